@@ -0,0 +1,260 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        batchrender.cpp
+// Purpose:     Command-line tool to render graphs from datasets to image files
+// Author:      Blake Madden
+// Created:     10/14/2026
+// Copyright:   (c) Blake Madden
+// Licence:     3-Clause BSD licence
+// SPDX-License-Identifier: BSD-3-Clause
+/////////////////////////////////////////////////////////////////////////////
+
+/* Usage:
+       WisteriaBatchRender --output <folder> --column <continuous column>
+                           [--group <grouping column>] [--type histogram|boxplot]
+                           [--format png|svg|jpg|bmp|tif|gif] [--width <DIPs>] [--height <DIPs>]
+                           [--profile fast|balanced|smallest] [--grayscale]
+                           <file.csv> [<file.csv> ...]
+
+   Each dataset is rendered to a file (with the same name as the dataset) in the output folder.
+   A single hidden canvas is reused for all of the datasets, and each image is
+   laid out only once (for the image's DC).
+   If only the width or height is given, then the other is calculated from the canvas's aspect ratio.
+   The images are encoded the same way as Canvas::Save() (see ImageExportOptions).*/
+
+#include <wx/wx.h>
+#include <wx/cmdline.h>
+#include <wx/filename.h>
+#include "../src/base/canvas.h"
+#include "../src/util/measuringdc.h"
+#include "../src/graphs/boxplot.h"
+#include "../src/graphs/histogram.h"
+
+using namespace Wisteria;
+using namespace Wisteria::Graphs;
+using namespace Wisteria::Data;
+
+// ---------------------------------------------------------------------------
+// BatchRenderApp
+// ---------------------------------------------------------------------------
+class BatchRenderApp final : public wxApp
+    {
+public:
+    bool OnInit() final
+        {
+        if (!wxApp::OnInit())
+            { return false; }
+        wxInitAllImageHandlers();
+        return true;
+        }
+    int OnExit() final
+        {
+        // the canvas's measuring DC must be destroyed before wxWidgets shuts down
+        MeasuringDC::ReleaseForCurrentThread();
+        return wxApp::OnExit();
+        }
+    /// @brief Renders all of the datasets and then exits (no event loop is run).
+    int OnRun() final;
+    void OnInitCmdLine(wxCmdLineParser& parser) final;
+    bool OnCmdLineParsed(wxCmdLineParser& parser) final;
+private:
+    /// @brief Loads a dataset and adds a graph of it to the canvas.
+    /// @returns @c true if the graph was created.
+    bool LoadDataset(Canvas* canvas, const wxString& filePath);
+    /// @returns The path to save a dataset's image to.
+    [[nodiscard]] wxFileName GetOutputPath(const wxString& filePath) const
+        { return wxFileName(m_outputFolder, wxFileName(filePath).GetName(), m_format); }
+    /// @brief Saves a rendered image of a dataset.
+    /// @returns @c true if the image was saved.
+    bool SaveImage(wxImage img, const wxString& filePath) const;
+    /// @returns The size to render the images at (if one was requested),
+    ///     using the canvas's aspect ratio for a missing width or height.
+    [[nodiscard]] std::optional<wxSize> GetImageSize(const Canvas* canvas) const;
+
+    wxString m_outputFolder;
+    wxString m_continuousColumn;
+    std::optional<wxString> m_groupColumn;
+    wxString m_graphType{ L"histogram" };
+    wxString m_format{ L"png" };
+    long m_widthDIPs{ 0 };
+    long m_heightDIPs{ 0 };
+    UI::ImageExportOptions m_exportOptions;
+    wxArrayString m_inputFiles;
+    };
+
+wxIMPLEMENT_APP(BatchRenderApp);
+
+//----------------------------------------------------------
+void BatchRenderApp::OnInitCmdLine(wxCmdLineParser& parser)
+    {
+    wxApp::OnInitCmdLine(parser);
+    parser.AddOption(L"o", L"output", _(L"Folder to save the images to."),
+                     wxCMD_LINE_VAL_STRING, wxCMD_LINE_OPTION_MANDATORY);
+    parser.AddOption(L"c", L"column", _(L"Continuous column to graph."),
+                     wxCMD_LINE_VAL_STRING, wxCMD_LINE_OPTION_MANDATORY);
+    parser.AddOption(L"g", L"group", _(L"Grouping column (optional)."));
+    parser.AddOption(L"t", L"type", _(L"Graph type: histogram (default) or boxplot."));
+    parser.AddOption(L"f", L"format", _(L"Image format: png (default), svg, jpg, bmp, tif, or gif."));
+    parser.AddOption(L"W", L"width", _(L"Image width (in DIPs)."), wxCMD_LINE_VAL_NUMBER);
+    parser.AddOption(L"H", L"height", _(L"Image height (in DIPs)."), wxCMD_LINE_VAL_NUMBER);
+    parser.AddOption(L"p", L"profile",
+                     _(L"Encoding profile: fast, balanced (default), or smallest."));
+    parser.AddSwitch(L"G", L"grayscale", _(L"Save the images in grayscale."));
+    parser.AddParam(_(L"CSV files to render"), wxCMD_LINE_VAL_STRING,
+                    wxCMD_LINE_PARAM_MULTIPLE);
+    }
+
+//----------------------------------------------------------
+bool BatchRenderApp::OnCmdLineParsed(wxCmdLineParser& parser)
+    {
+    if (!wxApp::OnCmdLineParsed(parser))
+        { return false; }
+    parser.Found(L"output", &m_outputFolder);
+    parser.Found(L"column", &m_continuousColumn);
+    if (wxString groupColumn; parser.Found(L"group", &groupColumn))
+        { m_groupColumn = groupColumn; }
+    parser.Found(L"type", &m_graphType);
+    parser.Found(L"format", &m_format);
+    parser.Found(L"width", &m_widthDIPs);
+    parser.Found(L"height", &m_heightDIPs);
+    if (parser.Found(L"grayscale"))
+        {
+        m_exportOptions.m_mode =
+            static_cast<decltype(m_exportOptions.m_mode)>(UI::ImageExportOptions::ColorMode::Grayscale);
+        }
+    if (wxString profile; parser.Found(L"profile", &profile))
+        {
+        using ExportProfile = UI::ImageExportOptions::ExportProfile;
+        if (profile.CmpNoCase(L"fast") == 0)
+            { m_exportOptions.m_profile = static_cast<int>(ExportProfile::Fast); }
+        else if (profile.CmpNoCase(L"balanced") == 0)
+            { m_exportOptions.m_profile = static_cast<int>(ExportProfile::Balanced); }
+        else if (profile.CmpNoCase(L"smallest") == 0)
+            { m_exportOptions.m_profile = static_cast<int>(ExportProfile::Smallest); }
+        else
+            {
+            wxLogError(_(L"Unknown encoding profile: '%s'."), profile);
+            return false;
+            }
+        }
+    for (size_t i = 0; i < parser.GetParamCount(); ++i)
+        { m_inputFiles.push_back(parser.GetParam(i)); }
+
+    if (m_graphType.CmpNoCase(L"histogram") != 0 && m_graphType.CmpNoCase(L"boxplot") != 0)
+        {
+        wxLogError(_(L"Unknown graph type: '%s'."), m_graphType);
+        return false;
+        }
+    if (m_widthDIPs < 0 || m_heightDIPs < 0)
+        {
+        wxLogError(_(L"The image width and height must be positive."));
+        return false;
+        }
+    return true;
+    }
+
+//----------------------------------------------------------
+std::optional<wxSize> BatchRenderApp::GetImageSize(const Canvas* canvas) const
+    {
+    if (m_widthDIPs == 0 && m_heightDIPs == 0)
+        { return std::nullopt; }
+    // keep the canvas's aspect ratio for the dimension that wasn't given
+    const double aspectRatio = safe_divide<double>(canvas->GetCanvasMinWidthDIPs(),
+                                                   canvas->GetCanvasMinHeightDIPs());
+    const long width = (m_widthDIPs > 0) ? m_widthDIPs :
+        static_cast<long>(std::lround(m_heightDIPs * aspectRatio));
+    const long height = (m_heightDIPs > 0) ? m_heightDIPs :
+        static_cast<long>(std::lround(safe_divide<double>(m_widthDIPs, aspectRatio)));
+    return wxSize(std::max(width, 1L), std::max(height, 1L));
+    }
+
+//----------------------------------------------------------
+int BatchRenderApp::OnRun()
+    {
+    wxFileName::Mkdir(m_outputFolder, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL);
+    // the canvas needs a parent window, but it is never shown
+    auto frame = new wxFrame(nullptr, wxID_ANY, wxString{});
+    auto canvas = new Canvas(frame);
+    const bool isSvg = (m_format.CmpNoCase(L"svg") == 0);
+    const auto sizeDIPs = GetImageSize(canvas);
+
+    size_t failedCount{ 0 };
+    for (const auto& inputFile : m_inputFiles)
+        {
+        if (!LoadDataset(canvas, inputFile))
+            {
+            ++failedCount;
+            continue;
+            }
+
+        if (isSvg)
+            {
+            const wxString outputPath{ GetOutputPath(inputFile).GetFullPath() };
+            if (!canvas->RenderToSvg(outputPath, sizeDIPs))
+                {
+                wxLogError(_(L"Failed to save image '%s'."), outputPath);
+                ++failedCount;
+                }
+            }
+        else if (!SaveImage(canvas->RenderToImage(sizeDIPs), inputFile))
+            { ++failedCount; }
+        }
+
+    frame->Destroy();
+    return (failedCount == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+//----------------------------------------------------------
+bool BatchRenderApp::LoadDataset(Canvas* canvas, const wxString& filePath)
+    {
+    auto dataset = std::make_shared<Dataset>();
+    try
+        {
+        auto importInfo = ImportInfo().ContinuousColumns({ m_continuousColumn });
+        if (m_groupColumn)
+            {
+            importInfo.CategoricalColumns(
+                { { m_groupColumn.value(), CategoricalImportMethod::ReadAsStrings } });
+            }
+        dataset->ImportCSV(filePath, importInfo);
+
+        if (m_graphType.CmpNoCase(L"boxplot") == 0)
+            {
+            auto plot = std::make_shared<BoxPlot>(canvas);
+            plot->SetData(dataset, m_continuousColumn, m_groupColumn);
+            canvas->SetFixedObject(0, 0, plot);
+            }
+        else
+            {
+            auto plot = std::make_shared<Histogram>(canvas);
+            plot->SetData(dataset, m_continuousColumn, m_groupColumn);
+            canvas->SetFixedObject(0, 0, plot);
+            }
+        }
+    catch (const std::exception& err)
+        {
+        wxLogError(L"%s: %s", filePath, wxString::FromUTF8(err.what()));
+        return false;
+        }
+    return true;
+    }
+
+//----------------------------------------------------------
+bool BatchRenderApp::SaveImage(wxImage img, const wxString& filePath) const
+    {
+    const wxFileName outputPath{ GetOutputPath(filePath) };
+    wxString ext{ m_format };
+    const wxBitmapType imageType = GraphItems::Image::GetImageFileTypeFromExtension(ext);
+    if (img.IsOk())
+        {
+        // encode the same way as Canvas::Save()
+        GraphItems::Image::FlattenForExport(img, (m_exportOptions.m_mode ==
+            static_cast<decltype(m_exportOptions.m_mode)>(UI::ImageExportOptions::ColorMode::Grayscale)));
+        m_exportOptions.ApplyEncodingOptions(img, imageType);
+        }
+    if (!img.IsOk() || !img.SaveFile(outputPath.GetFullPath(), imageType))
+        {
+        wxLogError(_(L"Failed to save image '%s'."), outputPath.GetFullPath());
+        return false;
+        }
+    return true;
+    }
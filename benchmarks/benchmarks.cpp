@@ -0,0 +1,455 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        benchmarks.cpp
+// Purpose:     Command-line tool to benchmark importing, statistics, and layout
+// Author:      Blake Madden
+// Created:     10/15/2026
+// Copyright:   (c) Blake Madden
+// Licence:     3-Clause BSD licence
+// SPDX-License-Identifier: BSD-3-Clause
+/////////////////////////////////////////////////////////////////////////////
+
+/* Usage:
+       WisteriaBenchmarks [--rows <count>] [--iterations <count>] [--datasets <folder>]
+                          [--filter <text>] [--output <file.json>]
+
+   The bundled datasets are scaled up (by repeating their rows) to the requested row count
+   (1,000,000 by default), and random data is generated from fixed seeds, so every run
+   measures the same work. Each benchmark is run once to warm up and then timed for the
+   requested number of iterations (5 by default).
+
+   The results are written as JSON (to the console if no output file is given), e.g.:
+
+       { "rows": 1000000, "iterations": 5, "results": [
+         { "name": "import/mpg", "rows": 1000000, "min_us": 812345, "median_us": 820112,
+           "mean_us": 823456 }, ... ] }*/
+
+#include <wx/wx.h>
+#include <wx/cmdline.h>
+#include <wx/dcgraph.h>
+#include <wx/filename.h>
+#include <wx/ffile.h>
+#include <wx/scopeguard.h>
+#include <wx/textfile.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <thread>
+#include "../src/base/canvas.h"
+#include "../src/graphs/boxplot.h"
+#include "../src/graphs/heatmap.h"
+#include "../src/graphs/histogram.h"
+#include "../src/math/statistics.h"
+#include "../src/util/frequency_set.h"
+
+using namespace Wisteria;
+using namespace Wisteria::Graphs;
+using namespace Wisteria::Data;
+
+// ---------------------------------------------------------------------------
+// BenchmarkApp
+// ---------------------------------------------------------------------------
+class BenchmarkApp final : public wxApp
+    {
+public:
+    bool OnInit() final
+        {
+        if (!wxApp::OnInit())
+            { return false; }
+        wxInitAllImageHandlers();
+        return true;
+        }
+    /// @brief Runs all of the benchmarks and then exits (no event loop is run).
+    int OnRun() final;
+    void OnInitCmdLine(wxCmdLineParser& parser) final;
+    bool OnCmdLineParsed(wxCmdLineParser& parser) final;
+private:
+    /// @brief The timings of a benchmark.
+    struct BenchmarkResult
+        {
+        wxString m_name;
+        size_t m_rows{ 0 };
+        std::vector<int64_t> m_microseconds;
+        };
+
+    /** @brief Times a benchmark.
+        @param name The benchmark's name (e.g., "import/mpg").
+        @param rows The number of rows (or values) that the benchmark processes.
+        @param setup Called before each run (and not timed).
+        @param run The work to time.*/
+    void Run(const wxString& name, const size_t rows,
+             const std::function<void()>& setup, const std::function<void()>& run);
+    /** @brief Writes a copy of a dataset, with its rows repeated to the given row count.
+        @param fileName The name of the file (in the datasets folder).
+        @param rows The number of rows to write.
+        @returns The path of the scaled dataset, or an empty string on failure.*/
+    [[nodiscard]] wxString ScaleDataset(const wxString& fileName, const size_t rows) const;
+    /// @returns The results as JSON.
+    [[nodiscard]] wxString FormatResults() const;
+
+    void RunImportBenchmarks();
+    void RunStatisticsBenchmarks();
+    void RunGraphBenchmarks();
+    void RunCanvasBenchmarks();
+
+    size_t m_rows{ 1'000'000 };
+    size_t m_iterations{ 5 };
+    wxString m_datasetsFolder{ L"datasets" };
+    wxString m_filter;
+    wxString m_outputPath;
+    wxString m_workFolder;
+    std::vector<BenchmarkResult> m_results;
+    // the canvases need a parent window, but it is never shown
+    wxFrame* m_frame{ nullptr };
+    };
+
+wxIMPLEMENT_APP(BenchmarkApp);
+
+//----------------------------------------------------------
+void BenchmarkApp::OnInitCmdLine(wxCmdLineParser& parser)
+    {
+    wxApp::OnInitCmdLine(parser);
+    parser.AddOption(L"r", L"rows", _(L"Number of rows to scale the datasets to."),
+                     wxCMD_LINE_VAL_NUMBER);
+    parser.AddOption(L"i", L"iterations", _(L"Number of times to run each benchmark."),
+                     wxCMD_LINE_VAL_NUMBER);
+    parser.AddOption(L"d", L"datasets", _(L"Folder containing the bundled datasets."));
+    parser.AddOption(L"f", L"filter", _(L"Only run benchmarks whose names contain this text."));
+    parser.AddOption(L"o", L"output", _(L"JSON file to write the results to."));
+    }
+
+//----------------------------------------------------------
+bool BenchmarkApp::OnCmdLineParsed(wxCmdLineParser& parser)
+    {
+    if (!wxApp::OnCmdLineParsed(parser))
+        { return false; }
+    if (long rows{ 0 }; parser.Found(L"rows", &rows) && rows > 0)
+        { m_rows = static_cast<size_t>(rows); }
+    if (long iterations{ 0 }; parser.Found(L"iterations", &iterations) && iterations > 0)
+        { m_iterations = static_cast<size_t>(iterations); }
+    parser.Found(L"datasets", &m_datasetsFolder);
+    parser.Found(L"filter", &m_filter);
+    parser.Found(L"output", &m_outputPath);
+    return true;
+    }
+
+//----------------------------------------------------------
+int BenchmarkApp::OnRun()
+    {
+    m_workFolder = wxFileName(wxFileName::GetTempDir(), L"wisteria-benchmarks").GetFullPath();
+    wxFileName::Mkdir(m_workFolder, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL);
+    // remove the work folder (and the scaled datasets in it) however the runs end,
+    // including if one throws
+    wxScopeGuard removeWorkFolder = wxMakeGuard([this]()
+        { wxFileName::Rmdir(m_workFolder, wxPATH_RMDIR_RECURSIVE); });
+    m_frame = new wxFrame(nullptr, wxID_ANY, wxString{});
+
+    try
+        {
+        RunImportBenchmarks();
+        RunStatisticsBenchmarks();
+        RunGraphBenchmarks();
+        RunCanvasBenchmarks();
+        }
+    catch (const std::exception& err)
+        {
+        wxLogError(L"%s", wxString::FromUTF8(err.what()));
+        m_frame->Destroy();
+        return EXIT_FAILURE;
+        }
+
+    m_frame->Destroy();
+
+    const wxString json{ FormatResults() };
+    if (m_outputPath.empty())
+        {
+        wxPrintf(L"%s\n", json);
+        return EXIT_SUCCESS;
+        }
+    wxFFile outputFile(m_outputPath, L"wb");
+    if (!outputFile.IsOpened() || !outputFile.Write(json, wxConvUTF8))
+        {
+        wxLogError(_(L"Failed to write '%s'."), m_outputPath);
+        return EXIT_FAILURE;
+        }
+    return EXIT_SUCCESS;
+    }
+
+//----------------------------------------------------------
+void BenchmarkApp::Run(const wxString& name, const size_t rows,
+                       const std::function<void()>& setup, const std::function<void()>& run)
+    {
+    if (!m_filter.empty() && name.find(m_filter) == wxString::npos)
+        { return; }
+    BenchmarkResult result{ name, rows, {} };
+    // the first run warms up the caches (and the allocator) and isn't recorded
+    for (size_t i = 0; i <= m_iterations; ++i)
+        {
+        if (setup)
+            { setup(); }
+        const auto start = std::chrono::steady_clock::now();
+        run();
+        const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start);
+        if (i > 0)
+            { result.m_microseconds.push_back(elapsed.count()); }
+        }
+    m_results.push_back(std::move(result));
+    }
+
+//----------------------------------------------------------
+wxString BenchmarkApp::ScaleDataset(const wxString& fileName, const size_t rows) const
+    {
+    wxTextFile source(wxFileName(m_datasetsFolder, fileName).GetFullPath());
+    if (!source.Open() || source.GetLineCount() < 2)
+        {
+        throw std::runtime_error(
+            wxString::Format(_(L"'%s': unable to open dataset."), fileName).ToUTF8());
+        }
+    const wxString outputPath =
+        wxFileName(m_workFolder, wxString::Format(L"%s-%s.csv",
+                   wxFileName(fileName).GetName(), std::to_wstring(rows))).GetFullPath();
+    if (wxFileName::FileExists(outputPath))
+        { return outputPath; }
+
+    wxFFile output(outputPath, L"wb");
+    if (!output.IsOpened())
+        {
+        throw std::runtime_error(
+            wxString::Format(_(L"'%s': unable to write scaled dataset."), outputPath).ToUTF8());
+        }
+    // write in blocks, rather than a line at a time
+    constexpr size_t blockSize{ 4 * 1024 * 1024 };
+    std::string block;
+    block.reserve(blockSize);
+    block.append(source.GetLine(0).ToUTF8()).append("\n");
+    std::vector<std::string> dataLines;
+    for (size_t i = 1; i < source.GetLineCount(); ++i)
+        {
+        if (!source.GetLine(i).empty())
+            { dataLines.emplace_back(source.GetLine(i).ToUTF8()); }
+        }
+    for (size_t i = 0; i < rows; ++i)
+        {
+        block.append(dataLines[i % dataLines.size()]).append("\n");
+        if (block.length() >= blockSize)
+            {
+            output.Write(block.data(), block.length());
+            block.clear();
+            }
+        }
+    output.Write(block.data(), block.length());
+    return outputPath;
+    }
+
+//----------------------------------------------------------
+void BenchmarkApp::RunImportBenchmarks()
+    {
+    const wxString mpgPath = ScaleDataset(L"mpg.csv", m_rows);
+    Run(L"import/mpg", m_rows, nullptr,
+        [&mpgPath]()
+        {
+        Dataset dataset;
+        dataset.ImportCSV(mpgPath,
+            ImportInfo().
+            ContinuousColumns({ L"displ", L"cty", L"hwy" }).
+            CategoricalColumns({
+                { L"manufacturer", CategoricalImportMethod::ReadAsStrings },
+                { L"class", CategoricalImportMethod::ReadAsStrings } }));
+        });
+
+    const wxString silverPath = ScaleDataset(L"Silver Futures.csv", m_rows);
+    Run(L"import/silver-futures", m_rows, nullptr,
+        [&silverPath]()
+        {
+        Dataset dataset;
+        dataset.ImportCSV(silverPath,
+            ImportInfo().ContinuousColumns({ L"Close/Last", L"Volume", L"Open", L"High", L"Low" }));
+        });
+
+    const wxString belongingPath = ScaleDataset(L"Sense of Belonging.csv", m_rows);
+    Run(L"import/sense-of-belonging", m_rows, nullptr,
+        [&belongingPath]()
+        {
+        Dataset dataset;
+        dataset.ImportCSV(belongingPath,
+            ImportInfo().
+            ContinuousColumns({ L"YEAR", L"BELONG" }).
+            CategoricalColumns({ { L"NAME", CategoricalImportMethod::ReadAsStrings } }));
+        });
+    }
+
+//----------------------------------------------------------
+void BenchmarkApp::RunStatisticsBenchmarks()
+    {
+    // the same values every run
+    std::mt19937_64 generator{ 42 };
+    std::normal_distribution<double> distribution{ 50, 15 };
+    std::vector<double> values(m_rows);
+    std::generate(values.begin(), values.end(),
+                  [&]() { return std::round(distribution(generator) * 100) / 100; });
+    std::vector<double> workingValues;
+    const auto copyValues = [&]() { workingValues = values; };
+    double result{ 0 };
+
+    Run(L"statistics/mean", m_rows, nullptr,
+        [&]() { result += statistics::mean(values); });
+    Run(L"statistics/calculate-moments", m_rows, nullptr,
+        [&]()
+        {
+        const auto moments = statistics::calculate_moments(values);
+        result += statistics::variance(moments, true) + statistics::kurtosis(values, true);
+        });
+    Run(L"statistics/median", m_rows, copyValues,
+        [&]() { result += statistics::median_unsorted(workingValues); });
+    Run(L"statistics/quartiles", m_rows, copyValues,
+        [&]()
+        {
+        double lowerQuartile{ 0 }, upperQuartile{ 0 };
+        statistics::quartiles(workingValues, lowerQuartile, upperQuartile);
+        result += lowerQuartile + upperQuartile;
+        });
+
+    Run(L"frequency-set/ordered", m_rows, nullptr,
+        [&]()
+        {
+        frequency_set<double> frequencies;
+        for (const auto& value : values)
+            { frequencies.insert(value); }
+        result += frequencies.get_data().size();
+        });
+    Run(L"frequency-set/hash", m_rows, nullptr,
+        [&]()
+        {
+        frequency_set<double, std::less<double>, frequency_storage::hash_storage> frequencies;
+        for (const auto& value : values)
+            { frequencies.insert(value); }
+        result += frequencies.get_data().size();
+        });
+
+    // keep the results from being optimized away
+    if (std::isnan(result))
+        { wxLogWarning(L"Statistics benchmarks produced NaN."); }
+    }
+
+//----------------------------------------------------------
+void BenchmarkApp::RunGraphBenchmarks()
+    {
+    auto mpgData = std::make_shared<Dataset>();
+    mpgData->ImportCSV(ScaleDataset(L"mpg.csv", m_rows),
+        ImportInfo().
+        ContinuousColumns({ L"hwy" }).
+        CategoricalColumns({ { L"class", CategoricalImportMethod::ReadAsStrings } }));
+
+    auto canvas = new Canvas(m_frame);
+    Run(L"graphs/histogram-set-data", m_rows, nullptr,
+        [&]()
+        {
+        auto plot = std::make_shared<Histogram>(canvas);
+        plot->SetData(mpgData, L"hwy", L"class");
+        });
+    Run(L"graphs/boxplot-set-data", m_rows, nullptr,
+        [&]()
+        {
+        auto plot = std::make_shared<BoxPlot>(canvas);
+        plot->SetData(mpgData, L"hwy", L"class");
+        });
+
+    // every value is a cell in a heatmap, so scale that down to something that
+    // could actually be shown
+    const size_t heatmapRows = std::min<size_t>(m_rows, 10'000);
+    auto heatmapData = std::make_shared<Dataset>();
+    heatmapData->ImportCSV(ScaleDataset(L"mpg.csv", heatmapRows),
+        ImportInfo().
+        ContinuousColumns({ L"hwy" }).
+        CategoricalColumns({ { L"class", CategoricalImportMethod::ReadAsStrings } }));
+    Run(L"graphs/heatmap-set-data", heatmapRows, nullptr,
+        [&]()
+        {
+        auto plot = std::make_shared<HeatMap>(canvas);
+        plot->SetData(heatmapData, L"hwy", L"class", 5);
+        });
+    canvas->Destroy();
+    }
+
+//----------------------------------------------------------
+void BenchmarkApp::RunCanvasBenchmarks()
+    {
+    // canvases are laid out and exported with the same (small) dataset,
+    // as these measure the layout and rendering, not the graphs' data
+    auto mpgData = std::make_shared<Dataset>();
+    mpgData->ImportCSV(wxFileName(m_datasetsFolder, L"mpg.csv").GetFullPath(),
+        ImportInfo().
+        ContinuousColumns({ L"hwy" }).
+        CategoricalColumns({ { L"class", CategoricalImportMethod::ReadAsStrings } }));
+
+    auto canvas = new Canvas(m_frame);
+    auto plot = std::make_shared<BoxPlot>(canvas);
+    plot->SetData(mpgData, L"hwy", L"class");
+    canvas->SetFixedObject(0, 0, plot);
+
+    // fitting the axes' labels (and everything else) into different sizes
+    for (const auto& size : { wxSize(400, 300), wxSize(1024, 768), wxSize(3000, 2000) })
+        {
+        Run(wxString::Format(L"layout/calc-all-sizes-%dx%d", size.GetWidth(), size.GetHeight()),
+            mpgData->GetRowCount(), nullptr,
+            [&]()
+            {
+            wxImage image(size);
+            wxGraphicsContext* context =
+                wxGraphicsRenderer::GetDefaultRenderer()->CreateContextFromImage(image);
+            wxGCDC dc(context);
+            canvas->SetCanvasMinWidthDIPs(size.GetWidth());
+            canvas->SetCanvasMinHeightDIPs(size.GetHeight());
+            canvas->CalcAllSizes(dc);
+            });
+        }
+
+    UI::ImageExportOptions options;
+    options.m_imageSize = wxSize(1024, 768);
+    for (const wxString format : { L"png", L"jpg", L"bmp", L"tif", L"gif", L"svg" })
+        {
+        const wxFileName outputPath(m_workFolder, L"canvas", format);
+        Run(L"save/" + format, mpgData->GetRowCount(), nullptr,
+            [&]()
+            {
+            if (!canvas->Save(outputPath, options))
+                {
+                throw std::runtime_error(wxString::Format(_(L"Failed to save '%s'."),
+                    outputPath.GetFullPath()).ToUTF8());
+                }
+            });
+        }
+    canvas->Destroy();
+    }
+
+//----------------------------------------------------------
+wxString BenchmarkApp::FormatResults() const
+    {
+    wxString json = wxString::Format(
+        L"{\n  \"rows\": %s,\n  \"iterations\": %s,\n  \"threads\": %u,\n"
+         "  \"wxWidgets\": \"%s\",\n  \"results\": [",
+        std::to_wstring(m_rows), std::to_wstring(m_iterations),
+        std::thread::hardware_concurrency(), wxVERSION_NUM_DOT_STRING);
+    for (size_t i = 0; i < m_results.size(); ++i)
+        {
+        const auto& result = m_results[i];
+        auto sorted = result.m_microseconds;
+        std::sort(sorted.begin(), sorted.end());
+        const int64_t minimum = sorted.empty() ? 0 : sorted.front();
+        const int64_t median = sorted.empty() ? 0 : sorted[sorted.size() / 2];
+        const int64_t mean = sorted.empty() ? 0 :
+            std::accumulate(sorted.cbegin(), sorted.cend(), int64_t{ 0 }) /
+            static_cast<int64_t>(sorted.size());
+        // the names are ours (no characters that need escaping)
+        json += wxString::Format(
+            L"%s\n    { \"name\": \"%s\", \"rows\": %s, \"min_us\": %s, "
+             "\"median_us\": %s, \"mean_us\": %s }",
+            (i > 0 ? L"," : L""), result.m_name, std::to_wstring(result.m_rows),
+            std::to_wstring(minimum), std::to_wstring(median), std::to_wstring(mean));
+        }
+    json += L"\n  ]\n}";
+    return json;
+    }
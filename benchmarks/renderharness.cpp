@@ -0,0 +1,466 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        renderharness.cpp
+// Purpose:     Command-line tool to time rendering the demo's graphs end to end
+// Author:      Blake Madden
+// Created:     10/15/2026
+// Copyright:   (c) Blake Madden
+// Licence:     3-Clause BSD licence
+// SPDX-License-Identifier: BSD-3-Clause
+/////////////////////////////////////////////////////////////////////////////
+
+/* Usage:
+       WisteriaRenderHarness [--iterations <count>] [--width <DIPs> --height <DIPs>]
+                             [--datasets <folder>] [--filter <text>] [--output <file.json>]
+                             [--golden <folder> [--update-golden] [--tolerance <0-255>]
+                              [--max-diff <percent>]]
+
+   Renders the same graphs that the demo program builds (box plot, heat map, line plot,
+   Gantt chart, candlestick plot, pie chart, roadmap, Likert chart, and table; these are
+   shared with the demo in demo/demographs.cpp) without showing them, at fixed sizes
+   (800x600 and 1920x1080 DIPs, unless a size is given).
+   Each graph is built and rendered for the requested number of iterations (5 by default),
+   after a warmup run, and these stages are timed separately:
+
+     - set_data: building the graph from its (already imported) dataset
+     - layout:   Canvas::CalcAllSizes()
+     - draw:     drawing the canvas onto an image
+     - encode:   writing the image as a PNG (in memory)
+
+   The number of memory allocations made while building and rendering each graph is also
+   recorded, along with the process's peak memory use after rendering it. The latter is the
+   process's high-water mark (not the graph's own usage), so it never goes down from one
+   graph to the next and only shows when a graph raises it. The results are written as JSON
+   (to the console if no output file is given).
+
+   If a folder of golden images is given, the last image of each graph is compared against
+   its golden image (e.g., "boxplot-800x600.png"), and the program fails if more than
+   --max-diff percent (0.1 by default) of the pixels differ by more than --tolerance
+   (8 by default) in any channel. Pass --update-golden to write the golden images instead.
+
+   As this is deterministic and covers the library's main code paths, it is also meant to be
+   the training workload for profile-guided optimization builds.*/
+
+#include <wx/wx.h>
+#include <wx/cmdline.h>
+#include <wx/ffile.h>
+#include <wx/filename.h>
+#include <wx/mstream.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <numeric>
+#include "../src/base/canvas.h"
+#include "../demo/demographs.h"
+
+#if defined(__WXMSW__)
+    #include <psapi.h>
+    #if defined(_MSC_VER)
+        #pragma comment(lib, "psapi.lib")
+    #endif
+#else
+    #include <sys/resource.h>
+#endif
+
+using namespace Wisteria;
+using namespace Wisteria::Colors;
+using namespace Wisteria::Graphs;
+using namespace Wisteria::GraphItems;
+using namespace Wisteria::Data;
+
+// ---------------------------------------------------------------------------
+// Allocation counting
+// ---------------------------------------------------------------------------
+namespace
+    {
+    std::atomic<uint64_t> allocationCount{ 0 };
+    }
+
+// the nothrow forms of new call these
+void* operator new(size_t size)
+    {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size == 0 ? 1 : size))
+        { return ptr; }
+    throw std::bad_alloc{};
+    }
+
+void* operator new[](size_t size)
+    { return operator new(size); }
+
+void operator delete(void* ptr) noexcept
+    { std::free(ptr); }
+
+void operator delete[](void* ptr) noexcept
+    { std::free(ptr); }
+
+void operator delete(void* ptr, size_t) noexcept
+    { std::free(ptr); }
+
+void operator delete[](void* ptr, size_t) noexcept
+    { std::free(ptr); }
+
+// ---------------------------------------------------------------------------
+// RenderHarnessApp
+// ---------------------------------------------------------------------------
+class RenderHarnessApp final : public wxApp
+    {
+public:
+    bool OnInit() final
+        {
+        if (!wxApp::OnInit())
+            { return false; }
+        wxInitAllImageHandlers();
+        return true;
+        }
+    /// @brief Renders all of the scenarios and then exits (no event loop is run).
+    int OnRun() final;
+    void OnInitCmdLine(wxCmdLineParser& parser) final;
+    bool OnCmdLineParsed(wxCmdLineParser& parser) final;
+private:
+    /// @brief A graph from the demo program (see DemoGraphs).
+    struct Scenario
+        {
+        wxString m_name;
+        /// @brief Imports (and prepares) the dataset. This isn't timed.
+        std::function<std::shared_ptr<Dataset>(const wxString& datasetsFolder)> m_loadData;
+        /// @brief Builds the graph(s) on the canvas from the dataset.
+        std::function<void(Canvas* canvas, const std::shared_ptr<const Dataset>& data)> m_build;
+        };
+
+    /// @brief The timings and counters of a scenario rendered at a given size.
+    struct ScenarioResult
+        {
+        wxString m_name;
+        wxSize m_size;
+        std::vector<int64_t> m_setDataTimes;
+        std::vector<int64_t> m_layoutTimes;
+        std::vector<int64_t> m_drawTimes;
+        std::vector<int64_t> m_encodeTimes;
+        uint64_t m_allocations{ 0 };
+        // the process's high-water mark after this scenario, not the scenario's own usage
+        uint64_t m_processPeakMemory{ 0 };
+        // empty if not compared against a golden image
+        wxString m_goldenResult;
+        };
+
+    /// @returns The graphs from the demo program.
+    [[nodiscard]] static std::vector<Scenario> GetScenarios();
+    /** @brief Builds and renders a scenario.
+        @param scenario The scenario.
+        @param data The scenario's dataset.
+        @param size The size of the image (in DIPs).
+        @returns The timings of each stage.*/
+    [[nodiscard]] ScenarioResult Run(const Scenario& scenario,
+                                     const std::shared_ptr<const Dataset>& data,
+                                     const wxSize size);
+    /** @brief Compares an image against its golden image (or replaces the golden image).
+        @param image The rendered image.
+        @param fileName The name of the golden image.
+        @returns A description of the result (e.g., "match" or "2.5% of pixels differ").
+            This will start with "mismatch" if the images differ beyond the tolerance.*/
+    [[nodiscard]] wxString CompareToGolden(const wxImage& image, const wxString& fileName) const;
+    /** @returns The process's peak memory use (in bytes) so far.
+        @note This is cumulative for the whole run; it can't be reset between scenarios.*/
+    [[nodiscard]] static uint64_t GetPeakMemory();
+    /// @returns The results as JSON.
+    [[nodiscard]] wxString FormatResults(const std::vector<ScenarioResult>& results,
+                                         const double dpiScaling) const;
+
+    size_t m_iterations{ 5 };
+    std::vector<wxSize> m_sizesDIPs{ wxSize(800, 600), wxSize(1920, 1080) };
+    wxString m_datasetsFolder{ L"datasets" };
+    wxString m_filter;
+    wxString m_outputPath;
+    wxString m_goldenFolder;
+    bool m_updateGolden{ false };
+    long m_tolerance{ 8 };
+    double m_maxDiffPercent{ 0.1 };
+    // the canvases need a parent window, but it is never shown
+    wxFrame* m_frame{ nullptr };
+    };
+
+wxIMPLEMENT_APP(RenderHarnessApp);
+
+//----------------------------------------------------------
+void RenderHarnessApp::OnInitCmdLine(wxCmdLineParser& parser)
+    {
+    wxApp::OnInitCmdLine(parser);
+    parser.AddOption(L"i", L"iterations", _(L"Number of times to render each graph."),
+                     wxCMD_LINE_VAL_NUMBER);
+    parser.AddOption(L"W", L"width", _(L"Image width (in DIPs)."), wxCMD_LINE_VAL_NUMBER);
+    parser.AddOption(L"H", L"height", _(L"Image height (in DIPs)."), wxCMD_LINE_VAL_NUMBER);
+    parser.AddOption(L"d", L"datasets", _(L"Folder containing the bundled datasets."));
+    parser.AddOption(L"f", L"filter", _(L"Only render graphs whose names contain this text."));
+    parser.AddOption(L"o", L"output", _(L"JSON file to write the results to."));
+    parser.AddOption(L"g", L"golden", _(L"Folder of golden images to compare against."));
+    parser.AddSwitch(L"u", L"update-golden", _(L"Write the golden images instead of comparing."));
+    parser.AddOption(L"t", L"tolerance",
+                     _(L"How much a pixel's channel can differ from the golden image (0-255)."),
+                     wxCMD_LINE_VAL_NUMBER);
+    parser.AddOption(L"m", L"max-diff",
+                     _(L"Percent of pixels that can differ from the golden image."),
+                     wxCMD_LINE_VAL_DOUBLE);
+    }
+
+//----------------------------------------------------------
+bool RenderHarnessApp::OnCmdLineParsed(wxCmdLineParser& parser)
+    {
+    if (!wxApp::OnCmdLineParsed(parser))
+        { return false; }
+    if (long iterations{ 0 }; parser.Found(L"iterations", &iterations) && iterations > 0)
+        { m_iterations = static_cast<size_t>(iterations); }
+    long width{ 0 }, height{ 0 };
+    parser.Found(L"width", &width);
+    parser.Found(L"height", &height);
+    if (width > 0 && height > 0)
+        { m_sizesDIPs = { wxSize(width, height) }; }
+    parser.Found(L"datasets", &m_datasetsFolder);
+    parser.Found(L"filter", &m_filter);
+    parser.Found(L"output", &m_outputPath);
+    parser.Found(L"golden", &m_goldenFolder);
+    m_updateGolden = parser.Found(L"update-golden");
+    parser.Found(L"tolerance", &m_tolerance);
+    parser.Found(L"max-diff", &m_maxDiffPercent);
+
+    if (m_updateGolden && m_goldenFolder.empty())
+        {
+        wxLogError(_(L"A golden image folder must be specified to update it."));
+        return false;
+        }
+    return true;
+    }
+
+//----------------------------------------------------------
+int RenderHarnessApp::OnRun()
+    {
+    if (m_updateGolden)
+        { wxFileName::Mkdir(m_goldenFolder, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL); }
+    m_frame = new wxFrame(nullptr, wxID_ANY, wxString{});
+
+    std::vector<ScenarioResult> results;
+    bool goldenMismatch{ false };
+    try
+        {
+        for (const auto& scenario : GetScenarios())
+            {
+            if (!m_filter.empty() && scenario.m_name.find(m_filter) == wxString::npos)
+                { continue; }
+            const auto data = scenario.m_loadData(m_datasetsFolder);
+            for (const auto& size : m_sizesDIPs)
+                {
+                results.push_back(Run(scenario, data, size));
+                if (results.back().m_goldenResult.StartsWith(L"mismatch"))
+                    {
+                    wxLogError(L"%s (%dx%d): %s", scenario.m_name, size.GetWidth(),
+                               size.GetHeight(), results.back().m_goldenResult);
+                    goldenMismatch = true;
+                    }
+                }
+            }
+        }
+    catch (const std::exception& err)
+        {
+        wxLogError(L"%s", wxString::FromUTF8(err.what()));
+        m_frame->Destroy();
+        return EXIT_FAILURE;
+        }
+
+    const wxString json{ FormatResults(results, m_frame->GetDPIScaleFactor()) };
+    m_frame->Destroy();
+    if (m_outputPath.empty())
+        { wxPrintf(L"%s\n", json); }
+    else
+        {
+        wxFFile outputFile(m_outputPath, L"wb");
+        if (!outputFile.IsOpened() || !outputFile.Write(json, wxConvUTF8))
+            {
+            wxLogError(_(L"Failed to write '%s'."), m_outputPath);
+            return EXIT_FAILURE;
+            }
+        }
+    return goldenMismatch ? EXIT_FAILURE : EXIT_SUCCESS;
+    }
+
+//----------------------------------------------------------
+RenderHarnessApp::ScenarioResult RenderHarnessApp::Run(const Scenario& scenario,
+                                                       const std::shared_ptr<const Dataset>& data,
+                                                       const wxSize size)
+    {
+    ScenarioResult result{ scenario.m_name, size };
+    const auto elapsedSince = [](const std::chrono::steady_clock::time_point& start)
+        {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count();
+        };
+
+    wxImage image;
+    // the first run warms up the caches (and the allocator) and isn't recorded
+    for (size_t i = 0; i <= m_iterations; ++i)
+        {
+        const uint64_t startAllocations = allocationCount.load(std::memory_order_relaxed);
+
+        // a new canvas every time, so that nothing is reused from the last run
+        auto canvas = new Canvas(m_frame);
+        auto start = std::chrono::steady_clock::now();
+        scenario.m_build(canvas, data);
+        const auto setDataTime = elapsedSince(start);
+
+        canvas->ResetRenderMetrics();
+        image = canvas->RenderToImage(size);
+        const auto& metrics = canvas->GetRenderMetrics();
+
+        wxMemoryOutputStream encoded;
+        start = std::chrono::steady_clock::now();
+        if (!image.IsOk() || !image.SaveFile(encoded, wxBITMAP_TYPE_PNG))
+            {
+            throw std::runtime_error(
+                wxString::Format(_(L"'%s': failed to render image."), scenario.m_name).ToUTF8());
+            }
+        const auto encodeTime = elapsedSince(start);
+
+        if (i > 0)
+            {
+            result.m_setDataTimes.push_back(setDataTime);
+            result.m_layoutTimes.push_back(metrics.m_layoutTime.count());
+            result.m_drawTimes.push_back(metrics.m_drawTime.count());
+            result.m_encodeTimes.push_back(encodeTime);
+            }
+        // child windows can be deleted directly (there is no event loop to destroy them later)
+        delete canvas;
+        result.m_allocations = allocationCount.load(std::memory_order_relaxed) - startAllocations;
+        }
+    result.m_processPeakMemory = GetPeakMemory();
+
+    if (!m_goldenFolder.empty())
+        {
+        result.m_goldenResult = CompareToGolden(image,
+            wxString::Format(L"%s-%dx%d.png", scenario.m_name, size.GetWidth(), size.GetHeight()));
+        }
+    return result;
+    }
+
+//----------------------------------------------------------
+wxString RenderHarnessApp::CompareToGolden(const wxImage& image, const wxString& fileName) const
+    {
+    const wxString goldenPath{ wxFileName(m_goldenFolder, fileName).GetFullPath() };
+    if (m_updateGolden)
+        {
+        return image.SaveFile(goldenPath, wxBITMAP_TYPE_PNG) ?
+            wxString{ L"updated" } : wxString{ L"mismatch: unable to write golden image" };
+        }
+
+    wxImage golden;
+    if (!wxFileName::FileExists(goldenPath) || !golden.LoadFile(goldenPath, wxBITMAP_TYPE_PNG))
+        { return L"mismatch: golden image not found"; }
+    if (golden.GetSize() != image.GetSize())
+        {
+        return wxString::Format(L"mismatch: image is %dx%d, golden image is %dx%d",
+                                image.GetWidth(), image.GetHeight(),
+                                golden.GetWidth(), golden.GetHeight());
+        }
+
+    const size_t pixelCount = static_cast<size_t>(image.GetWidth()) * image.GetHeight();
+    const unsigned char* imagePixels = image.GetData();
+    const unsigned char* goldenPixels = golden.GetData();
+    size_t differentPixels{ 0 };
+    for (size_t i = 0; i < pixelCount * 3; i += 3)
+        {
+        if (std::abs(imagePixels[i] - goldenPixels[i]) > m_tolerance ||
+            std::abs(imagePixels[i + 1] - goldenPixels[i + 1]) > m_tolerance ||
+            std::abs(imagePixels[i + 2] - goldenPixels[i + 2]) > m_tolerance)
+            { ++differentPixels; }
+        }
+    const double diffPercent = safe_divide<double>(differentPixels, pixelCount) * 100;
+    if (differentPixels == 0)
+        { return L"match"; }
+    return wxString::Format(L"%s: %.3f%% of pixels differ",
+                            (diffPercent > m_maxDiffPercent ? L"mismatch" : L"match"),
+                            diffPercent);
+    }
+
+//----------------------------------------------------------
+uint64_t RenderHarnessApp::GetPeakMemory()
+    {
+#if defined(__WXMSW__)
+    PROCESS_MEMORY_COUNTERS counters{};
+    if (::GetProcessMemoryInfo(::GetCurrentProcess(), &counters, sizeof(counters)))
+        { return counters.PeakWorkingSetSize; }
+    return 0;
+#else
+    rusage usage{};
+    if (::getrusage(RUSAGE_SELF, &usage) != 0)
+        { return 0; }
+    #if defined(__APPLE__)
+    // already in bytes on macOS
+    return static_cast<uint64_t>(usage.ru_maxrss);
+    #else
+    // kilobytes everywhere else
+    return static_cast<uint64_t>(usage.ru_maxrss) * 1024;
+    #endif
+#endif
+    }
+
+//----------------------------------------------------------
+wxString RenderHarnessApp::FormatResults(const std::vector<ScenarioResult>& results,
+                                         const double dpiScaling) const
+    {
+    // the median of a stage's timings
+    const auto median = [](std::vector<int64_t> times)
+        {
+        if (times.empty())
+            { return int64_t{ 0 }; }
+        std::sort(times.begin(), times.end());
+        return times[times.size() / 2];
+        };
+
+    wxString json = wxString::Format(
+        L"{\n  \"iterations\": %s,\n  \"dpi_scaling\": %.2f,\n"
+         "  \"wxWidgets\": \"%s\",\n  \"results\": [",
+        std::to_wstring(m_iterations), dpiScaling, wxVERSION_NUM_DOT_STRING);
+    for (size_t i = 0; i < results.size(); ++i)
+        {
+        const auto& result = results[i];
+        const int64_t setData = median(result.m_setDataTimes);
+        const int64_t layout = median(result.m_layoutTimes);
+        const int64_t draw = median(result.m_drawTimes);
+        const int64_t encode = median(result.m_encodeTimes);
+        // the names are ours (no characters that need escaping)
+        json += wxString::Format(
+            L"%s\n    { \"name\": \"%s\", \"width\": %d, \"height\": %d, "
+             "\"set_data_us\": %s, \"layout_us\": %s, \"draw_us\": %s, \"encode_us\": %s, "
+             "\"total_us\": %s, \"allocations\": %s, \"process_peak_memory_bytes\": %s%s }",
+            (i > 0 ? L"," : L""), result.m_name,
+            result.m_size.GetWidth(), result.m_size.GetHeight(),
+            std::to_wstring(setData), std::to_wstring(layout),
+            std::to_wstring(draw), std::to_wstring(encode),
+            std::to_wstring(setData + layout + draw + encode),
+            std::to_wstring(result.m_allocations), std::to_wstring(result.m_processPeakMemory),
+            (result.m_goldenResult.empty() ? wxString{} :
+                wxString::Format(L", \"golden\": \"%s\"", result.m_goldenResult)));
+        }
+    json += L"\n  ]\n}";
+    return json;
+    }
+
+//----------------------------------------------------------
+std::vector<RenderHarnessApp::Scenario> RenderHarnessApp::GetScenarios()
+    {
+    return {
+        { L"boxplot", DemoGraphs::LoadBoxPlotData, DemoGraphs::BuildBoxPlot },
+        { L"heatmap-grouped", DemoGraphs::LoadGroupedHeatMapData,
+          DemoGraphs::BuildGroupedHeatMap },
+        { L"lineplot", DemoGraphs::LoadLinePlotData, DemoGraphs::BuildLinePlot },
+        { L"gantt", DemoGraphs::LoadGanttChartData, DemoGraphs::BuildGanttChart },
+        { L"candlestick", DemoGraphs::LoadCandlestickPlotData,
+          DemoGraphs::BuildCandlestickPlot },
+        { L"piechart-grouped", DemoGraphs::LoadGroupedPieChartData,
+          DemoGraphs::BuildGroupedPieChart },
+        { L"lr-roadmap", DemoGraphs::LoadLRRoadmapData, DemoGraphs::BuildLRRoadmap },
+        { L"likert-7point", DemoGraphs::LoadLikert7PointData,
+          DemoGraphs::BuildLikert7PointChart },
+        { L"table", DemoGraphs::LoadTableData, DemoGraphs::BuildTable }
+        };
+    }
@@ -49,6 +49,13 @@ bool MyApp::OnInit()
     return true;
     }
 
+int MyApp::OnExit()
+    {
+    // the canvases' measuring DC must be destroyed before wxWidgets shuts down
+    MeasuringDC::ReleaseForCurrentThread();
+    return wxApp::OnExit();
+    }
+
 // ---------------------------------------------------------------------------
 // MyFrame
 // ---------------------------------------------------------------------------
@@ -271,35 +278,16 @@ void MyFrame::OnNewWindow(wxCommandEvent& event)
     if (event.GetId() == MyApp::ID_NEW_BOXPLOT)
         {
         subframe->SetTitle(_(L"Box Plot"));
-        subframe->m_canvas->SetFixedObjectsGridSize(1, 1);
-        auto mpgData = std::make_shared<Data::Dataset>();
+        std::shared_ptr<Data::Dataset> mpgData;
         try
-            {
-            mpgData->ImportCSV(appDir + L"/datasets/mpg.csv",
-                ImportInfo().ContinuousColumns({ L"hwy" }).
-                CategoricalColumns({
-                    { L"class", CategoricalImportMethod::ReadAsStrings },
-                    { L"manufacturer", CategoricalImportMethod::ReadAsStrings } }));
-            }
+            { mpgData = DemoGraphs::LoadBoxPlotData(appDir + L"/datasets"); }
         catch (const std::exception& err)
             {
-            wxMessageBox(wxString::FromUTF8(wxString::FromUTF8(err.what())),
+            wxMessageBox(wxString::FromUTF8(err.what()),
                          _(L"Import Error"), wxOK|wxICON_ERROR|wxCENTRE);
             return;
             }
-        auto plot = std::make_shared<BoxPlot>(subframe->m_canvas);
-
-        plot->SetData(mpgData,
-                      L"hwy",
-                      // leave this as std::nullopt to not create grouped boxes
-                      L"class");
-
-        // Show all points (not just outliers).
-        // The points within the boxes and whiskers will be
-        // bee-swarm jittering to visualize the distribution.
-        plot->ShowAllPoints(true);
-
-        subframe->m_canvas->SetFixedObject(0, 0, plot);
+        DemoGraphs::BuildBoxPlot(subframe->m_canvas, mpgData);
         }
     // Heatmap
     else if (event.GetId() == MyApp::ID_NEW_HEATMAP)
@@ -349,43 +337,16 @@ void MyFrame::OnNewWindow(wxCommandEvent& event)
     else if (event.GetId() == MyApp::ID_NEW_HEATMAP_GROUPED)
         {
         subframe->SetTitle(_(L"Heatmap (Grouped)"));
-        subframe->m_canvas->SetFixedObjectsGridSize(1, 2);
-        auto testScoresData = std::make_shared<Data::Dataset>();
+        std::shared_ptr<Data::Dataset> testScoresData;
         try
-            {
-            testScoresData->ImportCSV(appDir + L"/datasets/Student Scores.csv",
-                ImportInfo().
-                ContinuousColumns({ L"test_score" }).
-                IdColumn(L"Week").
-                CategoricalColumns({ { L"Name", CategoricalImportMethod::ReadAsStrings } }));
-            }
+            { testScoresData = DemoGraphs::LoadGroupedHeatMapData(appDir + L"/datasets"); }
         catch (const std::exception& err)
             {
-            wxMessageBox(wxString::FromUTF8(wxString::FromUTF8(err.what())),
+            wxMessageBox(wxString::FromUTF8(err.what()),
                          _(L"Import Error"), wxOK|wxICON_ERROR|wxCENTRE);
             return;
             }
-
-        auto plot = std::make_shared<HeatMap>(subframe->m_canvas);
-        // add a title to the plot
-        plot->GetTitle().GetGraphItemInfo().Text(_(L"Test Scores")).
-            ChildAlignment(RelativeAlignment::FlushLeft).
-            Pen(wxNullPen).Padding(4, 0, 0, 4).
-            Font(wxFont(wxSystemSettings::GetFont(wxSYS_DEFAULT_GUI_FONT)).
-                 MakeLarger());
-
-        // use group and put all of the students' heatmaps into one column
-        plot->SetData(testScoresData, L"TEST_SCORE", L"Name", 1);
-        // say "Students" at the top instead of "Groups"
-        plot->SetGroupHeaderPrefix(_(L"Students"));
-
-        subframe->m_canvas->SetFixedObject(0, 0, plot);
-        // customize the header of the legend and add it to the canvas
-        auto legend{ plot->CreateLegend(
-            LegendOptions().
-                IncludeHeader(true).
-                PlacementHint(LegendCanvasPlacementHint::RightOfGraph)) };
-        subframe->m_canvas->SetFixedObject(0, 1, legend);
+        DemoGraphs::BuildGroupedHeatMap(subframe->m_canvas, testScoresData);
         }
     // Histogram
     else if (event.GetId() == MyApp::ID_NEW_HISTOGRAM)
@@ -482,62 +443,16 @@ void MyFrame::OnNewWindow(wxCommandEvent& event)
     else if (event.GetId() == MyApp::ID_NEW_LINEPLOT)
         {
         subframe->SetTitle(_(L"Line Plot"));
-        subframe->m_canvas->SetFixedObjectsGridSize(1, 2);
-        auto linePlotData = std::make_shared<Data::Dataset>();
+        std::shared_ptr<Data::Dataset> linePlotData;
         try
-            {
-            linePlotData->ImportCSV(appDir + L"/datasets/Spelling Grades.csv",
-                ImportInfo().
-                // first the Y column
-                ContinuousColumns({ L"AVG_GRADE"}).
-                // group and X
-                CategoricalColumns({
-                    { L"Gender", CategoricalImportMethod::ReadAsStrings },
-                    { L"WEEK_NAME", CategoricalImportMethod::ReadAsStrings }
-                    }));
-            }
+            { linePlotData = DemoGraphs::LoadLinePlotData(appDir + L"/datasets"); }
         catch (const std::exception& err)
             {
-            wxMessageBox(wxString::FromUTF8(wxString::FromUTF8(err.what())),
+            wxMessageBox(wxString::FromUTF8(err.what()),
                          _(L"Import Error"), wxOK|wxICON_ERROR|wxCENTRE);
             return;
             }
-        auto linePlot = std::make_shared<LinePlot>(subframe->m_canvas,
-            // use a different color scheme
-            std::make_shared<Colors::Schemes::Decade1960s>(),
-            // or create your own scheme
-            // std::make_shared<Colors::Schemes::ColorScheme>
-            //     (Colors::Schemes::ColorScheme{
-            //         ColorBrewer::GetColor(Colors::Color::Auburn),
-            //         ColorBrewer::GetColor(Colors::Color::OctoberMist) }),
-
-            // turn off markers by using a shape scheme filled with blank icons
-            // (having just one icon in this scheme will get recycled for each line)
-            std::make_shared<IconShapeScheme>(IconShapeScheme{IconShape::BlankIcon}));
-        // add padding around the plot
-        linePlot->SetCanvasMargins(5, 5, 5, 5);
-
-        // Set the data and use the grouping column from the dataset to create separate lines.
-        // Also, use a categorical column for the X axis.
-        linePlot->SetData(linePlotData, L"AVG_GRADE", L"WEEK_NAME", L"Gender");
-
-        // add some titles
-        linePlot->GetTitle().SetText(_(L"Average Grades"));
-        linePlot->GetSubtitle().SetText(_(L"Average grades taken from\n"
-                                           "last 5 weeks' spelling tests."));
-        linePlot->GetCaption().SetText(_(L"Note: not all grades have been\n"
-                                          "entered yet for last week."));
-        // remove default titles
-        linePlot->GetBottomXAxis().GetTitle().SetText(L"");
-        linePlot->GetLeftYAxis().GetTitle().SetText(L"");
-
-        // add the line plot and its legend to the canvas
-        subframe->m_canvas->SetFixedObject(0, 0, linePlot);
-        subframe->m_canvas->SetFixedObject(0, 1,
-            linePlot->CreateLegend(
-                LegendOptions().
-                    IncludeHeader(true).
-                    PlacementHint(LegendCanvasPlacementHint::RightOfGraph)) );
+        DemoGraphs::BuildLinePlot(subframe->m_canvas, linePlotData);
         }
     // Line Plot (customized)
     else if (event.GetId() == MyApp::ID_NEW_LINEPLOT_CUSTOMIZED)
@@ -663,107 +578,30 @@ void MyFrame::OnNewWindow(wxCommandEvent& event)
     else if (event.GetId() == MyApp::ID_NEW_GANTT)
         {
         subframe->SetTitle(_(L"Gantt Chart"));
-        subframe->m_canvas->SetFixedObjectsGridSize(1, 2);
-
-        auto companyAcquisitionData = std::make_shared<Data::Dataset>();
+        std::shared_ptr<Data::Dataset> companyAcquisitionData;
         try
-            {
-            companyAcquisitionData->ImportCSV(appDir + L"/datasets/Company Acquisition.csv",
-                ImportInfo().
-                ContinuousColumns({ L"Completion" }).
-                DateColumns({ { L"Start" }, { L"End" } }).
-                CategoricalColumns({
-                    { L"Task" },
-                    { L"Description" },
-                    { L"Resource" }
-                    }));
-            }
+            { companyAcquisitionData = DemoGraphs::LoadGanttChartData(appDir + L"/datasets"); }
         catch (const std::exception& err)
             {
             wxMessageBox(wxString::FromUTF8(err.what()),
                          _(L"Import Error"), wxOK|wxICON_ERROR|wxCENTRE);
             return;
             }
-
-        auto ganttChart = std::make_shared<GanttChart>(subframe->m_canvas,
-            // use a different color scheme where the colors
-            // stand out more from each other
-            std::make_shared<Colors::Schemes::Decade1920s>());
-        ganttChart->SetData(companyAcquisitionData,
-            DateInterval::FiscalQuarterly, FiscalYear::USBusiness,
-            L"Task", L"Start", "End",
-            // these columns are optional
-            L"Resource", L"Description", L"Completion", L"Resource");
-
-        // add deadlines
-        auto releaseDate = ganttChart->GetScalingAxis().GetPointFromDate(
-            wxDateTime(25, wxDateTime::Dec, 2022));
-        if (releaseDate)
-            {
-            ganttChart->AddReferenceLine(ReferenceLine(AxisType::BottomXAxis,
-                releaseDate.value(), _(L"Release"),
-                ColorBrewer::GetColor(Colors::Color::TractorRed)) );
-            }
-
-        auto updateReleaseDate = ganttChart->GetScalingAxis().GetPointFromDate(
-            wxDateTime(15, wxDateTime::Mar, 2023));
-        if (updateReleaseDate)
-            {
-            ganttChart->AddReferenceLine(ReferenceLine(AxisType::BottomXAxis,
-                updateReleaseDate.value(),
-                _(L"Hotfix Release"),
-                ColorBrewer::GetColor(Colors::Color::TractorRed,
-                                      Wisteria::Settings::GetTranslucencyValue())));
-            }
-
-        ganttChart->SetCanvasMargins(5, 5, 5, 5);
-        subframe->m_canvas->SetFixedObject(0, 0, ganttChart);
-        // add a legend, showing whom is assigned to which tasks
-        subframe->m_canvas->SetFixedObject(0, 1,
-            ganttChart->CreateLegend(
-                LegendOptions().
-                    IncludeHeader(false).
-                    PlacementHint(LegendCanvasPlacementHint::RightOfGraph)));
+        DemoGraphs::BuildGanttChart(subframe->m_canvas, companyAcquisitionData);
         }
     else if (event.GetId() == MyApp::ID_NEW_CANDLESTICK_AXIS)
         {
         subframe->SetTitle(_(L"Candlestick Plot"));
-        subframe->m_canvas->SetFixedObjectsGridSize(1, 1);
-
-        auto silverFuturesData = std::make_shared<Data::Dataset>();
+        std::shared_ptr<Data::Dataset> silverFuturesData;
         try
-            {
-            silverFuturesData->ImportCSV(appDir + L"/datasets/Silver Futures.csv",
-                ImportInfo().
-                ContinuousColumns({ L"Open", L"High", L"Low", L"Close/Last" }).
-                DateColumns({ { L"Date" } }));
-            }
+            { silverFuturesData = DemoGraphs::LoadCandlestickPlotData(appDir + L"/datasets"); }
         catch (const std::exception& err)
             {
             wxMessageBox(wxString::FromUTF8(err.what()),
                          _(L"Import Error"), wxOK|wxICON_ERROR|wxCENTRE);
             return;
             }
-
-        auto candlestickChart = std::make_shared<CandlestickPlot>(subframe->m_canvas);
-        // Chart's left axis will start at zero by default so that the scale
-        // isn't misleading; you can, however, turn that off like this
-        // to better see the daily activity.
-        // This should be done before calling SetData() so that it bases
-        // axis range on the data.
-        candlestickChart->GetLeftYAxis().StartAtZero(false);
-
-        // Uncomment this to fit the entire year onto the canvas
-        // so that there isn't a scrollbar.
-        // candlestickChart->SetPointsPerDefaultCanvasSize(365);
-
-        candlestickChart->SetData(silverFuturesData,
-            L"Date", L"Open", L"High", L"Low", L"Close/Last");
-
-        candlestickChart->GetTitle().SetText(_(L"Silver COMEX 2021 Trend"));
-
-        candlestickChart->SetCanvasMargins(5, 5, 5, 5);
-        subframe->m_canvas->SetFixedObject(0, 0, candlestickChart);
+        DemoGraphs::BuildCandlestickPlot(subframe->m_canvas, silverFuturesData);
         }
     // Bar Chart
     else if (event.GetId() == MyApp::ID_NEW_BARCHART)
@@ -1114,53 +952,16 @@ void MyFrame::OnNewWindow(wxCommandEvent& event)
     else if (event.GetId() == MyApp::ID_NEW_PIECHART_GROUPED)
         {
         subframe->SetTitle(_(L"Pie Chart (with Subgroup)"));
-        subframe->m_canvas->SetFixedObjectsGridSize(1, 2);
-        auto pieData = std::make_shared<Data::Dataset>();
+        std::shared_ptr<Data::Dataset> pieData;
         try
-            {
-            pieData->ImportCSV(appDir + L"/datasets/Fall Enrollment.csv",
-                ImportInfo().
-                ContinuousColumns({ L"Enrollment" }).
-                CategoricalColumns({
-                    { L"Course", CategoricalImportMethod::ReadAsStrings },
-                    { L"COLLEGE", CategoricalImportMethod::ReadAsStrings }
-                    }));
-            }
+            { pieData = DemoGraphs::LoadGroupedPieChartData(appDir + L"/datasets"); }
         catch (const std::exception& err)
             {
-            wxMessageBox(wxString::FromUTF8(wxString::FromUTF8(err.what())),
+            wxMessageBox(wxString::FromUTF8(err.what()),
                          _(L"Import Error"), wxOK|wxICON_ERROR|wxCENTRE);
             return;
             }
-        auto plot = std::make_shared<PieChart>(subframe->m_canvas);
-        plot->SetData(pieData, L"Enrollment", L"COLLEGE", L"Course");
-
-        // find a group from the outer ring and add a description to it
-        auto foundSlice = std::find(plot->GetOuterPie().begin(),
-                                    plot->GetOuterPie().end(), PieChart::SliceInfo{ L"English" });
-        if (foundSlice != plot->GetOuterPie().end())
-            { foundSlice->SetDescription(_(L"Includes both literary and composition courses")); }
-        // turn off all but one of the outer labels for the inner ring
-        // to draw attention to it
-        std::for_each(plot->GetInnerPie().begin(), plot->GetInnerPie().end(),
-            [](auto& slice) noexcept
-                {
-                if (slice.GetGroupLabel().CmpNoCase(L"Visual Basic.NET") != 0)
-                    { slice.ShowGroupLabel(false); }
-                }
-            );
-
-        // apply the slice's colors to its respective outside label
-        plot->UseColorLabels(true);
-
-        subframe->m_canvas->SetFixedObject(0, 0, plot);
-        // add a legend for the inner ring (i.e., the subgroup column,
-        // which will also show headers for their parent groups)
-        subframe->m_canvas->SetFixedObject(0, 1,
-            plot->CreateLegend(
-                LegendOptions().
-                    RingPerimeter(Perimeter::Inner).
-                    PlacementHint(LegendCanvasPlacementHint::RightOfGraph)) );
+        DemoGraphs::BuildGroupedPieChart(subframe->m_canvas, pieData);
         }
     // Donut Chart (with Subgroup)
     else if (event.GetId() == MyApp::ID_NEW_DONUTCHART_GROUPED)
@@ -1226,47 +1027,16 @@ void MyFrame::OnNewWindow(wxCommandEvent& event)
     else if (event.GetId() == MyApp::ID_NEW_LR_ROADMAP_GRAPH)
         {
         subframe->SetTitle(_(L"Linear Regression Roadmap"));
-        subframe->m_canvas->SetFixedObjectsGridSize(2, 1);
-
-        auto roadmapData = std::make_shared<Data::Dataset>();
+        std::shared_ptr<Data::Dataset> roadmapData;
         try
-            {
-            roadmapData->ImportCSV(appDir + L"/datasets/First-Year Osprey.csv",
-                ImportInfo().
-                ContinuousColumns({ L"coefficient" }).
-                CategoricalColumns({ { L"factor", CategoricalImportMethod::ReadAsStrings } }));
-            }
+            { roadmapData = DemoGraphs::LoadLRRoadmapData(appDir + L"/datasets"); }
         catch (const std::exception& err)
             {
-            wxMessageBox(wxString::FromUTF8(wxString::FromUTF8(err.what())),
+            wxMessageBox(wxString::FromUTF8(err.what()),
                          _(L"Import Error"), wxOK|wxICON_ERROR|wxCENTRE);
             return;
             }
-
-        auto roadmap = std::make_shared<LRRoadmap>(subframe->m_canvas);
-        roadmap->SetData(roadmapData, L"factor", L"coefficient",
-            std::nullopt, std::nullopt, std::nullopt, _(L"GPA"));
-        roadmap->SetCanvasMargins(5, 5, 5, 5);
-        // add the default caption explaining how to read the graph
-        roadmap->AddDefaultCaption();
-        roadmap->GetTitle().SetText(_(L"First-Year Osprey Roadmap\n"
-            "How do background characteristics and decisions affect First - Year Students' GPA?"));
-        // add a title with a blue banner background and white font
-        roadmap->GetTitle().GetHeaderInfo().Enable(true).FontColor(*wxWHITE).GetFont().MakeBold();
-        roadmap->GetTitle().SetPadding(5, 5, 5, 5);
-        roadmap->GetTitle().SetFontColor(*wxWHITE);
-        roadmap->GetTitle().SetFontBackgroundColor(ColorBrewer::GetColor(Colors::Color::NavyBlue));
-
-        subframe->m_canvas->SetFixedObject(0, 0, roadmap);
-
-        // add the legend at the bottom (beneath the explanatory caption)
-        auto legend = roadmap->CreateLegend(
-            LegendOptions().
-                IncludeHeader(true).
-                PlacementHint(LegendCanvasPlacementHint::AboveOrBeneathGraph));
-        subframe->m_canvas->SetFixedObject(1, 0, legend);
-
-        subframe->m_canvas->CalcRowDimensions();
+        DemoGraphs::BuildLRRoadmap(subframe->m_canvas, roadmapData);
         }
     // SWOT Roadmap
     else if (event.GetId() == MyApp::ID_NEW_PROCON_ROADMAP_GRAPH)
@@ -1491,55 +1261,16 @@ void MyFrame::OnNewWindow(wxCommandEvent& event)
     else if (event.GetId() == MyApp::ID_NEW_LIKERT_7POINT)
         {
         subframe->SetTitle(_(L"Likert Chart (7-Point Scale)"));
-        subframe->m_canvas->SetFixedObjectsGridSize(1, 2);
-
-        // import the dataset (this is available in the "datasets" folder)
-        auto surveyData = std::make_shared<Data::Dataset>();
+        std::shared_ptr<Data::Dataset> surveyData;
         try
-            {
-            surveyData->ImportCSV(appDir + L"/datasets/Graph Library Survey.csv",
-                Data::ImportInfo().
-                CategoricalColumns(
-                    {
-                    { L"I am happy with my current graphics library",
-                      CategoricalImportMethod::ReadAsIntegers },
-                    { L"Customization is important to me",
-                        CategoricalImportMethod::ReadAsIntegers },
-                    { L"A simple API is important to me",
-                        CategoricalImportMethod::ReadAsIntegers },
-                    { L"Support for obscure graphs is important to me",
-                        CategoricalImportMethod::ReadAsIntegers },
-                    { L"Extensibility is important to me",
-                        CategoricalImportMethod::ReadAsIntegers },
-                    { LR"(Standard, "out-of-the-box" graph support is important to me)",
-                        CategoricalImportMethod::ReadAsIntegers },
-                    { L"Data importing features are important to me",
-                        CategoricalImportMethod::ReadAsIntegers }
-                    }));
-            }
+            { surveyData = DemoGraphs::LoadLikert7PointData(appDir + L"/datasets"); }
         catch (const std::exception& err)
             {
-            wxMessageBox(wxString::FromUTF8(wxString::FromUTF8(err.what())),
-                         _(L"Import Error"), wxOK | wxICON_ERROR | wxCENTRE);
+            wxMessageBox(wxString::FromUTF8(err.what()),
+                         _(L"Import Error"), wxOK|wxICON_ERROR|wxCENTRE);
             return;
             }
-
-        // Because the responses in the dataset were coded 1-7, we will need to
-        // add meaningful labels to the dataset. The following will add stock
-        // labels to represent the responses.
-        LikertChart::SetLabels(surveyData,
-            surveyData->GetCategoricalColumnNames(),
-            LikertChart::CreateLabels(LikertChart::LikertSurveyQuestionFormat::SevenPoint));
-
-        auto likertChart = std::make_shared<LikertChart>(subframe->m_canvas,
-            LikertChart::LikertSurveyQuestionFormat::SevenPoint);
-        likertChart->SetData(surveyData, surveyData->GetCategoricalColumnNames());
-
-        subframe->m_canvas->SetFixedObject(0, 0, likertChart);
-        subframe->m_canvas->SetFixedObject(0, 1,
-            likertChart->CreateLegend(
-                LegendOptions().
-                    PlacementHint(LegendCanvasPlacementHint::RightOfGraph)) );
+        DemoGraphs::BuildLikert7PointChart(subframe->m_canvas, surveyData);
 
         // when printing, make it landscape and stretch it to fill the entire page
         subframe->m_canvas->GetPrinterData().SetOrientation(wxPrintOrientation::wxLANDSCAPE);
@@ -1716,75 +1447,16 @@ void MyFrame::OnNewWindow(wxCommandEvent& event)
     else if (event.GetId() == MyApp::ID_NEW_TABLE)
         {
         subframe->SetTitle(_(L"Table"));
-        subframe->m_canvas->SetFixedObjectsGridSize(1, 1);
-
-        auto juniorSeniorMajors = std::make_shared<Data::Dataset>();
+        std::shared_ptr<Data::Dataset> juniorSeniorMajors;
         try
-            {
-            juniorSeniorMajors->ImportCSV(appDir + L"/datasets/Tables/Junior & Senior Majors (Top 20).csv",
-                ImportInfo().
-                ContinuousColumns({ L"Female", L"Male" }).
-                CategoricalColumns({
-                    { L"Division" },
-                    { L"Department" }
-                    }));
-            }
+            { juniorSeniorMajors = DemoGraphs::LoadTableData(appDir + L"/datasets"); }
         catch (const std::exception& err)
             {
-            wxMessageBox(wxString::FromUTF8(wxString::FromUTF8(err.what())),
+            wxMessageBox(wxString::FromUTF8(err.what()),
                          _(L"Import Error"), wxOK|wxICON_ERROR|wxCENTRE);
             return;
             }
-
-        auto tableGraph = std::make_shared<Table>(subframe->m_canvas);
-        tableGraph->SetData(juniorSeniorMajors,
-            { L"Division", L"Department", L"Female", L"Male" });
-        // group the schools together in the first row
-        tableGraph->GroupColumn(0);
-
-        // add ratio aggregate column and group row totals
-        const wxColour aggColumnBkColor =
-            ColorBrewer::GetColor(Colors::Color::LightGray,
-                                  Settings::GetTranslucencyValue());
-        tableGraph->InsertAggregateColumn(Table::AggregateInfo(Table::AggregateType::Ratio),
-                                          _(L"Ratio"), std::nullopt, aggColumnBkColor);
-        tableGraph->InsertRowTotals(aggColumnBkColor);
-
-        // make the headers and row groups bold (and center the headers)
-        tableGraph->BoldRow(0);
-        tableGraph->BoldColumn(0);
-        tableGraph->CenterRowHorizontally(0);
-
-        const auto& ratioOutliers =
-            // Find outlier in the female-to-male ratios for the majors.
-            // (Note that we use a more liberal search, considering
-            // z-scores > 2 as being outliers
-            tableGraph->GetOutliers(tableGraph->GetColumnCount()-1, 2);
-        // if any outliers, make a note of it off to the side
-        if (ratioOutliers.size())
-            {
-            tableGraph->AddCellAnnotation(
-                { L"Majors with the most lopsided female-to-male ratios",
-                   ratioOutliers, Side::Right }
-                );
-            }
-
-        // if you also want to place annotations on the left of the table,
-        // then center it within its drawing area like so:
-        // tableGraph->SetPageHorizontalAlignment(PageHorizontalAlignment::Centered);
-
-        // add a title
-        subframe->m_canvas->GetTopTitles().push_back(Label(
-            GraphItemInfo(_(L"Top 20 Majors for Juniors & Seniors (AY2021-22)")).
-            Padding(5, 5, 5, 5).Pen(wxNullPen).
-            ChildAlignment(RelativeAlignment::FlushLeft).
-            FontBackgroundColor(ColorBrewer::GetColor(Color::MossGreen))) );
-
-        tableGraph->GetCaption().SetText(_(L"Source: Office of Institutional Research"));
-        tableGraph->GetCaption().SetPadding(5, 5, 5, 5);
-
-        // add the table to the canvas
-        subframe->m_canvas->SetFixedObject(0, 0, tableGraph);
+        DemoGraphs::BuildTable(subframe->m_canvas, juniorSeniorMajors);
 
         // make the canvas tall since it's a long table, but not very wide
         subframe->m_canvas->SetCanvasMinHeightDIPs(
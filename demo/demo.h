@@ -23,6 +23,7 @@
 #include "../src/base/label.h"
 #include "../src/import/text_matrix.h"
 #include "../src/util/logfile.h"
+#include "../src/util/measuringdc.h"
 #include "../src/graphs/barchart.h"
 #include "../src/graphs/boxplot.h"
 #include "../src/graphs/histogram.h"
@@ -37,12 +38,14 @@
 #include "../src/graphs/lrroadmap.h"
 #include "../src/graphs/proconroadmap.h"
 #include "../src/graphs/table.h"
+#include "demographs.h"
 
 // Define a new application
 class MyApp final : public wxApp
     {
 public:
     virtual bool OnInit() final;
+    virtual int OnExit() final;
     static constexpr int ID_NEW_BOXPLOT{ wxID_HIGHEST+1 };
     static constexpr int ID_NEW_HISTOGRAM{ wxID_HIGHEST+2 };
     static constexpr int ID_NEW_GANTT{ wxID_HIGHEST+3 };
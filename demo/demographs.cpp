@@ -0,0 +1,457 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        demographs.cpp
+// Purpose:     Graphs shared by the demo and the render harness
+// Author:      Blake Madden
+// Created:     10/15/2026
+// Copyright:   (c) Blake Madden
+// Licence:     3-Clause BSD licence
+// SPDX-License-Identifier: BSD-3-Clause
+/////////////////////////////////////////////////////////////////////////////
+
+#include "demographs.h"
+#include <wx/filename.h>
+#include <algorithm>
+#include "../src/graphs/boxplot.h"
+#include "../src/graphs/candlestickplot.h"
+#include "../src/graphs/ganttchart.h"
+#include "../src/graphs/heatmap.h"
+#include "../src/graphs/likertchart.h"
+#include "../src/graphs/lineplot.h"
+#include "../src/graphs/lrroadmap.h"
+#include "../src/graphs/piechart.h"
+#include "../src/graphs/table.h"
+
+using namespace Wisteria;
+using namespace Wisteria::Colors;
+using namespace Wisteria::Graphs;
+using namespace Wisteria::GraphItems;
+using namespace Wisteria::Data;
+
+namespace
+    {
+    // imports a CSV file from the datasets folder
+    std::shared_ptr<Dataset> ImportCsv(const wxString& datasetsFolder, const wxString& fileName,
+                                       const ImportInfo& info)
+        {
+        auto dataset = std::make_shared<Dataset>();
+        dataset->ImportCSV(wxFileName(datasetsFolder, fileName).GetFullPath(), info);
+        return dataset;
+        }
+    }
+
+namespace DemoGraphs
+    {
+    //----------------------------------------------------------
+    std::shared_ptr<Dataset> LoadBoxPlotData(const wxString& datasetsFolder)
+        {
+        return ImportCsv(datasetsFolder, L"mpg.csv",
+            ImportInfo().ContinuousColumns({ L"hwy" }).
+            CategoricalColumns({
+                { L"class", CategoricalImportMethod::ReadAsStrings },
+                { L"manufacturer", CategoricalImportMethod::ReadAsStrings } }));
+        }
+
+    //----------------------------------------------------------
+    void BuildBoxPlot(Canvas* canvas, const std::shared_ptr<const Dataset>& data)
+        {
+        canvas->SetFixedObjectsGridSize(1, 1);
+        auto plot = std::make_shared<BoxPlot>(canvas);
+
+        plot->SetData(data,
+                      L"hwy",
+                      // leave this as std::nullopt to not create grouped boxes
+                      L"class");
+
+        // Show all points (not just outliers).
+        // The points within the boxes and whiskers will be
+        // bee-swarm jittering to visualize the distribution.
+        plot->ShowAllPoints(true);
+
+        canvas->SetFixedObject(0, 0, plot);
+        }
+
+    //----------------------------------------------------------
+    std::shared_ptr<Dataset> LoadGroupedHeatMapData(const wxString& datasetsFolder)
+        {
+        return ImportCsv(datasetsFolder, L"Student Scores.csv",
+            ImportInfo().
+            ContinuousColumns({ L"test_score" }).
+            IdColumn(L"Week").
+            CategoricalColumns({ { L"Name", CategoricalImportMethod::ReadAsStrings } }));
+        }
+
+    //----------------------------------------------------------
+    void BuildGroupedHeatMap(Canvas* canvas, const std::shared_ptr<const Dataset>& data)
+        {
+        canvas->SetFixedObjectsGridSize(1, 2);
+        auto plot = std::make_shared<HeatMap>(canvas);
+        // add a title to the plot
+        plot->GetTitle().GetGraphItemInfo().Text(_(L"Test Scores")).
+            ChildAlignment(RelativeAlignment::FlushLeft).
+            Pen(wxNullPen).Padding(4, 0, 0, 4).
+            Font(wxFont(wxSystemSettings::GetFont(wxSYS_DEFAULT_GUI_FONT)).
+                 MakeLarger());
+
+        // use group and put all of the students' heatmaps into one column
+        plot->SetData(data, L"TEST_SCORE", L"Name", 1);
+        // say "Students" at the top instead of "Groups"
+        plot->SetGroupHeaderPrefix(_(L"Students"));
+
+        canvas->SetFixedObject(0, 0, plot);
+        // customize the header of the legend and add it to the canvas
+        auto legend{ plot->CreateLegend(
+            LegendOptions().
+                IncludeHeader(true).
+                PlacementHint(LegendCanvasPlacementHint::RightOfGraph)) };
+        canvas->SetFixedObject(0, 1, legend);
+        }
+
+    //----------------------------------------------------------
+    std::shared_ptr<Dataset> LoadLinePlotData(const wxString& datasetsFolder)
+        {
+        return ImportCsv(datasetsFolder, L"Spelling Grades.csv",
+            ImportInfo().
+            // first the Y column
+            ContinuousColumns({ L"AVG_GRADE"}).
+            // group and X
+            CategoricalColumns({
+                { L"Gender", CategoricalImportMethod::ReadAsStrings },
+                { L"WEEK_NAME", CategoricalImportMethod::ReadAsStrings }
+                }));
+        }
+
+    //----------------------------------------------------------
+    void BuildLinePlot(Canvas* canvas, const std::shared_ptr<const Dataset>& data)
+        {
+        canvas->SetFixedObjectsGridSize(1, 2);
+        auto linePlot = std::make_shared<LinePlot>(canvas,
+            // use a different color scheme
+            std::make_shared<Colors::Schemes::Decade1960s>(),
+            // or create your own scheme
+            // std::make_shared<Colors::Schemes::ColorScheme>
+            //     (Colors::Schemes::ColorScheme{
+            //         ColorBrewer::GetColor(Colors::Color::Auburn),
+            //         ColorBrewer::GetColor(Colors::Color::OctoberMist) }),
+
+            // turn off markers by using a shape scheme filled with blank icons
+            // (having just one icon in this scheme will get recycled for each line)
+            std::make_shared<IconShapeScheme>(IconShapeScheme{IconShape::BlankIcon}));
+        // add padding around the plot
+        linePlot->SetCanvasMargins(5, 5, 5, 5);
+
+        // Set the data and use the grouping column from the dataset to create separate lines.
+        // Also, use a categorical column for the X axis.
+        linePlot->SetData(data, L"AVG_GRADE", L"WEEK_NAME", L"Gender");
+
+        // add some titles
+        linePlot->GetTitle().SetText(_(L"Average Grades"));
+        linePlot->GetSubtitle().SetText(_(L"Average grades taken from\n"
+                                           "last 5 weeks' spelling tests."));
+        linePlot->GetCaption().SetText(_(L"Note: not all grades have been\n"
+                                          "entered yet for last week."));
+        // remove default titles
+        linePlot->GetBottomXAxis().GetTitle().SetText(L"");
+        linePlot->GetLeftYAxis().GetTitle().SetText(L"");
+
+        // add the line plot and its legend to the canvas
+        canvas->SetFixedObject(0, 0, linePlot);
+        canvas->SetFixedObject(0, 1,
+            linePlot->CreateLegend(
+                LegendOptions().
+                    IncludeHeader(true).
+                    PlacementHint(LegendCanvasPlacementHint::RightOfGraph)) );
+        }
+
+    //----------------------------------------------------------
+    std::shared_ptr<Dataset> LoadGanttChartData(const wxString& datasetsFolder)
+        {
+        return ImportCsv(datasetsFolder, L"Company Acquisition.csv",
+            ImportInfo().
+            ContinuousColumns({ L"Completion" }).
+            DateColumns({ { L"Start" }, { L"End" } }).
+            CategoricalColumns({
+                { L"Task" },
+                { L"Description" },
+                { L"Resource" }
+                }));
+        }
+
+    //----------------------------------------------------------
+    void BuildGanttChart(Canvas* canvas, const std::shared_ptr<const Dataset>& data)
+        {
+        canvas->SetFixedObjectsGridSize(1, 2);
+        auto ganttChart = std::make_shared<GanttChart>(canvas,
+            // use a different color scheme where the colors
+            // stand out more from each other
+            std::make_shared<Colors::Schemes::Decade1920s>());
+        ganttChart->SetData(data,
+            DateInterval::FiscalQuarterly, FiscalYear::USBusiness,
+            L"Task", L"Start", "End",
+            // these columns are optional
+            L"Resource", L"Description", L"Completion", L"Resource");
+
+        // add deadlines
+        auto releaseDate = ganttChart->GetScalingAxis().GetPointFromDate(
+            wxDateTime(25, wxDateTime::Dec, 2022));
+        if (releaseDate)
+            {
+            ganttChart->AddReferenceLine(ReferenceLine(AxisType::BottomXAxis,
+                releaseDate.value(), _(L"Release"),
+                ColorBrewer::GetColor(Colors::Color::TractorRed)) );
+            }
+
+        auto updateReleaseDate = ganttChart->GetScalingAxis().GetPointFromDate(
+            wxDateTime(15, wxDateTime::Mar, 2023));
+        if (updateReleaseDate)
+            {
+            ganttChart->AddReferenceLine(ReferenceLine(AxisType::BottomXAxis,
+                updateReleaseDate.value(),
+                _(L"Hotfix Release"),
+                ColorBrewer::GetColor(Colors::Color::TractorRed,
+                                      Wisteria::Settings::GetTranslucencyValue())));
+            }
+
+        ganttChart->SetCanvasMargins(5, 5, 5, 5);
+        canvas->SetFixedObject(0, 0, ganttChart);
+        // add a legend, showing whom is assigned to which tasks
+        canvas->SetFixedObject(0, 1,
+            ganttChart->CreateLegend(
+                LegendOptions().
+                    IncludeHeader(false).
+                    PlacementHint(LegendCanvasPlacementHint::RightOfGraph)));
+        }
+
+    //----------------------------------------------------------
+    std::shared_ptr<Dataset> LoadCandlestickPlotData(const wxString& datasetsFolder)
+        {
+        return ImportCsv(datasetsFolder, L"Silver Futures.csv",
+            ImportInfo().
+            ContinuousColumns({ L"Open", L"High", L"Low", L"Close/Last" }).
+            DateColumns({ { L"Date" } }));
+        }
+
+    //----------------------------------------------------------
+    void BuildCandlestickPlot(Canvas* canvas, const std::shared_ptr<const Dataset>& data)
+        {
+        canvas->SetFixedObjectsGridSize(1, 1);
+        auto candlestickChart = std::make_shared<CandlestickPlot>(canvas);
+        // Chart's left axis will start at zero by default so that the scale
+        // isn't misleading; you can, however, turn that off like this
+        // to better see the daily activity.
+        // This should be done before calling SetData() so that it bases
+        // axis range on the data.
+        candlestickChart->GetLeftYAxis().StartAtZero(false);
+
+        // Uncomment this to fit the entire year onto the canvas
+        // so that there isn't a scrollbar.
+        // candlestickChart->SetPointsPerDefaultCanvasSize(365);
+
+        candlestickChart->SetData(data,
+            L"Date", L"Open", L"High", L"Low", L"Close/Last");
+
+        candlestickChart->GetTitle().SetText(_(L"Silver COMEX 2021 Trend"));
+
+        candlestickChart->SetCanvasMargins(5, 5, 5, 5);
+        canvas->SetFixedObject(0, 0, candlestickChart);
+        }
+
+    //----------------------------------------------------------
+    std::shared_ptr<Dataset> LoadGroupedPieChartData(const wxString& datasetsFolder)
+        {
+        return ImportCsv(datasetsFolder, L"Fall Enrollment.csv",
+            ImportInfo().
+            ContinuousColumns({ L"Enrollment" }).
+            CategoricalColumns({
+                { L"Course", CategoricalImportMethod::ReadAsStrings },
+                { L"COLLEGE", CategoricalImportMethod::ReadAsStrings }
+                }));
+        }
+
+    //----------------------------------------------------------
+    void BuildGroupedPieChart(Canvas* canvas, const std::shared_ptr<const Dataset>& data)
+        {
+        canvas->SetFixedObjectsGridSize(1, 2);
+        auto plot = std::make_shared<PieChart>(canvas);
+        plot->SetData(data, L"Enrollment", L"COLLEGE", L"Course");
+
+        // find a group from the outer ring and add a description to it
+        auto foundSlice = std::find(plot->GetOuterPie().begin(),
+                                    plot->GetOuterPie().end(), PieChart::SliceInfo{ L"English" });
+        if (foundSlice != plot->GetOuterPie().end())
+            { foundSlice->SetDescription(_(L"Includes both literary and composition courses")); }
+        // turn off all but one of the outer labels for the inner ring
+        // to draw attention to it
+        std::for_each(plot->GetInnerPie().begin(), plot->GetInnerPie().end(),
+            [](auto& slice) noexcept
+                {
+                if (slice.GetGroupLabel().CmpNoCase(L"Visual Basic.NET") != 0)
+                    { slice.ShowGroupLabel(false); }
+                }
+            );
+
+        // apply the slice's colors to its respective outside label
+        plot->UseColorLabels(true);
+
+        canvas->SetFixedObject(0, 0, plot);
+        // add a legend for the inner ring (i.e., the subgroup column,
+        // which will also show headers for their parent groups)
+        canvas->SetFixedObject(0, 1,
+            plot->CreateLegend(
+                LegendOptions().
+                    RingPerimeter(Perimeter::Inner).
+                    PlacementHint(LegendCanvasPlacementHint::RightOfGraph)) );
+        }
+
+    //----------------------------------------------------------
+    std::shared_ptr<Dataset> LoadLRRoadmapData(const wxString& datasetsFolder)
+        {
+        return ImportCsv(datasetsFolder, L"First-Year Osprey.csv",
+            ImportInfo().
+            ContinuousColumns({ L"coefficient" }).
+            CategoricalColumns({ { L"factor", CategoricalImportMethod::ReadAsStrings } }));
+        }
+
+    //----------------------------------------------------------
+    void BuildLRRoadmap(Canvas* canvas, const std::shared_ptr<const Dataset>& data)
+        {
+        canvas->SetFixedObjectsGridSize(2, 1);
+        auto roadmap = std::make_shared<LRRoadmap>(canvas);
+        roadmap->SetData(data, L"factor", L"coefficient",
+            std::nullopt, std::nullopt, std::nullopt, _(L"GPA"));
+        roadmap->SetCanvasMargins(5, 5, 5, 5);
+        // add the default caption explaining how to read the graph
+        roadmap->AddDefaultCaption();
+        roadmap->GetTitle().SetText(_(L"First-Year Osprey Roadmap\n"
+            "How do background characteristics and decisions affect First - Year Students' GPA?"));
+        // add a title with a blue banner background and white font
+        roadmap->GetTitle().GetHeaderInfo().Enable(true).FontColor(*wxWHITE).GetFont().MakeBold();
+        roadmap->GetTitle().SetPadding(5, 5, 5, 5);
+        roadmap->GetTitle().SetFontColor(*wxWHITE);
+        roadmap->GetTitle().SetFontBackgroundColor(ColorBrewer::GetColor(Colors::Color::NavyBlue));
+
+        canvas->SetFixedObject(0, 0, roadmap);
+
+        // add the legend at the bottom (beneath the explanatory caption)
+        auto legend = roadmap->CreateLegend(
+            LegendOptions().
+                IncludeHeader(true).
+                PlacementHint(LegendCanvasPlacementHint::AboveOrBeneathGraph));
+        canvas->SetFixedObject(1, 0, legend);
+
+        canvas->CalcRowDimensions();
+        }
+
+    //----------------------------------------------------------
+    std::shared_ptr<Dataset> LoadLikert7PointData(const wxString& datasetsFolder)
+        {
+        auto surveyData = ImportCsv(datasetsFolder, L"Graph Library Survey.csv",
+            ImportInfo().
+            CategoricalColumns(
+                {
+                { L"I am happy with my current graphics library",
+                  CategoricalImportMethod::ReadAsIntegers },
+                { L"Customization is important to me",
+                    CategoricalImportMethod::ReadAsIntegers },
+                { L"A simple API is important to me",
+                    CategoricalImportMethod::ReadAsIntegers },
+                { L"Support for obscure graphs is important to me",
+                    CategoricalImportMethod::ReadAsIntegers },
+                { L"Extensibility is important to me",
+                    CategoricalImportMethod::ReadAsIntegers },
+                { LR"(Standard, "out-of-the-box" graph support is important to me)",
+                    CategoricalImportMethod::ReadAsIntegers },
+                { L"Data importing features are important to me",
+                    CategoricalImportMethod::ReadAsIntegers }
+                }));
+
+        // Because the responses in the dataset were coded 1-7, we will need to
+        // add meaningful labels to the dataset. The following will add stock
+        // labels to represent the responses.
+        LikertChart::SetLabels(surveyData,
+            surveyData->GetCategoricalColumnNames(),
+            LikertChart::CreateLabels(LikertChart::LikertSurveyQuestionFormat::SevenPoint));
+        return surveyData;
+        }
+
+    //----------------------------------------------------------
+    void BuildLikert7PointChart(Canvas* canvas, const std::shared_ptr<const Dataset>& data)
+        {
+        canvas->SetFixedObjectsGridSize(1, 2);
+        auto likertChart = std::make_shared<LikertChart>(canvas,
+            LikertChart::LikertSurveyQuestionFormat::SevenPoint);
+        likertChart->SetData(data, data->GetCategoricalColumnNames());
+
+        canvas->SetFixedObject(0, 0, likertChart);
+        canvas->SetFixedObject(0, 1,
+            likertChart->CreateLegend(
+                LegendOptions().
+                    PlacementHint(LegendCanvasPlacementHint::RightOfGraph)) );
+        }
+
+    //----------------------------------------------------------
+    std::shared_ptr<Dataset> LoadTableData(const wxString& datasetsFolder)
+        {
+        return ImportCsv(datasetsFolder, L"Tables/Junior & Senior Majors (Top 20).csv",
+            ImportInfo().
+            ContinuousColumns({ L"Female", L"Male" }).
+            CategoricalColumns({
+                { L"Division" },
+                { L"Department" }
+                }));
+        }
+
+    //----------------------------------------------------------
+    void BuildTable(Canvas* canvas, const std::shared_ptr<const Dataset>& data)
+        {
+        canvas->SetFixedObjectsGridSize(1, 1);
+        auto tableGraph = std::make_shared<Table>(canvas);
+        tableGraph->SetData(data,
+            { L"Division", L"Department", L"Female", L"Male" });
+        // group the schools together in the first row
+        tableGraph->GroupColumn(0);
+
+        // add ratio aggregate column and group row totals
+        const wxColour aggColumnBkColor =
+            ColorBrewer::GetColor(Colors::Color::LightGray,
+                                  Settings::GetTranslucencyValue());
+        tableGraph->InsertAggregateColumn(Table::AggregateInfo(Table::AggregateType::Ratio),
+                                          _(L"Ratio"), std::nullopt, aggColumnBkColor);
+        tableGraph->InsertRowTotals(aggColumnBkColor);
+
+        // make the headers and row groups bold (and center the headers)
+        tableGraph->BoldRow(0);
+        tableGraph->BoldColumn(0);
+        tableGraph->CenterRowHorizontally(0);
+
+        const auto& ratioOutliers =
+            // Find outlier in the female-to-male ratios for the majors.
+            // (Note that we use a more liberal search, considering
+            // z-scores > 2 as being outliers
+            tableGraph->GetOutliers(tableGraph->GetColumnCount()-1, 2);
+        // if any outliers, make a note of it off to the side
+        if (ratioOutliers.size())
+            {
+            tableGraph->AddCellAnnotation(
+                { L"Majors with the most lopsided female-to-male ratios",
+                   ratioOutliers, Side::Right }
+                );
+            }
+
+        // if you also want to place annotations on the left of the table,
+        // then center it within its drawing area like so:
+        // tableGraph->SetPageHorizontalAlignment(PageHorizontalAlignment::Centered);
+
+        // add a title
+        canvas->GetTopTitles().push_back(Label(
+            GraphItemInfo(_(L"Top 20 Majors for Juniors & Seniors (AY2021-22)")).
+            Padding(5, 5, 5, 5).Pen(wxNullPen).
+            ChildAlignment(RelativeAlignment::FlushLeft).
+            FontBackgroundColor(ColorBrewer::GetColor(Color::MossGreen))) );
+
+        tableGraph->GetCaption().SetText(_(L"Source: Office of Institutional Research"));
+        tableGraph->GetCaption().SetPadding(5, 5, 5, 5);
+
+        // add the table to the canvas
+        canvas->SetFixedObject(0, 0, tableGraph);
+        }
+    }
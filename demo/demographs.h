@@ -0,0 +1,93 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        demographs.h
+// Purpose:     Graphs shared by the demo and the render harness
+// Author:      Blake Madden
+// Created:     10/15/2026
+// Copyright:   (c) Blake Madden
+// Licence:     3-Clause BSD licence
+// SPDX-License-Identifier: BSD-3-Clause
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef __DEMO_GRAPHS_H__
+#define __DEMO_GRAPHS_H__
+
+#include <wx/wx.h>
+#include <memory>
+#include "../src/base/canvas.h"
+#include "../src/data/dataset.h"
+
+/** @brief Graphs from the demo program that are also rendered by the render harness,
+        so that the harness always times what the demo shows.
+    @details Each graph has a function to import its dataset (from the bundled
+        "datasets" folder) and one to build it onto a canvas.
+        The @c Load functions throw a @c std::exception if the import fails.
+        The @c Build functions expect an empty canvas and set its grid size.\n
+        Window-specific settings (e.g., titles, watermarks, and printer settings)
+        are left to the caller.*/
+namespace DemoGraphs
+    {
+    /// @brief Imports the data for the box plot.
+    [[nodiscard]] std::shared_ptr<Wisteria::Data::Dataset>
+        LoadBoxPlotData(const wxString& datasetsFolder);
+    /// @brief Builds a box plot (grouped by class, showing all points).
+    void BuildBoxPlot(Wisteria::Canvas* canvas,
+                      const std::shared_ptr<const Wisteria::Data::Dataset>& data);
+
+    /// @brief Imports the data for the grouped heat map.
+    [[nodiscard]] std::shared_ptr<Wisteria::Data::Dataset>
+        LoadGroupedHeatMapData(const wxString& datasetsFolder);
+    /// @brief Builds a heat map (grouped by student) and its legend.
+    void BuildGroupedHeatMap(Wisteria::Canvas* canvas,
+                             const std::shared_ptr<const Wisteria::Data::Dataset>& data);
+
+    /// @brief Imports the data for the line plot.
+    [[nodiscard]] std::shared_ptr<Wisteria::Data::Dataset>
+        LoadLinePlotData(const wxString& datasetsFolder);
+    /// @brief Builds a line plot (with a categorical X axis) and its legend.
+    void BuildLinePlot(Wisteria::Canvas* canvas,
+                       const std::shared_ptr<const Wisteria::Data::Dataset>& data);
+
+    /// @brief Imports the data for the Gantt chart.
+    [[nodiscard]] std::shared_ptr<Wisteria::Data::Dataset>
+        LoadGanttChartData(const wxString& datasetsFolder);
+    /// @brief Builds a Gantt chart (with release deadlines) and its legend.
+    void BuildGanttChart(Wisteria::Canvas* canvas,
+                         const std::shared_ptr<const Wisteria::Data::Dataset>& data);
+
+    /// @brief Imports the data for the candlestick plot.
+    [[nodiscard]] std::shared_ptr<Wisteria::Data::Dataset>
+        LoadCandlestickPlotData(const wxString& datasetsFolder);
+    /// @brief Builds a candlestick plot.
+    void BuildCandlestickPlot(Wisteria::Canvas* canvas,
+                              const std::shared_ptr<const Wisteria::Data::Dataset>& data);
+
+    /// @brief Imports the data for the pie chart (with subgroups).
+    [[nodiscard]] std::shared_ptr<Wisteria::Data::Dataset>
+        LoadGroupedPieChartData(const wxString& datasetsFolder);
+    /// @brief Builds a pie chart (with an inner ring) and the inner ring's legend.
+    void BuildGroupedPieChart(Wisteria::Canvas* canvas,
+                              const std::shared_ptr<const Wisteria::Data::Dataset>& data);
+
+    /// @brief Imports the data for the linear regression roadmap.
+    [[nodiscard]] std::shared_ptr<Wisteria::Data::Dataset>
+        LoadLRRoadmapData(const wxString& datasetsFolder);
+    /// @brief Builds a linear regression roadmap and its legend.
+    void BuildLRRoadmap(Wisteria::Canvas* canvas,
+                        const std::shared_ptr<const Wisteria::Data::Dataset>& data);
+
+    /// @brief Imports (and labels) the data for the 7-point Likert chart.
+    [[nodiscard]] std::shared_ptr<Wisteria::Data::Dataset>
+        LoadLikert7PointData(const wxString& datasetsFolder);
+    /// @brief Builds a 7-point Likert chart and its legend.
+    void BuildLikert7PointChart(Wisteria::Canvas* canvas,
+                                const std::shared_ptr<const Wisteria::Data::Dataset>& data);
+
+    /// @brief Imports the data for the table.
+    [[nodiscard]] std::shared_ptr<Wisteria::Data::Dataset>
+        LoadTableData(const wxString& datasetsFolder);
+    /// @brief Builds a table (with aggregates and annotations).
+    void BuildTable(Wisteria::Canvas* canvas,
+                    const std::shared_ptr<const Wisteria::Data::Dataset>& data);
+    }
+
+#endif //__DEMO_GRAPHS_H__
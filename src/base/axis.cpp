@@ -7,6 +7,8 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "axis.h"
+#include "../util/numberformatcache.h"
+#include <execution>
 
 namespace Wisteria::GraphItems
     {
@@ -73,6 +75,7 @@ namespace Wisteria::GraphItems
             {
             m_axisLabels.clear();
             m_customAxisLabels.clear();
+            m_customDateLabels.clear();
             m_tickMarks.clear();
             m_customTickMarks.clear();
             m_labelSpacingPhysicalOffset = 0;
@@ -88,7 +91,7 @@ namespace Wisteria::GraphItems
             m_tickMarkDisplayInterval = 1;
             m_minorTickMarkLength = 5;
             m_majorTickMarkLength = 10;
-            m_widestLabel = m_tallestLabel = Label(GraphItemInfo().Ok(false));
+            ResetLabelMeasurements();
             }
         if (level == AxisResetLevel::AllSettings)
             {
@@ -304,6 +307,7 @@ namespace Wisteria::GraphItems
             { m_maxHeight = rect.GetHeight(); }
         else if (IsVertical())
             { m_maxWidth = rect.GetWidth(); }
+        InvalidateCachedBoundingBox();
         }
 
     wxRect Axis::GetProtrudingBoundingBox(wxDC& dc) const
@@ -336,18 +340,19 @@ namespace Wisteria::GraphItems
         wxCoord firstLabelPhysicalPos{ 0 };
         if (!std::isnan(firstLabelPosition) && GetPhysicalCoordinate(firstLabelPosition, firstLabelPhysicalPos))
             {
+            const wxSize firstLabelSize = GetOuterLabelSize(dc, firstLabel, true);
             const auto spaceToStart = firstLabelPhysicalPos - GetLeftPoint().x;
             if (GetAxisLabelOrientation() == AxisLabelOrientation::Parallel)
                 {
                 if (GetParallelLabelAlignment() == RelativeAlignment::FlushRight)
-                    { topLeftCorner.x -= firstLabel.GetBoundingBox(dc).GetWidth()-spaceToStart; }
+                    { topLeftCorner.x -= firstLabelSize.GetWidth()-spaceToStart; }
                 else if (GetParallelLabelAlignment() == RelativeAlignment::Centered)
-                    { topLeftCorner.x -= (firstLabel.GetBoundingBox(dc).GetWidth()/2)-spaceToStart; }
+                    { topLeftCorner.x -= (firstLabelSize.GetWidth()/2)-spaceToStart; }
                 // FlushLeft needs no space on the left outer side
                 }
             else
                 {
-                topLeftCorner.x -= (firstLabel.GetBoundingBox(dc).GetHeight()/2)-spaceToStart;
+                topLeftCorner.x -= (firstLabelSize.GetHeight()/2)-spaceToStart;
                 }
             }
         // the last (far most right) axis label
@@ -355,18 +360,19 @@ namespace Wisteria::GraphItems
         wxCoord lastLabelPhysicalPos{ 0 };
         if (!std::isnan(lastLabelPosition) && GetPhysicalCoordinate(lastLabelPosition, lastLabelPhysicalPos))
             {
+            const wxSize lastLabelSize = GetOuterLabelSize(dc, lastLabel, false);
             const auto spaceToEnd = GetRightPoint().x - lastLabelPhysicalPos;
             if (GetAxisLabelOrientation() == AxisLabelOrientation::Parallel)
                 {
                 if (GetParallelLabelAlignment() == RelativeAlignment::FlushLeft)
-                    { bottomRightCorner.x += lastLabel.GetBoundingBox(dc).GetWidth()-spaceToEnd; }
+                    { bottomRightCorner.x += lastLabelSize.GetWidth()-spaceToEnd; }
                 else if (GetParallelLabelAlignment() == RelativeAlignment::Centered)
-                    { bottomRightCorner.x += (lastLabel.GetBoundingBox(dc).GetWidth()/2)-spaceToEnd; }
+                    { bottomRightCorner.x += (lastLabelSize.GetWidth()/2)-spaceToEnd; }
                 // FlushRight needs no space on the right outer side
                 }
             else
                 {
-                bottomRightCorner.x += (lastLabel.GetBoundingBox(dc).GetHeight()/2)-spaceToEnd;
+                bottomRightCorner.x += (lastLabelSize.GetHeight()/2)-spaceToEnd;
                 }
             }
         }
@@ -379,18 +385,19 @@ namespace Wisteria::GraphItems
         wxCoord firstLabelPhysicalPos{ 0 };
         if (!std::isnan(firstLabelPosition) && GetPhysicalCoordinate(firstLabelPosition, firstLabelPhysicalPos))
             {
+            const wxSize firstLabelSize = GetOuterLabelSize(dc, firstLabel, true);
             const auto spaceToStart = GetBottomPoint().y - firstLabelPhysicalPos;
             if (GetAxisLabelOrientation() == AxisLabelOrientation::Parallel)
                 {
                 if (GetParallelLabelAlignment() == RelativeAlignment::FlushBottom)
-                    { bottomRightCorner.y += firstLabel.GetBoundingBox(dc).GetWidth()-spaceToStart; }
+                    { bottomRightCorner.y += firstLabelSize.GetWidth()-spaceToStart; }
                 else if (GetParallelLabelAlignment() == RelativeAlignment::Centered)
-                    { bottomRightCorner.y += (firstLabel.GetBoundingBox(dc).GetWidth()/2)-spaceToStart; }
+                    { bottomRightCorner.y += (firstLabelSize.GetWidth()/2)-spaceToStart; }
                 // FlushTop needs no space on the upper outside
                 }
             else
                 {
-                bottomRightCorner.y += (firstLabel.GetBoundingBox(dc).GetHeight()/2)-spaceToStart;
+                bottomRightCorner.y += (firstLabelSize.GetHeight()/2)-spaceToStart;
                 }
             }
         // the last (far most top) axis label
@@ -398,24 +405,44 @@ namespace Wisteria::GraphItems
         wxCoord lastLabelPhysicalPos{ 0 };
         if (!std::isnan(lastLabelPosition) && GetPhysicalCoordinate(lastLabelPosition, lastLabelPhysicalPos))
             {
+            const wxSize lastLabelSize = GetOuterLabelSize(dc, lastLabel, false);
             const auto spaceToEnd = lastLabelPhysicalPos - GetTopPoint().y;
             if (GetAxisLabelOrientation() == AxisLabelOrientation::Parallel)
                 {
                 if (GetParallelLabelAlignment() == RelativeAlignment::FlushTop)
-                    { topLeftCorner.y -= lastLabel.GetBoundingBox(dc).GetWidth(); }
+                    { topLeftCorner.y -= lastLabelSize.GetWidth(); }
                 else if (GetParallelLabelAlignment() == RelativeAlignment::Centered)
-                    { topLeftCorner.y -= lastLabel.GetBoundingBox(dc).GetWidth()/2; }
+                    { topLeftCorner.y -= lastLabelSize.GetWidth()/2; }
                 // FlushBottom needs no space on the lower outer side
                 }
             else
                 {
-                topLeftCorner.y -= (lastLabel.GetBoundingBox(dc).GetHeight()/2)-spaceToEnd;
+                topLeftCorner.y -= (lastLabelSize.GetHeight()/2)-spaceToEnd;
                 }
             }
         }
 
     //-------------------------------------------
     wxRect Axis::GetBoundingBox(wxDC& dc) const
+        {
+        // measuring the labels, brackets, and titles is expensive and the bounding box
+        // is requested several times per layout (e.g., Graph2D::AdjustPlotArea()),
+        // so reuse the last one until a setter or a different DC invalidates it
+        double userScaleX{ 1 }, userScaleY{ 1 };
+        dc.GetUserScale(&userScaleX, &userScaleY);
+        const BoundingBoxMeasurementKey key{ dc.GetPPI(), dc.GetContentScaleFactor(),
+                                             userScaleX, userScaleY, IsShown() };
+        if (!GetCachedBoundingBox().IsEmpty() && key == m_cachedBoundingBoxKey)
+            { return GetCachedBoundingBox(); }
+
+        const wxRect boundingBox = CalcBoundingBox(dc);
+        SetCachedBoundingBox(boundingBox);
+        m_cachedBoundingBoxKey = key;
+        return boundingBox;
+        }
+
+    //-------------------------------------------
+    wxRect Axis::CalcBoundingBox(wxDC& dc) const
         {
         const auto textMeasurement = [this, &dc]()
             {
@@ -668,6 +695,7 @@ namespace Wisteria::GraphItems
         // (they're an add on), and client may not want that to be copied from axis to axis
         m_axisLabels = that.m_axisLabels;
         m_customAxisLabels = that.m_customAxisLabels;
+        m_customDateLabels = that.m_customDateLabels;
 
         m_tickMarks = that.m_tickMarks;
         m_customTickMarks = that.m_customTickMarks;
@@ -718,14 +746,18 @@ namespace Wisteria::GraphItems
         m_displayPrecision = that.m_displayPrecision;
         m_interval = that.m_interval;
         m_displayInterval = that.m_displayInterval;
+        ResetLabelMeasurements();
         }
 
     //-------------------------------------------
     void Axis::CalcTickMarkPositions()
         {
+        InvalidateCachedBoundingBox();
+        // only the labels' positions are changing (not their text), so access them directly
+        // rather than through GetAxisPoints(), which would discard the label measurements
         if (IsVertical())
             {
-            auto pos = GetAxisPoints().begin();
+            auto pos = m_axisLabels.begin();
             for (size_t i = 0; i < GetAxisPointsCount(); ++i, ++pos)
                 {
                 pos->SetPhysicalCoordinate(
@@ -753,7 +785,7 @@ namespace Wisteria::GraphItems
             }
         else if (IsHorizontal())
             {
-            auto pos = GetAxisPoints().begin();
+            auto pos = m_axisLabels.begin();
             for (size_t i = 0; i < GetAxisPointsCount(); ++i, ++pos)
                 {
                 pos->SetPhysicalCoordinate(GetLeftPoint().x+(GetLabelPhysicalOffset()*i));
@@ -781,6 +813,7 @@ namespace Wisteria::GraphItems
     //-------------------------------------------
     void Axis::CalcLabelPositions() noexcept
         {
+        InvalidateCachedBoundingBox();
         if (IsVertical())
             { SetLabelPhysicalOffset(safe_divide<double>(std::abs(GetBottomPoint().y-GetTopPoint().y), (GetAxisPointsCount()-1))); }
         else if (IsHorizontal())
@@ -2108,6 +2141,119 @@ namespace Wisteria::GraphItems
         if (IsStackingLabels())
             { m_maxLabelWidth *= 2; }
         m_widestLabel = m_tallestLabel = Label(GraphItemInfo().Ok(false));
+        // labels with background colors are sized to the max label width
+        InvalidateCachedBoundingBox();
+        }
+
+    //--------------------------------------
+    template<typename MeasureT>
+    double Axis::CalcScalingToFit(const double startScaling, const wxCoord maxSize,
+                                  MeasureT measure)
+        {
+        constexpr double SCALING_STEP{ 0.1 };
+        wxCoord currentSize = measure(startScaling);
+        if (startScaling <= 1.0 || currentSize <= maxSize)
+            { return startScaling; }
+
+        // the number of steps that it takes to reach 1.0 (or just under it)
+        const int maxSteps = std::max(1,
+            static_cast<int>(std::ceil(((startScaling - 1.0) / SCALING_STEP) - 1e-6)));
+        // estimate how far down to go from the label's current size,
+        // then step up (or down) from there until it fits
+        const double estimatedScaling = startScaling * safe_divide<double>(maxSize, currentSize);
+        int steps = std::clamp(
+            static_cast<int>(std::ceil(((startScaling - estimatedScaling) / SCALING_STEP) - 1e-6)),
+            1, maxSteps);
+        while (steps > 1 && measure(startScaling - ((steps - 1) * SCALING_STEP)) <= maxSize)
+            { --steps; }
+        currentSize = measure(startScaling - (steps * SCALING_STEP));
+        while (steps < maxSteps && currentSize > maxSize)
+            {
+            ++steps;
+            currentSize = measure(startScaling - (steps * SCALING_STEP));
+            }
+        return startScaling - (steps * SCALING_STEP);
+        }
+
+    //--------------------------------------
+    const std::vector<wxSize>& Axis::GetLabelSizes(wxDC& dc, const double scaling) const
+        {
+        const std::array<wxCoord, 4> padding{ GetTopPadding(), GetRightPadding(),
+                                              GetBottomPadding(), GetLeftPadding() };
+        const wxSize ppi = dc.GetPPI();
+        for (const auto& metrics : m_labelMetrics)
+            {
+            if (metrics.IsMeasuredWith(scaling, GetDPIScaleFactor(), GetFont(), padding, ppi) &&
+                metrics.m_sizes.size() == GetAxisPoints().size())
+                { return metrics.m_sizes; }
+            }
+
+        // labels that are the same as they were before the axis last changed
+        // can reuse their previous measurements
+        const auto previousMetrics = std::find_if(m_previousLabelMetrics.cbegin(),
+            m_previousLabelMetrics.cend(),
+            [&, this](const auto& previous)
+            { return previous.IsMeasuredWith(scaling, GetDPIScaleFactor(), GetFont(), padding, ppi); });
+
+        if (m_labelMetrics.size() >= MAX_LABEL_METRICS)
+            { m_labelMetrics.erase(m_labelMetrics.begin()); }
+        LabelMetrics metrics{ scaling, GetDPIScaleFactor(), GetFont(), padding, ppi, {}, {} };
+        metrics.m_sizes.reserve(GetAxisPoints().size());
+        metrics.m_texts.reserve(GetAxisPoints().size());
+        Label currentLabel(
+            GraphItemInfo().Pen(wxNullPen).Scaling(scaling).
+            Font(GetFont()).DPIScaling(GetDPIScaleFactor()).
+            Padding(GetTopPadding(), GetRightPadding(), GetBottomPadding(), GetLeftPadding()));
+        for (const auto& axisPt : GetAxisPoints())
+            {
+            if (IsPointDisplayingLabel(axisPt))
+                {
+                const size_t index = metrics.m_sizes.size();
+                wxString labelText = GetDisplayableValue(axisPt).GetText();
+                if (previousMetrics != m_previousLabelMetrics.cend() &&
+                    index < previousMetrics->m_texts.size() &&
+                    previousMetrics->m_sizes[index] != wxDefaultSize &&
+                    previousMetrics->m_texts[index] == labelText)
+                    { metrics.m_sizes.push_back(previousMetrics->m_sizes[index]); }
+                else
+                    {
+                    currentLabel.SetText(labelText);
+                    metrics.m_sizes.push_back(currentLabel.GetBoundingBox(dc).GetSize());
+                    }
+                metrics.m_texts.push_back(std::move(labelText));
+                }
+            else
+                {
+                metrics.m_sizes.push_back(wxDefaultSize);
+                metrics.m_texts.emplace_back();
+                }
+            }
+        m_labelMetrics.push_back(std::move(metrics));
+        return m_labelMetrics.back().m_sizes;
+        }
+
+    //--------------------------------------
+    wxSize Axis::GetOuterLabelSize(wxDC& dc, const Label& label, const bool first) const
+        {
+        if (!IsAdjustingLabelsForBackgroundColor())
+            {
+            const auto& labelSizes = GetLabelSizes(dc, GetAxisLabelScaling());
+            if (first)
+                {
+                const auto labelSize = std::find_if(labelSizes.cbegin(), labelSizes.cend(),
+                    [](const auto& sz) noexcept { return sz.IsFullySpecified(); });
+                if (labelSize != labelSizes.cend())
+                    { return *labelSize; }
+                }
+            else
+                {
+                const auto labelSize = std::find_if(labelSizes.crbegin(), labelSizes.crend(),
+                    [](const auto& sz) noexcept { return sz.IsFullySpecified(); });
+                if (labelSize != labelSizes.crend())
+                    { return *labelSize; }
+                }
+            }
+        return label.GetBoundingBox(dc).GetSize();
         }
 
     //--------------------------------------
@@ -2135,28 +2281,24 @@ namespace Wisteria::GraphItems
         if (GetAxisLabelOrientation() == AxisLabelOrientation::Parallel)
             {
             auto longestLabel{ GetWidestTextLabel(dc) };
-            auto longestWidth = longestLabel.GetBoundingBox(dc).GetWidth();
-
-            while (currentScaling > 1.0 && longestWidth > m_maxLabelWidth)
+            currentScaling = CalcScalingToFit(currentScaling, m_maxLabelWidth,
+                [&longestLabel, &dc](const double scaling)
                 {
-                currentScaling -= 0.1;
-                longestLabel.SetScaling(currentScaling);
-                longestWidth = longestLabel.GetBoundingBox(dc).GetWidth();
-                }
+                longestLabel.SetScaling(scaling);
+                return longestLabel.GetBoundingBox(dc).GetWidth();
+                });
             }
         else if (GetAxisLabelOrientation() == AxisLabelOrientation::Perpendicular)
             {
             auto tallestLabel = GetTallestTextLabel(dc);
-            auto tallestHeight = tallestLabel.GetBoundingBox(dc).GetHeight();
-
             // 1.0 will be the lowest scaling that we would recommend. Even if that continues to cause overlaps,
             // we don't want to suggest a scaling smaller than the default that the parent is probably using.
-            while (currentScaling > 1.0 && tallestHeight > m_maxLabelWidth)
+            currentScaling = CalcScalingToFit(currentScaling, m_maxLabelWidth,
+                [&tallestLabel, &dc](const double scaling)
                 {
-                currentScaling -= .1;
-                tallestLabel.SetScaling(currentScaling);
-                tallestHeight = tallestLabel.GetBoundingBox(dc).GetHeight();
-                }
+                tallestLabel.SetScaling(scaling);
+                return tallestLabel.GetBoundingBox(dc).GetHeight();
+                });
             }
         else
             {
@@ -2223,15 +2365,25 @@ namespace Wisteria::GraphItems
                     GetBottomPadding(), GetLeftPadding()) );
         AdjustLabelSizeIfUsingBackgroundColor(axisLabel, dc, true);
 
+        // unless the labels are sized around their backgrounds,
+        // use the (shared) label measurements
+        const std::vector<wxSize>* labelSizes = IsAdjustingLabelsForBackgroundColor() ?
+            nullptr : &GetLabelSizes(dc, GetScaling());
+
         for (auto pos = GetAxisPoints().cbegin();
             pos != GetAxisPoints().cend();
             ++pos)
             {
             if (IsPointDisplayingLabel(*pos))
                 {
-                axisLabel.SetText(GetDisplayableValue(*pos).GetText());
-                const wxSize labelSize =
-                    axisLabel.GetBoundingBox(dc).GetSize();
+                wxSize labelSize;
+                if (labelSizes != nullptr)
+                    { labelSize = labelSizes->at(std::distance(GetAxisPoints().cbegin(), pos)); }
+                else
+                    {
+                    axisLabel.SetText(GetDisplayableValue(*pos).GetText());
+                    labelSize = axisLabel.GetBoundingBox(dc).GetSize();
+                    }
                 wxCoord axisTextWidth = isMeasuringByHeight ?
                                         labelSize.GetHeight() : labelSize.GetWidth();
                 // with the first and last labels, the outer halves
@@ -2334,8 +2486,7 @@ namespace Wisteria::GraphItems
         // adjust monthly intervals to land on the start of the months
         else if (GetDateDisplayInterval() == DateInterval::Monthly)
             {
-            while (m_firstDay.GetDay() != 1)
-                { m_firstDay.Subtract(wxDateSpan(0, 0, 0, 1)); }
+            m_firstDay.SetDay(1);
             m_lastDay.SetToLastMonthDay();
             }
         // or adjust to weeks
@@ -2349,86 +2500,72 @@ namespace Wisteria::GraphItems
             m_lastDay.Subtract(wxDateSpan(0, 0, 0, 1));
             }
 
+        // The axis values are the days into the range. Rather than stepping through every day
+        // of the range (which can be tens of thousands for multi-decade ranges), the days that
+        // get labels are calculated from the calendar. Their labels are formatted later,
+        // as they are shown (see FindCustomLabel()).
+        const auto daysInRange = (m_lastDay - m_firstDay).GetDays();
+        const double firstJDN = m_firstDay.GetDateOnly().GetJDN();
+        // days between the start of the range and a date
+        // (rounded, as days across DST changes aren't quite 24 hours)
+        const auto daysFromStart = [&firstJDN](const wxDateTime& date)
+            { return std::lround(date.GetJDN() - firstJDN); };
+        m_customDateLabels.clear();
+        const auto addDateLabel = [this, &daysInRange](const long day)
+            {
+            if (day >= 0 && day <= daysInRange)
+                {
+                // a date label overwrites a custom label that was already here
+                m_customAxisLabels.erase(day);
+                m_customDateLabels.insert(day);
+                }
+            };
+
         // quarterly intervals
-        if (GetDateDisplayInterval() == DateInterval::FiscalQuarterly )
-            {
-            SetRange(0, (m_lastDay-m_firstDay).GetDays(), 0, 1, 1);
-            long currentDate = 0;
-            wxDateTime dateLabel = m_firstDay;
-            while (currentDate <= (m_lastDay-m_firstDay).GetDays())
-                {
-                // only show first and last month of quarters if using FYs
-                if (GetDateDisplayInterval() == DateInterval::FiscalQuarterly &&
-                    ((dateLabel.GetMonth() == m_fyQ1.GetMonth() &&
-                      dateLabel.GetDay() == m_fyQ1.GetDay()) ||
-                     (dateLabel.GetMonth() == m_fyQ2.GetMonth() &&
-                      dateLabel.GetDay() == m_fyQ2.GetDay()) ||
-                     (dateLabel.GetMonth() == m_fyQ3.GetMonth() &&
-                      dateLabel.GetDay() == m_fyQ3.GetDay()) ||
-                     (dateLabel.GetMonth() == m_fyQ4.GetMonth() &&
-                      dateLabel.GetDay() == m_fyQ4.GetDay())
-                    ))
-                    { SetCustomLabel(currentDate,
-                                     GraphItems::Label(dateLabel.FormatDate())); }
-                dateLabel.Add(wxDateSpan(0, 0, 0, 1));
-                ++currentDate;
+        if (GetDateDisplayInterval() == DateInterval::FiscalQuarterly)
+            {
+            BuildAxisPoints(0, daysInRange, 0, 1, 1, false);
+            // only show first and last month of quarters if using FYs
+            for (auto year = m_firstDay.GetYear(); year <= m_lastDay.GetYear(); ++year)
+                {
+                for (const auto& quarter : { m_fyQ1, m_fyQ2, m_fyQ3, m_fyQ4 })
+                    {
+                    // some months won't have the quarter's day (e.g., Feb. 29th)
+                    if (quarter.GetDay() <= wxDateTime::GetNumberOfDays(quarter.GetMonth(), year))
+                        {
+                        addDateLabel(daysFromStart(
+                            wxDateTime(quarter.GetDay(), quarter.GetMonth(), year)));
+                        }
+                    }
                 }
             }
         // monthly
         if (GetDateDisplayInterval() == DateInterval::Monthly)
             {
-            SetRange(0, (m_lastDay-m_firstDay).GetDays(), 0, 1, 1);
-            long currentDate = 0;
-            wxDateTime dateLabel = m_firstDay;
-            while (currentDate <= (m_lastDay-m_firstDay).GetDays())
-                {
-                // only show first of the months
-                if (dateLabel.GetDay() == 1)
-                    { SetCustomLabel(currentDate,
-                                     GraphItems::Label(dateLabel.FormatDate())); }
-                dateLabel.Add(wxDateSpan(0, 0, 0, 1));
-                ++currentDate;
-                }
+            BuildAxisPoints(0, daysInRange, 0, 1, 1, false);
+            // only show first of the months
+            for (wxDateTime monthStart(1, m_firstDay.GetMonth(), m_firstDay.GetYear());
+                 monthStart <= m_lastDay;
+                 monthStart.Add(wxDateSpan::Month()))
+                { addDateLabel(daysFromStart(monthStart)); }
             }
         // weekly intervals
         else if (GetDateDisplayInterval() == DateInterval::Weekly)
             {
-            SetRange(0, (m_lastDay-m_firstDay).GetDays(), 0, 1, 7);
-            long currentDate = 0;
-            wxDateTime dateLabel = m_firstDay;
-            // move next label to the start of the next week,
-            // so that all remaining labels show the first day of the week
-            while (dateLabel.GetWeekDay() != firstWeekDay)
-                {
-                dateLabel.Add(wxDateSpan(0, 0, 0, 1));
-                ++currentDate;
-                }
-            // add the rest
-            while (currentDate <= (m_lastDay-m_firstDay).GetDays())
-                {
-                SetCustomLabel(currentDate,
-                               GraphItems::Label(dateLabel.FormatDate()));
-                currentDate += 7;
-                if (currentDate > (m_lastDay-m_firstDay).GetDays())
-                    { break; }
-                dateLabel.Add(wxDateSpan(0, 0, 1, 0));
-                }
+            BuildAxisPoints(0, daysInRange, 0, 1, 7, false);
+            // start at the beginning of the next week,
+            // so that all labels show the first day of the week
+            for (long currentDate = (firstWeekDay - m_firstDay.GetWeekDay() + 7) % 7;
+                 currentDate <= daysInRange;
+                 currentDate += 7)
+                { addDateLabel(currentDate); }
             }
         // daily
         else if (GetDateDisplayInterval() == DateInterval::Daily)
             {
-            SetRange(0, (m_lastDay - m_firstDay).GetDays(), 0, 1, 1);
-            long currentDate = 0;
-            wxDateTime dateLabel = m_firstDay;
-            while (currentDate <= (m_lastDay-m_firstDay).GetDays())
-                {
-                SetCustomLabel(currentDate,
-                               GraphItems::Label(dateLabel.FormatDate()));
-                currentDate += 7;
-                if (currentDate > (m_lastDay-m_firstDay).GetDays())
-                    { break; }
-                dateLabel.Add(wxDateSpan(0, 0, 1, 0));
-                }
+            BuildAxisPoints(0, daysInRange, 0, 1, 1, false);
+            for (long currentDate = 0; currentDate <= daysInRange; currentDate += 7)
+                { addDateLabel(currentDate); }
             }
 
         SetLabelDisplay(AxisLabelDisplay::DisplayOnlyCustomLabels);
@@ -2499,8 +2636,14 @@ namespace Wisteria::GraphItems
     void Axis::SetRange(double rangeStart, double rangeEnd,
                         const uint8_t precision, double interval,
                         const size_t displayInterval /*= 1*/)
+        { BuildAxisPoints(rangeStart, rangeEnd, precision, interval, displayInterval, true); }
+
+    //--------------------------------------
+    void Axis::BuildAxisPoints(double rangeStart, double rangeEnd,
+                               const uint8_t precision, double interval,
+                               const size_t displayInterval, const bool formatValues)
         {
-        m_widestLabel = m_tallestLabel = Label(GraphItemInfo().Ok(false));
+        ResetLabelMeasurements();
 
         if (IsStartingAtZero())
             { rangeStart = std::min<double>(0, rangeStart); }
@@ -2536,8 +2679,10 @@ namespace Wisteria::GraphItems
                     { currentDisplayInterval = displayInterval; }
                 else
                     { --currentDisplayInterval; }
-                wxString textLabel = wxNumberFormatter::ToString(i, precision,
-                    wxNumberFormatter::Style::Style_WithThousandsSep);
+                wxString textLabel = formatValues ?
+                    NumberFormatCache::ToString(i, precision,
+                        wxNumberFormatter::Style::Style_WithThousandsSep) :
+                    wxString{};
                 // add it to the axis label collection
                 m_axisLabels.push_back(AxisPoint(i, textLabel, display));
                 lastValidPoint = i;
@@ -2559,8 +2704,10 @@ namespace Wisteria::GraphItems
                     { currentDisplayInterval = displayInterval; }
                 else
                     { --currentDisplayInterval; }
-                wxString textLabel = wxNumberFormatter::ToString(i, precision,
-                    wxNumberFormatter::Style::Style_WithThousandsSep);
+                wxString textLabel = formatValues ?
+                    NumberFormatCache::ToString(i, precision,
+                        wxNumberFormatter::Style::Style_WithThousandsSep) :
+                    wxString{};
                 // add it to the axis label collection
                 m_axisLabels.push_back(AxisPoint(i, textLabel, display));
                 lastValidPoint = i;
@@ -2573,8 +2720,15 @@ namespace Wisteria::GraphItems
     //--------------------------------------
     void Axis::SetCustomLabel(const double tickValue, const Label& label)
         {
-        m_widestLabel = m_tallestLabel = Label(GraphItemInfo().Ok(false));
+        ResetLabelMeasurements();
 
+        m_customAxisLabels[tickValue] = FormatCustomLabel(label);
+        m_customDateLabels.erase(tickValue);
+        }
+
+    //--------------------------------------
+    Label Axis::FormatCustomLabel(const Label& label) const
+        {
         Label theLabel = label;
         theLabel.SetDPIScaleFactor(GetDPIScaleFactor());
         theLabel.GetPen() = wxNullPen;
@@ -2582,15 +2736,32 @@ namespace Wisteria::GraphItems
         theLabel.SetFontColor(GetFontColor());
         theLabel.SetFontBackgroundColor(GetFontBackgroundColor());
         theLabel.SplitTextToFitLength(m_suggestedMaxLengthPerLine);
-        m_customAxisLabels[tickValue] = theLabel;
+        return theLabel;
         }
 
     //--------------------------------------
-    const Label& Axis::GetCustomLabel(const double value) const
+    const Label* Axis::FindCustomLabel(const double value) const
         {
         const auto custLabelIter = m_customAxisLabels.find(value);
-        return (custLabelIter != m_customAxisLabels.cend() ) ?
-            custLabelIter->second : m_invalidLabel;
+        if (custLabelIter != m_customAxisLabels.cend())
+            { return &custLabelIter->second; }
+        // format the point's date label if it has one
+        const auto dateLabelIter = m_customDateLabels.find(value);
+        if (dateLabelIter != m_customDateLabels.cend() && m_firstDay.IsValid())
+            {
+            const wxDateTime dateLabel = m_firstDay.GetDateOnly().Add(
+                wxDateSpan::Days(static_cast<int>(*dateLabelIter)));
+            return &m_customAxisLabels.insert(std::make_pair(*dateLabelIter,
+                FormatCustomLabel(Label(dateLabel.FormatDate())))).first->second;
+            }
+        return nullptr;
+        }
+
+    //--------------------------------------
+    const Label& Axis::GetCustomLabel(const double value) const
+        {
+        const auto customLabel = FindCustomLabel(value);
+        return (customLabel != nullptr) ? *customLabel : m_invalidLabel;
         }
 
     //--------------------------------------
@@ -2600,10 +2771,7 @@ namespace Wisteria::GraphItems
                                          m_axisLabels.cend(), value);
         if (labelIter != m_axisLabels.cend() && labelIter->IsShown())
             { return true; }
-        const auto custLabelIter = m_customAxisLabels.find(value);
-        if (custLabelIter != m_customAxisLabels.cend())
-            { return true; }
-        return false;
+        return HasCustomLabel(value);
         }
 
     //-------------------------------------------
@@ -2704,6 +2872,7 @@ namespace Wisteria::GraphItems
         Label lab(label);
         lab.SplitTextToFitLength(m_suggestedMaxLengthPerLine);
         pos = m_axisLabels.insert(pos, AxisPoint(value, lab.GetText()));
+        ResetLabelMeasurements();
         }
 
     //-------------------------------------------
@@ -2744,33 +2913,45 @@ namespace Wisteria::GraphItems
         if (GetAxisPoints().size() == 0)
             { return m_tallestLabel; }
 
-        wxCoord tallestLabelHeight{ 0 };
-        Label tallestAxisLabel;
         Label currentLabel(
             GraphItemInfo().Pen(wxNullPen).Scaling(GetAxisLabelScaling()).
             Font(GetFont()).DPIScaling(GetDPIScaleFactor()).
             Padding(GetTopPadding(), GetRightPadding(), GetBottomPadding(), GetLeftPadding()));
 
-        if ((IsVertical() && GetAxisLabelOrientation() == AxisLabelOrientation::Parallel) ||
-            (IsHorizontal() && GetAxisLabelOrientation() == AxisLabelOrientation::Perpendicular))
+        const bool isVerticalText =
+            ((IsVertical() && GetAxisLabelOrientation() == AxisLabelOrientation::Parallel) ||
+             (IsHorizontal() && GetAxisLabelOrientation() == AxisLabelOrientation::Perpendicular));
+        if (isVerticalText)
             { currentLabel.SetTextOrientation(Orientation::Vertical); }
 
-        for (const auto& axisPt : GetAxisPoints())
+        // find the tallest label from the (shared) label measurements;
+        // vertical text is the same size as horizontal text, just turned on its side
+        const auto& labelSizes = GetLabelSizes(dc, GetAxisLabelScaling());
+        wxCoord tallestSize{ 0 };
+        std::optional<size_t> tallestIndex;
+        for (size_t i = 0; i < labelSizes.size(); ++i)
             {
-            if (IsPointDisplayingLabel(axisPt))
+            if (labelSizes[i].IsFullySpecified())
                 {
-                currentLabel.SetText(GetDisplayableValue(axisPt).GetText());
-                const wxCoord textHeight =
-                    currentLabel.GetBoundingBox(dc).GetSize().GetHeight();
-                if (textHeight > tallestLabelHeight)
+                const wxCoord textSize = isVerticalText ?
+                    labelSizes[i].GetWidth() : labelSizes[i].GetHeight();
+                if (textSize > tallestSize)
                     {
-                    tallestAxisLabel = currentLabel;
-                    tallestLabelHeight = textHeight;
+                    tallestIndex = i;
+                    tallestSize = textSize;
                     }
                 }
             }
+
+        if (tallestIndex)
+            {
+            currentLabel.SetText(
+                GetDisplayableValue(GetAxisPoints()[tallestIndex.value()]).GetText());
+            m_tallestLabel = currentLabel;
+            }
+        else
+            { m_tallestLabel = Label(); }
         m_tallestLabel.SetDPIScaleFactor(GetDPIScaleFactor());
-        m_tallestLabel = tallestAxisLabel;
         return m_tallestLabel;
         }
 
@@ -2788,31 +2969,44 @@ namespace Wisteria::GraphItems
         if (GetAxisPoints().size() == 0)
             { return m_widestLabel; }
 
-        wxCoord longestLabelWidth{ 0 };
-        Label longestAxisLabel;
         Label currentLabel(
             GraphItemInfo().Pen(wxNullPen).Scaling(GetAxisLabelScaling()).
             Font(GetFont()).DPIScaling(GetDPIScaleFactor()).
             Padding(GetTopPadding(), GetRightPadding(), GetBottomPadding(), GetLeftPadding()));
 
-        if ((IsVertical() && GetAxisLabelOrientation() == AxisLabelOrientation::Parallel) ||
-            (IsHorizontal() && GetAxisLabelOrientation() == AxisLabelOrientation::Perpendicular))
+        const bool isVerticalText =
+            ((IsVertical() && GetAxisLabelOrientation() == AxisLabelOrientation::Parallel) ||
+             (IsHorizontal() && GetAxisLabelOrientation() == AxisLabelOrientation::Perpendicular));
+        if (isVerticalText)
             { currentLabel.SetTextOrientation(Orientation::Vertical); }
 
-        for (const auto& axisPt : GetAxisPoints())
+        // find the widest label from the (shared) label measurements;
+        // vertical text is the same size as horizontal text, just turned on its side
+        const auto& labelSizes = GetLabelSizes(dc, GetAxisLabelScaling());
+        wxCoord widestSize{ 0 };
+        std::optional<size_t> widestIndex;
+        for (size_t i = 0; i < labelSizes.size(); ++i)
             {
-            if (IsPointDisplayingLabel(axisPt))
+            if (labelSizes[i].IsFullySpecified())
                 {
-                currentLabel.SetText(GetDisplayableValue(axisPt).GetText());
-                const auto textWidth = currentLabel.GetBoundingBox(dc).GetWidth();
-                if (textWidth > longestLabelWidth)
+                const wxCoord textSize = isVerticalText ?
+                    labelSizes[i].GetHeight() : labelSizes[i].GetWidth();
+                if (textSize > widestSize)
                     {
-                    longestAxisLabel = currentLabel;
-                    longestLabelWidth = textWidth;
+                    widestIndex = i;
+                    widestSize = textSize;
                     }
                 }
             }
-        m_widestLabel = longestAxisLabel;
+
+        if (widestIndex)
+            {
+            currentLabel.SetText(
+                GetDisplayableValue(GetAxisPoints()[widestIndex.value()]).GetText());
+            m_widestLabel = currentLabel;
+            }
+        else
+            { m_widestLabel = Label(); }
         m_widestLabel.SetDPIScaleFactor(GetDPIScaleFactor());
         return m_widestLabel;
         }
@@ -2827,14 +3021,14 @@ namespace Wisteria::GraphItems
         else if (!reverse && IsReversed())
             { std::reverse(m_axisLabels.begin(), m_axisLabels.end()); }
         m_scaledReserved = reverse;
-        m_widestLabel = m_tallestLabel = Label(GraphItemInfo().Ok(false));
+        ResetLabelMeasurements();
         }
 
     //-------------------------------------------
     void Axis::SetAxisLabelOrientation(const AxisLabelOrientation& orient) noexcept
         {
         m_labelOrientation = orient;
-        m_widestLabel = m_tallestLabel = Label(GraphItemInfo().Ok(false));
+        ResetLabelMeasurements();
         }
 
     //-------------------------------------------
@@ -2964,6 +3158,184 @@ namespace Wisteria::GraphItems
             }
         }
 
+    //-------------------------------------------
+    Axis::CoordinateTransform Axis::GetCoordinateTransform() const
+        {
+        CoordinateTransform transform;
+        transform.m_reversed = IsReversed();
+        transform.m_horizontal = IsHorizontal();
+        transform.m_vertical = IsVertical();
+        transform.m_values.reserve(GetAxisPointsCount());
+        transform.m_coordinates.reserve(GetAxisPointsCount());
+        for (const auto& axisPoint : GetAxisPoints())
+            {
+            transform.m_values.push_back(axisPoint.GetValue());
+            transform.m_coordinates.push_back(axisPoint.GetPhysicalCoordinate());
+            }
+        // see if the points are evenly spaced, so that a value's point can be calculated
+        if (transform.m_values.size() > 1)
+            {
+            const double interval = safe_divide<double>(
+                transform.m_values.back() - transform.m_values.front(),
+                transform.m_values.size() - 1);
+            bool evenlySpaced{ interval != 0 };
+            for (size_t i = 1; evenlySpaced && i < transform.m_values.size(); ++i)
+                {
+                evenlySpaced = compare_doubles(transform.m_values[i] - transform.m_values[i - 1],
+                                               interval, std::fabs(interval) * 1e-6);
+                }
+            if (evenlySpaced)
+                { transform.m_interval = interval; }
+            }
+        return transform;
+        }
+
+    //-------------------------------------------
+    size_t Axis::CoordinateTransform::FindPoint(const double value) const noexcept
+        {
+        // points before the value (in the axis's direction)
+        const auto isBefore = [this, value](const size_t index) noexcept
+            { return m_reversed ? (m_values[index] > value) : (m_values[index] < value); };
+        size_t index{ 0 };
+        if (m_interval)
+            {
+            // calculate where the value should be, then step to the exact point
+            // (in case of floating-point imprecision)
+            const double estimate = std::ceil((value - m_values.front()) / m_interval.value());
+            index = (estimate <= 0) ? 0 :
+                (estimate >= m_values.size()) ? m_values.size() :
+                static_cast<size_t>(estimate);
+            while (index > 0 && !isBefore(index - 1))
+                { --index; }
+            while (index < m_values.size() && isBefore(index))
+                { ++index; }
+            }
+        else
+            {
+            index = std::partition_point(m_values.cbegin(), m_values.cend(),
+                [&value, this](const auto pointValue) noexcept
+                { return m_reversed ? (pointValue > value) : (pointValue < value); }) -
+                m_values.cbegin();
+            }
+        // reversed axes also stop at a point that is nearly equal to the value
+        if (m_reversed)
+            {
+            while (index > 0 && compare_doubles(value, m_values[index - 1]))
+                { --index; }
+            }
+        return index;
+        }
+
+    //-------------------------------------------
+    bool Axis::CoordinateTransform::ToPhysicalCoordinate(const double value,
+                                                         wxCoord& result) const noexcept
+        {
+        result = -1; // init to invalid value in case we have to return false
+        if (m_values.empty() || std::isnan(value))
+            { return false; }
+        const size_t pos = FindPoint(value);
+        if (pos == m_values.size())
+            { return false; }
+        if (compare_doubles(m_values[pos], value))
+            {
+            result = m_coordinates[pos];
+            return true;
+            }
+        // if this point is before the first axis line or
+        // above the top axis line, then it is out of range
+        if (pos == 0)
+            { return false; }
+        const size_t previousLine = pos - 1;
+        const double percentage = safe_divide<double>(
+            (value - m_values[previousLine]),
+            (m_values[pos] - m_values[previousLine]));
+        if (m_horizontal)
+            {
+            const long coordinateDifference = m_coordinates[pos] -
+                                              m_coordinates[previousLine];
+            result = m_coordinates[previousLine] +
+                     (coordinateDifference*percentage);
+            return true;
+            }
+        else if (m_vertical)
+            {
+            const long coordinateDifference = m_coordinates[previousLine] -
+                                              m_coordinates[pos];
+            result = m_coordinates[previousLine] -
+                     (coordinateDifference*percentage);
+            return true;
+            }
+        else
+            {
+            // shouldn't happen--invalid axis orientation
+            return false;
+            }
+        }
+
+    //-------------------------------------------
+    void Axis::CoordinateTransform::ToPhysicalCoordinates(const std::vector<double>& values,
+        std::vector<std::optional<wxCoord>>& results) const
+        {
+        results.resize(values.size());
+        const auto mapValue = [this](const double value) noexcept
+            {
+            wxCoord result{ -1 };
+            return ToPhysicalCoordinate(value, result) ?
+                std::optional<wxCoord>(result) : std::nullopt;
+            };
+        // only worth the overhead of threads for large series
+        constexpr size_t PARALLEL_THRESHOLD{ 100'000 };
+        if (values.size() >= PARALLEL_THRESHOLD)
+            {
+            std::transform(std::execution::par, values.cbegin(), values.cend(),
+                           results.begin(), mapValue);
+            }
+        else
+            { std::transform(values.cbegin(), values.cend(), results.begin(), mapValue); }
+        }
+
+    //-------------------------------------------
+    bool Axis::CoordinateTransform::ToValue(const wxCoord coordinate,
+                                            double& value) const noexcept
+        {
+        value = -1; // init to invalid value in case we have to return false
+        if (m_coordinates.empty() || (!m_horizontal && !m_vertical))
+            { return false; }
+        // coordinates go left to right on horizontal axes and bottom to top on vertical ones
+        const size_t pos = std::partition_point(m_coordinates.cbegin(), m_coordinates.cend(),
+            [&coordinate, this](const auto pointCoordinate) noexcept
+            {
+            return m_horizontal ? (coordinate > pointCoordinate) :
+                                  (coordinate < pointCoordinate);
+            }) - m_coordinates.cbegin();
+        if (pos == m_coordinates.size())
+            { return false; }
+        if (coordinate == m_coordinates[pos])
+            {
+            value = m_values[pos];
+            return true;
+            }
+        // if this point is before the first axis line or
+        // above the top axis line then it is out of range
+        if (pos == 0)
+            { return false; }
+        const size_t previousLine = pos - 1;
+        const double percentage = safe_divide<double>(
+            (coordinate - m_coordinates[previousLine]),
+            (m_coordinates[pos] - m_coordinates[previousLine]));
+        if (m_horizontal)
+            {
+            const double coordinateDifference = m_values[pos] - m_values[previousLine];
+            value = m_values[previousLine] + (coordinateDifference*percentage);
+            }
+        else
+            {
+            const double coordinateDifference = m_values[previousLine] - m_values[pos];
+            value = m_values[previousLine] - (coordinateDifference*percentage);
+            }
+        return true;
+        }
+
     //-------------------------------------------
     void Axis::SetLabelLineLength(const size_t suggestedMaxLengthPerLine)
         {
@@ -2983,6 +3355,7 @@ namespace Wisteria::GraphItems
             lab.SplitTextToFitLength(m_suggestedMaxLengthPerLine);
             axisPointPos->SetDisplayValue(lab.GetText());
             }
+        ResetLabelMeasurements();
         }
 
     //-------------------------------------------
@@ -3028,7 +3401,7 @@ namespace Wisteria::GraphItems
         // then turn them on, based on the specified interval
         for (size_t i = 0+offset; i < m_axisLabels.size(); i += m_displayInterval)
             { m_axisLabels.at(i).Show(true); }
-        m_widestLabel = m_tallestLabel = Label(GraphItemInfo().Ok(false));
+        ResetLabelMeasurements();
         }
 
     //-------------------------------------------
@@ -3037,12 +3410,12 @@ namespace Wisteria::GraphItems
         if (!point.IsShown())
             { return false; }
         // is it set to show a custom label, but doesn't have one?
-        const auto customLabel = m_customAxisLabels.find(point.GetValue());
+        const bool hasCustomLabel = HasCustomLabel(point.GetValue());
         if (GetLabelDisplay() == AxisLabelDisplay::DisplayOnlyCustomLabels &&
-            customLabel == m_customAxisLabels.cend())
+            !hasCustomLabel)
             { return false; }
         // custom and/or regular label, but has neither?
-        else if (customLabel == m_customAxisLabels.cend() &&
+        else if (!hasCustomLabel &&
             point.GetDisplayValue().empty())
             { return false; }
         else
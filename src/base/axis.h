@@ -13,8 +13,12 @@
 #define __WISTERIA_AXIS_H__
 
 #include <wx/wx.h>
+#include <array>
+#include <tuple>
 #include <vector>
 #include <map>
+#include <optional>
+#include <set>
 #include "label.h"
 #include "polygon.h"
 
@@ -384,6 +388,67 @@ namespace Wisteria::GraphItems
             double m_value{ 0 };
             };
 
+        /** @brief A snapshot of an axis's mapping between values and physical coordinates.
+            @details GetPhysicalCoordinate() searches through the axis points on every call.
+                This copies the points' values and coordinates into flat tables once, so that
+                a large number of values (e.g., a scatter plot's data) can be mapped quickly.
+                When the axis points are evenly spaced (the usual case), the interval that a value
+                falls into is calculated directly, rather than searched for.
+            @note This is a snapshot of the axis after it has been laid out, so call
+                Axis::GetCoordinateTransform() again if the axis changes.\n
+                Results are identical to Axis::GetPhysicalCoordinate()
+                and Axis::GetValueFromPhysicalCoordinate().
+            @par Example
+            @code
+                // after the plot's base RecalcSizes() has laid out the axes
+                const auto xTransform = GetBottomXAxis().GetCoordinateTransform();
+                std::vector<std::optional<wxCoord>> xCoords;
+                xTransform.ToPhysicalCoordinates(xValues, xCoords);
+            @endcode*/
+        class CoordinateTransform
+            {
+            friend class Axis;
+        public:
+            /// @private
+            CoordinateTransform() = default;
+            /// @returns @c true if the transform has axis points to map with.
+            [[nodiscard]] bool IsOk() const noexcept
+                { return !m_values.empty(); }
+            /** @brief Returns the physical point of an axis value, relative to the parent plot.
+                @param value The axis value to search for.
+                @param[out] result The physical coordinate of where the value is,
+                    relative to the parent plot.
+                @returns @c true if the physical coordinate is found
+                    (@c false when value isn't on the axis).*/
+            bool ToPhysicalCoordinate(const double value, wxCoord& result) const noexcept;
+            /** @brief Returns the physical points of a series of axis values.
+                @param values The axis values to search for.
+                @param[out] results The physical coordinates of where the values are,
+                    relative to the parent plot. Values not on the axis will be @c std::nullopt.
+                @note Large series are mapped in parallel.*/
+            void ToPhysicalCoordinates(const std::vector<double>& values,
+                                       std::vector<std::optional<wxCoord>>& results) const;
+            /** @brief Retrieves the value along the axis from a physical
+                    (relative to parent plot) coordinate.
+                @param coordinate The physical coordinate to look up.
+                @param[out] value The axis value connected to the coordinate.
+                @returns @c true if coordinate is on the axis and a value can be found;
+                    @c false otherwise.*/
+            bool ToValue(const wxCoord coordinate, double& value) const noexcept;
+        private:
+            /// @returns The index of the first axis point at (or past) @c value,
+            ///     in the axis's direction.
+            [[nodiscard]] size_t FindPoint(const double value) const noexcept;
+
+            std::vector<double> m_values;
+            std::vector<double> m_coordinates;
+            bool m_reversed{ false };
+            bool m_horizontal{ false };
+            bool m_vertical{ false };
+            // the (signed) interval between the points, if they are evenly spaced
+            std::optional<double> m_interval;
+            };
+
         /// @brief Constructor.
         /// @param type The type of axis this should be.
         explicit Axis(const AxisType type) :
@@ -494,8 +559,12 @@ namespace Wisteria::GraphItems
              dates to start and end at the beginning and end of a fiscal year.
              Also, after calling this, GetRangeDates() will return the (possibly adjusted)
              start and end dates. GetRange(), on the other hand, will return the underlying
-             axis values (which may be something like 0-365 if the date range is a year).
-            @sa GetRangeDates().*/
+             axis values (which may be something like 0-365 if the date range is a year).\n
+             The axis values are the number of days from the start date, and the dates' labels
+             are only formatted when they are shown (e.g., if SetDisplayInterval() hides most of
+             them, then those labels are never formatted). Because only the date labels are shown,
+             the axis values themselves are not formatted into labels.
+            @sa GetRangeDates(), GetPointFromDate().*/
         void SetRange(const wxDateTime& startDate, const wxDateTime& endDate,
                       const DateInterval displayInterval,
                       const FiscalYear FYtype);
@@ -594,14 +663,15 @@ namespace Wisteria::GraphItems
         /// @returns The major axis points (generated by SetRange()).
         [[nodiscard]] std::vector<AxisPoint>& GetAxisPoints() noexcept
             {
-            m_widestLabel = m_tallestLabel = Label(GraphItemInfo().Ok(false));
+            ResetLabelMeasurements();
             return m_axisLabels;
             }
         /// @brief Removes all custom labels from the axis.
         void ClearCustomLabels() noexcept
             {
             m_customAxisLabels.clear();
-            m_widestLabel = m_tallestLabel = Label(GraphItemInfo().Ok(false));
+            m_customDateLabels.clear();
+            ResetLabelMeasurements();
             }
         /** @brief Sets the text of an axis tick label (overriding any default calculated label).
             @param tickValue The tick on the axis to label.
@@ -624,7 +694,7 @@ namespace Wisteria::GraphItems
         void SetLabelDisplay(const AxisLabelDisplay display) noexcept
             {
             m_labelDisplay = display;
-            m_widestLabel = m_tallestLabel = Label(GraphItemInfo().Ok(false));
+            ResetLabelMeasurements();
             }
         /// @returns How the tick labels are displayed.
         [[nodiscard]] const AxisLabelDisplay& GetLabelDisplay() const noexcept
@@ -636,7 +706,10 @@ namespace Wisteria::GraphItems
         ///  will be ignored if this is set to @c CenterOnAxisLine.
         /// @todo Not currently implemented for horizontal axes.
         void SetPerpendicularLabelAxisAlignment(const AxisLabelAlignment alignment) noexcept
-            { m_axisLabelAlignment = alignment; }
+            {
+            m_axisLabelAlignment = alignment;
+            InvalidateCachedBoundingBox();
+            }
         /// @returns How the labels are aligned, either against the line or the outer boundary.
         [[nodiscard]] const AxisLabelAlignment& GetPerpendicularLabelAxisAlignment() const noexcept
             { return m_axisLabelAlignment; }
@@ -649,7 +722,10 @@ namespace Wisteria::GraphItems
             @note This only applies when labels are parallel to the axis, see SetAxisLabelOrientation().
              To control how the text within the axis labels are aligned, call SetTextAlignment().*/
         void SetParallelLabelAlignment(const RelativeAlignment alignment) noexcept
-            { m_labelAlignmet = alignment;}
+            {
+            m_labelAlignmet = alignment;
+            InvalidateCachedBoundingBox();
+            }
         /** @brief Sets whether the first and last axis labels should be shown (the outer lines of the plot).
              This should be called after the labels and scaling have been set.
             @param display Whether or not outer labels should be displayed.*/
@@ -660,7 +736,7 @@ namespace Wisteria::GraphItems
                 m_axisLabels.front().Show(display);
                 m_axisLabels.back().Show(display);
                 }
-            m_widestLabel = m_tallestLabel = Label(GraphItemInfo().Ok(false));
+            ResetLabelMeasurements();
             }
         /** @returns Whether the first and last axis labels are being shown (the outer lines of the plot).*/
         [[nodiscard]] bool IsShowingOuterLabels() const noexcept
@@ -674,7 +750,10 @@ namespace Wisteria::GraphItems
             @details This is useful for when the labels are long and will overlap each other.
             @param stacked Whether to stack the labels.*/
         void StackLabels(bool stacked = true) noexcept
-            { m_stackLabelsToFit = stacked; }
+            {
+            m_stackLabelsToFit = stacked;
+            InvalidateCachedBoundingBox();
+            }
         /** @brief Sets whether to enable auto stacking labels.
             @details If `true`, the axis will set labels to auto stack
              if it is determined that that is the best way to fit them along the axis.
@@ -694,7 +773,10 @@ namespace Wisteria::GraphItems
         /** @brief Specifies whether axis labels should be drawn on both sides of the axis.
             @param doubleSided Whether axis labels should be drawn on both sides of the main axis line.*/
         void SetDoubleSidedAxisLabels(const bool doubleSided) noexcept
-            { m_doubleSidedAxisLabels = doubleSided; }
+            {
+            m_doubleSidedAxisLabels = doubleSided;
+            InvalidateCachedBoundingBox();
+            }
 
         /** @returns The precision of the axis labels (if numeric).*/
         [[nodiscard]] uint8_t GetPrecision() const noexcept
@@ -727,7 +809,7 @@ namespace Wisteria::GraphItems
                         const wxCoord bottom, const wxCoord left) noexcept final
             {
             GraphItemBase::SetPadding(top, right, bottom, left);
-            m_widestLabel = m_tallestLabel = Label(GraphItemInfo().Ok(false));
+            ResetLabelMeasurements();
             }
         /** @brief Sets the bottom padding of the axis.
             @param padding The padding size.
@@ -735,7 +817,7 @@ namespace Wisteria::GraphItems
         void SetBottomPadding(const wxCoord padding) noexcept final
             {
             GraphItemBase::SetBottomPadding(padding);
-            m_widestLabel = m_tallestLabel = Label(GraphItemInfo().Ok(false));
+            ResetLabelMeasurements();
             }
         /** @brief Sets the top padding of the axis.
             @param padding The padding size.
@@ -743,7 +825,7 @@ namespace Wisteria::GraphItems
         void SetTopPadding(const wxCoord padding) noexcept final
             {
             GraphItemBase::SetTopPadding(padding);
-            m_widestLabel = m_tallestLabel = Label(GraphItemInfo().Ok(false));
+            ResetLabelMeasurements();
             }
         /** @brief Sets the right padding of the axis.
             @param padding The padding size.
@@ -751,7 +833,7 @@ namespace Wisteria::GraphItems
         void SetRightPadding(const wxCoord padding) noexcept final
             {
             GraphItemBase::SetRightPadding(padding);
-            m_widestLabel = m_tallestLabel = Label(GraphItemInfo().Ok(false));
+            ResetLabelMeasurements();
             }
         /** @brief Sets the left padding of the axis.
             @param padding The padding size.
@@ -759,7 +841,7 @@ namespace Wisteria::GraphItems
         void SetLeftPadding(const wxCoord padding) noexcept final
             {
             GraphItemBase::SetLeftPadding(padding);
-            m_widestLabel = m_tallestLabel = Label(GraphItemInfo().Ok(false));
+            ResetLabelMeasurements();
             }
         /// @}
 
@@ -774,6 +856,10 @@ namespace Wisteria::GraphItems
             @param[out] result The physical coordinate of where the value is, relative to the parent plot.
             @returns `true` if the physical coordinate is found (`false` when value isn't on the axis).*/
         bool GetPhysicalCoordinate(const double value, wxCoord& result) const;
+        /** @returns A snapshot of how the axis maps values to physical coordinates,
+                which is faster for mapping many values than calling GetPhysicalCoordinate().
+            @note This should be called after the axis is laid out by the parent plot.*/
+        [[nodiscard]] CoordinateTransform GetCoordinateTransform() const;
         /// @}
 
         /** @name Line Functions
@@ -784,7 +870,10 @@ namespace Wisteria::GraphItems
             @returns The axis line pen.
             @note Set to `wxNullPen` or transparent to turn off the main axis line and tickmarks.*/
         [[nodiscard]] wxPen& GetAxisLinePen() noexcept
-            { return m_axisLinePen; }
+            {
+            InvalidateCachedBoundingBox();
+            return m_axisLinePen;
+            }
 
         /** @brief Gets/sets the gridline pen.
             @returns The gridline pen.
@@ -799,7 +888,10 @@ namespace Wisteria::GraphItems
         /** @brief Sets how the end of the axis line is being drawn.
             @param capStyle The cap style to use.*/
         void SetCapStyle(const AxisCapStyle capStyle) noexcept
-            { m_capStyle = capStyle; }
+            {
+            m_capStyle = capStyle;
+            InvalidateCachedBoundingBox();
+            }
         /// @}
 
         /** @name Tickmark Functions
@@ -812,7 +904,10 @@ namespace Wisteria::GraphItems
             @param length The length of the tick mark.*/
         void AddCustomTickMark(const TickMark::DisplayType displayType,
                                const double position, const double length)
-            { m_customTickMarks.push_back(TickMark(displayType, position, length)); }
+            {
+            m_customTickMarks.push_back(TickMark(displayType, position, length));
+            InvalidateCachedBoundingBox();
+            }
 
         /// @returns The interval of the tick marks being shown.
         [[nodiscard]] double GetTickMarkInterval() const noexcept
@@ -820,7 +915,10 @@ namespace Wisteria::GraphItems
         /// @brief Sets the interval to display tick marks.
         /// @param interval The interval for the tickmarks.
         void SetTickMarkInterval(const double interval) noexcept
-            { m_tickMarkDisplayInterval = interval; }
+            {
+            m_tickMarkDisplayInterval = interval;
+            InvalidateCachedBoundingBox();
+            }
 
         /// @returns The length of the minor tick marks (i.e., tick marks between axis labels).
         /// @note This value is not scaled to the screen DPI because it is copied to the tickmarks,
@@ -832,7 +930,10 @@ namespace Wisteria::GraphItems
         ///  This is a pixel value that the framework will scale to the screen for you.
         ///  (The parent axis will also scale this as the graph's scaling changes.)
         void SetMinorTickMarkLength(const int length) noexcept
-            { m_minorTickMarkLength = length; }
+            {
+            m_minorTickMarkLength = length;
+            InvalidateCachedBoundingBox();
+            }
 
         /// @returns The length of the major tick marks (i.e., tick marks between axis labels).
         [[nodiscard]] int GetMajorTickMarkLength() const noexcept
@@ -842,14 +943,20 @@ namespace Wisteria::GraphItems
         ///  This is a pixel value that the framework will scale to the screen for you.
         ///  (The parent axis will also scale this as the graph's scaling changes.)
         void SetMajorTickMarkLength(const int length) noexcept
-            { m_majorTickMarkLength = length; }
+            {
+            m_majorTickMarkLength = length;
+            InvalidateCachedBoundingBox();
+            }
 
         /// @returns How the tick marks are being drawn.
         [[nodiscard]] const TickMark::DisplayType& GetTickMarkDisplay() const noexcept
             { return m_tickMarkDisplayType; }
         /// @param displayType Sets how to draw the tick marks.
         void SetTickMarkDisplay(const TickMark::DisplayType displayType) noexcept
-            { m_tickMarkDisplayType = displayType; }
+            {
+            m_tickMarkDisplayType = displayType;
+            InvalidateCachedBoundingBox();
+            }
         /// @}
 
         /** @brief Copies the settings from another axis into this one.
@@ -870,7 +977,10 @@ namespace Wisteria::GraphItems
             @returns The header of the axis.
             @sa SetRelativeAlignment().*/
         [[nodiscard]] Label& GetTitle() noexcept
-            { return m_title; }
+            {
+            InvalidateCachedBoundingBox();
+            return m_title;
+            }
         /// @}
 
         /** @name Header & Footer Functions
@@ -888,7 +998,10 @@ namespace Wisteria::GraphItems
             @returns The header of the axis.
             @sa SetRelativeAlignment().*/
         [[nodiscard]] Label& GetHeader() noexcept
-            { return m_header; }
+            {
+            InvalidateCachedBoundingBox();
+            return m_header;
+            }
 
         /** @brief Gets/sets the footer of the axis. This is a label that appears at the bottom or left of the axis
              (depending on the orientation of the axis).
@@ -901,7 +1014,10 @@ namespace Wisteria::GraphItems
             @sa SetRelativeAlignment().
             @returns The footer of the axis.*/
         [[nodiscard]] Label& GetFooter() noexcept
-            { return m_footer; }
+            {
+            InvalidateCachedBoundingBox();
+            return m_footer;
+            }
         /// @}
 
         /** @name Bracket Functions
@@ -919,10 +1035,16 @@ namespace Wisteria::GraphItems
         void AddBrackets(const BracketType bracketType);
         /// @brief Removes all the brackets.
         void ClearBrackets() noexcept
-            { m_brackets.clear(); }
+            {
+            m_brackets.clear();
+            InvalidateCachedBoundingBox();
+            }
         /// @returns The axis's brackets.
         [[nodiscard]] std::vector<AxisBracket>& GetBrackets() noexcept
-            { return m_brackets; }
+            {
+            InvalidateCachedBoundingBox();
+            return m_brackets;
+            }
         /// @}
 
         /** @name Custom Axis Functions
@@ -940,7 +1062,10 @@ namespace Wisteria::GraphItems
              the max value of the X axis, unless it is reversed (then use the min of the X axis).
              For vertical axes, this is where the axis should be placed on the bottom axis.*/
         void SetCustomXPosition(const double xPos) noexcept
-            { m_customXPosition = xPos; }
+            {
+            m_customXPosition = xPos;
+            InvalidateCachedBoundingBox();
+            }
         /// @returns The custom position (in respect to the main y axes); these only relate to custom axes.
         /// @sa SetCustomYPosition().
         [[nodiscard]] double GetCustomYPosition() const noexcept
@@ -951,7 +1076,10 @@ namespace Wisteria::GraphItems
              the max value of the Y axis, unless Y is reversed (then it should be its min value).
              For horizontal axes, this is where the axis should be placed on the left axis.*/
         void SetCustomYPosition(const double yPos) noexcept
-            { m_customYPosition = yPos; }
+            {
+            m_customYPosition = yPos;
+            InvalidateCachedBoundingBox();
+            }
 
         /// @returns The offset from the parent axis (applies only to custom axes).
         [[nodiscard]] double GetOffsetFromParentAxis() const noexcept
@@ -959,7 +1087,10 @@ namespace Wisteria::GraphItems
         /// @brief Sets the offset from the parent axis (applies only to custom axes).
         /// @param offset The offset from the parent axis.
         void SetOffsetFromParentAxis(const double offset) noexcept
-            { m_offsetFromParentAxis = offset; }
+            {
+            m_offsetFromParentAxis = offset;
+            InvalidateCachedBoundingBox();
+            }
 
         /** @brief Sets the physical y position on the canvas.
             @param y The physical y position to place the axis.
@@ -967,7 +1098,10 @@ namespace Wisteria::GraphItems
              Use SetCustomYPosition() and SetCustomXPosition() for custom positioning of an axis
              relative to the main axes.*/
         void SetPhysicalCustomYPosition(const double y) noexcept
-            { m_physicalCustomYPosition = y; }
+            {
+            m_physicalCustomYPosition = y;
+            InvalidateCachedBoundingBox();
+            }
         /// @returns The physical y position on the canvas of the axis.
         ///  (Should only be used if using custom positioning along a parent axis.)
         [[nodiscard]] double GetPhysicalCustomYPosition() const noexcept
@@ -978,7 +1112,10 @@ namespace Wisteria::GraphItems
              Use SetCustomYPosition() and SetCustomXPosition() for custom positioning of an axis
              relative to the main axes.*/
         void SetPhysicalCustomXPosition(const double x) noexcept
-            { m_physicalCustomXPosition = x; }
+            {
+            m_physicalCustomXPosition = x;
+            InvalidateCachedBoundingBox();
+            }
         /// @returns The physical x position on the canvas of the axis.
         ///  (Should only be used if using custom positioning along a parent axis.)
         [[nodiscard]] double GetPhysicalCustomXPosition() const noexcept
@@ -994,7 +1131,10 @@ namespace Wisteria::GraphItems
             @details By default, this outline is not being drawn and will be activated by calling this function.
             @param sz The size around the axis to draw an outline.*/
         void SetOutlineSize(const wxSize sz) noexcept
-            { m_outlineSize = sz; }
+            {
+            m_outlineSize = sz;
+            InvalidateCachedBoundingBox();
+            }
         /// @returns The inflated size around the axis that an outline is being drawn.
         /// @note By default, this outline is not being drawn and SetOutlineSize()
         ///  must be called to enable this behavior.
@@ -1013,19 +1153,19 @@ namespace Wisteria::GraphItems
         /// @private
         [[nodiscard]] GraphItemInfo& GetGraphItemInfo() noexcept final
             {
-            m_widestLabel = m_tallestLabel = Label(GraphItemInfo().Ok(false));
+            ResetLabelMeasurements();
             return GraphItemBase::GetGraphItemInfo();
             }
         /// @private
         void SetFontBackgroundColor(const wxColour& color) final
             {
             GraphItemBase::SetFontBackgroundColor(color);
-            m_widestLabel = m_tallestLabel = Label(GraphItemInfo().Ok(false));
+            ResetLabelMeasurements();
             }
         /// @private
         [[nodiscard]] wxFont& GetFont() noexcept final
             {
-            m_widestLabel = m_tallestLabel = Label(GraphItemInfo().Ok(false));
+            ResetLabelMeasurements();
             return GraphItemBase::GetFont();
             }
         /// @private
@@ -1035,7 +1175,7 @@ namespace Wisteria::GraphItems
         void SetFont(const wxFont& font) final
             {
             GraphItemBase::SetFont(font);
-            m_widestLabel = m_tallestLabel = Label(GraphItemInfo().Ok(false));
+            ResetLabelMeasurements();
             }
 
         // Just hiding these from Doxygen. If these are included inside of groupings,
@@ -1072,6 +1212,34 @@ namespace Wisteria::GraphItems
             return IsShown() && (GetLabelDisplay() != AxisLabelDisplay::NoDisplay);
             }
 
+        /** @brief Fills the axis with points along a range.
+            @param rangeStart The start of the range.
+            @param rangeEnd The end of the range.
+            @param precision The floating-point precision to show on the axis labels.
+            @param interval How often a tickmark should be placed along the axis range.
+            @param displayInterval How often a label should be shown along the tickmarks.
+            @param formatValues @c false to not format the points' values into labels.
+                This is used when only custom labels will be shown (e.g., a date range),
+                as formatting thousands of values that are never shown is wasteful.*/
+        void BuildAxisPoints(double rangeStart, double rangeEnd,
+                             const uint8_t precision, double interval,
+                             const size_t displayInterval, const bool formatValues);
+        /// @returns A custom label with the axis's formatting applied to it.
+        /// @param label The label to format.
+        [[nodiscard]] Label FormatCustomLabel(const Label& label) const;
+        /** @returns The custom label at @c value, or @c nullptr if there isn't one.
+            @param value The axis value to look up.
+            @note If the point has a date label that hasn't been formatted yet,
+                then it is formatted (and remembered) here.*/
+        [[nodiscard]] const Label* FindCustomLabel(const double value) const;
+        /// @returns @c true if @c value has a custom label (including unformatted date labels).
+        /// @param value The axis value to look up.
+        [[nodiscard]] bool HasCustomLabel(const double value) const
+            {
+            return (m_customAxisLabels.find(value) != m_customAxisLabels.cend() ||
+                    m_customDateLabels.find(value) != m_customDateLabels.cend());
+            }
+
         /// @brief Sets the fiscal year date range.
         /// @details This will be used if the date interval is set to DateInterval::FiscalQuarterly.
         ///  Fiscal years can vary between domains. For example, higher education runs July 1st to June 30,
@@ -1165,7 +1333,7 @@ namespace Wisteria::GraphItems
         void SetInterval(const double interval) noexcept
             {
             m_interval = interval;
-            m_widestLabel = m_tallestLabel = Label(GraphItemInfo().Ok(false));
+            ResetLabelMeasurements();
             }
         /// @brief Sets the scaling used just for the axis labels.
         /// @details The parent plot may set all axes to have a common scaling for the
@@ -1175,7 +1343,7 @@ namespace Wisteria::GraphItems
         void SetAxisLabelScaling(const double scaling)
             {
             m_axisLabelScaling = scaling;
-            m_widestLabel = m_tallestLabel = Label(GraphItemInfo().Ok(false));
+            ResetLabelMeasurements();
             }
         /// @returns The font scaling used just for the axis labels.
         [[nodiscard]] double GetAxisLabelScaling() const noexcept
@@ -1194,7 +1362,10 @@ namespace Wisteria::GraphItems
         /// @brief Sets the width of spacing between labels.
         /// @param width The width of spacing between labels.
         void SetLabelPhysicalOffset(const double width) noexcept
-            { m_labelSpacingPhysicalOffset = width; }
+            {
+            m_labelSpacingPhysicalOffset = width;
+            InvalidateCachedBoundingBox();
+            }
         /// @returns The spacing between axis labels.
         [[nodiscard]] double GetLabelPhysicalOffset() const noexcept
             { return m_labelSpacingPhysicalOffset; }
@@ -1214,6 +1385,8 @@ namespace Wisteria::GraphItems
             @param dc The DC to measure with.
             @note This version is more optimal if multiple axes need to be measured with the same DC.*/
         [[nodiscard]] wxRect GetBoundingBox(wxDC& dc) const;
+        /// @brief Calculates the bounding box (the uncached implementation of GetBoundingBox()).
+        [[nodiscard]] wxRect CalcBoundingBox(wxDC& dc) const;
         /** @returns The rectangle of the part of the axis that protrudes outside of the plot area.
             @param dc The DC to measure with.*/
         [[nodiscard]] wxRect GetProtrudingBoundingBox(wxDC& dc) const;
@@ -1266,12 +1439,18 @@ namespace Wisteria::GraphItems
             { return m_customTickMarks; }
         /// @returns The custom tick marks.
         [[nodiscard]] std::vector<TickMark>& GetCustomTickMarks() noexcept
-            { return m_customTickMarks; }
+            {
+            InvalidateCachedBoundingBox();
+            return m_customTickMarks;
+            }
 
         /// @returns The calculated tick marks.
         /// @sa GetCustomTickMarks().
         [[nodiscard]] std::vector<TickMark>& GetTickMarks() noexcept
-            { return m_tickMarks; }
+            {
+            InvalidateCachedBoundingBox();
+            return m_tickMarks;
+            }
         /// @returns The (const) calculated tick marks.
         /// @sa GetCustomTickMarks().
         [[nodiscard]] const std::vector<TickMark>& GetTickMarks() const noexcept
@@ -1279,6 +1458,55 @@ namespace Wisteria::GraphItems
         /// @returns The space between axis labels and the main axis line.
         [[nodiscard]] wxCoord GetSpacingBetweenLabelsAndLine() const noexcept
             { return 5; }
+        /// @brief Discards the cached measurements of the axis labels (and the axis's bounding box).
+        /// @details This should be called whenever the labels' text or settings change.
+        void ResetLabelMeasurements()
+            {
+            m_widestLabel = m_tallestLabel = Label(GraphItemInfo().Ok(false));
+            // keep the last measurements, as the labels may be rebuilt the same way
+            // (e.g., a graph being fed new data that has the same range)
+            if (!m_labelMetrics.empty())
+                {
+                m_previousLabelMetrics = std::move(m_labelMetrics);
+                m_labelMetrics.clear();
+                }
+            InvalidateCachedBoundingBox();
+            }
+        /** @brief Measures every axis label (once) at a given scaling.
+            @details Later calls with the same scaling (and font, padding, and DPI)
+                return the previous measurements.
+            @param dc The DC to measure with.
+            @param scaling The scaling to measure the labels at.
+            @returns The (horizontal) size of each axis point's label, or @c wxDefaultSize
+                for points that don't display a label.
+            @warning The returned reference is only valid until the next call.*/
+        [[nodiscard]] const std::vector<wxSize>& GetLabelSizes(wxDC& dc, const double scaling) const;
+        /// @returns @c true if the labels are resized to fit around their background color
+        ///     (see AdjustLabelSizeIfUsingBackgroundColor()), in which case
+        ///     they must be measured individually.
+        [[nodiscard]] bool IsAdjustingLabelsForBackgroundColor() const
+            {
+            return GetFontBackgroundColor().IsOk() &&
+                GetFontBackgroundColor() != wxTransparentColour &&
+                GetAxisLabelOrientation() == AxisLabelOrientation::Parallel;
+            }
+        /** @returns The size of the first or last displayed label, using the
+                cached label measurements if possible.
+            @param dc The DC to measure with.
+            @param label The label (from GetFirstDisplayedLabel() or GetLastDisplayedLabel()).
+            @param first @c true to find the first displayed label, @c false for the last one.*/
+        [[nodiscard]] wxSize GetOuterLabelSize(wxDC& dc, const Label& label, const bool first) const;
+        /** @returns The largest scaling (stepping down from @c startScaling by tenths,
+                but not below @c 1.0) that a label fits within @c maxSize at.
+            @details Text grows (almost) linearly with its scaling, so the number of steps
+                is estimated from a single measurement and then verified, rather than
+                measuring the label at every step.
+            @param startScaling The scaling to start at.
+            @param maxSize The size that the label must fit in.
+            @param measure A function that measures the label at a given scaling.*/
+        template<typename MeasureT>
+        [[nodiscard]] static double CalcScalingToFit(const double startScaling,
+                                                     const wxCoord maxSize, MeasureT measure);
         /// @returns The widest label;
         [[nodiscard]] Label GetWidestTextLabel(wxDC& dc) const;
         /** @returns The tallest label.
@@ -1318,7 +1546,10 @@ namespace Wisteria::GraphItems
         std::vector<AxisBracket> m_brackets;
 
         std::vector<AxisPoint> m_axisLabels;
-        std::map<double, Label, double_less> m_customAxisLabels;
+        // date labels are formatted into here when they are first requested (so this is mutable)
+        mutable std::map<double, Label, double_less> m_customAxisLabels;
+        // axis values (days into a date range) with date labels that haven't been formatted yet
+        std::set<double, double_less> m_customDateLabels;
         size_t m_suggestedMaxLengthPerLine{ 100 };
 
         std::vector<TickMark> m_tickMarks;
@@ -1382,6 +1613,38 @@ namespace Wisteria::GraphItems
         // cached values
         mutable Label m_widestLabel{ Label(GraphItemInfo().Ok(false)) };
         mutable Label m_tallestLabel{ Label(GraphItemInfo().Ok(false)) };
+        /// @brief Measurements of the axis labels at a given scaling.
+        struct LabelMetrics
+            {
+            double m_scaling{ 1 };
+            double m_dpiScaleFactor{ 1 };
+            wxFont m_font;
+            std::array<wxCoord, 4> m_padding{ 0, 0, 0, 0 };
+            wxSize m_ppi;
+            std::vector<wxSize> m_sizes;
+            // the text that each size was measured from
+            std::vector<wxString> m_texts;
+            /// @returns @c true if these measurements were made with the same settings.
+            [[nodiscard]] bool IsMeasuredWith(const double scaling, const double dpiScaleFactor,
+                                              const wxFont& font,
+                                              const std::array<wxCoord, 4>& padding,
+                                              const wxSize ppi) const
+                {
+                return compare_doubles(m_scaling, scaling) &&
+                    compare_doubles(m_dpiScaleFactor, dpiScaleFactor) &&
+                    m_padding == padding && m_ppi == ppi && m_font == font;
+                }
+            };
+        /// @brief The DC's PPI, content scale, user scale (x and y),
+        ///     and whether the axis was shown when the bounding box was cached.
+        using BoundingBoxMeasurementKey = std::tuple<wxSize, double, double, double, bool>;
+        mutable BoundingBoxMeasurementKey m_cachedBoundingBoxKey;
+        // a layout only measures at a couple of scalings (the parent's and the axis labels'),
+        // plus a few more while fitting the labels
+        mutable std::vector<LabelMetrics> m_labelMetrics;
+        // measurements from before the labels were last changed, which unchanged labels reuse
+        std::vector<LabelMetrics> m_previousLabelMetrics;
+        static constexpr size_t MAX_LABEL_METRICS{ 4 };
 
         wxSize m_outlineSize{ wxDefaultSize };
         };
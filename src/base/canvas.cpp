@@ -7,8 +7,13 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "canvas.h"
+#include <wx/thread.h>
 #include "colorbrewer.h"
 #include "axis.h"
+#include "../graphs/graph2d.h"
+#include "../util/textextentcache.h"
+#include "../util/svgoptimizer.h"
+#include "../util/measuringdc.h"
 
 DEFINE_EVENT_TYPE(EVT_WISTERIA_CANVAS_DCLICK)
 
@@ -16,6 +21,80 @@ using namespace Wisteria::GraphItems;
 using namespace Wisteria::Colors;
 using namespace Wisteria::UI;
 
+namespace
+    {
+    /// @brief Records how long a rendering stage took (and how much text it measured)
+    ///     into a canvas's render metrics when it goes out of scope.
+    class RenderStageScope
+        {
+    public:
+        /// @brief Constructor.
+        /// @param elapsed Where to write how long the stage took.
+        /// @param metrics The metrics to add the stage's text measurement counts to.
+        RenderStageScope(std::chrono::microseconds& elapsed,
+                         Wisteria::Canvas::RenderMetrics& metrics) noexcept :
+            m_elapsed(elapsed), m_metrics(metrics)
+            {}
+        /// @private
+        RenderStageScope(const RenderStageScope&) = delete;
+        /// @private
+        RenderStageScope& operator=(const RenderStageScope&) = delete;
+        /// @private
+        ~RenderStageScope()
+            {
+            m_elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - m_start);
+            // the stage runs on one thread, so only that thread's measurements are counted
+            // (not other canvases' being measured at the same time)
+            m_metrics.m_textMeasurements += TextExtentCache::GetThreadMissCount() - m_startMisses;
+            m_metrics.m_textMeasurementCacheHits +=
+                TextExtentCache::GetThreadHitCount() - m_startHits;
+            }
+    private:
+        std::chrono::microseconds& m_elapsed;
+        Wisteria::Canvas::RenderMetrics& m_metrics;
+        const std::chrono::steady_clock::time_point m_start{ std::chrono::steady_clock::now() };
+        const uint64_t m_startMisses{ TextExtentCache::GetThreadMissCount() };
+        const uint64_t m_startHits{ TextExtentCache::GetThreadHitCount() };
+        };
+
+    /// @brief Marks a canvas's window bitmaps (i.e., its backing bitmap and layout previews)
+    ///     as in use while in scope, so that the memory budget won't release them.
+    class WindowBitmapsInUseScope
+        {
+    public:
+        /// @brief Constructor.
+        /// @param useCount The canvas's counter of scopes using its bitmaps.
+        explicit WindowBitmapsInUseScope(int& useCount) noexcept : m_useCount(useCount)
+            { ++m_useCount; }
+        /// @private
+        WindowBitmapsInUseScope(const WindowBitmapsInUseScope&) = delete;
+        /// @private
+        WindowBitmapsInUseScope& operator=(const WindowBitmapsInUseScope&) = delete;
+        /// @private
+        ~WindowBitmapsInUseScope()
+            { --m_useCount; }
+    private:
+        int& m_useCount;
+        };
+
+    /// @returns The (approximate) number of bytes of pixel data in a bitmap.
+    [[nodiscard]] size_t GetBitmapBytes(const wxBitmap& bmp)
+        {
+        return bmp.IsOk() ?
+            static_cast<size_t>(bmp.GetWidth()) * static_cast<size_t>(bmp.GetHeight()) * 4 :
+            0;
+        }
+
+    /// @returns How long it has been since @c start.
+    [[nodiscard]] std::chrono::microseconds
+        ElapsedSince(const std::chrono::steady_clock::time_point start) noexcept
+        {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start);
+        }
+    }
+
 namespace Wisteria
     {
     /// @brief Printing interface for canvas.
@@ -49,6 +128,8 @@ namespace Wisteria
             wxDC* dc = GetDC();
             if (dc && (page == 1))
                 {
+                // print the window's layout, not the one from the canvas's last export
+                m_canvas->EnsureScreenLayout();
                 dc->SetFont(wxSystemSettings::GetFont(wxSYS_DEFAULT_GUI_FONT));
 
                 // get the size of the canvas
@@ -94,54 +175,22 @@ namespace Wisteria
                 const float scaleYReciprical = safe_divide<float>(1.0f, scaleY);
 
                 // Calculate the position on the DC for centring the graphic
-                const float posX = safe_divide<float>(
-                    (dcWidth -((maxX-(2*marginX))* std::min(scaleX,scaleY))), 2);
-                const float posY = safe_divide<float>(
+                PageLayout layout;
+                layout.m_dcSize = wxSize(dcWidth, dcHeight);
+                // use the same scale factor for x and y to maintain aspect ratio
+                layout.m_scale = std::min(scaleX, scaleY);
+                layout.m_posX = safe_divide<float>(
+                    (dcWidth -((maxX-(2*marginX))* layout.m_scale)), 2);
+                layout.m_posY = safe_divide<float>(
                     (dcHeight - ((maxY-(headerFooterUsedHeight+(2*marginY))) *
-                        std::min(scaleX,scaleY))), 2);
-
-                wxBitmap previewImg;
-                previewImg.CreateWithDIPSize(
-                    wxSize(m_canvas->ToDIP(dcWidth), m_canvas->ToDIP(dcHeight)),
-                    m_canvas->GetDPIScaleFactor());
-                wxMemoryDC memDc(previewImg);
-                memDc.Clear();
-    #ifdef __WXMSW__
-                // use Direct2D for rendering
-                wxGraphicsContext* context{ nullptr };
-                auto renderer = wxGraphicsRenderer::GetDirect2DRenderer();
-                if (renderer)
-                    { context = renderer->CreateContext(memDc); }
+                        layout.m_scale)), 2);
 
-                if (context)
-                    {
-                    wxGCDC gcdc(context);
-
-                    /* Set the scale and origin.
-                       Note that we use the same scale factor for x and y to maintain aspect ratio*/
-                    gcdc.SetUserScale(std::min(scaleX, scaleY), std::min(scaleX, scaleY));
-                    gcdc.SetDeviceOrigin(static_cast<wxCoord>(posX), static_cast<wxCoord>(posY));
-
-                    m_canvas->OnDraw(gcdc);
-                    }
-                else
-                    {
-                    wxGCDC gcdc(memDc);
-
-                    gcdc.SetUserScale(std::min(scaleX, scaleY), std::min(scaleX, scaleY));
-                    gcdc.SetDeviceOrigin(static_cast<wxCoord>(posX), static_cast<wxCoord>(posY));
-
-                    m_canvas->OnDraw(gcdc);
-                    }
-    #else
-                wxGCDC gcdc(memDc);
-
-                gcdc.SetUserScale(std::min(scaleX, scaleY), std::min(scaleX, scaleY));
-                gcdc.SetDeviceOrigin(static_cast<wxCoord>(posX), static_cast<wxCoord>(posY));
-
-                m_canvas->OnDraw(gcdc);
-    #endif
-                dc->Blit(0,0,dcWidth,dcHeight,&memDc,0,0);
+                // the preview repaints the page whenever it is scrolled or zoomed,
+                // so reuse what was rendered for its current zoom level
+                if (IsPreview())
+                    { DrawCachedPage(*dc, layout); }
+                else if (!DrawPageDirectly(*dc, layout))
+                    { DrawPageInStrips(*dc, layout); }
 
                 // draw the headers
                 wxCoord width{0}, height{0};
@@ -213,6 +262,161 @@ namespace Wisteria
             else return false;
             }
     private:
+        /// @brief Where (and how large) the canvas is drawn on the printer's DC.
+        struct PageLayout
+            {
+            wxSize m_dcSize;
+            float m_scale{ 1 };
+            float m_posX{ 0 };
+            float m_posY{ 0 };
+            };
+        /// @brief A page rendered for the preview, along with what it was rendered for.
+        struct CachedPage
+            {
+            wxSize m_dcSize;
+            wxSize m_canvasSize;
+            float m_scale{ 1 };
+            uint64_t m_contentGeneration{ 0 };
+            wxBitmap m_page;
+            };
+
+        /// @brief Draws the canvas onto the (printer's) DC, a strip at a time.
+        /// @details Rendering in strips keeps memory use the same regardless of
+        ///     the printer's resolution.
+        /// @param dc The DC to draw on.
+        /// @param layout Where to draw the canvas.
+        void DrawPageInStrips(wxDC& dc, const PageLayout& layout)
+            {
+            const int dcWidth{ layout.m_dcSize.GetWidth() };
+            const int dcHeight{ layout.m_dcSize.GetHeight() };
+            wxBitmap previewImg;
+            previewImg.CreateWithDIPSize(
+                wxSize(m_canvas->ToDIP(dcWidth),
+                       m_canvas->ToDIP(std::min(dcHeight, Canvas::TILE_HEIGHT))),
+                m_canvas->GetDPIScaleFactor());
+            // set the scale and origin (offset to the current strip) and draw
+            // what is inside of the strip
+            const auto drawStrip = [&](wxDC& gcdc, const int stripTop)
+                {
+                gcdc.SetUserScale(layout.m_scale, layout.m_scale);
+                gcdc.SetDeviceOrigin(static_cast<wxCoord>(layout.m_posX),
+                                     static_cast<wxCoord>(layout.m_posY) - stripTop);
+                const wxRect stripArea(
+                    wxPoint(gcdc.DeviceToLogicalX(0), gcdc.DeviceToLogicalY(0)),
+                    wxPoint(gcdc.DeviceToLogicalX(previewImg.GetWidth()),
+                            gcdc.DeviceToLogicalY(previewImg.GetHeight())));
+                m_canvas->DrawCanvas(gcdc, stripArea);
+                };
+            for (int stripTop = 0; stripTop < dcHeight; stripTop += previewImg.GetHeight())
+                {
+                wxMemoryDC memDc(previewImg);
+                memDc.Clear();
+    #ifdef __WXMSW__
+                // use Direct2D for rendering
+                wxGraphicsContext* context{ nullptr };
+                auto renderer = wxGraphicsRenderer::GetDirect2DRenderer();
+                if (renderer)
+                    { context = renderer->CreateContext(memDc); }
+
+                if (context)
+                    {
+                    wxGCDC gcdc(context);
+                    drawStrip(gcdc, stripTop);
+                    }
+                else
+                    {
+                    wxGCDC gcdc(memDc);
+                    drawStrip(gcdc, stripTop);
+                    }
+    #else
+                    {
+                    wxGCDC gcdc(memDc);
+                    drawStrip(gcdc, stripTop);
+                    }
+    #endif
+                dc.Blit(0, stripTop, dcWidth,
+                        std::min(previewImg.GetHeight(), dcHeight - stripTop), &memDc, 0, 0);
+                }
+            }
+
+        /** @brief Draws the canvas straight onto a printer's DC as vector graphics,
+                skipping the intermediate bitmap.
+            @param dc The DC to draw on.
+            @param layout Where to draw the canvas.
+            @returns @c false if the DC can't be drawn on directly
+                (e.g., a PostScript DC, which graphics contexts can't be created for).*/
+        bool DrawPageDirectly(wxDC& dc, const PageLayout& layout)
+            {
+    #if defined(__WXMSW__) || defined(__WXOSX__)
+            auto* printerDC = wxDynamicCast(&dc, wxPrinterDC);
+            if (printerDC == nullptr)
+                { return false; }
+            wxGCDC gcdc(*printerDC);
+            if (!gcdc.IsOk())
+                { return false; }
+            gcdc.SetUserScale(layout.m_scale, layout.m_scale);
+            gcdc.SetDeviceOrigin(static_cast<wxCoord>(layout.m_posX),
+                                 static_cast<wxCoord>(layout.m_posY));
+            m_canvas->DrawCanvas(gcdc, m_canvas->GetCanvasRect(gcdc));
+            return true;
+    #else
+            wxUnusedVar(dc);
+            wxUnusedVar(layout);
+            return false;
+    #endif
+            }
+
+        /** @brief Draws the page for the print preview, rendering it only if it
+                hasn't already been rendered at the preview's current zoom level.
+            @details Pages rendered before the canvas's content changed (e.g., a graph was
+                replaced or its data updated and the canvas refreshed) are discarded.
+            @param dc The preview's DC.
+            @param layout Where to draw the canvas.*/
+        void DrawCachedPage(wxDC& dc, const PageLayout& layout)
+            {
+            const uint64_t contentGeneration{ m_canvas->m_contentGeneration };
+            m_cachedPages.erase(std::remove_if(m_cachedPages.begin(), m_cachedPages.end(),
+                [contentGeneration](const auto& page) noexcept
+                { return page.m_contentGeneration != contentGeneration; }),
+                m_cachedPages.end());
+
+            wxGCDC measureDC;
+            const wxSize canvasSize{ m_canvas->GetCanvasRect(measureDC).GetSize() };
+            auto cachedPage = std::find_if(m_cachedPages.begin(), m_cachedPages.end(),
+                [&layout, &canvasSize](const auto& page) noexcept
+                {
+                return page.m_dcSize == layout.m_dcSize &&
+                       page.m_canvasSize == canvasSize &&
+                       compare_doubles(page.m_scale, layout.m_scale);
+                });
+            if (cachedPage == m_cachedPages.end())
+                {
+                CachedPage page{ layout.m_dcSize, canvasSize, layout.m_scale,
+                                 contentGeneration, wxBitmap{} };
+                page.m_page.CreateWithDIPSize(m_canvas->ToDIP(layout.m_dcSize),
+                                              m_canvas->GetDPIScaleFactor());
+                    {
+                    wxMemoryDC pageDC(page.m_page);
+                    DrawPageInStrips(pageDC, layout);
+                    }
+                // drop the zoom level that was viewed the longest time ago
+                if (m_cachedPages.size() >= MAX_CACHED_PAGES)
+                    { m_cachedPages.pop_back(); }
+                m_cachedPages.insert(m_cachedPages.begin(), std::move(page));
+                cachedPage = m_cachedPages.begin();
+                }
+            // keep the most recently viewed zoom levels at the front
+            else if (cachedPage != m_cachedPages.begin())
+                {
+                std::rotate(m_cachedPages.begin(), cachedPage, std::next(cachedPage));
+                cachedPage = m_cachedPages.begin();
+                }
+
+            wxMemoryDC pageDC(cachedPage->m_page);
+            dc.Blit(0, 0, layout.m_dcSize.GetWidth(), layout.m_dcSize.GetHeight(),
+                    &pageDC, 0, 0);
+            }
+
         /// @returns The margin around the printing area.
         [[nodiscard]] wxCoord GetMarginPadding() const
             { return 10*m_canvas->GetDPIScaleFactor(); }
@@ -233,6 +437,9 @@ namespace Wisteria
             }
 
         Canvas* m_canvas{ nullptr };
+        // pages rendered for the preview, the most recently viewed first
+        std::vector<CachedPage> m_cachedPages;
+        constexpr static size_t MAX_CACHED_PAGES{ 4 };
         };
 
     /// @brief Temporarily changes a canvas's aspect ratio to fit the page when printing.
@@ -548,6 +755,14 @@ namespace Wisteria
     //--------------------------------------------------
     bool Canvas::Save(const wxFileName& filePath, const ImageExportOptions& options)
         {
+        const auto saveStart = std::chrono::steady_clock::now();
+        m_renderMetrics.m_encodeTime = std::chrono::microseconds{ 0 };
+        const auto recordSaveTime = [this, saveStart](const bool saved)
+            {
+            m_renderMetrics.m_saveTime = ElapsedSince(saveStart);
+            return saved;
+            };
+
         // create the folder to the filepath, if necessary
         wxFileName::Mkdir(filePath.GetPath(), wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL);
 
@@ -564,35 +779,223 @@ namespace Wisteria
             { height = options.m_imageSize.GetHeight(); }
 
         if (filePath.GetExt().CmpNoCase(L"svg") == 0)
+            { return recordSaveTime(RenderToSvg(filePath.GetFullPath())); }
+        else
+            {
+            wxString ext{ filePath.GetExt() };
+            const wxBitmapType imageType = Image::GetImageFileTypeFromExtension(ext);
+
+            // very large images (e.g., posters) are rendered and written in strips
+            // (if the format supports that), rather than one giant bitmap
+            if ((imageType == wxBITMAP_TYPE_PNG || imageType == wxBITMAP_TYPE_TIF) &&
+                static_cast<int64_t>(width) * height >= TILED_EXPORT_MIN_PIXELS)
+                {
+                if (!recordSaveTime(SaveTiled(filePath, options, wxSize(width, height))))
+                    {
+                    wxMessageBox(wxString::Format(_(L"Failed to save image\n(%s)."),
+                        filePath.GetFullPath()),
+                        _(L"Save Error"), wxOK|wxICON_EXCLAMATION);
+                    return false;
+                    }
+                return true;
+                }
+
+            // lay out for the image's size, the same as the tiled export above,
+            // so that the image looks the same no matter which way it is written
+            wxImage img(RenderToImage(wxSize(width, height)));
+
+            const auto encodeStart = std::chrono::steady_clock::now();
+            // apply the color mode (the image is already opaque)
+            Image::FlattenForExport(img, (options.m_mode ==
+                static_cast<decltype(options.m_mode)>(ImageExportOptions::ColorMode::Grayscale)));
+
+            // image specific options
+            options.ApplyEncodingOptions(img, imageType);
+            if (imageType == wxBITMAP_TYPE_GIF)
+                {
+                // use the comment field too
+                img.SetOption(wxIMAGE_OPTION_GIF_COMMENT, GetLabel());
+                }
+
+            const bool saved = img.SaveFile(filePath.GetFullPath(), imageType);
+            m_renderMetrics.m_encodeTime = ElapsedSince(encodeStart);
+            recordSaveTime(saved);
+            if (!saved)
+                {
+                wxMessageBox(wxString::Format(_(L"Failed to save image\n(%s)."),
+                    filePath.GetFullPath()),
+                    _(L"Save Error"), wxOK|wxICON_EXCLAMATION);
+                return false;
+                }
+            return true;
+            }
+        }
+
+    //------------------------------------------
+    bool Canvas::SaveTiled(const wxFileName& filePath, const ImageExportOptions& options,
+                           const wxSize sizeDIPs)
+        {
+        wxFileOutputStream output(filePath.GetFullPath());
+        if (!output.IsOk())
+            { return false; }
+
+        // the bitmap that each strip is drawn on (and reused)
+        wxBitmap stripBitmap;
+        // TILE_HEIGHT is in pixels, so convert it to DIPs for the bitmap's height
+        stripBitmap.CreateWithDIPSize(wxSize(sizeDIPs.GetWidth(),
+                                             std::min(sizeDIPs.GetHeight(), ToDIP(TILE_HEIGHT))),
+                                      GetDPIScaleFactor());
+        if (!stripBitmap.IsOk())
+            { return false; }
+        const wxSize imageSize{ stripBitmap.GetWidth(),
+                                wxRound(sizeDIPs.GetHeight() * GetDPIScaleFactor()) };
+
+        std::unique_ptr<StripImageWriter> writer;
+        const auto profile = static_cast<ImageExportOptions::ExportProfile>(options.m_profile);
+        if (filePath.GetExt().CmpNoCase(L"png") == 0)
+            {
+            writer = std::make_unique<PngStripWriter>(output, imageSize,
+                (profile == ImageExportOptions::ExportProfile::Fast) ? 1 :
+                (profile == ImageExportOptions::ExportProfile::Smallest) ? 9 : 6);
+            }
+        else
+            {
+            // only deflate (or no) compression is available when writing in strips
+            writer = std::make_unique<TiffStripWriter>(output, imageSize,
+                (options.m_tiffCompression != TiffCompression::CompressionNone));
+            }
+
+        // lay out the canvas once for the image's size
+        wxRect originalRect;
+            {
+            wxMemoryDC memDc(stripBitmap);
+            wxGCDC gcdc(memDc);
+            wxEventBlocker blocker(this); // prevent resize event
+            originalRect = LayoutForExport(gcdc, sizeDIPs);
+            }
+
+        const bool grayscale = (options.m_mode ==
+            static_cast<decltype(options.m_mode)>(ImageExportOptions::ColorMode::Grayscale));
+        bool succeeded{ true };
+        for (int stripTop = 0; succeeded && stripTop < imageSize.GetHeight();
+             stripTop += stripBitmap.GetHeight())
             {
-            wxSize CanvasMinSize = GetCanvasRectDIPs().GetSize();
-            CanvasMinSize.SetWidth(std::max(GetCanvasMinWidthDIPs(), CanvasMinSize.GetWidth()));
-            CanvasMinSize.SetHeight(std::max(GetCanvasMinHeightDIPs(), CanvasMinSize.GetHeight()));
+            const int stripHeight = std::min(stripBitmap.GetHeight(),
+                                             imageSize.GetHeight() - stripTop);
+            // draw only what is inside of this strip
+            const auto drawStrip = [this, stripTop, stripHeight, &imageSize](wxDC& dc)
+                {
+                dc.SetDeviceOrigin(0, -stripTop);
+                DrawCanvas(dc, wxRect(0, stripTop, imageSize.GetWidth(), stripHeight));
+                };
+                {
+                wxMemoryDC memDc(stripBitmap);
+                memDc.SetBackground(*wxWHITE_BRUSH);
+                memDc.Clear();
+    #ifdef __WXMSW__
+                wxGraphicsContext* context{ nullptr };
+                auto renderer = wxGraphicsRenderer::GetDirect2DRenderer();
+                if (renderer)
+                    { context = renderer->CreateContext(memDc); }
 
-            wxSVGFileDC svg(filePath.GetFullPath(),
+                if (context)
+                    {
+                    wxGCDC gcdc(context);
+                    drawStrip(gcdc);
+                    }
+                else
+                    {
+                    wxGCDC gcdc(memDc);
+                    drawStrip(gcdc);
+                    }
+    #else
+                wxGCDC gcdc(memDc);
+                drawStrip(gcdc);
+    #endif
+                }
+
+            wxImage strip(stripBitmap.ConvertToImage());
+            // the last strip may be shorter
+            if (stripHeight < strip.GetHeight())
+                { strip = strip.GetSubImage(wxRect(0, 0, strip.GetWidth(), stripHeight)); }
+            Image::FlattenForExport(strip, grayscale);
+            succeeded = writer->WriteStrip(strip);
+            }
+
+        RestoreScreenLayout(originalRect);
+        return succeeded && writer->Finish();
+        }
+
+    //------------------------------------------
+    bool Canvas::RenderToSvg(const wxString& filePath,
+                             const std::optional<wxSize> sizeDIPs /*= std::nullopt*/)
+        {
+        wxSize CanvasMinSize = sizeDIPs.value_or(GetCanvasRectDIPs().GetSize());
+        CanvasMinSize.SetWidth(std::max(GetCanvasMinWidthDIPs(), CanvasMinSize.GetWidth()));
+        CanvasMinSize.SetHeight(std::max(GetCanvasMinHeightDIPs(), CanvasMinSize.GetHeight()));
+
+        // wxSVGFileDC writes every primitive with its own styling, so draw into a
+        // temporary file and then compact that into the real one
+        const wxString rawFilePath = wxFileName::CreateTempFileName(L"wisteria-svg");
+        if (rawFilePath.empty())
+            { return false; }
+            {
+            wxSVGFileDC svg(rawFilePath,
                 CanvasMinSize.GetWidth(), CanvasMinSize.GetHeight(), 72.0, GetLabel());
+            if (!svg.IsOk())
+                {
+                wxRemoveFile(rawFilePath);
+                return false;
+                }
             svg.SetBitmapHandler(new wxSVGBitmapEmbedHandler());
             // rescale everything to the SVG DC's scaling
             wxEventBlocker blocker(this); // prevent resize event
-            CalcAllSizes(svg);
-            OnDraw(svg);
-            // readjust the measurements to the canvas's DC
-            wxGCDC gdc(this);
-            CalcAllSizes(gdc);
-            return true;
-            }
-        else
+            const wxRect originalRect = LayoutForExport(svg, CanvasMinSize);
+            DrawCanvas(svg, std::nullopt);
+            RestoreScreenLayout(originalRect);
+            } // the DC writes the file when it is destroyed
+
+        bool written{ false };
             {
-            wxString ext{ filePath.GetExt() };
-            const wxBitmapType imageType = Image::GetImageFileTypeFromExtension(ext);
+            wxFileInputStream rawFile(rawFilePath);
+            wxFileOutputStream outputFile(filePath);
+            if (rawFile.IsOk() && outputFile.IsOk())
+                {
+                // the optimizer reads the raw file a character at a time,
+                // so read it through a buffer rather than from the file directly
+                wxBufferedInputStream bufferedInput(rawFile, SVG_BUFFER_SIZE);
+                wxBufferedOutputStream bufferedOutput(outputFile, SVG_BUFFER_SIZE);
+                wxStdInputStream input(bufferedInput);
+                wxStdOutputStream output(bufferedOutput);
+                written = SvgOptimizer().Optimize(input, output);
+                bufferedOutput.Sync();
+                written = written && bufferedOutput.IsOk() && outputFile.IsOk();
+                }
+            }
+        // if the file couldn't be compacted, then use it as-is
+        if (!written)
+            { written = wxCopyFile(rawFilePath, filePath); }
+        wxRemoveFile(rawFilePath);
+        return written;
+        }
 
-            // new bitmap to be used by memory DC
-            wxBitmap exportFile;
-            exportFile.CreateWithDIPSize(
-                wxSize(width, height),
-                GetDPIScaleFactor());
-            wxMemoryDC memDc(exportFile);
-            memDc.Clear();
+    //------------------------------------------
+    wxImage Canvas::RenderToImage(const std::optional<wxSize> sizeDIPs /*= std::nullopt*/)
+        {
+        wxBitmap exportFile;
+        exportFile.CreateWithDIPSize(sizeDIPs.value_or(GetCanvasRectDIPs().GetSize()),
+                                     GetDPIScaleFactor());
+        wxMemoryDC memDc(exportFile);
+        memDc.Clear();
+        wxRect originalRect;
+            {
+            wxEventBlocker blocker(this); // prevent resize event
+            // lay out and draw with the same DC
+            const auto layoutAndDraw = [this, &sizeDIPs, &originalRect](wxDC& dc)
+                {
+                originalRect = LayoutForExport(dc, sizeDIPs);
+                DrawCanvas(dc, std::nullopt);
+                };
     #ifdef __WXMSW__
             wxGraphicsContext* context{ nullptr };
             auto renderer = wxGraphicsRenderer::GetDirect2DRenderer();
@@ -602,57 +1005,100 @@ namespace Wisteria
             if (context)
                 {
                 wxGCDC gcdc(context);
-                OnDraw(gcdc);
+                layoutAndDraw(gcdc);
                 }
             else
                 {
                 wxGCDC gcdc(memDc);
-                OnDraw(gcdc);
+                layoutAndDraw(gcdc);
                 }
     #else
             wxGCDC gcdc(memDc);
-            OnDraw(gcdc);
+            layoutAndDraw(gcdc);
     #endif
-            // unlock the image from the DC
-            memDc.SelectObject(wxNullBitmap);
-            Image::SetOpacity(exportFile, wxALPHA_OPAQUE);
-
-            // save image with contents of the DC to a file
-            wxImage img(exportFile.ConvertToImage());
-
-            // color mode
-            if (options.m_mode ==
-                static_cast<decltype(options.m_mode)>(ImageExportOptions::ColorMode::Grayscale) )
-                { img = img.ConvertToGreyscale(); }
+            }
+        // unlock the image from the DC
+        memDc.SelectObject(wxNullBitmap);
+        RestoreScreenLayout(originalRect);
+        wxImage img(exportFile.ConvertToImage());
+        Image::FlattenForExport(img, false);
+        return img;
+        }
 
-            // image specific options
-            if (imageType == wxBITMAP_TYPE_TIF)
+    //------------------------------------------
+    std::vector<wxImage> Canvas::RenderToImages(const std::vector<Canvas*>& canvases,
+                                                const std::optional<wxSize> sizeDIPs /*= std::nullopt*/)
+        {
+        wxASSERT_MSG(wxThread::IsMain(),
+                     L"Canvas::RenderToImages() must be called from the main thread!");
+        std::vector<wxImage> images(canvases.size());
+        // wxWidgets's fonts, pens, and brushes (including the system and stock ones that
+        // the canvases' objects share) aren't reference counted atomically, so the canvases
+        // are rendered one at a time (rather than on worker threads)
+        for (size_t i = 0; i < canvases.size(); ++i)
+            {
+            auto canvas = canvases[i];
+            if (canvas == nullptr)
+                { continue; }
+            images[i] = wxImage(sizeDIPs.value_or(canvas->GetCanvasRectDIPs().GetSize()));
+            images[i].SetRGB(wxRect(images[i].GetSize()), 255, 255, 255);
+            wxGraphicsContext* context =
+                wxGraphicsRenderer::GetDefaultRenderer()->CreateContextFromImage(images[i]);
+            if (context == nullptr)
+                { continue; }
+            wxRect originalRect;
                 {
-                img.SetOption(wxIMAGE_OPTION_COMPRESSION,
-                              static_cast<int>(options.m_tiffCompression));
-                }
-            else if (imageType == wxBITMAP_TYPE_JPEG)
-                { img.SetOption(wxIMAGE_OPTION_QUALITY, 100); }
-            else if (imageType == wxBITMAP_TYPE_PNG)
-                { img.SetOption(wxIMAGE_OPTION_PNG_COMPRESSION_LEVEL, 9); } // max compression
-            else if (imageType == wxBITMAP_TYPE_GIF)
-                {
-                // "dumb" image down to 256 colors
-                wxQuantize::Quantize(img, img, 256);
-                img.ConvertAlphaToMask();
-                // use the comment field too
-                img.SetOption(wxIMAGE_OPTION_GIF_COMMENT, GetLabel());
+                // the DC takes ownership of the context and will write back to the image
+                // when it is destroyed
+                wxGCDC dc(context);
+                originalRect = canvas->LayoutForExport(dc, sizeDIPs);
+                canvas->DrawCanvas(dc, std::nullopt);
                 }
+            canvas->RestoreScreenLayout(originalRect);
+            }
+        return images;
+        }
 
-            if (!img.SaveFile(filePath.GetFullPath(), imageType))
-                {
-                wxMessageBox(wxString::Format(_(L"Failed to save image\n(%s)."),
-                    filePath.GetFullPath()),
-                    _(L"Save Error"), wxOK|wxICON_EXCLAMATION);
-                return false;
-                }
-            return true;
+    //------------------------------------------
+    wxRect Canvas::LayoutForExport(wxDC& dc, const std::optional<wxSize> sizeDIPs)
+        {
+        if (wxThread::IsMain())
+            { WaitForDeferredLayout(); }
+        const wxRect originalRect{ m_rectDIPs };
+        if (sizeDIPs)
+            { m_rectDIPs.SetSize(sizeDIPs.value()); }
+        CalcAllSizes(dc);
+        return originalRect;
+        }
+
+    //------------------------------------------
+    void Canvas::RestoreScreenLayout(const wxRect& originalRectDIPs)
+        {
+        m_rectDIPs = originalRectDIPs;
+        // readjust the measurements to the canvas's DC, but only if visible;
+        // otherwise, wait until it is painted (a hidden canvas being used for
+        // batch rendering will probably be laid out for another export first)
+        if (IsShownOnScreen())
+            {
+            wxEventBlocker blocker(this);
+            wxGCDC gdc(this);
+            CalcAllSizes(gdc);
+            m_screenLayoutIsStale = false;
             }
+        else
+            { m_screenLayoutIsStale = true; }
+        }
+
+    //------------------------------------------
+    void Canvas::EnsureScreenLayout()
+        {
+        WaitForDeferredLayout();
+        if (!m_screenLayoutIsStale)
+            { return; }
+        wxEventBlocker blocker(this);
+        wxGCDC gdc(this);
+        CalcAllSizes(gdc);
+        m_screenLayoutIsStale = false;
         }
 
     //------------------------------------------
@@ -670,8 +1116,16 @@ namespace Wisteria
         SetBackgroundColour(*wxWHITE);
         SetScrollbars(10, 10, 0, 0);
         SetVirtualSize(size);
-        wxGCDC gdc(this);
-        CalcAllSizes(gdc);
+        // the window may not be shown yet (or ever, if only used for exporting),
+        // so lay out with a measuring DC if it scales the same way as the window
+        if (auto measuringDC = MeasuringDC::GetForCurrentThread();
+            measuringDC != nullptr && measuringDC->MatchesScaleOf(*this))
+            { CalcAllSizes(*measuringDC); }
+        else
+            {
+            wxGCDC gdc(this);
+            CalcAllSizes(gdc);
+            }
 
         Bind(wxEVT_MENU,
             [this]([[maybe_unused]] wxCommandEvent&)
@@ -691,6 +1145,8 @@ namespace Wisteria
         Bind(wxEVT_KEY_DOWN, &Canvas::OnKeyDown, this);
         Bind(wxEVT_PAINT, &Canvas::OnPaint, this);
         Bind(wxEVT_SIZE, &Canvas::OnResize, this);
+        m_resizeTimer.SetOwner(this);
+        Bind(wxEVT_TIMER, &Canvas::OnResizeTimer, this, m_resizeTimer.GetId());
         Bind(wxEVT_CONTEXT_MENU, &Canvas::OnContextMenu, this);
         Bind(wxEVT_MENU, &Canvas::OnSave, this, wxID_SAVE);
         Bind(wxEVT_MENU, &Canvas::OnCopy, this, wxID_COPY);
@@ -717,6 +1173,111 @@ namespace Wisteria
         Bind(wxEVT_AUX2_UP, &Canvas::OnMouseEvent, this);
         Bind(wxEVT_AUX2_DCLICK, &Canvas::OnMouseEvent, this);
         Bind(wxEVT_MAGNIFY, &Canvas::OnMouseEvent, this);
+
+        m_memoryBudgetRegistration = MemoryBudget::Register(
+            wxString::Format(L"Canvas %d caches", GetId()),
+            [this]([[maybe_unused]] const size_t bytesToFree)
+                {
+                // release right away if it is safe to, so that the budget sees the freed bytes
+                // (and doesn't go on to evict the more recently used caches as well)
+                if (wxThread::IsMain() && m_windowBitmapsInUse == 0 && !IsLayoutPending())
+                    {
+                    ReleaseCaches();
+                    return;
+                    }
+                // Otherwise, the budget is being enforced from a worker thread, or from the
+                // main thread while this canvas is drawing (e.g., a text measurement going over budget),
+                // so release the caches once the main thread gets back to its event loop.
+                // (Pending calls are discarded if the canvas is destroyed first.)
+                if (m_releaseCachesPending.exchange(true))
+                    { return; }
+                CallAfter([this]()
+                    {
+                    m_releaseCachesPending = false;
+                    // other caches may have been evicted (or released) in the meantime,
+                    // so only release these if the program is still over budget
+                    const size_t budget = MemoryBudget::GetBudget();
+                    if (budget == 0 || MemoryBudget::GetUsedBytes() <= budget)
+                        { return; }
+                    // a deferred layout is about to run, try again next time
+                    if (IsLayoutPending())
+                        { return; }
+                    ReleaseCaches();
+                    });
+                });
+        }
+
+    //---------------------------------------------------
+    size_t Canvas::GetWindowBitmapsMemoryUsage() const
+        {
+        size_t bytes = GetBitmapBytes(m_backingStore);
+        for (const auto& [previewSize, preview] : m_layoutPreviews)
+            { bytes += GetBitmapBytes(preview); }
+        return bytes;
+        }
+
+    //---------------------------------------------------
+    size_t Canvas::GetCachesMemoryUsage() const
+        {
+        size_t bytes = GetWindowBitmapsMemoryUsage() +
+            GetBitmapBytes(m_bgImageCache) + GetBitmapBytes(m_watermarkImgCache);
+        for (const auto& row : m_fixedObjects)
+            {
+            for (const auto& object : row)
+                {
+                if (const auto graph = std::dynamic_pointer_cast<Graphs::Graph2D>(object);
+                    graph != nullptr)
+                    { bytes += graph->GetCachesMemoryUsage(); }
+                }
+            }
+        return bytes;
+        }
+
+    //---------------------------------------------------
+    void Canvas::UpdateMemoryBudget()
+        {
+        m_memoryBudgetRegistration.SetBytes(GetCachesMemoryUsage());
+        m_memoryBudgetRegistration.Touch();
+        MemoryBudget::Enforce();
+        }
+
+    //---------------------------------------------------
+    size_t Canvas::GetMemoryUsage() const
+        {
+        size_t bytes = GetWindowBitmapsMemoryUsage() +
+            GetBitmapBytes(m_bgImageCache) + GetBitmapBytes(m_watermarkImgCache);
+        for (const auto& row : m_fixedObjects)
+            {
+            for (const auto& object : row)
+                {
+                if (const auto graph = std::dynamic_pointer_cast<Graphs::Graph2D>(object);
+                    graph != nullptr)
+                    { bytes += graph->GetMemoryUsage(); }
+                }
+            }
+        return bytes;
+        }
+
+    //---------------------------------------------------
+    void Canvas::ReleaseCaches()
+        {
+        if (m_windowBitmapsInUse == 0)
+            {
+            m_backingStore = wxNullBitmap;
+            InvalidateBackingStore();
+            }
+        m_bgImageCache = wxNullBitmap;
+        m_watermarkImgCache = wxNullBitmap;
+        for (const auto& row : m_fixedObjects)
+            {
+            for (const auto& object : row)
+                {
+                if (const auto graph = std::dynamic_pointer_cast<Graphs::Graph2D>(object);
+                    graph != nullptr)
+                    { graph->ReleaseCaches(); }
+                }
+            }
+        m_memoryBudgetRegistration.SetBytes(GetCachesMemoryUsage());
         }
 
     //----------------------------------------------------------------
@@ -824,25 +1385,266 @@ namespace Wisteria
     //---------------------------------------------------
     void Canvas::OnResize([[maybe_unused]] wxSizeEvent& event)
         {
+        // coalesce size events (e.g., while the window's border is being dragged)
+        // and show an image of the current layout until the size settles
+        if (m_resizeDelay > 0 && m_zoomLevel <= 0)
+            {
+            if (!m_resizePending)
+                {
+                CacheLayoutPreview();
+                m_resizeStartSize = GetClientSize();
+                m_resizePending = true;
+                }
+            m_resizeTimer.StartOnce(m_resizeDelay);
+            // call the base version, as the layout hasn't changed yet
+            wxScrolledWindow::Refresh(false);
+            return;
+            }
+        ResizeCanvas();
+        }
+
+    //---------------------------------------------------
+    void Canvas::OnResizeTimer([[maybe_unused]] wxTimerEvent& event)
+        {
+        m_resizePending = false;
+        // resized back to where it started, so the current layout is still valid
+        if (GetClientSize() == m_resizeStartSize)
+            {
+            wxScrolledWindow::Refresh(false);
+            return;
+            }
+        // the images of the other sizes' layouts are still valid,
+        // as only the size of the canvas is changing
+        auto layoutPreviews = std::move(m_layoutPreviews);
+        ResizeCanvas();
+        m_layoutPreviews = std::move(layoutPreviews);
+        wxScrolledWindow::Refresh(true);
+        }
+
+    //---------------------------------------------------
+    void Canvas::CacheLayoutPreview()
+        {
+        const wxSize clientSize{ GetClientSize() };
+        if (clientSize.GetWidth() <= 0 || clientSize.GetHeight() <= 0 || IsLayoutPending())
+            { return; }
+        const WindowBitmapsInUseScope bitmapsInUse(m_windowBitmapsInUse);
+        // move this size's image to the front if already cached
+        if (auto cachedPreview = std::find_if(m_layoutPreviews.begin(), m_layoutPreviews.end(),
+                [&clientSize](const auto& preview) noexcept
+                    { return preview.first == clientSize; });
+            cachedPreview != m_layoutPreviews.end())
+            {
+            std::rotate(m_layoutPreviews.begin(), cachedPreview, std::next(cachedPreview));
+            return;
+            }
+
+        wxClientDC cdc(this);
+        wxBitmap preview;
+        preview.Create(clientSize, cdc);
+        wxMemoryDC memDC(preview);
+        memDC.SetBackground(*wxWHITE_BRUSH);
+        memDC.Clear();
+        // copy from the backing bitmap if available; otherwise, render the visible area
+        if (IsUsingBackingStore())
+            {
+            UpdateBackingStore();
+            wxMemoryDC backingDC(m_backingStore);
+            wxPoint viewStart;
+            CalcUnscrolledPosition(0, 0, &viewStart.x, &viewStart.y);
+            memDC.Blit(wxPoint(0, 0), clientSize, &backingDC, viewStart);
+            }
+        else
+            {
+            wxGCDC dc(memDC);
+            PrepareDC(dc);
+            DrawCanvas(dc, std::nullopt);
+            }
+        memDC.SelectObject(wxNullBitmap);
+
+        m_layoutPreviews.insert(m_layoutPreviews.begin(), std::make_pair(clientSize, preview));
+        if (m_layoutPreviews.size() > m_maxLayoutPreviews)
+            { m_layoutPreviews.resize(m_maxLayoutPreviews); }
+        UpdateMemoryBudget();
+        }
+
+    //---------------------------------------------------
+    void Canvas::DrawLayoutPreview(wxDC& dc)
+        {
+        if (m_layoutPreviews.empty())
+            { return; }
+        const wxSize clientSize{ GetClientSize() };
+        // use the image for this exact size if we have one;
+        // otherwise, scale the most recent layout's image
+        auto preview = std::find_if(m_layoutPreviews.cbegin(), m_layoutPreviews.cend(),
+            [&clientSize](const auto& cachedPreview) noexcept
+                { return cachedPreview.first == clientSize; });
+        if (preview == m_layoutPreviews.cend())
+            { preview = m_layoutPreviews.cbegin(); }
+
+        dc.SetBackground(*wxWHITE_BRUSH);
+        dc.Clear();
+        wxMemoryDC memDC;
+        memDC.SelectObjectAsSource(preview->second);
+        const wxSize previewSize{ preview->second.GetSize() };
+        if (previewSize == clientSize)
+            { dc.Blit(wxPoint(0, 0), previewSize, &memDC, wxPoint(0, 0)); }
+        else
+            {
+            // keep the aspect ratio so that text isn't distorted
+            const double scale = std::min(
+                safe_divide<double>(clientSize.GetWidth(), previewSize.GetWidth()),
+                safe_divide<double>(clientSize.GetHeight(), previewSize.GetHeight()));
+            dc.StretchBlit(wxPoint(0, 0),
+                           wxSize(static_cast<int>(previewSize.GetWidth() * scale),
+                                  static_cast<int>(previewSize.GetHeight() * scale)),
+                           &memDC, wxPoint(0, 0), previewSize);
+            }
+        }
+
+    //---------------------------------------------------
+    void Canvas::ResizeCanvas()
+        {
+        // a layout is already queued, so lay it out again for the new size
+        // once that is finished
+        if (IsLayoutPending())
+            {
+            m_relayoutRequested = true;
+            return;
+            }
         wxGCDC gdc(this);
         // if the new size is larger than the canvas itself, then turn off zooming.
-        if (GetClientRect().GetWidth() > GetCanvasRect(gdc).GetWidth() &&
-            GetClientRect().GetHeight() > GetCanvasRect(gdc).GetHeight())
-            { m_zoomLevel = 0; }
+        if (GetClientRect().GetWidth() > GetZoomedCanvasSize(gdc).GetWidth() &&
+            GetClientRect().GetHeight() > GetZoomedCanvasSize(gdc).GetHeight())
+            {
+            m_zoomLevel = 0;
+            m_zoomTransform = 1.0;
+            }
         // don't resize if canvas is zoomed into
         if (m_zoomLevel <= 0)
             {
             m_rectDIPs = GetClientRect();
             m_rectDIPs.SetWidth(gdc.ToDIP(m_rectDIPs.GetWidth()));
             m_rectDIPs.SetHeight(gdc.ToDIP(m_rectDIPs.GetHeight()));
+            if (DeferLayout())
+                { return; }
+            CalcAllSizes(gdc);
+            m_screenLayoutIsStale = false;
+            SetVirtualSize(GetZoomedCanvasSize(gdc));
+            }
+        }
+
+    //---------------------------------------------------
+    bool Canvas::DeferLayout()
+        {
+        wxASSERT_MSG(!IsLayoutPending(),
+                     L"Canvas is already waiting to be laid out!");
+        if (!IsDeferredLayout() || IsLayoutPending())
+            { return false; }
+
+        // The layout measures text with wxWidgets's fonts, pens, and brushes, which
+        // aren't safe to use on a worker thread (their reference counts aren't atomic).
+        // So the layout is queued on the main thread instead, letting the placeholders
+        // be painted (and the resize finish) before the canvas is laid out.
+        CalcLayoutPlaceholders();
+        InvalidateBackingStore();
+        m_layoutPending = true;
+        CallAfter([this]() { FinishDeferredLayout(); });
+        return true;
+        }
+
+    //---------------------------------------------------
+    void Canvas::FinishDeferredLayout(const bool relayout /*= true*/)
+        {
+        // already finished by WaitForDeferredLayout()
+        if (!IsLayoutPending())
+            { return; }
+        // cleared first, as CalcAllSizes() waits for pending layouts
+        m_layoutPending = false;
+            {
+            wxGCDC gdc(this);
             CalcAllSizes(gdc);
-            SetVirtualSize(GetCanvasRect(gdc).GetSize());
+            SetVirtualSize(GetZoomedCanvasSize(gdc));
+            }
+        m_layoutPlaceholdersDIPs.clear();
+        m_screenLayoutIsStale = false;
+
+        // the window was resized while it was waiting to be laid out
+        if (m_relayoutRequested)
+            {
+            m_relayoutRequested = false;
+            if (relayout)
+                { ResizeCanvas(); }
+            else
+                { CallAfter([this]() { ResizeCanvas(); }); }
+            }
+        wxScrolledWindow::Refresh(true);
+        }
+
+    //---------------------------------------------------
+    void Canvas::WaitForDeferredLayout()
+        {
+        if (IsLayoutPending())
+            { FinishDeferredLayout(false); }
+        }
+
+    //---------------------------------------------------
+    void Canvas::CalcLayoutPlaceholders()
+        {
+        m_layoutPlaceholdersDIPs.clear();
+        const wxRect canvasRect{ GetCanvasRectDIPs() };
+        double rowTop{ static_cast<double>(canvasRect.GetTop()) };
+        for (size_t row = 0; row < GetFixedObjects().size(); ++row)
+            {
+            const double rowHeight = canvasRect.GetHeight() *
+                GetRowInfo(row).GetHeightProportion();
+            double columnLeft{ static_cast<double>(canvasRect.GetLeft()) };
+            for (const auto& object : GetFixedObjects()[row])
+                {
+                if (object == nullptr)
+                    { continue; }
+                const double columnWidth = canvasRect.GetWidth() *
+                    object->GetCanvasWidthProportion();
+                m_layoutPlaceholdersDIPs.emplace_back(
+                    wxRect(wxRound(columnLeft), wxRound(rowTop),
+                           wxRound(columnWidth), wxRound(rowHeight)).Deflate(5));
+                columnLeft += columnWidth;
+                }
+            rowTop += rowHeight;
+            }
+        }
+
+    //---------------------------------------------------
+    void Canvas::DrawLayoutPlaceholders(wxDC& dc)
+        {
+        dc.SetBackground(*wxWHITE_BRUSH);
+        dc.Clear();
+        wxDCPenChanger pc(dc, wxPen(ColorBrewer::GetColor(Color::LightGray),
+                                    dc.FromDIP(1), wxPENSTYLE_LONG_DASH));
+        wxDCBrushChanger bc(dc, wxBrush(ColorBrewer::GetColor(Color::GhostWhite)));
+        for (const auto& placeholder : m_layoutPlaceholdersDIPs)
+            {
+            dc.DrawRectangle(wxRect(dc.FromDIP(placeholder.GetTopLeft()),
+                                    dc.FromDIP(placeholder.GetSize())));
             }
         }
 
     //---------------------------------------------------
     void Canvas::CalcAllSizes(wxDC& dc)
         {
+        // bitmaps can only be destroyed in the main thread
+        // (this may be laid out from a worker thread)
+        if (wxThread::IsMain())
+            {
+            // a queued layout calls this itself, so finish it before this layout's
+            // metrics are started (otherwise, they would include that layout)
+            WaitForDeferredLayout();
+            InvalidateBackingStore();
+            }
+
+        const Settings::RenderScope settingsScope(m_renderSettings);
+        const RenderStageScope layoutScope(m_renderMetrics.m_layoutTime, m_renderMetrics);
+        ++m_renderMetrics.m_layoutCount;
+        m_renderMetrics.m_objects.clear();
         wxASSERT_MSG(
             (std::accumulate(m_rowsInfo.cbegin(), m_rowsInfo.cend(), 0.0,
                 [](const auto initVal, const auto val) noexcept
@@ -931,7 +1733,9 @@ namespace Wisteria
             // and usually something like a legend. This is done to keep the legend close
             // to its original height calculation; otherwise, canvas titles could steal
             // real estate for the legend and make it too small.
-            if (GetRowInfo(currentRowIndex).IsProportionLocked() && currentRowIndex > 0)
+            const bool previousRowsResized =
+                (GetRowInfo(currentRowIndex).IsProportionLocked() && currentRowIndex > 0);
+            if (previousRowsResized)
                 {
                 const auto rowHeightDiff = rowHeightFullCanvas - rowHeightGridArea;
                 rowHeightOffset -= rowHeightDiff;
@@ -952,7 +1756,7 @@ namespace Wisteria
                             bBox.SetHeight(bBox.GetHeight() - rowHeightDiffForPreviousRows);
                             bBox.Offset(wxPoint(0, -(rowHeightDiffForPreviousRows * previousRowIndex)) );
                             previousRowObject->SetBoundingBox(bBox, dc, GetScaling());
-                            previousRowObject->RecalcSizes(dc);
+                            RecalcObjectSizes(*previousRowObject, dc);
                             previousRowObject->UpdateSelectedItems();
                             }
                         }
@@ -1044,45 +1848,23 @@ namespace Wisteria
                         }
                     currentXPos += nonPaddedBoundingRect.GetWidth();
 
-                    objectsPos->RecalcSizes(dc);
+                    RecalcObjectSizes(*objectsPos, dc);
                     objectsPos->UpdateSelectedItems();
                     }
                 }
             if (IsRowContentAligned())
                 {
-                for (auto fixedObjectsRowItems = GetFixedObjects().begin();
-                     fixedObjectsRowItems != GetFixedObjects().end();
-                     ++fixedObjectsRowItems)
+                // Only this row needs to be aligned, as the rows after it haven't been laid out
+                // yet (they will be aligned when they are). The exception is if the previous
+                // rows were just resized to make room for this one.
+                if (previousRowsResized)
                     {
-                    std::vector<wxCoord> topPoints;
-                    std::vector<wxCoord> bottomPoints;
-                    for (auto& objectsPos : *fixedObjectsRowItems)
-                        {
-                        if (objectsPos != nullptr &&
-                            !objectsPos->GetContentRect().IsEmpty())
-                            {
-                            topPoints.emplace_back(objectsPos->GetContentRect().GetTop());
-                            bottomPoints.emplace_back(objectsPos->GetContentRect().GetBottom());
-                            }
-                        }
-                    if (topPoints.size() && bottomPoints.size())
-                        {
-                        const auto topPt = *std::max_element(topPoints.cbegin(), topPoints.cend());
-                        const auto bottomPt = *std::min_element(bottomPoints.cbegin(),
-                                                                bottomPoints.cend());
-                        for (auto& objectsPos : *fixedObjectsRowItems)
-                            {
-                            if (objectsPos != nullptr &&
-                                !objectsPos->GetContentRect().IsEmpty())
-                                {
-                                objectsPos->SetContentTop(topPt);
-                                objectsPos->SetContentBottom(bottomPt);
-                                objectsPos->RecalcSizes(dc);
-                                objectsPos->UpdateSelectedItems();
-                                }
-                            }
-                        }
+                    for (size_t previousRowIndex = 0;
+                         previousRowIndex < static_cast<size_t>(currentRowIndex);
+                         ++previousRowIndex)
+                        { AlignRowItems(GetFixedObjects().at(previousRowIndex), dc); }
                     }
+                AlignRowItems(currentRow, dc);
                 }
             rowHeightOffset += rowHeight;
             }
@@ -1132,10 +1914,18 @@ namespace Wisteria
                             if (objectPos != nullptr &&
                                 !objectPos->GetContentRect().IsEmpty())
                                 {
+                                // if already aligned (e.g., identical small multiples),
+                                // then its layout won't change
+                                const bool isAligned =
+                                    (objectPos->GetContentRect().GetLeft() == leftPt &&
+                                     objectPos->GetContentRect().GetRight() == rightPt);
                                 objectPos->SetContentLeft(leftPt);
                                 objectPos->SetContentRight(rightPt);
-                                objectPos->RecalcSizes(dc);
-                                objectPos->UpdateSelectedItems();
+                                if (!isAligned)
+                                    {
+                                    RecalcObjectSizes(*objectPos, dc);
+                                    objectPos->UpdateSelectedItems();
+                                    }
                                 }
                             }
                         }
@@ -1143,7 +1933,52 @@ namespace Wisteria
                 }
             }
 
-        SetVirtualSize(GetCanvasRect(dc).GetSize());
+        // scrollbars are only updated from the main thread
+        // (this may be laid out from a worker thread when exporting)
+        if (wxThread::IsMain())
+            { SetVirtualSize(GetZoomedCanvasSize(dc)); }
+        }
+
+    //---------------------------------------------------
+    void Canvas::AlignRowItems(std::vector<std::shared_ptr<GraphItems::GraphItemBase>>& row,
+                               wxDC& dc)
+        {
+        std::vector<wxCoord> topPoints;
+        std::vector<wxCoord> bottomPoints;
+        for (auto& objectsPos : row)
+            {
+            if (objectsPos != nullptr &&
+                !objectsPos->GetContentRect().IsEmpty())
+                {
+                topPoints.emplace_back(objectsPos->GetContentRect().GetTop());
+                bottomPoints.emplace_back(objectsPos->GetContentRect().GetBottom());
+                }
+            }
+        if (topPoints.size() && bottomPoints.size())
+            {
+            const auto topPt = *std::max_element(topPoints.cbegin(), topPoints.cend());
+            const auto bottomPt = *std::min_element(bottomPoints.cbegin(),
+                                                    bottomPoints.cend());
+            for (auto& objectsPos : row)
+                {
+                if (objectsPos != nullptr &&
+                    !objectsPos->GetContentRect().IsEmpty())
+                    {
+                    // if already aligned (e.g., identical small multiples),
+                    // then its layout won't change
+                    const bool isAligned =
+                        (objectsPos->GetContentRect().GetTop() == topPt &&
+                         objectsPos->GetContentRect().GetBottom() == bottomPt);
+                    objectsPos->SetContentTop(topPt);
+                    objectsPos->SetContentBottom(bottomPt);
+                    if (!isAligned)
+                        {
+                        RecalcObjectSizes(*objectsPos, dc);
+                        objectsPos->UpdateSelectedItems();
+                        }
+                    }
+                }
+            }
         }
 
     //---------------------------------------------------
@@ -1274,6 +2109,7 @@ namespace Wisteria
     //---------------------------------------------------
     void Canvas::SetFixedObjectsGridSize(const size_t rows, const size_t columns)
         {
+        InvalidateBackingStore();
         m_fixedObjects.resize(rows);
         for (auto pos = m_fixedObjects.begin();
              pos != m_fixedObjects.end();
@@ -1385,6 +2221,7 @@ namespace Wisteria
             SetFixedObjectsGridSize(GetFixedObjects().size(), column + 1);
             }
         GetFixedObjects().at(row).at(column) = object;
+        InvalidateBackingStore();
         // readjust the width if being fit with its content width-wise
         if (object != nullptr && object->IsFittingContentWidthToCanvas())
             {
@@ -1397,6 +2234,64 @@ namespace Wisteria
     //---------------------------------------------------
     void Canvas::OnPaint([[maybe_unused]] wxPaintEvent& event)
         {
+        const WindowBitmapsInUseScope bitmapsInUse(m_windowBitmapsInUse);
+        // the canvas was last laid out for an export, so lay it out for the window again
+        if (m_screenLayoutIsStale && !IsLayoutPending() && !DeferLayout())
+            {
+            wxGCDC gdc(this);
+            CalcAllSizes(gdc);
+            m_screenLayoutIsStale = false;
+            }
+        // the canvas is waiting to be laid out, so show an image of the
+        // last layout (or placeholders for its objects) until it is ready
+        if (IsLayoutPending())
+            {
+            wxAutoBufferedPaintDC pdc(this);
+            if (!m_layoutPreviews.empty())
+                { DrawLayoutPreview(pdc); }
+            else
+                {
+                PrepareDC(pdc);
+                DrawLayoutPlaceholders(pdc);
+                }
+            return;
+            }
+        // the window is being resized, so show an image of the last layout
+        // until the new size's layout is calculated
+        if (m_resizePending && !m_layoutPreviews.empty())
+            {
+            wxAutoBufferedPaintDC pdc(this);
+            DrawLayoutPreview(pdc);
+            return;
+            }
+        if (IsUsingBackingStore())
+            {
+            UpdateBackingStore();
+            wxPaintDC pdc(this);
+            PrepareDC(pdc);
+            wxMemoryDC memDC(m_backingStore);
+            // only copy the areas that need to be repainted
+            for (wxRegionIterator updateRegion(GetUpdateRegion()); updateRegion; ++updateRegion)
+                {
+                wxRect updateRect(updateRegion.GetRect());
+                // the update region is in window coordinates, the bitmap is in canvas coordinates
+                CalcUnscrolledPosition(updateRect.x, updateRect.y, &updateRect.x, &updateRect.y);
+                pdc.Blit(updateRect.GetPosition(), updateRect.GetSize(),
+                         &memDC, updateRect.GetPosition());
+                }
+            UpdateMemoryBudget();
+            return;
+            }
+        // Only objects inside of the area being repainted need to be drawn. Even if the
+        // whole window is being repainted, it may only be showing part of the canvas
+        // (e.g., if zoomed in), so only bother drawing everything if the entire canvas is visible.
+        std::optional<wxRect> updateArea;
+        wxRect updateRect{ GetUpdateClientRect() };
+        if (updateRect.IsEmpty())
+            { updateRect = wxRect(GetClientSize()); }
+        CalcUnscrolledPosition(updateRect.x, updateRect.y, &updateRect.x, &updateRect.y);
+        if (!updateRect.Contains(wxRect(GetVirtualSize())))
+            { updateArea = ZoomedToLayout(updateRect); }
     #ifdef __WXMSW__
         wxAutoBufferedPaintDC pdc(this);
         pdc.Clear();
@@ -1409,27 +2304,133 @@ namespace Wisteria
             {
             wxGCDC dc(context);
             PrepareDC(dc);
-            OnDraw(dc);
+            dc.SetUserScale(m_zoomTransform, m_zoomTransform);
+            DrawCanvas(dc, updateArea);
             }
         else
             {
             wxGCDC dc(pdc);
             PrepareDC(dc);
-            OnDraw(dc);
+            dc.SetUserScale(m_zoomTransform, m_zoomTransform);
+            DrawCanvas(dc, updateArea);
             }
     #else
         wxAutoBufferedPaintDC pdc(this);
         pdc.Clear();
         wxGCDC dc(pdc);
         PrepareDC(dc);
-        OnDraw(dc);
+        dc.SetUserScale(m_zoomTransform, m_zoomTransform);
+        DrawCanvas(dc, updateArea);
     #endif
+        // drawing may have cached the background or the graphs' legends
+        UpdateMemoryBudget();
+        }
+
+    //-------------------------------------------
+    void Canvas::UpdateBackingStore()
+        {
+        // the entire (scrollable) area of the canvas
+        const wxSize canvasSize{ GetVirtualSize() };
+        if (!m_backingStore.IsOk() || m_backingStoreSize != canvasSize)
+            { InvalidateBackingStore(); }
+        if (!m_backingStoreIsDirty && m_dirtyCanvasAreas.empty())
+            {
+            ++m_renderMetrics.m_backingStoreHits;
+            return;
+            }
+
+        wxClientDC cdc(this);
+        // create a bitmap compatible with the window (including its scale factor)
+        if (!m_backingStore.IsOk() || m_backingStoreSize != canvasSize)
+            {
+            m_backingStore.Create(canvasSize, cdc);
+            m_backingStoreSize = canvasSize;
+            }
+        wxMemoryDC memDC(m_backingStore);
+        if (m_backingStoreIsDirty)
+            {
+            memDC.SetBackground(*wxWHITE_BRUSH);
+            memDC.Clear();
+            }
+        // draws either the whole canvas or just the areas that
+        // have changed (e.g., a graph whose selection changed)
+        const auto drawDirtyAreas = [this](wxDC& dc)
+            {
+            dc.SetUserScale(m_zoomTransform, m_zoomTransform);
+            if (m_backingStoreIsDirty)
+                { DrawCanvas(dc, std::nullopt); }
+            else
+                {
+                for (const auto& area : m_dirtyCanvasAreas)
+                    { DrawCanvas(dc, area); }
+                }
+            };
+            {
+        #ifdef __WXMSW__
+            wxGraphicsContext* context{ nullptr };
+            auto renderer = wxGraphicsRenderer::GetDirect2DRenderer();
+            if (renderer)
+                { context = renderer->CreateContext(memDC); }
+            if (context)
+                {
+                wxGCDC dc(context);
+                drawDirtyAreas(dc);
+                }
+            else
+                {
+                wxGCDC dc(memDC);
+                drawDirtyAreas(dc);
+                }
+        #else
+            wxGCDC dc(memDC);
+            drawDirtyAreas(dc);
+        #endif
+            }
+        memDC.SelectObject(wxNullBitmap);
+        m_backingStoreIsDirty = false;
+        m_dirtyCanvasAreas.clear();
+        }
+
+    //-------------------------------------------
+    void Canvas::RefreshCanvasArea(const wxRect& canvasArea)
+        {
+        if (canvasArea.IsEmpty())
+            { return; }
+        // if the whole bitmap is being redrawn anyway, then there is no need to track this area
+        if (IsUsingBackingStore() && !m_backingStoreIsDirty)
+            { m_dirtyCanvasAreas.push_back(canvasArea); }
+        // the window's update region is in scrolled (window) coordinates
+        wxRect windowArea{ LayoutToZoomed(canvasArea) };
+        CalcScrolledPosition(windowArea.x, windowArea.y, &windowArea.x, &windowArea.y);
+        // call the base version, as ours would invalidate the entire backing bitmap
+        wxScrolledWindow::Refresh(true, &windowArea);
         }
 
     //-------------------------------------------
     void Canvas::OnDraw(wxDC& dc)
         {
-        dc.Clear();
+        // an export may have left the canvas laid out for another size or DC
+        EnsureScreenLayout();
+        DrawCanvas(dc, std::nullopt);
+        }
+
+    //-------------------------------------------
+    void Canvas::DrawCanvas(wxDC& dc, const std::optional<wxRect>& area)
+        {
+        const Settings::RenderScope settingsScope(m_renderSettings);
+        const RenderStageScope drawScope(m_renderMetrics.m_drawTime, m_renderMetrics);
+        ++m_renderMetrics.m_drawCount;
+
+        // when redrawing part of the canvas, only draw over that area and
+        // skip anything that isn't in it
+        std::optional<wxDCClipper> clipper;
+        if (area)
+            { clipper.emplace(dc, area.value()); }
+        else
+            { dc.Clear(); }
+        const auto isInArea = [&dc, &area](const GraphItems::GraphItemBase& object)
+            { return !area || object.GetBoundingBox(dc).Intersects(area.value()); };
+
         // fill in the background color with a linear gradient (if there is a user defined color)
         if (m_bgColorUseLinearGradient && GetBackgroundColor().IsOk())
             { dc.GradientFillLinear(GetCanvasRect(dc), GetBackgroundColor(), *wxWHITE, wxSOUTH); }
@@ -1444,43 +2445,51 @@ namespace Wisteria
 
         // fill in the background image (if there is one)
         if (GetBackgroundImage().IsOk() && m_bgOpacity != wxALPHA_TRANSPARENT)
-            {
-            GraphItems::Image img(GetBackgroundImage().GetBitmap(
-                GetBackgroundImage().GetDefaultSize()).ConvertToImage());
-            img.SetDPIScaleFactor(dc.FromDIP(1));
-            img.SetAnchoring(Anchoring::Center);
-            img.SetAnchorPoint(
-                wxPoint(GetCanvasRect(dc).GetLeft() + safe_divide(GetCanvasRect(dc).GetWidth(), 2),
-                        GetCanvasRect(dc).GetTop() + safe_divide(GetCanvasRect(dc).GetHeight(), 2)));
-            // we clip the image a little so that it fits the area better
-            img.SetBestSize(GetCanvasRect(dc).GetSize() +
-                            dc.FromDIP(wxSize(100, 100)));
-            img.SetOpacity(m_bgOpacity);
-            img.Draw(dc);
-            }
+            { DrawBackgroundImage(dc); }
 
         // draw the actual objects on the canvas
         for (const auto& fixedObjectsRow : GetFixedObjects())
             {
             for (const auto& objectPtr : fixedObjectsRow)
                 {
-                if (objectPtr != nullptr)
-                    { objectPtr->Draw(dc); }
+                if (objectPtr != nullptr && isInArea(*objectPtr))
+                    {
+                    const auto objectStart = std::chrono::steady_clock::now();
+                    objectPtr->Draw(dc);
+                    // graphs report how many of their own objects they drew
+                    const auto graph = dynamic_cast<const Graphs::Graph2D*>(objectPtr.get());
+                    const size_t objectsDrawn = (graph != nullptr) ?
+                        graph->GetLastDrawnObjectCount() : 1;
+                    m_renderMetrics.m_objectsDrawn += objectsDrawn;
+                    if (auto objectMetrics = GetObjectMetrics(objectPtr.get());
+                        objectMetrics != nullptr)
+                        {
+                        objectMetrics->m_drawTime = ElapsedSince(objectStart);
+                        objectMetrics->m_objectsDrawn = objectsDrawn;
+                        }
+                    }
                 }
             }
 
         // draw the titles
         for (const auto& title : GetTitles())
             {
-            if (title != nullptr)
-                { title->Draw(dc); }
+            if (title != nullptr && isInArea(*title))
+                {
+                title->Draw(dc);
+                ++m_renderMetrics.m_objectsDrawn;
+                }
             }
 
         // draw the movable objects (these sit on top of everything else)
         for (auto& objectPtr : GetFreeFloatingObjects())
             {
             objectPtr->SetScaling(GetScaling());
-            objectPtr->Draw(dc);
+            if (isInArea(*objectPtr))
+                {
+                objectPtr->Draw(dc);
+                ++m_renderMetrics.m_objectsDrawn;
+                }
             }
 
         // show a label on top of the selected items
@@ -1488,7 +2497,7 @@ namespace Wisteria
             {
             for (const auto& objectPtr : fixedObjectsRow)
                 {
-                if (objectPtr)
+                if (objectPtr != nullptr && isInArea(*objectPtr))
                     { objectPtr->DrawSelectionLabel(dc, GetScaling()); }
                 }
             }
@@ -1507,8 +2516,33 @@ namespace Wisteria
         if (Settings::IsDebugFlagEnabled(DebugSettings::DrawExtraInformation))
             {
             m_debugInfo.Trim();
+            const auto toMilliseconds = [](const std::chrono::microseconds duration)
+                {
+                return wxNumberFormatter::ToString(duration.count() / 1000.0, 2,
+                    wxNumberFormatter::Style::Style_WithThousandsSep);
+                };
+            const auto toCount = [](const uint64_t value)
+                {
+                return wxNumberFormatter::ToString(static_cast<wxLongLong_t>(value),
+                    wxNumberFormatter::Style::Style_WithThousandsSep);
+                };
+            // the draw time is from the previous draw, as this one isn't finished yet
+            const wxString metricsInfo = wxString::Format(L"\nLayout: %s ms\n"
+                "Previous draw: %s ms\nLast export: %s ms (encoding %s ms)\n"
+                "Layouts/draws: %s/%s\nObjects drawn: %s\n"
+                "Text measured: %s (%s cached)\nBacking store reuses: %s",
+                toMilliseconds(m_renderMetrics.m_layoutTime),
+                toMilliseconds(m_renderMetrics.m_drawTime),
+                toMilliseconds(m_renderMetrics.m_saveTime),
+                toMilliseconds(m_renderMetrics.m_encodeTime),
+                toCount(m_renderMetrics.m_layoutCount),
+                toCount(m_renderMetrics.m_drawCount),
+                toCount(m_renderMetrics.m_objectsDrawn),
+                toCount(m_renderMetrics.m_textMeasurements),
+                toCount(m_renderMetrics.m_textMeasurementCacheHits),
+                toCount(m_renderMetrics.m_backingStoreHits));
             const auto bBox = GetCanvasRect(dc);
-            Label infoLabel(GraphItemInfo(m_debugInfo).
+            Label infoLabel(GraphItemInfo(m_debugInfo + metricsInfo).
                 AnchorPoint(bBox.GetBottomRight()).
                 Anchoring(Anchoring::BottomRightCorner).
                 FontColor(*wxBLUE).
@@ -1518,12 +2552,87 @@ namespace Wisteria
             }
         }
 
+    //-------------------------------------------
+    void Canvas::RecalcObjectSizes(GraphItems::GraphItemBase& object, wxDC& dc)
+        {
+        const auto layoutStart = std::chrono::steady_clock::now();
+        object.RecalcSizes(dc);
+        if (auto objectMetrics = GetObjectMetrics(&object); objectMetrics != nullptr)
+            { objectMetrics->m_layoutTime += ElapsedSince(layoutStart); }
+        }
+
+    //-------------------------------------------
+    Canvas::RenderMetrics::ObjectMetrics*
+        Canvas::GetObjectMetrics(const GraphItems::GraphItemBase* object)
+        {
+        // the grid is small (usually a handful of items), so a linear search is fine
+        for (size_t row = 0; row < GetFixedObjects().size(); ++row)
+            {
+            const auto& currentRow = GetFixedObjects()[row];
+            for (size_t column = 0; column < currentRow.size(); ++column)
+                {
+                if (currentRow[column].get() != object)
+                    { continue; }
+                auto metricsPos = std::find_if(m_renderMetrics.m_objects.begin(),
+                    m_renderMetrics.m_objects.end(),
+                    [row, column](const auto& metrics) noexcept
+                    { return metrics.m_row == row && metrics.m_column == column; });
+                if (metricsPos != m_renderMetrics.m_objects.end())
+                    { return &(*metricsPos); }
+                auto& newMetrics = m_renderMetrics.m_objects.emplace_back();
+                newMetrics.m_row = row;
+                newMetrics.m_column = column;
+                return &newMetrics;
+                }
+            }
+        return nullptr;
+        }
+
+    //-------------------------------------------
+    void Canvas::DrawBackgroundImage(wxDC& dc)
+        {
+        const wxRect canvasRect{ GetCanvasRect(dc) };
+        // we clip the image a little so that it fits the area better
+        const wxSize bestSize{ canvasRect.GetSize() + dc.FromDIP(wxSize(100, 100)) };
+
+        // rescaling the image and applying its opacity is expensive,
+        // so only do that when the canvas's size (or DPI) has changed
+        if (!m_bgImageCache.IsOk() || m_bgImageCacheSize != bestSize ||
+            m_bgImageCacheOpacity != m_bgOpacity)
+            {
+            wxImage img(GetBackgroundImage().GetBitmap(
+                GetBackgroundImage().GetDefaultSize()).ConvertToImage());
+            const wxSize imgSize{ GraphItems::Image(img).SetBestSize(bestSize) };
+            img.Rescale(imgSize.GetWidth(), imgSize.GetHeight(), wxIMAGE_QUALITY_HIGH);
+            GraphItems::Image::SetOpacity(img, m_bgOpacity, true);
+            m_bgImageCache = wxBitmap(img);
+            m_bgImageCacheSize = bestSize;
+            m_bgImageCacheOpacity = m_bgOpacity;
+            }
+
+        // center the image on the canvas
+        const wxPoint center(canvasRect.GetLeft() + safe_divide(canvasRect.GetWidth(), 2),
+                             canvasRect.GetTop() + safe_divide(canvasRect.GetHeight(), 2));
+        const wxPoint halfSize(m_bgImageCache.GetWidth() / 2, m_bgImageCache.GetHeight() / 2);
+        const wxRect imgRect(center - halfSize, center + halfSize);
+        dc.DrawBitmap(m_bgImageCache, imgRect.GetTopLeft(), true);
+
+        // draw the outline
+        wxPoint pts[5];
+        GraphItems::Polygon::GetRectPoints(imgRect, pts);
+        pts[4] = pts[0]; // close the square
+        wxDCPenChanger pc(dc, wxPen(*wxBLACK, dc.FromDIP(1)));
+        dc.DrawLines(std::size(pts), pts);
+        }
+
     //-------------------------------------------
     void Canvas::SetBackgroundImage(const wxBitmapBundle& backgroundImage,
                                     const uint8_t opacity /*= wxALPHA_OPAQUE*/) noexcept
         {
         m_bgImage = backgroundImage;
         m_bgOpacity = opacity;
+        m_bgImageCache = wxNullBitmap;
+        InvalidateBackingStore();
         }
 
     //-------------------------------------------
@@ -1545,19 +2654,32 @@ namespace Wisteria
 
         if (m_watermarkImg.IsOk())
             {
-            GraphItems::Image img(m_watermarkImg.GetBitmap(
-                m_watermarkImg.GetDefaultSize()).ConvertToImage());
-            img.GetPen() = wxNullPen;
-            img.SetDPIScaleFactor(dc.FromDIP(1));
-            img.SetBestSize(wxSize(ScaleToScreenAndCanvas(m_watermarkImgSizeDIPs.GetWidth(), dc),
-                                   ScaleToScreenAndCanvas(m_watermarkImgSizeDIPs.GetHeight(), dc)));
+            const wxSize bestSize(ScaleToScreenAndCanvas(m_watermarkImgSizeDIPs.GetWidth(), dc),
+                                  ScaleToScreenAndCanvas(m_watermarkImgSizeDIPs.GetHeight(), dc));
             // make logo image mildly translucent
             // (twice as opaque as the system translucency).
-            img.SetOpacity(Settings::GetTranslucencyValue() * 2);
-            img.SetAnchoring(Anchoring::BottomRightCorner);
-            img.SetAnchorPoint(wxPoint(GetCanvasRect(dc).GetWidth(),
-                                       GetCanvasRect(dc).GetHeight()));
-            img.Draw(dc);
+            const uint8_t opacity = Settings::GetTranslucencyValue() * 2;
+            // rescaling the logo and applying its opacity is expensive,
+            // so only do that when its size (or the opacity) has changed
+            if (!m_watermarkImgCache.IsOk() || m_watermarkImgCacheSize != bestSize ||
+                m_watermarkImgCacheOpacity != opacity)
+                {
+                const wxSize imgSize{ GraphItems::Image(m_watermarkImg.GetBitmap(
+                    m_watermarkImg.GetDefaultSize()).ConvertToImage()).SetBestSize(bestSize) };
+                // get the bitmap at the size being drawn, so that SVGs are rasterized crisply
+                wxImage img(m_watermarkImg.GetBitmap(imgSize).ConvertToImage());
+                if (img.GetSize() != imgSize)
+                    { img.Rescale(imgSize.GetWidth(), imgSize.GetHeight(), wxIMAGE_QUALITY_HIGH); }
+                GraphItems::Image::SetOpacity(img, opacity, true);
+                m_watermarkImgCache = wxBitmap(img);
+                m_watermarkImgCacheSize = bestSize;
+                m_watermarkImgCacheOpacity = opacity;
+                }
+            // anchor to the bottom right corner
+            dc.DrawBitmap(m_watermarkImgCache,
+                          wxPoint(GetCanvasRect(dc).GetWidth() - m_watermarkImgCache.GetWidth(),
+                                  GetCanvasRect(dc).GetHeight() - m_watermarkImgCache.GetHeight()),
+                          true);
             }
         }
 
@@ -1585,7 +2707,8 @@ namespace Wisteria
                 labelFont.MakeBold();
                 wxDCFontChanger fc(dc, labelFont);
 
-                dc.GetMultiLineTextExtent(watermark.m_label, &labelWidth, &labelHeight);
+                TextExtentCache::GetMultiLineTextExtent(dc, watermark.m_label,
+                                                        &labelWidth, &labelHeight);
 
                 const float widthOfWatermark =
                     labelWidth*std::abs(std::cos(geometry::degrees_to_radians(angle))) -
@@ -1609,7 +2732,8 @@ namespace Wisteria
                 labelFont.MakeBold();
                 wxDCFontChanger fc(dc, labelFont);
 
-                dc.GetMultiLineTextExtent(watermark.m_label, &labelWidth, &labelHeight);
+                TextExtentCache::GetMultiLineTextExtent(dc, watermark.m_label,
+                                                        &labelWidth, &labelHeight);
                 dc.DrawText(watermark.m_label,
                     wxPoint((drawingRect.GetWidth()/2) - (labelWidth/2),
                             (drawingRect.GetHeight()/2) - (labelHeight/2)));
@@ -1620,6 +2744,15 @@ namespace Wisteria
     //-------------------------------------------
     void Canvas::OnMouseEvent(wxMouseEvent& event)
         {
+        // the objects can't be selected or moved while being laid out
+        if (IsLayoutPending())
+            {
+            event.Skip();
+            return;
+            }
+        // hit testing and dragging need the objects to be laid out for how they are shown
+        if (event.ButtonDown())
+            { LayoutForZoom(); }
         static DragMode dragMode = DragMode::DraggingNone;
         static wxPoint dragStartPos;
         static std::shared_ptr<GraphItems::GraphItemBase> currentlyDraggedShape;
@@ -1633,6 +2766,18 @@ namespace Wisteria
             {
             wxASSERT_LEVEL_2_MSG(currentlyDraggedShape == nullptr,
                                  L"Item being dragged should be null upon left mouse down!");
+            // areas of the canvas whose selection state changed and need to be repainted
+            // (the padding accounts for selection outlines and labels)
+            std::vector<wxRect> changedAreas;
+            const auto addChangedArea = [&changedAreas, &gdc, refreshPadding]
+                (const GraphItems::GraphItemBase& object)
+                { changedAreas.push_back(object.GetBoundingBox(gdc).Inflate(refreshPadding)); };
+            const auto refreshChangedAreas = [this, &changedAreas]()
+                {
+                for (const auto& area : changedAreas)
+                    { RefreshCanvasArea(area); }
+                Update();
+                };
             // unselect any selected items (if Control/Command isn't held down),
             // as we are now selecting (and possibly dragging) something else.
             if (!wxGetMouseState().CmdDown())
@@ -1640,20 +2785,29 @@ namespace Wisteria
                 for (auto& polygonPtr : GetFreeFloatingObjects())
                     {
                     if (polygonPtr && polygonPtr->IsSelected())
-                        { polygonPtr->SetSelected(false); }
+                        {
+                        polygonPtr->SetSelected(false);
+                        addChangedArea(*polygonPtr);
+                        }
                     }
                 for (auto& fixedObjectsRow : GetFixedObjects())
                     {
                     for (auto& objectPtr : fixedObjectsRow)
                         {
-                        if (objectPtr != nullptr)
-                            { objectPtr->ClearSelections(); }
+                        if (objectPtr != nullptr && objectPtr->HasSelections())
+                            {
+                            objectPtr->ClearSelections();
+                            addChangedArea(*objectPtr);
+                            }
                         }
                     }
                 for (auto& title : GetTitles())
                     {
                     if (title != nullptr && title->IsSelected())
-                        { title->SetSelected(false); }
+                        {
+                        title->SetSelected(false);
+                        addChangedArea(*title);
+                        }
                     }
                 }
             //see if a movable object is being selected.
@@ -1692,8 +2846,10 @@ namespace Wisteria
                     if ((*fixedObjectsPos) &&
                         (*fixedObjectsPos)->SelectObjectAtPoint(unscrolledPosition, gdc))
                         {
-                        Refresh(true);
-                        Update();
+                        // only the plot (and any plots that were unselected) need
+                        // to be redrawn, not the whole canvas
+                        addChangedArea(**fixedObjectsPos);
+                        refreshChangedAreas();
                         event.Skip();
                         return;
                         }
@@ -1703,14 +2859,13 @@ namespace Wisteria
                 {
                 if (title != nullptr && title->SelectObjectAtPoint(unscrolledPosition, gdc))
                     {
-                    Refresh(true);
-                    Update();
+                    addChangedArea(*title);
+                    refreshChangedAreas();
                     event.Skip();
                     return;
                     }
                 }
-            Refresh(true);
-            Update();
+            refreshChangedAreas();
             event.Skip();
             }
         else if (event.LeftUp() && dragMode != DragMode::DraggingNone)
@@ -1811,6 +2966,12 @@ namespace Wisteria
     //------------------------------------------------------
     void Canvas::OnKeyDown(wxKeyEvent& event)
         {
+        // the objects can't be moved (or the canvas zoomed) while being laid out
+        if (IsLayoutPending())
+            {
+            event.Skip();
+            return;
+            }
         if (event.GetKeyCode() == WXK_NUMPAD_ADD)
             { ZoomIn(); }
         else if (event.GetKeyCode() == WXK_NUMPAD_SUBTRACT)
@@ -1839,6 +3000,7 @@ namespace Wisteria
             event.GetKeyCode() == WXK_NUMPAD_RIGHT ||
             event.GetKeyCode() == WXK_RIGHT)
             {
+            LayoutForZoom();
             wxGCDC gdc(this);
             bool movingFloatingObjects{ false };
             for (auto& floatingObj : GetFreeFloatingObjects())
@@ -1890,17 +3052,20 @@ namespace Wisteria
     //------------------------------------------------------
     void Canvas::ZoomIn()
         {
+        WaitForDeferredLayout();
         wxASSERT(m_zoomLevel >= 0);
         if (m_zoomLevel >= 40) // don't allow zooming into a nonsensical depth
             { return; }
         ++m_zoomLevel;
+        if (ZoomWithTransform(ZOOM_FACTOR))
+            { return; }
         wxGCDC gdc(this);
 
         m_rectDIPs.SetWidth(m_rectDIPs.GetWidth() * ZOOM_FACTOR);
         m_rectDIPs.SetHeight(m_rectDIPs.GetHeight() * ZOOM_FACTOR);
 
         CalcAllSizes(gdc);
-        SetVirtualSize(GetCanvasRect(gdc).GetSize());
+        SetVirtualSize(GetZoomedCanvasSize(gdc));
         Refresh();
         Update();
         }
@@ -1908,17 +3073,27 @@ namespace Wisteria
     //------------------------------------------------------
     void Canvas::ZoomOut()
         {
+        WaitForDeferredLayout();
         wxASSERT(m_zoomLevel >= 0);
         if (m_zoomLevel <= 0)
             { return; }
         --m_zoomLevel;
+        // back to the original size, so lay out for the window
+        // (rather than for the accumulated scaling)
+        if (m_zoomLevel == 0 && !compare_doubles(m_zoomTransform, 1.0))
+            {
+            ZoomReset();
+            return;
+            }
+        if (ZoomWithTransform(safe_divide(1.0, ZOOM_FACTOR)))
+            { return; }
         wxGCDC gdc(this);
 
         m_rectDIPs.SetWidth(m_rectDIPs.GetWidth() / ZOOM_FACTOR);
         m_rectDIPs.SetHeight(m_rectDIPs.GetHeight() / ZOOM_FACTOR);
         
         CalcAllSizes(gdc);
-        SetVirtualSize(GetCanvasRect(gdc).GetSize());
+        SetVirtualSize(GetZoomedCanvasSize(gdc));
         Refresh();
         Update();
         }
@@ -1926,10 +3101,12 @@ namespace Wisteria
     //------------------------------------------------------
     void Canvas::ZoomReset()
         {
+        WaitForDeferredLayout();
         wxASSERT(m_zoomLevel >= 0);
-        if (m_zoomLevel == 0)
+        if (m_zoomLevel == 0 && compare_doubles(m_zoomTransform, 1.0))
             { return; }
         m_zoomLevel = 0;
+        m_zoomTransform = 1.0;
         wxGCDC gdc(this);
 
         m_rectDIPs = GetClientRect();
@@ -1937,7 +3114,48 @@ namespace Wisteria
         m_rectDIPs.SetHeight(gdc.ToDIP(m_rectDIPs.GetHeight()));
 
         CalcAllSizes(gdc);
-        SetVirtualSize(GetCanvasRect(gdc).GetSize());
+        SetVirtualSize(GetZoomedCanvasSize(gdc));
+        Refresh();
+        Update();
+        }
+
+    //------------------------------------------------------
+    bool Canvas::ZoomWithTransform(const double scale)
+        {
+        if (m_zoomRelayoutThreshold <= 1.0)
+            { return false; }
+        m_zoomTransform *= scale;
+        // scaled too far from the last layout for its text and lines to look right
+        if (m_zoomTransform >= m_zoomRelayoutThreshold ||
+            m_zoomTransform <= safe_divide(1.0, m_zoomRelayoutThreshold) ||
+            compare_doubles(m_zoomTransform, m_zoomRelayoutThreshold) ||
+            compare_doubles(m_zoomTransform, safe_divide(1.0, m_zoomRelayoutThreshold)))
+            {
+            LayoutForZoom();
+            return true;
+            }
+
+        wxGCDC gdc(this);
+        SetVirtualSize(GetZoomedCanvasSize(gdc));
+        Refresh();
+        Update();
+        return true;
+        }
+
+    //------------------------------------------------------
+    void Canvas::LayoutForZoom()
+        {
+        if (compare_doubles(m_zoomTransform, 1.0))
+            { return; }
+        WaitForDeferredLayout();
+        wxGCDC gdc(this);
+
+        m_rectDIPs.SetWidth(wxRound(m_rectDIPs.GetWidth() * m_zoomTransform));
+        m_rectDIPs.SetHeight(wxRound(m_rectDIPs.GetHeight() * m_zoomTransform));
+        m_zoomTransform = 1.0;
+
+        CalcAllSizes(gdc);
+        SetVirtualSize(GetZoomedCanvasSize(gdc));
         Refresh();
         Update();
         }
@@ -34,17 +34,27 @@
 #include <wx/quantize.h>
 #include <wx/event.h>
 #include <wx/wupdlock.h>
+#include <wx/timer.h>
+#include <wx/wfstream.h>
+#include <wx/stream.h>
+#include <wx/stdstream.h>
+#include <atomic>
+#include <chrono>
 #include <cmath>
 #include <vector>
 #include <map>
 #include <set>
+#include <optional>
 #include <algorithm>
+#include <memory>
 #include <stdexcept>
 #include "graphitems.h"
 #include "image.h"
 #include "label.h"
 #include "../ui/imageexportdlg.h"
 #include "../ui/radioboxdlg.h"
+#include "../util/stripimagewriter.h"
+#include "../util/memorybudget.h"
 
 DECLARE_EVENT_TYPE(EVT_WISTERIA_CANVAS_DCLICK, -1)
 
@@ -105,7 +115,10 @@ namespace Wisteria
             @param itemId The ID of this canvas.
             @param pos The position.
             @param size The initial size of the canvas; will change size relative to @c parent.
-            @param flags Window flags passed to wxScrolledWindow.*/
+            @param flags Window flags passed to wxScrolledWindow.
+            @note The canvas is first laid out with the main thread's MeasuringDC, so the
+                application should call MeasuringDC::ReleaseForCurrentThread() from its
+                @c OnExit().*/
         explicit Canvas(wxWindow* parent, int itemId = wxID_ANY,
                const wxPoint& pos = wxDefaultPosition,
                const wxSize& size = wxDefaultSize,
@@ -159,6 +172,7 @@ namespace Wisteria
             {
             m_bgColor = color;
             m_bgColorUseLinearGradient = includeLinearGradient;
+            InvalidateBackingStore();
             }
         /** @brief Sets the background image being drawn on the canvas.
             @param backgroundImage The image to draw on the background.
@@ -185,7 +199,10 @@ namespace Wisteria
         /// @brief Overlays translucent text diagonally across the canvas.
         /// @param watermark The text to draw as the watermark (e.g., a copyright notice).
         void SetWatermark(const wxString& watermark)
-            { m_watermark = watermark; }
+            {
+            m_watermark = watermark;
+            InvalidateBackingStore();
+            }
         /// @returns The watermark label shown across the canvas.
         /// @note The tags @c [DATETIME], @c [DATE], and @c [TIME] are expanded to their literal
         ///     values at time of rendering.
@@ -199,6 +216,8 @@ namespace Wisteria
             {
             m_watermarkImg = watermark;
             m_watermarkImgSizeDIPs = sz;
+            m_watermarkImgCache = wxNullBitmap;
+            InvalidateBackingStore();
             }
         /// @}
 
@@ -411,6 +430,245 @@ namespace Wisteria
         void ZoomOut();
         /// @brief Resets the scaling of the canvas to the default.
         void ZoomReset();
+        /** @brief Sets how far the canvas can be zoomed before it is laid out again.
+            @details By default, every zoom step lays out the canvas for its new size
+             (re-measuring all of its labels and recalculating all of its graphs).
+
+             When a threshold is set, zooming scales the current layout when it is drawn instead.
+             Only when the scaling (relative to the last layout) goes past the threshold is the
+             canvas laid out again for its zoomed size, so that its text and lines stay sharp.
+             This makes continuous zooming (e.g., with the mouse wheel) much faster.
+            @param threshold The scaling relative to the last layout at which to lay out again.
+             For example, @c 2.0 will lay out the canvas again after it has been zoomed
+             in to twice (or out to half) the size of its last layout.
+             Set to @c 1.0 (the default) to lay out the canvas on every zoom step.
+            @note The canvas is laid out for its zoomed size before any objects are selected
+             or moved, and when it is zoomed back out to its original size.
+
+             Exporting, printing, and copying use the canvas's last layout.*/
+        void SetZoomRelayoutThreshold(const double threshold) noexcept
+            { m_zoomRelayoutThreshold = std::max(threshold, 1.0); }
+        /// @returns How far the canvas can be zoomed before it is laid out again.
+        /// @sa SetZoomRelayoutThreshold().
+        [[nodiscard]] double GetZoomRelayoutThreshold() const noexcept
+            { return m_zoomRelayoutThreshold; }
+        /// @}
+
+        /** @name Rendering Functions
+            @brief Functions related to how the canvas is drawn on the screen.*/
+        /// @{
+
+        /** @brief Sets whether the canvas should be rendered to an offscreen (backing) bitmap
+             that is reused when the window is repainted.
+            @details When enabled, the canvas is only fully redrawn when its content changes
+             (i.e., when Refresh() is called or a canvas property is changed),
+             or when it is resized or zoomed. When an object is selected with the mouse,
+             only the objects whose selections changed are redrawn.
+             Other repaints (e.g., when the window is scrolled or uncovered) just copy the
+             exposed area from the bitmap, which is much faster for dashboards or zoomed-in canvases.
+            @param useBackingStore @c true to use a backing bitmap.
+            @note If editing the canvas's objects directly (e.g., changing a graph's data),
+             call Refresh() (or InvalidateBackingStore()) afterwards so that the changes are drawn.\n
+             The backing bitmap is the size of the entire (scrollable) canvas, so it will use more
+             memory as the canvas is zoomed into.*/
+        void UseBackingStore(const bool useBackingStore)
+            {
+            m_useBackingStore = useBackingStore;
+            InvalidateBackingStore();
+            if (!m_useBackingStore)
+                { m_backingStore = wxNullBitmap; }
+            }
+        /// @returns @c true if the canvas is rendered to a backing bitmap that is reused when repainting.
+        [[nodiscard]] bool IsUsingBackingStore() const noexcept
+            { return m_useBackingStore; }
+        /// @brief Marks the backing bitmap as out of date, so that the canvas will be
+        ///     fully redrawn the next time that it is painted.
+        /// @sa UseBackingStore().
+        void InvalidateBackingStore() noexcept
+            {
+            m_backingStoreIsDirty = true;
+            m_dirtyCanvasAreas.clear();
+            // images of the canvas at other sizes (and pages rendered for
+            // the print preview) are also out of date now
+            m_layoutPreviews.clear();
+            ++m_contentGeneration;
+            }
+        /** @private
+            @brief Invalidates the backing bitmap (if in use) and repaints the canvas.*/
+        void Refresh(bool eraseBackground = true, const wxRect* rect = nullptr) override
+            {
+            InvalidateBackingStore();
+            wxScrolledWindow::Refresh(eraseBackground, rect);
+            }
+        /// @brief Timings and counters for laying out and drawing a canvas.
+        /// @sa GetRenderMetrics().
+        struct RenderMetrics
+            {
+            /// @brief How long a single object on the canvas took to lay out and draw.
+            struct ObjectMetrics
+                {
+                /// @brief The row of the object in the canvas's grid.
+                size_t m_row{ 0 };
+                /// @brief The column of the object in the canvas's grid.
+                size_t m_column{ 0 };
+                /// @brief How long the object took to lay out during the last canvas layout.
+                /// @note This includes any extra layouts needed to align it with its
+                ///     neighbors (see AlignRowContent() and AlignColumnContent()).
+                std::chrono::microseconds m_layoutTime{ 0 };
+                /// @brief How long the object's last Draw() call took.
+                std::chrono::microseconds m_drawTime{ 0 };
+                /// @brief The number of objects drawn by the object's last Draw() call.
+                /// @details For graphs, this is the number of plot objects (bars, points, etc.)
+                ///     drawn; for other objects, this is @c 1.
+                size_t m_objectsDrawn{ 0 };
+                };
+
+            /// @brief How long the last layout (i.e., CalcAllSizes()) took.
+            std::chrono::microseconds m_layoutTime{ 0 };
+            /// @brief How long the last drawing of the canvas took.
+            std::chrono::microseconds m_drawTime{ 0 };
+            /// @brief How long the last call to Save() took (including layout and drawing).
+            std::chrono::microseconds m_saveTime{ 0 };
+            /// @brief How long the last call to Save() spent converting and encoding
+            ///     the rendered bitmap into the image file.
+            /// @note This is zero for SVG and very large (tiled) exports,
+            ///     where drawing and writing are interleaved.
+            std::chrono::microseconds m_encodeTime{ 0 };
+
+            /// @brief The number of times that the canvas has been laid out.
+            uint64_t m_layoutCount{ 0 };
+            /// @brief The number of times that the canvas (or part of it) has been drawn.
+            uint64_t m_drawCount{ 0 };
+            /// @brief The number of objects drawn, including the objects inside of graphs.
+            uint64_t m_objectsDrawn{ 0 };
+            /// @brief The number of text measurements that had to be made by a DC
+            ///     (i.e., were not in the text extent cache) while laying out and drawing.
+            uint64_t m_textMeasurements{ 0 };
+            /// @brief The number of text measurements found in the text extent cache
+            ///     while laying out and drawing.
+            uint64_t m_textMeasurementCacheHits{ 0 };
+            /// @brief The number of repaints that were served by copying the backing bitmap,
+            ///     instead of redrawing the canvas.
+            /// @sa UseBackingStore().
+            uint64_t m_backingStoreHits{ 0 };
+
+            /// @brief Timings for the fixed objects (e.g., graphs and legends)
+            ///     from the last layout and draw.
+            std::vector<ObjectMetrics> m_objects;
+            };
+
+        /** @brief Gets timings and counters for laying out, drawing, and exporting the canvas.
+            @details The timings are for the most recent layout, draw, and export;
+                the counters are running totals since the canvas was created
+                (or ResetRenderMetrics() was last called).\n
+                These are always collected; to also show a summary of them on the canvas,
+                enable DebugSettings::DrawExtraInformation.
+            @note Loading data and calling a graph's @c SetData() happen outside of the canvas,
+                so those are not included here. Use the @c PROFILE() macros for those.
+            @par Example
+            @code
+                canvas->Save(L"chart.png", ImageExportOptions{});
+                const auto& metrics = canvas->GetRenderMetrics();
+                wxLogMessage(L"Layout: %lld us, draw: %lld us, encode: %lld us",
+                    metrics.m_layoutTime.count(), metrics.m_drawTime.count(),
+                    metrics.m_encodeTime.count());
+            @endcode
+            @returns The render metrics.*/
+        [[nodiscard]] const RenderMetrics& GetRenderMetrics() const noexcept
+            { return m_renderMetrics; }
+        /// @brief Clears the render timings and counters.
+        void ResetRenderMetrics()
+            { m_renderMetrics = RenderMetrics{}; }
+
+        /** @returns The (approximate) number of bytes that the canvas is using for its
+                cached bitmaps (e.g., its backing bitmap and layout previews)
+                and its graphs (see @c Graph2D::GetMemoryUsage()).
+            @note Datasets aren't included, as they are usually shared between graphs
+                (and canvases); use @c Dataset::GetMemoryUsage() for those.
+            @sa MemoryBudget.*/
+        [[nodiscard]] size_t GetMemoryUsage() const;
+        /** @brief Discards the canvas's cached bitmaps and its graphs' caches.
+            @details These are recreated when next needed (e.g., the backing bitmap is
+                redrawn the next time that the window is painted), so this only frees memory.\n
+                These caches are registered with the MemoryBudget, which calls this
+                when the program's caches are over budget and this canvas was the least
+                recently painted. (If that happens on another thread or while the canvas is
+                drawing, then it is called later from the main thread's event loop instead,
+                if the caches are still over budget by then.)
+            @warning This should not be called while the canvas is being rendered.*/
+        void ReleaseCaches();
+
+        /** @brief Sets the library settings (e.g., point radius, debug flags)
+             to use when laying out and drawing this canvas, instead of the global ones.
+            @details This lets canvases with different settings be rendered one after another
+             (e.g., with RenderToImages()), without changing the global settings between renders.
+            @param settings The settings to use. Pass null (the default) to use the global settings.
+            @note The settings are an immutable snapshot; to change them, pass a new one.
+            @sa Settings::GetRenderSettings().*/
+        void SetRenderSettings(std::shared_ptr<const RenderSettings> settings) noexcept
+            { m_renderSettings = std::move(settings); }
+        /// @returns The library settings used to render this canvas,
+        ///  or null if it uses the global settings.
+        [[nodiscard]] const std::shared_ptr<const RenderSettings>& GetRenderSettings() const noexcept
+            { return m_renderSettings; }
+
+        /** @brief Sets how long to wait (after the window stops being resized) before
+             recalculating the canvas's layout.
+            @details By default, the layout of the canvas (i.e., all of its graphs and titles)
+             is recalculated every time that the window is resized. When the user drags the window's
+             border, this can result in many layouts per second.
+
+             When a delay is set, then size events are coalesced and a scaled image of the previous
+             layout is shown until the window has not been resized for the given amount of time.
+             Then the layout is recalculated once for the final size.
+            @param milliseconds How long to wait before recalculating the layout.
+             Set to @c 0 (the default) to recalculate the layout immediately.
+            @note Images of previous layouts are cached by window size, so that returning to a
+             window size that was seen before will show that layout's image instead of a scaled one.
+
+             If the window's size is the same once the resizing is finished as it was when
+             it began (e.g., a drag is cancelled), then the layout will not be recalculated.*/
+        void SetResizeDelay(const int milliseconds)
+            {
+            m_resizeDelay = std::max(milliseconds, 0);
+            if (m_resizeDelay == 0)
+                { m_layoutPreviews.clear(); }
+            }
+        /// @returns How long to wait (in milliseconds) after the window is resized before
+        ///     recalculating the canvas's layout.
+        /// @sa SetResizeDelay().
+        [[nodiscard]] int GetResizeDelay() const noexcept
+            { return m_resizeDelay; }
+        /** @brief Sets whether the canvas's layout for the window is deferred.
+            @details By default, the canvas is laid out right away whenever its window
+             is resized. For canvases with objects that are slow to lay out (e.g., a large table),
+             this can make resizing (or first showing) the window feel unresponsive, as nothing
+             is drawn until the layout is finished.
+
+             When enabled, the layout is queued instead (see @c wxEvtHandler::CallAfter()),
+             so that the resize can finish and the window can be painted first. Until the
+             canvas is laid out, an image of the previous layout is shown
+             (if a resize delay is set), or otherwise placeholder frames where
+             the canvas's objects will be. Mouse and keyboard input are ignored until the
+             layout is finished.
+            @param defer @c true to defer the canvas's layout.
+            @note This only postpones the layout; it is not a background layout.
+             The layout still runs on the main thread (as wxWidgets's fonts, pens, and
+             brushes, which are used to measure the objects, can't be shared with worker
+             threads), so the window is still unresponsive while it runs.
+
+             Exporting, printing, zooming, or calling CalcAllSizes() will lay out
+             the canvas right away if a layout is pending.
+            @sa SetResizeDelay().*/
+        void SetDeferredLayout(const bool defer) noexcept
+            { m_deferredLayout = defer; }
+        /// @returns @c true if the canvas's layout for the window is deferred.
+        /// @sa SetDeferredLayout().
+        [[nodiscard]] bool IsDeferredLayout() const noexcept
+            { return m_deferredLayout; }
+        /// @returns @c true if the canvas is waiting to be laid out.
+        [[nodiscard]] bool IsLayoutPending() const noexcept
+            { return m_layoutPending; }
         /// @}
 
         /** @name Print Functions
@@ -514,7 +772,54 @@ namespace Wisteria
         /// @param filePath The file path of the image to save to.
         /// @param options The export options for the image.
         /// @returns @c true upon successful saving.
+        /// @note The canvas is laid out for the image's size (and DC), as with RenderToImage().
+        ///     Very large PNG and TIFF images (e.g., for posters) are then rendered and written
+        ///     in strips, so that memory use stays constant regardless of the image's resolution.\n
+        ///     When writing a TIFF this way, LZW and JPEG compression will use deflate instead.
         bool Save(const wxFileName& filePath, const UI::ImageExportOptions& options);
+        /** @brief Lays out and renders the canvas to an image, without painting the window.
+            @details This is meant for batch rendering, where a (hidden) canvas is reused
+             to render many reports. The layout is calculated once, for the image's DC, and
+             the window's layout is only recalculated if it is shown on screen (otherwise,
+             that is deferred until the canvas is painted).
+            @param sizeDIPs The size of the image (in DIPs). If not provided,
+             then the canvas's current size will be used.
+            @returns The rendered image. Its raw RGB buffer is available from @c wxImage::GetData().*/
+        [[nodiscard]] wxImage RenderToImage(const std::optional<wxSize> sizeDIPs = std::nullopt);
+        /** @brief Lays out and renders the canvas to an SVG file, without painting the window.
+            @details The file is compacted as it is written (shared CSS classes for styling,
+             @c <use> references for repeated shapes such as points, and merged grid lines),
+             which makes files with many points much smaller. Refer to SvgOptimizer for details.
+            @param filePath The file path of the SVG file to save to.
+            @param sizeDIPs The size of the image (in DIPs). If not provided,
+             then the canvas's current size will be used.
+            @returns @c true upon successful saving.
+            @sa RenderToImage().*/
+        bool RenderToSvg(const wxString& filePath,
+                         const std::optional<wxSize> sizeDIPs = std::nullopt);
+        /** @brief Lays out and renders multiple canvases to images, one after another.
+            @details This is a batch version of RenderToImage(); the canvases are rendered
+             sequentially on the calling thread (not concurrently).
+
+             Each canvas is laid out and rasterized by drawing with a
+             @c wxGraphicsContext onto a @c wxImage (no window or bitmap is used while rendering).
+             Afterwards, each canvas's on-screen layout is restored (if shown).
+            @param canvases The canvases to render.
+            @param sizeDIPs The size of the images. If not provided,
+             then the canvases' current sizes will be used.
+            @returns The rendered images, in the same order as @c canvases.
+            @note This must be called from the main (GUI) thread, as the canvases are windows.
+             The canvases can't be rendered on worker threads, as wxWidgets's fonts, pens,
+             and brushes (which the canvases' objects share with each other and the system)
+             can't be copied on multiple threads at once.
+
+             The images are rendered at a DPI scaling of 1 (i.e., an image's size in pixels
+             will be the same as its size in DIPs).
+            @warning This requires a graphics renderer that supports drawing on images
+             (e.g., GDI+ or Cairo).*/
+        [[nodiscard]] static std::vector<wxImage>
+            RenderToImages(const std::vector<Canvas*>& canvases,
+                           const std::optional<wxSize> sizeDIPs = std::nullopt);
 
         /// @brief Assign a menu as the right-click menu for the canvas.
         /// @param menu The menu to assign.
@@ -582,12 +887,16 @@ namespace Wisteria
             {
             m_bgImage = std::move(backgroundImage);
             m_bgOpacity = opacity;
+            m_bgImageCache = wxNullBitmap;
+            InvalidateBackingStore();
             }
         /// @private
         void SetWatermarkLogo(wxBitmapBundle&& watermark, const wxSize sz) noexcept
             {
             m_watermarkImg = std::move(watermark);
             m_watermarkImgSizeDIPs = sz;
+            m_watermarkImgCache = wxNullBitmap;
+            InvalidateBackingStore();
             }
         /// @private
         [[nodiscard]] const std::vector<GraphItems::Label>& GetTopTitles() const noexcept
@@ -664,7 +973,130 @@ namespace Wisteria
 
         // Events
         void OnResize([[maybe_unused]] wxSizeEvent& event);
+        void OnResizeTimer([[maybe_unused]] wxTimerEvent& event);
+        /// @brief Fits the canvas to the window's current size and recalculates its layout.
+        void ResizeCanvas();
+        /// @brief Saves an image of the window's current content (if not already cached),
+        ///     to show while the window is being resized.
+        void CacheLayoutPreview();
+        /// @brief Draws the cached image of the layout that best fits the window's size.
+        void DrawLayoutPreview(wxDC& dc);
+        /// @returns The number of bytes in the backing bitmap and layout previews
+        ///     (i.e., the bitmaps that only the window uses).
+        [[nodiscard]] size_t GetWindowBitmapsMemoryUsage() const;
+        /// @returns The number of bytes that ReleaseCaches() would free (i.e., the window's
+        ///     bitmaps, the background and watermark images, and the graphs' caches).
+        [[nodiscard]] size_t GetCachesMemoryUsage() const;
+        /// @brief Reports the canvas's caches to the memory budget (as just used),
+        ///     then evicts other caches if over budget.
+        void UpdateMemoryBudget();
+        /// @brief Queues the canvas's layout for the window (on the main thread,
+        ///     once the current event is handled).
+        /// @returns @c false if deferred layout is disabled, in which case
+        ///     the caller should lay out the canvas itself.
+        bool DeferLayout();
+        /// @brief Lays out the canvas for the window if a layout is queued.
+        /// @param relayout @c true to lay out the canvas again right away
+        ///     if it was resized while waiting to be laid out. Otherwise, that will be queued.
+        void FinishDeferredLayout(const bool relayout = true);
+        /// @brief Finishes a queued layout right away (if there is one).
+        void WaitForDeferredLayout();
+        /// @brief Calculates the areas of the fixed objects (from the canvas's grid)
+        ///     to draw placeholders over while the canvas is being laid out.
+        void CalcLayoutPlaceholders();
+        /// @brief Draws placeholder frames where the fixed objects will be.
+        void DrawLayoutPlaceholders(wxDC& dc);
+        /** @brief Zooms by scaling the current layout (without laying it out again),
+             unless that would go past the relayout threshold.
+            @param scale The amount to scale the canvas by.
+            @returns @c false if zooming with scaling is disabled, in which case
+             the caller should lay out the canvas for its new size.*/
+        bool ZoomWithTransform(const double scale);
+        /// @brief Lays out the canvas for its zoomed size
+        ///     (if it was zoomed by scaling its previous layout).
+        void LayoutForZoom();
+        /// @returns The size of the canvas (in pixels) as shown in the window,
+        ///     including any zoom scaling.
+        [[nodiscard]] wxSize GetZoomedCanvasSize(wxDC& dc) const
+            {
+            const wxSize canvasSize{ GetCanvasRect(dc).GetSize() };
+            return wxSize(wxRound(canvasSize.GetWidth() * m_zoomTransform),
+                          wxRound(canvasSize.GetHeight() * m_zoomTransform));
+            }
+        /// @returns The area of the window (in unscrolled coordinates) that
+        ///     an area of the canvas's layout is shown in.
+        [[nodiscard]] wxRect LayoutToZoomed(const wxRect& rect) const
+            {
+            return wxRect(wxPoint(std::floor(rect.GetLeft() * m_zoomTransform),
+                                  std::floor(rect.GetTop() * m_zoomTransform)),
+                          wxPoint(std::ceil(rect.GetRight() * m_zoomTransform),
+                                  std::ceil(rect.GetBottom() * m_zoomTransform)));
+            }
+        /// @returns The area of the canvas's layout that an area of
+        ///     the window (in unscrolled coordinates) shows.
+        [[nodiscard]] wxRect ZoomedToLayout(const wxRect& rect) const
+            {
+            return wxRect(wxPoint(std::floor(safe_divide<double>(rect.GetLeft(), m_zoomTransform)),
+                                  std::floor(safe_divide<double>(rect.GetTop(), m_zoomTransform))),
+                          wxPoint(std::ceil(safe_divide<double>(rect.GetRight(), m_zoomTransform)),
+                                  std::ceil(safe_divide<double>(rect.GetBottom(), m_zoomTransform))));
+            }
+        /** @brief Lays out the canvas at a given size for an export DC.
+            @param dc The DC that will be drawn to.
+            @param sizeDIPs The size to lay out the canvas to. If not provided,
+             then the canvas's current size will be used.
+            @returns The original size of the canvas, which should be passed to
+             RestoreScreenLayout() after rendering.*/
+        wxRect LayoutForExport(wxDC& dc, const std::optional<wxSize> sizeDIPs);
+        /// @brief Restores the canvas's size and its layout for the window after being exported.
+        /// @param originalRectDIPs The canvas size returned from LayoutForExport().
+        void RestoreScreenLayout(const wxRect& originalRectDIPs);
+        /** @brief Lays out the canvas for the window again if its current layout was
+                calculated for an export (see RestoreScreenLayout()).
+            @details This should be called before drawing the canvas's current layout
+                anywhere other than the window (e.g., copying, saving, or printing it),
+                so that it isn't drawn with another size's or DC's layout.*/
+        void EnsureScreenLayout();
+        /** @brief Lays out the canvas for a (large) image's size and then renders and
+             writes it to a PNG or TIFF file in strips.
+            @param filePath The file path of the image to save to.
+            @param options The export options for the image.
+            @param sizeDIPs The size of the image.
+            @returns @c true upon successful saving.*/
+        bool SaveTiled(const wxFileName& filePath, const UI::ImageExportOptions& options,
+                       const wxSize sizeDIPs);
         void OnPaint([[maybe_unused]] wxPaintEvent& event);
+        /// @brief Redraws the canvas onto the backing bitmap if it is out of date.
+        /// @details If only some areas of the canvas have been marked as dirty,
+        ///     then only the objects inside of those areas are redrawn.
+        void UpdateBackingStore();
+        /** @brief Draws the canvas's content.
+            @param dc The DC to draw to.
+            @param area If provided, the area of the canvas (in canvas coordinates)
+             to redraw. Drawing will be clipped to this area and objects outside of it
+             will be skipped.*/
+        void DrawCanvas(wxDC& dc, const std::optional<wxRect>& area);
+        /** @brief Draws the background image, centered on the canvas.
+            @details The image is rescaled and has its opacity applied the first time that
+                it is drawn for a given canvas size, and then that bitmap is reused.
+            @param dc The DC to draw to.*/
+        void DrawBackgroundImage(wxDC& dc);
+        /** @brief Repaints an area of the canvas (e.g., a graph whose selection changed),
+             leaving the rest of the backing bitmap as-is.
+            @param canvasArea The area to repaint, in canvas (i.e., unscrolled) coordinates.*/
+        void RefreshCanvasArea(const wxRect& canvasArea);
+        /** @brief Aligns the content (e.g., plot areas and common axes) of a row's items.
+            @details Items whose content is already aligned with the rest of the row
+                (e.g., small multiples sharing a common axis) are not laid out again.
+            @param row The row of items to align.
+            @param dc The DC to measure content with.*/
+        void AlignRowItems(std::vector<std::shared_ptr<GraphItems::GraphItemBase>>& row, wxDC& dc);
+        /// @brief Lays out a fixed object, adding the time that it took to its render metrics.
+        void RecalcObjectSizes(GraphItems::GraphItemBase& object, wxDC& dc);
+        /// @returns The render metrics for a fixed object (adding an entry for it if necessary),
+        ///     or null if the object isn't in the canvas's grid.
+        [[nodiscard]] RenderMetrics::ObjectMetrics*
+            GetObjectMetrics(const GraphItems::GraphItemBase* object);
         void OnContextMenu([[maybe_unused]] wxContextMenuEvent& event);
         void OnMouseEvent(wxMouseEvent& event);
         void OnKeyDown(wxKeyEvent& event);
@@ -680,7 +1112,47 @@ namespace Wisteria
             { return m_titles; }
 
         static constexpr double ZOOM_FACTOR{ 1.5 };
+        // height (in pixels) of the strips that large exports and printouts are rendered in
+        static constexpr int TILE_HEIGHT{ 512 };
+        // size (in pixels) at which exports are rendered in strips instead of one bitmap
+        static constexpr int64_t TILED_EXPORT_MIN_PIXELS{ 4096 * 4096 };
+        // size (in bytes) of the buffers that SVG exports are read and written through
+        static constexpr size_t SVG_BUFFER_SIZE{ 1024 * 1024 };
         int m_zoomLevel{ 0 };
+        // scaling applied to the last layout when drawing it (when zooming without laying out)
+        double m_zoomTransform{ 1.0 };
+        double m_zoomRelayoutThreshold{ 1.0 };
+
+        // retained rendering of the whole canvas, copied to the window when repainting
+        bool m_useBackingStore{ false };
+        bool m_backingStoreIsDirty{ true };
+        wxBitmap m_backingStore;
+        wxSize m_backingStoreSize;
+        // areas of the backing bitmap that need to be redrawn (if not entirely dirty)
+        std::vector<wxRect> m_dirtyCanvasAreas;
+        // changed whenever the backing bitmap is invalidated (i.e., the content may have changed),
+        // so that the print preview knows when its rendered pages are out of date
+        uint64_t m_contentGeneration{ 0 };
+
+        // the current layout is for an export DC and needs to be recalculated before
+        // painting (or drawing the window's layout anywhere else)
+        bool m_screenLayoutIsStale{ false };
+
+        // deferred resizing
+        int m_resizeDelay{ 0 };
+        wxTimer m_resizeTimer;
+        bool m_resizePending{ false };
+        wxSize m_resizeStartSize;
+        // images of previous layouts (most recent first), keyed by the window's client size
+        std::vector<std::pair<wxSize, wxBitmap>> m_layoutPreviews;
+        static constexpr size_t m_maxLayoutPreviews{ 4 };
+
+        // deferred layout
+        bool m_deferredLayout{ false };
+        bool m_layoutPending{ false };
+        // the window was resized while waiting to be laid out
+        bool m_relayoutRequested{ false };
+        std::vector<wxRect> m_layoutPlaceholdersDIPs;
 
         // the current drawing rect
         wxRect m_rectDIPs;
@@ -728,14 +1200,32 @@ namespace Wisteria
         wxFont m_watermarkFont;
         wxBitmapBundle m_watermarkImg;
         wxSize m_watermarkImgSizeDIPs{ 100, 100 };
+        // the watermark logo, scaled and with its opacity applied for the canvas's current size
+        wxBitmap m_watermarkImgCache;
+        wxSize m_watermarkImgCacheSize;
+        uint8_t m_watermarkImgCacheOpacity{ wxALPHA_OPAQUE };
 
         // background values
         wxColour m_bgColor{ *wxWHITE };
         uint8_t m_bgOpacity{ wxALPHA_OPAQUE };
         bool m_bgColorUseLinearGradient{ false };
         wxBitmapBundle m_bgImage;
+        // the background image, scaled and with its opacity applied for the canvas's current size
+        wxBitmap m_bgImageCache;
+        wxSize m_bgImageCacheSize;
+        uint8_t m_bgImageCacheOpacity{ wxALPHA_OPAQUE };
 
         wxString m_debugInfo;
+        RenderMetrics m_renderMetrics;
+        std::shared_ptr<const RenderSettings> m_renderSettings;
+
+        // the number of paints (or previews) drawing from the window's bitmaps, during which
+        // the memory budget can't release them (e.g., if a text measurement goes over budget)
+        int m_windowBitmapsInUse{ 0 };
+        // whether the memory budget has queued a call to ReleaseCaches()
+        std::atomic<bool> m_releaseCachesPending{ false };
+        // declared last, so that it is unregistered before the bitmaps are destroyed
+        MemoryBudget::Registration m_memoryBudgetRegistration;
         };
     }
 
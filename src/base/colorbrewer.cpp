@@ -10,67 +10,73 @@
 
 using namespace Wisteria::Colors;
 
-const std::vector<std::wstring> ColorBrewer::m_colors =
+namespace
     {
-    L"#FBCB78", L"#5D8AA8", L"#598C74", L"#F0F8FF", L"#EFDECD", L"#E52B50", L"#FFBF00", L"#D28240", L"#9966CC", L"#A4C639",
-    L"#CD9575", L"#915C83", L"#FAEBD7", L"#008000", L"#DAB5B4", L"#8DB600", L"#FBCEB1", L"#00FFFF", L"#7FFFD4", L"#88ABB4",
-    L"#4B5320", L"#B2BEB5", L"#87A96B", L"#A52A2A", L"#FDEE00", L"#857C5D", L"#007FFF", L"#F0FFFF", L"#89CFF0", L"#F4C2C2",
-    L"#FFE135", L"#2A2922", L"#C0A98B", L"#848482", L"#98777B", L"#BCD4E6", L"#F5F5DC", L"#F0CDA0", L"#3D2B1F", L"#000000",
-    L"#FFEBCD", L"#ACE5EE", L"#FAF0BE", L"#0000FF", L"#A2A2D0", L"#063852", L"#ABD1C9", L"#DE5D83", L"#0095B6", L"#873260",
-    L"#B5A642", L"#CB4154", L"#004225", L"#CD7F32", L"#A52A2A", L"#7D5642", L"#FFC1CC", L"#E7FEFF", L"#CDBFB0", L"#800020",
-    L"#DEB887", L"#E97451", L"#8A3324", L"#702963", L"#536872", L"#5F9EA0", L"#91A3B0", L"#A67B5B", L"#4B3621", L"#78866B",
-    L"#FFFF99", L"#F62A00", L"#E4717A", L"#00BFFF", L"#592720", L"#C9A66B", L"#C41E3A", L"#00CC99", L"#FF0040", L"#FFA6C9",
-    L"#B31B1B", L"#ED9121", L"#ACB19F", L"#AF4425", L"#ACE1AF", L"#B2FFFF", L"#4997D0", L"#CDCDC0", L"#DE3163", L"#007BA7",
-    L"#A0785A", L"#FAD6A5", L"#36454F", L"#DE3163", L"#FFB7C5", L"#CD5C5C", L"#9E3E33", L"#D2691E", L"#98817B", L"#D2691E",
-    L"#E4D00A", L"#888782", L"#FBCCE7", L"#0047AB", L"#6F4E37", L"#75B9AE", L"#8C92AC", L"#B87333", L"#996666", L"#FF7F50",
-    L"#F88379", L"#893F45", L"#FBEC5D", L"#9ACEEB", L"#6495ED", L"#FFBCD9", L"#FFFDD0", L"#DC143C", L"#00FFFF", L"#FFFF31",
-    L"#FED340", L"#F0E130", L"#00008B", L"#654321", L"#A9A9A9", L"#013220", L"#555555", L"#1560BD", L"#C19A6B", L"#EDC9AF",
-    L"#696969", L"#1E90FF", L"#85BB65", L"#F0EADC", L"#967117", L"#B89D9A", L"#E1A95F", L"#B1975F", L"#614051", L"#F0EAD6",
-    L"#1034A6", L"#7DF9FF", L"#50C878", L"#95978A", L"#B54D7F", L"#C19A6B", L"#801818", L"#FF00FF", L"#8AA3B1", L"#E5AA70",
-    L"#4D5D53", L"#71BC78", L"#4F7942", L"#6C541E", L"#B22222", L"#CE2029", L"#7B3730", L"#F55449", L"#FC8EAC", L"#F4D3B3",
-    L"#EEDC82", L"#FFBF00", L"#FF1493", L"#D69969", L"#228B22", L"#716998", L"#A67B5B", L"#0072BB", L"#86608E", L"#F64A8A",
-    L"#D9C661", L"#DDC5A2", L"#CBD0C2", L"#FF00FF", L"#E48400", L"#CC6666", L"#E49B0F", L"#F8F8FF", L"#B06500", L"#1995AD",
-    L"#6082B6", L"#FFD700", L"#996515", L"#DAA520", L"#FFDF00", L"#D1B280", L"#A8E4A0", L"#3F681C", L"#808080", L"#465945",
-    L"#00FF00", L"#A99A86", L"#663854", L"#3FFF00", L"#DA9100", L"#808000", L"#DF73FF", L"#564537", L"#F0FFF0", L"#49796B",
-    L"#FF1DCE", L"#FF69B4", L"#355E3B", L"#A1D6E2", L"#FCF75E", L"#B2EC5D", L"#4B0082", L"#5A4FCF", L"#FFFFF0", L"#00A86B",
-    L"#F8DE7E", L"#D73B3E", L"#F1BFB1", L"#A50B5E", L"#FADA5E", L"#29AB87", L"#815D40", L"#4CBB17", L"#C3B091", L"#BAA185",
-    L"#A9BA9D", L"#E6E6FA", L"#506D2F", L"#FFF700", L"#FFFACD", L"#BFFF00", L"#FFF44F", L"#FDD5B1", L"#ADD8E6", L"#B5651D",
-    L"#E66771", L"#F08080", L"#93CCEA", L"#D3D3D3", L"#C4DFE6", L"#C8A2C8", L"#BFFF00", L"#32CD32", L"#195905", L"#FAF0E6",
-    L"#C19A6B", L"#E62020", L"#FFBD88", L"#FF00FF", L"#AAF0D1", L"#F8F4FF", L"#C04000", L"#FBEC5D", L"#6050DC", L"#0BDA51",
-    L"#979AAA", L"#FF8243", L"#F3EBDD", L"#800000", L"#E0B0FF", L"#EF98AA", L"#915F6D", L"#598234", L"#FDBCB4", L"#6C5F5B",
-    L"#3EB489", L"#F5FFFA", L"#98FF98", L"#FAEBD7", L"#967117", L"#73A9C2", L"#AEBD38", L"#ADDFAD", L"#30BA8F", L"#997A8D",
-    L"#C54B8C", L"#F2F3F4", L"#FFDB58", L"#21421E", L"#F6ADC6", L"#2A8000", L"#FADA5E", L"#FFDEAD", L"#EC8430", L"#00293C",
-    L"#000080", L"#FFA343", L"#FE59C2", L"#39FF14", L"#DAC3B3", L"#07575B", L"#0077BE", L"#1B4B5A", L"#CC7722", L"#B6B8A5",
-    L"#008000", L"#CFB53B", L"#FDF5E6", L"#808000", L"#6B8E23", L"#BAB86C", L"#9AB973", L"#0F0F0F", L"#B784A7", L"#FFA500",
-    L"#FF4500", L"#F8D568", L"#DA70D6", L"#E5E2DA", L"#654321", L"#414A4C", L"#FF6E4A", L"#F1F1F2", L"#002147", L"#1CA9C9",
-    L"#78184A", L"#EFEFEF", L"#50C878", L"#AEC6CF", L"#836953", L"#CFCFC4", L"#77DD77", L"#F49AC2", L"#FFB347", L"#FFD1DC",
-    L"#B39EB5", L"#FF6961", L"#CB99C9", L"#FDFD96", L"#800080", L"#536878", L"#FFE5B4", L"#1E656D", L"#D1E231", L"#EAE0C8",
-    L"#FAAE3D", L"#E6E200", L"#CCCCFF", L"#F98866", L"#4F4A45", L"#DF00FF", L"#000F89", L"#123524", L"#FDDDE6", L"#01796F",
-    L"#FFC0CB", L"#E4535E", L"#FC74FD", L"#E7ACCF", L"#DEC3B9", L"#F78FA7", L"#F18D9E", L"#C9AA98", L"#93C572", L"#E5E4E2",
-    L"#DDA0DD", L"#FF420E", L"#B0E0E6", L"#C9B29C", L"#003153", L"#DF00FF", L"#CC8899", L"#FF7518", L"#EDECE6", L"#800080",
-    L"#69359C", L"#9D81BA", L"#FE4EDA", L"#50404D", L"#5D8AA8", L"#A489A0", L"#6BB7C4", L"#E30B5D", L"#915F6D", L"#E25098",
-    L"#FF33CC", L"#E3256B", L"#FF0000", L"#CF3721", L"#1FCECB", L"#FF007F", L"#B76E79", L"#E32636", L"#FF66CC", L"#AA98A9",
-    L"#CD9C85", L"#905D5D", L"#AB4E52", L"#65000B", L"#D40000", L"#BC8F8F", L"#EBCECB", L"#4169E1", L"#CA2C92", L"#7851A9",
-    L"#E0115F", L"#BB6528", L"#B7410E", L"#8B4513", L"#FF6700", L"#F4C430", L"#FF8C69", L"#FF91A4", L"#AB7878", L"#C2B280",
-    L"#967117", L"#ECD540", L"#F4A460", L"#507D2A", L"#0F52BA", L"#CBA135", L"#FF2400", L"#FFD800", L"#006994", L"#2E8B57",
-    L"#321414", L"#FFF5EE", L"#704214", L"#C8D3E7", L"#8A795D", L"#45CEA2", L"#882D17", L"#C0C0C0", L"#CB410B", L"#007474",
-    L"#375E97", L"#87CEEB", L"#626D71", L"#6A5ACD", L"#708090", L"#1A472A", L"#2A623D", L"#5D5D5D", L"#AAAAAA", L"#003399",
-    L"#933D41", L"#100C08", L"#E2B6A7", L"#FFFAFA", L"#B0785C", L"#0FC0FC", L"#A7FC00", L"#00FF7F", L"#5A4E4D", L"#4682B4",
-    L"#80BD9E", L"#990000", L"#008080", L"#E4D96F", L"#CB0000", L"#C6B9B8", L"#F0D39D", L"#FFBB00", L"#FFCC33", L"#FAD6A5",
-    L"#FD5E53", L"#B2AC96", L"#D2B48C", L"#F94D00", L"#F28500", L"#483C32", L"#CD5700", L"#D0F0C0", L"#008080", L"#F4C2C2",
-    L"#E2725B", L"#D8BFD8", L"#DE6FA1", L"#505160", L"#0ABAB5", L"#E08D3C", L"#DBD7D2", L"#EEE600", L"#B6452C", L"#FF6347",
-    L"#746CC0", L"#FFC87C", L"#FD0E35", L"#C2CFCF", L"#2F2F30", L"#808080", L"#00755E", L"#DEAA88", L"#B57281", L"#30D5C8",
-    L"#8A496B", L"#66023C", L"#635147", L"#FFFF66", L"#CFC0AB", L"#E1AD21", L"#F3E5AB", L"#C5B358", L"#C80815", L"#43B3AE",
-    L"#E34234", L"#A020F0", L"#EE82EE", L"#40826D", L"#922724", L"#9F1D35", L"#DA1D81", L"#FFA089", L"#9F00FF", L"#4B5645",
-    L"#004242", L"#BCBABE", L"#68829E", L"#00FFFF", L"#B4CCC9", L"#66A5AD", L"#645452", L"#F5DEB3", L"#FFFFFF", L"#CDB592",
-    L"#A2ADD0", L"#FF43A4", L"#FC6C85", L"#722F37", L"#C9A0DC", L"#81715E", L"#738678", L"#FFFF00", L"#F5BE41", L"#2C1608"
-    };
+    // the known colors (as 0xRRGGBB), in the same order as Wisteria::Colors::Color
+    // (see tools/Colors.txt and "tools/Build Color List.R")
+    constexpr std::array<uint32_t, static_cast<size_t>(Color::COLOR_COUNT)> KNOWN_COLORS =
+        {
+        0xFBCB78, 0x5D8AA8, 0x598C74, 0xF0F8FF, 0xEFDECD, 0xE52B50, 0xFFBF00, 0xD28240, 0x9966CC, 0xA4C639,
+        0xCD9575, 0x915C83, 0xFAEBD7, 0x008000, 0xDAB5B4, 0x8DB600, 0xFBCEB1, 0x00FFFF, 0x7FFFD4, 0x88ABB4,
+        0x4B5320, 0xB2BEB5, 0x87A96B, 0xA52A2A, 0xFDEE00, 0x857C5D, 0x007FFF, 0xF0FFFF, 0x89CFF0, 0xF4C2C2,
+        0xFFE135, 0x2A2922, 0xC0A98B, 0x848482, 0x98777B, 0xBCD4E6, 0xF5F5DC, 0xF0CDA0, 0x3D2B1F, 0x000000,
+        0xFFEBCD, 0xACE5EE, 0xFAF0BE, 0x0000FF, 0xA2A2D0, 0x063852, 0xABD1C9, 0xDE5D83, 0x0095B6, 0x873260,
+        0xB5A642, 0xCB4154, 0x004225, 0xCD7F32, 0xA52A2A, 0x7D5642, 0xFFC1CC, 0xE7FEFF, 0xCDBFB0, 0x800020,
+        0xDEB887, 0xE97451, 0x8A3324, 0x702963, 0x536872, 0x5F9EA0, 0x91A3B0, 0xA67B5B, 0x4B3621, 0x78866B,
+        0xFFFF99, 0xF62A00, 0xE4717A, 0x00BFFF, 0x592720, 0xC9A66B, 0xC41E3A, 0x00CC99, 0xFF0040, 0xFFA6C9,
+        0xB31B1B, 0xED9121, 0xACB19F, 0xAF4425, 0xACE1AF, 0xB2FFFF, 0x4997D0, 0xCDCDC0, 0xDE3163, 0x007BA7,
+        0xA0785A, 0xFAD6A5, 0x36454F, 0xDE3163, 0xFFB7C5, 0xCD5C5C, 0x9E3E33, 0xD2691E, 0x98817B, 0xD2691E,
+        0xE4D00A, 0x888782, 0xFBCCE7, 0x0047AB, 0x6F4E37, 0x75B9AE, 0x8C92AC, 0xB87333, 0x996666, 0xFF7F50,
+        0xF88379, 0x893F45, 0xFBEC5D, 0x9ACEEB, 0x6495ED, 0xFFBCD9, 0xFFFDD0, 0xDC143C, 0x00FFFF, 0xFFFF31,
+        0xFED340, 0xF0E130, 0x00008B, 0x654321, 0xA9A9A9, 0x013220, 0x555555, 0x1560BD, 0xC19A6B, 0xEDC9AF,
+        0x696969, 0x1E90FF, 0x85BB65, 0xF0EADC, 0x967117, 0xB89D9A, 0xE1A95F, 0xB1975F, 0x614051, 0xF0EAD6,
+        0x1034A6, 0x7DF9FF, 0x50C878, 0x95978A, 0xB54D7F, 0xC19A6B, 0x801818, 0xFF00FF, 0x8AA3B1, 0xE5AA70,
+        0x4D5D53, 0x71BC78, 0x4F7942, 0x6C541E, 0xB22222, 0xCE2029, 0x7B3730, 0xF55449, 0xFC8EAC, 0xF4D3B3,
+        0xEEDC82, 0xFFBF00, 0xFF1493, 0xD69969, 0x228B22, 0x716998, 0xA67B5B, 0x0072BB, 0x86608E, 0xF64A8A,
+        0xD9C661, 0xDDC5A2, 0xCBD0C2, 0xFF00FF, 0xE48400, 0xCC6666, 0xE49B0F, 0xF8F8FF, 0xB06500, 0x1995AD,
+        0x6082B6, 0xFFD700, 0x996515, 0xDAA520, 0xFFDF00, 0xD1B280, 0xA8E4A0, 0x3F681C, 0x808080, 0x465945,
+        0x00FF00, 0xA99A86, 0x663854, 0x3FFF00, 0xDA9100, 0x808000, 0xDF73FF, 0x564537, 0xF0FFF0, 0x49796B,
+        0xFF1DCE, 0xFF69B4, 0x355E3B, 0xA1D6E2, 0xFCF75E, 0xB2EC5D, 0x4B0082, 0x5A4FCF, 0xFFFFF0, 0x00A86B,
+        0xF8DE7E, 0xD73B3E, 0xF1BFB1, 0xA50B5E, 0xFADA5E, 0x29AB87, 0x815D40, 0x4CBB17, 0xC3B091, 0xBAA185,
+        0xA9BA9D, 0xE6E6FA, 0x506D2F, 0xFFF700, 0xFFFACD, 0xBFFF00, 0xFFF44F, 0xFDD5B1, 0xADD8E6, 0xB5651D,
+        0xE66771, 0xF08080, 0x93CCEA, 0xD3D3D3, 0xC4DFE6, 0xC8A2C8, 0xBFFF00, 0x32CD32, 0x195905, 0xFAF0E6,
+        0xC19A6B, 0xE62020, 0xFFBD88, 0xFF00FF, 0xAAF0D1, 0xF8F4FF, 0xC04000, 0xFBEC5D, 0x6050DC, 0x0BDA51,
+        0x979AAA, 0xFF8243, 0xF3EBDD, 0x800000, 0xE0B0FF, 0xEF98AA, 0x915F6D, 0x598234, 0xFDBCB4, 0x6C5F5B,
+        0x3EB489, 0xF5FFFA, 0x98FF98, 0xFAEBD7, 0x967117, 0x73A9C2, 0xAEBD38, 0xADDFAD, 0x30BA8F, 0x997A8D,
+        0xC54B8C, 0xF2F3F4, 0xFFDB58, 0x21421E, 0xF6ADC6, 0x2A8000, 0xFADA5E, 0xFFDEAD, 0xEC8430, 0x00293C,
+        0x000080, 0xFFA343, 0xFE59C2, 0x39FF14, 0xDAC3B3, 0x07575B, 0x0077BE, 0x1B4B5A, 0xCC7722, 0xB6B8A5,
+        0x008000, 0xCFB53B, 0xFDF5E6, 0x808000, 0x6B8E23, 0xBAB86C, 0x9AB973, 0x0F0F0F, 0xB784A7, 0xFFA500,
+        0xFF4500, 0xF8D568, 0xDA70D6, 0xE5E2DA, 0x654321, 0x414A4C, 0xFF6E4A, 0xF1F1F2, 0x002147, 0x1CA9C9,
+        0x78184A, 0xEFEFEF, 0x50C878, 0xAEC6CF, 0x836953, 0xCFCFC4, 0x77DD77, 0xF49AC2, 0xFFB347, 0xFFD1DC,
+        0xB39EB5, 0xFF6961, 0xCB99C9, 0xFDFD96, 0x800080, 0x536878, 0xFFE5B4, 0x1E656D, 0xD1E231, 0xEAE0C8,
+        0xFAAE3D, 0xE6E200, 0xCCCCFF, 0xF98866, 0x4F4A45, 0xDF00FF, 0x000F89, 0x123524, 0xFDDDE6, 0x01796F,
+        0xFFC0CB, 0xE4535E, 0xFC74FD, 0xE7ACCF, 0xDEC3B9, 0xF78FA7, 0xF18D9E, 0xC9AA98, 0x93C572, 0xE5E4E2,
+        0xDDA0DD, 0xFF420E, 0xB0E0E6, 0xC9B29C, 0x003153, 0xDF00FF, 0xCC8899, 0xFF7518, 0xEDECE6, 0x800080,
+        0x69359C, 0x9D81BA, 0xFE4EDA, 0x50404D, 0x5D8AA8, 0xA489A0, 0x6BB7C4, 0xE30B5D, 0x915F6D, 0xE25098,
+        0xFF33CC, 0xE3256B, 0xFF0000, 0xCF3721, 0x1FCECB, 0xFF007F, 0xB76E79, 0xE32636, 0xFF66CC, 0xAA98A9,
+        0xCD9C85, 0x905D5D, 0xAB4E52, 0x65000B, 0xD40000, 0xBC8F8F, 0xEBCECB, 0x4169E1, 0xCA2C92, 0x7851A9,
+        0xE0115F, 0xBB6528, 0xB7410E, 0x8B4513, 0xFF6700, 0xF4C430, 0xFF8C69, 0xFF91A4, 0xAB7878, 0xC2B280,
+        0x967117, 0xECD540, 0xF4A460, 0x507D2A, 0x0F52BA, 0xCBA135, 0xFF2400, 0xFFD800, 0x006994, 0x2E8B57,
+        0x321414, 0xFFF5EE, 0x704214, 0xC8D3E7, 0x8A795D, 0x45CEA2, 0x882D17, 0xC0C0C0, 0xCB410B, 0x007474,
+        0x375E97, 0x87CEEB, 0x626D71, 0x6A5ACD, 0x708090, 0x1A472A, 0x2A623D, 0x5D5D5D, 0xAAAAAA, 0x003399,
+        0x933D41, 0x100C08, 0xE2B6A7, 0xFFFAFA, 0xB0785C, 0x0FC0FC, 0xA7FC00, 0x00FF7F, 0x5A4E4D, 0x4682B4,
+        0x80BD9E, 0x990000, 0x008080, 0xE4D96F, 0xCB0000, 0xC6B9B8, 0xF0D39D, 0xFFBB00, 0xFFCC33, 0xFAD6A5,
+        0xFD5E53, 0xB2AC96, 0xD2B48C, 0xF94D00, 0xF28500, 0x483C32, 0xCD5700, 0xD0F0C0, 0x008080, 0xF4C2C2,
+        0xE2725B, 0xD8BFD8, 0xDE6FA1, 0x505160, 0x0ABAB5, 0xE08D3C, 0xDBD7D2, 0xEEE600, 0xB6452C, 0xFF6347,
+        0x746CC0, 0xFFC87C, 0xFD0E35, 0xC2CFCF, 0x2F2F30, 0x808080, 0x00755E, 0xDEAA88, 0xB57281, 0x30D5C8,
+        0x8A496B, 0x66023C, 0x635147, 0xFFFF66, 0xCFC0AB, 0xE1AD21, 0xF3E5AB, 0xC5B358, 0xC80815, 0x43B3AE,
+        0xE34234, 0xA020F0, 0xEE82EE, 0x40826D, 0x922724, 0x9F1D35, 0xDA1D81, 0xFFA089, 0x9F00FF, 0x4B5645,
+        0x004242, 0xBCBABE, 0x68829E, 0x00FFFF, 0xB4CCC9, 0x66A5AD, 0x645452, 0xF5DEB3, 0xFFFFFF, 0xCDB592,
+        0xA2ADD0, 0xFF43A4, 0xFC6C85, 0x722F37, 0xC9A0DC, 0x81715E, 0x738678, 0xFFFF00, 0xF5BE41, 0x2C1608
+        };
+    }
 
-wxColour ColorBrewer::GetColor(const Color color)
+PackedColor ColorBrewer::GetPackedColor(const Color color) noexcept
     {
-    if (static_cast<uint16_t>(color) >= static_cast<uint16_t>(Color::COLOR_COUNT))
-        { return wxNullColour; }
-    return wxColour(m_colors[static_cast<uint16_t>(color)]);
+    if (static_cast<size_t>(color) >= KNOWN_COLORS.size())
+        { return PackedColor{}; }
+    // the table doesn't include alpha channels, so make it opaque
+    return PackedColor((KNOWN_COLORS[static_cast<size_t>(color)] << 8) | wxALPHA_OPAQUE);
     }
 
 wxColour ColorBrewer::BrewColor(const double value) const
@@ -106,6 +112,32 @@ wxColour ColorBrewer::BrewColor(const double value) const
     return brewedColor;
     }
 
+std::vector<wxColour> ColorBrewer::BrewColorTable(const size_t colorCount) const
+    {
+    // verify that we have a valid spectrum initialized
+    NON_UNIT_TEST_ASSERT(m_colorSpectrum.size() > 1);
+    if (m_colorSpectrum.size() < 2)
+        { throw std::length_error("Color scale has not been initialized in color brewer."); }
+
+    const size_t tableSize = ClampColorTableSize(colorCount);
+    std::vector<wxColour> colorTable;
+    colorTable.reserve(tableSize);
+    for (size_t i = 0; i < tableSize; ++i)
+        {
+        const double scalePosition = safe_divide<double>(i, tableSize - 1) *
+                                     (m_colorSpectrum.size() - 1);
+        const auto idx1 = std::min(static_cast<size_t>(std::floor(scalePosition)),
+                                   m_colorSpectrum.size() - 1);
+        const auto idx2 = std::min(idx1 + 1, m_colorSpectrum.size() - 1);
+        const double fractBetween = scalePosition - static_cast<double>(idx1);
+        colorTable.emplace_back(
+            (m_colorSpectrum[idx2].Red() - m_colorSpectrum[idx1].Red())*fractBetween + m_colorSpectrum[idx1].Red(),
+            (m_colorSpectrum[idx2].Green() - m_colorSpectrum[idx1].Green())*fractBetween + m_colorSpectrum[idx1].Green(),
+            (m_colorSpectrum[idx2].Blue() - m_colorSpectrum[idx1].Blue())*fractBetween + m_colorSpectrum[idx1].Blue());
+        }
+    return colorTable;
+    }
+
 wxColour ColorContrast::Contrast(const wxColour& color)
     {
     const auto bgLuminance = m_baseColor.GetLuminance();
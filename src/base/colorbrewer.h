@@ -17,6 +17,9 @@
 #include <wx/dcgraph.h>
 #include <wx/string.h>
 #include <vector>
+#include <array>
+#include <algorithm>
+#include <cstdint>
 #include <initializer_list>
 #include "../math/statistics.h"
 
@@ -556,6 +559,94 @@ namespace Wisteria::Colors
         COLOR_COUNT
         };
 
+    /** @brief A color packed into 32 bits (as @c 0xRRGGBBAA).
+        @details Unlike @c wxColour, this is a plain value that is never allocated or parsed,
+         so it is cheap to copy and compare. It is meant for code that looks up and
+         tests many colors (e.g., drawing thousands of bars or points);
+         convert it with ToColour() when a @c wxColour is needed for a pen or brush.
+        @sa ColorBrewer::GetPackedColor().*/
+    class PackedColor
+        {
+    public:
+        /// @brief Constructs an invalid (i.e., fully transparent black) color.
+        constexpr PackedColor() noexcept = default;
+        /// @brief Constructor.
+        /// @param rgba The color, packed as @c 0xRRGGBBAA.
+        constexpr explicit PackedColor(const uint32_t rgba) noexcept : m_rgba(rgba)
+            {}
+        /// @brief Constructor.
+        /// @param red The red channel.
+        /// @param green The green channel.
+        /// @param blue The blue channel.
+        /// @param alpha The alpha channel.
+        constexpr PackedColor(const uint8_t red, const uint8_t green, const uint8_t blue,
+                              const uint8_t alpha = wxALPHA_OPAQUE) noexcept :
+            m_rgba((static_cast<uint32_t>(red) << 24) | (static_cast<uint32_t>(green) << 16) |
+                   (static_cast<uint32_t>(blue) << 8) | alpha)
+            {}
+        /// @brief Constructor.
+        /// @param color The color to pack. An invalid color is packed as fully transparent black.
+        explicit PackedColor(const wxColour& color)
+            {
+            if (color.IsOk())
+                { m_rgba = PackedColor(color.Red(), color.Green(), color.Blue(), color.Alpha()).m_rgba; }
+            }
+        /// @returns The red channel.
+        [[nodiscard]] constexpr uint8_t Red() const noexcept
+            { return static_cast<uint8_t>(m_rgba >> 24); }
+        /// @returns The green channel.
+        [[nodiscard]] constexpr uint8_t Green() const noexcept
+            { return static_cast<uint8_t>(m_rgba >> 16); }
+        /// @returns The blue channel.
+        [[nodiscard]] constexpr uint8_t Blue() const noexcept
+            { return static_cast<uint8_t>(m_rgba >> 8); }
+        /// @returns The alpha channel.
+        [[nodiscard]] constexpr uint8_t Alpha() const noexcept
+            { return static_cast<uint8_t>(m_rgba); }
+        /// @returns The color, packed as @c 0xRRGGBBAA.
+        [[nodiscard]] constexpr uint32_t GetRGBA() const noexcept
+            { return m_rgba; }
+        /// @returns The color with a different opacity.
+        /// @param alpha The new alpha channel.
+        [[nodiscard]] constexpr PackedColor WithAlpha(const uint8_t alpha) const noexcept
+            { return PackedColor((m_rgba & 0xFFFFFF00) | alpha); }
+        /// @returns The luminance (0.0 to 1.0) of the color.
+        /// @note This uses the same weighting as @c wxColour::GetLuminance().
+        [[nodiscard]] constexpr double GetLuminance() const noexcept
+            { return (0.299 * Red() + 0.587 * Green() + 0.114 * Blue()) / 255.0; }
+        /** @returns A lighter or darker version of the color.
+            @param lightness The amount of lightness, where @c 0 is black, @c 100 is
+             the same color, and @c 200 is white. This is the same as
+             @c wxColour::ChangeLightness().*/
+        [[nodiscard]] constexpr PackedColor ChangeLightness(int lightness) const noexcept
+            {
+            if (lightness == 100)
+                { return *this; }
+            lightness = std::clamp(lightness, 0, 200);
+            // blend with white to lighten, or with black to darken
+            const double background = (lightness > 100) ? 255 : 0;
+            const double foregroundWeight = (lightness > 100) ?
+                1.0 - ((lightness - 100.0) / 100.0) : 1.0 + ((lightness - 100.0) / 100.0);
+            const auto blend = [background, foregroundWeight](const uint8_t channel)
+                {
+                return static_cast<uint8_t>(std::clamp(
+                    background + (foregroundWeight * (channel - background)), 0.0, 255.0));
+                };
+            return PackedColor(blend(Red()), blend(Green()), blend(Blue()), Alpha());
+            }
+        /// @returns The color as a @c wxColour.
+        [[nodiscard]] wxColour ToColour() const
+            { return wxColour(Red(), Green(), Blue(), Alpha()); }
+        /// @private
+        [[nodiscard]] constexpr bool operator==(const PackedColor& that) const noexcept
+            { return m_rgba == that.m_rgba; }
+        /// @private
+        [[nodiscard]] constexpr bool operator!=(const PackedColor& that) const noexcept
+            { return m_rgba != that.m_rgba; }
+    private:
+        uint32_t m_rgba{ 0 };
+        };
+
     /** @brief Constructs a color scale for a given range of values.
         @details Brews values within that range to a color representing its
          position on the color scale.
@@ -592,17 +683,29 @@ namespace Wisteria::Colors
     public:
         /** @brief Creates a color from a Colors::Color value.
             @returns A color from a list of known colors.
-            @param color The color ID to use.*/
-        [[nodiscard]] static wxColour GetColor(const Colors::Color color);
+            @param color The color ID to use.
+            @note This is thread safe, as the list of known colors is immutable
+             (it is a compiled table, not looked up in the application's color database).*/
+        [[nodiscard]] static wxColour GetColor(const Colors::Color color)
+            {
+            const auto packedColor = GetPackedColor(color);
+            return (packedColor == PackedColor{}) ? wxNullColour : packedColor.ToColour();
+            }
         /** @brief Creates a color from a Colors::Color value and applies an opacity to it.
             @returns A color from a list of known colors.
             @param color The color ID to use.
             @param opacity The opacity to set the color.*/
         [[nodiscard]] static wxColour GetColor(const Colors::Color color, const uint8_t opacity)
             {
-            auto foundColor = GetColor(color);
-            return wxColour(foundColor.Red(), foundColor.Green(), foundColor.Blue(), opacity);
+            const auto packedColor = GetPackedColor(color);
+            return (packedColor == PackedColor{}) ?
+                wxNullColour : packedColor.WithAlpha(opacity).ToColour();
             }
+        /** @brief Gets a color from a Colors::Color value without creating a @c wxColour.
+            @param color The color ID to use.
+            @returns The (opaque) color, or a fully transparent black color if @c color
+             is not a valid color ID.*/
+        [[nodiscard]] static PackedColor GetPackedColor(const Colors::Color color) noexcept;
 
         /** @brief Initializes the color scale to map to the range of values.
             @param start The start of a range of color objects (this will be the min value).
@@ -661,6 +764,71 @@ namespace Wisteria::Colors
                 { colors.push_back(BrewColor(value)); }
             return colors;
             }
+        /// @brief The index that BrewColorIndices() maps NaN values to.
+        static constexpr uint16_t INVALID_COLOR_INDEX{ std::numeric_limits<uint16_t>::max() };
+        /** @brief Creates a lookup table of colors evenly spaced along the color scale.
+            @details The first color is the scale's min color and the last is its max color.
+             This is meant to be used with the indices from BrewColorIndices().
+            @param colorCount The number of colors to create (e.g., @c 256 or @c 1024).
+             This will be clamped between @c 2 and @c 65,535.
+            @returns The color lookup table.*/
+        [[nodiscard]] std::vector<wxColour> BrewColorTable(const size_t colorCount) const;
+        /** @brief Converts a range of numbers into indices into a color lookup table
+             (see BrewColorTable()).
+            @details This is a much faster (and more compact) alternative to BrewColors()
+             for large amounts of data, as values are mapped to a precomputed table of colors
+             rather than interpolating a color for each value.\n
+             The values' range is recorded and can be retrieved from GetRange().
+            @param start The start of the data.
+            @param end The end of the data.
+            @param colorCount The size of the lookup table that the indices will be used with.
+             This should be the same as the value passed to BrewColorTable().
+            @returns The index into the color lookup table for each value in the data.
+            @note Any NaN values in the range will be mapped to @c INVALID_COLOR_INDEX.
+            @par Example
+            @code
+             ColorBrewer cb;
+             cb.SetColorScale({ *wxBLUE, *wxRED });
+             const auto colorTable = cb.BrewColorTable(1024);
+             const auto colorIndices = cb.BrewColorIndices(data.cbegin(), data.cend(), 1024);
+             // the color for the first value
+             const wxColour firstColor =
+                (colorIndices[0] != ColorBrewer::INVALID_COLOR_INDEX) ?
+                colorTable[colorIndices[0]] : wxColour();
+            @endcode*/
+        template<typename T>
+        [[nodiscard]] std::vector<uint16_t> BrewColorIndices(const T start, const T end,
+                                                             const size_t colorCount)
+            {
+            const size_t lastIndex = ClampColorTableSize(colorCount) - 1;
+            m_range.first = std::numeric_limits<double>::max();
+            m_range.second = std::numeric_limits<double>::lowest();
+            for (auto pos = start; pos != end; ++pos)
+                {
+                if (std::isnan(*pos))
+                    { continue; }
+                m_range.first = std::min<double>(m_range.first, *pos);
+                m_range.second = std::max<double>(m_range.second, *pos);
+                }
+            // all NaN (or empty)
+            if (m_range.first > m_range.second)
+                { m_range = { 0, 0 }; }
+
+            const double rangeSize = m_range.second - m_range.first;
+            std::vector<uint16_t> colorIndices(std::distance(start, end), INVALID_COLOR_INDEX);
+            auto indexPos = colorIndices.begin();
+            for (auto pos = start; pos != end; ++pos, ++indexPos)
+                {
+                if (std::isnan(*pos))
+                    { continue; }
+                // if all values are the same, then they all get the min color
+                // (which is what BrewColor() does)
+                const double normalizedValue = (rangeSize > 0) ?
+                    std::clamp((*pos - m_range.first) / rangeSize, 0.0, 1.0) : 0.0;
+                *indexPos = static_cast<uint16_t>(std::lround(normalizedValue * lastIndex));
+                }
+            return colorIndices;
+            }
         /** @brief Returns the calculated min and max of the values from the last
              call to BrewColors().
             @returns The min and max of the values represented by the color scale.
@@ -679,9 +847,11 @@ namespace Wisteria::Colors
             @note This code is adapted from http://andrewnoske.com/wiki/Code_-_heatmaps_and_color_gradients.*/
         [[nodiscard]] wxColour BrewColor(const double value) const;
     private:
+        /// @returns The size of a color lookup table, clamped to what the indices can represent.
+        [[nodiscard]] static size_t ClampColorTableSize(const size_t colorCount) noexcept
+            { return std::clamp<size_t>(colorCount, 2, INVALID_COLOR_INDEX); }
         std::pair<double,double> m_range{ 0,0 };
         std::vector<wxColour> m_colorSpectrum;
-        static const std::vector<std::wstring> m_colors;
         };
 
     /// @brief Adjusts a color to contrast against another color.
@@ -705,11 +875,21 @@ namespace Wisteria::Colors
         /// @returns @c true if the color's luminance is less than 50% (and not transparent).
         [[nodiscard]] static bool IsDark(const wxColour& color)
             { return (color.Alpha() != wxALPHA_TRANSPARENT && color.GetLuminance() < .5f); }
+        /// @brief Determines whether a color is dark (i.e., luminance is less than 50%).
+        /// @param color The color to review.
+        /// @returns @c true if the color's luminance is less than 50% (and not transparent).
+        [[nodiscard]] constexpr static bool IsDark(const PackedColor color) noexcept
+            { return (color.Alpha() != wxALPHA_TRANSPARENT && color.GetLuminance() < .5f); }
         /// @brief Determines whether a color is light (i.e., luminance is >= 50%).
         /// @param color The color to review.
         /// @returns @c true if the color's luminance is >= 50%.
         [[nodiscard]] static bool IsLight(const wxColour& color)
             { return !IsDark(color); }
+        /// @brief Determines whether a color is light (i.e., luminance is >= 50%).
+        /// @param color The color to review.
+        /// @returns @c true if the color's luminance is >= 50%.
+        [[nodiscard]] constexpr static bool IsLight(const PackedColor color) noexcept
+            { return !IsDark(color); }
         /// @returns A darkened version of a color.
         /// @param color The base color to darken.
         /// @param minimumLuminance The minimum darkness of the color,
@@ -721,6 +901,18 @@ namespace Wisteria::Colors
                 { color = color.ChangeLightness(--darkenValue); }
             return color;
             }
+        /// @returns A darkened version of a color.
+        /// @param color The base color to darken.
+        /// @param minimumLuminance The minimum darkness of the color,
+        ///     ranging from 0.0 to 1.0 (the lower, the darker).
+        [[nodiscard]] constexpr static PackedColor Shade(PackedColor color,
+                                                         const double minimumLuminance = 0.5f) noexcept
+            {
+            int darkenValue{ 100 };
+            while (color.GetLuminance() > std::clamp(minimumLuminance, 0.0, 1.0) && darkenValue > 0)
+                { color = color.ChangeLightness(--darkenValue); }
+            return color;
+            }
         /// @brief Returns a darker (shaded) or lighter (tinted) version of a color,
         ///  depending on how dark it is to begin with.
         ///  For example, black will be returned as dark gray, while white will return as an eggshell white.
@@ -740,6 +932,12 @@ namespace Wisteria::Colors
         /// @returns Black or white; whichever contrasts better against @c color.
         [[nodiscard]] static wxColour BlackOrWhiteContrast(const wxColour& color)
             { return (IsDark(color) ? *wxWHITE : *wxBLACK); }
+        /// @brief Returns either black or white, depending on which better contrasts
+        ///  against the specified color.
+        /// @param color The color to contrast against to see if white or black should go on it.
+        /// @returns Black or white; whichever contrasts better against @c color.
+        [[nodiscard]] constexpr static PackedColor BlackOrWhiteContrast(const PackedColor color) noexcept
+            { return (IsDark(color) ? PackedColor(255, 255, 255) : PackedColor(0, 0, 0)); }
         /// @returns @c true if two colors' luminance values are close.
         /// @param color1 First color to compare.
         /// @param color2 Second color to compare.
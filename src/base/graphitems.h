@@ -154,6 +154,16 @@ namespace Wisteria
                                    will draw a frame around the text.*/
         };
 
+    /// @brief How text is broken into lines when it is wrapped to fit an area.
+    enum class LineBreakStyle
+        {
+        Greedy,  /*!< Each line is filled with as many words as will fit
+                      before moving to the next line.*/
+        Balanced /*!< Lines are broken so that their lengths are as even as possible
+                      (i.e., minimal raggedness), which looks better for centered text.\n
+                      The text will take up the same number of lines or more as @c Greedy.*/
+        };
+
     /// @brief How (single or multi-line) text is aligned.
     /// @sa PageVerticalAlignment, PageHorizontalAlignment
     enum class TextAlignment
@@ -1632,6 +1642,9 @@ namespace Wisteria
             ///  This is only relevant for objects with subitems.
             [[nodiscard]] std::set<long>& GetSelectedIds() noexcept
                 { return m_itemInfo.m_selectedIds; }
+            /// @private
+            [[nodiscard]] const std::set<long>& GetSelectedIds() const noexcept
+                { return m_itemInfo.m_selectedIds; }
 
             /** @brief Gets/sets the pen used for outlining.
                 @returns The pen used for outlining.
@@ -1862,6 +1875,10 @@ namespace Wisteria
             /// @note Derived classes need to override this to unselect all subitems.
             virtual void ClearSelections()
                 { SetSelected(false); }
+            /// @returns @c true if the element (or any of its subitems) is selected.
+            /// @note Derived classes need to override this if they contain subitems.
+            [[nodiscard]] virtual bool HasSelections() const
+                { return IsSelected(); }
             /** @returns @c true if the given point is inside of this element.
                 @param pt The point to check.
                 @param dc The DC used for measuring. Not all objects use this parameter.*/
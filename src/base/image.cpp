@@ -8,6 +8,7 @@
 
 #include "image.h"
 #include "polygon.h"
+#include "../util/pixelkernels.h"
 
 using namespace Wisteria::Colors;
 
@@ -16,6 +17,12 @@ namespace Wisteria::GraphItems
     //----------------------------------------------------------
     wxSize Image::GetSVGSize(const wxString& filePath)
         {
+        auto key = MakeAssetKey(AssetType::SVGSize, filePath);
+        if (!key)
+            { return wxDefaultSize; }
+        if (wxImage cachedImage; wxSize cachedSize; FindAsset(key.value(), cachedImage, cachedSize))
+            { return cachedSize; }
+
         NSVGimage* image{ nullptr };
         image = nsvgParseFromFile(filePath, "px", 96.0f);
         if (image == nullptr)
@@ -25,6 +32,7 @@ namespace Wisteria::GraphItems
 
         nsvgDelete(image);
 
+        AddAsset(std::move(key.value()), wxNullImage, sz);
         return sz;
         }
 
@@ -152,24 +160,17 @@ namespace Wisteria::GraphItems
         {
         if (!image.IsOk())
             { return; }
-        const long pixelCount = image.GetWidth()*image.GetHeight();
+        // the alpha channel is edited directly, so don't alter any images sharing this one's data
+        // (e.g., an Image's original image or a cached effect)
+        image.UnShare();
+        const size_t pixelCount = static_cast<size_t>(image.GetWidth())*image.GetHeight();
 
         if (!image.HasAlpha())
             { image.InitAlpha(); }
         if (image.HasAlpha())
             {
             if (preserveTransparentPixels)
-                {
-                unsigned char* alphaData = image.GetAlpha();
-                if (alphaData)
-                    {
-                    for (long i = 0; i < pixelCount; ++i)
-                        {
-                        if (alphaData[i] != 0)
-                            { alphaData[i] = opacity; }
-                        }
-                    }
-                }
+                { PixelKernels::SetOpacity(image.GetAlpha(), pixelCount, opacity, true); }
             else
                 {
                 // must use malloc (not new) when setting alpha channel
@@ -183,6 +184,23 @@ namespace Wisteria::GraphItems
             }
         }
 
+    //-------------------------------------------
+    void Image::FlattenForExport(wxImage& image, const bool grayscale)
+        {
+        if (!image.IsOk())
+            { return; }
+        // an image without an alpha channel is opaque
+        if (image.HasAlpha())
+            { image.ClearAlpha(); }
+        if (!grayscale)
+            { return; }
+
+        // the pixels are edited directly, so don't alter other images sharing them
+        image.UnShare();
+        PixelKernels::ToGrayscale(image.GetData(),
+                                  static_cast<size_t>(image.GetWidth())*image.GetHeight());
+        }
+
     //-------------------------------------------
     wxImage Image::ChangeColor(const wxImage& image, const wxColour srcColor,
                                const wxColour destColor)
@@ -191,22 +209,12 @@ namespace Wisteria::GraphItems
             { return wxNullImage; }
 
         wxImage img{ image };
-        const size_t pixelRGBCount = static_cast<size_t>(img.GetWidth()*img.GetHeight())*3;
-        unsigned char* const rgbData = img.GetData();
-        if (rgbData)
-            {
-            for (size_t i = 0; i < pixelRGBCount; i += 3)
-                {
-                if (rgbData[i] == srcColor.Red() &&
-                    rgbData[i+1] == srcColor.Green() &&
-                    rgbData[i+2] == srcColor.Blue())
-                    {
-                    rgbData[i] = destColor.Red();
-                    rgbData[i+1] = destColor.Green();
-                    rgbData[i+2] = destColor.Blue();
-                    }
-                }
-            }
+        // the pixels are edited directly, so don't alter the original
+        img.UnShare();
+        PixelKernels::ReplaceColor(img.GetData(),
+                                   static_cast<size_t>(img.GetWidth())*img.GetHeight(),
+                                   srcColor.Red(), srcColor.Green(), srcColor.Blue(),
+                                   destColor.Red(), destColor.Green(), destColor.Blue());
         return img;
         }
 
@@ -216,12 +224,14 @@ namespace Wisteria::GraphItems
         if (!image.IsOk())
             { return wxNullImage; }
         wxImage Silhouette = image.ConvertToMono(0,0,0);
-        SetColorTransparent(Silhouette, *wxWHITE);
-        if (!opaque)
-            {
-            Silhouette = ChangeColor(Silhouette, *wxBLACK,
-                                     ColorBrewer::GetColor(Color::LightGray));
-            }
+        if (!Silhouette.HasAlpha())
+            { Silhouette.InitAlpha(); }
+        // make the white pixels transparent and (optionally) recolor
+        // the black ones in the same pass
+        const wxColour shadowColor = opaque ? *wxBLACK : ColorBrewer::GetColor(Color::LightGray);
+        PixelKernels::MonoToSilhouette(Silhouette.GetData(), Silhouette.GetAlpha(),
+            static_cast<size_t>(Silhouette.GetWidth())*Silhouette.GetHeight(),
+            shadowColor.Red(), shadowColor.Green(), shadowColor.Blue());
         return Silhouette;
         }
 
@@ -230,30 +240,124 @@ namespace Wisteria::GraphItems
         {
         if (!image.IsOk())
             { return; }
+        // the pixels are edited directly, so don't alter other images sharing them
+        image.UnShare();
         if (!image.HasAlpha())
             { image.InitAlpha(); }
         if (image.HasAlpha())
             {
-            const size_t pixelRGBCount = static_cast<size_t>(image.GetWidth()*image.GetHeight())*3;
-            const unsigned char* rgbData = image.GetData();
-            unsigned char* alphaData = image.GetAlpha();
-            if (rgbData && alphaData)
+            PixelKernels::SetColorTransparent(image.GetData(), image.GetAlpha(),
+                static_cast<size_t>(image.GetWidth())*image.GetHeight(),
+                color.Red(), color.Green(), color.Blue());
+            }
+        }
+
+    //-------------------------------------------
+    size_t Image::HashImage(const wxImage& image)
+        {
+        if (!image.IsOk())
+            { return 0; }
+        // FNV-1a
+        size_t hashValue{ 14695981039346656037ULL };
+        const auto hashBytes = [&hashValue](const unsigned char* bytes, const size_t length) noexcept
+            {
+            for (size_t i = 0; i < length; ++i)
                 {
-                for (size_t i = 0, j = 0; i < pixelRGBCount; i += 3, ++j)
-                    {
-                    if (rgbData[i] == color.Red() &&
-                        rgbData[i+1] == color.Green() &&
-                        rgbData[i+2] == color.Blue())
-                        { alphaData[j] = 0; }
-                    }
+                hashValue ^= bytes[i];
+                hashValue *= 1099511628211ULL;
                 }
+            };
+        const size_t pixelCount = static_cast<size_t>(image.GetWidth()) * image.GetHeight();
+        hashBytes(image.GetData(), pixelCount * 3);
+        if (image.HasAlpha())
+            { hashBytes(image.GetAlpha(), pixelCount); }
+        return hashValue ^ std::hash<int>{}(image.GetWidth()) ^ (std::hash<int>{}(image.GetHeight()) << 1);
+        }
+
+    //-------------------------------------------
+    bool Image::AreImagesEqual(const wxImage& image1, const wxImage& image2)
+        {
+        if (!image1.IsOk() || !image2.IsOk())
+            { return (image1.IsOk() == image2.IsOk()); }
+        if (image1.GetSize() != image2.GetSize() || image1.HasAlpha() != image2.HasAlpha())
+            { return false; }
+        const size_t pixelCount = static_cast<size_t>(image1.GetWidth()) * image1.GetHeight();
+        return (std::memcmp(image1.GetData(), image2.GetData(), pixelCount * 3) == 0 &&
+                (!image1.HasAlpha() ||
+                 std::memcmp(image1.GetAlpha(), image2.GetAlpha(), pixelCount) == 0));
+        }
+
+    //-------------------------------------------
+    wxImage Image::FindEffectImage(const EffectKey& key,
+                                   const wxImage& stipple /*= wxNullImage*/)
+        {
+        std::lock_guard<std::mutex> lock(m_effectCacheMutex);
+        const auto foundPos = m_effectCache.find(key);
+        // wxImage's reference counting isn't thread safe, so a copy (that doesn't share
+        // the cached image's data) is returned
+        return (foundPos != m_effectCache.cend() &&
+                AreImagesEqual(foundPos->second.second, stipple)) ?
+            CopyImage(foundPos->second.first) : wxNullImage;
+        }
+
+    //-------------------------------------------
+    void Image::AddEffectImage(const EffectKey& key, const wxImage& img,
+                               const wxImage& stipple /*= wxNullImage*/)
+        {
+        if (!img.IsOk())
+            { return; }
+        auto& registration = GetEffectBudgetRegistration();
+            {
+            std::lock_guard<std::mutex> lock(m_effectCacheMutex);
+            // bars are usually only a handful of sizes and colors,
+            // so just start over if a lot of different effects have been made
+            if (m_effectCache.size() >= MAX_EFFECT_CACHE_SIZE)
+                {
+                m_effectCache.clear();
+                m_effectCacheBytes = 0;
+                }
+            if (const auto foundPos = m_effectCache.find(key);
+                foundPos != m_effectCache.cend())
+                {
+                m_effectCacheBytes -= std::min(m_effectCacheBytes,
+                    GetImageBytes(foundPos->second.first) + GetImageBytes(foundPos->second.second));
+                }
+            // copies are cached, so that the caller's images don't share data with the cache
+            m_effectCache.insert_or_assign(key, std::make_pair(CopyImage(img), CopyImage(stipple)));
+            m_effectCacheBytes += GetImageBytes(img) + GetImageBytes(stipple);
+            registration.SetBytes(m_effectCacheBytes);
+            registration.Touch();
             }
+        // the budget may clear this cache, so it can't be locked here
+        MemoryBudget::Enforce();
+        }
+
+    //-------------------------------------------
+    MemoryBudget::Registration& Image::GetEffectBudgetRegistration()
+        {
+        // effects are cheap to recreate and not used in any particular order,
+        // so just start over if asked to free anything
+        static MemoryBudget::Registration registration =
+            MemoryBudget::Register(L"Image effects",
+                [](const size_t)
+                {
+                std::lock_guard<std::mutex> lock(m_effectCacheMutex);
+                m_effectCache.clear();
+                m_effectCacheBytes = 0;
+                GetEffectBudgetRegistration().SetBytes(m_effectCacheBytes);
+                });
+        return registration;
         }
 
     //-------------------------------------------
     wxImage Image::CreateGlassEffect(const wxSize fillSize, const wxColour color,
                                      const Orientation direction)
         {
+        const EffectKey key{ EffectType::Glass, color.GetRGBA(),
+                             fillSize.GetWidth(), fillSize.GetHeight(), direction, 0, -1 };
+        if (auto cachedImage = FindEffectImage(key); cachedImage.IsOk())
+            { return cachedImage; }
+
         wxBitmap background(fillSize);
         wxMemoryDC memDc(background);
         //fill with the color
@@ -269,7 +373,9 @@ namespace Wisteria::GraphItems
                                  (direction == Orientation::Vertical) ? wxSOUTH : wxEAST);
         memDc.SelectObject(wxNullBitmap);
 
-        return background.ConvertToImage();
+        const wxImage glassImage = background.ConvertToImage();
+        AddEffectImage(key, glassImage);
+        return glassImage;
         }
 
     //-------------------------------------------
@@ -291,6 +397,15 @@ namespace Wisteria::GraphItems
         {
         if (!stipple.IsOk() || fillSize.GetHeight() < 4 || fillSize.GetWidth() < 4)
             { return wxNullImage; }
+        // callers usually create the stipple from a bitmap bundle for every bar,
+        // so use its contents (not its identity) to look up the effect
+        const wxImage originalStipple{ stipple };
+        const EffectKey key{ EffectType::Stipple, 0, fillSize.GetWidth(), fillSize.GetHeight(),
+                             direction, HashImage(originalStipple),
+                             includeShadow ? shadowSize : -1 };
+        if (auto cachedImage = FindEffectImage(key, originalStipple); cachedImage.IsOk())
+            { return cachedImage; }
+
         wxBitmap background(fillSize);
         SetOpacity(background, wxALPHA_TRANSPARENT);
         wxMemoryDC memDc(background);
@@ -380,7 +495,9 @@ namespace Wisteria::GraphItems
 
         memDc.SelectObject(wxNullBitmap);
 
-        return background.ConvertToImage();
+        const wxImage stippledImage = background.ConvertToImage();
+        AddEffectImage(key, stippledImage, originalStipple);
+        return stippledImage;
         }
 
     //-------------------------------------------
@@ -507,8 +624,169 @@ namespace Wisteria::GraphItems
         return boundingBox;
         }
 
+    //-------------------------------------------
+    std::optional<Image::AssetKey> Image::MakeAssetKey(const AssetType assetType,
+                                                       const wxString& filePath,
+                                                       const wxSize size /*= wxDefaultSize*/)
+        {
+        wxFileName fn(filePath);
+        if (!fn.FileExists())
+            { return std::nullopt; }
+        fn.MakeAbsolute();
+        const wxDateTime modTime = fn.GetModificationTime();
+        return AssetKey{ assetType, fn.GetFullPath(),
+                         modTime.IsValid() ? modTime.GetValue() : wxLongLong(0),
+                         size.GetWidth(), size.GetHeight() };
+        }
+
+    //-------------------------------------------
+    bool Image::FindAsset(const AssetKey& key, wxImage& image, wxSize& size)
+        {
+        std::lock_guard<std::mutex> lock(m_assetCacheMutex);
+        const auto foundPos = m_assetLookup.find(key);
+        if (foundPos == m_assetLookup.cend())
+            { return false; }
+        // move to the front, as it is now the most recently used
+        m_assets.splice(m_assets.begin(), m_assets, foundPos->second);
+        // wxImage's reference counting isn't thread safe, so a copy (that doesn't share
+        // the cached image's data) is returned
+        image = CopyImage(foundPos->second->second.first);
+        size = foundPos->second->second.second;
+        return true;
+        }
+
+    //-------------------------------------------
+    void Image::AddAsset(AssetKey&& key, const wxImage& image, const wxSize size)
+        {
+        auto& registration = GetAssetBudgetRegistration();
+            {
+            std::lock_guard<std::mutex> lock(m_assetCacheMutex);
+            const size_t imageBytes = GetImageBytes(image);
+            // don't let one huge image flush out everything else
+            if (imageBytes > m_assetCacheMaxBytes ||
+                m_assetLookup.find(key) != m_assetLookup.cend())
+                { return; }
+            // a copy is cached, so that the caller's image doesn't share data with the cache
+            m_assets.emplace_front(std::move(key), std::make_pair(CopyImage(image), size));
+            m_assetLookup.insert(std::make_pair(m_assets.front().first, m_assets.begin()));
+            m_assetCacheBytes += imageBytes;
+            while (m_assetCacheBytes > m_assetCacheMaxBytes && !m_assets.empty())
+                { RemoveOldestAsset(); }
+            registration.SetBytes(m_assetCacheBytes);
+            registration.Touch();
+            }
+        // the budget may evict from this cache, so it can't be locked here
+        MemoryBudget::Enforce();
+        }
+
+    //-------------------------------------------
+    void Image::RemoveOldestAsset()
+        {
+        m_assetCacheBytes -= std::min(m_assetCacheBytes,
+                                      GetImageBytes(m_assets.back().second.first));
+        m_assetLookup.erase(m_assets.back().first);
+        m_assets.pop_back();
+        }
+
+    //-------------------------------------------
+    MemoryBudget::Registration& Image::GetAssetBudgetRegistration()
+        {
+        static MemoryBudget::Registration registration =
+            MemoryBudget::Register(L"Image assets",
+                [](const size_t bytesToFree)
+                {
+                std::lock_guard<std::mutex> lock(m_assetCacheMutex);
+                const size_t targetBytes = (m_assetCacheBytes > bytesToFree) ?
+                    m_assetCacheBytes - bytesToFree : 0;
+                while (m_assetCacheBytes > targetBytes && !m_assets.empty())
+                    { RemoveOldestAsset(); }
+                GetAssetBudgetRegistration().SetBytes(m_assetCacheBytes);
+                });
+        return registration;
+        }
+
+    //-------------------------------------------
+    void Image::SetAssetCacheMaxBytes(const size_t maxBytes)
+        {
+        auto& registration = GetAssetBudgetRegistration();
+        std::lock_guard<std::mutex> lock(m_assetCacheMutex);
+        m_assetCacheMaxBytes = maxBytes;
+        while ((m_assetCacheBytes > m_assetCacheMaxBytes || m_assetCacheMaxBytes == 0) &&
+               !m_assets.empty())
+            { RemoveOldestAsset(); }
+        registration.SetBytes(m_assetCacheBytes);
+        }
+
+    //-------------------------------------------
+    size_t Image::GetAssetCacheMaxBytes()
+        {
+        std::lock_guard<std::mutex> lock(m_assetCacheMutex);
+        return m_assetCacheMaxBytes;
+        }
+
+    //-------------------------------------------
+    void Image::ClearAssetCache()
+        {
+        auto& registration = GetAssetBudgetRegistration();
+        std::lock_guard<std::mutex> lock(m_assetCacheMutex);
+        m_assets.clear();
+        m_assetLookup.clear();
+        m_assetCacheBytes = 0;
+        registration.SetBytes(m_assetCacheBytes);
+        }
+
     //-------------------------------------------
     wxImage Image::LoadFile(const wxString& filePath)
+        {
+        auto key = MakeAssetKey(AssetType::DecodedImage, filePath);
+        if (!key)
+            { return wxNullImage; }
+        if (wxImage cachedImage; wxSize cachedSize; FindAsset(key.value(), cachedImage, cachedSize))
+            { return cachedImage; }
+
+        const wxImage image = DecodeFile(filePath);
+        if (image.IsOk())
+            { AddAsset(std::move(key.value()), image, image.GetSize()); }
+        return image;
+        }
+
+    //-------------------------------------------
+    wxImage Image::LoadFile(const wxString& filePath, const wxSize size)
+        {
+        if (size.GetWidth() <= 0 || size.GetHeight() <= 0)
+            { return LoadFile(filePath); }
+        auto key = MakeAssetKey(AssetType::ScaledImage, filePath, size);
+        if (!key)
+            { return wxNullImage; }
+        if (wxImage cachedImage; wxSize cachedSize; FindAsset(key.value(), cachedImage, cachedSize))
+            { return cachedImage; }
+
+        wxImage image;
+        if (wxString ext{ filePath };
+            GetImageFileTypeFromExtension(ext) == wxBITMAP_TYPE_ANY && ext.CmpNoCase(L"svg") == 0)
+            {
+            const wxSize svgSize = GetSVGSize(filePath);
+            if (!svgSize.IsFullySpecified())
+                { return wxNullImage; }
+            // rasterize at the requested size (rather than rescaling), so that it is crisp
+            const wxBitmapBundle bundle = wxBitmapBundle::FromSVGFile(filePath, svgSize);
+            if (bundle.IsOk())
+                { image = bundle.GetBitmap(size).ConvertToImage(); }
+            }
+        else
+            {
+            image = LoadFile(filePath);
+            if (image.IsOk())
+                { image = image.Scale(size.GetWidth(), size.GetHeight(), wxIMAGE_QUALITY_HIGH); }
+            }
+
+        if (image.IsOk())
+            { AddAsset(std::move(key.value()), image, size); }
+        return image;
+        }
+
+    //-------------------------------------------
+    wxImage Image::DecodeFile(const wxString& filePath)
         {
         try
             {
@@ -600,9 +878,16 @@ namespace Wisteria::GraphItems
             m_img = m_originalImg;
             m_img.Rescale(scaledSize.GetWidth(), scaledSize.GetHeight(),
                           wxIMAGE_QUALITY_HIGH);
+            m_drawBitmap = wxNullBitmap;
             }
 
-        SetOpacity(m_img, m_opacity, true);
+        // only convert to a bitmap when the image or opacity has changed
+        if (!m_drawBitmap.IsOk() || m_drawBitmapOpacity != m_opacity)
+            {
+            SetOpacity(m_img, m_opacity, true);
+            m_drawBitmap = wxBitmap(m_img);
+            m_drawBitmapOpacity = m_opacity;
+            }
 
         // Draw the shadow. This needs to be a polygon outside of the image
         // in case the image is translucent.
@@ -674,7 +959,7 @@ namespace Wisteria::GraphItems
                (GetImageSize().GetHeight() * GetScaling());
             }
 
-        dc.DrawBitmap(wxBitmap(m_img), imgTopLeftCorner, true);
+        dc.DrawBitmap(m_drawBitmap, imgTopLeftCorner, true);
 
         // draw the outline
         wxPoint pts[5];
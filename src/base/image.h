@@ -13,6 +13,10 @@
 #define __WISTERIA_GRAPHIMAGE_H__
 
 #include <cstring>
+#include <list>
+#include <map>
+#include <mutex>
+#include <tuple>
 #include <wx/wx.h>
 #include <wx/image.h>
 #include <wx/mstream.h>
@@ -24,6 +28,7 @@
 #include "colorbrewer.h"
 #include "../math/mathematics.h"
 #include "../util/memorymappedfile.h"
+#include "../util/memorybudget.h"
 #include "../easyexif/exif.h"
 #include "../nanosvg/src/nanosvg.h"
 
@@ -103,6 +108,7 @@ namespace Wisteria::GraphItems
         void Clear()
             {
             m_originalImg = m_img = wxNullImage;
+            m_drawBitmap = wxNullBitmap;
             m_frameSize = m_size = wxDefaultSize;
             SetOk(false);
             }
@@ -124,7 +130,8 @@ namespace Wisteria::GraphItems
                 This can be passed to a @c wxBitmapBundle when it loads an SVG.
             @param filePath The file path to the SVG file.
             @returns The default size of the SVG. Will be an invalid size if the
-                file fails to load.*/
+                file fails to load.
+            @note The size is cached (keyed on the file's path and modification time).*/
         [[nodiscard]] static wxSize GetSVGSize(const wxString& filePath);
         /** @brief Either downscales or upscales a size to another, maintaining the
                 original's aspect ratio.
@@ -143,9 +150,35 @@ namespace Wisteria::GraphItems
         /** @brief Loads image and adjusts its JPEG orientation (if necessary).
             @param filePath The filepath of the image to load.
             @note Memory mapping is used when loading, which can help memory usage when
-                large files.
+                large files.\n
+                Decoded images are cached (keyed on the file's path and modification time),
+                so loading the same file again is cheap. Refer to SetAssetCacheMaxBytes().\n
+                The returned image is a copy of the cached one (wxImage's reference counting
+                isn't thread safe, so it doesn't share its data with the cache).
             @returns The image loaded from @c filePath.*/
         [[nodiscard]] static wxImage LoadFile(const wxString& filePath);
+        /** @brief Loads an image (or rasterizes an SVG file) at a specific size.
+            @details This is useful for logos and icons that are drawn at the same size
+                over and over again (e.g., across many exported charts), as the scaled image
+                is cached (keyed on the file's path, modification time, and @c size).
+            @param filePath The filepath of the image (or SVG file) to load.
+            @param size The size to load the image at. For raster images, this is the
+                exact size that the image is rescaled to
+                (use ToBestSize() to maintain its aspect ratio).
+            @returns The image loaded from @c filePath at @c size,
+                or an invalid image if the file failed to load.*/
+        [[nodiscard]] static wxImage LoadFile(const wxString& filePath, const wxSize size);
+        /** @brief Sets the memory budget for images cached by LoadFile() and GetSVGSize().
+            @details When the budget is exceeded, the least recently used images are discarded.
+                The cache is also registered with the MemoryBudget, which can discard
+                the least recently used images when the program's caches are over budget.
+            @param maxBytes The maximum number of bytes of pixel data to keep.
+                Setting this to @c 0 disables the cache.*/
+        static void SetAssetCacheMaxBytes(const size_t maxBytes);
+        /// @returns The memory budget for images cached by LoadFile().
+        [[nodiscard]] static size_t GetAssetCacheMaxBytes();
+        /// @brief Removes all images cached by LoadFile() and GetSVGSize().
+        static void ClearAssetCache();
         /** @brief Fits an image to a rect, cropping it evenly if necessary.
             @details For example, if the height of the image is closer to the rect's than
                 the width are, then its height will be scaled to the rect's height
@@ -183,7 +216,9 @@ namespace Wisteria::GraphItems
             @param includeShadow Whether to draw a shadow under the bitmaps.
             @param shadowSize The width/height of the shadow from the image. Value should be
                 scaled for canvas scaling and DPI.
-            @returns The image with the stipple drawn across it.*/
+            @returns The image with the stipple drawn across it.
+            @note Images are cached (by stipple, size, direction, and shadow), so that bars
+                with the same stipple and size only need one image created.*/
         [[nodiscard]] static wxImage CreateStippledImage(wxImage stipple, const wxSize fillSize,
             const Orientation direction, const bool includeShadow,
             const wxCoord shadowSize);
@@ -197,7 +232,9 @@ namespace Wisteria::GraphItems
             @param fillSize The size of the output image to create.
             @param color The base color to fill the box with.
             @param direction The direction of the glassy shine.
-            @returns The glassy image.*/
+            @returns The glassy image.
+            @note Images are cached (by size, color, and direction), so that bars
+                with the same color and size only need one image created.*/
         [[nodiscard]] static wxImage CreateGlassEffect(const wxSize fillSize, const wxColour color,
                                                        const Orientation direction);
         /** @brief Changes each pixel of a given color with another one in a given image,
@@ -266,6 +303,15 @@ namespace Wisteria::GraphItems
                 are already transparent in the image.*/
         static void SetOpacity(wxImage& image, const uint8_t opacity,
                               const bool preserveTransparentPixels);
+        /** @brief Prepares a rendered image for saving by making it opaque and
+                (optionally) converting it to grayscale.
+            @details This is the same as calling SetOpacity() with @c wxALPHA_OPAQUE and then
+                @c wxImage::ConvertToGreyscale(), but is done in-place with a single pass over the pixels.
+                (Also, the alpha channel is removed instead of being filled, which
+                makes the image faster to encode.)
+            @param image The image to edit.
+            @param grayscale @c true to convert the image to grayscale.*/
+        static void FlattenForExport(wxImage& image, const bool grayscale);
         /// @returns The size of the image as it is being drawn.
         [[nodiscard]] const wxSize& GetImageSize() const noexcept
             { return m_size; }
@@ -310,8 +356,99 @@ namespace Wisteria::GraphItems
         /// @returns The wxSize object, wrapped into a std::pair.
         [[nodiscard]] inline static auto wxSizeToPair(const wxSize sz) noexcept
             { return std::make_pair(sz.GetWidth(), sz.GetHeight()); }
+
+        /// @brief The types of effect images that are cached.
+        enum class EffectType
+            {
+            Glass,
+            Stipple
+            };
+        /// @brief Effect type, color, size, orientation, hash of the stipple image (if applicable),
+        ///     and shadow size (or @c -1 if no shadow).
+        using EffectKey = std::tuple<EffectType, wxUint32, int, int, Orientation, size_t, wxCoord>;
+        /// @returns A hash of an image's pixels.
+        [[nodiscard]] static size_t HashImage(const wxImage& image);
+        /// @returns @c true if two images have the same pixels.
+        [[nodiscard]] static bool AreImagesEqual(const wxImage& image1, const wxImage& image2);
+        /** @returns A previously created effect image, or an invalid image if not found.
+            @param key The effect to look for.
+            @param stipple The stipple image used to create the effect (if applicable).
+                This is compared against the cached effect's stipple, in case
+                of a hash collision.*/
+        [[nodiscard]] static wxImage FindEffectImage(const EffectKey& key,
+                                                     const wxImage& stipple = wxNullImage);
+        /** @brief Caches an effect image.
+            @param key The effect.
+            @param img The effect image.
+            @param stipple The stipple image that was used to create the effect (if applicable).*/
+        static void AddEffectImage(const EffectKey& key, const wxImage& img,
+                                   const wxImage& stipple = wxNullImage);
+
+        // cached effect images (e.g., glassy bars), which are shared between all images;
+        // values are the effect image and the stipple image used to create it
+        inline static std::mutex m_effectCacheMutex;
+        inline static std::map<EffectKey, std::pair<wxImage, wxImage>> m_effectCache;
+        inline static size_t m_effectCacheBytes{ 0 };
+        static constexpr size_t MAX_EFFECT_CACHE_SIZE{ 256 };
+        /// @returns The effect cache's registration with the memory budget.
+        [[nodiscard]] static MemoryBudget::Registration& GetEffectBudgetRegistration();
+
+        /// @brief The types of assets that are cached.
+        enum class AssetType
+            {
+            DecodedImage,
+            ScaledImage,
+            SVGSize
+            };
+        /// @brief Asset type, file path, modification time (in milliseconds),
+        ///     and the size that it was loaded at (or @c wxDefaultSize if loaded at its own size).
+        using AssetKey = std::tuple<AssetType, wxString, wxLongLong, int, int>;
+        using AssetList = std::list<std::pair<AssetKey, std::pair<wxImage, wxSize>>>;
+        /// @returns The key for a file, or @c std::nullopt if the file doesn't exist.
+        [[nodiscard]] static std::optional<AssetKey> MakeAssetKey(const AssetType assetType,
+                                                                 const wxString& filePath,
+                                                                 const wxSize size = wxDefaultSize);
+        /** @brief Looks up a cached asset, and moves it to the front of the cache if found.
+            @param key The asset to look for.
+            @param[out] image The cached image.
+            @param[out] size The cached size.
+            @returns @c true if the asset was found.*/
+        [[nodiscard]] static bool FindAsset(const AssetKey& key, wxImage& image, wxSize& size);
+        /// @brief Caches an asset, discarding the least recently used ones if over budget.
+        static void AddAsset(AssetKey&& key, const wxImage& image, const wxSize size);
+        /// @brief Discards the least recently used asset.
+        /// @note The asset cache must be locked and not empty.
+        static void RemoveOldestAsset();
+        /// @returns The asset cache's registration with the memory budget.
+        [[nodiscard]] static MemoryBudget::Registration& GetAssetBudgetRegistration();
+        /// @brief Loads an image from disk (without the asset cache).
+        [[nodiscard]] static wxImage DecodeFile(const wxString& filePath);
+        /// @returns A copy of an image that doesn't share its data with the original
+        ///     (or an invalid image if the original is).
+        [[nodiscard]] static wxImage CopyImage(const wxImage& image)
+            { return image.IsOk() ? image.Copy() : wxImage(); }
+        /// @returns The number of bytes of pixel data in an image.
+        [[nodiscard]] static size_t GetImageBytes(const wxImage& image)
+            {
+            return image.IsOk() ?
+                static_cast<size_t>(image.GetWidth()) * image.GetHeight() *
+                    (image.HasAlpha() ? 4 : 3) :
+                0;
+            }
+
+        // images loaded from disk, which are shared between all images
+        // (most recently used are at the front)
+        inline static std::mutex m_assetCacheMutex;
+        inline static AssetList m_assets;
+        inline static std::map<AssetKey, AssetList::iterator> m_assetLookup;
+        inline static size_t m_assetCacheBytes{ 0 };
+        inline static size_t m_assetCacheMaxBytes{ 256 * 1024 * 1024 };
+
         wxImage m_originalImg;
         mutable wxImage m_img;
+        // m_img as a bitmap (at the opacity that it was last drawn with)
+        mutable wxBitmap m_drawBitmap;
+        mutable uint8_t m_drawBitmapOpacity{ wxALPHA_OPAQUE };
         wxSize m_size{ 0, 0};
         wxSize m_frameSize{ 0, 0 };
         uint8_t m_opacity{ wxALPHA_OPAQUE };
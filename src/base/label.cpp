@@ -9,6 +9,7 @@
 #include "label.h"
 #include "polygon.h"
 #include "shapes.h"
+#include "../util/textextentcache.h"
 
 using namespace Wisteria::Colors;
 
@@ -268,9 +269,12 @@ namespace Wisteria::GraphItems
             const auto secondLineStart = GetText().find_first_not_of(L"\r\n",
                 ((firstLineEnd != std::wstring::npos) ? firstLineEnd : 0), 2);
             if (GetHeaderInfo().IsEnabled() && firstLineEnd != std::wstring::npos)
-                { dc.GetMultiLineTextExtent(GetText().substr(secondLineStart), &width, &height); }
+                {
+                TextExtentCache::GetMultiLineTextExtent(dc, GetText().substr(secondLineStart),
+                                                        &width, &height);
+                }
             else
-                { dc.GetMultiLineTextExtent(GetText(), &width, &height); }
+                { TextExtentCache::GetMultiLineTextExtent(dc, GetText(), &width, &height); }
             // bounding box is padded four (horizontal) and two (vertical) pixels around text (if outlined)
             width += ScaleToScreenAndCanvas(GetLeftPadding()) +
                      ScaleToScreenAndCanvas(GetRightPadding());
@@ -284,7 +288,8 @@ namespace Wisteria::GraphItems
                 wxDCFontChanger fc2(dc,
                     GetHeaderInfo().GetFont().IsOk() ?
                     GetHeaderInfo().GetFont().Scaled(GetScaling()) : dc.GetFont());
-                auto topLineSize = dc.GetMultiLineTextExtent(GetText().substr(0, firstLineEnd));
+                auto topLineSize =
+                    TextExtentCache::GetMultiLineTextExtent(dc, GetText().substr(0, firstLineEnd));
                 topLineSize.x += ScaleToScreenAndCanvas(GetLeftPadding()) +
                                  ScaleToScreenAndCanvas(GetRightPadding());
                 width = std::max(topLineSize.GetWidth(), width);
@@ -297,9 +302,12 @@ namespace Wisteria::GraphItems
             const auto secondLineStart = GetText().find_first_not_of(L"\r\n",
                 ((firstLineEnd != std::wstring::npos) ? firstLineEnd : 0), 2);
             if (GetHeaderInfo().IsEnabled() && secondLineStart != std::wstring::npos)
-                { dc.GetMultiLineTextExtent(GetText().substr(secondLineStart), &height, &width); }
+                {
+                TextExtentCache::GetMultiLineTextExtent(dc, GetText().substr(secondLineStart),
+                                                        &height, &width);
+                }
             else
-                { dc.GetMultiLineTextExtent(GetText(), &height, &width); }
+                { TextExtentCache::GetMultiLineTextExtent(dc, GetText(), &height, &width); }
             height += ScaleToScreenAndCanvas(GetLeftPadding()) +
                       ScaleToScreenAndCanvas(GetRightPadding());
             width += spaceBetweenLines +
@@ -311,7 +319,8 @@ namespace Wisteria::GraphItems
                 wxDCFontChanger fc2(dc,
                     GetHeaderInfo().GetFont().IsOk() ?
                     GetHeaderInfo().GetFont().Scaled(GetScaling()) : dc.GetFont());
-                auto topLineSize = dc.GetMultiLineTextExtent(GetText().substr(0, firstLineEnd));
+                auto topLineSize =
+                    TextExtentCache::GetMultiLineTextExtent(dc, GetText().substr(0, firstLineEnd));
                 topLineSize.x += ScaleToScreenAndCanvas(GetLeftPadding()) +
                                  ScaleToScreenAndCanvas(GetRightPadding());
                 height = std::max(topLineSize.GetWidth(), height);
@@ -404,7 +413,7 @@ namespace Wisteria::GraphItems
 
         // get the uniform height of text
         wxCoord dummyX(0), dummyY(0), averageLineHeight(0);
-        dc.GetMultiLineTextExtent(GetText(), &dummyX, &dummyY, &averageLineHeight);
+        TextExtentCache::GetMultiLineTextExtent(dc, GetText(), &dummyX, &dummyY, &averageLineHeight);
         // draw the text
         dc.SetTextForeground(GetFontColor());
         if (GetTextOrientation() == Orientation::Horizontal)
@@ -703,7 +712,7 @@ namespace Wisteria::GraphItems
                 wxDCFontChanger fc2(dc,
                     GetHeaderInfo().GetFont().IsOk() ?
                     GetHeaderInfo().GetFont().Scaled(GetScaling()) : GetFont());
-                topLineHeight = dc.GetTextExtent(topLine).GetHeight();
+                topLineHeight = TextExtentCache::GetTextExtent(dc, topLine).GetHeight();
                 }
             for (auto iconPos = GetLegendIcons().cbegin();
                  iconPos != GetLegendIcons().cend();
@@ -1048,99 +1057,161 @@ namespace Wisteria::GraphItems
         tempStr.Replace(L"\r\n",L" ", true);
         tempStr.Replace(L"\r", L" ", true);
         tempStr.Replace(L"\n", L" ", true);
+        const std::wstring_view textView(tempStr.wc_str(), tempStr.length());
         wxString fittedText;
         // split the string into lines by looking for delimiters close to the
         // suggested line length in each line
-        while (tempStr.length() > suggestedLineLength)
+        // (this walks through the string, rather than erasing each line from the front of it)
+        size_t lineStart{ 0 };
+        while (textView.length() - lineStart > suggestedLineLength)
             {
-            const size_t index = tempStr.find_first_of(L" -", suggestedLineLength);
+            const size_t index = textView.find_first_of(L" -", lineStart + suggestedLineLength);
             if (index != std::wstring::npos)
                 {
-                fittedText.append(
-                    std::wstring_view(tempStr.wc_str()).substr(0, index+1).data(), index+1).
-                    Trim(true).append(L"\n");
-                tempStr.erase(0, index+1);
+                const auto line = textView.substr(lineStart, (index + 1) - lineStart);
+                fittedText.append(line.data(), line.length()).Trim(true).append(L"\n");
+                lineStart = index + 1;
                 }
             else
                 {
-                fittedText.append(tempStr.c_str());
-                tempStr.clear();
+                const auto line = textView.substr(lineStart);
+                fittedText.append(line.data(), line.length());
+                lineStart = textView.length();
                 }
-            tempStr.Trim(false);
+            while (lineStart < textView.length() && wxIsspace(textView[lineStart]))
+                { ++lineStart; }
+            }
+        if (lineStart < textView.length())
+            {
+            const auto line = textView.substr(lineStart);
+            fittedText.append(line.data(), line.length());
             }
-        if (tempStr.length())
-            { fittedText += tempStr; }
         fittedText.Trim(true); fittedText.Trim(false);
         SetText(fittedText);
         }
 
     //-------------------------------------------
-    void Label::SplitTextToFitBoundingBox(wxDC& dc, const wxSize& boundingBoxSize)
+    std::vector<size_t> Label::CalcLineBreaks(const std::vector<wxCoord>& wordWidths,
+                                              const wxCoord spaceWidth, const wxCoord maxWidth,
+                                              const LineBreakStyle lineBreakStyle)
+        {
+        std::vector<size_t> lineStarts;
+        if (wordWidths.empty())
+            { return lineStarts; }
+
+        if (lineBreakStyle == LineBreakStyle::Greedy)
+            {
+            lineStarts.push_back(0);
+            wxCoord lineWidth{ wordWidths[0] };
+            for (size_t i = 1; i < wordWidths.size(); ++i)
+                {
+                if (lineWidth + spaceWidth + wordWidths[i] > maxWidth)
+                    {
+                    lineStarts.push_back(i);
+                    lineWidth = wordWidths[i];
+                    }
+                else
+                    { lineWidth += spaceWidth + wordWidths[i]; }
+                }
+            return lineStarts;
+            }
+
+        // Balanced: minimize the sum of the squared space left over at the end of each line
+        // (other than the last one), only considering lines that fit.
+        // cost[i] is the lowest cost of breaking the words starting at i into lines,
+        // and nextLineStart[i] is where the line starting at i should end.
+        const size_t wordCount = wordWidths.size();
+        std::vector<double> cost(wordCount + 1, 0.0);
+        std::vector<size_t> nextLineStart(wordCount + 1, wordCount);
+        for (size_t i = wordCount; i-- > 0; /* in loop*/)
+            {
+            cost[i] = std::numeric_limits<double>::max();
+            wxCoord lineWidth{ -spaceWidth };
+            for (size_t j = i; j < wordCount; ++j)
+                {
+                lineWidth += spaceWidth + wordWidths[j];
+                // too wide (although a word on its own is always allowed)
+                if (lineWidth > maxWidth && j > i)
+                    { break; }
+                const double leftOver = std::max<double>(0, maxWidth - lineWidth);
+                // the last line doesn't need to be filled
+                const double lineCost = (j + 1 == wordCount) ? 0.0 :
+                    (leftOver * leftOver) + cost[j + 1];
+                if (lineCost < cost[i])
+                    {
+                    cost[i] = lineCost;
+                    nextLineStart[i] = j + 1;
+                    }
+                }
+            }
+        for (size_t i = 0; i < wordCount; i = nextLineStart[i])
+            { lineStarts.push_back(i); }
+        return lineStarts;
+        }
+
+    //-------------------------------------------
+    void Label::SplitTextToFitBoundingBox(wxDC& dc, const wxSize& boundingBoxSize,
+                                          const LineBreakStyle lineBreakStyle
+                                              /*= LineBreakStyle::Greedy*/)
         {
         if (!boundingBoxSize.IsFullySpecified())
             { return; }
         // note that fonts should not have their point size DPI scaled, only scaled to the canvas
         wxDCFontChanger fc(dc, GetFont().Scaled(GetScaling()));
 
-        wxString text = GetText();
-        text.Trim(false); text.Trim(true);
-
-        wxCoord textWidth = 0, textHeight = 0, totalHeight = 0;
-
-        wxStringTokenizer tok(text);
-        text.clear(); // tokenizer will reconstruct this
-        wxString currentLine;
-        wxString nextToken;
+        // measure each word once (and the space between words), rather than
+        // measuring each line over again as words are added to it
+        std::vector<wxString> words;
+        std::vector<wxCoord> wordWidths;
+        wxCoord lineHeight{ 0 };
+        wxStringTokenizer tok(GetText());
         while (tok.HasMoreTokens())
             {
-            nextToken = tok.GetNextToken();
-            dc.GetTextExtent(currentLine+L" "+nextToken, &textWidth, &textHeight);
-            if (textWidth > boundingBoxSize.GetWidth())
+            words.push_back(tok.GetNextToken());
+            const auto wordSize = TextExtentCache::GetTextExtent(dc, words.back());
+            wordWidths.push_back(wordSize.GetWidth());
+            lineHeight = std::max(lineHeight, wordSize.GetHeight());
+            }
+        const wxCoord spaceWidth = TextExtentCache::GetTextExtent(dc, L" ").GetWidth();
+        const auto lineStarts = CalcLineBreaks(wordWidths, spaceWidth,
+                                               boundingBoxSize.GetWidth(), lineBreakStyle);
+
+        const wxCoord lineSpacing = std::ceil(ScaleToScreenAndCanvas(GetLineSpacing()));
+        wxString text;
+        wxCoord totalHeight{ 0 };
+        for (size_t line = 0; line < lineStarts.size(); ++line)
+            {
+            // if the next line will make this too tall, then show the previous line
+            // being truncated with an ellipsis and stop
+            if ((totalHeight + lineHeight + lineSpacing) > boundingBoxSize.GetHeight())
                 {
-                dc.GetTextExtent(currentLine, &textWidth, &textHeight);
-                // if the next line will make this too tall, then show the current line
-                // being truncated with an ellipsis and stop
-                if ((totalHeight + textHeight +
-                    std::ceil(ScaleToScreenAndCanvas(GetLineSpacing()))) > boundingBoxSize.GetHeight())
-                    {
-                    if (text.length())
-                        { text[text.length()-1] = wxChar{8230}; }
-                    break;
-                    }
-                text += "\n"+currentLine;
-                totalHeight += textHeight+std::ceil(ScaleToScreenAndCanvas(GetLineSpacing()));
-                // start the next line with the word that made the previous line too wide
-                currentLine = nextToken;
+                if (text.length())
+                    { text[text.length()-1] = wxChar{8230}; }
+                break;
                 }
-            else
+            if (line > 0)
+                { text += L"\n"; }
+            const size_t lineEnd = (line + 1 < lineStarts.size()) ?
+                lineStarts[line + 1] : words.size();
+            for (size_t i = lineStarts[line]; i < lineEnd; ++i)
                 {
-                currentLine += L" " + nextToken;
+                if (i > lineStarts[line])
+                    { text += L" "; }
+                text += words[i];
                 }
+            totalHeight += lineHeight + lineSpacing;
             }
-        // add any trailing line
-        dc.GetTextExtent(currentLine, &textWidth, &textHeight);
-        if ((static_cast<double>(totalHeight+textHeight) +
-             std::ceil(ScaleToScreenAndCanvas(GetLineSpacing()))) > boundingBoxSize.GetHeight())
-            {
-            if (text.length())
-                { text[text.length()-1] = wxChar{8230}; }
-            }
-        else
-            { text += "\n" + currentLine; }
         text.Trim(false); text.Trim(true);
         SetText(text);
         }
 
     //-------------------------------------------
-    void Label::DrawVerticalMultiLineText(wxDC& dc, wxPoint pt) const
+    std::vector<Label::LaidOutLine> Label::CalcVerticalLineLayout(wxDC& dc) const
         {
-        if (!IsOk())
-            { return; }
-
+        std::vector<LaidOutLine> lines;
         const wxCoord spaceBetweenLines = (GetLineCount()-1) *
                                            std::ceil(ScaleToScreenAndCanvas(GetLineSpacing()));
 
-        pt.y += GetCachedContentBoundingBox().GetHeight();
         const wxCoord leftOffset = CalcPageHorizontalOffset(dc);
 
         // render the text
@@ -1166,14 +1237,14 @@ namespace Wisteria::GraphItems
         // up and cause the calculation to be way off.
         constexpr wchar_t hairSpace{ 0x200A };
         const double hairSpaceWidth = safe_divide<double>(
-            dc.GetTextExtent(wxString(hairSpace, 10)).GetWidth(), 10);
+            TextExtentCache::GetTextExtent(dc, wxString(hairSpace, 10)).GetWidth(), 10);
 
         const auto trackTextLine = [&](wxString& textLine)
             {
             tokenizedLineWords.clear();
             // if line is shorter than the longest line, then fill it with
             // more spaces (spread evenly throughout) until it fits
-            if (dc.GetTextExtent(textLine).GetWidth() < fullTextSz.GetHeight())
+            if (TextExtentCache::GetTextExtent(dc, textLine).GetWidth() < fullTextSz.GetHeight())
                 {
                 wxStringTokenizer wordTokenizer(textLine, L" ", wxTOKEN_RET_EMPTY);
                 wxString wordStr;
@@ -1186,7 +1257,8 @@ namespace Wisteria::GraphItems
                 if (tokenizedLineWords.size() < 2)
                     { return; }
                 // use hair spaces between words for more precise tracking
-                auto lineDiff = fullTextSz.GetHeight() - dc.GetTextExtent(wordStr).GetWidth();
+                auto lineDiff = fullTextSz.GetHeight() -
+                    TextExtentCache::GetTextExtent(dc, wordStr).GetWidth();
                 const auto hairSpacesNeeded = std::ceil(safe_divide<double>(lineDiff, hairSpaceWidth));
                 const auto wordSpaces = tokenizedLineWords.size() - 1;
                 const auto thinSpacesPerWordPair = std::max(1.0,
@@ -1207,16 +1279,16 @@ namespace Wisteria::GraphItems
 
         while (lineTokenizer.HasMoreTokens() )
             {
-            // draw the next line
+            // measure the next line
             wxString token = lineTokenizer.GetNextToken();
-            dc.GetTextExtent(token, &lineX, &lineY);
+            TextExtentCache::GetTextExtent(dc, token, &lineX, &lineY);
 
             if (GetHeaderInfo().IsEnabled() && currentLineNumber == 0 && GetLineCount() > 1)
                 {
                 wxDCFontChanger fc(dc,
                     GetHeaderInfo().GetFont().IsOk() ?
                     GetHeaderInfo().GetFont().Scaled(GetScaling()) : dc.GetFont());
-                dc.GetTextExtent(token, &lineX, &lineY);
+                TextExtentCache::GetTextExtent(dc, token, &lineX, &lineY);
                 if (GetHeaderInfo().GetLabelAlignment() == TextAlignment::FlushLeft)
                     {
                     offest = HasLegendIcons() ? 0 :
@@ -1256,40 +1328,20 @@ namespace Wisteria::GraphItems
                     trackTextLine(token);
                     }
                 }
-            if (!dc.GetFont().IsOk())
-                {
-                wxLogWarning(L"Invalid font used in graphics; will be replaced by system default.");
-                dc.SetFont(wxSystemSettings::GetFont(wxSYS_DEFAULT_GUI_FONT));
-                }
-            const auto currentLineOffset =
-                (GetLinesIgnoringLeftMargin().find(currentLineNumber) != GetLinesIgnoringLeftMargin().cend()) ? 0 :
-                ((GetHeaderInfo().IsEnabled() && currentLineNumber == 0) ? 0 : leftOffset);
-            const bool isHeader{ (currentLineNumber == 0 &&
-                                  GetLineCount() > 1 &&
-                                  GetHeaderInfo().IsEnabled() &&
-                                  GetHeaderInfo().GetFont().IsOk()) };
-            wxDCFontChanger fc(dc,
-                isHeader ?
-                GetHeaderInfo().GetFont().Scaled(GetScaling()) : dc.GetFont());
-            wxDCTextColourChanger tcc(dc,
-                isHeader ?
-                GetHeaderInfo().GetFontColor() : dc.GetTextForeground());
-            dc.DrawRotatedText(token, pt.x, pt.y-offest-currentLineOffset, 90+m_tiltAngle);
-            // move over for next line
-            pt.x += (lineY+std::ceil(ScaleToScreenAndCanvas(GetLineSpacing())));
+            lines.push_back({ std::move(token), offest,
+                static_cast<wxCoord>(lineY + std::ceil(ScaleToScreenAndCanvas(GetLineSpacing()))) });
             ++currentLineNumber;
             }
+        return lines;
         }
 
     //-------------------------------------------
-    void Label::DrawMultiLineText(wxDC& dc, wxPoint pt) const
+    std::vector<Label::LaidOutLine> Label::CalcLineLayout(wxDC& dc) const
         {
-        if (!IsOk())
-            { return; }
+        std::vector<LaidOutLine> lines;
         const wxCoord spaceBetweenLines = (GetLineCount()-1) *
                                            std::ceil(ScaleToScreenAndCanvas(GetLineSpacing()));
 
-        pt.y += CalcPageVerticalOffset(dc) + ScaleToScreenAndCanvas(GetTopPadding());
         const wxCoord leftOffset = CalcPageHorizontalOffset(dc);
 
         // render the text
@@ -1315,14 +1367,14 @@ namespace Wisteria::GraphItems
         // up and cause the calculation to be way off.
         constexpr wchar_t hairSpace{ 0x200A };
         const double hairSpaceWidth = safe_divide<double>(
-            dc.GetTextExtent(wxString(hairSpace, 10)).GetWidth(), 10);
+            TextExtentCache::GetTextExtent(dc, wxString(hairSpace, 10)).GetWidth(), 10);
 
         const auto trackTextLine = [&](wxString& textLine)
             {
             tokenizedLineWords.clear();
             // if line is shorter than the longest line, then fill it with
             // more spaces (spread evenly throughout) until it fits
-            if (dc.GetTextExtent(textLine).GetWidth() < fullTextSz.GetWidth())
+            if (TextExtentCache::GetTextExtent(dc, textLine).GetWidth() < fullTextSz.GetWidth())
                 {
                 // wxTOKEN_RET_EMPTY will preserve any extra (e.g., leading) spaces
                 // from the original line; we will want that, in case the client
@@ -1338,7 +1390,8 @@ namespace Wisteria::GraphItems
                 if (tokenizedLineWords.size() < 2)
                     { return; }
                 // use hair spaces between words for more precise tracking
-                auto lineDiff = fullTextSz.GetWidth() - dc.GetTextExtent(wordStr).GetWidth();
+                auto lineDiff = fullTextSz.GetWidth() -
+                    TextExtentCache::GetTextExtent(dc, wordStr).GetWidth();
                 const auto hairSpacesNeeded = std::ceil(safe_divide<double>(lineDiff, hairSpaceWidth));
                 const auto wordSpaces = tokenizedLineWords.size() - 1;
                 const auto hairSpacesPerWordPair = std::max(1.0,
@@ -1353,8 +1406,9 @@ namespace Wisteria::GraphItems
                                                  (extraSpaces > 0 ? 1 : 0), hairSpace);
                     --extraSpaces;
                     }
-                lineDiff = dc.GetTextExtent(textLine).GetWidth();
-                lineDiff = fullTextSz.GetWidth() - dc.GetTextExtent(textLine).GetWidth();
+                lineDiff = TextExtentCache::GetTextExtent(dc, textLine).GetWidth();
+                lineDiff = fullTextSz.GetWidth() -
+                    TextExtentCache::GetTextExtent(dc, textLine).GetWidth();
                 }
             else
                 { return; }
@@ -1362,9 +1416,9 @@ namespace Wisteria::GraphItems
 
         while (lineTokenizer.HasMoreTokens() )
             {
-            // draw the next line
+            // measure the next line
             wxString token = lineTokenizer.GetNextToken();
-            dc.GetTextExtent(token, &lineX, &lineY);
+            TextExtentCache::GetTextExtent(dc, token, &lineX, &lineY);
 
             if (GetHeaderInfo().IsEnabled() && currentLineNumber == 0 && GetLineCount() > 1)
                 {
@@ -1372,7 +1426,7 @@ namespace Wisteria::GraphItems
                 wxDCFontChanger fc(dc,
                     GetHeaderInfo().GetFont().IsOk() ?
                     GetHeaderInfo().GetFont().Scaled(GetScaling()) : dc.GetFont());
-                dc.GetTextExtent(token, &lineX, &lineY);
+                TextExtentCache::GetTextExtent(dc, token, &lineX, &lineY);
                 // if pushed to the left and it's a legend, then it should be to the edge;
                 // otherwise, align with the rest of the text
                 if (GetHeaderInfo().GetLabelAlignment() == TextAlignment::FlushLeft)
@@ -1415,11 +1469,105 @@ namespace Wisteria::GraphItems
                     trackTextLine(token);
                     }
                 }
-            if (!dc.GetFont().IsOk())
-                {
-                wxLogWarning(L"Invalid font used in graphics; will be replaced by system default.");
-                dc.SetFont(wxSystemSettings::GetFont(wxSYS_DEFAULT_GUI_FONT));
-                }
+            lines.push_back({ std::move(token), offest,
+                static_cast<wxCoord>(lineY + std::ceil(ScaleToScreenAndCanvas(GetLineSpacing()))) });
+            ++currentLineNumber;
+            }
+        return lines;
+        }
+
+    //-------------------------------------------
+    size_t Label::HashFont(const wxFont& font)
+        {
+        if (!font.IsOk())
+            { return 0; }
+        const wxString faceName{ font.GetFaceName() };
+        size_t hashValue = std::hash<std::wstring_view>{}(
+            std::wstring_view(faceName.wc_str(), faceName.length()));
+        const auto combine = [&hashValue](const size_t value) noexcept
+            { hashValue ^= value + 0x9e3779b9 + (hashValue << 6) + (hashValue >> 2); };
+        combine(std::hash<double>{}(font.GetFractionalPointSize()));
+        combine(std::hash<int>{}(font.GetNumericWeight()));
+        combine(std::hash<int>{}(font.GetStyle()));
+        combine(std::hash<int>{}(font.GetFamily()));
+        combine(std::hash<bool>{}(font.GetUnderlined()));
+        combine(std::hash<bool>{}(font.GetStrikethrough()));
+        return hashValue;
+        }
+
+    //-------------------------------------------
+    const std::vector<Label::LaidOutLine>& Label::GetLineLayout(wxDC& dc, const bool vertical) const
+        {
+        // everything that the lines' measurements and offsets depend on
+        LineLayoutKey key{ GetText(), HashFont(dc.GetFont()),
+                           GetHeaderInfo().IsEnabled() ? HashFont(GetHeaderInfo().GetFont()) : 0,
+                           dc.GetPPI(),
+                           GetCachedContentBoundingBox().GetSize(), CalcPageHorizontalOffset(dc),
+                           GetScaling(), GetDPIScaleFactor(), GetLineSpacing(),
+                           { GetLeftPadding(), GetRightPadding(),
+                             GetTopPadding(), GetBottomPadding() },
+                           GetTextAlignment(), GetHeaderInfo().GetLabelAlignment(),
+                           GetHeaderInfo().IsEnabled(), HasLegendIcons(), vertical };
+        if (!m_lineLayoutKey || !(m_lineLayoutKey.value() == key))
+            {
+            m_lineLayout = vertical ? CalcVerticalLineLayout(dc) : CalcLineLayout(dc);
+            m_lineLayoutKey = std::move(key);
+            }
+        return m_lineLayout;
+        }
+
+    //-------------------------------------------
+    void Label::DrawVerticalMultiLineText(wxDC& dc, wxPoint pt) const
+        {
+        if (!IsOk())
+            { return; }
+        if (!dc.GetFont().IsOk())
+            {
+            wxLogWarning(L"Invalid font used in graphics; will be replaced by system default.");
+            dc.SetFont(wxSystemSettings::GetFont(wxSYS_DEFAULT_GUI_FONT));
+            }
+
+        pt.y += GetCachedContentBoundingBox().GetHeight();
+        const wxCoord leftOffset = CalcPageHorizontalOffset(dc);
+        size_t currentLineNumber{ 0 };
+        for (const auto& line : GetLineLayout(dc, true))
+            {
+            const auto currentLineOffset =
+                (GetLinesIgnoringLeftMargin().find(currentLineNumber) != GetLinesIgnoringLeftMargin().cend()) ? 0 :
+                ((GetHeaderInfo().IsEnabled() && currentLineNumber == 0) ? 0 : leftOffset);
+            const bool isHeader{ (currentLineNumber == 0 &&
+                                  GetLineCount() > 1 &&
+                                  GetHeaderInfo().IsEnabled() &&
+                                  GetHeaderInfo().GetFont().IsOk()) };
+            wxDCFontChanger fc(dc,
+                isHeader ?
+                GetHeaderInfo().GetFont().Scaled(GetScaling()) : dc.GetFont());
+            wxDCTextColourChanger tcc(dc,
+                isHeader ?
+                GetHeaderInfo().GetFontColor() : dc.GetTextForeground());
+            dc.DrawRotatedText(line.m_text, pt.x, pt.y-line.m_offset-currentLineOffset, 90+m_tiltAngle);
+            // move over for next line
+            pt.x += line.m_advance;
+            ++currentLineNumber;
+            }
+        }
+
+    //-------------------------------------------
+    void Label::DrawMultiLineText(wxDC& dc, wxPoint pt) const
+        {
+        if (!IsOk())
+            { return; }
+        if (!dc.GetFont().IsOk())
+            {
+            wxLogWarning(L"Invalid font used in graphics; will be replaced by system default.");
+            dc.SetFont(wxSystemSettings::GetFont(wxSYS_DEFAULT_GUI_FONT));
+            }
+
+        pt.y += CalcPageVerticalOffset(dc) + ScaleToScreenAndCanvas(GetTopPadding());
+        const wxCoord leftOffset = CalcPageHorizontalOffset(dc);
+        size_t currentLineNumber{ 0 };
+        for (const auto& line : GetLineLayout(dc, false))
+            {
             const auto currentLineOffset =
                 (GetLinesIgnoringLeftMargin().find(currentLineNumber) != GetLinesIgnoringLeftMargin().cend()) ? 0 :
                 ((GetHeaderInfo().IsEnabled() && currentLineNumber == 0) ? 0 : leftOffset);
@@ -1434,11 +1582,11 @@ namespace Wisteria::GraphItems
                 isHeader ?
                 GetHeaderInfo().GetFontColor() : dc.GetTextForeground());
             if (m_tiltAngle != 0)
-                { dc.DrawRotatedText(token,pt.x+offest+currentLineOffset, pt.y, m_tiltAngle); }
+                { dc.DrawRotatedText(line.m_text, pt.x+line.m_offset+currentLineOffset, pt.y, m_tiltAngle); }
             else
-                { dc.DrawText(token,pt.x+offest+currentLineOffset, pt.y); }
+                { dc.DrawText(line.m_text, pt.x+line.m_offset+currentLineOffset, pt.y); }
             // move down for next line
-            pt.y += (lineY+std::ceil(ScaleToScreenAndCanvas(GetLineSpacing())));
+            pt.y += line.m_advance;
             ++currentLineNumber;
             }
         }
@@ -1524,74 +1672,99 @@ namespace Wisteria::GraphItems
         }
 
     //--------------------------------------------------
-    int Label::CalcFontSizeToFitBoundingBox(wxDC& dc, const wxFont& ft, const wxRect& boundingBox, const wxString& text)
+    int Label::CalcLargestFittingFontSize(wxDC& dc, const wxFont& ft,
+        const wxSize boxSize, const wxString& text,
+        const std::function<std::pair<double, double> (const wxSize)>& getFootprint)
         {
-        // start with the smallest possible font and work our way up.
-        wxFont resizedFont(ft); resizedFont.SetPointSize(1);
-        wxDCFontChanger fc(dc, resizedFont);
-        wxCoord textWidth{ 0 }, textHeight{ 0 };
+        // the largest size that will be tried (in case the text is empty)
+        constexpr int maxPointSize{ 1024 };
+        wxFont resizedFont(ft);
+        // the width and height that the text takes up at a given point size
+        const auto measure = [&dc, &resizedFont, &text, &getFootprint](const int pointSize)
+            {
+            resizedFont.SetPointSize(pointSize);
+            wxDCFontChanger fc(dc, resizedFont);
+            return getFootprint(TextExtentCache::GetMultiLineTextExtent(dc, text));
+            };
+        const auto fits = [&](const int pointSize)
+            {
+            const auto footprint = measure(pointSize);
+            // if the font can't be made this large, then treat it as not fitting
+            return resizedFont.GetPointSize() == pointSize &&
+                footprint.first <= boxSize.GetWidth() &&
+                footprint.second <= boxSize.GetHeight();
+            };
 
-        for (;;) // will break when font size is found
+        // measure once at the font's current size and scale that to the area
+        const int referenceSize = std::clamp(ft.GetPointSize(), 1, maxPointSize);
+        const auto [referenceWidth, referenceHeight] = measure(referenceSize);
+        double scaleToFit = std::numeric_limits<double>::max();
+        if (referenceWidth > 0)
+            { scaleToFit = std::min(scaleToFit, boxSize.GetWidth() / referenceWidth); }
+        if (referenceHeight > 0)
+            { scaleToFit = std::min(scaleToFit, boxSize.GetHeight() / referenceHeight); }
+        const int estimatedSize = static_cast<int>(
+            std::clamp(std::floor(referenceSize * scaleToFit), 1.0, static_cast<double>(maxPointSize)));
+
+        // then find sizes around the estimate that do (and don't) fit...
+        int fittingSize{ 1 };
+        int tooLargeSize{ maxPointSize + 1 };
+        if (fits(estimatedSize))
             {
-            // wxFont::Larger() increases font size by 1.2x, which may cause the
-            // point size (integer) to remain the same, messing up the comparison
-            // down below when we try to see if the point size can't be increased anymore.
-            // Also, increasing by 1.2 will be too aggressive (30pt will become 36pt in one operation),
-            // whereas we want to test each point size to find the perfect one.
-            resizedFont.SetPointSize(resizedFont.GetPointSize()+1);
-            // bail if the font can't be made any larger
-            if (resizedFont.GetPointSize() == dc.GetFont().GetPointSize())
-                { return resizedFont.GetPointSize(); }
-            wxDCFontChanger fc2(dc, resizedFont);
-            dc.GetMultiLineTextExtent(text, &textWidth, &textHeight);
-
-            if (textWidth > boundingBox.GetWidth() ||
-                textHeight > boundingBox.GetHeight())
+            fittingSize = estimatedSize;
+            int step{ 1 };
+            while (fittingSize + step < tooLargeSize && fits(fittingSize + step))
                 {
-                resizedFont.SetPointSize(std::max(1, resizedFont.GetPointSize() - 1));
-                break;
+                fittingSize += step;
+                step *= 2;
                 }
+            tooLargeSize = std::min(tooLargeSize, fittingSize + step);
             }
-        return resizedFont.GetPointSize();
+        else
+            {
+            tooLargeSize = estimatedSize;
+            int step{ 1 };
+            while (tooLargeSize - step > 1 && !fits(tooLargeSize - step))
+                {
+                tooLargeSize -= step;
+                step *= 2;
+                }
+            fittingSize = std::max(1, tooLargeSize - step);
+            }
+        // ...and narrow it down to the largest one that fits
+        while (tooLargeSize - fittingSize > 1)
+            {
+            const int midSize = fittingSize + (tooLargeSize - fittingSize) / 2;
+            if (fits(midSize))
+                { fittingSize = midSize; }
+            else
+                { tooLargeSize = midSize; }
+            }
+        return fittingSize;
+        }
+
+    //--------------------------------------------------
+    int Label::CalcFontSizeToFitBoundingBox(wxDC& dc, const wxFont& ft, const wxRect& boundingBox, const wxString& text)
+        {
+        return CalcLargestFittingFontSize(dc, ft, boundingBox.GetSize(), text,
+            [](const wxSize textSize)
+            { return std::make_pair<double, double>(textSize.GetWidth(), textSize.GetHeight()); });
         }
 
     //--------------------------------------------------
     int Label::CalcDiagonalFontSize(wxDC& dc, const wxFont& ft, const wxRect& boundingBox,
                                          const double angleInDegrees, const wxString& text)
         {
-        // start with the smallest possible font and work our way up.
-        wxFont resizedFont(ft); resizedFont.SetPointSize(1);
-        wxDCFontChanger fc(dc, resizedFont);
-        wxCoord textWidth{ 0 }, textHeight{ 0 };
-
-        for (;;) // will break when font size is found
+        const double angleCos = std::abs(std::cos(geometry::degrees_to_radians(angleInDegrees)));
+        const double angleSin = std::abs(std::sin(geometry::degrees_to_radians(angleInDegrees)));
+        return CalcLargestFittingFontSize(dc, ft, boundingBox.GetSize(), text,
+            [angleCos, angleSin](const wxSize textSize)
             {
-            // wxFont::Larger() increases font size by 1.2f, which may cause the
-            // point size (integer) to remain the same, messing up the comparison
-            // down below when we try to see if the point size can't be increased anymore.
-            // Also, increasing by 1.2 will be too aggressive (30pt will become 36pt in one operation),
-            // whereas we want to test each point size to find the perfect one.
-            resizedFont.SetPointSize(resizedFont.GetPointSize()+1);
-            // bail if the font can't be made any larger
-            if (resizedFont.GetPointSize() == dc.GetFont().GetPointSize())
-                { return resizedFont.GetPointSize(); }
-            wxDCFontChanger fc2(dc, resizedFont);
-            dc.GetMultiLineTextExtent(text, &textWidth, &textHeight);
-
-            const float widthOfWatermark = textWidth *
-                std::abs(std::cos(geometry::degrees_to_radians(angleInDegrees))) -
-                textHeight * std::abs(std::sin(geometry::degrees_to_radians(angleInDegrees)));
-            const float heightOfWatermark = textWidth *
-                std::abs(std::sin(geometry::degrees_to_radians(angleInDegrees))) +
-                textHeight * std::abs(std::cos(geometry::degrees_to_radians(angleInDegrees)));
-
-            if (widthOfWatermark > boundingBox.GetWidth() ||
-                heightOfWatermark > boundingBox.GetHeight())
-                {
-                resizedFont.SetPointSize(std::max(1, resizedFont.GetPointSize() - 1));
-                break;
-                }
-            }
-        return resizedFont.GetPointSize();
+            const float widthOfWatermark = textSize.GetWidth() * angleCos -
+                                           textSize.GetHeight() * angleSin;
+            const float heightOfWatermark = textSize.GetWidth() * angleSin +
+                                            textSize.GetHeight() * angleCos;
+            return std::make_pair<double, double>(widthOfWatermark, heightOfWatermark);
+            });
         }
     }
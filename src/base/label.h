@@ -13,7 +13,10 @@
 #define __WISTERIA_CANVASLABEL_H__
 
 #include <vector>
+#include <array>
+#include <optional>
 #include <string_view>
+#include <functional>
 #include <wx/wx.h>
 #include <wx/tokenzr.h>
 #include <wx/fontenum.h>
@@ -34,6 +37,7 @@ namespace Wisteria::Graphs
 namespace Wisteria::GraphItems
     {
     class Points2D;
+    class PointCloud;
     class GraphItemBase;
     class Axis;
     }
@@ -51,6 +55,7 @@ namespace Wisteria::GraphItems
         friend class Wisteria::Canvas;
         friend class GraphItems::Axis;
         friend class GraphItems::Points2D;
+        friend class GraphItems::PointCloud;
         friend class GraphItems::GraphItemBase;
     public:
         /// @private
@@ -82,9 +87,11 @@ namespace Wisteria::GraphItems
         /** @brief Chop the string up so that it will fit within a bounding box.
             @param dc The device context to measure with.
             @param boundingBoxSize The size of the bounding box to fit the text into.
+            @param lineBreakStyle How to choose where lines are broken.
             @note If the bounding box isn't tall enough to fit the text, then the text
              will be truncated and have an ellipsis appended to it.*/
-        void SplitTextToFitBoundingBox(wxDC& dc, const wxSize& boundingBoxSize);
+        void SplitTextToFitBoundingBox(wxDC& dc, const wxSize& boundingBoxSize,
+                                       const LineBreakStyle lineBreakStyle = LineBreakStyle::Greedy);
 
         /** @brief Splits the string into multiline chunks, with each line being around
              the suggested length argument.
@@ -141,6 +148,10 @@ namespace Wisteria::GraphItems
             @param label The text for the label.*/
         void SetText(const wxString& label) final
             {
+            // keep the cached measurements if the text isn't changing
+            // (e.g., a graph's titles being reset when it is given new data)
+            if (label == GetText())
+                { return; }
             GraphItemBase::SetText(label);
             CalcLongestLineLength();
             InvalidateCachedBoundingBox();
@@ -257,6 +268,31 @@ namespace Wisteria::GraphItems
         static void FixFont(wxFont& theFont);
         /// @}
     private:
+        /** @returns The largest font size that a string can be drawn with and still fit within
+             an area (or @c 1 if it doesn't fit at any size).
+            @details Text extents scale (roughly) linearly with the point size, so the size is
+             estimated from one measurement and then refined with a bounded search around that.
+             (Each size's measurement is cached, so fitting the same text again is cheap.)
+            @param dc The device context to measure with.
+            @param ft The font being measured.
+            @param boxSize The area that the text needs to fit in.
+            @param text The text being measured.
+            @param getFootprint Converts the size of the measured text into the width and height
+             that it will take up in the area (e.g., if it will be drawn at an angle).*/
+        [[nodiscard]] static int CalcLargestFittingFontSize(wxDC& dc, const wxFont& ft,
+            const wxSize boxSize, const wxString& text,
+            const std::function<std::pair<double, double> (const wxSize)>& getFootprint);
+        /** @brief Chooses where to break a series of words into lines.
+            @param wordWidths The widths of the words.
+            @param spaceWidth The width of the space between words.
+            @param maxWidth The maximum width of a line. (A word wider than this
+             will be put on its own line.)
+            @param lineBreakStyle How to choose where lines are broken.
+            @returns The indices of the words that start each line
+             (the first one will always be @c 0).*/
+        [[nodiscard]] static std::vector<size_t> CalcLineBreaks(
+            const std::vector<wxCoord>& wordWidths, const wxCoord spaceWidth,
+            const wxCoord maxWidth, const LineBreakStyle lineBreakStyle);
         /// @returns Number of lines of text in the label.
         [[nodiscard]] size_t GetLineCount() const noexcept
             { return m_lineCount; }
@@ -289,6 +325,69 @@ namespace Wisteria::GraphItems
             @param pt The point to draw the text.\n
              This coordinate refers to the top-left corner of the rectangle bounding the string.*/
         void DrawMultiLineText(wxDC& dc, wxPoint pt) const;
+        /// @brief A line of text, measured and positioned for drawing.
+        struct LaidOutLine
+            {
+            /// @brief The line's text (with extra spacing if justified).
+            wxString m_text;
+            /// @brief How far along the line's axis to draw it
+            ///  (not including the left margin offset).
+            wxCoord m_offset{ 0 };
+            /// @brief How far to move over for the next line.
+            wxCoord m_advance{ 0 };
+            };
+        /// @brief Everything that a label's line layout depends on.
+        struct LineLayoutKey
+            {
+            wxString m_text;
+            /// @brief Hashes of the fonts (see HashFont()), which are much cheaper to compare
+            ///  than the fonts themselves.
+            size_t m_fontHash{ 0 };
+            size_t m_headerFontHash{ 0 };
+            /// @brief The DC's resolution, which the fonts are measured at.
+            wxSize m_ppi;
+            wxSize m_contentSize;
+            wxCoord m_leftOffset{ 0 };
+            double m_scaling{ 1 };
+            double m_dpiScaling{ 1 };
+            double m_lineSpacing{ 1 };
+            std::array<wxCoord, 4> m_padding{ 0, 0, 0, 0 };
+            TextAlignment m_alignment{ TextAlignment::FlushLeft };
+            TextAlignment m_headerAlignment{ TextAlignment::FlushLeft };
+            bool m_headerEnabled{ false };
+            bool m_hasLegendIcons{ false };
+            bool m_vertical{ false };
+            [[nodiscard]] bool operator==(const LineLayoutKey& that) const
+                {
+                return m_fontHash == that.m_fontHash && m_headerFontHash == that.m_headerFontHash &&
+                    m_ppi == that.m_ppi && m_text == that.m_text && m_contentSize == that.m_contentSize &&
+                    m_leftOffset == that.m_leftOffset && m_scaling == that.m_scaling &&
+                    m_dpiScaling == that.m_dpiScaling && m_lineSpacing == that.m_lineSpacing &&
+                    m_padding == that.m_padding && m_alignment == that.m_alignment &&
+                    m_headerAlignment == that.m_headerAlignment &&
+                    m_headerEnabled == that.m_headerEnabled &&
+                    m_hasLegendIcons == that.m_hasLegendIcons && m_vertical == that.m_vertical;
+                }
+            };
+        /** @brief Splits the text into lines and measures where each one is drawn.
+            @details This is the expensive part of drawing a label (measuring each line,
+             and re-spacing justified lines), so the results are cached by GetLineLayout().
+            @param dc The device context to measure with.
+            @returns The lines for DrawVerticalMultiLineText().*/
+        [[nodiscard]] std::vector<LaidOutLine> CalcVerticalLineLayout(wxDC& dc) const;
+        /** @brief Splits the text into lines and measures where each one is drawn.
+            @param dc The device context to measure with.
+            @returns The lines for DrawMultiLineText().*/
+        [[nodiscard]] std::vector<LaidOutLine> CalcLineLayout(wxDC& dc) const;
+        /** @returns A hash of what a font measures text with (i.e., its face name, size, weight,
+             style, family, and decorations), or @c 0 for an invalid font.
+            @param font The font to hash.*/
+        [[nodiscard]] static size_t HashFont(const wxFont& font);
+        /** @returns The cached line layout, recalculating it if the text, fonts,
+             size, or scaling have changed since the last time the label was drawn.
+            @param dc The device context to measure with.
+            @param vertical @c true for the layout of vertical text.*/
+        [[nodiscard]] const std::vector<LaidOutLine>& GetLineLayout(wxDC& dc, const bool vertical) const;
         /// @brief Figures out how many characters are in the longest line of text
         ///  (takes multiline labels into account).
         void CalcLongestLineLength();
@@ -312,6 +411,10 @@ namespace Wisteria::GraphItems
         size_t m_longestLineLength{ 0 };
         std::set<size_t> m_linesIgnoringLeftMargin;
         BoxCorners m_boxCorners{ BoxCorners::Straight };
+
+        // lines from the last time the label was drawn, and what they were measured with
+        mutable std::vector<LaidOutLine> m_lineLayout;
+        mutable std::optional<LineLayoutKey> m_lineLayoutKey;
         };
     }
 
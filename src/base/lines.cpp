@@ -31,15 +31,81 @@ namespace Wisteria::GraphItems
         if (GetPen().IsOk())
             { scaledPen.SetWidth(ScaleToScreenAndCanvas(GetPen().GetWidth())); }
         wxDCPenChanger pc(dc, IsSelected() ? wxPen(*wxBLACK, 2*scaledPen.GetWidth(), wxPENSTYLE_DOT) : scaledPen);
-        for (const auto& line : m_lines)
+
+        // skip lines that are outside of the area being drawn
+        // (e.g., gridlines outside of the strip of a large image being rendered)
+        std::optional<wxRect> visibleRect{ GetClippingRect() };
+        if (wxRect dcClippingRect; dc.GetClippingBox(dcClippingRect) && !dcClippingRect.IsEmpty())
             {
-            if (GetLineStyle() == LineStyle::Arrows)
+            visibleRect = visibleRect ?
+                visibleRect.value().Intersect(dcClippingRect) : dcClippingRect;
+            }
+        if (visibleRect)
+            {
+            // include the pen's width and the arrowheads
+            visibleRect.value().Inflate(std::max(dc.GetPen().GetWidth(), 1) +
+                ((GetLineStyle() == LineStyle::Arrows) ? ScaleToScreenAndCanvas(10) : 0));
+            }
+        const auto isLineVisible = [&visibleRect](const std::pair<wxPoint, wxPoint>& line)
+            {
+            return !visibleRect ||
+                visibleRect.value().Intersects(wxRect(line.first, line.second));
+            };
+
+        if (GetLineStyle() == LineStyle::Arrows)
+            {
+            for (const auto& line : m_lines)
+                {
+                if (isLineVisible(line))
+                    {
+                    Polygon::DrawArrow(dc, line.first, line.second,
+                        wxSize(ScaleToScreenAndCanvas(10), ScaleToScreenAndCanvas(10)));
+                    }
+                }
+            }
+        // Lines or Spline
+        // (build all of the lines into one path and stroke them all at once)
+        else if (auto gc = dc.GetGraphicsContext(); gc != nullptr)
+            {
+            wxGraphicsPath path = gc->CreatePath();
+            bool hasVisibleLines{ false };
+            for (const auto& line : m_lines)
+                {
+                if (isLineVisible(line))
+                    {
+                    path.MoveToPoint(line.first.x, line.first.y);
+                    path.AddLineToPoint(line.second.x, line.second.y);
+                    hasVisibleLines = true;
+                    }
+                }
+            if (hasVisibleLines)
+                { gc->StrokePath(path); }
+            }
+        // or draw connected runs of lines (e.g., the outline of a box) as polylines
+        else
+            {
+            std::vector<wxPoint> polyline;
+            const auto flushPolyline = [&dc, &polyline]()
+                {
+                if (polyline.size() > 1)
+                    { dc.DrawLines(polyline.size(), &polyline[0]); }
+                polyline.clear();
+                };
+            for (const auto& line : m_lines)
                 {
-                Polygon::DrawArrow(dc, line.first, line.second,
-                    wxSize(ScaleToScreenAndCanvas(10), ScaleToScreenAndCanvas(10)));
+                if (!isLineVisible(line))
+                    {
+                    flushPolyline();
+                    continue;
+                    }
+                if (polyline.empty() || polyline.back() != line.first)
+                    {
+                    flushPolyline();
+                    polyline.push_back(line.first);
+                    }
+                polyline.push_back(line.second);
                 }
-            else // Lines or Spline
-                { dc.DrawLine(line.first, line.second); }
+            flushPolyline();
             }
         // highlight the selected bounding box in debug mode
         if (Settings::IsDebugFlagEnabled(DebugSettings::DrawBoundingBoxesOnSelection) && IsSelected())
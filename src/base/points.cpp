@@ -78,6 +78,7 @@ namespace Wisteria::GraphItems
     //-------------------------------------------
     void Points2D::AddPoint(Point2D pt, wxDC& dc)
         {
+        m_hitTestGrid.Clear();
         pt.SetId(m_currentAssignedId++);
         pt.SetDPIScaleFactor(GetDPIScaleFactor());
         pt.SetScaling(GetScaling());
@@ -113,16 +114,19 @@ namespace Wisteria::GraphItems
     //-------------------------------------------
     bool Points2D::HitTest(const wxPoint pt, wxDC& dc) const
         {
-        for (auto pointsPos = GetPoints().cbegin(); pointsPos != GetPoints().cend(); ++pointsPos)
+        // a point is hit if the mouse is inside of its bounding box,
+        // so index those to avoid testing every point
+        if (!m_hitTestGrid.IsBuilt())
             {
-            if (pointsPos->HitTest(pt, dc))
-                {
-                m_lastHitPointIndex = pointsPos-GetPoints().cbegin();
-                return true;
-                }
+            std::vector<wxRect> boxes;
+            boxes.reserve(GetPoints().size());
+            for (const auto& point : GetPoints())
+                { boxes.push_back(point.GetBoundingBox(dc)); }
+            m_hitTestGrid.Build(std::move(boxes));
             }
-        m_lastHitPointIndex = static_cast<std::vector<Point2D>::size_type>(-1);
-        return false;
+        const auto hitPoint = m_hitTestGrid.FindFirstItemAt(pt);
+        m_lastHitPointIndex = hitPoint.value_or(static_cast<std::vector<Point2D>::size_type>(-1));
+        return hitPoint.has_value();
         }
 
     //-------------------------------------------
@@ -602,4 +606,474 @@ namespace Wisteria::GraphItems
             }
         return boundingBox;
         }
+
+    //-------------------------------------------
+    void PointCloud::Reserve(const size_t size)
+        {
+        m_coordinates.reserve(size);
+        m_colorIndices.reserve(size);
+        m_shapeIndices.reserve(size);
+        }
+
+    //-------------------------------------------
+    void PointCloud::AddPoint(const wxPoint pt, const wxColour& color,
+                              const IconShape shape /*= IconShape::CircleIcon*/,
+                              const wxString& label /*= wxString{}*/,
+                              const wxBitmapBundle* img /*= nullptr*/)
+        {
+        m_hitTestGrid.Clear();
+        m_coordinates.push_back(pt);
+        // look up (or add) the point's color and shape in the tables
+        const auto [colorPos, colorInserted] =
+            m_colorLookup.try_emplace(color.GetRGBA(), static_cast<uint32_t>(m_colors.size()));
+        if (colorInserted)
+            { m_colors.push_back(color); }
+        m_colorIndices.push_back(colorPos->second);
+
+        const auto shapePos = std::find(m_shapes.cbegin(), m_shapes.cend(),
+                                        std::make_pair(shape, img));
+        if (shapePos != m_shapes.cend())
+            { m_shapeIndices.push_back(static_cast<uint8_t>(shapePos - m_shapes.cbegin())); }
+        else if (m_shapes.size() <= std::numeric_limits<uint8_t>::max())
+            {
+            m_shapeIndices.push_back(static_cast<uint8_t>(m_shapes.size()));
+            m_shapes.emplace_back(shape, img);
+            }
+        else
+            {
+            wxFAIL_MSG(L"Too many shapes in point cloud, using the first shape instead.");
+            m_shapeIndices.push_back(0);
+            }
+
+        if (!label.empty())
+            {
+            if (m_labels.size() < m_coordinates.size())
+                { m_labels.resize(m_coordinates.size()); }
+            m_labels.back() = label;
+            }
+
+        if (pt.IsFullySpecified())
+            {
+            if (!m_hasValidPoints)
+                {
+                m_minPoint = m_maxPoint = pt;
+                m_hasValidPoints = true;
+                }
+            else
+                {
+                m_minPoint.x = std::min(m_minPoint.x, pt.x);
+                m_minPoint.y = std::min(m_minPoint.y, pt.y);
+                m_maxPoint.x = std::max(m_maxPoint.x, pt.x);
+                m_maxPoint.y = std::max(m_maxPoint.y, pt.y);
+                }
+            if (IsTallShape(shape))
+                { m_hasTallShapes = true; }
+            }
+        }
+
+    //-------------------------------------------
+    void PointCloud::SetSelected(const bool selected)
+        {
+        GraphItemBase::SetSelected(selected);
+
+        // toggle selection on the point that was clicked on
+        if (selected && m_singlePointSelection && m_lastHitPointIndex < GetPointCount())
+            {
+            const auto id = static_cast<long>(m_lastHitPointIndex);
+            if (const auto foundPos = GetSelectedIds().find(id);
+                foundPos != GetSelectedIds().end())
+                {
+                GetSelectedIds().erase(foundPos);
+                // if last point was unselected, then mark the entire collection as unselected
+                if (GetSelectedIds().empty())
+                    { GraphItemBase::SetSelected(false); }
+                }
+            else
+                { GetSelectedIds().insert(id); }
+            }
+        }
+
+    //-------------------------------------------
+    wxRect PointCloud::GetPointBoundingBox(const size_t index) const
+        {
+        if (!m_coordinates[index].IsFullySpecified())
+            { return wxRect(); }
+        const auto radius = static_cast<wxCoord>(ScaleToScreenAndCanvas(GetRadius()));
+        wxRect boundingBox(GetScreenPoint(index) - wxSize(radius, radius),
+                           wxSize(radius * 2, radius * 2));
+        if (IsTallShape(m_shapes[m_shapeIndices[index]].first))
+            {
+            boundingBox.SetTop(boundingBox.GetTop() - boundingBox.GetHeight());
+            boundingBox.SetHeight(boundingBox.GetHeight() * 1.5);
+            }
+        return boundingBox;
+        }
+
+    //-------------------------------------------
+    wxRect PointCloud::GetBoundingBox([[maybe_unused]] wxDC& dc) const
+        {
+        if (!m_hasValidPoints)
+            { return wxRect(); }
+        const double scaling = IsFreeFloating() ? GetScaling() : 1.0;
+        const auto radius = static_cast<wxCoord>(ScaleToScreenAndCanvas(GetRadius()));
+        wxRect boundingBox(wxPoint(m_minPoint.x * scaling, m_minPoint.y * scaling),
+                           wxPoint(m_maxPoint.x * scaling, m_maxPoint.y * scaling));
+        boundingBox.Inflate(radius);
+        if (m_hasTallShapes)
+            {
+            boundingBox.SetTop(boundingBox.GetTop() - radius * 2);
+            boundingBox.SetHeight(boundingBox.GetHeight() + radius * 2);
+            }
+        return boundingBox;
+        }
+
+    //-------------------------------------------
+    void PointCloud::Offset(const int xToMove, const int yToMove)
+        {
+        for (auto& pt : m_coordinates)
+            {
+            if (pt.IsFullySpecified())
+                { pt += wxPoint(xToMove, yToMove); }
+            }
+        m_minPoint += wxPoint(xToMove, yToMove);
+        m_maxPoint += wxPoint(xToMove, yToMove);
+        m_hitTestGrid.Clear();
+        }
+
+    //-------------------------------------------
+    bool PointCloud::HitTest(const wxPoint pt, [[maybe_unused]] wxDC& dc) const
+        {
+        if (!m_hitTestGrid.IsBuilt())
+            {
+            std::vector<wxRect> boxes;
+            boxes.reserve(GetPointCount());
+            for (size_t i = 0; i < GetPointCount(); ++i)
+                { boxes.push_back(GetPointBoundingBox(i)); }
+            m_hitTestGrid.Build(std::move(boxes));
+            }
+        const auto hitPoint = m_hitTestGrid.FindFirstItemAt(pt);
+        m_lastHitPointIndex = hitPoint.value_or(static_cast<size_t>(-1));
+        return hitPoint.has_value();
+        }
+
+    //-------------------------------------------
+    void PointCloud::DrawSelectionLabel(wxDC& dc, const double scaling,
+                                        const wxRect boundingBox) const
+        {
+        if (!IsSelected() || !IsShowingLabelWhenSelected())
+            { return; }
+
+        const auto drawLabel = [&](const size_t index)
+            {
+            if (index >= m_labels.size() || m_labels[index].empty() ||
+                !m_coordinates[index].IsFullySpecified())
+                { return; }
+            const wxRect pointBox = GetPointBoundingBox(index);
+            GraphItems::Label selectionLabel(
+                GraphItemInfo(m_labels[index]).Scaling(scaling).Pen(*wxBLACK_PEN).
+                DPIScaling(GetDPIScaleFactor()).
+                Padding(2, 2, 2, 2).FontBackgroundColor(*wxWHITE).
+                AnchorPoint(pointBox.GetTopLeft() + wxPoint(pointBox.GetWidth() / 2,
+                                                            pointBox.GetHeight() / 2)));
+            // move the label inside of the bounding box if it is going outside of it
+            if (!boundingBox.IsEmpty())
+                {
+                const wxRect labelBox = selectionLabel.GetBoundingBox(dc);
+                wxPoint adjustment(0, 0);
+                if (labelBox.GetBottom() > boundingBox.GetBottom())
+                    { adjustment.y = boundingBox.GetBottom() - labelBox.GetBottom(); }
+                else if (labelBox.GetTop() < boundingBox.GetTop())
+                    { adjustment.y = boundingBox.GetTop() - labelBox.GetTop(); }
+                if (labelBox.GetRight() > boundingBox.GetRight())
+                    { adjustment.x = boundingBox.GetRight() - labelBox.GetRight(); }
+                else if (labelBox.GetLeft() < boundingBox.GetLeft())
+                    { adjustment.x = boundingBox.GetLeft() - labelBox.GetLeft(); }
+                selectionLabel.SetAnchorPoint(selectionLabel.GetAnchorPoint() + adjustment);
+                }
+            selectionLabel.Draw(dc);
+            };
+
+        if (m_singlePointSelection)
+            {
+            for (const auto id : GetSelectedIds())
+                {
+                if (id >= 0)
+                    { drawLabel(static_cast<size_t>(id)); }
+                }
+            }
+        else
+            {
+            for (size_t i = 0; i < m_labels.size(); ++i)
+                { drawLabel(i); }
+            }
+        }
+
+    //-------------------------------------------
+    void PointCloud::DrawConnectionLine(wxDC& dc) const
+        {
+        if (!GetPen().IsOk() || m_coordinates.empty())
+            { return; }
+
+        wxPen scaledPen(GetPen());
+        scaledPen.SetWidth(ScaleToScreenAndCanvas(GetPen().GetWidth()));
+        wxDCPenChanger pc(dc, scaledPen);
+
+        const auto okPointsCount = std::count_if(m_coordinates.cbegin(), m_coordinates.cend(),
+            [](const auto pt) noexcept { return pt.IsFullySpecified(); });
+        if (okPointsCount == 0)
+            { return; }
+        // just one point, so no line to draw
+        // (just draw point if shapes aren't being drawn; if points have a shape,
+        //  then it will be drawn later)
+        else if (okPointsCount == 1)
+            {
+            for (size_t i = 0; i < GetPointCount(); ++i)
+                {
+                if (m_coordinates[i].IsFullySpecified() &&
+                    GetPointShape(i) == IconShape::BlankIcon)
+                    {
+                    wxDCBrushChanger bc(dc, scaledPen.GetColour());
+                    dc.DrawCircle(GetScreenPoint(i), GetRadius());
+                    break;
+                    }
+                }
+            return;
+            }
+
+        // draw each run of valid points (missing points will break the line)
+        std::vector<wxPoint> currentSegment;
+        const auto drawSegment = [&dc, &currentSegment, this]()
+            {
+            if (currentSegment.size() > 1)
+                {
+                if (GetLineStyle() == LineStyle::Spline)
+                    { dc.DrawSpline(currentSegment.size(), &currentSegment.front()); }
+                else if (GetLineStyle() == LineStyle::Arrows)
+                    {
+                    for (size_t i = 0; i < currentSegment.size() - 1; ++i)
+                        {
+                        Polygon::DrawArrow(dc, currentSegment[i], currentSegment[i + 1],
+                            wxSize(ScaleToScreenAndCanvas(10), ScaleToScreenAndCanvas(10)));
+                        }
+                    }
+                else
+                    { dc.DrawLines(currentSegment.size(), &currentSegment.front()); }
+                }
+            currentSegment.clear();
+            };
+        for (size_t i = 0; i < GetPointCount(); ++i)
+            {
+            if (m_coordinates[i].IsFullySpecified())
+                { currentSegment.push_back(GetScreenPoint(i)); }
+            else
+                { drawSegment(); }
+            }
+        drawSegment();
+        }
+
+    //-------------------------------------------
+    bool PointCloud::DrawBatch(wxDC& dc, const PointStyle style,
+                               const std::vector<size_t>& indices) const
+        {
+        const IconShape shape = m_shapes[style.second].first;
+        if (shape == IconShape::BlankIcon)
+            { return true; }
+
+        const auto radius = static_cast<wxCoord>(ScaleToScreenAndCanvas(GetRadius()));
+        // the outline of the shape (relative to a point's center),
+        // either a polygon or line segments
+        std::vector<wxPoint> polygon;
+        std::vector<std::pair<wxPoint, wxPoint>> segments;
+        switch (shape)
+            {
+            case IconShape::CircleIcon:
+                [[fallthrough]];
+            case IconShape::SquareIcon:
+                break;
+            case IconShape::HorizontalLineIcon:
+                segments.emplace_back(wxPoint(-radius, 0), wxPoint(radius - 1, 0));
+                break;
+            case IconShape::CrossIcon:
+                segments.emplace_back(wxPoint(0, -radius), wxPoint(0, radius));
+                segments.emplace_back(wxPoint(-radius, 0), wxPoint(radius, 0));
+                break;
+            case IconShape::AsteriskIcon:
+                segments.emplace_back(wxPoint(0, -radius), wxPoint(0, radius));
+                segments.emplace_back(wxPoint(-radius, 0), wxPoint(radius, 0));
+                segments.emplace_back(wxPoint(radius, radius), wxPoint(-radius, -radius));
+                segments.emplace_back(wxPoint(-radius, radius), wxPoint(radius, -radius));
+                break;
+            case IconShape::TriangleUpwardIcon:
+                polygon = { wxPoint(0, -radius), wxPoint(-radius, radius), wxPoint(radius, radius) };
+                break;
+            case IconShape::TriangleDownwardIcon:
+                polygon = { wxPoint(0, radius), wxPoint(-radius, -radius), wxPoint(radius, -radius) };
+                break;
+            case IconShape::TriangleRightIcon:
+                polygon = { wxPoint(radius, 0), wxPoint(-radius, radius), wxPoint(-radius, -radius) };
+                break;
+            case IconShape::TriangleLeftIcon:
+                polygon = { wxPoint(-radius, 0), wxPoint(radius, radius), wxPoint(radius, -radius) };
+                break;
+            case IconShape::DiamondIcon:
+                polygon = { wxPoint(0, -radius), wxPoint(radius, 0),
+                            wxPoint(0, radius), wxPoint(-radius, 0) };
+                break;
+            case IconShape::HexagonIcon:
+                polygon = { wxPoint(-radius / 2, -radius), wxPoint(-radius, 0),
+                            wxPoint(-radius / 2, radius), wxPoint(radius / 2, radius),
+                            wxPoint(radius, 0), wxPoint(radius / 2, -radius) };
+                break;
+            default:
+                // more complex shapes (and images) are drawn individually
+                return false;
+            }
+
+        // points that land on the same pixel would just be drawn on top of each other
+        std::vector<wxPoint> centers;
+        centers.reserve(indices.size());
+        for (const auto index : indices)
+            { centers.push_back(GetScreenPoint(index)); }
+        std::sort(centers.begin(), centers.end(),
+            [](const auto& pt1, const auto& pt2) noexcept
+            { return (pt1.x < pt2.x) || (pt1.x == pt2.x && pt1.y < pt2.y); });
+        centers.erase(std::unique(centers.begin(), centers.end()), centers.end());
+
+        const wxColour& color = m_colors[style.first];
+        wxPen pen{ m_pointPen };
+        if (pen.IsOk())
+            { pen.SetWidth(ScaleToScreenAndCanvas(pen.GetWidth())); }
+        else
+            { pen = *wxTRANSPARENT_PEN; }
+        // lines are drawn with the pen, and crosses with a thicker pen using the point's color
+        if (shape == IconShape::CrossIcon || shape == IconShape::AsteriskIcon)
+            { pen = wxPen(wxPenInfo(color, std::max(pen.GetWidth(), 1) * 2)); }
+
+        // build everything into one path and draw it all at once
+        if (auto gc = dc.GetGraphicsContext(); gc != nullptr)
+            {
+            wxGraphicsPath path = gc->CreatePath();
+            for (const auto& center : centers)
+                {
+                if (shape == IconShape::CircleIcon)
+                    { path.AddCircle(center.x, center.y, radius); }
+                else if (shape == IconShape::SquareIcon)
+                    { path.AddRectangle(center.x - radius, center.y - radius, radius * 2, radius * 2); }
+                else if (!polygon.empty())
+                    {
+                    path.MoveToPoint(center.x + polygon[0].x, center.y + polygon[0].y);
+                    for (size_t i = 1; i < polygon.size(); ++i)
+                        { path.AddLineToPoint(center.x + polygon[i].x, center.y + polygon[i].y); }
+                    path.CloseSubpath();
+                    }
+                else
+                    {
+                    for (const auto& [startPt, endPt] : segments)
+                        {
+                        path.MoveToPoint(center.x + startPt.x, center.y + startPt.y);
+                        path.AddLineToPoint(center.x + endPt.x, center.y + endPt.y);
+                        }
+                    }
+                }
+            gc->SetPen(pen);
+            if (segments.empty())
+                {
+                gc->SetBrush(wxBrush(color));
+                // overlapping points should all be filled
+                gc->DrawPath(path, wxWINDING_RULE);
+                }
+            else
+                { gc->StrokePath(path); }
+            // restore the DC's pen and brush on the graphics context
+            gc->SetPen(dc.GetPen());
+            gc->SetBrush(dc.GetBrush());
+            }
+        // or stamp the shape on each point, with the pen and brush only set once
+        else
+            {
+            wxDCPenChanger pc(dc, pen);
+            wxDCBrushChanger bc(dc, color);
+            for (const auto& center : centers)
+                {
+                if (shape == IconShape::CircleIcon)
+                    { dc.DrawCircle(center, radius); }
+                else if (shape == IconShape::SquareIcon)
+                    { dc.DrawRectangle(center - wxSize(radius, radius), wxSize(radius * 2, radius * 2)); }
+                else if (!polygon.empty())
+                    { dc.DrawPolygon(polygon.size(), &polygon.front(), center.x, center.y); }
+                else
+                    {
+                    for (const auto& [startPt, endPt] : segments)
+                        { dc.DrawLine(center + startPt, center + endPt); }
+                    }
+                }
+            }
+        return true;
+        }
+
+    //-------------------------------------------
+    void PointCloud::DrawSinglePoint(wxDC& dc, const size_t index, const wxPen& pen) const
+        {
+        Point2D pt(GraphItemInfo().AnchorPoint(m_coordinates[index]).
+                   Brush(GetPointColor(index)).Pen(pen).
+                   Scaling(GetScaling()).DPIScaling(GetDPIScaleFactor()),
+                   GetRadius(), GetPointShape(index), m_shapes[m_shapeIndices[index]].second);
+        pt.SetFreeFloating(IsFreeFloating());
+        pt.SetSelected(IsPointSelected(index));
+        pt.Draw(dc);
+        }
+
+    //-------------------------------------------
+    wxRect PointCloud::Draw(wxDC& dc) const
+        {
+        if (!IsShown())
+            { return wxRect(); }
+        if (IsInDragState())
+            { return GetBoundingBox(dc); }
+
+        if (GetClippingRect())
+            { dc.SetClippingRegion(GetClippingRect().value()); }
+
+        DrawConnectionLine(dc);
+
+        // group the points by color and shape (in the order that the styles first appear)
+        std::vector<std::pair<PointStyle, std::vector<size_t>>> batches;
+        std::map<PointStyle, size_t> batchLookup;
+        // selected points are drawn individually on top of everything else
+        std::vector<size_t> selectedPoints;
+        for (size_t i = 0; i < GetPointCount(); ++i)
+            {
+            if (!m_coordinates[i].IsFullySpecified())
+                { continue; }
+            if (m_singlePointSelection && IsPointSelected(i))
+                {
+                selectedPoints.push_back(i);
+                continue;
+                }
+            const PointStyle style{ m_colorIndices[i], m_shapeIndices[i] };
+            const auto [batchPos, inserted] = batchLookup.try_emplace(style, batches.size());
+            if (inserted)
+                { batches.emplace_back(style, std::vector<size_t>{}); }
+            batches[batchPos->second].second.push_back(i);
+            }
+
+        for (const auto& [style, indices] : batches)
+            {
+            if (!DrawBatch(dc, style, indices))
+                {
+                for (const auto index : indices)
+                    { DrawSinglePoint(dc, index, m_pointPen); }
+                }
+            }
+
+        wxPen selectedPen{ m_pointPen };
+        if (selectedPen.IsOk())
+            { selectedPen.SetStyle(wxPENSTYLE_DOT); }
+        for (const auto index : selectedPoints)
+            { DrawSinglePoint(dc, index, selectedPen); }
+
+        if (GetClippingRect())
+            { dc.DestroyClippingRegion(); }
+        return GetBoundingBox(dc);
+        }
     }
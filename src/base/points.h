@@ -12,7 +12,12 @@
 #ifndef __WISTERIA_POINTS_H__
 #define __WISTERIA_POINTS_H__
 
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <unordered_map>
 #include "graphitems.h"
+#include "../util/spatialgrid.h"
 
 namespace Wisteria::GraphItems
     {
@@ -20,6 +25,7 @@ namespace Wisteria::GraphItems
     class Point2D final : public GraphItemBase
         {
         friend class Points2D;
+        friend class PointCloud;
         friend class Graphs::Graph2D;
         friend class Wisteria::Canvas;
     public:
@@ -111,8 +117,12 @@ namespace Wisteria::GraphItems
         explicit Points2D(const wxPen& pen)
             { GetPen() = pen; }
         /// @returns The points in this collection.
+        /// @note The points may be edited, so the hit-testing index will be rebuilt.
         [[nodiscard]] std::vector<Point2D>& GetPoints() noexcept
-            { return m_points; }
+            {
+            m_hitTestGrid.Clear();
+            return m_points;
+            }
         /// @brief Reserves memory for a specified number of points.
         /// @param size The number of points to reserve space for.
         void Reserve(const size_t size)
@@ -142,6 +152,7 @@ namespace Wisteria::GraphItems
             GraphItemBase::SetFreeFloating(freeFloat);
             for (auto& point : m_points)
                 { point.SetFreeFloating(freeFloat); }
+            m_hitTestGrid.Clear();
             }
         /// @returns How the segments between the points on a line are connected.
         [[nodiscard]] LineStyle GetLineStyle() const noexcept
@@ -158,6 +169,7 @@ namespace Wisteria::GraphItems
             GraphItemBase::SetScaling(scaling);
             for (auto& point : m_points)
                 { point.SetScaling(scaling); }
+            m_hitTestGrid.Clear();
             }
         /// @brief Sets the DPI scale factor.
         /// @param scaling The DPI scaling.
@@ -166,6 +178,7 @@ namespace Wisteria::GraphItems
             GraphItemBase::SetDPIScaleFactor(scaling);
             for (auto& point : m_points)
                 { point.SetDPIScaleFactor(scaling); }
+            m_hitTestGrid.Clear();
             }
         /// @private
         [[nodiscard]] const std::vector<Point2D>& GetPoints() const noexcept
@@ -203,14 +216,14 @@ namespace Wisteria::GraphItems
         /// @param dc Measurement DC, which is not used in this implementation.
         [[nodiscard]] wxRect GetBoundingBox([[maybe_unused]] wxDC& dc) const final
             {
+            // fixed points are already at the collection's scaling when they are added
+            if (!IsFreeFloating())
+                { return m_boundingBox; }
             wxRect boundingBox(m_boundingBox.GetTopLeft(),
                                 wxSize(m_boundingBox.GetWidth()*GetScaling(),
                                 m_boundingBox.GetHeight()*GetScaling()));
-            if (IsFreeFloating())
-                {
-                boundingBox.Offset((boundingBox.GetLeftTop()*GetScaling()) -
-                                    boundingBox.GetLeftTop());
-                }
+            boundingBox.Offset((boundingBox.GetLeftTop()*GetScaling()) -
+                                boundingBox.GetLeftTop());
             return boundingBox;
             }
         /** @brief Moves the points by the specified x and y values.
@@ -221,6 +234,7 @@ namespace Wisteria::GraphItems
             for (auto& point : m_points)
                 { point.Offset(xToMove,yToMove); }
             m_boundingBox.Offset(wxPoint(xToMove, yToMove));
+            m_hitTestGrid.Clear();
             }
         /** @returns `true` if the given point is inside any of the points in this collection.
             @param pt The point to check.*/
@@ -228,6 +242,8 @@ namespace Wisteria::GraphItems
         std::vector<Point2D> m_points;
         mutable std::vector<Point2D>::size_type m_lastHitPointIndex
             { static_cast<std::vector<Point2D>::size_type>(-1) };
+        // index of the points' bounding boxes, built on the first hit test after a layout
+        mutable SpatialGrid m_hitTestGrid;
         /* Note that we don't use the base class's cached bounding box logic because
             GetBoundingBox() doesn't calculate anything. Instead, we manage a bounding box
             internally whenever a point is added.*/
@@ -237,6 +253,214 @@ namespace Wisteria::GraphItems
 
         long m_currentAssignedId{ 0 };
         };
+
+    /** @brief A large collection of points, stored compactly and drawn in batches.
+        @details Unlike Points2D (where every point is a full Point2D object with its own pen,
+            brush, label, and selection state), this stores the points as parallel arrays
+            of coordinates and indices into small tables of colors and shapes.
+            When drawing, all the points sharing a color and shape are drawn together
+            (as a single graphics path if the DC is using a graphics context).
+
+            This is meant for plots with many thousands of points (e.g., a LinePlot with a
+            long time series), where Points2D would be slow to build and draw.
+        @note The points all share the same radius and outline pen.\n
+            Selection and IDs work the same way as Points2D; a point's ID is the order it was
+            added in, and selected points are tracked through GetSelectedIds().\n
+            Shapes that cannot be drawn in a batch (e.g., images and road signs) are supported,
+            but are drawn one at a time.*/
+    class PointCloud final : public GraphItemBase
+        {
+        friend class Graphs::Graph2D;
+        friend class Wisteria::Canvas;
+    public:
+        /** @brief Constructor.
+            @param pen The pen to draw the line connecting the points.
+                Set to @c wxNullPen to not connect the points.*/
+        explicit PointCloud(const wxPen& pen)
+            { GetPen() = pen; }
+        /// @brief Reserves memory for a specified number of points.
+        /// @param size The number of points to reserve space for.
+        void Reserve(const size_t size);
+        /** @brief Adds a point to the collection.
+            @param pt The center of the point. Pass in a point with @c wxDefaultCoord
+                values to add a missing point (i.e., a gap in the connecting line).
+            @param color The point's color.
+            @param shape The point's shape.
+            @param label The label to show when the point is selected.
+            @param img An image to use for the point if @c shape is IconShape::ImageIcon.*/
+        void AddPoint(const wxPoint pt, const wxColour& color,
+                      const IconShape shape = IconShape::CircleIcon,
+                      const wxString& label = wxString{},
+                      const wxBitmapBundle* img = nullptr);
+        /// @returns The number of points (including missing points) in the collection.
+        [[nodiscard]] size_t GetPointCount() const noexcept
+            { return m_coordinates.size(); }
+        /// @returns The center of a point (which will have @c wxDefaultCoord values if missing).
+        /// @param index The point's index (i.e., its ID).
+        [[nodiscard]] wxPoint GetPoint(const size_t index) const
+            { return m_coordinates.at(index); }
+        /// @returns The color of a point.
+        /// @param index The point's index (i.e., its ID).
+        [[nodiscard]] const wxColour& GetPointColor(const size_t index) const
+            { return m_colors.at(m_colorIndices.at(index)); }
+        /// @returns The shape of a point.
+        /// @param index The point's index (i.e., its ID).
+        [[nodiscard]] IconShape GetPointShape(const size_t index) const
+            { return m_shapes.at(m_shapeIndices.at(index)).first; }
+
+        /// @returns The radius of the points.
+        /// @warning This needs to be scaled when called for measuring and rendering.
+        [[nodiscard]] size_t GetRadius() const noexcept
+            { return m_radius; }
+        /** @brief Sets the radius of the points.
+            @param radius The radius of the points. This is a DIP value that the framework will
+                scale to the screen for you.
+            @note This should be set before adding points, as the bounding box of the
+                collection is calculated as points are added.*/
+        void SetRadius(const size_t radius) noexcept
+            { m_radius = radius; }
+        /// @returns The pen that the points' outlines are drawn with.
+        [[nodiscard]] wxPen& GetPointPen() noexcept
+            { return m_pointPen; }
+        /** @brief Sets whether selecting the points collection will select the
+                individual point that was clicked on or all the points.
+            @param singlePointSelect Whether to select the last hit point.*/
+        void SetSinglePointSelection(const bool singlePointSelect) noexcept
+            { m_singlePointSelection = singlePointSelect; }
+        /// @returns How the segments between the points on a line are connected.
+        [[nodiscard]] LineStyle GetLineStyle() const noexcept
+            { return m_lineStyle; }
+        /// @brief How the segments between the points on a line are connected.
+        /// @param lineStyle The line style.
+        void SetLineStyle(const LineStyle lineStyle) noexcept
+            { m_lineStyle = lineStyle; }
+        /** @brief Sets whether the points should be bound to a plot's coordinate system
+                or float on the canvas.
+            @param freeFloat Whether the points should be free floating.*/
+        void SetFreeFloating(const bool freeFloat) final
+            {
+            GraphItemBase::SetFreeFloating(freeFloat);
+            m_hitTestGrid.Clear();
+            }
+        /** @brief Sets the scaling of the points.
+            @param scaling The scaling to use.*/
+        void SetScaling(const double scaling) final
+            {
+            GraphItemBase::SetScaling(scaling);
+            m_hitTestGrid.Clear();
+            }
+        /// @brief Sets the DPI scale factor.
+        /// @param scaling The DPI scaling.
+        void SetDPIScaleFactor(const double scaling) noexcept final
+            {
+            GraphItemBase::SetDPIScaleFactor(scaling);
+            m_hitTestGrid.Clear();
+            }
+    private:
+        /// @brief A color and shape (i.e., indices into the color and shape tables)
+        ///     that a batch of points are drawn with.
+        using PointStyle = std::pair<uint32_t, uint8_t>;
+
+        /** @brief Sets whether the points are selected.
+            @param selected Whether the last hit point
+                (or all points if there was no previous hit) should be selected.*/
+        void SetSelected(const bool selected) final;
+        /// @returns @c true if a point is selected.
+        /// @param index The point's index.
+        [[nodiscard]] bool IsPointSelected(const size_t index) const
+            {
+            return IsSelected() &&
+                (!m_singlePointSelection ||
+                 GetSelectedIds().find(static_cast<long>(index)) != GetSelectedIds().cend());
+            }
+        /** @brief Draws the selected points' labels.
+            @param dc The DC to render with.
+            @param scaling The scaling to draw the text with.
+            @param boundingBox The bounding box to constrain the label inside of.
+                Default is an empty rect, which will cause this parameter to be ignored.*/
+        void DrawSelectionLabel(wxDC& dc, const double scaling,
+                                const wxRect boundingBox = wxRect()) const final;
+        /** @warning Should not be called. Points should be explicitly set at
+                specific coordinates, and cannot be scaled to fit in an arbitrary bounding box.
+            @param rect This parameter is ignored.
+            @param parentScaling This parameter is ignored.*/
+        [[deprecated("Not implemented")]]
+        void SetBoundingBox([[maybe_unused]] const wxRect& rect,
+                            [[maybe_unused]] wxDC& dc,
+                            [[maybe_unused]] const double parentScaling) final
+            { wxFAIL_MSG(L"SetBoundingBox() not supported for PointCloud objects."
+                            "Points should be explicitly set at specific coordinates, "
+                            "and cannot be scaled to fit in an arbitrary bounding box."); }
+        /** @brief Draws the connecting line and the points.
+            @param dc The device context to draw to.
+            @returns The area that the points are being drawn in.*/
+        wxRect Draw(wxDC& dc) const final;
+        /// @brief Draws the line connecting the points.
+        void DrawConnectionLine(wxDC& dc) const;
+        /** @brief Draws a batch of points with the same color and shape.
+            @param dc The DC to draw with.
+            @param style The color and shape of the points.
+            @param indices The points to draw.
+            @returns @c false if the shape can't be drawn in a batch.*/
+        bool DrawBatch(wxDC& dc, const PointStyle style, const std::vector<size_t>& indices) const;
+        /** @brief Draws a single point (with its own Point2D).
+            @param dc The DC to draw with.
+            @param index The point to draw.
+            @param pen The (unscaled) outline pen to draw with.*/
+        void DrawSinglePoint(wxDC& dc, const size_t index, const wxPen& pen) const;
+        /// @returns The rectangle on the canvas where the points would fit in.
+        /// @param dc Measurement DC, which is not used in this implementation.
+        [[nodiscard]] wxRect GetBoundingBox([[maybe_unused]] wxDC& dc) const final;
+        /// @returns The rectangle on the canvas where a point would fit in.
+        [[nodiscard]] wxRect GetPointBoundingBox(const size_t index) const;
+        /// @returns @c true if a shape is drawn above its point (like a sign on a post).
+        [[nodiscard]] static bool IsTallShape(const IconShape shape) noexcept
+            {
+            return (shape == IconShape::LocationMarker ||
+                    shape == IconShape::GoRoadSign ||
+                    shape == IconShape::WarningRoadSign);
+            }
+        /// @returns The center of a point on the canvas.
+        [[nodiscard]] wxPoint GetScreenPoint(const size_t index) const
+            {
+            return IsFreeFloating() ?
+                wxPoint(m_coordinates[index].x * GetScaling(),
+                        m_coordinates[index].y * GetScaling()) :
+                m_coordinates[index];
+            }
+        /** @brief Moves the points by the specified x and y values.
+            @param xToMove The amount to move horizontally.
+            @param yToMove The amount to move vertically.*/
+        void Offset(const int xToMove, const int yToMove) final;
+        /** @returns `true` if the given point is inside any of the points in this collection.
+            @param pt The point to check.*/
+        [[nodiscard]] bool HitTest(const wxPoint pt, wxDC& dc) const final;
+
+        // the points, stored as parallel arrays
+        std::vector<wxPoint> m_coordinates;
+        std::vector<uint32_t> m_colorIndices;
+        std::vector<uint8_t> m_shapeIndices;
+        // labels are only stored if a point has one,
+        // so this may be shorter than the other arrays
+        std::vector<wxString> m_labels;
+        // the tables of colors and shapes that the points use
+        std::vector<wxColour> m_colors;
+        std::unordered_map<wxUint32, uint32_t> m_colorLookup;
+        std::vector<std::pair<IconShape, const wxBitmapBundle*>> m_shapes;
+
+        mutable size_t m_lastHitPointIndex{ static_cast<size_t>(-1) };
+        // index of the points' bounding boxes, built on the first hit test after a layout
+        mutable SpatialGrid m_hitTestGrid;
+        // the range of the (valid) points' centers, unscaled
+        wxPoint m_minPoint;
+        wxPoint m_maxPoint;
+        bool m_hasValidPoints{ false };
+        bool m_hasTallShapes{ false };
+        size_t m_radius{ 4 };
+        wxPen m_pointPen{ *wxBLACK_PEN };
+        bool m_singlePointSelection{ true };
+        LineStyle m_lineStyle{ LineStyle::Lines };
+        };
     };
 
 /** @}*/
@@ -22,6 +22,8 @@ namespace Wisteria::GraphItems
             {
             m_points.clear();
             m_scaledPoints.clear();
+            m_boundingBox = wxRect();
+            m_isAxisAlignedRect = false;
             }
         }
 
@@ -167,19 +169,45 @@ namespace Wisteria::GraphItems
         return wxRect(wxPoint(minX,minY), wxPoint(maxX,maxY));
         }
 
+    //-------------------------------------------
+    bool Polygon::IsAxisAlignedRectangle(const std::vector<wxPoint>& polygon)
+        {
+        if (polygon.size() != 4)
+            { return false; }
+        // the sides must alternate between horizontal and vertical,
+        // starting with either
+        const auto isHorizontal = [&polygon](const size_t side)
+            { return polygon[side].y == polygon[(side + 1) % 4].y; };
+        const auto isVertical = [&polygon](const size_t side)
+            { return polygon[side].x == polygon[(side + 1) % 4].x; };
+        return (isHorizontal(0) && isVertical(1) && isHorizontal(2) && isVertical(3)) ||
+               (isVertical(0) && isHorizontal(1) && isVertical(2) && isHorizontal(3));
+        }
+
     //-------------------------------------------
     void Polygon::UpdatePointPositions()
         {
         m_scaledPoints = GetPoints();
-        if (!IsFreeFloating())
-            { return; }
-        for (auto ptPos = m_scaledPoints.begin(); ptPos != m_scaledPoints.end(); ++ptPos)
-            { *ptPos = (*ptPos*GetScaling()); } // grow
+        if (IsFreeFloating())
+            {
+            for (auto ptPos = m_scaledPoints.begin(); ptPos != m_scaledPoints.end(); ++ptPos)
+                { *ptPos = (*ptPos*GetScaling()); } // grow
+            }
+        m_boundingBox = m_scaledPoints.empty() ? wxRect() :
+            GetPolygonBoundingBox(&m_scaledPoints[0], m_scaledPoints.size());
+        m_isAxisAlignedRect = IsAxisAlignedRectangle(m_scaledPoints);
         }
 
     //-------------------------------------------
     bool Polygon::HitTest(const wxPoint pt, [[maybe_unused]] wxDC& dc) const
-        { return IsInsidePolygon(pt, &m_scaledPoints[0], m_scaledPoints.size()); }
+        {
+        // quick rejection, which is all that most of a graph's polygons will need
+        if (m_scaledPoints.empty() || !m_boundingBox.Contains(pt))
+            { return false; }
+        if (m_isAxisAlignedRect)
+            { return true; }
+        return IsInsidePolygon(pt, &m_scaledPoints[0], m_scaledPoints.size());
+        }
 
     //-------------------------------------------
     void Polygon::GetRectPoints(const wxRect& rect, wxPoint* points)
@@ -393,6 +421,8 @@ namespace Wisteria::GraphItems
         {
         for (auto pos = m_points.begin(); pos != m_points.end(); ++pos)
             { *pos += wxPoint(xToMove, yToMove); }
+        // keep the drawn points (and their bounds) in sync
+        UpdatePointPositions();
         }
 
     //-------------------------------------------
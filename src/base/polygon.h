@@ -194,7 +194,7 @@ namespace Wisteria::GraphItems
         /// @returns The rectangle on the canvas where the point would fit in.
         /// @param dc Measurement DC, which is not used in this implementation.
         [[nodiscard]] wxRect GetBoundingBox([[maybe_unused]] wxDC& dc) const final
-            { return GetPolygonBoundingBox(&m_scaledPoints[0], m_scaledPoints.size()); }
+            { return m_boundingBox; }
         /** @brief Moves the polygon by the specified x and y values.
             @param xToMove The amount to move horizontally.
             @param yToMove The amount to move vertically.*/
@@ -210,10 +210,20 @@ namespace Wisteria::GraphItems
             @param points The four points to construct the rectangle.
             @warning It is assumed that there are four elements in @c points.*/
         [[nodiscard]] static wxRect GetRectFromPoints(const wxPoint* points);
+        /** @returns @c true if the points are the four corners of a rectangle
+                whose sides are horizontal and vertical.
+            @param polygon The polygon's points.*/
+        [[nodiscard]] static bool IsAxisAlignedRectangle(const std::vector<wxPoint>& polygon);
         void UpdatePointPositions();
         std::vector<wxPoint> m_points;
         // secondary cache used for actual (i.e., scaled) bounding box
         std::vector<wxPoint> m_scaledPoints;
+        // the bounds of the scaled points, so that hit tests can reject points
+        // outside of them without walking the edges
+        wxRect m_boundingBox;
+        // if the scaled points are an upright rectangle, then the bounding box
+        // is the polygon, and hit tests don't need to walk the edges at all
+        bool m_isAxisAlignedRect{ false };
         Colors::GradientFill m_backgroundFill;
         BoxCorners m_boxCorners{ BoxCorners::Straight };
         PolygonShape m_polygonShape{ PolygonShape::Irregular };
@@ -14,6 +14,8 @@
 
 #include "colorbrewer.h"
 #include <wx/numformatter.h>
+#include <atomic>
+#include <memory>
 
 namespace Wisteria
     {
@@ -38,20 +40,124 @@ namespace Wisteria
                                                   can easily be enabled/disabled globally.*/
         };
 
+    /** @brief A snapshot of the library settings, used to render a canvas with
+         settings different from the global ones.
+        @details Call Settings::GetRenderSettings() to capture the current settings,
+         change what should be different, and then pass it to
+         Canvas::SetRenderSettings() (as a @c const shared pointer, so that it can't
+         change while it is being rendered).\n
+         A default-constructed RenderSettings has the library's default values
+         (which are also what the global settings start with), not the current global values.
+        @par Example
+        @code
+            auto settings = Settings::GetRenderSettings();
+            settings.m_pointRadius = 6;
+            settings.m_debugSettings = DebugSettings::None;
+            canvas->SetRenderSettings(std::make_shared<const RenderSettings>(settings));
+        @endcode*/
+    struct RenderSettings
+        {
+        /// @brief The default point radius.
+        size_t m_pointRadius{ 4 };
+        /// @brief The opacity value to use when making a color translucent.
+        uint8_t m_translucencyValue{ 100 };
+        /// @brief The maximum number of items that can be displayed in a legend.
+        uint8_t m_maxLegendItems{ 20 };
+        /// @brief The maximum text length for legend labels.
+        size_t m_maxLegendTextLength{ 32 };
+        /// @brief The radius of rounded corners.
+        double m_roundedCornerRadius{ 5 };
+        /// @brief The maximum number of observations to show as a label in a bin.
+        size_t m_maxObservationsInBin{ 25 };
+        /// @brief The DebugSettings flags.
+        /// @details DebugSettings::DrawBoundingBoxesOnSelection is enabled by default
+        ///  if @c wxDEBUG_LEVEL is set to 2; otherwise, all flags are disabled.
+        int m_debugSettings
+#if wxDEBUG_LEVEL >= 2
+        { DebugSettings::DrawBoundingBoxesOnSelection };
+#else
+        { DebugSettings::None };
+#endif
+        /// @brief The @c wxNumberFormatter::Style flags to format numbers with.
+        int m_numberFormat{ wxNumberFormatter::Style::Style_WithThousandsSep|
+                            wxNumberFormatter::Style::Style_NoTrailingZeroes };
+        };
+
     /// @brief Class for managing global library settings.
+    /// @details While a canvas is being laid out or drawn, these return the values from
+    ///  its RenderSettings (if it has any; see Canvas::SetRenderSettings()) instead of
+    ///  the global values. This lets canvases with different settings be rendered
+    ///  one after another without changing the global values in between.
+    /// @note These settings can be read from any thread. However, changing a global
+    ///  setting while canvases (without their own RenderSettings) are being rendered
+    ///  will affect those renders.
     class Settings
         {
     public:
+        /** @brief Makes the settings on the current thread come from a snapshot
+             (instead of the global values) until the scope ends.
+            @details This is what Canvas uses while laying out and drawing; client code
+             only needs this for graph code called outside of a canvas's rendering
+             (e.g., creating a legend for a graph).*/
+        class RenderScope
+            {
+        public:
+            /// @brief Constructor.
+            /// @param settings The settings to use. If null, then the current settings
+            ///  (global, or from an enclosing scope) remain in effect.
+            explicit RenderScope(std::shared_ptr<const RenderSettings> settings) noexcept :
+                m_settings(std::move(settings)), m_previousSettings(m_currentRenderSettings)
+                {
+                if (m_settings != nullptr)
+                    { m_currentRenderSettings = m_settings.get(); }
+                }
+            /// @private
+            RenderScope(const RenderScope&) = delete;
+            /// @private
+            RenderScope& operator=(const RenderScope&) = delete;
+            /// @private
+            ~RenderScope()
+                { m_currentRenderSettings = m_previousSettings; }
+        private:
+            std::shared_ptr<const RenderSettings> m_settings;
+            const RenderSettings* m_previousSettings{ nullptr };
+            };
+
+        /// @returns A snapshot of the settings currently in effect on this thread.
+        [[nodiscard]] static RenderSettings GetRenderSettings()
+            {
+            if (m_currentRenderSettings != nullptr)
+                { return *m_currentRenderSettings; }
+            RenderSettings settings;
+            settings.m_pointRadius = m_pointRadius.load(std::memory_order_relaxed);
+            settings.m_translucencyValue = m_translucencyValue.load(std::memory_order_relaxed);
+            settings.m_maxLegendItems = m_maxLegendItems.load(std::memory_order_relaxed);
+            settings.m_maxLegendTextLength = m_maxLegendTextLength.load(std::memory_order_relaxed);
+            settings.m_roundedCornerRadius = m_roundedCornerRadius.load(std::memory_order_relaxed);
+            settings.m_maxObservationsInBin = m_maxObservationsInBin.load(std::memory_order_relaxed);
+            settings.m_debugSettings = m_debugSettings.load(std::memory_order_relaxed);
+            settings.m_numberFormat = m_numberFormat.load(std::memory_order_relaxed);
+            return settings;
+            }
+
         /// @returns The default point radius.
         [[nodiscard]] static size_t GetPointRadius() noexcept
-            { return m_pointRadius; }
+            {
+            return (m_currentRenderSettings != nullptr) ?
+                m_currentRenderSettings->m_pointRadius :
+                m_pointRadius.load(std::memory_order_relaxed);
+            }
         /// @brief Sets the default point radius.
         /// @param radius The default point radius.
-        void SetPointRadius(const size_t radius) noexcept
+        static void SetPointRadius(const size_t radius) noexcept
             { m_pointRadius = radius; }
         /// @returns The opacity value to use when making a color translucent.
         [[nodiscard]] static uint8_t GetTranslucencyValue() noexcept
-            { return m_translucencyValue; }
+            {
+            return (m_currentRenderSettings != nullptr) ?
+                m_currentRenderSettings->m_translucencyValue :
+                m_translucencyValue.load(std::memory_order_relaxed);
+            }
         /// @brief Sets the opacity value to use when making a color translucent.
         ///  Default is 100;
         /// @param value The opacity level (should be between 0 [transparent] to 255 [opaque]).
@@ -60,7 +166,11 @@ namespace Wisteria
         /// @brief Gets the maximum number of items that can be displayed in a legend.
         /// @returns The maximum number of items that can be displayed in a legend.
         [[nodiscard]] static uint8_t GetMaxLegendItemCount() noexcept
-            { return m_maxLegendItems; }
+            {
+            return (m_currentRenderSettings != nullptr) ?
+                m_currentRenderSettings->m_maxLegendItems :
+                m_maxLegendItems.load(std::memory_order_relaxed);
+            }
         /// @brief Sets the maximum number of items that can be displayed in a legend.
         /// @details If there are more items in the legend, then an ellipsis will be shown.
         ///  The default number of items is 20.
@@ -70,12 +180,20 @@ namespace Wisteria
         /// @brief Gets the maximum text length for legend labels.
         /// @returns The maximum text length.
         [[nodiscard]] static size_t GetMaxLegendTextLength() noexcept
-            { return m_maxLegendTextLength; }
+            {
+            return (m_currentRenderSettings != nullptr) ?
+                m_currentRenderSettings->m_maxLegendTextLength :
+                m_maxLegendTextLength.load(std::memory_order_relaxed);
+            }
 
         /// @brief Gets the maximum number of observations to show as a label in a bin.
         /// @returns The maximum number of observations to show in a bin label.
         [[nodiscard]] static size_t GetMaxObservationInBin() noexcept
-            { return m_maxObservationsInBin; }
+            {
+            return (m_currentRenderSettings != nullptr) ?
+                m_currentRenderSettings->m_maxObservationsInBin :
+                m_maxObservationsInBin.load(std::memory_order_relaxed);
+            }
  
         /// @brief Sets the radius of the rounded corner, which is used when using rounded
         ///  corners for labels, box plots, etc.
@@ -85,7 +203,11 @@ namespace Wisteria
         /// @returns The radius of the rounded corner, which is used when using rounded
         ///  corners for labels, box plots, etc.
         [[nodiscard]] static double GetBoxRoundedCornerRadius() noexcept
-            { return m_roundedCornerRadius; }
+            {
+            return (m_currentRenderSettings != nullptr) ?
+                m_currentRenderSettings->m_roundedCornerRadius :
+                m_roundedCornerRadius.load(std::memory_order_relaxed);
+            }
         /// @brief Sets the maximum text length for legend labels.
         /// @details The default length is 32.
         /// @details If a label is longer than this,
@@ -124,31 +246,42 @@ namespace Wisteria
         /// @param flag The flag to check for.
         /// @returns `true` if the given flag is enabled.
         [[nodiscard]] static bool IsDebugFlagEnabled(const int flag) noexcept
-            { return (m_debugSettings & flag) == flag; }
-        /// @returns No trailing zeroes and thousands separator format
-        ///  for calls to @c wxNumberFormatter::ToString().
-        [[nodiscard]] static auto GetDefaultNumberFormat() noexcept
             {
-            return wxNumberFormatter::Style::Style_WithThousandsSep|
-                   wxNumberFormatter::Style::Style_NoTrailingZeroes;
+            const int debugSettings = (m_currentRenderSettings != nullptr) ?
+                m_currentRenderSettings->m_debugSettings :
+                m_debugSettings.load(std::memory_order_relaxed);
+            return (debugSettings & flag) == flag;
+            }
+        /// @returns The format for calls to @c wxNumberFormatter::ToString().\n
+        ///  The default is no trailing zeroes and thousands separators.
+        [[nodiscard]] static int GetDefaultNumberFormat() noexcept
+            {
+            return (m_currentRenderSettings != nullptr) ?
+                m_currentRenderSettings->m_numberFormat :
+                m_numberFormat.load(std::memory_order_relaxed);
             }
+        /// @brief Sets the format for calls to @c wxNumberFormatter::ToString().
+        /// @param format The @c wxNumberFormatter::Style flags to use.
+        static void SetDefaultNumberFormat(const int format) noexcept
+            { m_numberFormat = format; }
         /// @returns The default color scheme to use for groups with the graphs.
+        /// @note Graphs use this when they are constructed (unless a scheme is passed
+        ///  to their constructors), so it isn't part of RenderSettings.
         [[nodiscard]] static std::shared_ptr<Colors::Schemes::ColorScheme> GetDefaultColorScheme()
             { return std::make_shared<Colors::Schemes::ColorScheme>(Colors::Schemes::Dusk()); }
     private:
-        inline static uint8_t m_translucencyValue{ 100 };
-        inline static uint8_t m_maxLegendItems{ 20 };
-        inline static size_t m_maxLegendTextLength{ 32 };
-        inline static size_t m_pointRadius{ 4 };
-        inline static double m_roundedCornerRadius{ 5 };
-        inline static size_t m_maxObservationsInBin{ 25 };
-        inline static int m_debugSettings
-#if wxDEBUG_LEVEL >= 2
-        { DebugSettings::DrawBoundingBoxesOnSelection };
-#else
-        { DebugSettings::None };
-#endif
-        std::shared_ptr<Colors::Schemes::ColorScheme> m_defaultColorScheme;
+        // the defaults come from RenderSettings, so that the two can't drift apart
+        static constexpr RenderSettings m_defaults{};
+        inline static std::atomic<uint8_t> m_translucencyValue{ m_defaults.m_translucencyValue };
+        inline static std::atomic<uint8_t> m_maxLegendItems{ m_defaults.m_maxLegendItems };
+        inline static std::atomic<size_t> m_maxLegendTextLength{ m_defaults.m_maxLegendTextLength };
+        inline static std::atomic<size_t> m_pointRadius{ m_defaults.m_pointRadius };
+        inline static std::atomic<double> m_roundedCornerRadius{ m_defaults.m_roundedCornerRadius };
+        inline static std::atomic<size_t> m_maxObservationsInBin{ m_defaults.m_maxObservationsInBin };
+        inline static std::atomic<int> m_numberFormat{ m_defaults.m_numberFormat };
+        inline static std::atomic<int> m_debugSettings{ m_defaults.m_debugSettings };
+        // the settings of the canvas being rendered on this thread (if it has its own)
+        inline static thread_local const RenderSettings* m_currentRenderSettings{ nullptr };
         };
     }
 
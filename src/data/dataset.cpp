@@ -7,6 +7,8 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "dataset.h"
+#include "../util/memorymappedfile.h"
+#include <cwctype>
 
 namespace Wisteria::Data
     {
@@ -47,6 +49,150 @@ namespace Wisteria::Data
         return reMap;
         }
 
+    //----------------------------------------------
+    std::optional<int64_t> IdentifierColumn::ToIntegerId(const wxString& val)
+        {
+        wxLongLong_t intValue{ 0 };
+        if (val.empty() || !val.ToLongLong(&intValue) ||
+            intValue == m_emptyIntegerId)
+            { return std::nullopt; }
+        // make sure that the string can be rebuilt from the integer
+        // (i.e., it doesn't have leading zeros, a plus sign, or whitespace)
+        if (std::to_wstring(static_cast<int64_t>(intValue)) != val.wc_str())
+            { return std::nullopt; }
+        return static_cast<int64_t>(intValue);
+        }
+
+    //----------------------------------------------
+    void IdentifierColumn::AddUtf8Value(const wxString& val)
+        {
+        if (m_utf8Offsets.empty())
+            { m_utf8Offsets.push_back(0); }
+        const wxScopedCharBuffer utf8Value = val.ToUTF8();
+        m_utf8Ids.append(utf8Value.data(), utf8Value.length());
+        m_utf8Offsets.push_back(m_utf8Ids.length());
+        }
+
+    //----------------------------------------------
+    void IdentifierColumn::ConvertIntegersToUtf8()
+        {
+        wxASSERT_MSG(m_storage == Storage::Integers,
+                     L"ID column must be stored as integers in call to ConvertIntegersToUtf8()!");
+        m_utf8Ids.clear();
+        m_utf8Offsets.clear();
+        m_utf8Offsets.reserve(m_integerIds.size() + 1);
+        m_utf8Offsets.push_back(0);
+        for (const auto intValue : m_integerIds)
+            {
+            if (intValue != m_emptyIntegerId)
+                { m_utf8Ids.append(std::to_string(intValue)); }
+            m_utf8Offsets.push_back(m_utf8Ids.length());
+            }
+        std::vector<int64_t>().swap(m_integerIds);
+        m_storage = Storage::Utf8;
+        }
+
+    //----------------------------------------------
+    void IdentifierColumn::Compact()
+        {
+        if (IsCompact())
+            { return; }
+
+        // see if the IDs are all integers
+        std::vector<int64_t> integerIds;
+        integerIds.reserve(m_data.size());
+        for (const auto& id : m_data)
+            {
+            if (id.empty())
+                { integerIds.push_back(m_emptyIntegerId); }
+            else if (const auto intValue = ToIntegerId(id); intValue)
+                { integerIds.push_back(intValue.value()); }
+            else
+                { break; }
+            }
+
+        if (integerIds.size() == m_data.size())
+            {
+            m_integerIds = std::move(integerIds);
+            m_storage = Storage::Integers;
+            }
+        else
+            {
+            // otherwise, pack them as UTF-8
+            std::vector<int64_t>().swap(integerIds);
+            m_utf8Ids.clear();
+            m_utf8Offsets.clear();
+            m_utf8Offsets.reserve(m_data.size() + 1);
+            for (const auto& id : m_data)
+                { AddUtf8Value(id); }
+            if (m_utf8Offsets.empty())
+                { m_utf8Offsets.push_back(0); }
+            m_utf8Ids.shrink_to_fit();
+            m_storage = Storage::Utf8;
+            }
+        // release the strings
+        std::vector<wxString>().swap(m_data);
+        }
+
+    //----------------------------------------------
+    void IdentifierColumn::Expand()
+        {
+        if (!IsCompact())
+            { return; }
+
+        std::vector<wxString> ids;
+        ids.reserve(GetRowCount());
+        for (size_t i = 0; i < GetRowCount(); ++i)
+            { ids.push_back(GetValue(i)); }
+
+        std::vector<int64_t>().swap(m_integerIds);
+        std::string().swap(m_utf8Ids);
+        std::vector<size_t>().swap(m_utf8Offsets);
+        m_data = std::move(ids);
+        m_storage = Storage::Strings;
+        }
+
+    //----------------------------------------------
+    void IdentifierColumn::Reserve(const size_t rowCount)
+        {
+        switch (m_storage)
+            {
+        case Storage::Integers:
+            m_integerIds.reserve(rowCount);
+            break;
+        case Storage::Utf8:
+            m_utf8Offsets.reserve(rowCount + 1);
+            break;
+        default:
+            m_data.reserve(rowCount);
+            }
+        }
+
+    //----------------------------------------------
+    void IdentifierColumn::AddValue(const wxString& val)
+        {
+        if (m_storage == Storage::Integers)
+            {
+            if (val.empty())
+                {
+                m_integerIds.push_back(m_emptyIntegerId);
+                return;
+                }
+            else if (const auto intValue = ToIntegerId(val); intValue)
+                {
+                m_integerIds.push_back(intValue.value());
+                return;
+                }
+            // not an integer, so switch to UTF-8 storage and add it below
+            ConvertIntegersToUtf8();
+            }
+
+        if (m_storage == Storage::Utf8)
+            { AddUtf8Value(val); }
+        else
+            { m_data.push_back(val); }
+        }
+
     //----------------------------------------------
     double Dataset::ConvertToDouble(const wxString& input)
         {
@@ -69,6 +215,12 @@ namespace Wisteria::Data
             { return mdCode; }
         else
             {
+            // codes are unsigned, so reject negative values
+            // (wcstoull would otherwise wrap them around to huge codes)
+            const auto firstChar = std::find_if_not(input.cbegin(), input.cend(),
+                [](const auto ch) { return std::iswspace(static_cast<wint_t>(ch)); });
+            if (firstChar != input.cend() && *firstChar == L'-')
+                { return 0; }
             wchar_t* end{ nullptr };
             GroupIdType value = std::wcstoull(input.c_str(), &end, 10);
             return (input.c_str() == end) ? 0 : value;
@@ -87,6 +239,8 @@ namespace Wisteria::Data
         wxString::const_iterator end;
         switch (method)
             {
+        case DateImportMethod::DetectFormat:
+            [[fallthrough]];
         case DateImportMethod::Automatic:
             // try reading as date & time, and fall back to just date if that fails
             if (!dt.ParseDateTime(input, &end))
@@ -110,6 +264,351 @@ namespace Wisteria::Data
         return dt;
         }
 
+    //----------------------------------------------
+    double Dataset::ConvertToDoubleFast(const wxString& input, const wchar_t decimalSeparator)
+        {
+        if (input.empty())
+            { return std::numeric_limits<double>::quiet_NaN(); }
+        // numbers are only made up of ASCII characters, so narrow the text into a
+        // buffer on the stack (anything longer than this isn't a reasonable number)
+        std::array<char, 64> buffer{ 0 };
+        if (input.length() > buffer.size())
+            { return std::numeric_limits<double>::quiet_NaN(); }
+        const wchar_t* text = input.wc_str();
+        for (size_t i = 0; i < input.length(); ++i)
+            {
+            if (text[i] == decimalSeparator)
+                { buffer[i] = '.'; }
+            else if (text[i] > 0x7F || text[i] == L'.')
+                { return std::numeric_limits<double>::quiet_NaN(); }
+            else
+                { buffer[i] = static_cast<char>(text[i]); }
+            }
+        return ConvertUtf8ToDouble(std::string_view(buffer.data(), input.length()));
+        }
+
+    //----------------------------------------------
+    double Dataset::ConvertUtf8ToDouble(const std::string_view input,
+                                        const wchar_t decimalSeparator /*= L'.'*/)
+        {
+        if (input.empty())
+            { return std::numeric_limits<double>::quiet_NaN(); }
+        if (decimalSeparator != L'.')
+            {
+            if (input.length() > 64 || decimalSeparator > 0x7F)
+                { return std::numeric_limits<double>::quiet_NaN(); }
+            std::array<char, 64> buffer{ 0 };
+            for (size_t i = 0; i < input.length(); ++i)
+                {
+                if (input[i] == static_cast<char>(decimalSeparator))
+                    { buffer[i] = '.'; }
+                else if (input[i] == '.')
+                    { return std::numeric_limits<double>::quiet_NaN(); }
+                else
+                    { buffer[i] = input[i]; }
+                }
+            return ConvertUtf8ToDouble(std::string_view(buffer.data(), input.length()));
+            }
+        // from_chars doesn't accept a leading plus sign, but ToCDouble() does
+        const char* start = (input.front() == '+') ? input.data() + 1 : input.data();
+        const char* end = input.data() + input.length();
+        double val{ 0 };
+        const auto [ptr, ec] = std::from_chars(start, end, val);
+        return (ec == std::errc() && ptr == end) ?
+            val : std::numeric_limits<double>::quiet_NaN();
+        }
+
+    //----------------------------------------------
+    GroupIdType Dataset::ConvertUtf8ToGroupId(const std::string_view input, const GroupIdType mdCode)
+        {
+        if (input.empty())
+            { return mdCode; }
+        // codes are unsigned, so negative values are rejected (the same as the text path)
+        if (input.front() == '-')
+            { return 0; }
+        const char* start = (input.front() == '+') ? input.data() + 1 : input.data();
+        GroupIdType value{ 0 };
+        const auto [ptr, ec] = std::from_chars(start, input.data() + input.length(), value);
+        return (ec == std::errc()) ? value : 0;
+        }
+
+    //----------------------------------------------
+    wxString Dataset::ConvertUtf8ToString(const std::string_view input)
+        {
+        if (input.empty())
+            { return wxString(); }
+        // collapse escaped (i.e., doubled up) quotes
+        const auto convert = [](const char* text, const size_t length)
+            {
+            auto str = wxString::FromUTF8(text, length);
+            // not valid UTF-8, so fall back to Latin-1 (the same as what wxConvAuto does)
+            if (str.empty())
+                { str = wxString(text, wxConvISO8859_1, length); }
+            return str;
+            };
+        if (input.find("\"\"") == std::string_view::npos)
+            { return convert(input.data(), input.length()); }
+        std::string collapsedText{ input };
+        size_t start{ 0 };
+        while ((start = collapsedText.find("\"\"", start)) != std::string::npos)
+            { collapsedText.erase(start++, 1); }
+        return convert(collapsedText.c_str(), collapsedText.length());
+        }
+
+    //----------------------------------------------
+    void Dataset::ApplyReplacementStrings(wxString& str, const ImportInfo& info)
+        {
+        for (const auto& [re, replacement] : info.m_textImportReplacements)
+            {
+            if (re && re->IsValid())
+                { re->ReplaceAll(&str, replacement); }
+            }
+        }
+
+    //----------------------------------------------
+    const wxString& Dataset::ApplyReplacementStrings(const wxString& str, const ImportInfo& info,
+        std::unordered_map<wxString, wxString, StringHash>& replacedStrings)
+        {
+        if (info.m_textImportReplacements.empty())
+            { return str; }
+        auto replacedString = replacedStrings.find(str);
+        if (replacedString == replacedStrings.end())
+            {
+            // a column with this many distinct values (e.g., free-form text) isn't getting
+            // much from the cache, so start over rather than let it grow with the file
+            // (the previous result has already been used, so clearing is safe)
+            if (replacedStrings.size() >= MAX_REPLACED_STRINGS)
+                { replacedStrings.clear(); }
+            wxString label{ str };
+            ApplyReplacementStrings(label, info);
+            replacedString = replacedStrings.insert(std::make_pair(str, std::move(label))).first;
+            }
+        return replacedString->second;
+        }
+
+    //----------------------------------------------
+    void Dataset::CompiledDateFormat::Compile(const wxString& format)
+        {
+        m_fields.clear();
+        bool hasYear{ false }, hasMonth{ false }, hasDay{ false };
+        for (size_t i = 0; i < format.length(); ++i)
+            {
+            if (format[i] == L'%' && i + 1 < format.length())
+                {
+                const wchar_t specifier = format[++i];
+                switch (specifier)
+                    {
+                case L'Y':
+                    hasYear = true;
+                    m_fields.push_back(Field{ specifier, 0 });
+                    break;
+                case L'm':
+                    hasMonth = true;
+                    m_fields.push_back(Field{ specifier, 0 });
+                    break;
+                case L'd':
+                    hasDay = true;
+                    m_fields.push_back(Field{ specifier, 0 });
+                    break;
+                case L'H':
+                case L'M':
+                case L'S':
+                    m_fields.push_back(Field{ specifier, 0 });
+                    break;
+                case L'%':
+                    m_fields.push_back(Field{ 0, L'%' });
+                    break;
+                // unsupported specifier, so this format will need to be parsed
+                // by wxDateTime::ParseFormat() instead
+                default:
+                    m_fields.clear();
+                    return;
+                    }
+                }
+            else
+                { m_fields.push_back(Field{ 0, format[i] }); }
+            }
+        // formats missing part of the date would rely on
+        // ParseFormat() filling that in with today's date
+        if (!hasYear || !hasMonth || !hasDay)
+            { m_fields.clear(); }
+        }
+
+    //----------------------------------------------
+    wxDateTime Dataset::CompiledDateFormat::Parse(const wxString& input) const
+        {
+        const wchar_t* currentPos = input.wc_str();
+        const wchar_t* const end = currentPos + input.length();
+        int year{ 0 }, month{ 1 }, day{ 1 }, hour{ 0 }, minute{ 0 }, second{ 0 };
+        for (const auto& field : m_fields)
+            {
+            if (field.m_specifier == 0)
+                {
+                if (currentPos == end || currentPos[0] != field.m_literal)
+                    { return wxInvalidDateTime; }
+                ++currentPos;
+                continue;
+                }
+            const size_t maxDigits = (field.m_specifier == L'Y') ? 4 : 2;
+            size_t digitCount{ 0 };
+            int value{ 0 };
+            while (currentPos < end && digitCount < maxDigits &&
+                   currentPos[0] >= L'0' && currentPos[0] <= L'9')
+                {
+                value = (value * 10) + (currentPos[0] - L'0');
+                ++currentPos;
+                ++digitCount;
+                }
+            if (digitCount == 0)
+                { return wxInvalidDateTime; }
+            switch (field.m_specifier)
+                {
+            case L'Y':
+                year = value;
+                break;
+            case L'm':
+                month = value;
+                break;
+            case L'd':
+                day = value;
+                break;
+            case L'H':
+                hour = value;
+                break;
+            case L'M':
+                minute = value;
+                break;
+            case L'S':
+                second = value;
+                break;
+                }
+            }
+        if (currentPos != end ||
+            month < 1 || month > 12 ||
+            day < 1 ||
+            day > wxDateTime::GetNumberOfDays(static_cast<wxDateTime::Month>(month - 1), year) ||
+            hour > 23 || minute > 59 || second > 59)
+            { return wxInvalidDateTime; }
+        return wxDateTime(static_cast<wxDateTime::wxDateTime_t>(day),
+                          static_cast<wxDateTime::Month>(month - 1), year,
+                          static_cast<wxDateTime::wxDateTime_t>(hour),
+                          static_cast<wxDateTime::wxDateTime_t>(minute),
+                          static_cast<wxDateTime::wxDateTime_t>(second));
+        }
+
+    //----------------------------------------------
+    Dataset::DateColumnParser::DateColumnParser(const DateImportMethod method,
+                                                const wxString& formatStr) :
+        m_importMethod(method), m_formatStr(formatStr)
+        {
+        if (m_importMethod == DateImportMethod::StrptimeFormatString)
+            { m_format = CompiledDateFormat(m_formatStr); }
+        else if (m_importMethod == DateImportMethod::DetectFormat)
+            {
+            // the order is important; for ambiguous values (e.g., 01/02/2022),
+            // the first format that matches all of the sampled values will be used
+            for (const auto& format :
+                { L"%Y-%m-%d", L"%Y-%m-%dT%H:%M:%S", L"%Y-%m-%d %H:%M:%S", L"%Y-%m-%d %H:%M",
+                  L"%Y/%m/%d", L"%Y/%m/%d %H:%M:%S",
+                  L"%m/%d/%Y", L"%m/%d/%Y %H:%M:%S", L"%m/%d/%Y %H:%M",
+                  L"%d/%m/%Y", L"%d/%m/%Y %H:%M:%S", L"%d/%m/%Y %H:%M",
+                  L"%d.%m.%Y", L"%d.%m.%Y %H:%M:%S",
+                  L"%m-%d-%Y", L"%d-%m-%Y", L"%Y%m%d" })
+                { m_candidateFormats.emplace_back(format); }
+            }
+        }
+
+    //----------------------------------------------
+    void Dataset::DateColumnParser::SampleFormat(const wxString& input)
+        {
+        m_candidateFormats.erase(
+            std::remove_if(m_candidateFormats.begin(), m_candidateFormats.end(),
+                [&input](const auto& format)
+                    { return !format.Parse(input).IsValid(); }),
+            m_candidateFormats.end());
+        // enough values have been reviewed (or nothing matches),
+        // so use whichever format is still matching everything
+        if (++m_sampledCount >= m_sampleSize || m_candidateFormats.empty())
+            {
+            if (m_candidateFormats.size())
+                { m_format = m_candidateFormats.front(); }
+            m_candidateFormats.clear();
+            m_candidateFormats.shrink_to_fit();
+            }
+        }
+
+    //----------------------------------------------
+    wxDateTime Dataset::DateColumnParser::Parse(const wxString& input)
+        {
+        if (input.empty())
+            { return wxInvalidDateTime; }
+        if (m_importMethod == DateImportMethod::StrptimeFormatString ||
+            m_importMethod == DateImportMethod::DetectFormat)
+            {
+            if (m_format.IsOk())
+                {
+                const auto dt = m_format.Parse(input);
+                if (dt.IsValid())
+                    { return dt; }
+                }
+            // still detecting the format, so use the free-format parser
+            // on these sampled values
+            else if (m_candidateFormats.size())
+                { SampleFormat(input); }
+            }
+        // values that the compiled format couldn't handle
+        return ConvertToDate(input, m_importMethod, m_formatStr);
+        }
+
+    //----------------------------------------------
+    Dataset::StringTableBuilder::StringTableBuilder(
+        const ColumnWithStringTable::StringTableType& stringTable) : m_strings(stringTable)
+        {
+        for (const auto& [code, str] : stringTable)
+            {
+            m_rawStrings.insert(std::make_pair(str, code));
+            m_foldedStrings.insert(std::make_pair(str.Lower(), code));
+            m_currentId = std::max<GroupIdType>(m_currentId, code + 1);
+            }
+        }
+
+    //----------------------------------------------
+    GroupIdType Dataset::StringTableBuilder::LoadCode(const wxString& code)
+        {
+        const auto foundRawString = m_rawStrings.find(code);
+        if (foundRawString != m_rawStrings.cend())
+            { return foundRawString->second; }
+        // new spelling of a string, see if it differs from a known string only by case
+        auto foundString = m_foldedStrings.find(code.Lower());
+        if (foundString == m_foldedStrings.end())
+            {
+            foundString = m_foldedStrings.insert(
+                std::make_pair(code.Lower(), m_currentId)).first;
+            m_strings.insert(std::make_pair(m_currentId, code));
+            ++m_currentId;
+            }
+        m_rawStrings.insert(std::make_pair(code, foundString->second));
+        return foundString->second;
+        }
+
+    //----------------------------------------------
+    Dataset::ImportState Dataset::CreateImportState(const ImportColumnMap& columnMap,
+                                                    const ImportInfo& info)
+        {
+        ImportState state;
+        state.m_categoricalVars.reserve(columnMap.m_catColumnIndices.size());
+        for (size_t i = 0; i < columnMap.m_catColumnIndices.size(); ++i)
+            { state.m_categoricalVars.emplace_back(info.m_categoricalColumns.at(i).m_stringTable); }
+        state.m_dateParsers.reserve(columnMap.m_dateColumnIndices.size());
+        for (const auto& dateInfo : columnMap.m_dateColumnIndices)
+            {
+            state.m_dateParsers.emplace_back(
+                dateInfo ? dateInfo.value().m_importMethod : DateImportMethod::Automatic,
+                dateInfo ? dateInfo.value().m_formatStr : wxString());
+            }
+        return state;
+        }
+
     //----------------------------------------------
     void Dataset::AddRow(const RowInfo& dataInfo)
         {
@@ -153,6 +652,202 @@ namespace Wisteria::Data
             { m_continuousColumns.at(i).AddValue(dataInfo.m_continuousValues.at(i)); }
         }
 
+    //----------------------------------------------
+    void Dataset::AddRows(ColumnBatch&& batch)
+        {
+        const size_t rowCount = batch.GetRowCount();
+        if (rowCount == 0)
+            { return; }
+
+        // add new columns if included in the batch but not previously defined
+        for (size_t i = m_dateColumns.size(); i < batch.m_dateColumns.size(); ++i)
+            { AddDateColumn(wxString::Format(L"[DATE%zu]", i+1)); }
+        for (size_t i = m_continuousColumns.size(); i < batch.m_continuousValues.size(); ++i)
+            { AddContinuousColumn(wxString::Format(L"[CONTINUOUS%zu]", i+1)); }
+        for (size_t i = m_categoricalColumns.size(); i < batch.m_categoryValues.size(); ++i)
+            { AddCategoricalColumn(wxString::Format(L"[CATEGORICAL%zu]", i+1)); }
+
+        const size_t newRowCount = GetRowCount() + rowCount;
+        // appends the batch's values for each of the dataset's columns
+        // (or missing data for any columns not in the batch); narrowed columns
+        // stay narrowed, unless a new value doesn't fit in them
+        const auto appendColumns = [newRowCount](auto& columns, auto& batchColumns,
+                                                 const auto& missingValue)
+            {
+            for (size_t i = 0; i < columns.size(); ++i)
+                {
+                columns[i].AppendValues((i < batchColumns.size()) ?
+                    std::move(batchColumns[i]) :
+                    std::remove_reference_t<decltype(batchColumns[i])>{},
+                    newRowCount, missingValue);
+                }
+            };
+
+        // ID (compacted IDs are appended to the compacted storage, rather than being
+        // expanded and compacted again for every batch)
+        wxASSERT_MSG(batch.m_ids.empty() || batch.m_ids.size() + GetRowCount() == newRowCount,
+                     L"Columns in batch have different lengths in call to AddRows()!");
+        if (m_idColumn.IsCompact())
+            {
+            for (const auto& id : batch.m_ids)
+                { m_idColumn.AddValue(id); }
+            }
+        else if (m_idColumn.m_data.empty())
+            { m_idColumn.m_data = std::move(batch.m_ids); }
+        else
+            {
+            m_idColumn.m_data.insert(m_idColumn.m_data.end(),
+                                     std::make_move_iterator(batch.m_ids.begin()),
+                                     std::make_move_iterator(batch.m_ids.end()));
+            }
+        while (m_idColumn.GetRowCount() < newRowCount)
+            { m_idColumn.AddValue(wxString()); }
+        appendColumns(m_dateColumns, batch.m_dateColumns, wxInvalidDateTime);
+        appendColumns(m_categoricalColumns, batch.m_categoryValues, static_cast<GroupIdType>(0));
+        appendColumns(m_continuousColumns, batch.m_continuousValues,
+                      std::numeric_limits<double>::quiet_NaN());
+        }
+
+    //----------------------------------------------
+    std::shared_ptr<Dataset> Dataset::GetSubset(const std::vector<size_t>& rows) const
+        {
+        const auto invalidRow = std::find_if(rows.cbegin(), rows.cend(),
+            [this](const auto row) noexcept
+            { return row >= GetRowCount(); });
+        if (invalidRow != rows.cend())
+            {
+            throw std::runtime_error(wxString::Format(
+                _(L"Row %zu is out of range for subset of dataset."), *invalidRow).ToUTF8());
+            }
+
+        auto subset = std::make_shared<Dataset>();
+        subset->m_name = GetName();
+        // copies the selected rows from a column's values
+        const auto copyRows = [&rows](auto& subsetValues, const auto& column)
+            {
+            subsetValues.reserve(rows.size());
+            for (const auto row : rows)
+                { subsetValues.push_back(column.GetValue(row)); }
+            };
+
+        // ID
+        subset->m_idColumn.SetTitle(GetIdColumn().GetTitle());
+        if (GetIdColumn().IsCompact())
+            {
+            subset->m_idColumn.Reserve(rows.size());
+            for (const auto row : rows)
+                { subset->m_idColumn.AddValue(GetIdColumn().GetValue(row)); }
+            subset->m_idColumn.Compact();
+            }
+        else
+            { copyRows(subset->m_idColumn.m_data, GetIdColumn()); }
+        // dates
+        subset->m_dateColumns.reserve(GetDateColumns().size());
+        for (const auto& column : GetDateColumns())
+            {
+            subset->m_dateColumns.emplace_back(column.GetTitle());
+            copyRows(subset->m_dateColumns.back().m_data, column);
+            }
+        // categoricals
+        subset->m_categoricalColumns.reserve(GetCategoricalColumns().size());
+        for (const auto& column : GetCategoricalColumns())
+            {
+            subset->m_categoricalColumns.emplace_back(column.GetTitle());
+            subset->m_categoricalColumns.back().GetStringTable() = column.GetStringTable();
+            copyRows(subset->m_categoricalColumns.back().m_data, column);
+            }
+        // continuous
+        subset->m_continuousColumns.reserve(GetContinuousColumns().size());
+        for (const auto& column : GetContinuousColumns())
+            {
+            subset->m_continuousColumns.emplace_back(column.GetTitle());
+            copyRows(subset->m_continuousColumns.back().m_data, column);
+            subset->m_continuousColumns.back().SetStorage(column.GetStorage());
+            }
+
+        subset->RebuildColumnIndices();
+        return subset;
+        }
+
+    //----------------------------------------------
+    std::shared_ptr<Dataset> Dataset::GetSubset(
+        const std::function<bool (const size_t)>& rowFilter) const
+        {
+        std::vector<size_t> rows;
+        for (size_t i = 0; i < GetRowCount(); ++i)
+            {
+            if (rowFilter(i))
+                { rows.push_back(i); }
+            }
+        return GetSubset(rows);
+        }
+
+    //----------------------------------------------
+    std::shared_ptr<Dataset> Dataset::GetSubset(const wxString& groupColumn,
+                                                const GroupIdType groupId) const
+        {
+        const auto groupColumnIterator = GetCategoricalColumn(groupColumn);
+        if (groupColumnIterator == GetCategoricalColumns().cend())
+            {
+            throw std::runtime_error(wxString::Format(
+                _(L"'%s': group column not found for subset of dataset."), groupColumn).ToUTF8());
+            }
+        return GetSubset(groupColumnIterator->GetGroupRows(groupId));
+        }
+
+    //----------------------------------------------
+    std::shared_ptr<Dataset> Dataset::GetAssociationMatrix(
+        const std::vector<wxString>& columnNames, const AssociationMethod method) const
+        {
+        std::vector<std::reference_wrapper<const std::vector<double>>> variables;
+        variables.reserve(columnNames.size());
+        ColumnWithStringTable::StringTableType variableNames;
+        for (const auto& columnName : columnNames)
+            {
+            const auto column = GetContinuousColumn(columnName);
+            if (column == GetContinuousColumns().cend())
+                {
+                throw std::runtime_error(wxString::Format(
+                    _(L"'%s': continuous column not found for association matrix."),
+                    columnName).ToUTF8());
+                }
+            variableNames.insert(std::make_pair(variables.size(), columnName));
+            variables.push_back(std::cref(column->GetValues()));
+            }
+
+        auto coefficients = (method == AssociationMethod::Phi) ?
+            statistics::phi_coefficient_matrix(variables) :
+            statistics::correlation_matrix(variables);
+
+        // one row for each pair, grouped by the first variable in the pair
+        std::vector<wxString> ids;
+        std::vector<GroupIdType> groups;
+        ids.reserve(coefficients.size());
+        groups.reserve(coefficients.size());
+        for (size_t i = 0; i < columnNames.size(); ++i)
+            {
+            for (size_t j = 0; j < columnNames.size(); ++j)
+                {
+                ids.push_back(columnNames[i] + L", " + columnNames[j]);
+                groups.push_back(i);
+                }
+            }
+
+        auto matrix = std::make_shared<Dataset>();
+        matrix->AddCategoricalColumn(L"Variable", variableNames);
+        matrix->AddContinuousColumn(L"Coefficient");
+        // (move the values into the batch, rather than using initializer lists, which would copy them)
+        std::vector<std::vector<GroupIdType>> categoricalValues(1);
+        categoricalValues.front() = std::move(groups);
+        std::vector<std::vector<double>> continuousValues(1);
+        continuousValues.front() = std::move(coefficients);
+        ColumnBatch batch;
+        batch.Ids(std::move(ids)).Categoricals(std::move(categoricalValues)).
+            Continuous(std::move(continuousValues));
+        matrix->AddRows(std::move(batch));
+        return matrix;
+        }
+
     //----------------------------------------------
     std::pair<double, double> Dataset::GetContinuousMinMax(const wxString& column,
         const std::optional<wxString>& groupColumn,
@@ -184,25 +879,31 @@ namespace Wisteria::Data
                 groupColumn.value()).ToUTF8());
             }
 
-        // No rows or all NaN? Then return a range of NaNs.
-        if (GetContinuousColumnValidN(column, groupColumn, groupId) == 0)
+        // not grouping, so use the column's (cached) summary
+        if (groupColumnIterator == GetCategoricalColumns().cend())
             {
-            return std::make_pair(std::numeric_limits<double>::quiet_NaN(),
-                                  std::numeric_limits<double>::quiet_NaN());
+            const auto& summary = continuousColumnIterator->GetSummary();
+            return std::make_pair(summary.m_min, summary.m_max);
             }
 
+        size_t validN{ 0 };
         auto minValue = std::numeric_limits<double>::max();
         auto maxValue = std::numeric_limits<double>::lowest();
-        for (size_t i = 0; i < GetRowCount(); ++i)
+        for (const auto i : groupColumnIterator->GetGroupRows(groupId.value()))
             {
-            if (!std::isnan(continuousColumnIterator->GetValue(i)) &&
-                ((groupColumnIterator == GetCategoricalColumns().cend()) ||
-                groupColumnIterator->GetValue(i) == groupId.value()))
+            if (!std::isnan(continuousColumnIterator->GetValue(i)))
                 {
+                ++validN;
                 minValue = std::min(minValue, continuousColumnIterator->GetValue(i));
                 maxValue = std::max(maxValue, continuousColumnIterator->GetValue(i));
                 }
             }
+        // No rows or all NaN? Then return a range of NaNs.
+        if (validN == 0)
+            {
+            return std::make_pair(std::numeric_limits<double>::quiet_NaN(),
+                                  std::numeric_limits<double>::quiet_NaN());
+            }
         return std::make_pair(minValue, maxValue);
         }
 
@@ -237,22 +938,14 @@ namespace Wisteria::Data
                 groupColumn.value()).ToUTF8());
             }
 
-        size_t validN{ 0 };
-        for (size_t i = 0; i < GetRowCount(); ++i)
-            {
-            if (groupColumnIterator != GetCategoricalColumns().cend())
-                {
-                if (groupColumnIterator->GetValue(i) == groupId.value() &&
-                    !std::isnan(continuousColumnIterator->GetValue(i)))
-                    { ++validN; }
-                }
-            else
-                {
-                if (!std::isnan(continuousColumnIterator->GetValue(i)))
-                    { ++validN; }
-                }
-            }
-        return validN;
+        // not grouping, so use the column's (cached) summary
+        if (groupColumnIterator == GetCategoricalColumns().cend())
+            { return continuousColumnIterator->GetSummary().m_validN; }
+
+        const auto& groupRows = groupColumnIterator->GetGroupRows(groupId.value());
+        return static_cast<size_t>(std::count_if(groupRows.cbegin(), groupRows.cend(),
+            [&continuousColumnIterator](const auto i)
+                { return !std::isnan(continuousColumnIterator->GetValue(i)); }));
         }
 
     //----------------------------------------------
@@ -304,7 +997,42 @@ namespace Wisteria::Data
             { GetCategoricalColumn(i).SetTitle(info.m_categoricalColumns.at(i).m_columnName); }
         // continuous
         for (size_t i = 0; i < info.m_continuousColumns.size(); ++i)
-            { GetContinuousColumn(i).SetTitle(info.m_continuousColumns.at(i)); }
+            { GetContinuousColumn(i).SetTitle(info.m_continuousColumns.at(i).m_columnName); }
+
+        RebuildColumnIndices();
+        }
+
+    //----------------------------------------------
+    void Dataset::ApplyStorageOptions(const ImportInfo& info)
+        {
+        if (info.m_compactIds)
+            { m_idColumn.Compact(); }
+        for (size_t i = 0; i < info.m_continuousColumns.size() && i < m_continuousColumns.size(); ++i)
+            {
+            const auto storage = info.m_continuousColumns[i].m_storage;
+            if (storage != ContinuousStorage::Double &&
+                !m_continuousColumns[i].SetStorage(storage))
+                {
+                wxLogWarning(_(L"'%s': column's values do not fit in the requested storage type; "
+                                L"they will be stored as doubles."),
+                             m_continuousColumns[i].GetTitle());
+                }
+            }
+        }
+
+    //----------------------------------------------
+    void Dataset::RebuildColumnIndices()
+        {
+        const auto rebuildIndex = [](ColumnNameIndex& columnIndex, const auto& columns)
+            {
+            columnIndex.clear();
+            columnIndex.reserve(columns.size());
+            for (size_t i = 0; i < columns.size(); ++i)
+                { IndexColumnName(columnIndex, columns[i].GetTitle(), i); }
+            };
+        rebuildIndex(m_dateColumnIndex, m_dateColumns);
+        rebuildIndex(m_categoricalColumnIndex, m_categoricalColumns);
+        rebuildIndex(m_continuousColumnIndex, m_continuousColumns);
         }
 
     //----------------------------------------------
@@ -314,6 +1042,7 @@ namespace Wisteria::Data
             L"Column name is empty in call to AddCategoricalColumn()!");
         m_categoricalColumns.resize(m_categoricalColumns.size()+1);
         m_categoricalColumns.back().SetTitle(columnName);
+        IndexColumnName(m_categoricalColumnIndex, columnName, m_categoricalColumns.size()-1);
         // add a string table with an empty value and fill the data with that
         // if there are existing rows in the data
         if (GetRowCount())
@@ -332,6 +1061,7 @@ namespace Wisteria::Data
             L"Column name is empty in call to AddCategoricalColumn()!");
         m_categoricalColumns.resize(m_categoricalColumns.size()+1);
         m_categoricalColumns.back().SetTitle(columnName);
+        IndexColumnName(m_categoricalColumnIndex, columnName, m_categoricalColumns.size()-1);
         m_categoricalColumns.back().GetStringTable() = stringTable;
         // if we have existing rows and need to fill this column
         if (GetRowCount())
@@ -435,263 +1165,834 @@ namespace Wisteria::Data
         return columnInfo;
         }
 
+    //----------------------------------------------
+    Dataset::ColumnPreviewInfo Dataset::ReadColumnInfo(const wxString& filePath, const wchar_t delimiter,
+                                                       const PreviewInfo& info)
+        {
+        wxFile fl(filePath);
+        const auto throwReadError = [&fl, &filePath]()
+            {
+            throw std::runtime_error(wxString::Format(_(L"'%s':\n%s"), filePath,
+                                     wxSysErrorMsg(fl.GetLastError())).ToUTF8());
+            };
+        if (!fl.IsOpened())
+            { throwReadError(); }
+        const wxFileOffset fileLength = fl.Length();
+        if (fileLength == wxInvalidOffset)
+            { throwReadError(); }
+        const size_t fileSize = static_cast<size_t>(fileLength);
+
+        // reads a block of raw bytes from the file
+        const auto readBlock = [&fl, &throwReadError](const size_t start, const size_t length)
+            {
+            std::string block(length, '\0');
+            if (fl.Seek(static_cast<wxFileOffset>(start)) == wxInvalidOffset)
+                { throwReadError(); }
+            const auto bytesRead = fl.Read(block.data(), length);
+            if (bytesRead == wxInvalidOffset)
+                { throwReadError(); }
+            block.resize(static_cast<size_t>(bytesRead));
+            return block;
+            };
+
+        // read the beginning of the file (making sure that it includes the full header)
+        std::string prefix = readBlock(0, std::min(fileSize, info.m_prefixSize));
+        while (prefix.length() < fileSize && prefix.find('\n') == std::string::npos)
+            {
+            const auto nextBlock = readBlock(prefix.length(),
+                                             std::min(fileSize - prefix.length(), info.m_prefixSize));
+            if (nextBlock.empty())
+                { break; }
+            prefix.append(nextBlock);
+            }
+
+        // blocks of UTF-16/32 text can't be split on newline bytes,
+        // so fall back to reading the whole file
+        switch (wxConvAuto::DetectBOM(prefix.data(), prefix.length()))
+            {
+        case wxConvAuto::BOM_UTF16BE:
+        case wxConvAuto::BOM_UTF16LE:
+        case wxConvAuto::BOM_UTF32BE:
+        case wxConvAuto::BOM_UTF32LE:
+            return ReadColumnInfo(filePath, delimiter);
+        default:
+            break;
+            }
+
+        // only keep complete lines from a block
+        const auto trimToLines = [](std::string& block, const bool trimStart, const bool trimEnd)
+            {
+            if (trimEnd)
+                {
+                const auto lastNewLine = block.rfind('\n');
+                block.erase((lastNewLine == std::string::npos) ? 0 : lastNewLine + 1);
+                }
+            if (trimStart)
+                {
+                const auto firstNewLine = block.find('\n');
+                block.erase(0, (firstNewLine == std::string::npos) ? block.length() : firstNewLine + 1);
+                }
+            };
+        const size_t prefixLength = prefix.length();
+        trimToLines(prefix, false, prefixLength < fileSize);
+
+        // the same converter is used for all blocks, so that they are decoded
+        // with the encoding detected from the start of the file
+        wxConvAuto conv;
+        wxString prefixText(prefix.data(), conv, prefix.length());
+        prefixText.Trim(true).Trim(false);
+        ColumnPreviewInfo columnInfo;
+        if (prefixText.empty())
+            { return columnInfo; }
+
+        lily_of_the_valley::text_preview preview;
+        preview.read_header(prefixText, delimiter);
+        const size_t columnCount = preview.get_header_names().size();
+
+        lily_of_the_valley::standard_delimited_character_column
+            noReadColumn(lily_of_the_valley::text_column_delimited_character_parser{ delimiter, false });
+        lily_of_the_valley::text_row<wxString> noReadRow{ 1 };
+        noReadRow.add_column(noReadColumn);
+
+        lily_of_the_valley::standard_delimited_character_column
+            deliminatedColumn(lily_of_the_valley::text_column_delimited_character_parser{ delimiter });
+        lily_of_the_valley::text_row<wxString> row;
+        row.add_column(deliminatedColumn);
+
+        std::vector<std::vector<wxString>> dataStrings;
+        // the prefix (skipping the header)
+            {
+            lily_of_the_valley::text_matrix<wxString> importer{ &dataStrings };
+            importer.add_row(noReadRow);
+            importer.add_row(row);
+            importer.read_all(prefixText, columnCount, false);
+            }
+
+        // evenly spaced blocks from the rest of the file
+        if (info.m_sampleBlockCount > 0 && prefixLength < fileSize)
+            {
+            const size_t remainingLength = fileSize - prefixLength;
+            const size_t blockSpacing = remainingLength / info.m_sampleBlockCount;
+            for (size_t blockIndex = 0; blockIndex < info.m_sampleBlockCount; ++blockIndex)
+                {
+                // the block starts on the last byte of the previous section (which may
+                // be a newline), so that its first full line isn't skipped
+                const size_t blockStart = prefixLength + (blockIndex * blockSpacing) - 1;
+                auto block = readBlock(blockStart,
+                    std::min(info.m_sampleBlockSize, fileSize - blockStart));
+                trimToLines(block, true, blockStart + block.length() < fileSize);
+                if (block.empty())
+                    { continue; }
+                const wxString blockText(block.data(), conv, block.length());
+
+                std::vector<std::vector<wxString>> blockStrings;
+                lily_of_the_valley::text_matrix<wxString> importer{ &blockStrings };
+                importer.add_row(row);
+                importer.read_all(blockText, columnCount, false);
+                dataStrings.insert(dataStrings.end(),
+                                   std::make_move_iterator(blockStrings.begin()),
+                                   std::make_move_iterator(blockStrings.end()));
+                }
+            }
+
+        wxLogNull nl;
+        for (size_t colIndex = 0; colIndex < columnCount; ++colIndex)
+            {
+            // count how many of the sampled values look like dates or numbers
+            size_t valueCount{ 0 }, dateCount{ 0 }, numericCount{ 0 };
+            for (const auto& currentRow : dataStrings)
+                {
+                if (colIndex >= currentRow.size() || currentRow[colIndex].empty())
+                    { continue; }
+                const auto& currentCell = currentRow[colIndex];
+                ++valueCount;
+                if (ConvertToDate(currentCell, DateImportMethod::Automatic, L"").IsValid())
+                    { ++dateCount; }
+                if (!std::isnan(ConvertToDouble(currentCell)))
+                    { ++numericCount; }
+                }
+            // columns with no values are assumed to be numeric
+            // (the same as the other ReadColumnInfo())
+            const double requiredCount = valueCount * info.m_confidenceThreshold;
+            const ColumnImportType currentColumnType =
+                (valueCount == 0) ? ColumnImportType::Numeric :
+                (dateCount > 0 && dateCount >= requiredCount) ? ColumnImportType::Date :
+                (numericCount >= requiredCount) ? ColumnImportType::Numeric :
+                ColumnImportType::String;
+            columnInfo.push_back(std::make_pair(
+                preview.get_header_names().at(colIndex).c_str(),
+                currentColumnType));
+            }
+        return columnInfo;
+        }
+
     //----------------------------------------------
     void Dataset::ExportText(const wxString& filePath,
-                             const wchar_t delimiter, const bool quoteColumns) const
+                             const wchar_t delimiter, const bool quoteColumns,
+                             const bool parallelFormat /*= false*/) const
         {
-        const auto wrapText = [&](const wxString& val)
+        wxFile fl(filePath, wxFile::write);
+        const auto throwWriteError = [&fl, &filePath]()
+            {
+            throw std::runtime_error(wxString::Format(_(L"'%s':\n%s"), filePath,
+                                     wxSysErrorMsg(fl.GetLastError())).ToUTF8());
+            };
+        if (!fl.IsOpened())
+            { throwWriteError(); }
+
+        const std::string delim{ wxString(1, delimiter).ToUTF8() };
+        const std::string decimalSeparator{
+            wxString(1, wxNumberFormatter::GetDecimalSeparator()).ToUTF8() };
+        // appends a (UTF-8) value to the output, quoting it if requested
+        const auto appendText = [quoteColumns](std::string& output, const std::string_view val)
             {
             if (quoteColumns)
                 {
                 // convert double quotes in val to two double quotes,
                 // then wrap text with double quotes
-                wxString escapedText = val;
-                escapedText.Replace(L"\"", L"\"\"", true);
-                return wxString(L"\"" + escapedText + L"\"");
+                output.append(1, '"');
+                for (const auto ch : val)
+                    {
+                    if (ch == '"')
+                        { output.append(1, '"'); }
+                    output.append(1, ch);
+                    }
+                output.append(1, '"');
                 }
             else
-                { return val; }
+                { output.append(val); }
+            };
+        const auto appendString = [&appendText](std::string& output, const wxString& val)
+            {
+            const wxScopedCharBuffer utf8Value = val.ToUTF8();
+            appendText(output, std::string_view(utf8Value.data(), utf8Value.length()));
             };
-        // combines column names as a delimited string
-        const auto concatColNames = [&](const auto& cols)
+
+        // write the column names
+        const bool hasIdData = HasValidIdData();
+        std::string colNames;
+        const auto appendColumnNames = [&](const auto& cols)
             {
-            wxString colNames;
-            for (const auto& catCol : cols)
+            for (const auto& col : cols)
                 {
-                colNames.append(wrapText(catCol.GetTitle())).
-                    append(1, delimiter);
+                if (!colNames.empty())
+                    { colNames.append(delim); }
+                appendString(colNames, col.GetTitle());
                 }
-            colNames.RemoveLast();
-            return colNames;
             };
-        wxString idName = HasValidIdData() ? wrapText(GetIdColumn().GetTitle()) : wxString();
-        wxString continuousColumnNames = concatColNames(GetContinuousColumns());
-        wxString catColumnNames = concatColNames(GetCategoricalColumns());
-        wxString dataColumnNames = concatColNames(GetDateColumns());
-        wxString colNames = (idName.length() ? idName + delimiter : wxString()) +
-            (continuousColumnNames.length() ? continuousColumnNames + delimiter : wxString()) +
-            (catColumnNames.length() ? catColumnNames + delimiter : wxString()) +
-            (dataColumnNames.length() ? dataColumnNames + delimiter : wxString());
-        if (colNames.length() && colNames.Last() == delimiter)
-            { colNames.RemoveLast();}
-        
-        wxString fileContent = colNames + L'\n';
-
-        // write the data
-        wxString currentRow;
-        for (size_t i = 0; i < GetRowCount(); ++i)
+        if (hasIdData)
+            { appendString(colNames, GetIdColumn().GetTitle()); }
+        appendColumnNames(GetContinuousColumns());
+        appendColumnNames(GetCategoricalColumns());
+        appendColumnNames(GetDateColumns());
+        colNames.append(1, '\n');
+        if (fl.Write(colNames.data(), colNames.length()) != colNames.length())
+            { throwWriteError(); }
+
+        // convert each categorical column's labels to (quoted) UTF-8 once,
+        // rather than for every row
+        std::vector<std::unordered_map<GroupIdType, std::string>> categoricalLabels;
+        categoricalLabels.reserve(GetCategoricalColumns().size());
+        for (const auto& col : GetCategoricalColumns())
             {
-            currentRow.clear();
-            // ID
-            if (HasValidIdData())
-                { currentRow.append(wrapText(GetIdColumn().GetValue(i))).append(1, delimiter); }
-            // continuous
-            for (const auto& col : GetContinuousColumns())
+            auto& labels = categoricalLabels.emplace_back();
+            for (const auto& [code, label] : col.GetStringTable())
+                { appendString(labels[code], label); }
+            }
+
+        // formats a range of rows into the output text
+        const auto formatRows = [&](std::string& output, const size_t firstRow, const size_t lastRow)
+            {
+            // enough space for six-point precision of any double
+            std::array<char, 512> numberBuffer{ 0 };
+            for (size_t i = firstRow; i < lastRow; ++i)
                 {
-                currentRow.append(wrapText(std::isnan(col.GetValue(i)) ? wxString() :
-                                  wxNumberFormatter::ToString(col.GetValue(i), 6,
-                                      wxNumberFormatter::Style::Style_NoTrailingZeroes))).
-                           append(1, delimiter);
+                bool isFirstColumn{ true };
+                const auto appendDelimiter = [&output, &delim, &isFirstColumn]()
+                    {
+                    if (!isFirstColumn)
+                        { output.append(delim); }
+                    isFirstColumn = false;
+                    };
+                // ID
+                if (hasIdData)
+                    {
+                    appendDelimiter();
+                    appendString(output, GetIdColumn().GetValue(i));
+                    }
+                // continuous
+                for (const auto& col : GetContinuousColumns())
+                    {
+                    appendDelimiter();
+                    const double value = col.GetValue(i);
+                    if (std::isnan(value))
+                        {
+                        appendText(output, std::string_view{});
+                        continue;
+                        }
+                    std::string_view number{ numberBuffer.data(),
+                        static_cast<size_t>(std::to_chars(numberBuffer.data(),
+                            numberBuffer.data() + numberBuffer.size(), value,
+                            std::chars_format::fixed, 6).ptr - numberBuffer.data()) };
+                    // remove trailing zeroes (and the decimal point, if nothing follows it)
+                    if (const auto decimalPos = number.find('.'); decimalPos != std::string_view::npos)
+                        {
+                        number.remove_suffix(number.length() - (number.find_last_not_of('0') + 1));
+                        const std::string_view fraction = number.substr(decimalPos + 1);
+                        number = number.substr(0, decimalPos);
+                        if (!fraction.empty())
+                            {
+                            std::string formattedNumber{ number };
+                            formattedNumber.append(decimalSeparator).append(fraction);
+                            appendText(output, formattedNumber);
+                            continue;
+                            }
+                        }
+                    appendText(output, number);
+                    }
+                // categoricals
+                for (size_t colIndex = 0; colIndex < GetCategoricalColumns().size(); ++colIndex)
+                    {
+                    appendDelimiter();
+                    const auto code = GetCategoricalColumns()[colIndex].GetValue(i);
+                    const auto foundLabel = categoricalLabels[colIndex].find(code);
+                    if (foundLabel != categoricalLabels[colIndex].cend())
+                        { output.append(foundLabel->second); }
+                    else
+                        { appendText(output, std::to_string(code)); }
+                    }
+                // dates
+                for (const auto& col : GetDateColumns())
+                    {
+                    appendDelimiter();
+                    if (!col.GetValue(i).IsValid())
+                        {
+                        appendText(output, std::string_view{});
+                        continue;
+                        }
+                    // same as wxDateTime::FormatISOCombined()
+                    const wxDateTime::Tm dateInfo = col.GetValue(i).GetTm();
+                    const int dateLength = std::snprintf(numberBuffer.data(), numberBuffer.size(),
+                        "%04d-%02d-%02dT%02d:%02d:%02d", dateInfo.year,
+                        static_cast<int>(dateInfo.mon) + 1, static_cast<int>(dateInfo.mday),
+                        static_cast<int>(dateInfo.hour), static_cast<int>(dateInfo.min),
+                        static_cast<int>(dateInfo.sec));
+                    appendText(output, std::string_view(numberBuffer.data(),
+                                                        static_cast<size_t>(std::max(dateLength, 0))));
+                    }
+                output.append(1, '\n');
                 }
-            // categoricals
-            for (const auto& col : GetCategoricalColumns())
+            };
+
+        // write the data in blocks of rows, so that the whole file is never held in memory
+        constexpr size_t rowsPerBlock{ 64 * 1024 };
+        constexpr size_t rowsPerTask{ 4 * 1024 };
+        std::vector<std::string> blockTexts(parallelFormat ? (rowsPerBlock / rowsPerTask) : 1);
+        std::vector<size_t> taskIndices(blockTexts.size());
+        std::iota(taskIndices.begin(), taskIndices.end(), 0);
+        for (size_t blockStart = 0; blockStart < GetRowCount(); blockStart += rowsPerBlock)
+            {
+            const size_t blockEnd = std::min(blockStart + rowsPerBlock, GetRowCount());
+            if (parallelFormat)
                 {
-                currentRow.append(wrapText(col.GetCategoryLabelFromID(col.GetValue(i)))).
-                           append(1, delimiter);
+                // each task formats a slice of the block into its own buffer
+                std::for_each(std::execution::par, taskIndices.cbegin(), taskIndices.cend(),
+                    [&](const size_t taskIndex)
+                    {
+                    auto& taskText = blockTexts[taskIndex];
+                    taskText.clear();
+                    const size_t taskStart = blockStart + (taskIndex * rowsPerTask);
+                    if (taskStart < blockEnd)
+                        { formatRows(taskText, taskStart, std::min(taskStart + rowsPerTask, blockEnd)); }
+                    });
                 }
-            // dates
-            for (const auto& col : GetDateColumns())
+            else
                 {
-                currentRow.append(
-                           wrapText(col.GetValue(i).IsValid() ? col.GetValue(i).FormatISOCombined() : wxString())).
-                           append(1, delimiter);
+                blockTexts.front().clear();
+                formatRows(blockTexts.front(), blockStart, blockEnd);
+                }
+
+            for (const auto& blockText : blockTexts)
+                {
+                if (!blockText.empty() &&
+                    fl.Write(blockText.data(), blockText.length()) != blockText.length())
+                    { throwWriteError(); }
                 }
-            if (currentRow.length() && currentRow.Last() == delimiter)
-                { currentRow.RemoveLast();}
-            fileContent.append(currentRow).append(1, L'\n');
             }
+        }
 
-        wxFile fl(filePath, wxFile::write);
-        if (!fl.IsOpened() || !fl.Write(fileContent))
+    //----------------------------------------------
+    MemoryUsage ColumnWithStringTable::GetMemoryUsage() const
+        {
+        // approximate size of a node in a map or unordered_map, not including its value
+        constexpr size_t mapNodeBytes{ 4 * sizeof(void*) };
+        auto usage = Column::GetMemoryUsage();
+        for (const auto& [code, label] : m_stringTable)
             {
-            throw std::runtime_error(wxString::Format(_(L"'%s':\n%s"), filePath,
-                                     wxSysErrorMsg(fl.GetLastError())).ToUTF8());
+            usage.m_dataBytes += mapNodeBytes + sizeof(StringTableType::value_type) +
+                                 label.length() * sizeof(wxChar);
             }
+        if (const auto* lookup = m_lookup.Find())
+            {
+            usage.m_cacheBytes +=
+                lookup->m_labels.capacity() * sizeof(decltype(lookup->m_labels)::value_type) +
+                lookup->m_codes.bucket_count() * sizeof(void*);
+            for (const auto& label : lookup->m_labels)
+                {
+                if (label)
+                    { usage.m_cacheBytes += label->length() * sizeof(wxChar); }
+                }
+            for (const auto& [label, code] : lookup->m_codes)
+                {
+                usage.m_cacheBytes += mapNodeBytes +
+                    sizeof(decltype(lookup->m_codes)::value_type) +
+                    label.length() * sizeof(wxChar);
+                }
+            }
+        if (const auto* groupRows = m_groupRows.Find())
+            {
+            usage.m_cacheBytes += groupRows->bucket_count() * sizeof(void*);
+            for (const auto& [code, rows] : *groupRows)
+                {
+                usage.m_cacheBytes += mapNodeBytes +
+                    sizeof(std::remove_pointer_t<decltype(groupRows)>::value_type) +
+                    rows.capacity() * sizeof(size_t);
+                }
+            }
+        return usage;
         }
 
     //----------------------------------------------
-    void Dataset::ImportText(const wxString& filePath, const ImportInfo& info,
-                             const wchar_t delimiter)
+    MemoryUsage IdentifierColumn::GetMemoryUsage() const
         {
-        // reset
-        Clear();
-        m_dateColumns.clear();
-        m_categoricalColumns.clear();
-        m_continuousColumns.clear();
+        MemoryUsage usage;
+        usage.m_dataBytes = m_title.length() * sizeof(wxChar) +
+            m_data.capacity() * sizeof(wxString) +
+            m_integerIds.capacity() * sizeof(int64_t) +
+            m_utf8Ids.capacity() +
+            m_utf8Offsets.capacity() * sizeof(size_t);
+        for (const auto& id : m_data)
+            { usage.m_dataBytes += id.length() * sizeof(wxChar); }
+        return usage;
+        }
 
-        wxString fileText;
-        wxFile fl(filePath);
-        if (!fl.IsOpened() || !fl.ReadAll(&fileText))
+    //----------------------------------------------
+    MemoryUsage Dataset::GetMemoryUsage() const
+        {
+        MemoryUsage usage = m_idColumn.GetMemoryUsage();
+        usage.m_dataBytes += m_name.length() * sizeof(wxChar) +
+            m_dateColumns.capacity() * sizeof(Column<wxDateTime>) +
+            m_categoricalColumns.capacity() * sizeof(ColumnWithStringTable) +
+            m_continuousColumns.capacity() * sizeof(Column<double>);
+        for (const auto& column : m_dateColumns)
+            { usage += column.GetMemoryUsage(); }
+        for (const auto& column : m_categoricalColumns)
+            { usage += column.GetMemoryUsage(); }
+        for (const auto& column : m_continuousColumns)
+            { usage += column.GetMemoryUsage(); }
+        return usage;
+        }
+
+    //----------------------------------------------
+    void Dataset::ReleaseCaches() noexcept
+        {
+        for (auto& column : m_dateColumns)
+            { column.InvalidateCaches(); }
+        for (auto& column : m_categoricalColumns)
+            { column.ReleaseCaches(); }
+        for (auto& column : m_continuousColumns)
+            { column.InvalidateCaches(); }
+        }
+
+    //----------------------------------------------
+    void Dataset::ExportBinary(const wxString& filePath) const
+        {
+        wxFile fl(filePath, wxFile::write);
+        const auto throwWriteError = [&fl, &filePath]()
             {
             throw std::runtime_error(wxString::Format(_(L"'%s':\n%s"), filePath,
                                      wxSysErrorMsg(fl.GetLastError())).ToUTF8());
+            };
+        if (!fl.IsOpened())
+            { throwWriteError(); }
+
+        // small values (e.g., ID strings) are buffered, while a column's data
+        // is written directly in one call
+        constexpr size_t bufferSize{ 1024 * 1024 };
+        std::vector<char> buffer;
+        buffer.reserve(bufferSize);
+        const auto flushBuffer = [&]()
+            {
+            if (buffer.size() && fl.Write(buffer.data(), buffer.size()) != buffer.size())
+                { throwWriteError(); }
+            buffer.clear();
+            };
+        const auto writeBytes = [&](const void* data, const size_t size)
+            {
+            if (size == 0)
+                { return; }
+            if (buffer.size() + size > bufferSize)
+                {
+                flushBuffer();
+                if (size > bufferSize)
+                    {
+                    if (fl.Write(data, size) != size)
+                        { throwWriteError(); }
+                    return;
+                    }
+                }
+            const auto bytes = static_cast<const char*>(data);
+            buffer.insert(buffer.end(), bytes, bytes + size);
+            };
+        const auto writeValue = [&writeBytes](const auto value)
+            { writeBytes(&value, sizeof(value)); };
+        const auto writeString = [&writeBytes, &writeValue](const wxString& str)
+            {
+            const auto utf8Str = str.ToUTF8();
+            writeValue(static_cast<uint64_t>(utf8Str.length()));
+            writeBytes(utf8Str.data(), utf8Str.length());
+            };
+
+        // header
+        writeBytes(m_binaryFileSignature.data(), m_binaryFileSignature.size());
+        writeValue(m_binaryFileVersion);
+        writeValue(m_binaryByteOrderMark);
+        writeString(GetName());
+        writeValue(static_cast<uint64_t>(GetRowCount()));
+        writeValue(static_cast<uint64_t>(GetContinuousColumns().size()));
+        writeValue(static_cast<uint64_t>(GetCategoricalColumns().size()));
+        writeValue(static_cast<uint64_t>(GetDateColumns().size()));
+
+        // ID
+        writeString(GetIdColumn().GetTitle());
+        for (size_t i = 0; i < GetIdColumn().GetRowCount(); ++i)
+            { writeString(GetIdColumn().GetValue(i)); }
+        // continuous
+        for (const auto& column : GetContinuousColumns())
+            {
+            writeString(column.GetTitle());
+            if (column.GetStorage() == ContinuousStorage::Double)
+                { writeBytes(column.m_data.data(), GetRowCount() * sizeof(double)); }
+            else
+                {
+                // narrowed values are saved as doubles (without building a widened copy of them)
+                for (size_t i = 0; i < GetRowCount(); ++i)
+                    { writeValue(column.GetValue(i)); }
+                }
             }
-        fileText.Trim(true).Trim(false);
+        // categoricals
+        for (const auto& column : GetCategoricalColumns())
+            {
+            writeString(column.GetTitle());
+            writeValue(static_cast<uint64_t>(column.GetStringTable().size()));
+            for (const auto& [code, label] : column.GetStringTable())
+                {
+                writeValue(code);
+                writeString(label);
+                }
+            writeBytes(column.m_data.data(), GetRowCount() * sizeof(GroupIdType));
+            }
+        // dates
+        std::vector<int64_t> dateValues(GetRowCount());
+        for (const auto& column : GetDateColumns())
+            {
+            writeString(column.GetTitle());
+            std::transform(column.m_data.cbegin(), column.m_data.cend(), dateValues.begin(),
+                [](const auto& dt)
+                    {
+                    return dt.IsValid() ? static_cast<int64_t>(dt.GetValue().GetValue()) :
+                                          std::numeric_limits<int64_t>::min();
+                    });
+            writeBytes(dateValues.data(), dateValues.size() * sizeof(int64_t));
+            }
+        flushBuffer();
+        }
 
-        m_name = wxFileName(filePath).GetName();
+    //----------------------------------------------
+    void Dataset::ImportBinary(const wxString& filePath)
+        {
+        MemoryMappedFile fileMap;
+        bool isMapped{ false };
+        try
+            { isMapped = fileMap.MapFile(filePath, true, true); }
+        catch (...)
+            { isMapped = false; }
+        if (!isMapped)
+            {
+            throw std::runtime_error(
+                wxString::Format(_(L"'%s': unable to open dataset file."), filePath).ToUTF8());
+            }
 
-        std::vector<std::vector<wxString>> dataStrings;
+        const char* currentPosition = static_cast<const char*>(fileMap.GetStream());
+        const char* const fileEnd = currentPosition + fileMap.GetMapSize();
+        const auto throwInvalidFile = [&filePath]()
+            {
+            throw std::runtime_error(
+                wxString::Format(_(L"'%s': invalid or corrupt dataset file."), filePath).ToUTF8());
+            };
+        const auto readBytes = [&](void* data, const size_t size)
+            {
+            if (static_cast<size_t>(fileEnd - currentPosition) < size)
+                { throwInvalidFile(); }
+            if (size > 0)
+                { std::memcpy(data, currentPosition, size); }
+            currentPosition += size;
+            };
+        const auto readValue = [&readBytes](auto& value)
+            { readBytes(&value, sizeof(value)); };
+        const auto readString = [&]()
+            {
+            uint64_t length{ 0 };
+            readValue(length);
+            if (static_cast<uint64_t>(fileEnd - currentPosition) < length)
+                { throwInvalidFile(); }
+            const auto str = wxString::FromUTF8(currentPosition, static_cast<size_t>(length));
+            currentPosition += length;
+            return str;
+            };
+        // reads an array of values, making sure that the file actually has that much data
+        // before allocating anything
+        const auto readValues = [&](auto& values, const size_t count)
+            {
+            using ValueType = typename std::remove_reference_t<decltype(values)>::value_type;
+            if (static_cast<size_t>(fileEnd - currentPosition) / sizeof(ValueType) < count)
+                { throwInvalidFile(); }
+            values.resize(count);
+            readBytes(values.data(), count * sizeof(ValueType));
+            };
 
-        lily_of_the_valley::text_matrix<wxString> importer{ &dataStrings };
+        // header
+        std::array<char, 4> signature{ 0 };
+        uint32_t version{ 0 }, byteOrderMark{ 0 };
+        readBytes(signature.data(), signature.size());
+        readValue(version);
+        readValue(byteOrderMark);
+        if (signature != m_binaryFileSignature || version != m_binaryFileVersion ||
+            byteOrderMark != m_binaryByteOrderMark)
+            { throwInvalidFile(); }
+        const wxString datasetName = readString();
+        uint64_t rowCount{ 0 }, continuousCount{ 0 }, categoricalCount{ 0 }, dateCount{ 0 };
+        readValue(rowCount);
+        readValue(continuousCount);
+        readValue(categoricalCount);
+        readValue(dateCount);
+        // every row has at least the length of its ID
+        if (static_cast<uint64_t>(fileEnd - currentPosition) / sizeof(uint64_t) < rowCount)
+            { throwInvalidFile(); }
 
-        // skip the header
-        lily_of_the_valley::standard_delimited_character_column
-            noReadColumn(lily_of_the_valley::text_column_delimited_character_parser{ delimiter, false });
-        lily_of_the_valley::text_row<wxString> noReadRow{ 1 };
-        noReadRow.add_column(noReadColumn);
-        importer.add_row(noReadRow);
+        // ID
+        IdentifierColumn idColumn{ readString() };
+        idColumn.m_data.reserve(rowCount);
+        for (uint64_t i = 0; i < rowCount; ++i)
+            { idColumn.m_data.push_back(readString()); }
+        // continuous
+        std::vector<Column<double>> continuousColumns;
+        for (uint64_t i = 0; i < continuousCount; ++i)
+            {
+            continuousColumns.emplace_back(readString());
+            readValues(continuousColumns.back().m_data, rowCount);
+            }
+        // categoricals
+        std::vector<ColumnWithStringTable> categoricalColumns;
+        for (uint64_t i = 0; i < categoricalCount; ++i)
+            {
+            categoricalColumns.emplace_back(readString());
+            uint64_t stringCount{ 0 };
+            readValue(stringCount);
+            for (uint64_t j = 0; j < stringCount; ++j)
+                {
+                GroupIdType code{ 0 };
+                readValue(code);
+                categoricalColumns.back().GetStringTable().insert(std::make_pair(code, readString()));
+                }
+            readValues(categoricalColumns.back().m_data, rowCount);
+            }
+        // dates
+        std::vector<Column<wxDateTime>> dateColumns;
+        std::vector<int64_t> dateValues;
+        for (uint64_t i = 0; i < dateCount; ++i)
+            {
+            dateColumns.emplace_back(readString());
+            readValues(dateValues, rowCount);
+            dateColumns.back().m_data.reserve(rowCount);
+            for (const auto dateValue : dateValues)
+                {
+                dateColumns.back().m_data.push_back(
+                    (dateValue == std::numeric_limits<int64_t>::min()) ?
+                        wxInvalidDateTime : wxDateTime(wxLongLong(dateValue)));
+                }
+            }
+
+        // everything was read successfully, so replace the current data
+        m_name = datasetName;
+        m_idColumn = std::move(idColumn);
+        m_continuousColumns = std::move(continuousColumns);
+        m_categoricalColumns = std::move(categoricalColumns);
+        m_dateColumns = std::move(dateColumns);
+        RebuildColumnIndices();
+        }
+
+    //----------------------------------------------
+    std::pair<lily_of_the_valley::text_row<wxString>, size_t> Dataset::ProjectImportColumns(
+        ImportColumnMap& columnMap, const size_t columnCount, const wchar_t delimiter)
+        {
+        // the file's columns being imported (in order), and where they will be in the rows read
+        std::map<size_t, size_t> projectedIndices;
+        if (columnMap.m_idColumnIndex)
+            { projectedIndices.insert(std::make_pair(columnMap.m_idColumnIndex.value(), 0)); }
+        const auto addIndices = [&projectedIndices](const auto& indices)
+            {
+            for (const auto& index : indices)
+                {
+                if (index)
+                    { projectedIndices.insert(std::make_pair(index.value().m_index, 0)); }
+                }
+            };
+        addIndices(columnMap.m_dateColumnIndices);
+        addIndices(columnMap.m_catColumnIndices);
+        addIndices(columnMap.m_continuousColumnIndices);
 
-        lily_of_the_valley::standard_delimited_character_column
-            deliminatedColumn(lily_of_the_valley::text_column_delimited_character_parser{ delimiter });
         lily_of_the_valley::text_row<wxString> row;
-        row.add_column(deliminatedColumn);
-        importer.add_row(row);
+        // nothing being imported, so just read the rows in as-is
+        // (empty rows will still be added to the dataset)
+        if (projectedIndices.empty())
+            {
+            lily_of_the_valley::standard_delimited_character_column
+                deliminatedColumn(lily_of_the_valley::text_column_delimited_character_parser{ delimiter });
+            row.add_column(deliminatedColumn);
+            return std::make_pair(row, columnCount);
+            }
 
-        lily_of_the_valley::text_preview preview;
-        // see how many lines are in the file and resize the container
-        const size_t rowCount = preview(fileText, delimiter, false, false);
-        if (rowCount > 0)
+        lily_of_the_valley::standard_delimited_character_column
+            readColumn(lily_of_the_valley::text_column_delimited_character_parser{ delimiter }, 1);
+        size_t nextColumn{ 0 }, projectedIndex{ 0 };
+        for (auto& [fileIndex, rowIndex] : projectedIndices)
             {
-            dataStrings.resize(rowCount);
-            importer.read(fileText, rowCount, preview.get_header_names().size(), false);
-            Reserve(rowCount);
+            if (fileIndex > nextColumn)
+                {
+                lily_of_the_valley::standard_delimited_character_column
+                    skipColumns(lily_of_the_valley::text_column_delimited_character_parser{ delimiter, false },
+                                fileIndex - nextColumn);
+                row.add_column(skipColumns);
+                }
+            row.add_column(readColumn);
+            rowIndex = projectedIndex++;
+            nextColumn = fileIndex + 1;
             }
-        else
-            { return; }
+        // skip the rest of the line
+        lily_of_the_valley::standard_delimited_character_column
+            noReadColumn(lily_of_the_valley::text_column_delimited_character_parser{ delimiter, false });
+        row.add_column(noReadColumn);
+
+        // remap the columns to their positions in the projected rows
+        if (columnMap.m_idColumnIndex)
+            { columnMap.m_idColumnIndex = projectedIndices[columnMap.m_idColumnIndex.value()]; }
+        const auto remapIndices = [&projectedIndices](auto& indices)
+            {
+            for (auto& index : indices)
+                {
+                if (index)
+                    { index.value().m_index = projectedIndices[index.value().m_index]; }
+                }
+            };
+        remapIndices(columnMap.m_dateColumnIndices);
+        remapIndices(columnMap.m_catColumnIndices);
+        remapIndices(columnMap.m_continuousColumnIndices);
+
+        return std::make_pair(row, projectedIndices.size());
+        }
 
+    //----------------------------------------------
+    Dataset::ImportColumnMap Dataset::MapImportColumns(
+        const std::vector<std::wstring>& headerNames, const ImportInfo& info)
+        {
         // checks for columns client requested that aren't in the file
-        const auto throwIfColumnNotFound = [&preview](const auto& columnName,
-                                                      const auto& foundIterator,
-                                                      const bool allowEmptyColumnName)
+        const auto throwIfColumnNotFound = [&headerNames](const auto& columnName,
+                                                          const auto& foundIterator,
+                                                          const bool allowEmptyColumnName)
             {
             if (allowEmptyColumnName && columnName.empty())
                 { return; }
-            if (foundIterator == preview.get_header_names().cend())
+            if (foundIterator == headerNames.cend())
                 {
                 const wxString errorMsg = wxString::Format(L"'%s': column not found!", columnName.c_str());
                 throw std::runtime_error(errorMsg.ToUTF8());
                 }
             };
 
-        // column index with specialized import method
-        struct catIndexInfo
-            {
-            size_t m_index{ 0 };
-            CategoricalImportMethod m_importMethod{ CategoricalImportMethod::ReadAsStrings };
-            GroupIdType m_mdCode{ 0 };
-            };
-
-        // column index with specialized import method
-        struct dateIndexInfo
-            {
-            size_t m_index{ 0 };
-            DateImportMethod m_importMethod{ DateImportMethod::Automatic };
-            wxString m_formatStr;
-            };
+        ImportColumnMap columnMap;
 
         // find the column indices into the data that match the column names
         // from the client and map them as they requested
-        const auto idColumnIter = std::find_if(preview.get_header_names().cbegin(),
-            preview.get_header_names().cend(),
+        const auto idColumnIter = std::find_if(headerNames.cbegin(),
+            headerNames.cend(),
             [&info](const auto& item) noexcept
                 { return info.m_idColumn.CmpNoCase(item.c_str()) == 0; });
         throwIfColumnNotFound(info.m_idColumn, idColumnIter, true);
-        const std::optional<size_t> idColumnIndex = (idColumnIter != preview.get_header_names().cend()) ?
-            std::optional<size_t>(idColumnIter - preview.get_header_names().cbegin()) : std::nullopt;
+        columnMap.m_idColumnIndex = (idColumnIter != headerNames.cend()) ?
+            std::optional<size_t>(idColumnIter - headerNames.cbegin()) : std::nullopt;
 
         // find the supplied date columns
-        std::vector<std::optional<dateIndexInfo>> dateColumnIndices;
         for (const auto& dateColumn : info.m_dateColumns)
             {
-            const auto dateColumnIter = std::find_if(preview.get_header_names().cbegin(),
-                preview.get_header_names().cend(),
+            const auto dateColumnIter = std::find_if(headerNames.cbegin(),
+                headerNames.cend(),
                 [&dateColumn](const auto& item) noexcept
                     { return dateColumn.m_columnName.CmpNoCase(item.c_str()) == 0; });
             throwIfColumnNotFound(dateColumn.m_columnName, dateColumnIter, false);
-            dateColumnIndices.push_back(
-                (dateColumnIter != preview.get_header_names().cend()) ?
-                std::optional<dateIndexInfo>(dateIndexInfo{
-                    static_cast<size_t>(dateColumnIter - preview.get_header_names().cbegin()),
+            columnMap.m_dateColumnIndices.push_back(
+                (dateColumnIter != headerNames.cend()) ?
+                std::optional<DateIndexInfo>(DateIndexInfo{
+                    static_cast<size_t>(dateColumnIter - headerNames.cbegin()),
                     dateColumn.m_importMethod, dateColumn.m_strptimeFormatString }) :
                 std::nullopt);
             }
 
         // find the supplied categorical columns
-        std::vector<std::optional<catIndexInfo>> catColumnIndices;
         for (const auto& catColumn : info.m_categoricalColumns)
             {
-            const auto catColumnIter = std::find_if(preview.get_header_names().cbegin(),
-                preview.get_header_names().cend(),
+            const auto catColumnIter = std::find_if(headerNames.cbegin(),
+                headerNames.cend(),
                 [&catColumn](const auto& item) noexcept
                     { return catColumn.m_columnName.CmpNoCase(item.c_str()) == 0; });
             throwIfColumnNotFound(catColumn.m_columnName, catColumnIter, false);
-            catColumnIndices.push_back(
-                (catColumnIter != preview.get_header_names().cend()) ?
-                std::optional<catIndexInfo>(catIndexInfo{
-                    static_cast<size_t>(catColumnIter - preview.get_header_names().cbegin()),
+            columnMap.m_catColumnIndices.push_back(
+                (catColumnIter != headerNames.cend()) ?
+                std::optional<CategoricalIndexInfo>(CategoricalIndexInfo{
+                    static_cast<size_t>(catColumnIter - headerNames.cbegin()),
                                         catColumn.m_importMethod, catColumn.m_mdCode }) :
                 std::nullopt);
             }
 
         // find the supplied continuous columns
-        std::vector<std::optional<size_t>> continuousColumnIndices;
         for (const auto& continuousColumn : info.m_continuousColumns)
             {
-            const auto continuousColumnIter = std::find_if(preview.get_header_names().cbegin(),
-                preview.get_header_names().cend(),
+            const auto continuousColumnIter = std::find_if(headerNames.cbegin(),
+                headerNames.cend(),
                 [&continuousColumn](const auto& item) noexcept
-                    { return continuousColumn.CmpNoCase(item.c_str()) == 0; });
-            throwIfColumnNotFound(continuousColumn, continuousColumnIter, false);
-            continuousColumnIndices.push_back(
-                (continuousColumnIter != preview.get_header_names().cend()) ?
-                std::optional<size_t>(continuousColumnIter - preview.get_header_names().cbegin()) :
+                    { return continuousColumn.m_columnName.CmpNoCase(item.c_str()) == 0; });
+            throwIfColumnNotFound(continuousColumn.m_columnName, continuousColumnIter, false);
+            columnMap.m_continuousColumnIndices.push_back(
+                (continuousColumnIter != headerNames.cend()) ?
+                std::optional<ContinuousIndexInfo>(ContinuousIndexInfo{
+                    static_cast<size_t>(continuousColumnIter - headerNames.cbegin()),
+                    continuousColumn.m_importMethod, continuousColumn.m_decimalSeparator }) :
                 std::nullopt);
             }
 
-        // performs user-provided text replacement commands
-        const auto replaceStrings = [&](const wxString& str)
-            {
-            wxString alteredStr{ str };
-            for (const auto& [re, replacement] : info.m_textImportReplacements)
-                {
-                if (re && re->IsValid())
-                    { re->ReplaceAll(&alteredStr, replacement); }
-                }
-            return alteredStr;
-            };
+        return columnMap;
+        }
 
-        // setup the string tables
-        struct StringTableBuilder
+    //----------------------------------------------
+    void Dataset::ImportTextRows(const std::vector<std::vector<wxString>>& dataStrings,
+                                 const ImportColumnMap& columnMap, const ImportInfo& info,
+                                 ImportState& state)
+        {
+        if (info.m_parallelImport)
             {
-        public:
-            [[nodiscard]] GroupIdType LoadCode(const wxString& code)
-                {
-                auto foundGroup = m_strings.find(code);
-                if (foundGroup == m_strings.end())
-                    {
-                    foundGroup = m_strings.insert(
-                        std::make_pair(code, currentId++)).first;
-                    }
-                return foundGroup->second;
-                }
-            [[nodiscard]] const auto& GetStrings() const noexcept
-                { return m_strings; }
-        private:
-            GroupIdType currentId{ 0 };
-            std::map<wxString, GroupIdType, StringCmpNoCase> m_strings;
-            };
-
-        std::vector<StringTableBuilder> categoricalVars{ catColumnIndices.size() };
+            ImportTextColumns(dataStrings, columnMap, info, state);
+            return;
+            }
 
         // load the data
         RowInfo currentItem;
@@ -704,36 +2005,36 @@ namespace Wisteria::Data
 
             // dates
             dateValues.clear();
-            for (size_t i = 0; i < dateColumnIndices.size(); ++i)
+            for (size_t i = 0; i < columnMap.m_dateColumnIndices.size(); ++i)
                 {
-                if (dateColumnIndices.at(i))
+                if (columnMap.m_dateColumnIndices.at(i))
                     {
-                    const auto& currentDateInfo{ dateColumnIndices.at(i).value() };
+                    const auto& currentDateInfo{ columnMap.m_dateColumnIndices.at(i).value() };
                     dateValues.emplace_back(
-                        ConvertToDate(currentRow.at(currentDateInfo.m_index),
-                            currentDateInfo.m_importMethod, currentDateInfo.m_formatStr));
+                        state.m_dateParsers.at(i).Parse(currentRow.at(currentDateInfo.m_index)));
                     }
                 }
             currentItem.Dates(dateValues);
 
             // categoricals
             catCodes.clear();
-            for (size_t i = 0; i < catColumnIndices.size(); ++i)
+            for (size_t i = 0; i < columnMap.m_catColumnIndices.size(); ++i)
                 {
-                if (catColumnIndices.at(i))
+                if (columnMap.m_catColumnIndices.at(i))
                     {
-                    if (catColumnIndices.at(i).value().m_importMethod == CategoricalImportMethod::ReadAsStrings)
+                    const auto& currentCatInfo{ columnMap.m_catColumnIndices.at(i).value() };
+                    if (currentCatInfo.m_importMethod == CategoricalImportMethod::ReadAsStrings)
                         {
-                        catCodes.emplace_back(
-                            categoricalVars.at(i).LoadCode(
-                                replaceStrings(currentRow.at(catColumnIndices.at(i).value().m_index))) );
+                        // performs user-provided text replacement commands
+                        catCodes.emplace_back(state.m_categoricalVars.at(i).LoadCode(
+                            ApplyReplacementStrings(currentRow.at(currentCatInfo.m_index),
+                                                    info, state.m_replacedStrings)));
                         }
                     else
                         {
                         catCodes.emplace_back(
-                            ConvertToGroupId(
-                                currentRow.at(catColumnIndices.at(i).value().m_index),
-                                catColumnIndices.at(i).value().m_mdCode));
+                            ConvertToGroupId(currentRow.at(currentCatInfo.m_index),
+                                             currentCatInfo.m_mdCode));
                         }
                     }
                 }
@@ -741,34 +2042,596 @@ namespace Wisteria::Data
 
             // continuous columns
             continuousValues.clear();
-            for (size_t i = 0; i < continuousColumnIndices.size(); ++i)
+            for (size_t i = 0; i < columnMap.m_continuousColumnIndices.size(); ++i)
                 {
-                if (continuousColumnIndices.at(i))
+                if (columnMap.m_continuousColumnIndices.at(i))
                     {
+                    const auto& currentContinuousInfo{ columnMap.m_continuousColumnIndices.at(i).value() };
                     continuousValues.emplace_back(
-                        ConvertToDouble(currentRow.at(continuousColumnIndices.at(i).value())));
+                        (currentContinuousInfo.m_importMethod == ContinuousImportMethod::Fast) ?
+                            ConvertToDoubleFast(currentRow.at(currentContinuousInfo.m_index),
+                                                currentContinuousInfo.m_decimalSeparator) :
+                            ConvertToDouble(currentRow.at(currentContinuousInfo.m_index)));
                     }
                 }
             currentItem.Continuous(continuousValues);
 
             // ID column
-            if (idColumnIndex)
-                { currentItem.Id(currentRow.at(idColumnIndex.value())); }
+            if (columnMap.m_idColumnIndex)
+                { currentItem.Id(currentRow.at(columnMap.m_idColumnIndex.value())); }
             AddRow(currentItem);
             }
-        // set string tables for categoricals
-        // (just applies for columns using CategoricalImportMethod::ReadAsStrings)
+        }
+
+    //----------------------------------------------
+    void Dataset::ImportTextColumns(const std::vector<std::vector<wxString>>& dataStrings,
+                                    const ImportColumnMap& columnMap, const ImportInfo& info,
+                                    ImportState& state)
+        {
+        if (dataStrings.empty())
+            { return; }
+
+        // add the requested columns (if not already added from a previous chunk)
+        // and grow them to fit the new rows, so that each column can be written to independently
+        SetColumnNames(info);
+        const size_t startRow = GetRowCount();
+        const size_t rowCount = dataStrings.size();
+        m_idColumn.Resize(startRow + rowCount);
+        for (auto& column : m_dateColumns)
+            { column.Resize(startRow + rowCount, wxInvalidDateTime); }
+        for (auto& column : m_categoricalColumns)
+            { column.Resize(startRow + rowCount, 0); }
+        for (auto& column : m_continuousColumns)
+            { column.Resize(startRow + rowCount, std::numeric_limits<double>::quiet_NaN()); }
+
+        // each task converts one column of text into its respective dataset column
+        std::vector<std::function<void()>> columnTasks;
+        if (columnMap.m_idColumnIndex)
+            {
+            columnTasks.emplace_back([&, textIndex = columnMap.m_idColumnIndex.value()]()
+                {
+                auto& values = m_idColumn.m_data;
+                for (size_t i = 0; i < rowCount; ++i)
+                    { values[startRow + i] = dataStrings[i].at(textIndex); }
+                });
+            }
+
+        for (size_t colIndex = 0; colIndex < columnMap.m_dateColumnIndices.size(); ++colIndex)
+            {
+            if (!columnMap.m_dateColumnIndices.at(colIndex))
+                { continue; }
+            columnTasks.emplace_back([&, colIndex]()
+                {
+                const auto& currentDateInfo{ columnMap.m_dateColumnIndices[colIndex].value() };
+                auto& dateParser = state.m_dateParsers[colIndex];
+                auto& values = m_dateColumns[colIndex].m_data;
+                for (size_t i = 0; i < rowCount; ++i)
+                    { values[startRow + i] = dateParser.Parse(dataStrings[i].at(currentDateInfo.m_index)); }
+                });
+            }
+
+        // wxRegEx objects store their matches (and the replaced strings are cached
+        // in the import state), so they can't be shared between threads.
+        // Because of that, any categorical columns using the replacement regexes are
+        // converted together (sequentially) in one task.
+        const auto convertCategorical = [&](const size_t colIndex)
+            {
+            const auto& currentCatInfo{ columnMap.m_catColumnIndices[colIndex].value() };
+            auto& values = m_categoricalColumns[colIndex].m_data;
+            if (currentCatInfo.m_importMethod == CategoricalImportMethod::ReadAsStrings)
+                {
+                auto& stringTable = state.m_categoricalVars[colIndex];
+                for (size_t i = 0; i < rowCount; ++i)
+                    {
+                    values[startRow + i] = stringTable.LoadCode(
+                        ApplyReplacementStrings(dataStrings[i].at(currentCatInfo.m_index),
+                                                info, state.m_replacedStrings));
+                    }
+                }
+            else
+                {
+                for (size_t i = 0; i < rowCount; ++i)
+                    {
+                    values[startRow + i] =
+                        ConvertToGroupId(dataStrings[i].at(currentCatInfo.m_index),
+                                         currentCatInfo.m_mdCode);
+                    }
+                }
+            };
+        std::vector<size_t> replacementCategoricalColumns;
+        for (size_t colIndex = 0; colIndex < columnMap.m_catColumnIndices.size(); ++colIndex)
+            {
+            if (!columnMap.m_catColumnIndices.at(colIndex))
+                { continue; }
+            if (columnMap.m_catColumnIndices.at(colIndex).value().m_importMethod ==
+                    CategoricalImportMethod::ReadAsStrings &&
+                info.m_textImportReplacements.size())
+                { replacementCategoricalColumns.push_back(colIndex); }
+            else
+                { columnTasks.emplace_back([&convertCategorical, colIndex]() { convertCategorical(colIndex); }); }
+            }
+        if (replacementCategoricalColumns.size())
+            {
+            columnTasks.emplace_back([&convertCategorical, &replacementCategoricalColumns]()
+                {
+                for (const auto colIndex : replacementCategoricalColumns)
+                    { convertCategorical(colIndex); }
+                });
+            }
+
+        for (size_t colIndex = 0; colIndex < columnMap.m_continuousColumnIndices.size(); ++colIndex)
+            {
+            if (!columnMap.m_continuousColumnIndices.at(colIndex))
+                { continue; }
+            columnTasks.emplace_back([&, colIndex]()
+                {
+                const auto& currentContinuousInfo{ columnMap.m_continuousColumnIndices[colIndex].value() };
+                auto& values = m_continuousColumns[colIndex].m_data;
+                if (currentContinuousInfo.m_importMethod == ContinuousImportMethod::Fast)
+                    {
+                    for (size_t i = 0; i < rowCount; ++i)
+                        {
+                        values[startRow + i] =
+                            ConvertToDoubleFast(dataStrings[i].at(currentContinuousInfo.m_index),
+                                                currentContinuousInfo.m_decimalSeparator);
+                        }
+                    }
+                else
+                    {
+                    for (size_t i = 0; i < rowCount; ++i)
+                        {
+                        values[startRow + i] =
+                            ConvertToDouble(dataStrings[i].at(currentContinuousInfo.m_index));
+                        }
+                    }
+                });
+            }
+
+        std::for_each(std::execution::par, columnTasks.begin(), columnTasks.end(),
+            [](const auto& columnTask)
+                { columnTask(); });
+        }
+
+    //----------------------------------------------
+    void Dataset::ApplyImportStringTables(const std::vector<StringTableBuilder>& categoricalVars)
+        {
+        // set string tables for categoricals (columns using
+        // CategoricalImportMethod::ReadAsIntegers will just have their seeded tables, if any)
         for (size_t i = 0; i < categoricalVars.size(); ++i)
+            { GetCategoricalColumn(i).GetStringTable() = categoricalVars.at(i).GetStrings(); }
+        }
+
+    //----------------------------------------------
+    bool Dataset::ImportTextChunked(const wxString& filePath, const ImportInfo& info,
+                                    const wchar_t delimiter)
+        {
+        wxFile fl(filePath);
+        if (!fl.IsOpened())
+            {
+            throw std::runtime_error(wxString::Format(_(L"'%s':\n%s"), filePath,
+                                     wxSysErrorMsg(fl.GetLastError())).ToUTF8());
+            }
+        const auto fileLength = static_cast<size_t>(fl.Length());
+        std::vector<char> buffer;
+        buffer.reserve(info.m_chunkSize + 1);
+
+        // wxConvAuto remembers the BOM that it finds in the first block,
+        // so reuse it for all of them
+        wxConvAuto conv;
+        bool atEndOfFile{ false };
+        bool isFirstChunk{ true };
+
+        const auto fillBuffer = [&](const size_t minimumSize)
             {
-            GetCategoricalColumn(i).GetStringTable().clear();
-            for (const auto& item : categoricalVars.at(i).GetStrings())
+            while (!atEndOfFile && buffer.size() < minimumSize)
                 {
-                GetCategoricalColumn(i).GetStringTable().insert(
-                    std::make_pair(item.second, item.first));
+                const auto previousSize = buffer.size();
+                buffer.resize(previousSize + info.m_chunkSize);
+                const auto bytesRead = fl.Read(buffer.data() + previousSize, info.m_chunkSize);
+                if (bytesRead == wxInvalidOffset)
+                    {
+                    throw std::runtime_error(wxString::Format(_(L"'%s':\n%s"), filePath,
+                                             wxSysErrorMsg(fl.GetLastError())).ToUTF8());
+                    }
+                buffer.resize(previousSize + bytesRead);
+                if (static_cast<size_t>(bytesRead) < info.m_chunkSize || fl.Eof())
+                    { atEndOfFile = true; }
                 }
+            };
+
+        fillBuffer(info.m_chunkSize);
+        // multibyte line ends can't be found by simply looking for a '\n' byte,
+        // so let the caller read these the regular way
+        switch (wxConvAuto::DetectBOM(buffer.data(), buffer.size()))
+            {
+        case wxConvAuto::BOM_UTF16BE:
+        case wxConvAuto::BOM_UTF16LE:
+        case wxConvAuto::BOM_UTF32BE:
+        case wxConvAuto::BOM_UTF32LE:
+            return false;
+        default:
+            break;
             }
 
+        lily_of_the_valley::text_row<wxString> row;
+
+        ImportColumnMap columnMap;
+        ImportState state;
+        std::vector<std::vector<wxString>> dataStrings;
+        size_t columnCount{ 0 };
+
+        while (buffer.size())
+            {
+            // find the end of the last complete line in the block, reading more
+            // if this block doesn't contain a full line. Line ends inside of quotes
+            // are part of a (multiline) cell, so the block can't be split there.
+            // (The block always starts at the start of a row, so it starts outside of quotes.)
+            size_t scannedLength{ 0 };
+            bool insideQuotes{ false };
+            std::optional<size_t> lastLineEnd;
+            // the last line end, even if inside of quotes
+            std::optional<size_t> lastAnyLineEnd;
+            const auto scanForLineEnd = [&]()
+                {
+                for (; scannedLength < buffer.size(); ++scannedLength)
+                    {
+                    // doubled (escaped) quotes toggle this twice, so they cancel out
+                    if (buffer[scannedLength] == '"')
+                        { insideQuotes = !insideQuotes; }
+                    else if (buffer[scannedLength] == '\n')
+                        {
+                        lastAnyLineEnd = scannedLength;
+                        if (!insideQuotes)
+                            { lastLineEnd = scannedLength; }
+                        }
+                    }
+                };
+            scanForLineEnd();
+            while (!lastLineEnd && !atEndOfFile)
+                {
+                // A stray quote would make the rest of the file look like one quoted cell,
+                // growing this block to the end of the file. Rather than reading
+                // the whole file into memory, assume that the quote is unbalanced
+                // and split at the last line end.
+                if (lastAnyLineEnd && buffer.size() >= info.m_chunkSize * MAX_QUOTED_BLOCK_CHUNKS)
+                    {
+                    lastLineEnd = lastAnyLineEnd;
+                    break;
+                    }
+                fillBuffer(buffer.size() + info.m_chunkSize);
+                scanForLineEnd();
+                }
+            // don't include the newline at the end of the block, otherwise it will be
+            // seen as an extra blank line
+            const size_t blockSize = (atEndOfFile || !lastLineEnd) ?
+                buffer.size() : lastLineEnd.value() + 1;
+            const size_t textLength = (blockSize == buffer.size()) ? blockSize : blockSize - 1;
+
+            wxString fileText(buffer.data(), conv, textLength);
+            if (isFirstChunk)
+                { fileText.Trim(false); }
+            if (atEndOfFile && blockSize == buffer.size())
+                { fileText.Trim(true); }
+            else if (fileText.length() && fileText.Last() == L'\r')
+                { fileText.RemoveLast(); }
+
+            // move anything after the last line end to the front of the buffer
+            buffer.erase(buffer.begin(), buffer.begin() + blockSize);
+
+            lily_of_the_valley::text_matrix<wxString> importer{ &dataStrings };
+            if (isFirstChunk)
+                {
+                // skip the header
+                lily_of_the_valley::standard_delimited_character_column
+                    noReadColumn(lily_of_the_valley::text_column_delimited_character_parser{ delimiter, false });
+                lily_of_the_valley::text_row<wxString> noReadRow{ 1 };
+                noReadRow.add_column(noReadColumn);
+                importer.add_row(noReadRow);
+
+                if (fileText.empty())
+                    { return true; }
+                lily_of_the_valley::text_preview preview;
+                preview.read_header(fileText, delimiter);
+                columnMap = MapImportColumns(preview.get_header_names(), info);
+                state = CreateImportState(columnMap, info);
+                std::tie(row, columnCount) =
+                    ProjectImportColumns(columnMap, preview.get_header_names().size(), delimiter);
+                }
+            importer.add_row(row);
+            importer.read_all(fileText, columnCount, false);
+            if (isFirstChunk)
+                {
+                // estimate the number of rows in the file from this block
+                // (unless the client knows it) so that the columns
+                // don't have to keep reallocating
+                if (info.m_rowCountHint > 0)
+                    { Reserve(info.m_rowCountHint); }
+                else if (textLength > 0)
+                    {
+                    Reserve(static_cast<size_t>(
+                        (static_cast<double>(fileLength) / textLength) * (dataStrings.size() + 1)));
+                    }
+                }
+            ImportTextRows(dataStrings, columnMap, info, state);
+            isFirstChunk = false;
+
+            fillBuffer(buffer.size() + info.m_chunkSize);
+            }
+
+        ApplyImportStringTables(state.m_categoricalVars);
+        return true;
+        }
+
+    //----------------------------------------------
+    bool Dataset::ImportTextMapped(const wxString& filePath, const ImportInfo& info,
+                                   const wchar_t delimiter)
+        {
+        // multibyte delimiters would require decoding the text first
+        if (delimiter > 0x7F)
+            { return false; }
+        const auto delim = static_cast<char>(delimiter);
+
+        MemoryMappedFile fileMap;
+        try
+            {
+            if (!fileMap.MapFile(filePath, true, false) ||
+                fileMap.GetMapSize() != static_cast<size_t>(wxFileName::GetSize(filePath).GetValue()))
+                { return false; }
+            }
+        catch (...)
+            { return false; }
+
+        const char* text = static_cast<const char*>(fileMap.GetStream());
+        const char* textEnd = text + fileMap.GetMapSize();
+        switch (wxConvAuto::DetectBOM(text, fileMap.GetMapSize()))
+            {
+        case wxConvAuto::BOM_UTF16BE:
+        case wxConvAuto::BOM_UTF16LE:
+        case wxConvAuto::BOM_UTF32BE:
+        case wxConvAuto::BOM_UTF32LE:
+            return false;
+        case wxConvAuto::BOM_UTF8:
+            text += 3;
+            break;
+        default:
+            break;
+            }
+
+        const auto isSpace = [](const char ch) noexcept
+            { return std::isspace(static_cast<unsigned char>(ch)); };
+        const auto isEol = [](const char ch) noexcept
+            { return (ch == 10 || ch == 13); };
+
+        // trim the whitespace around the entire file
+        while (text < textEnd && isSpace(text[0]))
+            { ++text; }
+        while (textEnd > text && isSpace(textEnd[-1]))
+            { --textEnd; }
+        if (text == textEnd)
+            { return true; }
+
+        // trims whitespace and quotes from around a cell (same as lily_of_the_valley::cell_trim)
+        const auto trimCell = [&isSpace](const char* start, const char* end) noexcept
+            {
+            if (start < end && start[0] == '\"')
+                { ++start; }
+            while (start < end && isSpace(start[0]))
+                { ++start; }
+            if (end > start && end[-1] == '\"')
+                { --end; }
+            while (end > start && isSpace(end[-1]))
+                { --end; }
+            return std::string_view(start, static_cast<size_t>(end - start));
+            };
+
+        // splits a line into cells (as views into the mapped file)
+        const auto splitLine = [&](const char* lineStart, const char* lineEnd,
+                                   std::vector<std::string_view>& cells)
+            {
+            cells.clear();
+            const char* currentPos = lineStart;
+            for (;;)
+                {
+                const char* cellStart = currentPos;
+                int32_t quoteStack{ 0 };
+                // allow delimiters if inside of set of double quotes
+                while (currentPos < lineEnd &&
+                       (currentPos[0] != delim || (quoteStack % 2 != 0)))
+                    {
+                    if (currentPos[0] == '\"')
+                        {
+                        // just step over doubled up (i.e., escaped) quote
+                        if (currentPos + 1 < lineEnd && currentPos[1] == '\"')
+                            { currentPos += 2; }
+                        else
+                            {
+                            ++currentPos;
+                            ++quoteStack;
+                            }
+                        }
+                    else
+                        { ++currentPos; }
+                    }
+                cells.push_back(trimCell(cellStart, std::min(currentPos, lineEnd)));
+                if (currentPos >= lineEnd)
+                    { break; }
+                ++currentPos; // step over the delimiter
+                }
+            };
+
+        // returns the end of the current line
+        const auto findLineEnd = [&](const char* lineStart) noexcept
+            { return std::find_if(lineStart, textEnd, isEol); };
+        // returns the start of the next line
+        const auto nextLine = [&](const char* lineEnd) noexcept
+            {
+            if (lineEnd < textEnd && lineEnd[0] == 13 &&
+                lineEnd + 1 < textEnd && lineEnd[1] == 10)
+                { return lineEnd + 2; }
+            return (lineEnd < textEnd) ? lineEnd + 1 : textEnd;
+            };
+
+        std::vector<std::string_view> cells;
+        const std::string_view emptyCell;
+        const auto getCell = [&cells, &emptyCell](const size_t index) noexcept
+            { return (index < cells.size()) ? cells[index] : emptyCell; };
+
+        // read the header
+        const char* lineEnd = findLineEnd(text);
+        splitLine(text, lineEnd, cells);
+        std::vector<std::wstring> headerNames;
+        headerNames.reserve(cells.size());
+        for (const auto& cell : cells)
+            { headerNames.push_back(ConvertUtf8ToString(cell).ToStdWstring()); }
+        const auto columnMap = MapImportColumns(headerNames, info);
+
+        // counting the line ends in the mapped file is cheap, so do that to
+        // allocate the columns up front (unless the client already knows this)
+        Reserve((info.m_rowCountHint > 0) ? info.m_rowCountHint :
+                static_cast<size_t>(std::count(text, textEnd, '\n')));
+
+        // the codes for labels that have already been decoded (keyed by their
+        // raw text in the file), so that only new labels need to be converted
+        auto state = CreateImportState(columnMap, info);
+        std::vector<std::unordered_map<std::string_view, GroupIdType>>
+            categoricalCodeCache{ columnMap.m_catColumnIndices.size() };
+
+        RowInfo currentItem;
+        std::vector<wxDateTime> dateValues;
+        std::vector<Data::GroupIdType> catCodes;
+        std::vector<double> continuousValues;
+        const char* currentLine = nextLine(lineEnd);
+        while (currentLine < textEnd)
+            {
+            lineEnd = findLineEnd(currentLine);
+            splitLine(currentLine, lineEnd, cells);
+            currentLine = nextLine(lineEnd);
+
+            // dates
+            dateValues.clear();
+            for (size_t i = 0; i < columnMap.m_dateColumnIndices.size(); ++i)
+                {
+                if (columnMap.m_dateColumnIndices.at(i))
+                    {
+                    dateValues.emplace_back(state.m_dateParsers.at(i).Parse(
+                        ConvertUtf8ToString(getCell(columnMap.m_dateColumnIndices.at(i).value().m_index))));
+                    }
+                }
+            currentItem.Dates(dateValues);
+
+            // categoricals
+            catCodes.clear();
+            for (size_t i = 0; i < columnMap.m_catColumnIndices.size(); ++i)
+                {
+                if (columnMap.m_catColumnIndices.at(i))
+                    {
+                    const auto& currentCatInfo{ columnMap.m_catColumnIndices.at(i).value() };
+                    const auto cell = getCell(currentCatInfo.m_index);
+                    if (currentCatInfo.m_importMethod == CategoricalImportMethod::ReadAsStrings)
+                        {
+                        auto& codeCache = categoricalCodeCache.at(i);
+                        auto cachedCode = codeCache.find(cell);
+                        if (cachedCode == codeCache.end())
+                            {
+                            wxString label = ConvertUtf8ToString(cell);
+                            ApplyReplacementStrings(label, info);
+                            cachedCode = codeCache.insert(
+                                std::make_pair(cell, state.m_categoricalVars.at(i).LoadCode(label))).first;
+                            }
+                        catCodes.emplace_back(cachedCode->second);
+                        }
+                    else
+                        { catCodes.emplace_back(ConvertUtf8ToGroupId(cell, currentCatInfo.m_mdCode)); }
+                    }
+                }
+            currentItem.Categoricals(catCodes);
+
+            // continuous columns
+            continuousValues.clear();
+            for (const auto& continuousInfo : columnMap.m_continuousColumnIndices)
+                {
+                if (continuousInfo)
+                    {
+                    continuousValues.emplace_back(
+                        ConvertUtf8ToDouble(getCell(continuousInfo.value().m_index),
+                                            continuousInfo.value().m_decimalSeparator));
+                    }
+                }
+            currentItem.Continuous(continuousValues);
+
+            // ID column
+            if (columnMap.m_idColumnIndex)
+                { currentItem.Id(ConvertUtf8ToString(getCell(columnMap.m_idColumnIndex.value()))); }
+            AddRow(currentItem);
+            }
+
+        ApplyImportStringTables(state.m_categoricalVars);
+        return true;
+        }
+
+    //----------------------------------------------
+    void Dataset::ImportText(const wxString& filePath, const ImportInfo& info,
+                             const wchar_t delimiter)
+        {
+        // reset
+        Clear();
+        m_dateColumns.clear();
+        m_categoricalColumns.clear();
+        m_continuousColumns.clear();
+        RebuildColumnIndices();
+
+        m_name = wxFileName(filePath).GetName();
+
+        // parse the file in place or read and convert it in blocks if requested
+        if ((info.m_memoryMapFile && ImportTextMapped(filePath, info, delimiter)) ||
+            (info.m_chunkSize > 0 && ImportTextChunked(filePath, info, delimiter)))
+            {
+            SetColumnNames(info);
+            ApplyStorageOptions(info);
+            return;
+            }
+
+        wxString fileText;
+        wxFile fl(filePath);
+        if (!fl.IsOpened() || !fl.ReadAll(&fileText))
+            {
+            throw std::runtime_error(wxString::Format(_(L"'%s':\n%s"), filePath,
+                                     wxSysErrorMsg(fl.GetLastError())).ToUTF8());
+            }
+        fileText.Trim(true).Trim(false);
+
+        std::vector<std::vector<wxString>> dataStrings;
+
+        lily_of_the_valley::text_matrix<wxString> importer{ &dataStrings };
+
+        // skip the header
+        lily_of_the_valley::standard_delimited_character_column
+            noReadColumn(lily_of_the_valley::text_column_delimited_character_parser{ delimiter, false });
+        lily_of_the_valley::text_row<wxString> noReadRow{ 1 };
+        noReadRow.add_column(noReadColumn);
+        importer.add_row(noReadRow);
+
+        if (fileText.empty())
+            { return; }
+        // read the header, and then the rest of the file in one pass
+        // (the rows will be added as they are read, so they don't need to be counted first)
+        lily_of_the_valley::text_preview preview;
+        preview.read_header(fileText, delimiter);
+        auto columnMap = MapImportColumns(preview.get_header_names(), info);
+
+        // only read the columns being imported
+        const auto [row, columnCount] =
+            ProjectImportColumns(columnMap, preview.get_header_names().size(), delimiter);
+        importer.add_row(row);
+        importer.read_all(fileText, columnCount, false, info.m_rowCountHint);
+        Reserve(dataStrings.size());
+
+        auto state = CreateImportState(columnMap, info);
+        ImportTextRows(dataStrings, columnMap, info, state);
+        ApplyImportStringTables(state.m_categoricalVars);
+
         // set the names for the columns
         SetColumnNames(info);
+        ApplyStorageOptions(info);
         }
     }
@@ -18,10 +18,22 @@
 #include <optional>
 #include <limits>
 #include <cinttypes>
+#include <array>
+#include <string_view>
+#include <charconv>
+#include <unordered_map>
+#include <functional>
+#include <execution>
+#include <cstring>
+#include <type_traits>
+#include <cmath>
+#include <numeric>
+#include <future>
 #include <wx/wx.h>
 #include <wx/string.h>
 #include <wx/colour.h>
 #include <wx/file.h>
+#include <wx/convauto.h>
 #include <wx/datetime.h>
 #include <wx/uilocale.h>
 #include <wx/filename.h>
@@ -29,7 +41,9 @@
 #include <wx/regex.h>
 #include "../import/text_matrix.h"
 #include "../import/text_preview.h"
+#include "../math/statistics.h"
 #include "../debug/debug_assert.h"
+#include "../util/lazycache.h"
 
 /** @brief %Data management classes for graphs.*/
 namespace Wisteria::Data
@@ -43,9 +57,80 @@ namespace Wisteria::Data
             { return lhs.CmpNoCase(rhs) < 0; };
         };
 
+    // Helper functor to hash wxStrings (case sensitively).
+    // This is useful as the hasher for unordered maps and sets.
+    class StringHash
+        {
+    public:
+        [[nodiscard]] size_t operator()(const wxString& str) const
+            { return std::hash<std::wstring_view>{}(std::wstring_view(str.wc_str(), str.length())); }
+        };
+
     // forward declarations for friendships
     class Dataset;
 
+    /// @brief Summary statistics for a continuous column.
+    /// @sa Column::GetSummary().
+    struct ColumnSummary
+        {
+        /// @brief The number of valid (i.e., non-NaN) values.
+        size_t m_validN{ 0 };
+        /// @brief The lowest valid value (or NaN if there are no valid values).
+        double m_min{ std::numeric_limits<double>::quiet_NaN() };
+        /// @brief The highest valid value (or NaN if there are no valid values).
+        double m_max{ std::numeric_limits<double>::quiet_NaN() };
+        /// @brief The sum of the valid values.
+        double m_sum{ 0 };
+        };
+
+    /// @brief How much memory a column (or dataset) is using.
+    /// @sa Column::GetMemoryUsage(), Dataset::GetMemoryUsage().
+    struct MemoryUsage
+        {
+        /// @brief The number of bytes used by the data (including string tables).
+        size_t m_dataBytes{ 0 };
+        /// @brief The number of bytes used by what is calculated from the data and cached
+        ///     (e.g., group indices and widened copies of narrowed values).
+        /// @details These are rebuilt when needed, so they can be released
+        ///     to free memory (see Dataset::ReleaseCaches()).
+        size_t m_cacheBytes{ 0 };
+        /// @returns The total number of bytes.
+        [[nodiscard]] size_t GetTotalBytes() const noexcept
+            { return m_dataBytes + m_cacheBytes; }
+        /// @brief Adds another object's memory usage to this one.
+        /// @param that The memory usage to add.
+        /// @returns A reference to this object.
+        MemoryUsage& operator+=(const MemoryUsage& that) noexcept
+            {
+            m_dataBytes += that.m_dataBytes;
+            m_cacheBytes += that.m_cacheBytes;
+            return *this;
+            }
+        };
+
+    /// @brief How a continuous column's values are stored in memory.
+    /// @details Narrower types reduce the memory used by columns that don't need the
+    ///  precision (or range) of a @c double, such as Likert codes or small counts.
+    ///  Values are always widened back to @c double when they are read.
+    /// @sa Column::SetStorage().
+    enum class ContinuousStorage
+        {
+        Double, /*!< Stored as @c double (the default).*/
+        Float,  /*!< Stored as @c float, which has about seven significant digits of precision.
+                     The values' magnitudes must be within @c float's (normal) range.*/
+        Int32,  /*!< Stored as 32-bit integers. All values must be whole numbers.*/
+        UInt8   /*!< Stored as 8-bit integers. All values must be whole numbers between 0 and 254.*/
+        };
+
+    /// @brief How to measure the association between continuous columns.
+    /// @sa Dataset::GetAssociationMatrix().
+    enum class AssociationMethod
+        {
+        Pearson, /*!< Pearson correlation coefficients.*/
+        Phi      /*!< Phi coefficients, for binary (e.g., yes/no) columns.
+                      Values greater than zero are treated as @c 1.*/
+        };
+
     /// @brief A column of data.
     template<typename T>
     class Column
@@ -77,35 +162,259 @@ namespace Wisteria::Data
             @param val The new value.*/
         void SetValue(const size_t index, const T& val)
             {
-            wxASSERT_MSG(index < m_data.size(), "Invalid index in call to Column::SetValue()");
-            if (index >= m_data.size())
+            wxASSERT_MSG(index < GetRowCount(), "Invalid index in call to Column::SetValue()");
+            if (index >= GetRowCount())
                 { return; }
+            Widen();
             m_data.at(index) = val;
+            InvalidateCaches();
             }
         /// @brief Recodes all instances of a value in the column to a new value.
         /// @param oldValue The value to replace.
         /// @param newValue The new value to replace with.
         void Recode(const T& oldValue, const T& newValue)
-            { std::replace(m_data.begin(), m_data.end(), oldValue, newValue); }
+            {
+            Widen();
+            std::replace(m_data.begin(), m_data.end(), oldValue, newValue);
+            InvalidateCaches();
+            }
+        /** @brief Recodes the values in the column from a lookup table, in one pass.
+            @details This is faster than calling Recode() for each value that needs to be changed.
+            @param recodeTable The new values, where the index is the value being replaced.
+                Values that are not an index into the table are left as they are.
+            @note This is only available for integral columns (e.g., categorical codes).*/
+        void Recode(const std::vector<T>& recodeTable)
+            {
+            static_assert(std::is_integral_v<T>,
+                          "Recoding from a table is only supported for integral columns.");
+            Widen();
+            for (auto& value : m_data)
+                {
+                if (value < recodeTable.size())
+                    { value = recodeTable[value]; }
+                }
+            InvalidateCaches();
+            }
         /** @brief Fills the data with a value.
             @param val The value to fill the data with.*/
         void Fill(const T& val)
-            { std::fill(m_data.begin(), m_data.end(), val); }
+            {
+            Widen();
+            std::fill(m_data.begin(), m_data.end(), val);
+            InvalidateCaches();
+            }
         /// @}
 
-        /// @returns The raw data.
-        [[nodiscard]] const std::vector<T>& GetValues() const noexcept
-            { return m_data; }
+        /** @brief Stores the column's values in a narrower type to reduce memory usage.
+            @details Values are widened back to @c double when they are read.
+             Changing any of the column's values will convert it back to @c double storage.
+             Rows added to the dataset are stored in the narrower type, unless any of
+             their values don't fit in it (in which case the column is converted back to
+             @c double storage; call GetStorage() afterwards to see how it is stored).
+            @param storage The type to store the values as.
+            @returns `true` if the values were converted; `false` if any of them
+             don't fit in the requested type (e.g., fractional values for integer storage,
+             or values beyond @c float's range for @c float storage),
+             in which case they will remain as doubles.
+            @note This is only available for continuous columns.
+             Also, GetValues() will need to build (and cache) a widened copy of the values
+             if they are narrowed (which uses the memory that narrowing them saved),
+             so prefer ForEachValue() or GetValue() when reading narrowed columns.*/
+        bool SetStorage(const ContinuousStorage storage)
+            {
+            if constexpr (std::is_same_v<T, double>)
+                {
+                if (storage == m_storage)
+                    { return true; }
+                Widen();
+                if (storage == ContinuousStorage::Double)
+                    { return true; }
+                if (!std::all_of(m_data.cbegin(), m_data.cend(),
+                    [storage](const double val) noexcept
+                    { return FitsStorage(storage, val); }))
+                    { return false; }
+                if (storage == ContinuousStorage::Float)
+                    {
+                    m_floatData.assign(m_data.cbegin(), m_data.cend());
+                    }
+                else if (storage == ContinuousStorage::Int32)
+                    {
+                    m_int32Data.reserve(m_data.size());
+                    for (const auto val : m_data)
+                        {
+                        m_int32Data.push_back(std::isnan(val) ?
+                            m_missingInt32 : static_cast<int32_t>(val));
+                        }
+                    }
+                else
+                    {
+                    m_uint8Data.reserve(m_data.size());
+                    for (const auto val : m_data)
+                        {
+                        m_uint8Data.push_back(std::isnan(val) ?
+                            m_missingUInt8 : static_cast<uint8_t>(val));
+                        }
+                    }
+                std::vector<T>().swap(m_data);
+                m_storage = storage;
+                return true;
+                }
+            else
+                { return storage == ContinuousStorage::Double; }
+            }
+        /// @returns How the column's values are stored.
+        [[nodiscard]] ContinuousStorage GetStorage() const noexcept
+            { return m_storage; }
+
+        /** @returns The valid N, min, max, and sum of the column.
+            @details These are calculated the first time that this is called and then
+             cached until the column's data is changed.
+            @note This is only available for floating-point (i.e., continuous) columns.
+             This can be called from multiple threads; the summary is only calculated once.*/
+        [[nodiscard]] const ColumnSummary& GetSummary() const
+            {
+            static_assert(std::is_floating_point_v<T>,
+                          "Column summaries are only available for continuous columns.");
+            return m_summary.Get([this]()
+                {
+                ColumnSummary summary;
+                auto minValue = std::numeric_limits<double>::max();
+                auto maxValue = std::numeric_limits<double>::lowest();
+                const auto addValue = [&summary, &minValue, &maxValue](const double val) noexcept
+                    {
+                    if (!std::isnan(val))
+                        {
+                        ++summary.m_validN;
+                        summary.m_sum += val;
+                        minValue = std::min<double>(minValue, val);
+                        maxValue = std::max<double>(maxValue, val);
+                        }
+                    };
+                ForEachValue(addValue);
+                if (summary.m_validN > 0)
+                    {
+                    summary.m_min = minValue;
+                    summary.m_max = maxValue;
+                    }
+                return summary;
+                });
+            }
+
+        /** @returns Running statistics (e.g., the mean, variance, and approximate quantiles)
+             of the column's valid values.
+            @details These are calculated the first time that this is called. After that,
+             rows appended to the column (i.e., from Dataset::AddRow() or Dataset::AddRows())
+             are added to them incrementally, rather than the statistics being recalculated
+             from all of the data. This is useful for graphs of data that is frequently
+             appended to (e.g., a live feed). Any other change to the column's data
+             will discard them.
+            @note This is only available for floating-point (i.e., continuous) columns.
+             Like GetSummary(), this can be called from multiple threads.*/
+        [[nodiscard]] const statistics::running_statistics& GetRunningStatistics() const
+            {
+            static_assert(std::is_floating_point_v<T>,
+                          "Running statistics are only available for continuous columns.");
+            return m_runningStatistics.Get([this]()
+                {
+                statistics::running_statistics runningStatistics;
+                for (size_t i = 0; i < GetRowCount(); ++i)
+                    { runningStatistics.add(GetValue(i)); }
+                return runningStatistics;
+                });
+            }
+
+        /** @returns The raw data.
+            @note If the values are stored in a narrower type (see SetStorage()), then a widened
+             copy of them is built (and cached) the first time that this is called.
+             To read narrowed values without that copy, use ForEachValue() instead.*/
+        [[nodiscard]] const std::vector<T>& GetValues() const
+            {
+            if (m_storage == ContinuousStorage::Double)
+                { return m_data; }
+            return m_widenedData.Get([this]()
+                {
+                std::vector<T> widenedData;
+                widenedData.reserve(GetRowCount());
+                ForEachValue([&widenedData](const T val)
+                    { widenedData.push_back(val); });
+                return widenedData;
+                });
+            }
+        /** @brief Calls a function with each value (in order), reading them straight from
+             how they are stored.
+            @details Unlike GetValues(), this doesn't need a widened copy of narrowed values
+             (see SetStorage()); each value is widened as it is read.
+            @param func The function to call, which takes a value (as a @c T).*/
+        template<typename FunctionT>
+        void ForEachValue(FunctionT&& func) const
+            {
+            if constexpr (std::is_same_v<T, double>)
+                {
+                switch (m_storage)
+                    {
+                case ContinuousStorage::Float:
+                    for (const auto val : m_floatData)
+                        { func(static_cast<T>(val)); }
+                    return;
+                case ContinuousStorage::Int32:
+                    for (const auto val : m_int32Data)
+                        {
+                        func((val == m_missingInt32) ?
+                             std::numeric_limits<double>::quiet_NaN() : static_cast<T>(val));
+                        }
+                    return;
+                case ContinuousStorage::UInt8:
+                    for (const auto val : m_uint8Data)
+                        {
+                        func((val == m_missingUInt8) ?
+                             std::numeric_limits<double>::quiet_NaN() : static_cast<T>(val));
+                        }
+                    return;
+                default:
+                    break;
+                    }
+                }
+            for (const auto& val : m_data)
+                { func(val); }
+            }
         /** @returns A value from the data.
             @param index The index into the data to set.*/
-        [[nodiscard]] const T& GetValue(const size_t index) const
+        [[nodiscard]] T GetValue(const size_t index) const
             {
-            wxASSERT_MSG(index < m_data.size(), L"Invalid index in call to Column::GetValue()");
+            wxASSERT_MSG(index < GetRowCount(), L"Invalid index in call to Column::GetValue()");
+            if constexpr (std::is_same_v<T, double>)
+                {
+                switch (m_storage)
+                    {
+                case ContinuousStorage::Float:
+                    return m_floatData.at(index);
+                case ContinuousStorage::Int32:
+                    return (m_int32Data.at(index) == m_missingInt32) ?
+                        std::numeric_limits<double>::quiet_NaN() : m_int32Data.at(index);
+                case ContinuousStorage::UInt8:
+                    return (m_uint8Data.at(index) == m_missingUInt8) ?
+                        std::numeric_limits<double>::quiet_NaN() : m_uint8Data.at(index);
+                default:
+                    break;
+                    }
+                }
             return m_data.at(index);
             }
         /// @returns The number of rows.
         [[nodiscard]] size_t GetRowCount() const noexcept
-            { return m_data.size(); }
+            {
+            switch (m_storage)
+                {
+            case ContinuousStorage::Float:
+                return m_floatData.size();
+            case ContinuousStorage::Int32:
+                return m_int32Data.size();
+            case ContinuousStorage::UInt8:
+                return m_uint8Data.size();
+            default:
+                return m_data.size();
+                }
+            }
         /// @returns The title of the column.
         [[nodiscard]] const wxString& GetTitle() const noexcept
             { return m_title; }
@@ -113,30 +422,231 @@ namespace Wisteria::Data
         /// @param title The title.
         void SetTitle(const wxString& title)
             { m_title = title; }
+        /** @returns The (approximate) number of bytes that the column's data
+                and caches are using.
+            @note For date columns, this doesn't include any memory that the dates' time zone
+                information uses.*/
+        [[nodiscard]] virtual MemoryUsage GetMemoryUsage() const
+            {
+            MemoryUsage usage;
+            usage.m_dataBytes = m_title.length() * sizeof(wxChar) +
+                m_data.capacity() * sizeof(T) +
+                m_floatData.capacity() * sizeof(float) +
+                m_int32Data.capacity() * sizeof(int32_t) +
+                m_uint8Data.capacity() * sizeof(uint8_t);
+            // the summary and running statistics are stored in the column itself
+            if (const auto* widenedData = m_widenedData.Find())
+                { usage.m_cacheBytes = widenedData->capacity() * sizeof(T); }
+            return usage;
+            }
     protected:
         /// @brief Removes all data.
         virtual void Clear() noexcept
-            { m_data.clear(); }
-        /** @brief Allocates space for the data.
+            {
+            m_data.clear();
+            m_floatData.clear();
+            m_int32Data.clear();
+            m_uint8Data.clear();
+            m_storage = ContinuousStorage::Double;
+            InvalidateCaches();
+            }
+        /** @brief Allocates space for the data (in however it is currently stored).
             @param rowCount The number of rows to allocate space for.*/
         void Reserve(const size_t rowCount)
-            { m_data.reserve(rowCount); }
+            {
+            switch (m_storage)
+                {
+            case ContinuousStorage::Float:
+                m_floatData.reserve(rowCount);
+                break;
+            case ContinuousStorage::Int32:
+                m_int32Data.reserve(rowCount);
+                break;
+            case ContinuousStorage::UInt8:
+                m_uint8Data.reserve(rowCount);
+                break;
+            default:
+                m_data.reserve(rowCount);
+                }
+            }
         /** @brief Resizes the number of rows.
             @param rowCount The new number of rows.*/
         void Resize(const size_t rowCount)
-            { m_data.resize(rowCount); }
+            {
+            Widen();
+            m_data.resize(rowCount);
+            InvalidateCaches();
+            }
         /** @brief Resizes the number of rows.
             @param rowCount The new number of rows.
             @param val Value to initialize any new rows with.*/
         void Resize(const size_t rowCount, const T& val)
-            { m_data.resize(rowCount, val); }
+            {
+            Widen();
+            m_data.resize(rowCount, val);
+            InvalidateCaches();
+            }
         /** @brief Adds a value to the data.
             @param val The new value.*/
         void AddValue(const T& val)
-            { m_data.push_back(val); }
+            {
+            if constexpr (std::is_same_v<T, double>)
+                {
+                if (m_storage != ContinuousStorage::Double && FitsStorage(m_storage, val))
+                    {
+                    AddNarrowedValue(val);
+                    InvalidateCachesAfterAppend(GetRowCount() - 1);
+                    return;
+                    }
+                }
+            Widen();
+            m_data.push_back(val);
+            InvalidateCachesAfterAppend(GetRowCount() - 1);
+            }
+        /** @brief Appends values to the data.
+            @details If the values are narrowed (see SetStorage()), then the new values
+             are stored the same way, unless any of them don't fit
+             (then the column is widened first).
+            @param values The values to append.
+            @param rowCount The number of rows that the column should have afterwards.
+             Any rows after the appended values are filled with @c missingValue.
+            @param missingValue The value to fill any remaining rows with.*/
+        void AppendValues(std::vector<T>&& values, const size_t rowCount, const T& missingValue)
+            {
+            const size_t firstNewRow = GetRowCount();
+            wxASSERT_MSG(values.empty() || firstNewRow + values.size() == rowCount,
+                         L"Columns in batch have different lengths in call to AddRows()!");
+            if constexpr (std::is_same_v<T, double>)
+                {
+                if (m_storage != ContinuousStorage::Double)
+                    {
+                    const auto fitsStorage = [this](const double val) noexcept
+                        { return FitsStorage(m_storage, val); };
+                    if (std::all_of(values.cbegin(), values.cend(), fitsStorage) &&
+                        (firstNewRow + values.size() >= rowCount || fitsStorage(missingValue)))
+                        {
+                        for (const auto val : values)
+                            { AddNarrowedValue(val); }
+                        while (GetRowCount() < rowCount)
+                            { AddNarrowedValue(missingValue); }
+                        InvalidateCachesAfterAppend(firstNewRow);
+                        return;
+                        }
+                    Widen();
+                    }
+                }
+            // (inserting grows the storage geometrically, so appending batches stays linear)
+            if (m_data.empty())
+                { m_data = std::move(values); }
+            else
+                {
+                m_data.insert(m_data.end(), std::make_move_iterator(values.begin()),
+                                            std::make_move_iterator(values.end()));
+                }
+            m_data.resize(rowCount, missingValue);
+            InvalidateCachesAfterAppend(firstNewRow);
+            }
+        /// @brief Converts narrowed values (see SetStorage()) back to @c double storage.
+        void Widen()
+            {
+            if (m_storage == ContinuousStorage::Double)
+                { return; }
+            std::vector<T> data;
+            data.reserve(GetRowCount());
+            for (size_t i = 0; i < GetRowCount(); ++i)
+                { data.push_back(GetValue(i)); }
+            std::vector<float>().swap(m_floatData);
+            std::vector<int32_t>().swap(m_int32Data);
+            std::vector<uint8_t>().swap(m_uint8Data);
+            m_data = std::move(data);
+            m_storage = ContinuousStorage::Double;
+            // the values themselves didn't change, so the running statistics are still valid
+            InvalidateCachesAfterAppend(GetRowCount());
+            }
+        /// @brief Discards anything cached about the data (e.g., the summary statistics).
+        /// @note This should be called whenever the data is changed directly.
+        virtual void InvalidateCaches() noexcept
+            {
+            m_summary.Reset();
+            m_widenedData.Reset();
+            m_runningStatistics.Reset();
+            }
+        /** @brief Discards anything cached about the data, except for the running statistics,
+             which are updated with the newly appended rows instead.
+            @param firstNewRow The index of the first row that was appended.
+            @note This should be called (instead of InvalidateCaches()) after rows
+             are appended to the data.*/
+        void InvalidateCachesAfterAppend(const size_t firstNewRow)
+            {
+            auto runningStatistics = m_runningStatistics.Take();
+            InvalidateCaches();
+            if constexpr (std::is_floating_point_v<T>)
+                {
+                if (runningStatistics)
+                    {
+                    for (size_t i = firstNewRow; i < GetRowCount(); ++i)
+                        { runningStatistics->add(GetValue(i)); }
+                    m_runningStatistics.Set(std::move(runningStatistics.value()));
+                    }
+                }
+            }
     private:
+        /// @returns @c true if a value can be stored in the given (narrowed) storage.
+        [[nodiscard]] static bool FitsStorage(const ContinuousStorage storage,
+                                              const double val) noexcept
+            {
+            if (storage == ContinuousStorage::Double || std::isnan(val))
+                { return true; }
+            if (storage == ContinuousStorage::Float)
+                {
+                // values outside of float's range would become infinity (or zero),
+                // and tiny (subnormal) values would lose most of their precision
+                const double magnitude = std::abs(val);
+                return (magnitude == 0 || std::isinf(magnitude) ||
+                        (magnitude >= std::numeric_limits<float>::min() &&
+                         magnitude <= std::numeric_limits<float>::max()));
+                }
+            if (val != std::floor(val))
+                { return false; }
+            return (storage == ContinuousStorage::Int32) ?
+                (val > std::numeric_limits<int32_t>::min() &&
+                 val <= std::numeric_limits<int32_t>::max()) :
+                (val >= 0 && val < m_missingUInt8);
+            }
+        /// @brief Appends a value to the narrowed storage.
+        /// @note The caller should check that it fits (see FitsStorage()) first.
+        void AddNarrowedValue(const double val)
+            {
+            switch (m_storage)
+                {
+            case ContinuousStorage::Float:
+                m_floatData.push_back(static_cast<float>(val));
+                break;
+            case ContinuousStorage::Int32:
+                m_int32Data.push_back(std::isnan(val) ? m_missingInt32 : static_cast<int32_t>(val));
+                break;
+            case ContinuousStorage::UInt8:
+                m_uint8Data.push_back(std::isnan(val) ? m_missingUInt8 : static_cast<uint8_t>(val));
+                break;
+            default:
+                break;
+                }
+            }
+
+        // used for missing data when values are stored as integers
+        static constexpr int32_t m_missingInt32{ std::numeric_limits<int32_t>::min() };
+        static constexpr uint8_t m_missingUInt8{ std::numeric_limits<uint8_t>::max() };
+
         wxString m_title;
         std::vector<T> m_data;
+        // narrowed storage for continuous columns (only one of m_data and these is used)
+        ContinuousStorage m_storage{ ContinuousStorage::Double };
+        std::vector<float> m_floatData;
+        std::vector<int32_t> m_int32Data;
+        std::vector<uint8_t> m_uint8Data;
+        LazyCache<std::vector<T>> m_widenedData;
+        LazyCache<ColumnSummary> m_summary;
+        LazyCache<statistics::running_statistics> m_runningStatistics;
         };
 
     /// @brief The integral type used for looking up a label from a grouping column's string table.
@@ -166,22 +676,87 @@ namespace Wisteria::Data
         /// @brief Gets/sets the string table.
         /// @details This can be called to fill or edit the table.
         /// @returns The string table.
+        /// @warning The lookup tables used by GetCategoryLabelFromID(), GetIDFromCategoryLabel(),
+        ///  and FindMissingDataCode() are discarded when this is called and rebuilt
+        ///  the next time that they are needed. Because of that, edits made through a
+        ///  reference that was returned before calling those functions will not be seen
+        ///  by them; call this again (rather than holding on to the returned reference)
+        ///  for each round of edits.
         [[nodiscard]] StringTableType& GetStringTable() noexcept
-            { return m_stringTable; }
+            {
+            m_lookup.Reset();
+            return m_stringTable;
+            }
         /// @private
         [[nodiscard]] const StringTableType& GetStringTable() const noexcept
             { return m_stringTable; }
+        /// @returns The (approximate) number of bytes that the column's data,
+        ///     string table, and caches are using.
+        [[nodiscard]] MemoryUsage GetMemoryUsage() const final;
         /** @brief Gets the label from the string table given the numeric code,
              or the code formatted as a string if not found.
             @returns The label from the string table, or the code as a string if not found.
             @param code The ID to look up.*/
         [[nodiscard]] wxString GetCategoryLabelFromID(const GroupIdType code) const
             {
-            const auto foundLabel = m_stringTable.find(code);
-            if (foundLabel != m_stringTable.cend())
-                { return foundLabel->second; }
+            const auto& lookup = GetLookup();
+            if (lookup.m_isDense)
+                {
+                if (code < lookup.m_labels.size() && lookup.m_labels[code])
+                    { return lookup.m_labels[code].value(); }
+                }
             else
-                { return std::to_wstring(code); }
+                {
+                const auto foundLabel = m_stringTable.find(code);
+                if (foundLabel != m_stringTable.cend())
+                    { return foundLabel->second; }
+                }
+            return std::to_wstring(code);
+            }
+        /** @brief Gets the numeric code from the string table given a label
+             (case insensitively).
+            @returns The code for the label, or @c std::nullopt if not found.
+            @param label The label to look up.*/
+        [[nodiscard]] std::optional<GroupIdType> GetIDFromCategoryLabel(const wxString& label) const
+            {
+            const auto& lookup = GetLookup();
+            const auto foundCode = lookup.m_codes.find(label.Lower());
+            return (foundCode != lookup.m_codes.cend()) ?
+                std::optional<GroupIdType>(foundCode->second) : std::nullopt;
+            }
+        /// @returns The key value from the string table that represents missing data
+        ///  (i.e., empty string), or @c std::nullopt if not found.
+        [[nodiscard]] std::optional<GroupIdType> FindMissingDataCode() const
+            { return GetLookup().m_missingDataCode; }
+        /** @brief Gets the rows in the column that have the given code.
+            @details The rows for every code are indexed the first time that this is called,
+             and then cached until the column's data is changed. This is useful for
+             reviewing a group's rows without having to scan the entire column for them.
+            @param code The group ID to find the rows for.
+            @returns The (sorted) indices of the rows with the code.
+            @note Like GetSummary(), this can be called from multiple threads;
+             the index is only built once.*/
+        [[nodiscard]] const std::vector<size_t>& GetGroupRows(const GroupIdType code) const
+            {
+            const auto& groupRows = GetGroupIndex();
+            const auto foundGroup = groupRows.find(code);
+            if (foundGroup != groupRows.cend())
+                { return foundGroup->second; }
+            static const std::vector<size_t> noRows;
+            return noRows;
+            }
+        /** @returns The (sorted) codes that appear in the column.
+            @note This uses (and builds, if necessary) the same index as GetGroupRows(),
+             so the column does not need to be scanned again.*/
+        [[nodiscard]] std::vector<GroupIdType> GetGroupIds() const
+            {
+            const auto& groupRows = GetGroupIndex();
+            std::vector<GroupIdType> groupIds;
+            groupIds.reserve(groupRows.size());
+            for (const auto& [code, rows] : groupRows)
+                { groupIds.push_back(code); }
+            std::sort(groupIds.begin(), groupIds.end());
+            return groupIds;
             }
         /// @returns The key value from a string table that's represents missing data
         ///  (i.e., empty string), or @c std::nullopt if not found.
@@ -214,9 +789,215 @@ namespace Wisteria::Data
             {
             Column::Clear();
             m_stringTable.clear();
+            m_lookup.Reset();
+            }
+        /// @brief Discards the cached summary and group index.
+        void InvalidateCaches() noexcept final
+            {
+            Column::InvalidateCaches();
+            m_groupRows.Reset();
+            }
+        /// @brief Discards the cached summary, group index, and string table lookups.
+        void ReleaseCaches() noexcept
+            {
+            InvalidateCaches();
+            m_lookup.Reset();
+            }
+
+        // O(1) lookups for the string table, built when first needed
+        struct StringTableLookup
+            {
+            // if the codes are dense (e.g., assigned sequentially during import),
+            // then the labels are stored by code; otherwise, the string table itself is used
+            bool m_isDense{ false };
+            std::vector<std::optional<wxString>> m_labels;
+            // lowercased labels and their codes
+            std::unordered_map<wxString, GroupIdType, StringHash> m_codes;
+            std::optional<GroupIdType> m_missingDataCode;
+            };
+        /// @returns The lookup tables, building them if necessary.
+        [[nodiscard]] const StringTableLookup& GetLookup() const
+            {
+            return m_lookup.Get([this]()
+                {
+                StringTableLookup lookup;
+                // allow for a few gaps between the codes
+                const GroupIdType maxDenseCode = (m_stringTable.size() * 2) + 16;
+                lookup.m_isDense = m_stringTable.empty() ||
+                                   m_stringTable.crbegin()->first < maxDenseCode;
+                if (lookup.m_isDense && !m_stringTable.empty())
+                    { lookup.m_labels.resize(m_stringTable.crbegin()->first + 1); }
+                lookup.m_codes.reserve(m_stringTable.size());
+                for (const auto& [key, value] : m_stringTable)
+                    {
+                    if (lookup.m_isDense)
+                        { lookup.m_labels[key] = value; }
+                    // keep the first code for labels that differ only by case
+                    lookup.m_codes.insert(std::make_pair(value.Lower(), key));
+                    if (!lookup.m_missingDataCode && value.empty())
+                        { lookup.m_missingDataCode = key; }
+                    }
+                return lookup;
+                });
+            }
+
+        /// @returns The rows for every code, building the index if necessary.
+        [[nodiscard]] const std::unordered_map<GroupIdType, std::vector<size_t>>& GetGroupIndex() const
+            {
+            return m_groupRows.Get([this]()
+                {
+                const auto& values = GetValues();
+                // partition the rows like a counting sort: count each code's rows first,
+                // so that each code's row list is only allocated once
+                std::unordered_map<GroupIdType, size_t> groupCounts;
+                for (const auto& value : values)
+                    { ++groupCounts[value]; }
+                std::unordered_map<GroupIdType, std::vector<size_t>> groupRows;
+                groupRows.reserve(groupCounts.size());
+                for (const auto& [code, count] : groupCounts)
+                    { groupRows[code].reserve(count); }
+                for (size_t i = 0; i < values.size(); ++i)
+                    { groupRows[values[i]].push_back(i); }
+                return groupRows;
+                });
             }
 
         StringTableType m_stringTable;
+        LazyCache<StringTableLookup> m_lookup;
+        // the rows for each code, built when first needed
+        LazyCache<std::unordered_map<GroupIdType, std::vector<size_t>>> m_groupRows;
+        };
+
+    /** @brief A column of IDs (i.e., names) for the observations in a dataset.
+        @details By default, the IDs are stored as strings. For large datasets, Compact()
+         can be called to reduce the memory used by the IDs. This will store them as integers
+         (if every ID is an integer or empty) or pack them into a single UTF-8 buffer.\n
+         The IDs are read the same way regardless of how they are stored.
+        @note Unlike Column::GetValue(), GetValue() returns a copy of the ID,
+         as compacted IDs are not stored as strings.*/
+    class IdentifierColumn
+        {
+        friend class Dataset;
+    public:
+        /** @brief Constructor.
+            @param title The title of the column.*/
+        explicit IdentifierColumn(const wxString& title) : m_title(title)
+            {}
+        /// @private
+        IdentifierColumn() = default;
+
+        /** @brief Sets a value in the data.
+            @param index The index into the data to set.
+            @param val The new value.
+            @note If the column is compacted, then it will be expanded back to strings first.*/
+        void SetValue(const size_t index, const wxString& val)
+            {
+            wxASSERT_MSG(index < GetRowCount(), "Invalid index in call to IdentifierColumn::SetValue()");
+            if (index >= GetRowCount())
+                { return; }
+            Expand();
+            m_data.at(index) = val;
+            }
+        /** @returns A value from the data.
+            @param index The index into the data to read.*/
+        [[nodiscard]] wxString GetValue(const size_t index) const
+            {
+            wxASSERT_MSG(index < GetRowCount(), L"Invalid index in call to IdentifierColumn::GetValue()");
+            switch (m_storage)
+                {
+            case Storage::Integers:
+                return (m_integerIds.at(index) == m_emptyIntegerId) ?
+                    wxString() : wxString(std::to_wstring(m_integerIds.at(index)));
+            case Storage::Utf8:
+                return wxString::FromUTF8(m_utf8Ids.data() + m_utf8Offsets.at(index),
+                                          m_utf8Offsets.at(index + 1) - m_utf8Offsets.at(index));
+            default:
+                return m_data.at(index);
+                }
+            }
+        /// @returns The number of rows.
+        [[nodiscard]] size_t GetRowCount() const noexcept
+            {
+            switch (m_storage)
+                {
+            case Storage::Integers:
+                return m_integerIds.size();
+            case Storage::Utf8:
+                return m_utf8Offsets.empty() ? 0 : m_utf8Offsets.size() - 1;
+            default:
+                return m_data.size();
+                }
+            }
+        /// @returns The title of the column.
+        [[nodiscard]] const wxString& GetTitle() const noexcept
+            { return m_title; }
+        /// @brief Sets the column's title.
+        /// @param title The title.
+        void SetTitle(const wxString& title)
+            { m_title = title; }
+
+        /// @returns `true` if the IDs are compacted (i.e., not stored as strings).
+        [[nodiscard]] bool IsCompact() const noexcept
+            { return m_storage != Storage::Strings; }
+        /** @brief Reduces the memory used by the IDs.
+            @details If every ID is an integer (without leading zeros) or empty, then they
+             will be stored as integers; otherwise, they will be packed into a UTF-8 buffer.\n
+             IDs added after this will be stored the same way (an integer column will be
+             converted to UTF-8 if a non-integer ID is added).*/
+        void Compact();
+        /// @brief Converts compacted IDs back to strings.
+        void Expand();
+        /// @returns The (approximate) number of bytes that the IDs are using.
+        /// @note Compact() can reduce this for large datasets.
+        [[nodiscard]] MemoryUsage GetMemoryUsage() const;
+    private:
+        /// @brief Removes all data.
+        void Clear() noexcept
+            {
+            m_storage = Storage::Strings;
+            m_data.clear();
+            m_integerIds.clear();
+            m_utf8Ids.clear();
+            m_utf8Offsets.clear();
+            }
+        /** @brief Allocates space for the data.
+            @param rowCount The number of rows to allocate space for.*/
+        void Reserve(const size_t rowCount);
+        /** @brief Resizes the number of rows (expanding the IDs to strings first).
+            @param rowCount The new number of rows.*/
+        void Resize(const size_t rowCount)
+            {
+            Expand();
+            m_data.resize(rowCount);
+            }
+        /** @brief Adds a value to the data.
+            @param val The new value.*/
+        void AddValue(const wxString& val);
+
+        /// @returns The ID as an integer, if it is one (that can be converted back
+        ///  into the same string).
+        [[nodiscard]] static std::optional<int64_t> ToIntegerId(const wxString& val);
+        /// @brief Converts integer storage to UTF-8 storage.
+        void ConvertIntegersToUtf8();
+        /// @brief Appends an ID to the UTF-8 storage.
+        void AddUtf8Value(const wxString& val);
+
+        enum class Storage
+            {
+            Strings,
+            Integers,
+            Utf8
+            };
+        // used for empty IDs when they are stored as integers
+        static constexpr int64_t m_emptyIntegerId{ std::numeric_limits<int64_t>::min() };
+
+        wxString m_title;
+        Storage m_storage{ Storage::Strings };
+        std::vector<wxString> m_data;
+        std::vector<int64_t> m_integerIds;
+        std::string m_utf8Ids;
+        // where each ID starts in the UTF-8 buffer (and the end of the buffer)
+        std::vector<size_t> m_utf8Offsets;
         };
 
     /** @brief Class for filling a row in a dataset.
@@ -315,6 +1096,99 @@ namespace Wisteria::Data
         wxString m_id;
         };
 
+    /** @brief Class for filling multiple rows in a dataset at once, column by column.
+        @details This can be used with @c AddRows() to append large amounts of data
+         without the overhead of building and adding each row individually:
+        @code
+         dataset.AddRows(ColumnBatch().
+            Continuous({ { 4, 5, 6 }, { 120, 130, 140 } }).
+            Categoricals({ { 1, 1, 0 } }));
+        @endcode
+        @note All columns in the batch should have the same number of values.*/
+    class ColumnBatch
+        {
+        friend class Dataset;
+    public:
+        /** @brief Sets the codes for the categorical columns.
+            @details The order of the columns is important.
+            @param categoricalValues The values (i.e., codes) to fill the categorical columns with.
+            @returns A self reference.*/
+        ColumnBatch& Categoricals(const std::vector<std::vector<GroupIdType>>& categoricalValues)
+            {
+            m_categoryValues = categoricalValues;
+            return *this;
+            }
+        /// @private
+        ColumnBatch& Categoricals(std::vector<std::vector<GroupIdType>>&& categoricalValues)
+            {
+            m_categoryValues = std::move(categoricalValues);
+            return *this;
+            }
+        /** @brief Sets the values for the continuous columns.
+            @details The order of the columns is important.
+            @param values The values to fill the continuous columns with.
+            @returns A self reference.*/
+        ColumnBatch& Continuous(const std::vector<std::vector<double>>& values)
+            {
+            m_continuousValues = values;
+            return *this;
+            }
+        /// @private
+        ColumnBatch& Continuous(std::vector<std::vector<double>>&& values)
+            {
+            m_continuousValues = std::move(values);
+            return *this;
+            }
+        /** @brief Sets the dates for the date columns.
+            @details The order of the columns is important.
+            @param dateValues The values to fill the date columns with.
+            @returns A self reference.*/
+        ColumnBatch& Dates(const std::vector<std::vector<wxDateTime>>& dateValues)
+            {
+            m_dateColumns = dateValues;
+            return *this;
+            }
+        /// @private
+        ColumnBatch& Dates(std::vector<std::vector<wxDateTime>>&& dateValues)
+            {
+            m_dateColumns = std::move(dateValues);
+            return *this;
+            }
+        /** @brief Sets the IDs/names of the points.
+            @param ids The values for the IDs.
+            @returns A self reference.*/
+        ColumnBatch& Ids(const std::vector<wxString>& ids)
+            {
+            m_ids = ids;
+            return *this;
+            }
+        /// @private
+        ColumnBatch& Ids(std::vector<wxString>&& ids)
+            {
+            m_ids = std::move(ids);
+            return *this;
+            }
+        /// @returns The number of rows in the batch (i.e., the length of its longest column).
+        [[nodiscard]] size_t GetRowCount() const noexcept
+            {
+            size_t rowCount{ m_ids.size() };
+            const auto updateRowCount = [&rowCount](const auto& columns) noexcept
+                {
+                for (const auto& column : columns)
+                    { rowCount = std::max(rowCount, column.size()); }
+                };
+            updateRowCount(m_categoryValues);
+            updateRowCount(m_continuousValues);
+            updateRowCount(m_dateColumns);
+            return rowCount;
+            }
+    private:
+        std::vector<std::vector<GroupIdType>> m_categoryValues;
+        std::vector<std::vector<double>> m_continuousValues;
+        std::vector<std::vector<wxDateTime>> m_dateColumns;
+        std::vector<wxString> m_ids;
+        };
+
     /// @brief How date column data should be read while importing.
     /// @sa ImportInfo.
     enum class DateImportMethod
@@ -328,9 +1202,15 @@ namespace Wisteria::Data
                                   to interpret the given string as date and time."
                                   If @c ParseDateTime() fails (because a time component isn't found), then
                                   @c ParseDateTime() will be attempted.*/
-        StrptimeFormatString /*!< Parse using a strptime()-like format string (e.g., "%Y-%m-%d").
-                                  Please see the description of the ANSI C function @c strftime(3)
-                                  for the syntax of the format string.*/
+        StrptimeFormatString, /*!< Parse using a strptime()-like format string (e.g., "%Y-%m-%d").
+                                   Please see the description of the ANSI C function @c strftime(3)
+                                   for the syntax of the format string.*/
+        DetectFormat          /*!< Reviews the first few values in the column to detect which
+                                   fixed format they are using (e.g., "YYYY-MM-DD" or "MM/DD/YYYY"),
+                                   and then parses the rest of the column with that format.
+                                   Values that don't match the detected format (or if no format is
+                                   detected) will be parsed the same way as @c Automatic.\n
+                                   This is much faster than @c Automatic for large files.*/
         };
 
     /// @brief How categorical column data should be read while importing.
@@ -343,6 +1223,16 @@ namespace Wisteria::Data
                              arbitrarily assigned in the order that strings appear.*/
         };
 
+    /// @brief How continuous column data should be read while importing.
+    /// @sa ImportInfo.
+    enum class ContinuousImportMethod
+        {
+        Standard, /*!< Parse using @c wxString::ToCDouble() (i.e., C locale).*/
+        Fast      /*!< Parse using a fast, locale-independent parser (@c std::from_chars()),
+                       with an explicitly specified decimal separator.\n
+                       This is recommended for large, numeric-heavy files.*/
+        };
+
     /// @brief Class for specifying which columns from an input file to use in the dataset
     ///  and how to map them.
     /// @details The fields in this class are chainable, so you can set multiple properties
@@ -381,6 +1271,32 @@ namespace Wisteria::Data
             ///  Caller is responsible for assigning an empty string to this code when
             ///  connecting a string table to this column after import.
             GroupIdType m_mdCode{ 0 };
+            /// @brief Optional string table to seed the column with.
+            /// @details If using @c ReadAsStrings, strings found in this table (case insensitively)
+            ///  will be assigned their respective codes, and any other strings will be assigned
+            ///  codes after the highest one in this table. This is useful for keeping codes
+            ///  consistent between imports for known values (e.g., Likert responses).\n
+            ///  If using @c ReadAsIntegers, this table will be assigned to the column after import.
+            ColumnWithStringTable::StringTableType m_stringTable;
+            };
+
+        /// @brief Structure defining how to import a continuous column.
+        struct ContinuousImportInfo
+            {
+            /// @brief The name of the column.
+            wxString m_columnName;
+            /// @brief The method to import the column with.
+            ContinuousImportMethod m_importMethod{ ContinuousImportMethod::Fast };
+            /// @brief If using @c Fast, this will be the decimal separator that the
+            ///  values are expected to use, regardless of the current locale.
+            /// @note Thousands separators are not supported, and if this is something
+            ///  other than '.', then a '.' in the value will make it invalid (i.e., NaN).
+            wchar_t m_decimalSeparator{ L'.' };
+            /// @brief How to store the column's values after they are imported.
+            /// @details If the values don't fit in the requested type, then they
+            ///  are stored as doubles.
+            /// @sa Column::SetStorage().
+            ContinuousStorage m_storage{ ContinuousStorage::Double };
             };
 
         /// @brief Map of regular expressions and their replacement strings.
@@ -461,16 +1377,49 @@ namespace Wisteria::Data
              This will result in `COMPASS SCORES` being imported as the first continuous column
              and `GPA` as the second continuous column.
             @param colNames The column names.
+            @param storage How to store the columns' values. For example, columns of Likert
+             responses could be stored as @c UInt8 to use an eighth of the memory.
+            @returns A self reference.*/
+        ImportInfo& ContinuousColumns(const std::vector<wxString>& colNames,
+                                      const ContinuousStorage storage = ContinuousStorage::Double)
+            {
+            m_continuousColumns.clear();
+            m_continuousColumns.reserve(colNames.size());
+            for (const auto& colName : colNames)
+                {
+                m_continuousColumns.push_back(
+                    ContinuousImportInfo{ colName, ContinuousImportMethod::Standard, L'.', storage });
+                }
+            return *this;
+            }
+        /** @brief Sets the names of the input columns to import for the continuous columns,
+             along with how to parse each of them.
+
+             As an example:
+
+            @code
+             info().ContinuousColumnsInfo({
+                 // US formatted numbers, read with the fast parser
+                 { L"COMPASS SCORES" },
+                 // European formatted numbers
+                 { L"GPA", ContinuousImportMethod::Fast, L',' },
+                 { L"ATTENDANCE", ContinuousImportMethod::Standard }
+                 })
+            @endcode
+            @param continuousColumns The column names and their respective import methods
+             (and decimal separator, if the method is @c Fast).
+            @note This replaces any columns previously specified by ContinuousColumns().
+            @sa ContinuousImportInfo for more info.
             @returns A self reference.*/
-        ImportInfo& ContinuousColumns(const std::vector<wxString>& colNames)
+        ImportInfo& ContinuousColumnsInfo(const std::vector<ContinuousImportInfo>& continuousColumns)
             {
-            m_continuousColumns = colNames;
+            m_continuousColumns = continuousColumns;
             return *this;
             }
         /// @private
-        ImportInfo& ContinuousColumns(std::vector<wxString>&& colNames)
+        ImportInfo& ContinuousColumnsInfo(std::vector<ContinuousImportInfo>&& continuousColumns)
             {
-            m_continuousColumns = std::move(colNames);
+            m_continuousColumns = std::move(continuousColumns);
             return *this;
             }
         /** @brief Sets the name of the input column to use for the ID column.
@@ -535,12 +1484,152 @@ namespace Wisteria::Data
             m_textImportReplacements = std::move(replaceStrings);
             return *this;
             }
+        /** @brief Sets the size (in bytes) of the blocks that a file is read and
+             converted in while importing.
+            @details By default (i.e., @c 0), the entire file is read into memory
+             and parsed in one pass. When a chunk size is specified, the file is instead
+             read in blocks of (roughly) this size and each block's rows are converted
+             directly into the dataset's columns before the next block is read.
+             This keeps peak memory near the size of the final dataset (plus one chunk),
+             rather than several times the size of the file.\n
+             This is recommended for very large files (e.g., over a few hundred megabytes).
+            @param chunkSize The number of bytes to read from the file at a time.
+            @note Blocks are always split at the end of a line, so a block may end up
+             being larger than @c chunkSize if it contains an exceptionally long line.
+             Line ends inside of quotes are skipped (as they are part of a multiline cell),
+             unless that makes the block grow to several times @c chunkSize. In that case,
+             the file probably has an unbalanced quote, and the block is split at
+             its last line end instead.\n
+             Also, UTF-16 and UTF-32 files cannot be split and will be read in their
+             entirety regardless of this setting.
+            @returns A self reference.*/
+        ImportInfo& ChunkSize(const size_t chunkSize) noexcept
+            {
+            m_chunkSize = chunkSize;
+            return *this;
+            }
+        /** @brief Sets whether to map the file into memory and parse it in place while importing.
+            @details When enabled, the file's (UTF-8) bytes are tokenized directly from the
+             memory-mapped file, rather than being read into and decoded as a single string first.
+             Numeric and integer-code columns are converted straight from the mapped bytes, and
+             only categorical labels that haven't been seen before are decoded into strings.\n
+             This is recommended when repeatedly importing large files.
+            @param mapFile `true` to map the file into memory while importing it.
+            @note If the file cannot be mapped (or isn't UTF-8 or ASCII text), then the
+             file will be imported normally instead.\n
+             Also, this takes precedence over ChunkSize().
+            @returns A self reference.*/
+        ImportInfo& MemoryMapFile(const bool mapFile = true) noexcept
+            {
+            m_memoryMapFile = mapFile;
+            return *this;
+            }
+        /** @brief Sets whether the columns should be converted in parallel after the file is parsed.
+            @details By default, the parsed text is converted and loaded into the dataset
+             one row at a time. When this is enabled, each requested column is instead
+             converted independently (on multiple threads) and written directly into its
+             respective dataset column. This is recommended for files with numerous columns.
+            @param parallel `true` to convert the columns in parallel.
+            @note Categorical columns that are read as strings and have ReplacementStrings()
+             applied to them are converted together on the same thread, as the regular
+             expressions cannot be shared between threads.\n
+             Also, this does not apply to MemoryMapFile(), which converts
+             the data while it tokenizes it.
+            @returns A self reference.*/
+        ImportInfo& ParallelImport(const bool parallel = true) noexcept
+            {
+            m_parallelImport = parallel;
+            return *this;
+            }
+        /** @brief Sets the expected number of rows in the file.
+            @details The file is parsed in a single pass, where rows are added as they are read.
+             If the number of rows is known ahead of time, then providing it here allows
+             for the dataset to allocate space for all of the rows up front.
+            @param rowCount The (approximate) number of rows in the file.
+            @note This is only a hint; the actual number of rows read is not limited by it.
+            @returns A self reference.*/
+        ImportInfo& RowCountHint(const size_t rowCount) noexcept
+            {
+            m_rowCountHint = rowCount;
+            return *this;
+            }
+        /** @brief Sets whether the ID column should be compacted after it is imported.
+            @details IDs are usually unique (e.g., record numbers or names), so they can use
+             a large amount of memory for large files. When this is enabled, IDs that are all
+             integers are stored as such; otherwise, they are packed into a single UTF-8 buffer.
+            @param compact `true` to compact the IDs.
+            @note Reading an ID returns a copy of it, so it is slightly slower when compacted.
+             Also, editing an ID will expand the column back to strings.
+            @sa IdentifierColumn::Compact().
+            @returns A self reference.*/
+        ImportInfo& CompactIds(const bool compact = true) noexcept
+            {
+            m_compactIds = compact;
+            return *this;
+            }
     private:
         std::vector<DateImportInfo> m_dateColumns;
         std::vector<CategoricalImportInfo> m_categoricalColumns;
-        std::vector<wxString> m_continuousColumns;
+        std::vector<ContinuousImportInfo> m_continuousColumns;
         wxString m_idColumn;
         RegExMap m_textImportReplacements;
+        size_t m_chunkSize{ 0 };
+        bool m_memoryMapFile{ false };
+        bool m_parallelImport{ false };
+        size_t m_rowCountHint{ 0 };
+        bool m_compactIds{ false };
+        };
+
+    /// @brief Class for specifying how a file should be sampled when its columns are previewed.
+    /// @details The fields in this class are chainable, so you can set multiple properties
+    ///  in place as you construct it.
+    /// @sa Dataset::ReadColumnInfo().
+    class PreviewInfo
+        {
+        friend class Dataset;
+    public:
+        /** @brief Sets how much of the beginning of the file (which includes the header) to read.
+            @param byteCount The number of bytes to read.
+            @note If the header is longer than this, then more of the file will be read
+             until the end of the header is reached.
+            @returns A self reference.*/
+        PreviewInfo& PrefixSize(const size_t byteCount) noexcept
+            {
+            m_prefixSize = std::max<size_t>(byteCount, 1);
+            return *this;
+            }
+        /** @brief Sets the number of blocks to sample from throughout the rest of the file.
+            @details The blocks are evenly spaced between the prefix and the end of the file.
+             This catches columns whose values change further along in the file
+             (e.g., a numeric column that starts using text codes).
+            @param blockCount The number of blocks to sample (use zero to only read the prefix).
+            @param blockSize The size (in bytes) of each block. Any partial lines
+             at the start or end of a block are ignored.
+            @returns A self reference.*/
+        PreviewInfo& SampleBlocks(const size_t blockCount, const size_t blockSize) noexcept
+            {
+            m_sampleBlockCount = blockCount;
+            m_sampleBlockSize = std::max<size_t>(blockSize, 1);
+            return *this;
+            }
+        /** @brief Sets the percent of a column's (non-empty) sampled values that
+             must be numbers (or dates) for the column to be classified as numeric (or date).
+            @details By default, this is `1.0`, meaning that one text value in
+             the sample will cause a column to be classified as text.
+             Lowering this allows for columns with the occasional stray value
+             (e.g., "N/A") to still be classified as numeric.
+            @param threshold The threshold (between `0.0` and `1.0`).
+            @returns A self reference.*/
+        PreviewInfo& ConfidenceThreshold(const double threshold) noexcept
+            {
+            m_confidenceThreshold = std::clamp(threshold, 0.0, 1.0);
+            return *this;
+            }
+    private:
+        size_t m_prefixSize{ 1024 * 1024 };
+        size_t m_sampleBlockCount{ 8 };
+        size_t m_sampleBlockSize{ 64 * 1024 };
+        double m_confidenceThreshold{ 1.0 };
         };
 
     /** @brief %Dataset interface for graphs.
@@ -606,6 +1695,7 @@ namespace Wisteria::Data
                 L"Column name is empty in call to AddContinuousColumn()!");
             m_continuousColumns.resize(m_continuousColumns.size()+1);
             m_continuousColumns.back().SetTitle(columnName);
+            IndexColumnName(m_continuousColumnIndex, columnName, m_continuousColumns.size()-1);
             m_continuousColumns.back().Resize(GetRowCount(),
                                               std::numeric_limits<double>::quiet_NaN());
             }
@@ -635,6 +1725,7 @@ namespace Wisteria::Data
                 L"Date name is empty in call to AddDateColumn()!");
             m_dateColumns.resize(m_dateColumns.size()+1);
             m_dateColumns.back().SetTitle(columnName);
+            IndexColumnName(m_dateColumnIndex, columnName, m_dateColumns.size()-1);
             m_dateColumns.back().Resize(GetRowCount(), wxInvalidDateTime);
             }
         /** @brief Adds a single data point.
@@ -650,6 +1741,79 @@ namespace Wisteria::Data
              (e.e., call AddDateColumn()); otherwise, this function will create any
              necessary columns with generically generated names.*/
         void AddRow(const RowInfo& dataInfo);
+        /** @brief Adds multiple rows of data, column by column.
+            @details This is much faster than calling AddRow() for each row,
+             as each column's values are appended (or moved) in one step.
+            @param batch The columns of data to fill the rows with.
+            @note Like AddRow(), any columns included in the batch that aren't in the dataset
+             will be added (with generically generated names). Also, if the batch doesn't
+             include all of the dataset's columns (or any of its columns are shorter than
+             the others), then those columns will be filled with missing data
+             (e.g., NaN or @c wxInvalidDateTime) for the new rows.\n
+             Columns stored in a narrower type (see Column::SetStorage()) and compacted
+             IDs (see IdentifierColumn::Compact()) keep their storage, so appending a batch
+             only costs as much as the batch itself.*/
+        void AddRows(ColumnBatch&& batch);
+        /// @private
+        void AddRows(const ColumnBatch& batch)
+            { AddRows(ColumnBatch(batch)); }
+        /** @brief Creates a new dataset from a selection of rows in this one.
+            @details The dataset will have the same columns (and string tables) as this one,
+             and each column is copied in one step. This is much faster than building
+             a new dataset with AddRow().
+            @param rows The indices of the rows to copy (in the order that they should be added).
+            @returns The subset of the data, which can be passed to a graph's @c SetData().
+            @throws std::runtime_error If any of the row indices are out of range.\n
+             The exception's @c what() message is UTF-8 encoded, so pass it to @c wxString::FromUTF8()
+             when formatting it for an error message.*/
+        [[nodiscard]] std::shared_ptr<Dataset> GetSubset(const std::vector<size_t>& rows) const;
+        /** @brief Creates a new dataset from the rows that pass a filter.
+            @param rowFilter A function that is passed a row index and returns
+             `true` if that row should be included.
+            @returns The subset of the data.
+            @code
+             // all scores above 90
+             const auto scoresColumn = testData->GetContinuousColumn(L"Score");
+             auto highScores = testData->GetSubset(
+                [&scoresColumn](const size_t row)
+                    { return scoresColumn->GetValue(row) > 90; });
+            @endcode*/
+        [[nodiscard]] std::shared_ptr<Dataset> GetSubset(
+            const std::function<bool (const size_t)>& rowFilter) const;
+        /** @brief Creates a new dataset from the rows in a group.
+            @details This uses the group column's row index, so the dataset
+             doesn't need to be scanned to find the group's rows.
+            @param groupColumn The categorical column to filter on.
+            @param groupId The group ID (i.e., code) to filter on.
+            @returns The subset of the data.
+            @throws std::runtime_error If the group column can't be found.\n
+             The exception's @c what() message is UTF-8 encoded, so pass it to @c wxString::FromUTF8()
+             when formatting it for an error message.*/
+        [[nodiscard]] std::shared_ptr<Dataset> GetSubset(const wxString& groupColumn,
+                                                         const GroupIdType groupId) const;
+        /** @brief Calculates the association (e.g., correlation) between every pair of
+             continuous columns and returns it as a matrix that can be passed directly to
+             HeatMap::SetData().
+            @details The matrix is calculated in one pass, in parallel over tiles of column pairs.
+             For phi coefficients, the columns are bit packed and compared 64 rows at a time.
+            @param columnNames The continuous columns to compare.
+            @param method How to measure the associations.
+            @returns A dataset with a row for each pair of columns, where the
+             @c "Variable" categorical column is the first column of the pair (with the
+             rows sorted by it) and the @c "Coefficient" continuous column is the association.
+             The IDs are the names of the pair of columns.
+            @code
+             auto matrix = surveyData->GetAssociationMatrix(
+                { L"Q1", L"Q2", L"Q3", L"Q4" }, AssociationMethod::Phi);
+             auto plot = std::make_shared<HeatMap>(canvas);
+             // one group (i.e., row of cells) for each variable
+             plot->SetData(matrix, L"Coefficient", L"Variable", 1);
+            @endcode
+            @throws std::runtime_error If any of the columns can't be found.\n
+             The exception's @c what() message is UTF-8 encoded, so pass it to @c wxString::FromUTF8()
+             when formatting it for an error message.*/
+        [[nodiscard]] std::shared_ptr<Dataset> GetAssociationMatrix(
+            const std::vector<wxString>& columnNames, const AssociationMethod method) const;
         /** @brief During import, sets the column names to the names
              that the client specified.
             @param info The import specification used when importing the
@@ -660,11 +1824,26 @@ namespace Wisteria::Data
         [[nodiscard]] size_t GetRowCount() const noexcept
             { return m_idColumn.GetRowCount(); }
 
+        /** @returns The (approximate) number of bytes that the dataset's columns
+                (and their caches) are using.
+            @note This walks through the ID and categorical columns' strings,
+                so it takes longer for larger datasets.*/
+        [[nodiscard]] MemoryUsage GetMemoryUsage() const;
+        /** @brief Discards everything that the columns have calculated and cached
+                (e.g., summary statistics, group indices, and string table lookups).
+            @details These are rebuilt when next needed, so this only frees memory.
+                Datasets aren't registered with the MemoryBudget (they are copied
+                and shared between graphs in too many ways to track), so clients keeping
+                large datasets around can register them (and call this when evicted).
+            @warning This should not be called while the dataset is being read
+                (e.g., a graph's @c SetData() running on another thread).*/
+        void ReleaseCaches() noexcept;
+
         /// @private
-        [[nodiscard]] const Column<wxString>& GetIdColumn() const noexcept
+        [[nodiscard]] const IdentifierColumn& GetIdColumn() const noexcept
             { return m_idColumn; }
         /// @returns The ID column.
-        [[nodiscard]] Column<wxString>& GetIdColumn() noexcept
+        [[nodiscard]] IdentifierColumn& GetIdColumn() noexcept
             { return m_idColumn; }
 
         /** @brief Gets an iterator to a categorical column by name.
@@ -675,10 +1854,7 @@ namespace Wisteria::Data
              to confirm that the column was found prior to using it.*/
         [[nodiscard]] const auto GetCategoricalColumn(const wxString& columnName) const noexcept
             {
-            return std::find_if(GetCategoricalColumns().cbegin(),
-                GetCategoricalColumns().cend(),
-                [&columnName](const auto& item) noexcept
-                { return item.GetTitle().CmpNoCase(columnName) == 0; });
+            return FindColumn(GetCategoricalColumns(), m_categoricalColumnIndex, columnName);
             }
         /** @brief Gets an iterator to a categorical column by name.
             @param columnName The name of the categorical column to look for.
@@ -688,10 +1864,7 @@ namespace Wisteria::Data
              to confirm that the column was found prior to using it.*/
         [[nodiscard]] auto GetCategoricalColumn(const wxString& columnName) noexcept
             {
-            return std::find_if(GetCategoricalColumns().begin(),
-                GetCategoricalColumns().end(),
-                [&columnName](const auto& item) noexcept
-                { return item.GetTitle().CmpNoCase(columnName) == 0; });
+            return FindColumn(GetCategoricalColumns(), m_categoricalColumnIndex, columnName);
             }
         /// @private
         [[nodiscard]] const std::vector<ColumnWithStringTable>& GetCategoricalColumns() const noexcept
@@ -717,10 +1890,7 @@ namespace Wisteria::Data
              to confirm that the column was found prior to using it.*/
         [[nodiscard]] const auto GetDateColumn(const wxString& columnName) const noexcept
             {
-            return std::find_if(GetDateColumns().cbegin(),
-                GetDateColumns().cend(),
-                [&columnName](const auto& item) noexcept
-                { return item.GetTitle().CmpNoCase(columnName) == 0; });
+            return FindColumn(GetDateColumns(), m_dateColumnIndex, columnName);
             }
         /** @brief Gets an iterator to a date column by name.
             @param columnName The name of the date column to look for.
@@ -730,10 +1900,7 @@ namespace Wisteria::Data
              to confirm that the column was found prior to using it.*/
         [[nodiscard]] auto GetDateColumn(const wxString& columnName) noexcept
             {
-            return std::find_if(GetDateColumns().begin(),
-                GetDateColumns().end(),
-                [&columnName](const auto& item) noexcept
-                { return item.GetTitle().CmpNoCase(columnName) == 0; });
+            return FindColumn(GetDateColumns(), m_dateColumnIndex, columnName);
             }
         /// @private
         [[nodiscard]] const std::vector<Column<wxDateTime>>& GetDateColumns() const noexcept
@@ -759,10 +1926,7 @@ namespace Wisteria::Data
              to confirm that the column was found prior to using it.*/
         [[nodiscard]] const auto GetContinuousColumn(const wxString& columnName) const noexcept
             {
-            return std::find_if(GetContinuousColumns().cbegin(),
-                GetContinuousColumns().cend(),
-                [&columnName](const auto& item) noexcept
-                { return item.GetTitle().CmpNoCase(columnName) == 0; });
+            return FindColumn(GetContinuousColumns(), m_continuousColumnIndex, columnName);
             }
         /// @private
         [[nodiscard]] const std::vector<Column<double>>& GetContinuousColumns() const noexcept
@@ -848,6 +2012,42 @@ namespace Wisteria::Data
         [[nodiscard]] static ColumnPreviewInfo ReadColumnInfo(const wxString& filePath,
                                                               const wchar_t delimiter,
                                                               const size_t rowPreviewCount = 100);
+        /** @brief Reads the column names from a file and deduces their data types
+             by sampling the file.
+            @details Rather than reading the entire file, this reads the beginning of the file
+             and a number of evenly spaced blocks throughout it, so it returns almost instantly
+             even for very large files.
+            @param filePath The path to the data file.
+            @param delimiter The delimiter to parse the columns with.
+            @param info How to sample the file.
+            @returns A vector of column names and their respective data types.
+            @note UTF-16 and UTF-32 files are read entirely (using the other ReadColumnInfo()).
+            @throws std::runtime_error If the file can't be read, throws an exception.\n
+             The exception's @c what() message is UTF-8 encoded, so pass it to @c wxString::FromUTF8()
+             when formatting it for an error message.*/
+        [[nodiscard]] static ColumnPreviewInfo ReadColumnInfo(const wxString& filePath,
+                                                              const wchar_t delimiter,
+                                                              const PreviewInfo& info);
+        /** @brief Samples a file's columns (see ReadColumnInfo()) on a background thread.
+            @details This is useful for showing a UI (e.g., a VariableSelectDlg) while
+             the file is being sampled.
+            @param filePath The path to the data file.
+            @param delimiter The delimiter to parse the columns with.
+            @param info How to sample the file.
+            @returns The column information, which will be available when the sampling is complete.
+             Any errors reading the file will be thrown when calling the future's @c get().
+            @code
+             auto columnInfo = Dataset::ReadColumnInfoAsync(filePath, L',', PreviewInfo());
+             // ...do other work (e.g., build the UI)
+             VariableSelectDlg dlg(this, columnInfo.get(), varInfo);
+            @endcode*/
+        [[nodiscard]] static std::future<ColumnPreviewInfo> ReadColumnInfoAsync(
+            const wxString& filePath, const wchar_t delimiter, const PreviewInfo& info)
+            {
+            return std::async(std::launch::async,
+                [filePath, delimiter, info]()
+                { return ReadColumnInfo(filePath, delimiter, info); });
+            }
         /** @brief Imports a text file into the dataset.
             @param filePath The path to the data file.
             @param info The definition for which columns to import and how to map them.
@@ -890,16 +2090,21 @@ namespace Wisteria::Data
             { ImportText(filePath, info, L'\t'); }
         /** @brief Exports the dataset to a text file.
             @details Continuous columns are exported with six-point precision and date
-             columns are exported in ISO date & time format.
+             columns are exported in ISO date & time format.\n
+             The file is written (as UTF-8) in blocks of rows as they are formatted,
+             so the entire file is never held in memory.
             @param filePath The file path to save to.
             @param delimiter The delimiter to save with.
             @param quoteColumns Whether the columns should be quoted.
+            @param parallelFormat `true` to format each block of rows on multiple threads.
+             This is recommended for large datasets.
             @throws std::runtime_error If the file can't be written to.\n
              The exception's @c what() message is UTF-8 encoded, so pass it to @c wxString::FromUTF8()
              when formatting it for an error message.*/
         void ExportText(const wxString& filePath,
                         const wchar_t delimiter,
-                        const bool quoteColumns) const;
+                        const bool quoteColumns,
+                        const bool parallelFormat = false) const;
         /** @brief Exports the dataset to as a tab-delimited text file.
             @details This is a shortcut for ExportText(), using tabs as the column separator.
             @param filePath The file path to save to.
@@ -917,7 +2122,64 @@ namespace Wisteria::Data
              when formatting it for an error message.*/
         void ExportCSV(const wxString& filePath) const
             { ExportText(filePath, L',', true); }
+        /** @brief Saves the dataset to a binary (columnar) file.
+            @details The columns are saved in their native formats: continuous columns as doubles,
+             categorical columns as their codes (along with their string tables), and dates as
+             milliseconds since the epoch. Loading this file with ImportBinary() is much
+             faster than re-importing the original text file.
+            @param filePath The file path to save to.
+            @note The file is saved using the system's byte order, so it is meant for caching
+             imported data (e.g., sharing it between processes on the same system),
+             not for exchanging data.
+            @throws std::runtime_error If the file can't be written to.\n
+             The exception's @c what() message is UTF-8 encoded, so pass it to @c wxString::FromUTF8()
+             when formatting it for an error message.*/
+        void ExportBinary(const wxString& filePath) const;
+        /** @brief Loads a dataset that was saved with ExportBinary().
+            @details The file is memory mapped and its columns are copied directly into
+             the dataset, so no text parsing is involved.
+            @param filePath The path to the data file.
+            @throws std::runtime_error If the file can't be read or isn't a valid dataset file.\n
+             The exception's @c what() message is UTF-8 encoded, so pass it to @c wxString::FromUTF8()
+             when formatting it for an error message.*/
+        void ImportBinary(const wxString& filePath);
     private:
+        // lowercased column names and their positions in their respective column vectors
+        using ColumnNameIndex = std::unordered_map<wxString, size_t, StringHash>;
+
+        /** @brief Finds a column by name (case insensitively), using a name index.
+            @details Because clients can rename columns (or add them) directly,
+             the index is verified and a linear search is performed
+             if it is out of date.
+            @param columns The columns to search.
+            @param columnIndex The name index for the columns.
+            @param columnName The name of the column to look for.
+            @returns An iterator to the column if found, `columns.end()` otherwise.*/
+        template<typename columnsT>
+        [[nodiscard]] static auto FindColumn(columnsT& columns, const ColumnNameIndex& columnIndex,
+                                             const wxString& columnName)
+            {
+            const auto foundColumn = columnIndex.find(columnName.Lower());
+            if (foundColumn != columnIndex.cend() && foundColumn->second < columns.size() &&
+                columns[foundColumn->second].GetTitle().CmpNoCase(columnName) == 0)
+                { return columns.begin() + foundColumn->second; }
+            return std::find_if(columns.begin(), columns.end(),
+                [&columnName](const auto& item) noexcept
+                { return item.GetTitle().CmpNoCase(columnName) == 0; });
+            }
+        /// @brief Adds a column name to a name index.
+        /// @details If there is already a column with this name, then the first one is kept
+        ///  (which is the one that a linear search would find).
+        static void IndexColumnName(ColumnNameIndex& columnIndex, const wxString& columnName,
+                                    const size_t position)
+            { columnIndex.insert(std::make_pair(columnName.Lower(), position)); }
+        /// @brief After an import, compacts the ID column and narrows the continuous columns
+        ///  if requested.
+        /// @param info The import specification used when importing the data.
+        void ApplyStorageOptions(const ImportInfo& info);
+        /// @brief Rebuilds the column name indices from the current columns.
+        void RebuildColumnIndices();
+
         /// @returns The specified continuous column.
         /// @param column The index into the list of continuous columns.
         [[nodiscard]] Column<double>& GetContinuousColumn(const size_t column) noexcept
@@ -939,19 +2201,222 @@ namespace Wisteria::Data
         [[nodiscard]] Column<wxDateTime>& GetDateColumn(const size_t column) noexcept
             { return m_dateColumns.at(column); }
         [[nodiscard]] static double ConvertToDouble(const wxString& input);
+        [[nodiscard]] static double ConvertToDoubleFast(const wxString& input,
+                                                        const wchar_t decimalSeparator);
+        // negative or non-numeric codes are read as 0; empty ones as mdCode
         [[nodiscard]] static GroupIdType ConvertToGroupId(const wxString& input,
                                                           const GroupIdType mdCode);
         [[nodiscard]] static wxDateTime ConvertToDate(const wxString& input,
                                                       const DateImportMethod method,
                                                       const wxString& formatStr);
+        // versions of the above conversions that work directly on UTF-8 text
+        [[nodiscard]] static double ConvertUtf8ToDouble(const std::string_view input,
+                                                        const wchar_t decimalSeparator = L'.');
+        [[nodiscard]] static GroupIdType ConvertUtf8ToGroupId(const std::string_view input,
+                                                              const GroupIdType mdCode);
+        [[nodiscard]] static wxString ConvertUtf8ToString(const std::string_view input);
+        /// @brief Applies the client's regex replacements to a string being imported.
+        /// @param[in,out] str The string to transform.
+        /// @param info The import specification containing the replacements.
+        static void ApplyReplacementStrings(wxString& str, const ImportInfo& info);
+        /// @brief Applies the client's regex replacements to a string being imported,
+        ///  only transforming each distinct string once.
+        /// @param str The string to transform.
+        /// @param info The import specification containing the replacements.
+        /// @param[in,out] replacedStrings The previously transformed strings.
+        ///  This holds at most @c MAX_REPLACED_STRINGS strings.
+        /// @returns The transformed string, which is only valid until the next call.
+        [[nodiscard]] static const wxString& ApplyReplacementStrings(const wxString& str,
+            const ImportInfo& info,
+            std::unordered_map<wxString, wxString, StringHash>& replacedStrings);
+        // the most distinct strings to remember the replacements for during an import
+        static constexpr size_t MAX_REPLACED_STRINGS{ 64 * 1024 };
+
+        // column index with specialized import method
+        struct CategoricalIndexInfo
+            {
+            size_t m_index{ 0 };
+            CategoricalImportMethod m_importMethod{ CategoricalImportMethod::ReadAsStrings };
+            GroupIdType m_mdCode{ 0 };
+            };
+
+        // column index with specialized import method
+        struct DateIndexInfo
+            {
+            size_t m_index{ 0 };
+            DateImportMethod m_importMethod{ DateImportMethod::Automatic };
+            wxString m_formatStr;
+            };
+
+        // column index with specialized import method
+        struct ContinuousIndexInfo
+            {
+            size_t m_index{ 0 };
+            ContinuousImportMethod m_importMethod{ ContinuousImportMethod::Standard };
+            wchar_t m_decimalSeparator{ L'.' };
+            };
+
+        // the indices into a file's columns that map to the columns requested by the client
+        struct ImportColumnMap
+            {
+            std::optional<size_t> m_idColumnIndex;
+            std::vector<std::optional<DateIndexInfo>> m_dateColumnIndices;
+            std::vector<std::optional<CategoricalIndexInfo>> m_catColumnIndices;
+            std::vector<std::optional<ContinuousIndexInfo>> m_continuousColumnIndices;
+            };
+
+        // assigns integer codes to strings (in the order they are encountered) while importing
+        class StringTableBuilder
+            {
+        public:
+            StringTableBuilder() = default;
+            // seeds the builder with known strings and their codes
+            explicit StringTableBuilder(const ColumnWithStringTable::StringTableType& stringTable);
+            // Looks up (or assigns) the code for a string, case insensitively.
+            // Strings are only case folded the first time that they are encountered.
+            [[nodiscard]] GroupIdType LoadCode(const wxString& code);
+            // the codes and the first spelling of their strings encountered
+            [[nodiscard]] const ColumnWithStringTable::StringTableType& GetStrings() const noexcept
+                { return m_strings; }
+        private:
+            GroupIdType m_currentId{ 0 };
+            // strings exactly as they appeared in the data
+            std::unordered_map<wxString, GroupIdType, StringHash> m_rawStrings;
+            // lowercased strings, used for case-insensitive lookups
+            std::unordered_map<wxString, GroupIdType, StringHash> m_foldedStrings;
+            ColumnWithStringTable::StringTableType m_strings;
+            };
+
+        // A strptime()-like date format, compiled into a sequence of fields
+        // that can be parsed without having to re-interpret the format string.
+        // Only supports %Y, %m, %d, %H, %M, %S, and literal characters.
+        class CompiledDateFormat
+            {
+        public:
+            explicit CompiledDateFormat(const wxString& format)
+                { Compile(format); }
+            CompiledDateFormat() = default;
+            [[nodiscard]] bool IsOk() const noexcept
+                { return !m_fields.empty(); }
+            // @returns The parsed date, or wxInvalidDateTime if the input
+            //  doesn't (entirely) match the format.
+            [[nodiscard]] wxDateTime Parse(const wxString& input) const;
+        private:
+            void Compile(const wxString& format);
+            // the format specifier (e.g., 'Y'), or 0 if a literal character
+            struct Field
+                {
+                wchar_t m_specifier{ 0 };
+                wchar_t m_literal{ 0 };
+                };
+            std::vector<Field> m_fields;
+            };
+
+        // parses the dates for a column while importing, caching the column's format
+        class DateColumnParser
+            {
+        public:
+            DateColumnParser(const DateImportMethod method, const wxString& formatStr);
+            [[nodiscard]] wxDateTime Parse(const wxString& input);
+        private:
+            void SampleFormat(const wxString& input);
+            // the number of values reviewed when detecting a column's format
+            static constexpr size_t m_sampleSize{ 50 };
+
+            DateImportMethod m_importMethod{ DateImportMethod::Automatic };
+            wxString m_formatStr;
+            CompiledDateFormat m_format;
+            // formats still being considered while detecting the column's format
+            std::vector<CompiledDateFormat> m_candidateFormats;
+            size_t m_sampledCount{ 0 };
+            };
+
+        // state that persists between the blocks of text being imported
+        struct ImportState
+            {
+            std::vector<StringTableBuilder> m_categoricalVars;
+            std::vector<DateColumnParser> m_dateParsers;
+            // raw strings and what they became after the replacement regexes were applied
+            std::unordered_map<wxString, wxString, StringHash> m_replacedStrings;
+            };
+        /// @brief Creates the string table builders and date parsers for an import.
+        [[nodiscard]] static ImportState CreateImportState(const ImportColumnMap& columnMap,
+                                                           const ImportInfo& info);
+
+        /** @brief Maps the columns requested by the client to the columns of a file.
+            @param headerNames The column names from the file.
+            @param info The import specification from the client.
+            @returns The indices of the requested columns.
+            @throws std::runtime_error If any requested columns aren't in the file.*/
+        [[nodiscard]] static ImportColumnMap MapImportColumns(
+            const std::vector<std::wstring>& headerNames, const ImportInfo& info);
+        /** @brief Creates a row definition for the text importer that only reads
+             the columns being imported.
+            @details The other columns are still scanned, but their text is never copied.
+            @param[in,out] columnMap The columns being imported. Their indices will be
+             remapped to where the columns will be in the rows that are read.
+            @param columnCount The number of columns in the file.
+            @param delimiter The delimiter between the columns.
+            @returns The row definition and the number of columns that it will read.*/
+        [[nodiscard]] static std::pair<lily_of_the_valley::text_row<wxString>, size_t>
+            ProjectImportColumns(ImportColumnMap& columnMap, const size_t columnCount,
+                                 const wchar_t delimiter);
+        /** @brief Converts parsed rows of text and appends them to the dataset.
+            @param dataStrings The rows of text (already split into columns).
+            @param columnMap Which columns of text to read and where to write them.
+            @param info The import specification from the client.
+            @param[in,out] state The string tables being built for the
+             categorical columns and the date parsers. These persist between calls
+             in case the data is being loaded in chunks.*/
+        void ImportTextRows(const std::vector<std::vector<wxString>>& dataStrings,
+                            const ImportColumnMap& columnMap, const ImportInfo& info,
+                            ImportState& state);
+        /// @brief Same as ImportTextRows(), but converts each column independently
+        ///  (and in parallel) instead of row by row.
+        void ImportTextColumns(const std::vector<std::vector<wxString>>& dataStrings,
+                               const ImportColumnMap& columnMap, const ImportInfo& info,
+                               ImportState& state);
+        /** @brief Imports a text file, reading and converting it in blocks.
+            @param filePath The path to the data file.
+            @param info The import specification from the client.
+            @param delimiter The delimiter to parse the columns with.
+            @returns `false` if the file's encoding prevents it from being split,
+             in which case nothing was loaded.*/
+        bool ImportTextChunked(const wxString& filePath, const ImportInfo& info,
+                               const wchar_t delimiter);
+        // how many chunks a block can grow to while looking for a line end outside of quotes
+        // before an unbalanced quote is assumed and the block is split at any line end
+        static constexpr size_t MAX_QUOTED_BLOCK_CHUNKS{ 4 };
+        /** @brief Imports a text file by memory mapping it and tokenizing it in place.
+            @param filePath The path to the data file.
+            @param info The import specification from the client.
+            @param delimiter The delimiter to parse the columns with.
+            @returns `false` if the file couldn't be mapped or isn't UTF-8,
+             in which case nothing was loaded.*/
+        bool ImportTextMapped(const wxString& filePath, const ImportInfo& info,
+                              const wchar_t delimiter);
+        /// @brief Moves the string tables built during an import into the categorical columns.
+        /// @param categoricalVars The string tables built while importing.
+        void ApplyImportStringTables(const std::vector<StringTableBuilder>& categoricalVars);
+
+        // header values for files written by ExportBinary()
+        static constexpr std::array<char, 4> m_binaryFileSignature{ 'W', 'D', 'S', 'B' };
+        static constexpr uint32_t m_binaryFileVersion{ 1 };
+        // used to detect files written on a system with a different byte order
+        static constexpr uint32_t m_binaryByteOrderMark{ 0x01020304 };
 
         wxString m_name;
 
         // actual data
-        Column<wxString> m_idColumn{ L"IDS" };
+        IdentifierColumn m_idColumn{ L"IDS" };
         std::vector<Column<wxDateTime>> m_dateColumns;
         std::vector<ColumnWithStringTable> m_categoricalColumns;
         std::vector<Column<double>> m_continuousColumns;
+
+        // name lookups for the columns
+        ColumnNameIndex m_dateColumnIndex;
+        ColumnNameIndex m_categoricalColumnIndex;
+        ColumnNameIndex m_continuousColumnIndex;
         };
     }
 
@@ -13,6 +13,7 @@
 #define __WISTERIA_JITTER_H__
 
 #include <algorithm>
+#include <vector>
 #include "../math/safe_math.h"
 #include "../math/mathematics.h"
 #include "../util/frequency_set.h"
@@ -41,8 +42,8 @@ namespace Wisteria::Data
         // CalcSpread() should be called once when an axis's data is set
         frequency_set<double> jitterPoints;
         // assuming "ptCollection" is a pointer to a Dataset.
-        for (const auto& datum : ptCollection->GetYColumn().GetValues())
-            { jitterPoints.insert(datum); }
+        ptCollection->GetYColumn().ForEachValue([&jitterPoints](const double datum)
+            { jitterPoints.insert(datum); });
         jtr.CalcSpread(jitterPoints);
 
         ...
@@ -92,21 +93,27 @@ namespace Wisteria::Data
             @param points The data points to analyze.
             @note This only needs to be called once after a plot's data changes,
              does not need to be called after calls to SetJitterWidth() or ResetJitterData().*/
-        template<typename T>
-        void CalcSpread(const frequency_set<T>& points) noexcept
+        template<typename T, typename Compare, typename Storage>
+        void CalcSpread(const frequency_set<T, Compare, Storage>& points) noexcept
             {
             if (points.get_data().size() == 0)
                 {
                 m_numberOfPointsOnEachSide = 0;
                 return;
                 }
+            CalcSpread(std::max_element(points.get_data().cbegin(), points.get_data().cend(),
+                [](const auto& first, const auto& second)
+                    { return first.second < second.second; })->second);
+            }
+
+        /** @brief Determines how many points should be spread across each side of the axis.
+            @param mostFrequentCount The number of times the most frequent value appears in the data.
+            @note This is useful if the caller already knows the largest frequency
+             and doesn't need to build a frequency_set.*/
+        void CalcSpread(const size_t mostFrequentCount) noexcept
+            {
             m_numberOfPointsOnEachSide =
-                static_cast<size_t>(round_to_integer(
-                safe_divide<double>(
-                    std::max_element(points.get_data().cbegin(), points.get_data().cend(),
-                        [](const auto& first, const auto& second)
-                            { return first.second < second.second; })->second,
-                    2)));
+                static_cast<size_t>(round_to_integer(safe_divide<double>(mostFrequentCount, 2)));
             }
 
         /** @brief Sets the width of how far the points can be jittered around the axis.
@@ -123,7 +130,7 @@ namespace Wisteria::Data
              just clears data from previous jittering calls.
             @note Calling SetJitterWidth() will call this for you.*/
         void ResetJitterData() noexcept
-            { m_plottedPoints.clear(); }
+            { std::fill(m_plottedPoints.begin(), m_plottedPoints.end(), 0); }
 
         /** @brief Jitters a point.
             @param[in,out] pt The point to be jittered (along the non-dominant axis).
@@ -134,41 +141,48 @@ namespace Wisteria::Data
              another series of calls to this function.*/
         bool JitterPoint(wxPoint& pt)
             {
-            if (m_dominantAxis == AxisType::LeftYAxis ||
-                m_dominantAxis == AxisType::RightYAxis)
-                {
-                const auto plottedPointInfo = m_plottedPoints.insert(pt.y);
-                // only jitter if there is already another point on the axis line
-                if (plottedPointInfo->second > 1)
-                    {
-                    // if an even number of points, jitter to the left
-                    pt.x += is_even(plottedPointInfo->second) ?
-                        -static_cast<wxCoord>(safe_divide(m_jitterSideWidth, m_numberOfPointsOnEachSide)*
-                                std::clamp<size_t>(safe_divide<size_t>(plottedPointInfo->second,2), 1, m_numberOfPointsOnEachSide)) :
-                        // or to the right if odd
-                         static_cast<wxCoord>(safe_divide(m_jitterSideWidth, m_numberOfPointsOnEachSide)*
-                                std::clamp<size_t>(safe_divide<size_t>(plottedPointInfo->second,2), 1, m_numberOfPointsOnEachSide));
-                    return true;
-                    }
-                return false;
-                }
-            else
+            const bool jitterAlongX = (m_dominantAxis == AxisType::LeftYAxis ||
+                                       m_dominantAxis == AxisType::RightYAxis);
+            const size_t tiedCount = ++GetPlottedPointCount(jitterAlongX ? pt.y : pt.x);
+            // only jitter if there is already another point on the axis line
+            if (tiedCount <= 1)
+                { return false; }
+            const auto offset =
+                static_cast<wxCoord>(safe_divide(m_jitterSideWidth, m_numberOfPointsOnEachSide)*
+                    std::clamp<size_t>(safe_divide<size_t>(tiedCount, 2), 1, m_numberOfPointsOnEachSide));
+            // if an even number of points, jitter to the left (or down);
+            // otherwise, to the right (or up)
+            (jitterAlongX ? pt.x : pt.y) += is_even(tiedCount) ? -offset : offset;
+            return true;
+            }
+    private:
+        /** @returns The number of points already plotted at a coordinate along the dominant axis.
+            @param coordinate The coordinate along the dominant axis.
+            @details The counts are stored in a table indexed by coordinate (offset from the lowest one seen),
+             so looking up a point's position is constant time. The table only spans the
+             physical coordinates of the axis, so it stays small.*/
+        [[nodiscard]] size_t& GetPlottedPointCount(const wxCoord coordinate)
+            {
+            if (m_plottedPoints.empty())
+                { m_firstCoordinate = coordinate; }
+            if (coordinate < m_firstCoordinate)
                 {
-                const auto plottedPointInfo = m_plottedPoints.insert(pt.x);
-                if (plottedPointInfo->second > 1)
-                    {
-                    pt.y += is_even(plottedPointInfo->second) ?
-                        -static_cast<wxCoord>(safe_divide(m_jitterSideWidth, m_numberOfPointsOnEachSide)*
-                                std::clamp<size_t>(safe_divide<size_t>(plottedPointInfo->second,2), 1, m_numberOfPointsOnEachSide)) :
-                         static_cast<wxCoord>(safe_divide(m_jitterSideWidth, m_numberOfPointsOnEachSide)*
-                                std::clamp<size_t>(safe_divide<size_t>(plottedPointInfo->second,2), 1, m_numberOfPointsOnEachSide));
-                    return true;
-                    }
-                return false;
+                // grow downwards, with some headroom so that repeated growth is amortized
+                const auto growth = std::max(static_cast<size_t>(m_firstCoordinate - coordinate),
+                                             m_plottedPoints.size());
+                m_plottedPoints.insert(m_plottedPoints.begin(), growth, 0);
+                m_firstCoordinate -= static_cast<wxCoord>(growth);
                 }
+            const auto index = static_cast<size_t>(coordinate - m_firstCoordinate);
+            if (index >= m_plottedPoints.size())
+                { m_plottedPoints.resize(std::max(index + 1, m_plottedPoints.size() * 2), 0); }
+            return m_plottedPoints[index];
             }
-    private:
-        frequency_set<wxCoord> m_plottedPoints;
+
+        // the number of points plotted at each coordinate along the dominant axis,
+        // starting from m_firstCoordinate
+        std::vector<size_t> m_plottedPoints;
+        wxCoord m_firstCoordinate{ 0 };
         size_t m_jitterSideWidth{ 0 };
         size_t m_numberOfPointsOnEachSide{ 50 };
         AxisType m_dominantAxis{ AxisType::LeftYAxis };
@@ -1,4 +1,8 @@
 #include "textclassifier.h"
+#include <array>
+#include <cwctype>
+#include <string_view>
+#include <thread>
 
 namespace Wisteria::Data
     {
@@ -10,7 +14,7 @@ namespace Wisteria::Data
         const std::optional<wxString>& negationPatternsColumnName)
         {
         // reset
-        m_categoryPatternsMap.clear();
+        m_categoryPatterns.clear();
         m_categoryColumnName.clear();
         m_subCategoryColumnName = std::nullopt;
 
@@ -54,6 +58,7 @@ namespace Wisteria::Data
             { subCatMDCode = ColumnWithStringTable::GetNextKey(m_subCategoriesStringTable); }
 
         // build a map of unique categories and all the regexes connected to them.
+        std::map<IdPair, std::vector<std::pair<wxString, wxString>>> categoryPatterns;
         for (size_t i = 0; i < classifierData->GetRowCount(); ++i)
             {
             // make sure the regex is OK before loading it for later
@@ -67,15 +72,9 @@ namespace Wisteria::Data
 
             if (reValue.length() && re.IsValid())
                 {
-                m_categoryPatternsMap.insert(
-                    std::make_pair(categoryCol->GetValue(i),
-                        (subCategoryColumnName ? subCategoryCol->GetValue(i) : subCatMDCode.value())),
-                    std::make_pair(std::make_shared<wxRegEx>(reValue),
-                        // empty string can be seen as valid, so an unitialized wxRegEx
-                        // if there is no string
-                        negatingReValue.length() ?
-                        std::make_shared<wxRegEx>(negatingReValue) :
-                        std::make_shared<wxRegEx>()));
+                categoryPatterns[std::make_pair(categoryCol->GetValue(i),
+                    (subCategoryColumnName ? subCategoryCol->GetValue(i) : subCatMDCode.value()))].
+                    emplace_back(reValue, negatingReValue);
                 }
             else
                 {
@@ -84,6 +83,315 @@ namespace Wisteria::Data
                              categoryCol->GetCategoryLabelFromID(categoryCol->GetValue(i)));
                 }
             }
+
+        // compile each category's regexes
+        m_categoryPatterns.reserve(categoryPatterns.size());
+        for (const auto& [id, patterns] : categoryPatterns)
+            { m_categoryPatterns.emplace_back(id, CompilePatterns(patterns)); }
+        }
+
+    //----------------------------------------------------------------
+    std::optional<TextClassifier::RequiredLiteral> TextClassifier::FindRequiredLiteral(
+        const wxString& pattern)
+        {
+        // literals shorter than this won't rule out enough text to be worth checking
+        constexpr size_t MIN_LITERAL_LENGTH{ 3 };
+
+        wxString strippedPattern{ pattern };
+        RequiredLiteral literal;
+        literal.m_ignoreCase = RemoveIgnoreCaseOption(strippedPattern);
+        const std::wstring re{ strippedPattern.ToStdWstring() };
+        // alternations, other inline options (including extended mode), and verbs
+        // make it too complicated to know what must be in the text
+        if (re.find(L'|') != std::wstring::npos ||
+            re.find(L"(?") != std::wstring::npos ||
+            re.find(L"(*") != std::wstring::npos)
+            { return std::nullopt; }
+
+        const auto isLiteralChar = [](const wchar_t ch) noexcept
+            {
+            return (ch >= L'a' && ch <= L'z') || (ch >= L'A' && ch <= L'Z') ||
+                   (ch >= L'0' && ch <= L'9') || ch == L' ';
+            };
+
+        std::wstring currentRun;
+        const auto endRun = [&literal, &currentRun]()
+            {
+            if (currentRun.length() > literal.m_text.length())
+                { literal.m_text = currentRun; }
+            currentRun.clear();
+            };
+
+        int groupDepth{ 0 };
+        for (size_t i = 0; i < re.length(); ++i)
+            {
+            const wchar_t ch = re[i];
+            if (ch == L'\\')
+                {
+                endRun();
+                // classes (e.g., "\w") and word boundaries are fine, but anything else
+                // (e.g., back references or hex codes) is too complicated to review
+                if (i + 1 < re.length() &&
+                    std::wstring_view{ L"bBdDwWsS" }.find(re[i + 1]) == std::wstring_view::npos &&
+                    isLiteralChar(re[i + 1]))
+                    { return std::nullopt; }
+                ++i;
+                }
+            else if (ch == L'[')
+                {
+                endRun();
+                // skip over the character class
+                ++i;
+                if (i < re.length() && re[i] == L'^')
+                    { ++i; }
+                if (i < re.length() && re[i] == L']')
+                    { ++i; }
+                while (i < re.length() && re[i] != L']')
+                    { i += (re[i] == L'\\') ? 2 : 1; }
+                }
+            else if (ch == L'{')
+                {
+                endRun();
+                // skip over the quantifier's range
+                while (i < re.length() && re[i] != L'}')
+                    { ++i; }
+                }
+            else if (ch == L'(')
+                {
+                endRun();
+                ++groupDepth;
+                }
+            else if (ch == L')')
+                {
+                endRun();
+                --groupDepth;
+                }
+            // anything inside of a group may be optional, so only review the top level
+            else if (groupDepth == 0 && isLiteralChar(ch))
+                {
+                // a quantifier after this character may make it optional
+                const wchar_t nextCh = (i + 1 < re.length()) ? re[i + 1] : 0;
+                if (nextCh == L'?' || nextCh == L'*' || nextCh == L'{')
+                    {
+                    endRun();
+                    continue;
+                    }
+                currentRun += literal.m_ignoreCase ? static_cast<wchar_t>(std::towlower(ch)) : ch;
+                // repeated, so it can't be part of a longer run
+                if (nextCh == L'+')
+                    { endRun(); }
+                }
+            else
+                { endRun(); }
+            }
+        endRun();
+
+        return (literal.m_text.length() >= MIN_LITERAL_LENGTH) ?
+            std::optional<RequiredLiteral>(literal) : std::nullopt;
+        }
+
+    //----------------------------------------------------------------
+    bool TextClassifier::RemoveIgnoreCaseOption(wxString& pattern)
+        {
+        if (pattern.StartsWith(L"(?i)"))
+            {
+            pattern.erase(0, 4);
+            return true;
+            }
+        return false;
+        }
+
+    //----------------------------------------------------------------
+    bool TextClassifier::CanCombinePattern(const wxString& pattern)
+        {
+        const std::wstring re{ pattern.ToStdWstring() };
+        // verbs (e.g., "(*UTF)") must be at the start of the regex
+        if (re.find(L"(*") != std::wstring::npos)
+            { return false; }
+        // named groups may conflict with ones in other patterns
+        if (re.find(L"(?<") != std::wstring::npos || re.find(L"(?P") != std::wstring::npos ||
+            re.find(L"(?'") != std::wstring::npos)
+            { return false; }
+        // back references would be renumbered when combined with other patterns
+        for (size_t i = 0; i + 1 < re.length(); ++i)
+            {
+            if (re[i] == L'\\')
+                {
+                const wchar_t nextCh = re[i + 1];
+                if ((nextCh >= L'1' && nextCh <= L'9') || nextCh == L'g' || nextCh == L'k')
+                    { return false; }
+                // skip the escaped character (e.g., "\\")
+                ++i;
+                }
+            }
+        return true;
+        }
+
+    //----------------------------------------------------------------
+    std::vector<TextClassifier::CategoryPattern> TextClassifier::CompilePatterns(
+        const std::vector<std::pair<wxString, wxString>>& patterns)
+        {
+        std::vector<CategoryPattern> compiledPatterns;
+
+        const auto addPattern = [&compiledPatterns](const wxString& pattern,
+                                                    const wxString& negatingPattern,
+                                                    std::vector<RequiredLiteral> requiredLiterals)
+            {
+            CategoryPattern compiledPattern{ pattern, negatingPattern,
+                                             std::make_shared<wxRegEx>(pattern), nullptr,
+                                             std::move(requiredLiterals) };
+            if (!compiledPattern.m_regex->IsValid())
+                { return false; }
+            // empty string can be seen as valid, so only load a negating regex if there is one
+            if (negatingPattern.length())
+                {
+                auto negatingRegex = std::make_shared<wxRegEx>(negatingPattern);
+                if (negatingRegex->IsValid())
+                    { compiledPattern.m_negatingRegex = std::move(negatingRegex); }
+                }
+            compiledPatterns.push_back(std::move(compiledPattern));
+            return true;
+            };
+
+        // Patterns without negations can be combined into one alternation, so that the text
+        // is only scanned once for all of them. These are split by whether they have
+        // a required literal, which can be used to skip the regex entirely, and by
+        // whether they are case insensitive. (A "(?i)" option is only supported at
+        // the start of a regex by every wxRegEx backend, so it is removed from each pattern
+        // and put in front of the combined regex instead.)
+        struct PatternsToCombine
+            {
+            std::vector<wxString> m_patterns;
+            std::vector<RequiredLiteral> m_requiredLiterals;
+            };
+        // indexed by [has a required literal][ignores case]
+        std::array<std::array<PatternsToCombine, 2>, 2> combinablePatterns;
+        for (const auto& [pattern, negatingPattern] : patterns)
+            {
+            const auto requiredLiteral = FindRequiredLiteral(pattern);
+            wxString strippedPattern{ pattern };
+            const bool ignoreCase = RemoveIgnoreCaseOption(strippedPattern);
+            if (negatingPattern.empty() && CanCombinePattern(strippedPattern))
+                {
+                auto& patternsToCombine =
+                    combinablePatterns[requiredLiteral.has_value()][ignoreCase];
+                patternsToCombine.m_patterns.push_back(strippedPattern);
+                if (requiredLiteral)
+                    { patternsToCombine.m_requiredLiterals.push_back(requiredLiteral.value()); }
+                }
+            else
+                {
+                addPattern(pattern, negatingPattern,
+                    requiredLiteral ?
+                        std::vector<RequiredLiteral>{ requiredLiteral.value() } :
+                        std::vector<RequiredLiteral>{});
+                }
+            }
+
+        const auto addCombinedPatterns = [&addPattern](const PatternsToCombine& patternsToCombine,
+                                                       const bool ignoreCase)
+            {
+            const wxString optionsPrefix{ ignoreCase ? L"(?i)" : L"" };
+            const auto& literals = patternsToCombine.m_requiredLiterals;
+            if (patternsToCombine.m_patterns.size() > 1)
+                {
+                // use plain (capturing) groups, as non-capturing groups are not
+                // supported by extended (POSIX) regex syntax
+                wxString combinedPattern{ optionsPrefix };
+                for (const auto& pattern : patternsToCombine.m_patterns)
+                    {
+                    if (combinedPattern.length() > optionsPrefix.length())
+                        { combinedPattern += L'|'; }
+                    combinedPattern.append(L"(").append(pattern).append(L")");
+                    }
+                // make sure that the combined regex compiles; if it doesn't,
+                // then fall back to using the patterns separately
+                wxLogNull suppressErrors;
+                if (addPattern(combinedPattern, wxString{}, literals))
+                    { return; }
+                }
+            for (size_t i = 0; i < patternsToCombine.m_patterns.size(); ++i)
+                {
+                addPattern(optionsPrefix + patternsToCombine.m_patterns[i], wxString{},
+                    literals.empty() ?
+                        std::vector<RequiredLiteral>{} :
+                        std::vector<RequiredLiteral>{ literals[i] });
+                }
+            };
+        for (const bool hasLiteral : { true, false })
+            {
+            for (const bool ignoreCase : { false, true })
+                { addCombinedPatterns(combinablePatterns[hasLiteral][ignoreCase], ignoreCase); }
+            }
+
+        return compiledPatterns;
+        }
+
+    //----------------------------------------------------------------
+    std::vector<TextClassifier::CategoryPatterns> TextClassifier::ClonePatterns(
+        const std::vector<CategoryPatterns>& categoryPatterns)
+        {
+        std::vector<CategoryPatterns> clonedPatterns{ categoryPatterns };
+        for (auto& [id, patterns] : clonedPatterns)
+            {
+            for (auto& pattern : patterns)
+                {
+                pattern.m_regex = std::make_shared<wxRegEx>(pattern.m_pattern);
+                if (pattern.m_negatingRegex != nullptr)
+                    { pattern.m_negatingRegex = std::make_shared<wxRegEx>(pattern.m_negatingPattern); }
+                }
+            }
+        return clonedPatterns;
+        }
+
+    //----------------------------------------------------------------
+    std::vector<TextClassifier::IdPair> TextClassifier::ClassifyText(const wxString& text,
+        const std::vector<CategoryPatterns>& categoryPatterns)
+        {
+        const std::wstring textBuffer{ text.ToStdWstring() };
+        // Case-insensitive literals are only used to rule out ASCII text, as lowercasing
+        // may not fold other characters the same way that the regex engine does.
+        const bool isAsciiText = std::all_of(textBuffer.cbegin(), textBuffer.cend(),
+            [](const wchar_t ch) noexcept { return ch < 128; });
+        std::optional<std::wstring> lowerTextBuffer;
+
+        const auto containsLiteral = [&](const RequiredLiteral& literal)
+            {
+            if (!literal.m_ignoreCase)
+                { return textBuffer.find(literal.m_text) != std::wstring::npos; }
+            if (!isAsciiText)
+                { return true; }
+            if (!lowerTextBuffer)
+                {
+                lowerTextBuffer = textBuffer;
+                std::transform(lowerTextBuffer->begin(), lowerTextBuffer->end(),
+                    lowerTextBuffer->begin(),
+                    [](const wchar_t ch) noexcept
+                        { return static_cast<wchar_t>(std::towlower(ch)); });
+                }
+            return lowerTextBuffer->find(literal.m_text) != std::wstring::npos;
+            };
+
+        std::vector<IdPair> categories;
+        // compare the text against each category...
+        for (const auto& [id, patterns] : categoryPatterns)
+            {
+            // ...by comparing it against each regex in the category
+            const bool categoryMatched = std::any_of(patterns.cbegin(), patterns.cend(),
+                [&text, &containsLiteral](const auto& pattern)
+                    {
+                    return (pattern.m_requiredLiterals.empty() ||
+                            std::any_of(pattern.m_requiredLiterals.cbegin(),
+                                        pattern.m_requiredLiterals.cend(), containsLiteral)) &&
+                        pattern.m_regex->Matches(text) &&
+                        // either no negating regex or it doesn't match it
+                        (pattern.m_negatingRegex == nullptr ||
+                         !pattern.m_negatingRegex->Matches(text));
+                    });
+            if (categoryMatched)
+                { categories.push_back(id); }
+            }
+        return categories;
         }
 
     //----------------------------------------------------------------
@@ -93,7 +401,7 @@ namespace Wisteria::Data
                     const wxString& contentColumnName)
         {
         // nothing patterns or categories loaded from previous call to SetClassifierData()?
-        if (m_categoryPatternsMap.get_data().size() == 0)
+        if (m_categoryPatterns.empty())
             { return std::make_pair(nullptr, nullptr); }
 
         auto contentColumn = contentData->GetCategoricalColumn(contentColumnName);
@@ -116,57 +424,89 @@ namespace Wisteria::Data
 
         auto unclassifiedData = std::make_shared<Data::Dataset>();
         unclassifiedData->AddCategoricalColumn(contentColumnName, contentColumn->GetStringTable());
-        const auto mdCode = ColumnWithStringTable::FindMissingDataCode(contentColumn->GetStringTable());
+        const auto mdCode = contentColumn->FindMissingDataCode();
+
+        // classify each distinct string from the content column (rather than every row)
+        std::vector<GroupIdType> contentIds{ contentColumn->GetValues() };
+        std::sort(contentIds.begin(), contentIds.end());
+        contentIds.erase(std::unique(contentIds.begin(), contentIds.end()), contentIds.end());
+        std::vector<wxString> contentStrings;
+        contentStrings.reserve(contentIds.size());
+        for (const auto& id : contentIds)
+            { contentStrings.push_back(contentColumn->GetCategoryLabelFromID(id)); }
 
-        for (size_t i = 0; i < contentData->GetRowCount(); ++i)
+        // the categories that each distinct string is classified into
+        std::vector<std::vector<IdPair>> classifications(contentIds.size());
+        const auto classifyStrings = [&contentStrings, &classifications]
+            (const std::vector<CategoryPatterns>& categoryPatterns,
+             const size_t first, const size_t last)
             {
-            bool matchedAnyCategory{ false };
-            // compare each comment from the data against each catetory...
-            for (const auto& [id, regexes] : m_categoryPatternsMap.get_data())
-                {
-                // ...by comparing it against each regex in every category
-                bool categoryRegexMatched{ false };
-                for (const auto& re : regexes.first)
-                    {
-                    if (re.first->IsValid() &&
-                        re.first->Matches(contentColumn->GetCategoryLabelFromID(contentColumn->GetValue(i))) &&
-                        // either no negating regex or it doesn't match it
-                        (!re.second->IsValid() ||
-                         !re.second->Matches(contentColumn->GetCategoryLabelFromID(contentColumn->GetValue(i)))))
-                        {
-                        categoryRegexMatched = true;
-                        matchedAnyCategory = true;
-                        break;
-                        }
-                    }
-                // if any regex from the category matched the comment,
-                // then add a row to the output containing the comment and the
-                // category ID next to it
-                if (categoryRegexMatched)
+            for (size_t i = first; i < last; ++i)
+                { classifications[i] = ClassifyText(contentStrings[i], categoryPatterns); }
+            };
+
+        constexpr size_t MIN_STRINGS_PER_CHUNK{ 64 };
+        const size_t chunkSize = std::max<size_t>(MIN_STRINGS_PER_CHUNK,
+            safe_divide<size_t>(contentIds.size(), std::thread::hardware_concurrency() * 4));
+        if (IsParallelClassification() && contentIds.size() > chunkSize)
+            {
+            // each chunk of strings is classified with its own copy of the regexes,
+            // with the results going into their own slots (so output order is preserved)
+            std::vector<size_t> chunkIndices((contentIds.size() + chunkSize - 1) / chunkSize);
+            std::iota(chunkIndices.begin(), chunkIndices.end(), 0);
+            std::for_each(std::execution::par, chunkIndices.cbegin(), chunkIndices.cend(),
+                [this, &classifyStrings, &contentIds, chunkSize](const size_t chunkIndex)
                     {
-                    if (m_subCategoryColumnName)
-                        {
-                        classifiedData->AddRow(Data::RowInfo().Categoricals(
-                            { contentColumn->GetValue(i), id.first, id.second }));
-                        }
-                    else
-                        {
-                        classifiedData->AddRow(Data::RowInfo().Categoricals(
-                            { contentColumn->GetValue(i), id.first }));
-                        }
-                    }
-                }
-            if (!matchedAnyCategory)
+                    classifyStrings(ClonePatterns(m_categoryPatterns), chunkIndex * chunkSize,
+                                    std::min(contentIds.size(), (chunkIndex + 1) * chunkSize));
+                    });
+            }
+        else
+            { classifyStrings(m_categoryPatterns, 0, contentIds.size()); }
+
+        // build the output columns in row order, then add them all at once
+        const auto getClassification = [&contentIds, &classifications](const GroupIdType id)
+            {
+            return classifications[std::lower_bound(contentIds.cbegin(), contentIds.cend(), id) -
+                                   contentIds.cbegin()];
+            };
+        size_t classifiedRowCount{ 0 };
+        for (const auto& id : contentColumn->GetValues())
+            { classifiedRowCount += getClassification(id).size(); }
+
+        std::vector<GroupIdType> classifiedComments, classifiedCategories,
+                                 classifiedSubCategories, unclassifiedComments;
+        classifiedComments.reserve(classifiedRowCount);
+        classifiedCategories.reserve(classifiedRowCount);
+        if (m_subCategoryColumnName)
+            { classifiedSubCategories.reserve(classifiedRowCount); }
+        for (const auto& commentId : contentColumn->GetValues())
+            {
+            const auto& classification = getClassification(commentId);
+            // if the comment matched any categories, then add a row to the output for each one,
+            // containing the comment and the category ID next to it
+            for (const auto& id : classification)
                 {
-                // don't write out empty comments
-                if (contentColumn->GetValue(i) != mdCode)
-                    {
-                    unclassifiedData->AddRow(Data::RowInfo().Categoricals(
-                        { contentColumn->GetValue(i) }));
-                    }
+                classifiedComments.push_back(commentId);
+                classifiedCategories.push_back(id.first);
+                if (m_subCategoryColumnName)
+                    { classifiedSubCategories.push_back(id.second); }
                 }
+            // don't write out empty comments
+            if (classification.empty() && commentId != mdCode)
+                { unclassifiedComments.push_back(commentId); }
             }
 
+        std::vector<std::vector<GroupIdType>> classifiedColumns;
+        classifiedColumns.push_back(std::move(classifiedComments));
+        classifiedColumns.push_back(std::move(classifiedCategories));
+        if (m_subCategoryColumnName)
+            { classifiedColumns.push_back(std::move(classifiedSubCategories)); }
+        classifiedData->AddRows(ColumnBatch().Categoricals(std::move(classifiedColumns)));
+        std::vector<std::vector<GroupIdType>> unclassifiedColumns;
+        unclassifiedColumns.push_back(std::move(unclassifiedComments));
+        unclassifiedData->AddRows(ColumnBatch().Categoricals(std::move(unclassifiedColumns)));
+
         return std::make_pair(classifiedData, unclassifiedData);
         }
     }
\ No newline at end of file
@@ -13,7 +13,6 @@
 #define __WISTERIA_TEXT_CLASSIFIER_H__
 
 #include "dataset.h"
-#include "../util/frequency_set.h"
 
 namespace Wisteria::Data
     {
@@ -141,12 +140,82 @@ namespace Wisteria::Data
                         ClassifyData(
                             std::shared_ptr<const Data::Dataset> contentData,
                             const wxString& contentColumnName);
+        /** @brief Sets whether ClassifyData() classifies the text on multiple threads.
+            @details The distinct strings from the content column are split into chunks,
+             which are classified in parallel (each with its own copy of the regexes).
+             The results are the same (and in the same order) either way.
+            @param parallel @c true to classify in parallel (the default).*/
+        void SetParallelClassification(const bool parallel) noexcept
+            { m_parallelClassification = parallel; }
+        /// @returns @c true if ClassifyData() classifies the text on multiple threads.
+        [[nodiscard]] bool IsParallelClassification() const noexcept
+            { return m_parallelClassification; }
     private:
         using IdPair = std::pair<Data::GroupIdType, Data::GroupIdType>;
-        // wxRegEx cannot be copy constructed by design, so use shared pointers instead
-        using RegExPair = std::pair<std::shared_ptr<wxRegEx>, std::shared_ptr<wxRegEx>>;
 
-        multi_value_aggregate_map<IdPair, RegExPair> m_categoryPatternsMap;
+        /// @brief Text that must appear in a string for a regex to be able to match it.
+        struct RequiredLiteral
+            {
+            std::wstring m_text;
+            /// @brief @c true if @c m_text is lowercased and should be compared
+            ///  case insensitively.
+            bool m_ignoreCase{ false };
+            };
+
+        /// @brief A (possibly combined) regex that classifies text into a category.
+        struct CategoryPattern
+            {
+            wxString m_pattern;
+            wxString m_negatingPattern;
+            // wxRegEx cannot be copy constructed by design, so use shared pointers instead
+            std::shared_ptr<wxRegEx> m_regex;
+            /// @brief Null if there is no negating regex.
+            std::shared_ptr<wxRegEx> m_negatingRegex;
+            /// @brief If not empty, then text must contain at least one of these
+            ///  for the regex to be able to match it.
+            std::vector<RequiredLiteral> m_requiredLiterals;
+            };
+
+        /// @brief A category (and sub-category) and the patterns that classify text into it.
+        using CategoryPatterns = std::pair<IdPair, std::vector<CategoryPattern>>;
+
+        /** @returns The longest run of literal text that any match of @c pattern must contain,
+             or @c std::nullopt if one can't be (safely) deduced.
+            @param pattern The regular expression to review.*/
+        [[nodiscard]] static std::optional<RequiredLiteral>
+            FindRequiredLiteral(const wxString& pattern);
+        /** @brief Removes a leading case-insensitive option (i.e., `(?i)`) from a pattern.
+            @details This is the only inline option that is read from patterns, as it is
+             the one that every wxRegEx backend supports (but only at the start of a regex).
+            @param[in,out] pattern The pattern to remove the option from.
+            @returns @c true if the pattern started with the option.*/
+        static bool RemoveIgnoreCaseOption(wxString& pattern);
+        /** @returns @c true if @c pattern can be combined with others into one alternation
+             (i.e., it doesn't use back references, named groups, or verbs).
+            @param pattern The regular expression to review.*/
+        [[nodiscard]] static bool CanCombinePattern(const wxString& pattern);
+        /** @brief Compiles a category's patterns, combining the ones without negating
+             patterns into alternations.
+            @param patterns The category's patterns and (possibly empty) negating patterns.
+            @returns The compiled patterns.*/
+        [[nodiscard]] static std::vector<CategoryPattern>
+            CompilePatterns(const std::vector<std::pair<wxString, wxString>>& patterns);
+        /** @returns A copy of @c categoryPatterns with their own (newly compiled) regexes.
+            @param categoryPatterns The patterns to copy.
+            @note wxRegEx objects store their matches, so they can't be shared between threads.
+             Use this to give each thread its own copy of the patterns.*/
+        [[nodiscard]] static std::vector<CategoryPatterns>
+            ClonePatterns(const std::vector<CategoryPatterns>& categoryPatterns);
+        /** @returns The categories (and sub-categories) that @c text is classified into,
+             in category ID order.
+            @param text The text to classify.
+            @param categoryPatterns The categories and their patterns to classify with.*/
+        [[nodiscard]] static std::vector<IdPair>
+            ClassifyText(const wxString& text,
+                         const std::vector<CategoryPatterns>& categoryPatterns);
+
+        std::vector<CategoryPatterns> m_categoryPatterns;
+        bool m_parallelClassification{ true };
         wxString m_categoryColumnName;
         std::optional<wxString> m_subCategoryColumnName;
         ColumnWithStringTable::StringTableType m_categoriesStringTable;
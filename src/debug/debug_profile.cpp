@@ -13,98 +13,343 @@
 namespace __debug
     {
     std::string __profile_reporter::m_outputPath = "profile.csv";
-    std::set<__profile_info> __profile_reporter::m_profiles;
-    std::vector<__profiler*> __profile_reporter::m_profilers;
+    std::string __profile_reporter::m_tracePath;
+    const std::chrono::steady_clock::time_point __profile_reporter::m_epoch =
+        std::chrono::steady_clock::now();
+    std::mutex __profile_reporter::m_mutex;
+    std::vector<std::string> __profile_reporter::m_callSiteNames{ "[root]" };
+    std::vector<std::shared_ptr<__thread_profile>> __profile_reporter::m_threadProfiles;
     static __profile_reporter __profile_reporter__;
 
-    void __profile_info::add_duration_time(const std::chrono::nanoseconds& duration_time, const char* extra_info)
+    namespace
+        {
+        /// @returns The key for a call site (when called from a given parent call node).
+        [[nodiscard]] inline uint64_t make_edge_key(const __call_node_id parent,
+                                                    const __call_site_id child) noexcept
+            { return (static_cast<uint64_t>(parent) << 32) | child; }
+
+        /// @brief Replaces an atomic's value (only safe when the calling thread is the only writer).
+        template<typename T, typename U>
+        inline void store_relaxed(std::atomic<T>& value, const U newValue) noexcept
+            { value.store(static_cast<T>(newValue), std::memory_order_relaxed); }
+
+        /// @returns A function name with its template information simplified.
+        [[nodiscard]] std::string simplify_name(std::string name)
+            {
+            const auto templateStart = name.find_first_of('<');
+            const auto templateEnd = name.rfind(">::");
+            if (templateStart != std::string::npos && templateEnd != std::string::npos &&
+                templateStart < templateEnd)
+                { name.replace(templateStart+1, (templateEnd+2)-templateStart, "...>::"); }
+            return name;
+            }
+        }
+
+    //-------------------------------------
+    void __profile_info::add_duration_time(const std::chrono::nanoseconds& duration_time,
+                                           const std::chrono::nanoseconds& inclusive_duration_time,
+                                           const char* extra_info)
         {
         ++m_called_count;
         m_total_duration_time += duration_time;
-        m_average_duration_time = m_total_duration_time / m_called_count;
-        m_lowest_duration_time = (duration_time < m_lowest_duration_time) ? duration_time : m_lowest_duration_time;
-        if (duration_time > m_highest_duration_time)
+        m_total_inclusive_duration_time += inclusive_duration_time;
+        m_lowest_duration_time = std::min(duration_time, m_lowest_duration_time);
+        if (m_called_count == 1 || duration_time > m_highest_duration_time)
             {
             m_highest_duration_time = duration_time;
             if (extra_info)
                 { m_extra_info.assign(extra_info); }
             }
-        m_duration_times.emplace_back(duration_time);
         }
 
-    __profiler::__profiler(const char* name) :
-                                    m_starttime(std::chrono::high_resolution_clock::now()),
-                                    m_block_name(name), m_total_pause_duration(0)
-        { push_profiler(this); }
+    //-------------------------------------
+    void __profile_info::merge(const __profile_info& that)
+        {
+        if (that.m_called_count == 0)
+            { return; }
+        if (m_called_count == 0 || that.m_highest_duration_time > m_highest_duration_time)
+            {
+            m_highest_duration_time = that.m_highest_duration_time;
+            m_extra_info = that.m_extra_info;
+            }
+        m_called_count += that.m_called_count;
+        m_total_duration_time += that.m_total_duration_time;
+        m_total_inclusive_duration_time += that.m_total_inclusive_duration_time;
+        m_lowest_duration_time = std::min(that.m_lowest_duration_time, m_lowest_duration_time);
+        }
+
+    //-------------------------------------
+    void __call_node::add_duration_time(const std::chrono::nanoseconds& duration_time,
+                                        const std::chrono::nanoseconds& inclusive_duration_time,
+                                        const char* extra_info)
+        {
+        // only the owning thread writes to these, so there is no need for read-modify-write operations
+        const auto calledCount = m_called_count.load(std::memory_order_relaxed) + 1;
+        store_relaxed(m_called_count, calledCount);
+        store_relaxed(m_total_duration_time,
+            m_total_duration_time.load(std::memory_order_relaxed) + duration_time.count());
+        store_relaxed(m_total_inclusive_duration_time,
+            m_total_inclusive_duration_time.load(std::memory_order_relaxed) + inclusive_duration_time.count());
+        if (duration_time.count() < m_lowest_duration_time.load(std::memory_order_relaxed))
+            { store_relaxed(m_lowest_duration_time, duration_time.count()); }
+        if (calledCount == 1 ||
+            duration_time.count() > m_highest_duration_time.load(std::memory_order_relaxed))
+            {
+            store_relaxed(m_highest_duration_time, duration_time.count());
+            if (extra_info)
+                {
+                m_extra_info_history.push_back(std::make_unique<const std::string>(extra_info));
+                m_extra_info.store(m_extra_info_history.back().get(), std::memory_order_release);
+                }
+            }
+        }
 
-    __profiler::__profiler(const char* name, const char* extra_info) :
-                                    m_starttime(std::chrono::high_resolution_clock::now()),
-                                    m_block_name(name), m_extra_info(extra_info), m_total_pause_duration(0)
-        { push_profiler(this); }
+    //-------------------------------------
+    __profile_info __call_node::get_profile_info() const
+        {
+        __profile_info info;
+        info.m_called_count = m_called_count.load(std::memory_order_relaxed);
+        info.m_lowest_duration_time =
+            std::chrono::nanoseconds(m_lowest_duration_time.load(std::memory_order_relaxed));
+        info.m_highest_duration_time =
+            std::chrono::nanoseconds(m_highest_duration_time.load(std::memory_order_relaxed));
+        info.m_total_duration_time =
+            std::chrono::nanoseconds(m_total_duration_time.load(std::memory_order_relaxed));
+        info.m_total_inclusive_duration_time =
+            std::chrono::nanoseconds(m_total_inclusive_duration_time.load(std::memory_order_relaxed));
+        const auto extraInfo = m_extra_info.load(std::memory_order_acquire);
+        if (extraInfo)
+            { info.m_extra_info = *extraInfo; }
+        return info;
+        }
 
-    __profiler::~__profiler()
+    //-------------------------------------
+    __call_node_id __thread_profile::get_child_node(const __call_node_id parent,
+                                                    const __call_site_id call_site)
         {
-        m_endtime = std::chrono::high_resolution_clock::now();
-        const auto totalTime = (m_endtime-m_starttime)-m_total_pause_duration;
+        if (parent == __no_call_node)
+            { return __no_call_node; }
+        const auto [foundNode, inserted] =
+            m_child_nodes.try_emplace(make_edge_key(parent, call_site), __no_call_node);
+        if (inserted)
+            {
+            const size_t nodeCount = m_call_node_count.load(std::memory_order_relaxed);
+            if (nodeCount < MAX_CALL_NODES)
+                {
+                m_call_nodes[nodeCount].m_parent = parent;
+                m_call_nodes[nodeCount].m_call_site = call_site;
+                foundNode->second = static_cast<__call_node_id>(nodeCount);
+                // publish the node to the report
+                m_call_node_count.store(nodeCount + 1, std::memory_order_release);
+                }
+            }
+        return foundNode->second;
+        }
 
-        const auto [iterator, inserted] = __profile_reporter__.m_profiles.emplace(m_block_name.c_str(), totalTime, m_extra_info.c_str() );
-        // if it was already in the table, then add the current duration time to it
-        if (!inserted)
+    //-------------------------------------
+    void __profiler::push_profiler(const __call_site_id call_site)
+        {
+        m_thread_profile = &__profile_reporter::get_thread_profile();
+        const size_t depth = ++m_thread_profile->m_depth;
+        if (depth < __thread_profile::MAX_DEPTH)
             {
-            auto node = __profile_reporter__.m_profiles.extract(iterator);
-            node.value().add_duration_time(totalTime, m_extra_info.c_str());
-            __profile_reporter__.m_profiles.insert(std::move(node));
+            m_thread_profile->m_stack[depth] =
+                { call_site,
+                  m_thread_profile->get_child_node(m_thread_profile->m_stack[depth-1].m_call_node, call_site),
+                  std::chrono::nanoseconds{ 0 } };
             }
-        pop_profiler();
         }
 
-    void __profiler::push_profiler(__profiler* profiler) const
+    //-------------------------------------
+    __profiler::~__profiler()
         {
-        if (__profile_reporter__.m_profilers.size() )
+        const auto endtime = std::chrono::steady_clock::now();
+        auto& threadProfile = *m_thread_profile;
+        const size_t depth = threadProfile.m_depth--;
+        if (depth >= __thread_profile::MAX_DEPTH)
+            { return; }
+
+        // The time spent in profiled blocks that this block called is excluded from this block,
+        // so that only the time that it took to execute the code in this block is shown.
+        const auto& frame = threadProfile.m_stack[depth];
+        auto& parentFrame = threadProfile.m_stack[depth-1];
+        const auto totalTime =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(endtime - m_starttime);
+        parentFrame.m_child_duration_time += totalTime;
+
+        if (frame.m_call_node != __no_call_node)
             {
-            (*(__profile_reporter__.m_profilers.back())).pause();
+            threadProfile.m_call_nodes[frame.m_call_node].
+                add_duration_time(totalTime - frame.m_child_duration_time, totalTime, m_extra_info);
             }
-        __profile_reporter__.m_profilers.push_back(profiler);
+
+        // record the call in the trace (overwriting the oldest call if the buffer is full)
+        const size_t traceCount = threadProfile.m_trace_count.load(std::memory_order_relaxed);
+        auto& event = threadProfile.m_trace[traceCount % __thread_profile::TRACE_CAPACITY];
+        // pairs with the report's fence, so that if it reads part of this call
+        // it will also see that the slot's previous call is being overwritten
+        std::atomic_thread_fence(std::memory_order_release);
+        store_relaxed(event.m_call_site, frame.m_call_site);
+        store_relaxed(event.m_depth, depth-1);
+        store_relaxed(event.m_start_time, __profile_reporter::get_elapsed_time(m_starttime).count());
+        store_relaxed(event.m_duration_time, totalTime.count());
+        threadProfile.m_trace_count.store(traceCount + 1, std::memory_order_release);
+        }
+
+    //-------------------------------------
+    __call_site_id __profile_reporter::intern_call_site(const char* name)
+        {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const auto foundName = std::find(m_callSiteNames.cbegin(), m_callSiteNames.cend(), name);
+        if (foundName != m_callSiteNames.cend())
+            { return static_cast<__call_site_id>(foundName - m_callSiteNames.cbegin()); }
+        m_callSiteNames.emplace_back(name);
+        return static_cast<__call_site_id>(m_callSiteNames.size() - 1);
         }
 
-    void __profiler::pop_profiler() const
+    //-------------------------------------
+    __thread_profile& __profile_reporter::get_thread_profile()
         {
-        __profile_reporter__.m_profilers.pop_back();
-        if (__profile_reporter__.m_profilers.size() )
+        // the registry shares ownership, so that the data outlives its thread
+        thread_local const std::shared_ptr<__thread_profile> threadProfile = []()
             {
-            (*(__profile_reporter__.m_profilers.back())).unpause();
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_threadProfiles.push_back(std::make_shared<__thread_profile>(m_threadProfiles.size()));
+            return m_threadProfiles.back();
+            }();
+        return *threadProfile;
+        }
+
+    //-------------------------------------
+    void __profile_reporter::write_trace()
+        {
+        std::ofstream output(m_tracePath.c_str(), std::ios::out|std::ios::trunc);
+        if (!output.is_open())
+            { return; }
+
+        const auto writeJsonString = [&output](const std::string& str)
+            {
+            output << '"';
+            for (const auto ch : str)
+                {
+                if (ch == '"' || ch == '\\')
+                    { output << '\\' << ch; }
+                else if (static_cast<unsigned char>(ch) < 0x20)
+                    { output << ' '; }
+                else
+                    { output << ch; }
+                }
+            output << '"';
+            };
+
+        // "complete" events, with times in microseconds
+        output << "{\"traceEvents\":[";
+        bool firstEvent{ true };
+        output.imbue(std::locale::classic());
+        for (const auto& threadProfile : m_threadProfiles)
+            {
+            // the thread may still be running, so read the calls that had been written before now
+            const size_t traceCount = threadProfile->m_trace_count.load(std::memory_order_acquire);
+            const size_t firstCall = (traceCount > __thread_profile::TRACE_CAPACITY) ?
+                traceCount - __thread_profile::TRACE_CAPACITY : 0;
+            for (size_t i = firstCall; i < traceCount; ++i)
+                {
+                const auto& event = threadProfile->m_trace[i % __thread_profile::TRACE_CAPACITY];
+                const auto callSite = event.m_call_site.load(std::memory_order_relaxed);
+                const auto depth = event.m_depth.load(std::memory_order_relaxed);
+                const auto startTime = event.m_start_time.load(std::memory_order_relaxed);
+                const auto durationTime = event.m_duration_time.load(std::memory_order_relaxed);
+                // skip the call if the thread has wrapped around and started overwriting it
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (threadProfile->m_trace_count.load(std::memory_order_relaxed) >=
+                    i + __thread_profile::TRACE_CAPACITY)
+                    { continue; }
+                output << (firstEvent ? "\n" : ",\n") << "{\"name\":";
+                writeJsonString(m_callSiteNames[callSite]);
+                output << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << threadProfile->m_thread_index <<
+                    ",\"ts\":" << (startTime / 1000.0) <<
+                    ",\"dur\":" << (durationTime / 1000.0) <<
+                    ",\"args\":{\"depth\":" << depth << "}}";
+                firstEvent = false;
+                }
             }
+        output << "\n],\"displayTimeUnit\":\"ms\"}\n";
         }
 
+    //-------------------------------------
     void __profile_reporter::dump_results()
         {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        // combine the threads' call trees into one (with the root as the first node),
+        // and combine their timings per call site
+        struct __merged_node
+            {
+            __call_site_id m_call_site{ __root_call_site };
+            __profile_info m_info;
+            std::vector<size_t> m_children;
+            };
+        std::vector<__merged_node> callTree(1);
+        std::unordered_map<uint64_t, size_t> mergedChildren;
+        std::vector<__profile_info> profiles(m_callSiteNames.size());
+        for (const auto& threadProfile : m_threadProfiles)
+            {
+            // the thread may still be running, so only read the nodes that it had published before now
+            const size_t nodeCount = threadProfile->m_call_node_count.load(std::memory_order_acquire);
+            // a parent always comes before its children, so its merged node is already known
+            std::vector<size_t> mergedNodes(nodeCount, 0);
+            for (size_t i = 1; i < nodeCount; ++i)
+                {
+                const auto& node = threadProfile->m_call_nodes[i];
+                const size_t mergedParent = mergedNodes[node.m_parent];
+                const auto [foundChild, inserted] = mergedChildren.try_emplace(
+                    make_edge_key(static_cast<__call_node_id>(mergedParent), node.m_call_site),
+                    callTree.size());
+                if (inserted)
+                    {
+                    callTree.push_back({ node.m_call_site, __profile_info{}, {} });
+                    callTree[mergedParent].m_children.push_back(foundChild->second);
+                    }
+                mergedNodes[i] = foundChild->second;
+                const auto info = node.get_profile_info();
+                callTree[foundChild->second].m_info.merge(info);
+                profiles[node.m_call_site].merge(info);
+                }
+            }
+
         std::fstream output;
         if (m_outputPath.length())
             { output.open(m_outputPath.c_str(), std::ios::out|std::ios::trunc); }
 
-        if (m_profiles.size())
+        std::chrono::nanoseconds totalTime{0};
+        for (const auto& pos : profiles)
+            { totalTime += pos.m_total_duration_time; }
+
+        if (totalTime.count() > 0)
             {
-            std::chrono::nanoseconds totalTime{0};
-            for (const auto& pos : m_profiles)
-                { totalTime += pos.m_total_duration_time; }
             // write a header
             std::string header = "Name\tTimes calls\tTotal time (in milliseconds)\tTotal time (%)\tLowest call time\tHighest call time\tAverage call time\tExtra Info (from highest call time)\n";
             if (output.is_open())
                 { output << header.c_str(); }
-            std::wcout << header.c_str();
-            // write out the profiled blocked
+            std::cout << header;
+            // write out the profiled blocked, sorted by name
+            std::vector<__call_site_id> callSites;
+            for (__call_site_id i = 0; i < profiles.size(); ++i)
+                {
+                if (profiles[i].m_called_count > 0)
+                    { callSites.push_back(i); }
+                }
+            std::sort(callSites.begin(), callSites.end(),
+                [](const auto left, const auto right)
+                    { return m_callSiteNames[left] < m_callSiteNames[right]; });
             std::stringstream stream;
             stream.imbue(std::locale{""}); // show thousands separator for milliseconds
-            for (auto pos : m_profiles)
+            for (const auto callSite : callSites)
                 {
+                const auto& pos = profiles[callSite];
                 stream.clear();
                 stream.str(std::string());
-                // simplify template info in function names
-                const auto templateStart = pos.m_name.find_first_of('<');
-                const auto templateEnd = pos.m_name.rfind(">::");
-                if (templateStart != std::string::npos && templateEnd != std::string::npos)
-                    { pos.m_name.replace(templateStart+1, (templateEnd+2)-templateStart, "...>::"); }
-                stream << pos.m_name << "\t" <<
+                stream << simplify_name(m_callSiteNames[callSite]) << "\t" <<
                         pos.m_called_count << "\t" <<
                         std::chrono::duration_cast<std::chrono::milliseconds>(pos.m_total_duration_time).count() << "\t" <<
                         std::floor(
@@ -113,13 +358,48 @@ namespace __debug
                             *100) << "%\t" <<
                         std::chrono::duration_cast<std::chrono::milliseconds>(pos.m_lowest_duration_time).count() << "\t" <<
                         std::chrono::duration_cast<std::chrono::milliseconds>(pos.m_highest_duration_time).count() << "\t" <<
-                        std::chrono::duration_cast<std::chrono::milliseconds>(pos.m_average_duration_time).count() << "\t" <<
+                        std::chrono::duration_cast<std::chrono::milliseconds>(pos.m_total_duration_time / pos.m_called_count).count() << "\t" <<
                         pos.m_extra_info << "\n";
                 if (output.is_open())
                     { output << stream.str(); }
                 // dump it to standard output too
                 std::cout << stream.str();
                 }
+
+            // write the call tree, with the blocks that each block called indented beneath it
+            if (m_outputPath.length())
+                {
+                std::ofstream treeOutput((m_outputPath + ".tree").c_str(), std::ios::out|std::ios::trunc);
+                treeOutput.imbue(std::locale{""});
+                treeOutput << "Name\tTimes calls\tTotal time (in milliseconds)\tSelf time (in milliseconds)\n";
+                // each node is a distinct call path, so a block is shown beneath each path that called it
+                const auto writeChildren = [&](const auto& self, const size_t parent,
+                                               const size_t depth) -> void
+                    {
+                    auto children = callTree[parent].m_children;
+                    std::sort(children.begin(), children.end(),
+                        [&callTree](const auto left, const auto right)
+                            {
+                            return m_callSiteNames[callTree[left].m_call_site] <
+                                   m_callSiteNames[callTree[right].m_call_site];
+                            });
+                    for (const auto child : children)
+                        {
+                        const auto& node = callTree[child];
+                        if (node.m_info.m_called_count == 0)
+                            { continue; }
+                        treeOutput << std::string(depth * 4, ' ') <<
+                            simplify_name(m_callSiteNames[node.m_call_site]) << "\t" <<
+                            node.m_info.m_called_count << "\t" <<
+                            std::chrono::duration_cast<std::chrono::milliseconds>(
+                                node.m_info.m_total_inclusive_duration_time).count() << "\t" <<
+                            std::chrono::duration_cast<std::chrono::milliseconds>(
+                                node.m_info.m_total_duration_time).count() << "\n";
+                        self(self, child, depth + 1);
+                        }
+                    };
+                writeChildren(writeChildren, 0, 0);
+                }
             }
         else
             {
@@ -128,6 +408,9 @@ namespace __debug
             if (output.is_open())
                 { output.clear(); }
             }
+
+        if (m_tracePath.length())
+            { write_trace(); }
         }
     }
 
@@ -13,6 +13,13 @@
       thus only show the time it took to execute the code in the initial block, excluding the time it took to call any subsequent blocks
       that are also being tracked. This is an important distinction from other profiling systems.
 
+    - Each thread records its timings into its own buffers without taking any locks (the report reads and merges
+      them when it is written), so profiled code can run on multiple threads at once. Call sites are interned the first
+      time that they are reached, so recording a call is just two reads of the steady clock and a few counter updates.
+    - Along with the flat report, a hierarchical report (showing the timings for each distinct call path) is also written,
+      and the most recent calls from each thread can be exported as a Chrome trace (SET_PROFILER_TRACE_PATH())
+      to be viewed in `chrome://tracing` or Perfetto.
+
     Profiling information will be written to standard output and a specified file (SET_PROFILER_REPORT_PATH()).
 
     This program is free software; you can redistribute it and/or modify
@@ -58,15 +65,20 @@
 #ifndef __DEBUG_PROFILE_H__
 #define __DEBUG_PROFILE_H__
 
-#include <set>
 #include <algorithm>
 #include <string>
-#include <ctime>
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <vector>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <unordered_map>
 #include <chrono>
+#include <cstdint>
+#include <cmath>
 #include <locale>
 #include <cassert>
 
@@ -85,6 +97,8 @@
 
 @def PROFILE_SECTION_START(section_name)
     @brief Profiles a section of code. A unique label describing the code section should be passed here.
+    @note The label is interned the first time that the section is reached,
+     so it should be a string literal (or otherwise not change between calls).
     @details The profiling will stop when the code section goes out of scope. @sa PROFILE_SECTION_END
     @param section_name The user-defined name to associate with the code block.
 
@@ -104,7 +118,8 @@
 
 @def SET_PROFILER_REPORT_PATH(path)
     @brief Sets the path to where the profile report will be written.
-    @details This is a tab-delimited report containing the following columns:
+    @details This is a tab-delimited report (with the calls from all threads combined)
+     containing the following columns:
      - Function name
      - Times calls
      - Total time (in milliseconds)
@@ -113,17 +128,28 @@
      - Highest call time
      - Average call time
      - Extra Info (connected to the call with the highest call time)
-    @note Times are in milliseconds.
+    @note Times are in milliseconds.\n
+     A hierarchical report (with each block's calls indented beneath it) is written next to it,
+     with `.tree` appended to the path. A block that is reached through different call paths
+     is shown (with its own timings) beneath each of them.
+
+@def SET_PROFILER_TRACE_PATH(path)
+    @brief Sets the path to where a Chrome trace (JSON) of the most recent calls from each thread will be written.
+    @details This can be loaded into `chrome://tracing` or https://ui.perfetto.dev.
+     No trace is written unless this is set.
 
 @def DUMP_PROFILER_REPORT()
     @brief Outputs all of the current profile information.
     @details This will automatically happen at the exit of the program, but can be explicitly called via this macro at any time.
+    @note This can be called while other threads are running profiled code; calls that are still in progress
+     are not included.
 */
 /** @} */
 
 /* The standard __func__ macro doesn't include the name of the class for member functions,
    so it isn't as useful as it could be. Try to use more descriptive macros (if available) first.*/
-#ifdef __PRETTY_FUNCTION__
+#if defined(__GNUC__) || defined(__clang__)
+    // __PRETTY_FUNCTION__ is an identifier (not a macro), so check for the compiler instead
     #define __DEBUG_FUNCTION_NAME__ __PRETTY_FUNCTION__
 #elif defined(__FUNCTION__)
     #define __DEBUG_FUNCTION_NAME__ __FUNCTION__
@@ -133,20 +159,32 @@
     #define __DEBUG_FUNCTION_NAME__ __FUNCSIG__
 #elif defined(__FUNCDNAME__)
     #define __DEBUG_FUNCTION_NAME__ __FUNCDNAME__
+#else
+    #define __DEBUG_FUNCTION_NAME__ __func__
 #endif
 
 #ifdef ENABLE_PROFILING
     #define PROFILE() \
-        __debug::__profiler __debug__profiled__function__(__DEBUG_FUNCTION_NAME__)
+        static const auto __debug__call_site__ = \
+            __debug::__profile_reporter::intern_call_site(__DEBUG_FUNCTION_NAME__); \
+        __debug::__profiler __debug__profiled__function__(__debug__call_site__)
     #define PROFILE_WITH_INFO(info) \
-        __debug::__profiler __debug__profiled__function__(__DEBUG_FUNCTION_NAME__, (info))
+        static const auto __debug__call_site__ = \
+            __debug::__profile_reporter::intern_call_site(__DEBUG_FUNCTION_NAME__); \
+        __debug::__profiler __debug__profiled__function__(__debug__call_site__, (info))
     #define PROFILE_SECTION_START(section_name) \
-        { __debug::__profiler __debug__profiled__function__(section_name)
+        { static const auto __debug__call_site__ = \
+            __debug::__profile_reporter::intern_call_site(section_name); \
+        __debug::__profiler __debug__profiled__function__(__debug__call_site__)
     #define PROFILE_SECTION_WITH_INFO_START(section_name, info) \
-        { __debug::__profiler __debug__profiled__function__(section_name, (info))
+        { static const auto __debug__call_site__ = \
+            __debug::__profile_reporter::intern_call_site(section_name); \
+        __debug::__profiler __debug__profiled__function__(__debug__call_site__, (info))
     #define PROFILE_SECTION_END() }
     #define SET_PROFILER_REPORT_PATH(path) \
                     __debug::__profile_reporter::set_output_path((path))
+    #define SET_PROFILER_TRACE_PATH(path) \
+                    __debug::__profile_reporter::set_trace_path((path))
     #define DUMP_PROFILER_REPORT() \
                     __debug::__profile_reporter::dump_results()
 #else
@@ -156,6 +194,7 @@
     #define PROFILE_SECTION_WITH_INFO_START(section_name, info) ((void)0)
     #define PROFILE_SECTION_END() ((void)0)
     #define SET_PROFILER_REPORT_PATH(path) ((void)0)
+    #define SET_PROFILER_TRACE_PATH(path) ((void)0)
     #define DUMP_PROFILER_REPORT() ((void)0)
 #endif
 
@@ -164,65 +203,148 @@
 // profiler definition
 namespace __debug
     {
+    /// @brief The interned ID of a profiled function or section.
+    using __call_site_id = uint32_t;
+    /// @brief The ID used for the (implicit) root of every thread's call stack.
+    constexpr __call_site_id __root_call_site{ 0 };
+    /// @brief The index of a call path in a thread's call tree.
+    using __call_node_id = uint32_t;
+    /// @brief The index of the (implicit) root of every thread's call tree.
+    constexpr __call_node_id __root_call_node{ 0 };
+    /// @brief The index used for a call that could not be added to the call tree.
+    constexpr __call_node_id __no_call_node{ UINT32_MAX };
+
     //-------------------------------------
+    /// @brief Timings for a call site (or a call path), as combined when the report is written.
     class __profile_info
         {
     public:
-        __profile_info(const char* name, const std::chrono::nanoseconds& duration_time) : m_name(name),
-                       m_called_count(1), m_lowest_duration_time(duration_time), m_highest_duration_time(duration_time),
-                       m_total_duration_time(duration_time), m_average_duration_time(duration_time)
-            {}
-        __profile_info(const char* name, const std::chrono::nanoseconds& duration_time, const char* extra_info) :
-                       m_name(name), m_extra_info(extra_info),
-                       m_called_count(1), m_lowest_duration_time(duration_time), m_highest_duration_time(duration_time),
-                       m_total_duration_time(duration_time), m_average_duration_time(duration_time)
-            {}
-        [[nodiscard]] inline bool operator<(const __profile_info& that) const noexcept
-            { return m_name < that.m_name; }
-        [[nodiscard]] inline bool operator==(const __profile_info& that) const noexcept
-            { return m_name == that.m_name; }
-        void add_duration_time(const std::chrono::nanoseconds& duration_time, const char* extra_info);
+        void add_duration_time(const std::chrono::nanoseconds& duration_time,
+                               const std::chrono::nanoseconds& inclusive_duration_time,
+                               const char* extra_info);
+        void merge(const __profile_info& that);
 
-        std::string m_name;
         std::string m_extra_info;
         size_t m_called_count{ 0 };
-        std::chrono::nanoseconds m_lowest_duration_time;
-        std::chrono::nanoseconds m_highest_duration_time;
-        std::chrono::nanoseconds m_total_duration_time;
-        std::chrono::nanoseconds m_average_duration_time;
-        std::vector<std::chrono::nanoseconds> m_duration_times;
+        std::chrono::nanoseconds m_lowest_duration_time{ std::chrono::nanoseconds::max() };
+        std::chrono::nanoseconds m_highest_duration_time{ 0 };
+        /// @brief The time spent in the block itself (excluding profiled blocks that it called).
+        std::chrono::nanoseconds m_total_duration_time{ 0 };
+        /// @brief The time spent in the block, including profiled blocks that it called.
+        std::chrono::nanoseconds m_total_inclusive_duration_time{ 0 };
+        };
+
+    //-------------------------------------
+    /// @brief A call path in a thread's call tree (i.e., a call site, when called through
+    ///  a specific chain of parent call sites) and its timings.
+    /// @details Only the owning thread writes the timings, but the report reads them from
+    ///  another thread, so they are atomics (which are only ever stored to by the owner).
+    ///  The parent and call site are set before the node is published and never change.
+    class __call_node
+        {
+    public:
+        void add_duration_time(const std::chrono::nanoseconds& duration_time,
+                               const std::chrono::nanoseconds& inclusive_duration_time,
+                               const char* extra_info);
+        /// @returns A copy of the timings, which can be read from any thread.
+        [[nodiscard]] __profile_info get_profile_info() const;
+
+        __call_node_id m_parent{ __root_call_node };
+        __call_site_id m_call_site{ __root_call_site };
+    private:
+        using __duration_rep = std::chrono::nanoseconds::rep;
+        std::atomic<size_t> m_called_count{ 0 };
+        std::atomic<__duration_rep> m_lowest_duration_time{ std::chrono::nanoseconds::max().count() };
+        std::atomic<__duration_rep> m_highest_duration_time{ 0 };
+        std::atomic<__duration_rep> m_total_duration_time{ 0 };
+        std::atomic<__duration_rep> m_total_inclusive_duration_time{ 0 };
+        /// @brief The extra info from the highest call time.
+        /// @details Each new string is published (and never changed) so that it can be copied
+        ///  by the report; the previous ones are kept in @c m_extra_info_history until the node is destroyed.
+        std::atomic<const std::string*> m_extra_info{ nullptr };
+        std::vector<std::unique_ptr<const std::string>> m_extra_info_history;
+        };
+
+    //-------------------------------------
+    /// @brief A completed call, as stored in a thread's trace buffer.
+    /// @details The fields are atomics so that the report can read the buffer while
+    ///  the owning thread is writing to it.
+    struct __trace_event
+        {
+        std::atomic<__call_site_id> m_call_site{ __root_call_site };
+        std::atomic<uint32_t> m_depth{ 0 };
+        std::atomic<std::chrono::nanoseconds::rep> m_start_time{ 0 };
+        std::atomic<std::chrono::nanoseconds::rep> m_duration_time{ 0 };
+        };
+
+    //-------------------------------------
+    /// @brief A thread's profiling data.
+    /// @details Only the owning thread writes to this and no locks are taken while recording a call.
+    ///  The report reads the published call nodes and the trace from another thread and merges them
+    ///  with the other threads' data. (The stack and the child lookup are only used by the owning thread.)
+    class __thread_profile
+        {
+    public:
+        /// @brief The number of calls that can be profiled inside of each other.
+        ///  Calls deeper than this are not recorded.
+        static constexpr size_t MAX_DEPTH{ 256 };
+        /// @brief The number of distinct call paths that are recorded for each thread.
+        ///  Calls through new paths after this are not recorded (other than in the trace).
+        static constexpr size_t MAX_CALL_NODES{ 4 * 1024 };
+        /// @brief The number of most recent calls kept for the trace.
+        static constexpr size_t TRACE_CAPACITY{ 16 * 1024 };
+
+        struct __frame
+            {
+            __call_site_id m_call_site{ __root_call_site };
+            __call_node_id m_call_node{ __root_call_node };
+            std::chrono::nanoseconds m_child_duration_time{ 0 };
+            };
+
+        explicit __thread_profile(const size_t thread_index) : m_thread_index(thread_index)
+            {}
+
+        /// @returns The node for a call site called from @c parent, adding it if necessary.
+        ///  Returns @c __no_call_node if the parent was not recorded or the call tree is full.
+        [[nodiscard]] __call_node_id get_child_node(const __call_node_id parent,
+                                                    const __call_site_id call_site);
+
+        size_t m_thread_index{ 0 };
+        std::array<__frame, MAX_DEPTH> m_stack;
+        size_t m_depth{ 0 };
+        /// @brief The call tree. The first node is the root and a node's parent always comes before it.
+        std::vector<__call_node> m_call_nodes{ std::vector<__call_node>(MAX_CALL_NODES) };
+        /// @brief The number of nodes that have been published to the report.
+        std::atomic<size_t> m_call_node_count{ 1 };
+        /// @brief The nodes' children, keyed by the parent node and child call site IDs (only used by the owning thread).
+        std::unordered_map<uint64_t, __call_node_id> m_child_nodes;
+        /// @brief Ring buffer of the most recent calls.
+        std::vector<__trace_event> m_trace{ std::vector<__trace_event>(TRACE_CAPACITY) };
+        /// @brief The number of calls written to the trace (the next slot is this modulo the capacity).
+        std::atomic<size_t> m_trace_count{ 0 };
         };
 
     //-------------------------------------
     class __profiler
         {
     public:
-        explicit __profiler(const char* name);
-        __profiler(const char* name, const char* extra_info);
+        explicit __profiler(const __call_site_id call_site) :
+            m_starttime(std::chrono::steady_clock::now())
+            { push_profiler(call_site); }
+        __profiler(const __call_site_id call_site, const char* extra_info) :
+            m_starttime(std::chrono::steady_clock::now()), m_extra_info(extra_info)
+            { push_profiler(call_site); }
         __profiler(const __profiler& that) = delete;
         __profiler(__profiler&& that) = delete;
         __profiler& operator=(const __profiler&) = delete;
         __profiler& operator=(__profiler&&) = delete;
         ~__profiler();
+    private:
+        void push_profiler(const __call_site_id call_site);
 
-        inline void push_profiler(__profiler* profiler) const;
-        inline void pop_profiler() const;
-
-        inline void pause() noexcept
-            { m_pause_starttime = std::chrono::high_resolution_clock::now(); }
-        inline void unpause() noexcept
-            {
-            m_pause_endtime = std::chrono::high_resolution_clock::now();
-            m_total_pause_duration += (m_pause_endtime - m_pause_starttime);
-            }
-    protected:
-        std::chrono::time_point<std::chrono::high_resolution_clock> m_starttime;
-        std::chrono::time_point<std::chrono::high_resolution_clock> m_endtime;
-        std::chrono::time_point<std::chrono::high_resolution_clock> m_pause_starttime;
-        std::chrono::time_point<std::chrono::high_resolution_clock> m_pause_endtime;
-        std::chrono::nanoseconds m_total_pause_duration;
-        std::string m_block_name;
-        std::string m_extra_info;
+        std::chrono::steady_clock::time_point m_starttime;
+        const char* m_extra_info{ nullptr };
+        __thread_profile* m_thread_profile{ nullptr };
         };
 
     //-------------------------------------
@@ -238,10 +360,27 @@ namespace __debug
             { dump_results(); }
         static void set_output_path(const char* path)
             { m_outputPath = path; }
+        static void set_trace_path(const char* path)
+            { m_tracePath = path; }
         static void dump_results();
+        /// @returns The ID for a function or section name, adding it if necessary.
+        static __call_site_id intern_call_site(const char* name);
+        /// @returns The calling thread's profile data, creating it on first use.
+        static __thread_profile& get_thread_profile();
+        /// @returns The time since the profiler started.
+        static std::chrono::nanoseconds get_elapsed_time(
+            const std::chrono::steady_clock::time_point& time_point) noexcept
+            { return time_point - m_epoch; }
+
         static std::string m_outputPath;
-        static std::set<__profile_info> m_profiles;
-        static std::vector<__profiler*> m_profilers;
+        static std::string m_tracePath;
+    private:
+        static void write_trace();
+
+        static const std::chrono::steady_clock::time_point m_epoch;
+        static std::mutex m_mutex;
+        static std::vector<std::string> m_callSiteNames;
+        static std::vector<std::shared_ptr<__thread_profile>> m_threadProfiles;
         };
     }
 #endif
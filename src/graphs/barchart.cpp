@@ -77,14 +77,55 @@ namespace Wisteria::Graphs
             { UpdateScalingAxisFromBar(bar); }
         }
 
+    //-----------------------------------
+    void BarChart::AddBars(std::vector<Bar> bars, const bool adjustScalingAxis /*= true*/)
+        {
+        if (bars.empty())
+            { return; }
+
+        m_bars.reserve(m_bars.size() + bars.size());
+        double longestBarEnd{ 0 };
+        for (auto& bar : bars)
+            {
+            const auto customWidth = bar.GetCustomWidth().has_value() ?
+                                     safe_divide<double>(bar.GetCustomWidth().value(), 2) :
+                                     0;
+
+            if (m_highestBarAxisPosition < bar.GetAxisPosition() + customWidth)
+                { m_highestBarAxisPosition = bar.GetAxisPosition() + customWidth; }
+
+            if (m_lowestBarAxisPosition > bar.GetAxisPosition() - customWidth)
+                { m_lowestBarAxisPosition = bar.GetAxisPosition() - customWidth; }
+
+            longestBarEnd = std::max(longestBarEnd, GetBarEnd(bar));
+            m_bars.push_back(std::move(bar));
+            }
+
+        // adjust the bar axis to hold the bars
+        GetBarAxis().SetRange((m_lowestBarAxisPosition-GetBarAxis().GetInterval()),
+                m_highestBarAxisPosition + GetBarAxis().GetInterval(),
+                GetBarAxis().GetPrecision(), GetBarAxis().GetInterval(),
+                GetBarAxis().GetDisplayInterval());
+        for (auto bar = m_bars.cend() - bars.size(); bar != m_bars.cend(); ++bar)
+            {
+            if (!bar->GetAxisLabel().GetText().empty())
+                { GetBarAxis().SetCustomLabel(bar->GetAxisPosition(), bar->GetAxisLabel()); }
+            }
+
+        if (adjustScalingAxis)
+            { UpdateScalingAxisFromBarEnd(longestBarEnd); }
+        }
+
     //-----------------------------------
     void BarChart::UpdateScalingAxisFromBar(const Bar& bar)
         {
         // where the bar actually ends on the scaling axis
-        const auto barEnd = bar.GetLength() +
-            (bar.GetCustomScalingAxisStartPosition().has_value() ?
-                bar.GetCustomScalingAxisStartPosition().value() : 0);
+        UpdateScalingAxisFromBarEnd(GetBarEnd(bar));
+        }
 
+    //-----------------------------------
+    void BarChart::UpdateScalingAxisFromBarEnd(const double barEnd)
+        {
         // if this bar is longer than previous ones, then update the scaling
         if (m_longestBarLength < barEnd)
             {
@@ -288,7 +329,7 @@ namespace Wisteria::Graphs
                             auto barRectAdjustedToPlotArea = barRect;
                             barRectAdjustedToPlotArea.SetLeft(barRect.GetLeft() - GetPlotAreaBoundingBox().GetLeft());
                             barRectAdjustedToPlotArea.SetTop(barRect.GetTop() - GetPlotAreaBoundingBox().GetTop());
-                            auto barImage = std::make_shared<Image>(
+                            auto barImage = MakePlotObject<Image>(
                                 GraphItemInfo(barBlock.GetSelectionLabel().GetText()).
                                 Pen(GetImageOulineColor()).
                                 AnchorPoint(wxPoint(lineXStart, lineYStart)),
@@ -305,7 +346,7 @@ namespace Wisteria::Graphs
                             wxASSERT_LEVEL_2_MSG((bar.GetShape() == BarShape::Rectangle),
                                                  L"Non-rectangular shapes not currently "
                                                   "supported with stipple bar effect.");
-                            auto barImage = std::make_shared<Image>(
+                            auto barImage = MakePlotObject<Image>(
                                 GraphItemInfo(barBlock.GetSelectionLabel().GetText()).
                                 Pen(wxNullPen).
                                 AnchorPoint(wxPoint(lineXStart, lineYStart)),
@@ -327,7 +368,7 @@ namespace Wisteria::Graphs
                             wxASSERT_LEVEL_2_MSG((bar.GetShape() == BarShape::Rectangle),
                                                  L"Non-rectangular shapes not currently "
                                                   "supported with glassy bar effect.");
-                            auto barImage = std::make_shared<Image>(
+                            auto barImage = MakePlotObject<Image>(
                                 GraphItemInfo(barBlock.GetSelectionLabel().GetText()).
                                 Pen(wxNullPen).
                                 AnchorPoint(wxPoint(lineXStart, lineYStart)),
@@ -360,12 +401,12 @@ namespace Wisteria::Graphs
                                         shadowPts[4] = barRect.GetRightTop()+wxPoint(0, scaledShadowOffset);
                                         shadowPts[5] = barRect.GetRightBottom();
                                         shadowPts[6] = shadowPts[0]; // close polygon
-                                        AddObject(std::make_shared<GraphItems::Polygon>(
+                                        AddObject(MakePlotObject<GraphItems::Polygon>(
                                             GraphItemInfo().Pen(wxNullPen).Brush(GraphItemBase::GetShadowColour()),
                                             shadowPts, std::size(shadowPts)));
                                         }
                                     }
-                                box = std::make_shared<GraphItems::Polygon>(
+                                box = MakePlotObject<GraphItems::Polygon>(
                                     GraphItemInfo(barBlock.GetSelectionLabel().GetText()).
                                     Pen(wxPen(*wxBLACK)).Brush(blockBrush).Scaling(GetScaling()).ShowLabelWhenSelected(true),
                                     boxPoints, std::size(boxPoints));
@@ -383,7 +424,7 @@ namespace Wisteria::Graphs
                                 arrowPoints[4] = wxPoint(barNeckRect.GetRight(), barRect.GetBottom());
                                 arrowPoints[5] = barNeckRect.GetBottomRight();
                                 arrowPoints[6] = barNeckRect.GetBottomLeft();
-                                box = std::make_shared<GraphItems::Polygon>(
+                                box = MakePlotObject<GraphItems::Polygon>(
                                     GraphItemInfo(barBlock.GetSelectionLabel().GetText()).
                                     Pen(wxPen(*wxBLACK)).Brush(blockBrush).Scaling(GetScaling()).ShowLabelWhenSelected(true),
                                     arrowPoints, std::size(arrowPoints));
@@ -441,7 +482,7 @@ namespace Wisteria::Graphs
                         const wxCoord leftPadding = ScaleToScreenAndCanvas(2);
                         wxRect decalRect(barNeckRect); decalRect.Deflate(leftPadding, 0);
 
-                        auto decalLabel = std::make_shared<GraphItems::Label>(barBlock.GetDecal());
+                        auto decalLabel = MakePlotObject<GraphItems::Label>(barBlock.GetDecal());
                         decalLabel->GetGraphItemInfo().Scaling(GetScaling()).
                             Pen(wxNullPen).DPIScaling(GetDPIScaleFactor());
                         decalLabel->GetFont().MakeSmaller().MakeSmaller();
@@ -614,7 +655,7 @@ namespace Wisteria::Graphs
                             auto barRectAdjustedToPlotArea = barRect;
                             barRectAdjustedToPlotArea.SetLeft(barRect.GetLeft() - GetPlotAreaBoundingBox().GetLeft());
                             barRectAdjustedToPlotArea.SetTop(barRect.GetTop() - GetPlotAreaBoundingBox().GetTop());
-                            auto barImage = std::make_shared<Image>(
+                            auto barImage = MakePlotObject<Image>(
                                 GraphItemInfo(barBlock.GetSelectionLabel().GetText()).
                                 Pen(GetImageOulineColor()).
                                 AnchorPoint(wxPoint(lineXStart, lineYEnd)),
@@ -631,7 +672,7 @@ namespace Wisteria::Graphs
                             wxASSERT_LEVEL_2_MSG((bar.GetShape() == BarShape::Rectangle),
                                                  L"Non-rectangular shapes not currently "
                                                   "supported with stipple bar effect.");
-                            auto barImage = std::make_shared<Image>(
+                            auto barImage = MakePlotObject<Image>(
                                 GraphItemInfo(barBlock.GetSelectionLabel().GetText()).
                                 Pen(wxNullPen).
                                 AnchorPoint(wxPoint(lineXStart, lineYEnd)),
@@ -653,7 +694,7 @@ namespace Wisteria::Graphs
                             wxASSERT_LEVEL_2_MSG((bar.GetShape() == BarShape::Rectangle),
                                                  L"Non-rectangular shapes not currently "
                                                   "supported with glassy bar effect.");
-                            auto barImage = std::make_shared<Image>(
+                            auto barImage = MakePlotObject<Image>(
                                 GraphItemInfo(barBlock.GetSelectionLabel().GetText()).
                                 Pen(wxNullPen).
                                 AnchorPoint(wxPoint(lineXStart, lineYEnd)),
@@ -683,13 +724,13 @@ namespace Wisteria::Graphs
                                         shadowPts[1] = barRect.GetRightTop() + wxPoint(scaledShadowOffset, scaledShadowOffset);
                                         shadowPts[2] = barRect.GetRightTop() + wxPoint(0, scaledShadowOffset);
                                         shadowPts[3] = barRect.GetRightBottom();
-                                        AddObject(std::make_shared<GraphItems::Polygon>(
+                                        AddObject(MakePlotObject<GraphItems::Polygon>(
                                             GraphItemInfo().Pen(wxNullPen).Brush(GraphItemBase::GetShadowColour()),
                                             shadowPts, std::size(shadowPts)));
                                         }
                                     }
 
-                                box = std::make_shared<GraphItems::Polygon>(
+                                box = MakePlotObject<GraphItems::Polygon>(
                                     GraphItemInfo(barBlock.GetSelectionLabel().GetText()).
                                     Pen(wxPen(*wxBLACK)).Brush(blockBrush).Scaling(GetScaling()).ShowLabelWhenSelected(true),
                                     boxPoints, std::size(boxPoints));
@@ -710,7 +751,7 @@ namespace Wisteria::Graphs
                                 arrowPoints[4] = wxPoint(barRect.GetRight(), barNeckRect.GetTop());
                                 arrowPoints[5] = barNeckRect.GetTopRight();
                                 arrowPoints[6] = barNeckRect.GetBottomRight();
-                                box = std::make_shared<GraphItems::Polygon>(
+                                box = MakePlotObject<GraphItems::Polygon>(
                                     GraphItemInfo(barBlock.GetSelectionLabel().GetText()).
                                     Pen(wxPen(*wxBLACK)).Brush(blockBrush).
                                     Scaling(GetScaling()).ShowLabelWhenSelected(true),
@@ -773,7 +814,7 @@ namespace Wisteria::Graphs
                         wxRect decalRect(wxPoint(0,0), wxSize(barNeckRect.GetHeight(), barNeckRect.GetWidth()));
                         decalRect.SetHeight(decalRect.GetHeight()-leftPadding);
 
-                        auto decalLabel = std::make_shared<GraphItems::Label>(barBlock.GetDecal());
+                        auto decalLabel = MakePlotObject<GraphItems::Label>(barBlock.GetDecal());
                         decalLabel->GetGraphItemInfo().
                             Scaling(GetScaling()).Pen(wxNullPen).
                             DPIScaling(GetDPIScaleFactor());
@@ -880,7 +921,7 @@ namespace Wisteria::Graphs
             {
             for (const auto& bar : GetBars())
                 {
-                auto label = std::make_shared<GraphItems::Label>(bar.GetLabel());
+                auto label = MakePlotObject<GraphItems::Label>(bar.GetLabel());
                 label->SetScaling(GetScaling());
                 label->SetShadowType(GetShadowType());
                 AddObject(label);
@@ -633,6 +633,15 @@ namespace Wisteria::Graphs
              `false` is only recommended if you will be setting the scaling axis manually
              and don't want the chart adjusting it for you.*/
         void AddBar(Bar bar, const bool adjustScalingAxis = true);
+        /** @brief Adds a series of bars to the chart.
+            @details This is the same as calling AddBar() for each bar, except that
+             the bar and scaling axes are only adjusted once (after all the bars are added).
+             This is recommended when adding a large number of bars.
+            @param bars The bars to add.
+            @param adjustScalingAxis `true` to adjust the scaling axis to fit the bars.
+             `false` is only recommended if you will be setting the scaling axis manually
+             and don't want the chart adjusting it for you.*/
+        void AddBars(std::vector<Bar> bars, const bool adjustScalingAxis = true);
         /// @brief Removes all bars from the chart.
         /// @param resetAxes `true` to reset axes. `true` is recommended if you will be adding
         ///    new bars and want the chart to adjust the axes as you add them. `false` is
@@ -836,6 +845,17 @@ namespace Wisteria::Graphs
         /** @brief Recalculates the scaling axis based on the size and positioning on a given bar.
             @param bar The bar to review.*/
         void UpdateScalingAxisFromBar(const Bar& bar);
+        /** @brief Recalculates the scaling axis to fit a bar ending at the given point.
+            @param barEnd Where the bar ends on the scaling axis.*/
+        void UpdateScalingAxisFromBarEnd(const double barEnd);
+        /// @returns Where a bar ends on the scaling axis.
+        /// @param bar The bar to review.
+        [[nodiscard]] static double GetBarEnd(const Bar& bar)
+            {
+            return bar.GetLength() +
+                (bar.GetCustomScalingAxisStartPosition().has_value() ?
+                    bar.GetCustomScalingAxisStartPosition().value() : 0);
+            }
         /// @brief Adjusts the parent canvas size based on how many bars there are.
         ///    The default behaviour is to compare the number of bars to GetBarsPerDefaultCanvasSize(),
         ///    but you can override this function.
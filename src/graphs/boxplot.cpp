@@ -8,6 +8,7 @@
 
 #include "boxplot.h"
 #include "../math/statistics.h"
+#include <execution>
 
 using namespace Wisteria::GraphItems;
 using namespace Wisteria::Colors;
@@ -50,27 +51,24 @@ namespace Wisteria::Graphs
 
         Calculate();
 
-        frequency_set<double> jitterPoints;
+        frequency_set<double, std::less<double>, frequency_storage::hash_storage> jitterPoints;
         if (m_useGrouping)
             {
-            for (size_t i = 0; i < GetData()->GetRowCount(); ++i)
+            for (const auto i : m_groupColumn->GetGroupRows(m_groupId))
                 {
                 if (std::isnan(m_continuousColumn->GetValue(i)))
                     { continue; }
 
-                if (m_groupColumn->GetValue(i) == m_groupId)
-                    { jitterPoints.insert(m_continuousColumn->GetValue(i)); }
+                jitterPoints.insert(m_continuousColumn->GetValue(i));
                 }
             }
         else
             {
-            for (const auto& datum : m_continuousColumn->GetValues())
+            m_continuousColumn->ForEachValue([&jitterPoints](const double datum)
                 {
-                if (std::isnan(datum))
-                    { continue; }
-
-                jitterPoints.insert(datum);
-                }
+                if (!std::isnan(datum))
+                    { jitterPoints.insert(datum); }
+                });
             }
         m_jitter.CalcSpread(jitterPoints);
         }
@@ -80,53 +78,85 @@ namespace Wisteria::Graphs
         {
         if (GetData() == nullptr || m_continuousColumn->GetRowCount() == 0)
             { return; }
-        std::vector<double> dest;
-        if (m_useGrouping)
+        // calls a function for each of the box's valid values
+        const auto forEachValue = [this](auto&& valueFunction)
             {
-            dest.reserve(GetData()->GetRowCount());
-            for (size_t i = 0; i < GetData()->GetRowCount(); ++i)
+            if (m_useGrouping)
                 {
-                if (m_groupColumn->GetValue(i) == m_groupId &&
-                    !std::isnan(m_continuousColumn->GetValue(i)))
-                    { dest.push_back(m_continuousColumn->GetValue(i)); }
+                for (const auto i : m_groupColumn->GetGroupRows(m_groupId))
+                    {
+                    const double val = m_continuousColumn->GetValue(i);
+                    if (!std::isnan(val))
+                        { valueFunction(val); }
+                    }
                 }
-            }
-        else
-            {
-            dest.reserve(GetData()->GetRowCount());
-            std::copy_if(m_continuousColumn->GetValues().cbegin(),
-                         m_continuousColumn->GetValues().cend(),
-                         std::back_inserter(dest),
-                         [](const auto val) noexcept
-                           { return !std::isnan(val); });
-            }
+            else
+                {
+                for (size_t i = 0; i < m_continuousColumn->GetRowCount(); ++i)
+                    {
+                    const double val = m_continuousColumn->GetValue(i);
+                    if (!std::isnan(val))
+                        { valueFunction(val); }
+                    }
+                }
+            };
 
-        std::sort(std::execution::par, dest.begin(), dest.end());
-        statistics::quartiles_presorted(dest,
-            m_lowerControlLimit, m_upperControlLimit);
-        const double outlierRange = 1.5*(m_upperControlLimit-m_lowerControlLimit);
-        m_lowerWhisker = m_lowerControlLimit-outlierRange;
-        m_upperWhisker = m_upperControlLimit+outlierRange;
-        // find the first (lower) non-outlier point
-        for (const auto& val : dest)
+        if (m_approximateQuantiles)
             {
-            if (val >= m_lowerWhisker)
+            std::vector<double> boxQuantiles;
+            // if the box uses the whole column and the column's running statistics
+            // (which are kept up to date as rows are appended) are precise enough,
+            // then reuse them
+            if (!m_useGrouping &&
+                m_continuousColumn->GetRunningStatistics().get_quantile_sketch().rank_error() <=
+                    m_approximateQuantiles.value())
                 {
-                m_lowerWhisker = val;
-                break;
+                boxQuantiles =
+                    m_continuousColumn->GetRunningStatistics().quantiles({ 0.25, 0.5, 0.75 });
                 }
-            }
-        // find the first (upper) non-outlier point
-        for (auto val = dest.rbegin(); val != dest.rend(); ++val)
-            {
-            if (*val <= m_upperWhisker)
+            // otherwise, stream the data through a sketch, rather than copying it
+            else
                 {
-                m_upperWhisker = *val;
-                break;
+                statistics::quantile_sketch sketch(m_approximateQuantiles.value());
+                forEachValue([&sketch](const double val) { sketch.insert(val); });
+                boxQuantiles = sketch.quantiles({ 0.25, 0.5, 0.75 });
                 }
+            m_lowerControlLimit = boxQuantiles[0];
+            m_middlePoint = boxQuantiles[1];
+            m_upperControlLimit = boxQuantiles[2];
+            }
+        else
+            {
+            std::vector<double> dest;
+            dest.reserve(m_useGrouping ? m_groupColumn->GetGroupRows(m_groupId).size() :
+                         GetData()->GetRowCount());
+            forEachValue([&dest](const double val) { dest.push_back(val); });
+            // select the quartiles and median (rather than sorting all of the data)
+            statistics::median_and_quartiles(dest, m_middlePoint,
+                m_lowerControlLimit, m_upperControlLimit);
             }
 
-        m_middlePoint = statistics::median_presorted(dest.cbegin(), dest.cend());
+        const double outlierRange = 1.5*(m_upperControlLimit-m_lowerControlLimit);
+        const double lowerWhiskerLimit = m_lowerControlLimit-outlierRange;
+        const double upperWhiskerLimit = m_upperControlLimit+outlierRange;
+        // find the lowest and highest non-outlier points
+        // (and the range of all the points, while we are at it)
+        m_lowerWhisker = m_minValue = std::numeric_limits<double>::max();
+        m_upperWhisker = m_maxValue = std::numeric_limits<double>::lowest();
+        forEachValue([&](const double val)
+            {
+            m_minValue = std::min(m_minValue, val);
+            m_maxValue = std::max(m_maxValue, val);
+            if (val >= lowerWhiskerLimit)
+                { m_lowerWhisker = std::min(m_lowerWhisker, val); }
+            if (val <= upperWhiskerLimit)
+                { m_upperWhisker = std::max(m_upperWhisker, val); }
+            });
+        // (or the limits themselves if no points are within them)
+        if (m_lowerWhisker == std::numeric_limits<double>::max())
+            { m_lowerWhisker = lowerWhiskerLimit; }
+        if (m_upperWhisker == std::numeric_limits<double>::lowest())
+            { m_upperWhisker = upperWhiskerLimit; }
         }
 
     //----------------------------------------------------------------
@@ -193,21 +223,25 @@ namespace Wisteria::Graphs
         std::vector<BoxAndWhisker> boxes;
         if (m_groupColumn != m_data->GetCategoricalColumns().cend())
             {
-            std::set<Data::GroupIdType> groups;
-            for (const auto& groupId : m_groupColumn->GetValues())
-                { groups.insert(groupId); }
-            for (const auto& group : groups)
-                {
-                BoxAndWhisker box(GetBoxColor(), GetBoxEffect(),
-                                  GetBoxCorners(), GetOpacity());
-                box.SetData(data, continuousColumnName, groupColumnName, group);
-                boxes.push_back(box);
-                }
+            // partition the rows by group (in one pass); the boxes will then read
+            // their rows from this index, rather than scanning the data for their group
+            const auto groups = m_groupColumn->GetGroupIds();
+            BoxAndWhisker groupBox(GetBoxColor(), GetBoxEffect(),
+                                   GetBoxCorners(), GetOpacity());
+            groupBox.m_approximateQuantiles = m_approximateQuantiles;
+            boxes.resize(groups.size(), groupBox);
+            // the boxes are independent of each other, so calculate them in parallel
+            std::vector<size_t> boxIndices(boxes.size());
+            std::iota(boxIndices.begin(), boxIndices.end(), 0);
+            std::for_each(std::execution::par, boxIndices.cbegin(), boxIndices.cend(),
+                [&](const size_t i)
+                { boxes[i].SetData(data, continuousColumnName, groupColumnName, groups[i]); });
             }
         else
             {
             BoxAndWhisker box(GetBoxColor(), GetBoxEffect(),
                               GetBoxCorners(), GetOpacity());
+            box.m_approximateQuantiles = m_approximateQuantiles;
             box.SetData(data, continuousColumnName, std::nullopt, 0);
             boxes.push_back(box);
             }
@@ -246,16 +280,9 @@ namespace Wisteria::Graphs
 
         // see how much room is needed for the whiskers and data points
         // (outliers would go beyond the whiskers).
-        const auto [fullDataMin, fullDataMax] = std::minmax_element(
-            currentBox.m_continuousColumn->GetValues().cbegin(),
-            currentBox.m_continuousColumn->GetValues().cend());
-        const auto [minValue, maxValue] = currentBox.m_useGrouping ?
-            currentBox.GetData()->GetContinuousMinMax(
-                currentBox.m_continuousColumnName, currentBox.m_groupColumnName,
-                currentBox.m_groupId) :
-            std::make_pair(*fullDataMin, *fullDataMax);
-        const double yMin = std::min(currentBox.GetLowerWhisker(), minValue);
-        const double yMax = std::max(currentBox.GetUpperWhisker(), maxValue);
+        // The box's data range was found when it was calculated.
+        const double yMin = std::min(currentBox.GetLowerWhisker(), currentBox.m_minValue);
+        const double yMax = std::max(currentBox.GetUpperWhisker(), currentBox.m_maxValue);
 
         auto [rangeStart, rangeEnd] = GetLeftYAxis().GetRange();
 
@@ -519,22 +546,14 @@ namespace Wisteria::Graphs
             auto dataPoints = std::make_shared<GraphItems::Points2D>(wxNullPen);
             dataPoints->SetScaling(GetScaling());
             dataPoints->SetDPIScaleFactor(GetDPIScaleFactor());
-            for (size_t i = 0; i < box.GetData()->GetRowCount(); ++i)
+            const auto pointOutline =
+                ColorContrast::BlackOrWhiteContrast(GetPointColor());
+            const auto addPoint = [&](const size_t i)
                 {
-                if (std::isnan(box.m_continuousColumn->GetValue(i)))
-                    { continue; }
-
-                const auto pointOutline =
-                    ColorContrast::BlackOrWhiteContrast(GetPointColor());
                 // skip value if from a different group
                 if (box.m_useGrouping &&
                     box.m_groupColumn->GetValue(i) != box.m_groupId)
-                    { continue; }
-                // skip non-outlier points (unless they are requested to be shown)
-                if (!box.IsShowingAllPoints() &&
-                    box.m_continuousColumn->GetValue(i) <= box.GetUpperWhisker() &&
-                    box.m_continuousColumn->GetValue(i) >= box.GetLowerWhisker())
-                    { continue; }
+                    { return; }
                 if (GetPhyscialCoordinates(box.GetXAxisPosition(),
                                            box.m_continuousColumn->GetValue(i), pt))
                     {
@@ -559,6 +578,45 @@ namespace Wisteria::Graphs
                             IconShape::CircleIcon), dc);
                         }
                     }
+                };
+            if (box.IsShowingAllPoints())
+                {
+                // only review the box's group, if grouping
+                if (box.m_useGrouping)
+                    {
+                    for (const auto i : box.m_groupColumn->GetGroupRows(box.m_groupId))
+                        {
+                        if (!std::isnan(box.m_continuousColumn->GetValue(i)))
+                            { addPoint(i); }
+                        }
+                    }
+                else
+                    {
+                    for (size_t i = 0; i < box.GetData()->GetRowCount(); ++i)
+                        {
+                        if (!std::isnan(box.m_continuousColumn->GetValue(i)))
+                            { addPoint(i); }
+                        }
+                    }
+                }
+            // only the outliers are shown, so find them in one pass
+            // rather than visiting (and discarding) every other point
+            else if (box.m_useGrouping)
+                {
+                // only review the box's group (rather than rescanning the whole column for each box)
+                for (const auto i : box.m_groupColumn->GetGroupRows(box.m_groupId))
+                    {
+                    const double value = box.m_continuousColumn->GetValue(i);
+                    if (value < box.GetLowerWhisker() || value > box.GetUpperWhisker())
+                        { addPoint(i); }
+                    }
+                }
+            else
+                {
+                for (const auto i : statistics::indices_outside_range(
+                                        box.m_continuousColumn->GetValues(),
+                                        box.GetLowerWhisker(), box.GetUpperWhisker()))
+                    { addPoint(i); }
                 }
             AddObject(dataPoints);
             AddObject(outliers);
@@ -221,6 +221,8 @@ namespace Wisteria::Graphs
             /// @brief Calculates the outlier and box ranges.
             void Calculate();
 
+            // if set, the rank error of the quantile sketch used to calculate the box
+            std::optional<double> m_approximateQuantiles;
             bool m_displayLabels{ false };
             bool m_showAllPoints{ false };
 
@@ -245,6 +247,9 @@ namespace Wisteria::Graphs
             double m_upperControlLimit{ 0 };
             double m_lowerWhisker{ 0 };
             double m_upperWhisker{ 0 };
+            // the range of the box's data (including outliers)
+            double m_minValue{ std::numeric_limits<double>::max() };
+            double m_maxValue{ std::numeric_limits<double>::lowest() };
 
             // drawing coordinates used by parent BoxPlot
             wxPoint m_lowerOutlierRangeCoordinate;
@@ -426,6 +431,32 @@ namespace Wisteria::Graphs
             { m_pointColour = color; }
         /// @}
 
+        /// @name Statistics Functions
+        /// @brief Functions relating to how the boxes' statistics are calculated.
+        /// @{
+
+        /** @brief Sets whether to calculate the boxes' quartiles and medians from
+             an approximate quantile sketch, rather than from exact order statistics.
+            @details By default, each box copies its (valid) values and selects its
+             quartiles from them. For very large datasets, a sketch can instead be built
+             while streaming through the data, which uses a small, fixed amount of memory.
+            @param useApproximation `true` to use approximate quantiles.
+            @param rankError The approximate maximum (rank) error of the quartiles and medians.
+             For example, `0.01` will result in a median that is within the
+             49th and 51st percentiles.
+            @note This must be called before SetData().
+            @sa statistics::quantile_sketch.*/
+        void UseApproximateQuantiles(const bool useApproximation, const double rankError = 0.01)
+            {
+            m_approximateQuantiles = useApproximation ?
+                std::optional<double>(rankError) : std::nullopt;
+            }
+        /// @returns `true` if the boxes' quartiles and medians are calculated from
+        ///  an approximate quantile sketch.
+        [[nodiscard]] bool IsUsingApproximateQuantiles() const noexcept
+            { return m_approximateQuantiles.has_value(); }
+        /// @}
+
         /// @private
         [[nodiscard]] const BoxAndWhisker& GetBox(const size_t index) const
             { return m_boxes[index]; }
@@ -458,6 +489,7 @@ namespace Wisteria::Graphs
         BoxCorners m_boxCorners{ BoxCorners::Straight };
         bool m_displayLabels{ false };
         bool m_showAllPoints{ false };
+        std::optional<double> m_approximateQuantiles;
         };
     }
 
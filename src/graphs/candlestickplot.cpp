@@ -1,4 +1,5 @@
 #include "candlestickplot.h"
+#include <map>
 
 using namespace Wisteria::GraphItems;
 using namespace Wisteria::Colors;
@@ -47,46 +48,148 @@ namespace Wisteria::Graphs
                 L"'%s': closing column not found for Candlestick plot.", closeColumnName).ToUTF8());
             }
 
+        // Combine the observations into daily candles (and find the range of values) in one pass.
+        // The observations are usually sorted, so check the last day's candle
+        // before looking up the day.
+        struct DailyOhlc
+            {
+            Ohlc m_ohlc;
+            wxDateTime m_openTime;
+            wxDateTime m_closeTime;
+            };
+        std::map<wxDateTime, DailyOhlc> dailyOhlcs;
+        auto currentDay = dailyOhlcs.end();
+        wxDateTime currentDayEnd;
+        std::pair<double, double> valueRange{ std::numeric_limits<double>::max(),
+                                              std::numeric_limits<double>::lowest() };
         for (size_t i = 0; i < data->GetRowCount(); ++i)
             {
-            if (!dateColumn->GetValue(i).IsValid() ||
-                std::isnan(openColumn->GetValue(i)) ||
-                std::isnan(highColumn->GetValue(i)) ||
-                std::isnan(lowColumn->GetValue(i)) ||
-                std::isnan(closeColumn->GetValue(i)))
+            const auto& date = dateColumn->GetValue(i);
+            const auto openValue = openColumn->GetValue(i);
+            const auto highValue = highColumn->GetValue(i);
+            const auto lowValue = lowColumn->GetValue(i);
+            const auto closeValue = closeColumn->GetValue(i);
+            if (!date.IsValid() ||
+                std::isnan(openValue) ||
+                std::isnan(highValue) ||
+                std::isnan(lowValue) ||
+                std::isnan(closeValue))
                 { continue; }
-            m_ohlcs.push_back({ dateColumn->GetValue(i), openColumn->GetValue(i),
-                                highColumn->GetValue(i), lowColumn->GetValue(i),
-                                closeColumn->GetValue(i) });
+            valueRange.first = std::min({ valueRange.first, openValue, highValue, lowValue, closeValue });
+            valueRange.second = std::max({ valueRange.second, openValue, highValue, lowValue, closeValue });
+
+            if (currentDay == dailyOhlcs.end() ||
+                date < currentDay->first || date >= currentDayEnd)
+                {
+                const auto day = date.GetDateOnly();
+                currentDay = dailyOhlcs.find(day);
+                if (currentDay == dailyOhlcs.end())
+                    {
+                    currentDay = dailyOhlcs.insert(std::make_pair(day,
+                        DailyOhlc{ Ohlc{ day, openValue, highValue, lowValue, closeValue },
+                                   date, date })).first;
+                    currentDayEnd = day + wxDateSpan::Day();
+                    continue;
+                    }
+                currentDayEnd = day + wxDateSpan::Day();
+                }
+            auto& [ohlc, openTime, closeTime] = currentDay->second;
+            ohlc.m_high = std::max(ohlc.m_high, highValue);
+            ohlc.m_low = std::min(ohlc.m_low, lowValue);
+            if (date < openTime)
+                {
+                ohlc.m_open = openValue;
+                openTime = date;
+                }
+            if (date >= closeTime)
+                {
+                ohlc.m_close = closeValue;
+                closeTime = date;
+                }
+            }
+
+        m_ohlcs.clear();
+        m_ohlcs.reserve(dailyOhlcs.size());
+        for (const auto& dailyOhlc : dailyOhlcs)
+            { m_ohlcs.push_back(dailyOhlc.second.m_ohlc); }
+
+        // combine into larger candles, if requested (or if there would be too many to show)
+        m_resampledCandlePeriod = (GetCandlePeriod() == CandlePeriod::Automatic) ?
+            CandlePeriod::Daily : GetCandlePeriod();
+        const size_t maxCandles = GetPointsPerDefaultCanvasSize() * 10;
+        if (GetCandlePeriod() != CandlePeriod::Daily &&
+            (GetCandlePeriod() != CandlePeriod::Automatic || m_ohlcs.size() > maxCandles))
+            {
+            auto resampledOhlcs = ResampleOhlcs(m_ohlcs,
+                (GetCandlePeriod() == CandlePeriod::Automatic) ?
+                    CandlePeriod::Weekly : GetCandlePeriod());
+            m_resampledCandlePeriod = (GetCandlePeriod() == CandlePeriod::Automatic) ?
+                CandlePeriod::Weekly : GetCandlePeriod();
+            if (GetCandlePeriod() == CandlePeriod::Automatic && resampledOhlcs.size() > maxCandles)
+                {
+                resampledOhlcs = ResampleOhlcs(m_ohlcs, CandlePeriod::Monthly);
+                m_resampledCandlePeriod = CandlePeriod::Monthly;
+                }
+            m_ohlcs = std::move(resampledOhlcs);
             }
-        Calculate(data, openColumnName, lowColumnName, highColumnName, closeColumnName);
+
+        Calculate(valueRange);
         UpdateCanvasForPoints();
         }
 
     //----------------------------------------------------------------
-    void CandlestickPlot::Calculate(const std::shared_ptr<const Data::Dataset>& data,
-        const wxString& openColumnName, const wxString& highColumnName,
-        const wxString& lowColumnName, const wxString& closeColumnName)
+    std::vector<CandlestickPlot::Ohlc> CandlestickPlot::ResampleOhlcs(
+        const std::vector<Ohlc>& dailyOhlcs, const CandlePeriod period)
         {
-        if (!m_ohlcs.size() || data == nullptr)
-            { return; }
+        // use the first day of the week based on the locale's calendar
+        wxDateTime::WeekDay firstWeekDay;
+        if (!wxDateTime::GetFirstWeekDay(&firstWeekDay))
+            { firstWeekDay = wxDateTime::WeekDay::Sun; }
 
-        wxDateTime firstDay = std::min_element(m_ohlcs.cbegin(), m_ohlcs.cend(),
-            [](const auto& ohlc1, const auto& ohlc2)
+        std::vector<Ohlc> resampledOhlcs;
+        for (const auto& dailyOhlc : dailyOhlcs)
+            {
+            wxDateTime periodStart = dailyOhlc.m_date;
+            if (period == CandlePeriod::Monthly)
+                { periodStart.SetDay(1); }
+            else if (period == CandlePeriod::Weekly)
                 {
-                return (!ohlc1.m_date.IsValid() && !ohlc2.m_date.IsValid()) ? false :
-                    (!ohlc1.m_date.IsValid() && ohlc2.m_date.IsValid()) ? false :
-                    (ohlc1.m_date.IsValid() && !ohlc2.m_date.IsValid()) ? true :
-                    ohlc1.m_date < ohlc2.m_date;
-                })->m_date;
-        wxDateTime lastDay = std::max_element(m_ohlcs.cbegin(), m_ohlcs.cend(),
-            [](const auto& ohlc1, const auto& ohlc2)
+                while (periodStart.GetWeekDay() != firstWeekDay)
+                    { periodStart.Subtract(wxDateSpan::Day()); }
+                }
+            // the days are sorted, so the day either goes into the last candle or starts a new one
+            if (resampledOhlcs.empty() || resampledOhlcs.back().m_date != periodStart)
                 {
-                return (!ohlc1.m_date.IsValid() && !ohlc2.m_date.IsValid()) ? false :
-                    (!ohlc1.m_date.IsValid() && ohlc2.m_date.IsValid()) ? true :
-                    (ohlc1.m_date.IsValid() && !ohlc2.m_date.IsValid()) ? false :
-                    ohlc1.m_date < ohlc2.m_date;
-                })->m_date;
+                resampledOhlcs.push_back(dailyOhlc);
+                resampledOhlcs.back().m_date = periodStart;
+                continue;
+                }
+            auto& ohlc = resampledOhlcs.back();
+            ohlc.m_high = std::max(ohlc.m_high, dailyOhlc.m_high);
+            ohlc.m_low = std::min(ohlc.m_low, dailyOhlc.m_low);
+            ohlc.m_close = dailyOhlc.m_close;
+            }
+        return resampledOhlcs;
+        }
+
+    //----------------------------------------------------------------
+    int CandlestickPlot::GetDaysInCandle(const Ohlc& ohlc) const
+        {
+        return (m_resampledCandlePeriod == CandlePeriod::Monthly) ?
+            wxDateTime::GetNumberOfDays(ohlc.m_date.GetMonth(), ohlc.m_date.GetYear()) :
+            (m_resampledCandlePeriod == CandlePeriod::Weekly) ? 7 : 1;
+        }
+
+    //----------------------------------------------------------------
+    void CandlestickPlot::Calculate(const std::pair<double, double>& valueRange)
+        {
+        if (!m_ohlcs.size())
+            { return; }
+
+        // the candles are sorted by date
+        const wxDateTime firstDay = m_ohlcs.front().m_date;
+        const wxDateTime lastDay = m_ohlcs.back().m_date +
+            wxDateSpan::Days(GetDaysInCandle(m_ohlcs.back()) - 1);
 
         if (firstDay.IsValid() && lastDay.IsValid())
             {
@@ -102,17 +205,7 @@ namespace Wisteria::Graphs
                 GetBottomXAxis().GetRangeDates().second.FormatDate());
             }
 
-        const auto openMinMaxValues = data->GetContinuousMinMax(openColumnName, std::nullopt, 0);
-        const auto lowMinMaxValues = data->GetContinuousMinMax(lowColumnName, std::nullopt, 0);
-        const auto highMinMaxValues = data->GetContinuousMinMax(highColumnName, std::nullopt, 0);
-        const auto closeMinMaxValues = data->GetContinuousMinMax(closeColumnName, std::nullopt, 0);
-
-        GetLeftYAxis().SetRange(
-            std::min({ openMinMaxValues.first, lowMinMaxValues.first,
-                       highMinMaxValues.first, closeMinMaxValues.first}),
-            std::max({ openMinMaxValues.second, lowMinMaxValues.second,
-                       highMinMaxValues.second, closeMinMaxValues.second }),
-            2);
+        GetLeftYAxis().SetRange(valueRange.first, valueRange.second, 2);
 
         const auto [yStartCurrent, yEndCurrent] = GetLeftYAxis().GetRange();
         const auto [adjustedYStartCurrent, adjustedYEndCurrent] =
@@ -131,8 +224,8 @@ namespace Wisteria::Graphs
         {
         Graph2D::RecalcSizes(dc);
 
-        const auto candleWidth = std::floor(safe_divide<double>(
-            GetPlotAreaBoundingBox().GetWidth(), GetBottomXAxis().GetAxisPointsCount()));
+        const auto dayWidth = safe_divide<double>(
+            GetPlotAreaBoundingBox().GetWidth(), GetBottomXAxis().GetAxisPointsCount());
 
         for (const auto& ohlc : m_ohlcs)
             {
@@ -148,20 +241,29 @@ namespace Wisteria::Graphs
                 continue;
                 }
 
+            // candles covering more than a day are centered on their period
+            const auto daysInCandle = GetDaysInCandle(ohlc);
+            const auto candleWidth = std::floor(dayWidth * daysInCandle);
+
             wxString ohlcInfo = wxString::Format(
                 _(L"Date: %s\n"
                    "Opening: %s\n"
                    "High : %s\n"
                    "Low : %s\n"
                    "Closing : %s"),
-                   ohlc.m_date.FormatDate(),
+                   (daysInCandle > 1 ?
+                       wxString::Format(L"%s-%s", ohlc.m_date.FormatDate(),
+                           (ohlc.m_date + wxDateSpan::Days(daysInCandle - 1)).FormatDate()) :
+                       ohlc.m_date.FormatDate()),
                    wxNumberFormatter::ToString(ohlc.m_open, Settings::GetDefaultNumberFormat()),
                    wxNumberFormatter::ToString(ohlc.m_high, Settings::GetDefaultNumberFormat()),
                    wxNumberFormatter::ToString(ohlc.m_low, Settings::GetDefaultNumberFormat()),
                    wxNumberFormatter::ToString(ohlc.m_close, Settings::GetDefaultNumberFormat()));
 
             wxPoint lowPt, hiPt;
-            const auto datePos = GetBottomXAxis().GetPointFromDate(ohlc.m_date);
+            auto datePos = GetBottomXAxis().GetPointFromDate(ohlc.m_date);
+            if (datePos.has_value())
+                { datePos = datePos.value() + (daysInCandle - 1) / 2.0; }
             if (!datePos.has_value() ||
                 !GetPhyscialCoordinates(datePos.value(), ohlc.m_low, lowPt) ||
                 !GetPhyscialCoordinates(datePos.value(), ohlc.m_high, hiPt))
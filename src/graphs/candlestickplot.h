@@ -37,6 +37,10 @@ namespace Wisteria::Graphs
 
          ...
 
+         The observations do not need to be daily; intraday (e.g., tick or minute) data is
+         combined into daily, weekly, or monthly candles (refer to SetCandlePeriod()).
+         Also, the data does not need to be sorted.
+
          @par Missing Data:
           - Any missing data in an observation will result in listwise deletion.
 
@@ -94,6 +98,16 @@ namespace Wisteria::Graphs
             Ohlc         /*!< Display gains and losses as protruding lines.*/
             };
 
+        /// @brief The period of time that each candle covers.
+        enum class CandlePeriod
+            {
+            Automatic, /*!< Days, unless that would be too many candles to show, in which case
+                            weeks or months are used. Refer to SetCandlePeriod() for details.*/
+            Daily,     /*!< Each candle is a day.*/
+            Weekly,    /*!< Each candle is a week (starting on the locale's first weekday).*/
+            Monthly    /*!< Each candle is a month.*/
+            };
+
         /** @brief Constructor.
             @param canvas The canvas to draw the line plot on.*/
         explicit CandlestickPlot(Canvas* canvas) :
@@ -110,6 +124,10 @@ namespace Wisteria::Graphs
             @param lowColumnName The column containing the lowest price during the day.
             @param highColumnName The column containing the highest price during the day.
             @param closeColumnName The column containing the closing price.
+            @details The observations are combined into candles (based on GetCandlePeriod()),
+                where a candle's opening price is from its earliest observation,
+                its closing price is from its latest observation,
+                and its high and low are the extremes of all of its observations.
             @throws std::runtime_error If any columns can't be found by name, throws an exception.\n
              The exception's @c what() message is UTF-8 encoded, so pass it to @c wxString::FromUTF8()
              when formatting it for an error message.*/
@@ -126,6 +144,26 @@ namespace Wisteria::Graphs
             @param type The chart type to set this to.*/
         void SetChartType(const ChartType& type)
             { m_chartType = type; }
+        /** @brief Sets the period of time that each candle covers.
+            @details By default, this is CandlePeriod::Automatic, which will show a candle
+                for each day, unless there would be more than
+                `GetPointsPerDefaultCanvasSize() * 10` candles
+                (i.e., the canvas would need to be widened more than ten times to show them).
+                In that case, weekly candles are used; or monthly candles, if there would still
+                be too many weekly candles.
+            @param period The period for each candle.
+            @note This should be called before SetData().*/
+        void SetCandlePeriod(const CandlePeriod period) noexcept
+            { m_candlePeriod = period; }
+        /// @returns The period of time that each candle covers.
+        /// @sa GetResampledCandlePeriod().
+        [[nodiscard]] CandlePeriod GetCandlePeriod() const noexcept
+            { return m_candlePeriod; }
+        /// @returns The period of time that the candles from the last call to SetData() cover.
+        /// @note If GetCandlePeriod() is CandlePeriod::Automatic, then this will return the
+        ///     period that was selected.
+        [[nodiscard]] CandlePeriod GetResampledCandlePeriod() const noexcept
+            { return m_resampledCandlePeriod; }
         /// @brief Gets/sets the brush used to paint days that saw a loss.
         /// @returns The brush used to paint days that saw a loss.
         [[nodiscard]] wxBrush& GetLossBrush() noexcept
@@ -174,9 +212,14 @@ namespace Wisteria::Graphs
             double m_close{ 0 };
             };
 
-        void Calculate(const std::shared_ptr<const Data::Dataset>& data,
-            const wxString& openColumnName, const wxString& highColumnName,
-            const wxString& lowColumnName, const wxString& closeColumnName);
+        /// @brief Combines daily candles into weekly or monthly ones.
+        /// @param dailyOhlcs The daily candles (sorted by date).
+        /// @param period The period to combine the candles into.
+        [[nodiscard]] static std::vector<Ohlc> ResampleOhlcs(const std::vector<Ohlc>& dailyOhlcs,
+                                                             const CandlePeriod period);
+        /// @returns The number of days that a candle covers.
+        [[nodiscard]] int GetDaysInCandle(const Ohlc& ohlc) const;
+        void Calculate(const std::pair<double, double>& valueRange);
         /// @brief Recalculates the size of embedded objects on the plot.
         void RecalcSizes(wxDC& dc) final;
 
@@ -195,6 +238,8 @@ namespace Wisteria::Graphs
 
         std::vector<Ohlc> m_ohlcs;
         size_t m_pointsPerDefaultCanvasSize{ 100 };
+        CandlePeriod m_candlePeriod{ CandlePeriod::Automatic };
+        CandlePeriod m_resampledCandlePeriod{ CandlePeriod::Daily };
         ChartType m_chartType{ ChartType::Candlestick };
         };
     }
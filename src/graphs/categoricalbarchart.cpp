@@ -88,26 +88,89 @@ namespace Wisteria::Graphs
         if (m_data == nullptr)
             { return; }
 
-        // calculate how many observations are in each group
-        aggregate_frequency_set<CatBarBlock> groups;
+        // (category, group) blocks with their observation counts and totals, in block order
+        std::vector<std::pair<CatBarBlock, std::pair<size_t, double>>> blockTotals;
 
-        for (size_t i = 0; i < m_data->GetRowCount(); ++i)
+        const auto& categoryIds = m_categoricalColumn->GetValues();
+        const auto maxCategoryId = categoryIds.empty() ? Data::GroupIdType{ 0 } :
+            *std::max_element(categoryIds.cbegin(), categoryIds.cend());
+        const auto maxGroupId = (m_useGrouping && m_groupColumn->GetRowCount() > 0) ?
+            *std::max_element(m_groupColumn->GetValues().cbegin(),
+                              m_groupColumn->GetValues().cend()) :
+            Data::GroupIdType{ 0 };
+
+        // if the codes are compact enough, count into a dense (category x group) table
+        // (in parallel, with one table per chunk of rows); otherwise, fall back to
+        // an ordered set for sparse, high-cardinality codes
+        if (maxCategoryId < MAX_DENSE_BLOCK_COUNT && maxGroupId < MAX_DENSE_BLOCK_COUNT &&
+            (maxCategoryId + 1) * (maxGroupId + 1) <= MAX_DENSE_BLOCK_COUNT)
+            {
+            const size_t groupCount = maxGroupId + 1;
+            const size_t cellCount = (maxCategoryId + 1) * groupCount;
+            const auto* groupIds = m_useGrouping ? &m_groupColumn->GetValues() : nullptr;
+
+            const auto cellTotals = statistics::chunked_reduce(categoryIds.size(),
+                std::vector<std::pair<size_t, double>>(cellCount, std::make_pair(size_t{ 0 }, 0.0)),
+                [this, &categoryIds, groupIds, groupCount]
+                (auto& totals, const size_t first, const size_t last)
+                    {
+                    for (size_t i = first; i < last; ++i)
+                        {
+                        const double value = m_useValueColumn ?
+                            m_continuousColumn->GetValue(i) : 1.0;
+                        // entire observation is ignored if value being aggregated is NaN
+                        if (std::isnan(value))
+                            { continue; }
+                        auto& cell = totals[(categoryIds[i] * groupCount) +
+                                            (groupIds != nullptr ? (*groupIds)[i] : 0)];
+                        ++cell.first;
+                        cell.second += value;
+                        }
+                    },
+                [](auto& result, const auto& chunkTotals)
+                    {
+                    for (size_t i = 0; i < result.size(); ++i)
+                        {
+                        result[i].first += chunkTotals[i].first;
+                        result[i].second += chunkTotals[i].second;
+                        }
+                    },
+                // larger chunks for larger tables, so that merging them stays cheap
+                std::max<size_t>(DENSE_CHUNK_SIZE, cellCount * 64));
+
+            for (size_t i = 0; i < cellTotals.size(); ++i)
+                {
+                if (cellTotals[i].first > 0)
+                    {
+                    blockTotals.emplace_back(
+                        CatBarBlock{ i / groupCount, i % groupCount }, cellTotals[i]);
+                    }
+                }
+            }
+        else
             {
-            // entire observation is ignored if value being aggregated is NaN
-            if (m_useValueColumn &&
-                std::isnan(m_continuousColumn->GetValue(i)))
-                { continue; }
-            groups.insert(
-                // the current category ID (and group, if applicable)
-                CatBarBlock{
-                    m_categoricalColumn->GetValue(i),
-                    (m_useGrouping ?
-                        m_groupColumn->GetValue(i) : static_cast<Data::GroupIdType>(0)) },
-                (m_useValueColumn ? m_continuousColumn->GetValue(i) : 1));
+            aggregate_frequency_set<CatBarBlock> groups;
+
+            for (size_t i = 0; i < m_data->GetRowCount(); ++i)
+                {
+                // entire observation is ignored if value being aggregated is NaN
+                if (m_useValueColumn &&
+                    std::isnan(m_continuousColumn->GetValue(i)))
+                    { continue; }
+                groups.insert(
+                    // the current category ID (and group, if applicable)
+                    CatBarBlock{
+                        m_categoricalColumn->GetValue(i),
+                        (m_useGrouping ?
+                            m_groupColumn->GetValue(i) : static_cast<Data::GroupIdType>(0)) },
+                    (m_useValueColumn ? m_continuousColumn->GetValue(i) : 1));
+                }
+            blockTotals.assign(groups.get_data().cbegin(), groups.get_data().cend());
             }
 
-        // add the bars (block-by-block)
-        for (const auto& blockTable : groups.get_data())
+        // build the bars (block-by-block), then add them all at once
+        std::vector<Bar> bars;
+        for (const auto& blockTable : blockTotals)
             {
             const wxColour blockColor = (m_useGrouping ?
                 GetColorScheme()->GetColor(blockTable.first.m_block) : GetColorScheme()->GetColor(0));
@@ -129,10 +192,10 @@ namespace Wisteria::Graphs
                 }
             GraphItems::Label blockLabel(blockLabelText);
 
-            auto foundBar = std::find_if(GetBars().begin(), GetBars().end(),
-                [&blockTable](const auto& bar)
-                    { return compare_doubles(bar.GetAxisPosition(), blockTable.first.m_bin); });
-            if (foundBar == GetBars().end())
+            // blocks are ordered by category, so a category's bar (if already built)
+            // will be the last one
+            if (bars.empty() ||
+                !compare_doubles(bars.back().GetAxisPosition(), blockTable.first.m_bin))
                 {
                 Bar theBar(blockTable.first.m_bin,
                     {
@@ -143,16 +206,16 @@ namespace Wisteria::Graphs
                     GraphItems::Label(
                         m_categoricalColumn->GetCategoryLabelFromID(blockTable.first.m_bin)),
                     GetBarEffect(), GetBarOpacity());
-                AddBar(theBar);
+                bars.push_back(std::move(theBar));
                 }
             else
                 {
                 BarBlock block{ BarBlock(BarBlockInfo(blockTable.second.second).
                     Brush(blockColor).SelectionLabel(blockLabel)) };
-                foundBar->AddBlock(block);
-                UpdateScalingAxisFromBar(*foundBar);
+                bars.back().AddBlock(block);
                 }
             }
+        AddBars(std::move(bars));
 
         // add the bar labels now that they are built
         for (auto& bar : GetBars())
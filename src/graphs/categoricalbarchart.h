@@ -149,6 +149,10 @@ namespace Wisteria::Graphs
                 }
             };
         void Calculate();
+        /// @brief The most (category x group) blocks that Calculate() will tally in a dense table.
+        constexpr static size_t MAX_DENSE_BLOCK_COUNT{ 64 * 1024 };
+        /// @brief The minimum number of rows that each (parallel) dense tally processes.
+        constexpr static size_t DENSE_CHUNK_SIZE{ 1024 * 1024 };
         /// @returns The type of labels being shown on the bars.
         [[nodiscard]] BinLabelDisplay GetBinLabelDisplay() const noexcept
             { return m_binLabelDisplay; }
@@ -48,6 +48,8 @@ namespace Wisteria::Graphs
 
         ClearBars();
         GetSelectedIds().clear();
+        m_tasks.clear();
+        m_taskIndexIsStale = true;
         m_legendLines.clear();
         m_legendTitle.clear();
 
@@ -83,6 +85,7 @@ namespace Wisteria::Graphs
 
         std::set<Data::GroupIdType> groupIds;
 
+        m_tasks.reserve(data->GetRowCount());
         for (size_t i = 0; i < data->GetRowCount(); ++i)
             {
             AddTask(
@@ -109,6 +112,8 @@ namespace Wisteria::Graphs
             if (groupColumn != data->GetCategoricalColumns().cend())
                 { groupIds.insert(groupColumn->GetValue(i)); }
             }
+        // index the tasks and set the date range once, after all of them are added
+        Calculate();
 
         if (groupColumn != data->GetCategoricalColumns().cend())
             {
@@ -122,28 +127,72 @@ namespace Wisteria::Graphs
             }
         }
 
+    //----------------------------------------------------------------
+    void GanttChart::BuildTaskIndex()
+        {
+        // tasks without a start (or end) date run from the start (or to the end) of the timeline
+        std::vector<std::pair<double, double>> taskDates;
+        taskDates.reserve(m_tasks.size());
+        m_firstTaskDate = m_lastTaskDate = wxInvalidDateTime;
+        for (const auto& task : m_tasks)
+            {
+            taskDates.emplace_back(
+                task.m_start.IsValid() ?
+                    task.m_start.GetJDN() : -std::numeric_limits<double>::infinity(),
+                task.m_end.IsValid() ?
+                    task.m_end.GetJDN() : std::numeric_limits<double>::infinity());
+            if (task.m_start.IsValid() &&
+                (!m_firstTaskDate.IsValid() || task.m_start < m_firstTaskDate))
+                { m_firstTaskDate = task.m_start; }
+            if (task.m_end.IsValid() &&
+                (!m_lastTaskDate.IsValid() || task.m_end > m_lastTaskDate))
+                { m_lastTaskDate = task.m_end; }
+            }
+        m_taskIndex.Build(taskDates);
+        m_taskIndexIsStale = false;
+        }
+
+    //----------------------------------------------------------------
+    std::vector<size_t> GanttChart::GetVisibleTasks() const
+        {
+        if (!m_visibleDateRange)
+            {
+            std::vector<size_t> allTasks(m_tasks.size());
+            std::iota(allTasks.begin(), allTasks.end(), 0);
+            return allTasks;
+            }
+        const auto& [rangeStart, rangeEnd] = m_visibleDateRange.value();
+        return m_taskIndex.FindOverlapping(
+            rangeStart.IsValid() ? rangeStart.GetJDN() : -std::numeric_limits<double>::infinity(),
+            rangeEnd.IsValid() ? rangeEnd.GetJDN() : std::numeric_limits<double>::infinity());
+        }
+
     //----------------------------------------------------------------
     void GanttChart::Calculate()
         {
         if (!m_tasks.size())
             { return; }
 
-        wxDateTime firstDay = std::min_element(m_tasks.cbegin(), m_tasks.cend(),
-            [](const auto& task1, const auto& task2)
-                {
-                return (!task1.m_start.IsValid() && !task2.m_start.IsValid()) ? false :
-                    (!task1.m_start.IsValid() && task2.m_start.IsValid()) ? false :
-                    (task1.m_start.IsValid() && !task2.m_start.IsValid()) ? true :
-                    task1.m_start < task2.m_start;
-                })->m_start;
-        wxDateTime lastDay = std::max_element(m_tasks.cbegin(), m_tasks.cend(),
-            [](const auto& task1, const auto& task2)
+        if (m_taskIndexIsStale)
+            { BuildTaskIndex(); }
+
+        wxDateTime firstDay{ m_firstTaskDate };
+        wxDateTime lastDay{ m_lastTaskDate };
+        // narrow the axis to the visible range (but not past the tasks' dates)
+        if (m_visibleDateRange)
+            {
+            const auto& [rangeStart, rangeEnd] = m_visibleDateRange.value();
+            if (rangeStart.IsValid() && (!firstDay.IsValid() || rangeStart > firstDay))
+                { firstDay = rangeStart; }
+            if (rangeEnd.IsValid() && (!lastDay.IsValid() || rangeEnd < lastDay))
+                { lastDay = rangeEnd; }
+            // range is outside of all the tasks, so just show the range
+            if (firstDay.IsValid() && lastDay.IsValid() && firstDay > lastDay)
                 {
-                return (!task1.m_end.IsValid() && !task2.m_end.IsValid()) ? false :
-                    (!task1.m_end.IsValid() && task2.m_end.IsValid()) ? true :
-                    (task1.m_end.IsValid() && !task2.m_end.IsValid()) ? false :
-                    task1.m_end < task2.m_end;
-                })->m_end;
+                firstDay = rangeStart;
+                lastDay = rangeEnd;
+                }
+            }
 
         if (firstDay.IsValid() && lastDay.IsValid())
             {
@@ -174,24 +223,49 @@ namespace Wisteria::Graphs
         {
         ClearBars(false);
 
-        for (const auto& taskInfo : m_tasks)
+        // only the tasks in the visible date range are laid out (which may be
+        // a small part of a large project plan), so build their bars first
+        // and then add them in one batch
+        const auto visibleTasks = GetVisibleTasks();
+        const auto [axisStartDate, axisEndDate] = GetScalingAxis().GetRangeDates();
+        std::vector<Bar> taskBars;
+        taskBars.reserve(visibleTasks.size());
+        for (const auto taskIndex : visibleTasks)
             {
+            const auto& taskInfo = m_tasks[taskIndex];
             if (taskInfo.m_start.IsValid() && taskInfo.m_end.IsValid())
                 {
 
                 const GraphItems::Label axisLabel(taskInfo.m_name);
 
-                const auto startPt = GetScalingAxis().GetPointFromDate(taskInfo.m_start);
-                const auto endPt = GetScalingAxis().GetPointFromDate(taskInfo.m_end);
+                // tasks running past the visible range are cut off at the edges of the axis
+                const wxDateTime barStart =
+                    (axisStartDate.IsValid() && taskInfo.m_start < axisStartDate) ?
+                    axisStartDate : taskInfo.m_start;
+                const wxDateTime barEnd =
+                    (axisEndDate.IsValid() && taskInfo.m_end > axisEndDate) ?
+                    axisEndDate : taskInfo.m_end;
+                const bool isCutOff = (barStart != taskInfo.m_start || barEnd != taskInfo.m_end);
+
+                const auto startPt = GetScalingAxis().GetPointFromDate(barStart);
+                const auto endPt = GetScalingAxis().GetPointFromDate(barEnd);
                 wxASSERT_MSG(startPt.has_value() && endPt.has_value(),
                     L"Valid dates not found on axis in Gantt chart?!");
                 if (!startPt.has_value() || !endPt.has_value())
                     { continue; }
 
-                const auto daysInTask = static_cast<int>(endPt.value() - startPt.value());
-                const double daysFinished = safe_divide<double>(taskInfo.m_percentFinished, 100) * daysInTask;
-                const double daysRemaining = daysInTask-daysFinished;
-                Bar br(GetBars().size(),
+                const auto barDays = endPt.value() - startPt.value();
+                const auto daysInTask = isCutOff ?
+                    (taskInfo.m_end - taskInfo.m_start).GetDays() : static_cast<int>(barDays);
+                double daysFinished = safe_divide<double>(taskInfo.m_percentFinished, 100) * daysInTask;
+                // only the part of the finished days that are in the visible range is shown
+                if (isCutOff)
+                    {
+                    daysFinished = std::clamp<double>(
+                        daysFinished - (barStart - taskInfo.m_start).GetDays(), 0, barDays);
+                    }
+                const double daysRemaining = barDays-daysFinished;
+                Bar br(taskBars.size(),
                     {
                         { BarBlock(BarBlockInfo(daysFinished).
                             Brush(wxBrush(ColorContrast::BlackOrWhiteContrast(taskInfo.m_color),
@@ -285,7 +359,7 @@ namespace Wisteria::Graphs
                     br.GetAxisLabel().GetLegendIcons().emplace_back(
                         LegendIcon(IconShape::ImageWholeLegend, img));
                     }
-                AddBar(br, false);
+                taskBars.push_back(std::move(br));
                 }
             else
                 {
@@ -297,7 +371,7 @@ namespace Wisteria::Graphs
                     (endPoint.has_value() ? endPoint.value() : GetScalingAxis().GetRange().second) -
                     (startPoint.has_value() ? startPoint.value() : GetScalingAxis().GetRange().first);
 
-                Bar arrowBar(GetBars().size(),
+                Bar arrowBar(taskBars.size(),
                     {
                         {
                         BarBlock(BarBlockInfo(daysDiff).
@@ -367,9 +441,10 @@ namespace Wisteria::Graphs
                     arrowBar.GetAxisLabel().GetLegendIcons().emplace_back(
                         LegendIcon(IconShape::ImageWholeLegend, img));
                     }
-                AddBar(arrowBar, false);
+                taskBars.push_back(std::move(arrowBar));
                 }
             }
+        AddBars(std::move(taskBars), false);
 
         BarChart::RecalcSizes(dc);
         }
@@ -12,7 +12,9 @@
 #ifndef __WISTERIA_GANTT_H__
 #define __WISTERIA_GANTT_H__
 
+#include <limits>
 #include "barchart.h"
+#include "../util/intervalindex.h"
 
 namespace Wisteria::Graphs
     {
@@ -164,6 +166,32 @@ namespace Wisteria::Graphs
                      std::optional<const wxString> completionColumnName = std::nullopt,
                      std::optional<const wxString> groupColumnName = std::nullopt);
 
+        /** @brief Only shows the tasks (or the parts of them) within a date range.
+            @details This is useful for large project plans, where only the window of dates
+             being reviewed needs to be shown. Only the tasks that overlap the range are
+             laid out, and tasks extending past it are cut off at the edges of the axis.
+            @param start The start of the range.
+            @param end The end of the range.
+            @note The range is clamped to the dates of the tasks, and the axis
+             may be expanded further by the date display interval
+             (e.g., to the start and end of fiscal quarters).*/
+        void SetVisibleDateRange(const wxDateTime& start, const wxDateTime& end)
+            {
+            m_visibleDateRange = std::make_pair(start, end);
+            Calculate();
+            }
+        /// @brief Shows all tasks, removing the range set by SetVisibleDateRange().
+        void ClearVisibleDateRange()
+            {
+            m_visibleDateRange.reset();
+            Calculate();
+            }
+        /// @returns The range of dates that tasks are being shown for,
+        ///     or @c std::nullopt if all tasks are being shown.
+        [[nodiscard]] const std::optional<std::pair<wxDateTime, wxDateTime>>&
+            GetVisibleDateRange() const noexcept
+            { return m_visibleDateRange; }
+
         /// @returns The date intervals as they are shown along the scaling axis.
         [[nodiscard]] DateInterval GetDateDisplayInterval() const noexcept
             { return m_dateDisplayInterval; }
@@ -305,17 +333,23 @@ namespace Wisteria::Graphs
             wxColour m_color{ *wxBLACK };
             };
         /** @brief Adds a task to the chart.
-            @param taskInfo Information about the task.*/
+            @param taskInfo Information about the task.
+            @note Call Calculate() after adding tasks.*/
         void AddTask(const TaskInfo& taskInfo)
             {
             m_tasks.emplace_back(taskInfo);
-            Calculate();
+            m_taskIndexIsStale = true;
             }
         void AddTask(TaskInfo&& taskInfo)
             {
-            m_tasks.emplace_back(taskInfo);
-            Calculate();
+            m_tasks.emplace_back(std::move(taskInfo));
+            m_taskIndexIsStale = true;
             }
+        /// @brief Indexes the tasks by their dates and finds the earliest and latest dates.
+        void BuildTaskIndex();
+        /// @returns The indices of the tasks that overlap the visible date range
+        ///     (or all tasks if no range is set), in the order that they were added.
+        [[nodiscard]] std::vector<size_t> GetVisibleTasks() const;
         void Calculate();
         void RecalcSizes(wxDC& dc) final;
         
@@ -325,6 +359,12 @@ namespace Wisteria::Graphs
             { return m_colorScheme; }
 
         std::vector<TaskInfo> m_tasks;
+        // the tasks' dates (as Julian day numbers), for finding the tasks in the visible range
+        IntervalIndex<double> m_taskIndex;
+        bool m_taskIndexIsStale{ true };
+        wxDateTime m_firstTaskDate;
+        wxDateTime m_lastTaskDate;
+        std::optional<std::pair<wxDateTime, wxDateTime>> m_visibleDateRange;
         TaskLabelDisplay m_labelDisplay{ TaskLabelDisplay::Days };
 
         DateInterval m_dateDisplayInterval{ DateInterval::FiscalQuarterly };
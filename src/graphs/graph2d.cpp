@@ -79,6 +79,40 @@ namespace Wisteria::Graphs
         legend->SetText(legend->GetText() + L"\n \n" + textLines.Trim());
         }
 
+    //----------------------------------------------------------------
+    std::shared_ptr<GraphItems::Label> Graph2D::FindCachedLegend(
+        const LegendOptions& options) const
+        {
+        const auto foundPos = std::find_if(m_legendCache.cbegin(), m_legendCache.cend(),
+            [this, &options](const auto& cached) noexcept
+            {
+            return cached.m_options == options &&
+                compare_doubles(cached.m_dpiScaleFactor, GetDPIScaleFactor()) &&
+                cached.m_maxItemCount == Settings::GetMaxLegendItemCount() &&
+                cached.m_maxTextLength == Settings::GetMaxLegendTextLength();
+            });
+        return (foundPos != m_legendCache.cend()) ?
+            std::make_shared<GraphItems::Label>(*foundPos->m_legend) : nullptr;
+        }
+
+    //----------------------------------------------------------------
+    void Graph2D::CacheLegend(const LegendOptions& options,
+                              const std::shared_ptr<GraphItems::Label>& legend)
+        {
+        if (legend == nullptr)
+            { return; }
+        // replace what was cached with these options previously
+        // (e.g., with a different scaling)
+        m_legendCache.erase(std::remove_if(m_legendCache.begin(), m_legendCache.end(),
+            [&options](const auto& cached) noexcept
+            { return cached.m_options == options; }),
+            m_legendCache.end());
+        m_legendCache.push_back(
+            { options, GetDPIScaleFactor(), Settings::GetMaxLegendItemCount(),
+              Settings::GetMaxLegendTextLength(),
+              std::make_shared<GraphItems::Label>(*legend) });
+        }
+
     //----------------------------------------------------------------
     void Graph2D::AdjustLegendSettings(std::shared_ptr<GraphItems::Label>& legend,
                                        const LegendCanvasPlacementHint hint)
@@ -151,6 +185,7 @@ namespace Wisteria::Graphs
     void Graph2D::SetDPIScaleFactor(const double scaling)
         {
         GraphItemBase::SetDPIScaleFactor(scaling);
+        m_plotObjectsGrid.Clear();
         // set axes' DPI information
         GetLeftYAxis().SetDPIScaleFactor(scaling);
         GetRightYAxis().SetDPIScaleFactor(scaling);
@@ -389,6 +424,7 @@ namespace Wisteria::Graphs
         {
         m_currentAssignedId = 0;
         m_plotObjects.clear();
+        m_plotObjectsGrid.Clear();
 
         // If bounding box hasn't been set yet, then set it to the parent
         // canvas's size. This would only happen if trying to measure the graph
@@ -488,6 +524,7 @@ namespace Wisteria::Graphs
             GetBottomXAxis().GetAxisPointsCount() > 2)
             {
             auto xAxisLines = std::make_shared<Wisteria::GraphItems::Lines>(GetBottomXAxis().GetGridlinePen(), GetScaling());
+            xAxisLines->Reserve(GetBottomXAxis().GetAxisPointsCount() - 2);
             for (auto pos = GetBottomXAxis().GetAxisPoints().cbegin()+1;
                 pos != GetBottomXAxis().GetAxisPoints().cend()-1;
                 ++pos)
@@ -505,6 +542,7 @@ namespace Wisteria::Graphs
             GetLeftYAxis().GetAxisPointsCount() > 2)
             {
             auto yAxisLines = std::make_shared<Wisteria::GraphItems::Lines>(GetLeftYAxis().GetGridlinePen(), GetScaling());
+            yAxisLines->Reserve(GetLeftYAxis().GetAxisPointsCount() - 2);
             for (auto pos = GetLeftYAxis().GetAxisPoints().cbegin()+1;
                 pos != GetLeftYAxis().GetAxisPoints().cend()-1;
                 ++pos)
@@ -750,11 +788,33 @@ namespace Wisteria::Graphs
     //----------------------------------------------------------------
     wxRect Graph2D::Draw(wxDC& dc) const
         {
+        // If only part of the plot is being drawn (e.g., the canvas is zoomed in or only
+        // part of it is being repainted), then skip the objects outside of that area.
+        // The area is padded a little, as shadows and thick outlines can draw
+        // slightly outside of objects' bounding boxes.
+        std::optional<wxRect> drawingArea;
+        if (wxRect dcClippingRect; dc.GetClippingBox(dcClippingRect) &&
+            !dcClippingRect.IsEmpty() && !dcClippingRect.Contains(GetBoundingBox(dc)))
+            { drawingArea = dcClippingRect.Inflate(ScaleToScreenAndCanvas(10)); }
+        const auto isInDrawingArea = [&dc, &drawingArea](const GraphItems::GraphItemBase& object)
+            { return !drawingArea || object.GetBoundingBox(dc).Intersects(drawingArea.value()); };
+
+        m_lastDrawnObjectCount = m_lastCulledObjectCount = 0;
         // draw the plot objects
         for (const auto& object : m_plotObjects)
-            { object->Draw(dc); }
+            {
+            if (isInDrawingArea(*object))
+                {
+                object->Draw(dc);
+                ++m_lastDrawnObjectCount;
+                }
+            else
+                { ++m_lastCulledObjectCount; }
+            }
         for (const auto& object : m_embeddedObjects)
             {
+            // the lines to the interest points can go anywhere,
+            // so those are always drawn (there are only a few of them)
             for (const auto& interestPoint : object.m_interestPts)
                 {
                 wxPoint anchorPt, interestPt;
@@ -770,7 +830,13 @@ namespace Wisteria::Graphs
                     ln.Draw(dc);
                     }
                 }
-            object.m_object->Draw(dc);
+            if (isInDrawingArea(*object.m_object))
+                {
+                object.m_object->Draw(dc);
+                ++m_lastDrawnObjectCount;
+                }
+            else
+                { ++m_lastCulledObjectCount; }
             }
         // draw the outline
         if (IsSelected())
@@ -912,43 +978,40 @@ namespace Wisteria::Graphs
                 }
             }
         // the standard graph objects (addded via AddObject())
-        for (auto plotObject = m_plotObjects.rbegin();
-             plotObject != m_plotObjects.rend();
-             ++plotObject)
+        BuildPlotObjectsGrid(dc);
+        if (const auto hitObject = FindPlotObjectAt(pt, dc); hitObject)
             {
-            if ((*plotObject)->IsSelectable() && (*plotObject)->HitTest(pt, dc))
+            const auto& plotObject = m_plotObjects[hitObject.value()];
+            // toggle selection (or if it has subitems, then set it to selected
+            // and let it perform its own selection logic)
+            plotObject->SetSelected(
+                plotObject->GetSelectedIds().size() ? true :
+                !plotObject->IsSelected());
+            // update list of selected items
+            // (based on whether this is newly selected or just unselected)
+            if (plotObject->IsSelected())
                 {
-                // toggle selection (or if it has subitems, then set it to selected
-                // and let it perform its own selection logic)
-                (*plotObject)->SetSelected(
-                    (*plotObject)->GetSelectedIds().size() ? true :
-                    !(*plotObject)->IsSelected());
-                // update list of selected items
-                // (based on whether this is newly selected or just unselected)
-                if ((*plotObject)->IsSelected())
-                    {
-                    GetSelectedIds().insert((*plotObject)->GetId());
-                    // if object has subitems, then record that for when we
-                    // need to reselect items after recreating managed objects
-                    if ((*plotObject)->GetSelectedIds().size())
-                        {
-                        m_selectedItemsWithSubitems.insert_or_assign(
-                            (*plotObject)->GetId(), (*plotObject)->GetSelectedIds());
-                        }
-                    }
-                else
+                GetSelectedIds().insert(plotObject->GetId());
+                // if object has subitems, then record that for when we
+                // need to reselect items after recreating managed objects
+                if (plotObject->GetSelectedIds().size())
                     {
-                    // update our selection info if the object (an possibly, its subobjects)
-                    // were deselected
-                    auto unselectedItem = GetSelectedIds().find((*plotObject)->GetId());
-                    if (unselectedItem != GetSelectedIds().end())
-                        { GetSelectedIds().erase(unselectedItem); }
-                    auto unselectedItemWithSubitems = m_selectedItemsWithSubitems.find((*plotObject)->GetId());
-                    if (unselectedItemWithSubitems != m_selectedItemsWithSubitems.end())
-                        { m_selectedItemsWithSubitems.erase(unselectedItemWithSubitems); }
+                    m_selectedItemsWithSubitems.insert_or_assign(
+                        plotObject->GetId(), plotObject->GetSelectedIds());
                     }
-                return true;
                 }
+            else
+                {
+                // update our selection info if the object (an possibly, its subobjects)
+                // were deselected
+                auto unselectedItem = GetSelectedIds().find(plotObject->GetId());
+                if (unselectedItem != GetSelectedIds().end())
+                    { GetSelectedIds().erase(unselectedItem); }
+                auto unselectedItemWithSubitems = m_selectedItemsWithSubitems.find(plotObject->GetId());
+                if (unselectedItemWithSubitems != m_selectedItemsWithSubitems.end())
+                    { m_selectedItemsWithSubitems.erase(unselectedItemWithSubitems); }
+                }
+            return true;
             }
         // no items selected, so see if we at least clicked inside of the plot area
         if (HitTest(pt, dc))
@@ -958,4 +1021,65 @@ namespace Wisteria::Graphs
             }
         return false;
         }
+
+    //----------------------------------------------------------------
+    void Graph2D::BuildPlotObjectsGrid(wxDC& dc)
+        {
+        if (m_plotObjectsGrid.IsBuilt())
+            { return; }
+        std::vector<wxRect> boxes;
+        boxes.reserve(m_plotObjects.size());
+        for (const auto& plotObject : m_plotObjects)
+            { boxes.push_back(plotObject->GetBoundingBox(dc)); }
+        m_plotObjectsGrid.Build(std::move(boxes));
+        }
+
+    //----------------------------------------------------------------
+    std::optional<size_t> Graph2D::FindPlotObjectAt(const wxPoint& pt, wxDC& dc) const
+        {
+        wxASSERT_MSG(m_plotObjectsGrid.IsBuilt(),
+                     L"BuildPlotObjectsGrid() must be called before FindPlotObjectAt()!");
+        // An object can only be hit inside of its bounding box, so only the objects
+        // whose boxes contain the point need to be hit tested.
+        // Items are added to a plot FILO (i.e., painter's algorithm),
+        // so go backwards so that we find the items on top.
+        const auto candidates = m_plotObjectsGrid.FindItemsAt(pt);
+        for (auto candidate = candidates.crbegin();
+             candidate != candidates.crend();
+             ++candidate)
+            {
+            const auto& plotObject = m_plotObjects[*candidate];
+            if (plotObject->IsSelectable() && plotObject->HitTest(pt, dc))
+                { return *candidate; }
+            }
+        return std::nullopt;
+        }
+
+    //----------------------------------------------------------------
+    size_t Graph2D::GetMemoryUsage() const
+        {
+        // objects made with MakePlotObject() are in the pool; other objects (and anything
+        // that objects allocate themselves, such as their labels' text) are not counted
+        return sizeof(Graph2D) +
+            m_plotObjects.capacity() * sizeof(decltype(m_plotObjects)::value_type) +
+            m_objectPool->GetReservedBytes() +
+            m_embeddedObjects.capacity() * sizeof(EmbeddedObject) +
+            GetCachesMemoryUsage();
+        }
+
+    //----------------------------------------------------------------
+    std::vector<std::optional<long>> Graph2D::FindObjectsAtPoints(
+        const std::vector<wxPoint>& points, wxDC& dc)
+        {
+        BuildPlotObjectsGrid(dc);
+        std::vector<std::optional<long>> hitIds;
+        hitIds.reserve(points.size());
+        for (const auto& pt : points)
+            {
+            const auto hitObject = FindPlotObjectAt(pt, dc);
+            hitIds.push_back(hitObject ?
+                std::optional<long>(m_plotObjects[hitObject.value()]->GetId()) : std::nullopt);
+            }
+        return hitIds;
+        }
     }
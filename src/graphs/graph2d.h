@@ -20,6 +20,8 @@
 #include "../base/axis.h"
 #include "../base/lines.h"
 #include "../math/mathematics.h"
+#include "../util/objectpool.h"
+#include "../util/spatialgrid.h"
 
 /// @brief Classes for presenting data graphically.
 namespace Wisteria::Graphs
@@ -66,6 +68,13 @@ namespace Wisteria::Graphs
         /// @returns Which ring of a pie-like chart is the legend referring to.
         Perimeter GetRingPerimeter() const noexcept
             { return m_perimeter; }
+        /// @private
+        [[nodiscard]] bool operator==(const LegendOptions& that) const noexcept
+            {
+            return m_includeHeader == that.m_includeHeader &&
+                m_hint == that.m_hint &&
+                m_perimeter == that.m_perimeter;
+            }
     private:
         bool m_includeHeader{ false };
         LegendCanvasPlacementHint m_hint{ LegendCanvasPlacementHint::RightOfGraph };
@@ -161,10 +170,16 @@ namespace Wisteria::Graphs
             { return m_customAxes; }
         /// @returns The reference lines.
         [[nodiscard]] std::vector<Wisteria::GraphItems::ReferenceLine>& GetReferenceLines() noexcept
-            { return m_referenceLines; }
+            {
+            InvalidateLegendCache();
+            return m_referenceLines;
+            }
         /// @returns The reference areas.
         [[nodiscard]] std::vector<Wisteria::GraphItems::ReferenceArea>& GetReferenceAreas() noexcept
-            { return m_referenceAreas; }
+            {
+            InvalidateLegendCache();
+            return m_referenceAreas;
+            }
 
         /// @returns `true` if a copy of the bottom X axis is being displayed on the top of the graph.
         [[nodiscard]] bool IsXAxisMirrored() const noexcept
@@ -196,7 +211,10 @@ namespace Wisteria::Graphs
                 parallel axis for you.
             @param refLine The reference line to add.*/
         void AddReferenceLine(const Wisteria::GraphItems::ReferenceLine& refLine)
-            { m_referenceLines.push_back(refLine); }
+            {
+            m_referenceLines.push_back(refLine);
+            InvalidateLegendCache();
+            }
 
         /** @brief Adds a reference area to draw across the graph.
             @details The parent axis and starting points are specified in the composite
@@ -207,7 +225,10 @@ namespace Wisteria::Graphs
                 This is useful for instances of related events on a plot (e.g., recessions).
                 In this context, 'duplicate' means the areas have the same label and area color.*/
         void AddReferenceArea(const Wisteria::GraphItems::ReferenceArea& refArea)
-            { m_referenceAreas.push_back(refArea); }
+            {
+            m_referenceAreas.push_back(refArea);
+            InvalidateLegendCache();
+            }
         /// @}
 
         /** @name Visual Effect Functions
@@ -295,6 +316,44 @@ namespace Wisteria::Graphs
         virtual std::shared_ptr<GraphItems::Label> CreateLegend(
             const LegendOptions& options) = 0;
 
+        /** @brief Finds the objects (e.g., bars, slices, or cells) under a set of points.
+            @details This is meant for hover feedback (e.g., checking the points that the mouse
+                moved through since the last update). The plot's objects are indexed by their
+                bounding boxes once per layout, so each point is only hit tested against the
+                few objects whose boxes contain it.
+            @param points The points to look up (relative to the parent canvas).
+            @param dc The DC to measure with.
+            @returns For each point, the ID of the topmost selectable object under it,
+                or @c std::nullopt if there isn't one.
+            @note Embedded objects (see AddEmbeddedObject()) are not included.*/
+        [[nodiscard]] std::vector<std::optional<long>>
+            FindObjectsAtPoints(const std::vector<wxPoint>& points, wxDC& dc);
+
+        /** @returns The (approximate) number of bytes that the graph is using for its
+                plot objects, hit testing index, and cached legends.
+            @details Derived graphs that keep their own data (e.g., the cells of a heatmap)
+                can override this to add it.
+            @note The graph's dataset isn't included, as it is usually shared with other
+                graphs; use @c Dataset::GetMemoryUsage() for that.*/
+        [[nodiscard]] virtual size_t GetMemoryUsage() const;
+        /// @returns The (approximate) number of bytes that ReleaseCaches() would free.
+        [[nodiscard]] size_t GetCachesMemoryUsage() const
+            {
+            return m_plotObjectsGrid.GetMemoryUsage() +
+                m_legendCache.capacity() * sizeof(CachedLegend) +
+                m_legendCache.size() * sizeof(GraphItems::Label);
+            }
+        /** @brief Discards the graph's caches (i.e., its hit testing index and cached legends).
+            @details These are rebuilt when next needed, so this only frees memory.
+                Canvases call this for their graphs when the MemoryBudget is exceeded
+                (see Canvas::ReleaseCaches()).*/
+        void ReleaseCaches()
+            {
+            // (Clear() would keep the index's memory for the next build)
+            m_plotObjectsGrid = SpatialGrid{};
+            InvalidateLegendCache();
+            }
+
         // Just hiding these from Doxygen. If these are included inside of groupings,
         // then the "private" tag will break the group in the generated help.
         /// @private
@@ -327,13 +386,19 @@ namespace Wisteria::Graphs
             { return m_referenceLines; }
         /// @private
         void AddReferenceLine(Wisteria::GraphItems::ReferenceLine&& refLine)
-            { m_referenceLines.emplace_back(refLine); }
+            {
+            m_referenceLines.emplace_back(refLine);
+            InvalidateLegendCache();
+            }
         /// @private
         [[nodiscard]] const std::vector<Wisteria::GraphItems::ReferenceArea>& GetReferenceAreas() const noexcept
             { return m_referenceAreas; }
         /// @private
         void AddReferenceArea(Wisteria::GraphItems::ReferenceArea&& refArea)
-            { m_referenceAreas.emplace_back(refArea); }
+            {
+            m_referenceAreas.emplace_back(refArea);
+            InvalidateLegendCache();
+            }
         /// @private
         [[nodiscard]] const GraphItems::Label& GetTitle() const noexcept
             { return m_title; }
@@ -369,6 +434,37 @@ namespace Wisteria::Graphs
                 This is useful for multiple instances of the same event on a plot
                 (e.g., recessions).*/
         void AddReferenceLinesAndAreasToLegend(std::shared_ptr<GraphItems::Label>& legend) const;
+        /** @brief Looks for a legend that was already built with the same options.
+            @details Building a legend for a large grouping (along with measuring it afterwards)
+                is expensive, so derived graphs should check this at the start of
+                `CreateLegend()` and call CacheLegend() at the end of it.
+            @param options The options that the legend is being built with.
+            @returns A copy of the cached legend (that the caller is free to modify),
+                or null if one hasn't been built with these options since the last
+                time that the graph changed.*/
+        [[nodiscard]] std::shared_ptr<GraphItems::Label>
+            FindCachedLegend(const LegendOptions& options) const;
+        /** @brief Remembers a legend built by `CreateLegend()`, so that it can be reused
+                the next time that a legend is requested with the same options.
+            @param options The options that the legend was built with.
+            @param legend The legend (a copy of it is cached).*/
+        void CacheLegend(const LegendOptions& options,
+                         const std::shared_ptr<GraphItems::Label>& legend);
+        /** @brief Discards any cached legends.
+            @details Derived graphs should call this whenever anything shown on their
+                legends changes (e.g., their data or color scheme), or when they return
+                something that the client can use to change that.*/
+        void InvalidateLegendCache() noexcept
+            { m_legendCache.clear(); }
+        /** @brief Discards the cached legends for one ring of a pie-like chart.
+            @param perimeter The ring whose legends should be discarded.*/
+        void InvalidateLegendCache(const Perimeter perimeter)
+            {
+            m_legendCache.erase(std::remove_if(m_legendCache.begin(), m_legendCache.end(),
+                [perimeter](const auto& cached) noexcept
+                { return cached.m_options.GetRingPerimeter() == perimeter; }),
+                m_legendCache.end());
+            }
         /// @returns A non-const version of the parent canvas.
         /// @details This should be used in derived classes when needing to call
         ///     `Canvas::CalcAllSizes()` or `Canvas::SetCanvasMinHeightDIPs()`.
@@ -385,15 +481,39 @@ namespace Wisteria::Graphs
                 {
                 object->SetId(m_currentAssignedId++);
                 object->SetDPIScaleFactor(GetDPIScaleFactor());
-                m_plotObjects.push_back(object);
+                m_plotObjects.push_back(std::move(object));
+                m_plotObjectsGrid.Clear();
                 }
             }
+        /** @brief Creates an object (e.g., a polygon) for the plot from the plot's object pool.
+            @details Plots create (and then discard) many small objects every time that they are
+                laid out, so these are allocated from a pool that lives with the plot,
+                and the next layout reuses their memory.
+            @param args The arguments to pass to the object's constructor.
+            @returns The new object, which will usually be passed to AddObject().
+            @note The object keeps the pool alive, so it is safe for it to outlive the plot.*/
+        template<typename T, typename... Args>
+        [[nodiscard]] std::shared_ptr<T> MakePlotObject(Args&&... args)
+            {
+            return std::allocate_shared<T>(ObjectPoolAllocator<T>(m_objectPool),
+                                           std::forward<Args>(args)...);
+            }
         void SetDPIScaleFactor(const double scaling) override;
 
         /** @brief Draws the plot.
             @param dc The DC to draw to.
             @returns The bounding box of the plot.*/
         wxRect Draw(wxDC& dc) const override;
+        /** @returns The number of plot objects (e.g., bars, points, and embedded labels)
+                drawn by the last call to Draw().
+            @note Objects outside of the area being drawn (e.g., when the canvas is zoomed in)
+                are skipped and not included in this count; see GetLastCulledObjectCount().*/
+        [[nodiscard]] size_t GetLastDrawnObjectCount() const noexcept
+            { return m_lastDrawnObjectCount; }
+        /// @returns The number of plot objects skipped by the last call to Draw()
+        ///     because they were outside of the area being drawn.
+        [[nodiscard]] size_t GetLastCulledObjectCount() const noexcept
+            { return m_lastCulledObjectCount; }
         /// @returns The rectangle on the canvas where the point would fit in.
         /// @param dc Measurement DC, which is not used in this implementation.
         [[nodiscard]] wxRect GetBoundingBox([[maybe_unused]] wxDC& dc) const final
@@ -482,6 +602,7 @@ namespace Wisteria::Graphs
                 }
             m_rect.Offset(wxPoint(xToMove, yToMove));
             m_plotRect.Offset(wxPoint(xToMove, yToMove));
+            m_plotObjectsGrid.Clear();
             }
         /** @brief Draws the items label (if it has one) in the middle of the item if it is selected.
             @param dc The canvas to draw the item on.
@@ -505,6 +626,24 @@ namespace Wisteria::Graphs
                     { object.m_object->SetSelected(false); }
                 }
             }
+        /// @returns @c true if the plot or any of its objects are selected.
+        [[nodiscard]] bool HasSelections() const final
+            {
+            if (IsSelected())
+                { return true; }
+            for (const auto& object : m_plotObjects)
+                {
+                if (object->HasSelections() || object->GetSelectedIds().size())
+                    { return true; }
+                }
+            for (const auto& object : m_embeddedObjects)
+                {
+                if (object.m_object != nullptr &&
+                    object.m_object->HasSelections())
+                    { return true; }
+                }
+            return false;
+            }
         /** @brief Sets whether the plot is selected.
             @param selected Whether the last hit subobject should be selected.*/
         void SetSelected(const bool selected) final
@@ -526,6 +665,15 @@ namespace Wisteria::Graphs
             @note This will toggle the selection of an object, if it was selected before
                 then it will become unselected.*/
         [[nodiscard]] bool SelectObjectAtPoint(const wxPoint& pt, wxDC& dc) final;
+        /// @brief Indexes the plot objects' bounding boxes, if not already indexed
+        ///     since the last layout.
+        void BuildPlotObjectsGrid(wxDC& dc);
+        /** @returns The index of the topmost selectable plot object at a point,
+                or @c std::nullopt if there isn't one.
+            @param pt The point to hit test.
+            @param dc The DC to measure with.
+            @note BuildPlotObjectsGrid() must be called first.*/
+        [[nodiscard]] std::optional<size_t> FindPlotObjectAt(const wxPoint& pt, wxDC& dc) const;
         /// @brief Calculates how much outer axis labels and headers go outside of the
         ///     axes' widths and heights (used to adjust the margins of the plot area).
         void GetAxesOverhang(long& leftMargin, long& rightMargin, long& topMargin, long& bottomMargin,
@@ -540,6 +688,11 @@ namespace Wisteria::Graphs
         bool m_mirrorXAxis{ false };
         bool m_mirrorYAxis{ false };
         std::vector<std::shared_ptr<GraphItems::GraphItemBase>> m_plotObjects;
+        // index of the plot objects' bounding boxes (for hit testing),
+        // built on the first hit test after a layout
+        SpatialGrid m_plotObjectsGrid;
+        // where plot objects created with MakePlotObject() get their memory
+        std::shared_ptr<ObjectPool> m_objectPool{ std::make_shared<ObjectPool>() };
         std::vector<EmbeddedObject> m_embeddedObjects;
         GraphItems::Label m_title;
         GraphItems::Label m_subtitle;
@@ -562,8 +715,21 @@ namespace Wisteria::Graphs
         std::vector<Wisteria::GraphItems::Axis> m_customAxes;
         std::vector<Wisteria::GraphItems::ReferenceLine> m_referenceLines;
         std::vector<Wisteria::GraphItems::ReferenceArea> m_referenceAreas;
+        /// @brief A legend built by a derived graph, along with everything it was built with.
+        struct CachedLegend
+            {
+            LegendOptions m_options;
+            double m_dpiScaleFactor{ 1 };
+            size_t m_maxItemCount{ 0 };
+            size_t m_maxTextLength{ 0 };
+            std::shared_ptr<GraphItems::Label> m_legend;
+            };
+        std::vector<CachedLegend> m_legendCache;
         mutable size_t m_lastHitPointIndex{ static_cast<size_t>(-1) };
         mutable size_t m_lastHitPointEmbeddedObjectIndex{ static_cast<size_t>(-1) };
+        // render statistics from the last call to Draw()
+        mutable size_t m_lastDrawnObjectCount{ 0 };
+        mutable size_t m_lastCulledObjectCount{ 0 };
 
         // cached values
         long m_calculatedTopPadding{ 0 };
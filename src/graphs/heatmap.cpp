@@ -8,6 +8,8 @@
 
 #include "heatmap.h"
 #include "../util/frequency_set.h"
+#include <execution>
+#include <numeric>
 
 using namespace Wisteria::Colors;
 using namespace Wisteria::GraphItems;
@@ -38,6 +40,7 @@ namespace Wisteria::Graphs
             { return; }
 
         m_data = data;
+        InvalidateLegendCache();
         GetSelectedIds().clear();
         m_useGrouping = groupColumnName.has_value();
         m_groupColumn = (groupColumnName ? m_data->GetCategoricalColumn(groupColumnName.value()) :
@@ -55,6 +58,7 @@ namespace Wisteria::Graphs
             }
         m_groupColumnCount = (groupColumnCount ? std::clamp<size_t>(groupColumnCount.value(), 1, 5) : 1);
         m_matrix.clear();
+        m_cellBlocks.clear();
         m_range = { 0, 0 };
 
         if (m_data->GetContinuousColumns().size() == 0)
@@ -68,17 +72,20 @@ namespace Wisteria::Graphs
         m_reversedColorSpectrum = m_colorSpectrum->GetColors();
         std::reverse(m_reversedColorSpectrum.begin(), m_reversedColorSpectrum.end());
 
+        // map the values to a precomputed table of colors,
+        // rather than interpolating a color for every cell
         ColorBrewer cb;
         cb.SetColorScale(m_colorSpectrum->GetColors().cbegin(), m_colorSpectrum->GetColors().cend());
-        const auto cellColors = cb.BrewColors(m_continuousColumn->GetValues().cbegin(),
-                                              m_continuousColumn->GetValues().cend());
+        m_cellColors = cb.BrewColorTable(CELL_COLOR_COUNT);
+        const auto cellColorIndices = cb.BrewColorIndices(m_continuousColumn->GetValues().cbegin(),
+                                                          m_continuousColumn->GetValues().cend(),
+                                                          CELL_COLOR_COUNT);
         m_range = cb.GetRange();
-
-        const wxString crossedOutSymbolForNaN{ L"\x274C" };
         if (m_useGrouping)
             {
             // see how many groups there are
-            frequency_set<Data::GroupIdType> groups;
+            frequency_set<Data::GroupIdType, std::less<Data::GroupIdType>,
+                          frequency_storage::dense_storage> groups;
             for (const auto& groupId : m_groupColumn->GetValues())
                 { groups.insert(groupId); }
             // if more columns than groups, then fix the column count
@@ -93,7 +100,7 @@ namespace Wisteria::Graphs
 
             size_t currentRow{ 0 }, currentColumn{ 0 };
             auto currentGroupId = m_groupColumn->GetValue(0);
-            for (size_t i = 0; i < cellColors.size(); ++i)
+            for (size_t i = 0; i < cellColorIndices.size(); ++i)
                 {
                 // move to next row if on another group ID
                 if (m_groupColumn->GetValue(i) != currentGroupId)
@@ -118,14 +125,8 @@ namespace Wisteria::Graphs
                 // shouldn't happen, just done as sanity check
                 if (currentRow >= m_matrix.size() || currentColumn >= m_matrix[currentRow].size())
                     { break; }
-                m_matrix[currentRow][currentColumn].m_color = cellColors[i];
-                m_matrix[currentRow][currentColumn].m_valueLabel =
-                    (std::isnan(m_continuousColumn->GetValue(i)) ?
-                        crossedOutSymbolForNaN :
-                        wxNumberFormatter::ToString(m_continuousColumn->GetValue(i), 1,
-                            Settings::GetDefaultNumberFormat()));
-                m_matrix[currentRow][currentColumn].m_selectionLabel = m_data->GetIdColumn().GetValue(i);
-                m_matrix[currentRow][currentColumn].m_groupId = m_groupColumn->GetValue(i);
+                m_matrix[currentRow][currentColumn].m_row = i;
+                m_matrix[currentRow][currentColumn].m_colorIndex = cellColorIndices[i];
                 ++currentColumn;
                 }
             }
@@ -144,7 +145,7 @@ namespace Wisteria::Graphs
                 { row.resize(cellColumnCount); }
 
             size_t currentRow{ 0 }, currentColumn{ 0 };
-            for (size_t i = 0; i < cellColors.size(); ++i)
+            for (size_t i = 0; i < cellColorIndices.size(); ++i)
                 {
                 // move to next row, if needed
                 if (currentColumn >= cellColumnCount)
@@ -159,15 +160,8 @@ namespace Wisteria::Graphs
                 // shouldn't happen, just done as sanity check
                 if (currentRow >= m_matrix.size() || currentColumn >= m_matrix[currentRow].size())
                     { break; }
-                m_matrix[currentRow][currentColumn].m_color = cellColors[i];
-                m_matrix[currentRow][currentColumn].m_valueLabel =
-                    (std::isnan(m_continuousColumn->GetValue(i)) ?
-                        crossedOutSymbolForNaN :
-                        wxNumberFormatter::ToString(m_continuousColumn->GetValue(i), 1,
-                            Settings::GetDefaultNumberFormat()));
-                m_matrix[currentRow][currentColumn].m_selectionLabel = m_data->GetIdColumn().GetValue(i);
-                // ignored, just default to zero
-                m_matrix[currentRow][currentColumn].m_groupId = 0;
+                m_matrix[currentRow][currentColumn].m_row = i;
+                m_matrix[currentRow][currentColumn].m_colorIndex = cellColorIndices[i];
                 ++currentColumn;
                 }
             }
@@ -176,6 +170,8 @@ namespace Wisteria::Graphs
     //----------------------------------------------------------------
     void HeatMap::RecalcSizes(wxDC& dc)
         {
+        m_cellBlocks.clear();
+        m_drawingAsRaster = false;
         // if no data then bail
         if (m_data == nullptr || m_data->GetRowCount() == 0 || m_matrix.size() == 0)
             { return; }
@@ -281,12 +277,29 @@ namespace Wisteria::Graphs
                                 std::min(safe_divide<wxCoord>(drawArea.GetHeight(), m_matrix.size()),
                                          safe_divide<wxCoord>(drawArea.GetWidth(), std::max<size_t>(m_matrix[0].size(), 5)) );
 
+        // Large heat maps are written into an image instead of having boxes and labels for each cell.
+        // Here, the cells don't need to be whole pixels; and if they are smaller than a pixel,
+        // then there is no point keeping them square, so stretch them to fill the area.
+        m_drawingAsRaster = (m_continuousColumn->GetRowCount() > GetRasterCellThreshold());
+        double cellWidth{ static_cast<double>(boxWidth) }, cellHeight{ static_cast<double>(boxWidth) };
+        if (m_drawingAsRaster)
+            {
+            const double rowsPerBlock = m_useGrouping ? maxRowsWhenGrouping : m_matrix.size();
+            const double columnsPerBlock = (m_useGrouping && m_groupColumnCount > 1) ?
+                m_matrix[0].size() : std::max<size_t>(m_matrix[0].size(), 5);
+            cellWidth = safe_divide<double>(drawArea.GetWidth(), columnsPerBlock);
+            cellHeight = safe_divide<double>(drawArea.GetHeight(), rowsPerBlock);
+            if (std::min(cellWidth, cellHeight) >= 1)
+                { cellWidth = cellHeight = std::min(cellWidth, cellHeight); }
+            }
+        const wxCoord rowHeight = std::max<wxCoord>(cellHeight, 1);
+
         // get the best font size to fit the row labels
         wxFont groupLabelFont{ GetBottomXAxis().GetFont() };
         groupLabelFont.SetPointSize(// fit font as best possible
             Label::CalcFontSizeToFitBoundingBox(
                 dc, groupLabelFont,
-                wxSize(widestLabelWidth-ScaleToScreenAndCanvas(labelRightPadding), boxWidth),
+                wxSize(widestLabelWidth-ScaleToScreenAndCanvas(labelRightPadding), rowHeight),
                 widestStr));
         // and the labels on the boxes
         wxFont boxLabelFont{ GetBottomXAxis().GetFont() };
@@ -298,6 +311,7 @@ namespace Wisteria::Graphs
                     Settings::GetDefaultNumberFormat())));
 
         // draw the boxes in a grid, row x column
+        const wxString crossedOutSymbolForNaN{ L"\x274C" };
         wxPoint pts[4];
         size_t currentRow{ 0 }, currentColumn{ 0 };
         size_t currentGroupdStart{ 0 };
@@ -306,6 +320,29 @@ namespace Wisteria::Graphs
         const wxString singleGroupHeaderFormatString = (groupHeaderLabelMultiline ? L"%s\n%zu" : L"%s %zu");
         for (const auto& row : m_matrix)
             {
+            // starting a new column of groups (or the only block of cells, if not grouping)
+            if (currentRow == 0)
+                {
+                const size_t blockRowCount = m_useGrouping ?
+                    std::min<size_t>(maxRowsWhenGrouping, m_matrix.size() - currentGroupdStart) :
+                    m_matrix.size();
+                CellBlock block{ wxRect(drawArea.GetTopLeft(),
+                                        wxSize(std::lround(row.size() * cellWidth),
+                                               std::lround(blockRowCount * cellHeight))),
+                                 currentGroupdStart, blockRowCount, cellWidth, cellHeight };
+                if (m_drawingAsRaster && !block.m_rect.IsEmpty())
+                    {
+                    auto cellsImage = std::make_shared<Image>(
+                        GraphItemInfo().Pen(wxNullPen).Selectable(false).
+                        AnchorPoint(block.m_rect.GetTopLeft()),
+                        RasterizeCells(block));
+                    cellsImage->SetAnchoring(Anchoring::TopLeftCorner);
+                    AddObject(cellsImage);
+                    }
+                // keep the block relative to the plot area, in case the plot is moved later
+                block.m_rect.Offset(-GetPlotAreaBoundingBox().GetTopLeft());
+                m_cellBlocks.push_back(block);
+                }
             if (currentRow == 0 && IsShowingGroupHeaders() && m_useGrouping && m_matrix.size() > 1)
                 {
                 // If only one group in column, then don't show that as a range;
@@ -333,14 +370,22 @@ namespace Wisteria::Graphs
             // then the column's cells
             for (const auto& cell : row)
                 {
-                // if no label on cell, then that means this row is jagged and there
-                // are no more cells in it, so go to next row
-                if (cell.m_valueLabel.empty())
+                // already drawn as an image
+                if (m_drawingAsRaster)
+                    { break; }
+                // if no data connected to the cell, then that means this row is jagged and
+                // there are no more cells in it, so go to next row
+                if (cell.m_row == EMPTY_CELL)
                     { continue; }
-                // if NaN, then color will be bogus, so use plot's background color
-                const wxColour cellColor = cell.m_color.IsOk() ?
-                                               cell.m_color :
+                // if NaN, then there is no color, so use plot's background color
+                const bool isCellColorOk = (cell.m_colorIndex < m_cellColors.size());
+                const wxColour cellColor = isCellColorOk ?
+                                               m_cellColors[cell.m_colorIndex] :
                                                wxTransparentColor;
+                const double cellValue = m_continuousColumn->GetValue(cell.m_row);
+                const wxString cellValueLabel = std::isnan(cellValue) ?
+                    crossedOutSymbolForNaN :
+                    wxNumberFormatter::ToString(cellValue, 1, Settings::GetDefaultNumberFormat());
 
                 pts[0] = wxPoint(drawArea.GetTopLeft().x+(boxWidth*currentColumn),
                                  drawArea.GetTopLeft().y+(currentRow*boxWidth));
@@ -352,7 +397,7 @@ namespace Wisteria::Graphs
                                  drawArea.GetTopLeft().y+(currentRow*boxWidth));
                 // keep scaling at 1 since this is set to a specific size on the plot
                 auto box = std::make_shared<GraphItems::Polygon>(
-                    GraphItems::GraphItemInfo(cell.m_selectionLabel).
+                    GraphItems::GraphItemInfo(m_data->GetIdColumn().GetValue(cell.m_row)).
                     Pen(GetPen()).Brush(cellColor),
                     pts, std::size(pts));
                 const wxRect boxRect(pts[0], pts[2]);
@@ -360,11 +405,11 @@ namespace Wisteria::Graphs
                 AddObject(box);
                 // show the value of the cell, centered on it
                 AddObject(std::make_shared<GraphItems::Label>(
-                    GraphItemInfo(cell.m_valueLabel).Font(boxLabelFont).
+                    GraphItemInfo(cellValueLabel).Font(boxLabelFont).
                     Pen(wxNullPen).Selectable(false).
                     FontColor(
                         // contrast colors, unless this cell is NaN
-                        (cell.m_color.IsOk() ?
+                        (isCellColorOk ?
                             ColorContrast::BlackOrWhiteContrast(cellColor) :
                             // if NaN, then set 'X' to red
                             ColorContrast::ShadeOrTintIfClose(*wxRED, cellColor))).
@@ -382,13 +427,14 @@ namespace Wisteria::Graphs
                     // font is already scaled, so leave the label's scaling at 1.0
                     Font(groupLabelFont).
                     AnchorPoint(wxPoint(drawArea.GetTopLeft().x -
-                                        groupLabelWidth, drawArea.GetTopLeft().y+(currentRow*boxWidth))).
+                                        groupLabelWidth,
+                                        drawArea.GetTopLeft().y + std::lround(currentRow*cellHeight))).
                     Pen(wxNullPen).
                     Padding(0, labelRightPadding, 0, 0).
                     LabelPageVerticalAlignment(PageVerticalAlignment::Centered));
                 groupRowLabel->SetMinimumUserSizeDIPs(
                     dc.ToDIP(groupLabelWidth),
-                    dc.ToDIP(boxWidth));
+                    dc.ToDIP(rowHeight));
                 AddObject(groupRowLabel);
                 }
 
@@ -406,9 +452,90 @@ namespace Wisteria::Graphs
             }
         }
 
+    //----------------------------------------------------------------
+    wxImage HeatMap::RasterizeCells(const CellBlock& block) const
+        {
+        wxImage cellsImage(block.m_rect.GetSize(), false);
+        cellsImage.InitAlpha();
+        uint8_t* rgb = cellsImage.GetData();
+        uint8_t* alpha = cellsImage.GetAlpha();
+        const size_t imageWidth = cellsImage.GetWidth();
+        const size_t columnCount = m_matrix[block.m_firstRow].size();
+
+        // which cell each pixel column and row lands on (sampled at the pixel's center)
+        std::vector<size_t> pixelColumns(imageWidth);
+        for (size_t x = 0; x < pixelColumns.size(); ++x)
+            {
+            pixelColumns[x] = std::min<size_t>((x + 0.5) / block.m_cellWidth, columnCount - 1);
+            }
+        std::vector<size_t> pixelRows(cellsImage.GetHeight());
+        for (size_t y = 0; y < pixelRows.size(); ++y)
+            {
+            pixelRows[y] = block.m_firstRow +
+                std::min<size_t>((y + 0.5) / block.m_cellHeight, block.m_rowCount - 1);
+            }
+
+        const auto fillRow = [&](const size_t y)
+            {
+            const auto& row = m_matrix[pixelRows[y]];
+            uint8_t* rgbPos = rgb + (y * imageWidth * 3);
+            uint8_t* alphaPos = alpha + (y * imageWidth);
+            for (size_t x = 0; x < imageWidth; ++x, rgbPos += 3, ++alphaPos)
+                {
+                const auto& cell = row[pixelColumns[x]];
+                // empty cells and missing data are left transparent
+                if (cell.m_row == EMPTY_CELL || cell.m_colorIndex >= m_cellColors.size())
+                    {
+                    rgbPos[0] = rgbPos[1] = rgbPos[2] = 0;
+                    *alphaPos = wxALPHA_TRANSPARENT;
+                    continue;
+                    }
+                const wxColour& cellColor = m_cellColors[cell.m_colorIndex];
+                rgbPos[0] = cellColor.Red();
+                rgbPos[1] = cellColor.Green();
+                rgbPos[2] = cellColor.Blue();
+                *alphaPos = cellColor.Alpha();
+                }
+            };
+
+        // each pixel row is independent, so fill large images in parallel
+        std::vector<size_t> imageRows(pixelRows.size());
+        std::iota(imageRows.begin(), imageRows.end(), 0);
+        if (imageWidth * imageRows.size() >= 1024 * 1024)
+            { std::for_each(std::execution::par, imageRows.cbegin(), imageRows.cend(), fillRow); }
+        else
+            { std::for_each(imageRows.cbegin(), imageRows.cend(), fillRow); }
+
+        return cellsImage;
+        }
+
+    //----------------------------------------------------------------
+    std::optional<size_t> HeatMap::GetDataRowAtPoint(const wxPoint pt) const
+        {
+        const wxPoint plotPt = pt - GetPlotAreaBoundingBox().GetTopLeft();
+        for (const auto& block : m_cellBlocks)
+            {
+            if (!block.m_rect.Contains(plotPt) || block.m_cellWidth <= 0 || block.m_cellHeight <= 0)
+                { continue; }
+            const size_t matrixRow = block.m_firstRow +
+                std::min<size_t>((plotPt.y - block.m_rect.GetTop()) / block.m_cellHeight,
+                                 block.m_rowCount - 1);
+            const auto& row = m_matrix[matrixRow];
+            const size_t matrixColumn =
+                std::min<size_t>((plotPt.x - block.m_rect.GetLeft()) / block.m_cellWidth,
+                                 row.size() - 1);
+            if (row[matrixColumn].m_row == EMPTY_CELL)
+                { return std::nullopt; }
+            return row[matrixColumn].m_row;
+            }
+        return std::nullopt;
+        }
+
     //----------------------------------------------------------------
     std::shared_ptr<GraphItems::Label> HeatMap::CreateLegend(const LegendOptions& options)
         {
+        if (auto cachedLegend = FindCachedLegend(options); cachedLegend != nullptr)
+            { return cachedLegend; }
         if (m_data == nullptr || m_continuousColumn->GetRowCount() == 0)
             { return nullptr; }
 
@@ -440,6 +567,7 @@ namespace Wisteria::Graphs
 
         AddReferenceLinesAndAreasToLegend(legend);
         AdjustLegendSettings(legend, options.GetPlacementHint());
+        CacheLegend(options, legend);
         return legend;
         }
     }
@@ -182,6 +182,39 @@ namespace Wisteria::Graphs
             { return m_showGroupHeaders; }
         /// @}
 
+        /** @name Raster Functions
+            @brief Functions related to drawing large heat maps as images.
+            @details When a heat map has more cells than the raster threshold,
+                its cells are written directly into an image (at the plot's resolution),
+                rather than being added as individual boxes with value labels.
+                This is much faster for large heat maps (where the cells
+                would be too small to read anyway).\n
+                When drawn this way, cells with missing data are transparent
+                (instead of showing a red 'X'). Also, once the cells would be smaller than
+                a pixel, they are stretched to fill the plot area (rather than being square).*/
+        /// @{
+
+        /// @returns The number of cells above which the heat map is drawn as an image.
+        [[nodiscard]] size_t GetRasterCellThreshold() const noexcept
+            { return m_rasterCellThreshold; }
+        /** @brief Sets the number of cells above which the heat map is drawn as an image.
+            @param cellCount The cell count. Set to @c 0 to always draw as an image, or
+                `std::numeric_limits<size_t>::max()` to never draw as an image.*/
+        void SetRasterCellThreshold(const size_t cellCount) noexcept
+            { m_rasterCellThreshold = cellCount; }
+        /// @returns @c true if the heat map's cells were drawn as an image
+        ///     the last time that it was laid out.
+        [[nodiscard]] bool IsDrawingAsRaster() const noexcept
+            { return m_drawingAsRaster; }
+        /** @brief Finds the cell at a given point.
+            @details This works arithmetically from the cells' layout (in either drawing mode),
+                so it is suitable for tooltips and other frequent hit testing.
+            @param pt The point (relative to the parent canvas).
+            @returns The row in the dataset of the cell at @c pt, or @c std::nullopt
+                if there is no cell there.*/
+        [[nodiscard]] std::optional<size_t> GetDataRowAtPoint(const wxPoint pt) const;
+        /// @}
+
         /** @brief Builds and returns a legend.
             @details This can be then be managed by the parent canvas and placed next to the plot.
             @param options The options for how to build the legend.
@@ -201,14 +234,36 @@ namespace Wisteria::Graphs
     private:
         void RecalcSizes(wxDC& dc) final;
 
+        /// @brief The row of a cell that isn't connected to any data
+        ///     (i.e., padding at the end of a jagged row).
+        static constexpr size_t EMPTY_CELL{ std::numeric_limits<size_t>::max() };
+        /// @brief The number of colors in the lookup table that cells' colors are mapped to.
+        static constexpr size_t CELL_COLOR_COUNT{ 1024 };
+        // A cell is just its row in the data and an index into the color lookup table;
+        // its labels are built from the data when the cells are drawn.
         struct HeatCell
             {
-            wxString m_valueLabel;
-            wxString m_selectionLabel;
-            wxColour m_color;
-            Data::GroupIdType m_groupId{ 0 };
+            size_t m_row{ EMPTY_CELL };
+            uint16_t m_colorIndex{ Colors::ColorBrewer::INVALID_COLOR_INDEX };
             };
         std::vector<std::vector<HeatCell>> m_matrix;
+        // where a column of grouped (or all of the ungrouped) matrix rows were laid out,
+        // used to map points back to cells
+        struct CellBlock
+            {
+            wxRect m_rect;
+            size_t m_firstRow{ 0 };
+            size_t m_rowCount{ 0 };
+            double m_cellWidth{ 0 };
+            double m_cellHeight{ 0 };
+            };
+        // writes a block of cells directly into an image
+        [[nodiscard]] wxImage RasterizeCells(const CellBlock& block) const;
+        std::vector<CellBlock> m_cellBlocks;
+        size_t m_rasterCellThreshold{ 10'000 };
+        bool m_drawingAsRaster{ false };
+        // lookup table for the cells' colors
+        std::vector<wxColour> m_cellColors;
         std::shared_ptr<Colors::Schemes::ColorScheme> m_colorSpectrum;
         std::vector<wxColour> m_reversedColorSpectrum; // used for the legend
         [[nodiscard]] const std::shared_ptr<const Data::Dataset>& GetData() const noexcept
@@ -8,6 +8,7 @@
 
 #include "histogram.h"
 #include "../util/frequency_set.h"
+#include "../util/numberformatcache.h"
 #include "../math/statistics.h"
 
 using namespace Wisteria::GraphItems;
@@ -34,6 +35,7 @@ namespace Wisteria::Graphs
         m_useGrouping = groupColumnName.has_value();
         m_groupIds.clear();
         GetSelectedIds().clear();
+        InvalidateLegendCache();
         m_binningMethod = bMethod;
         m_roundingMethod = rounding;
         m_intervalDisplay = iDisplay;
@@ -61,7 +63,11 @@ namespace Wisteria::Graphs
                 continuousColumnName).ToUTF8());
             }
 
-        m_validN = statistics::valid_n(m_continuousColumn->GetValues());
+        // valid N and range of the data, in a single pass
+        const auto valuesSummary = statistics::parallel_aggregate(m_continuousColumn->GetValues());
+        m_validN = valuesSummary.n;
+        m_minValue = valuesSummary.minimum;
+        m_maxValue = valuesSummary.maximum;
 
         // see if we should use grouping from the data
         if (m_useGrouping)
@@ -82,7 +88,7 @@ namespace Wisteria::Graphs
             }
 
         // if 4 or less unique values, might as well use unique values instead of ranges
-        if (CalcUniqueValuesCount() <= 4)
+        if (!HasMoreUniqueValuesThan(4))
             { SetBinningMethod(BinningMethod::BinUniqueValues); }
 
         if (GetBinningMethod() == BinningMethod::BinUniqueValues)
@@ -97,6 +103,165 @@ namespace Wisteria::Graphs
         GetScalingAxis().GetTitle().SetText(_(L"Frequency"));
         }
 
+    //----------------------------------------------------------------
+    void Histogram::SetBinnedData(std::shared_ptr<const Data::Dataset> data,
+                                  const wxString& binStartColumnName,
+                                  const wxString& binEndColumnName,
+                                  const wxString& countColumnName,
+                                  const std::optional<const wxString> groupColumnName /*= std::nullopt*/,
+                                  const IntervalDisplay iDisplay /*= IntervalDisplay::Cutpoints*/,
+                                  const BinLabelDisplay blDisplay /*= BinLabelDisplay::BinValue*/)
+        {
+        if (data == nullptr)
+            { return; }
+
+        m_data = data;
+        m_useGrouping = groupColumnName.has_value();
+        m_groupIds.clear();
+        GetSelectedIds().clear();
+        InvalidateLegendCache();
+        // the bins are explicit ranges, so these are not applicable
+        m_binningMethod = BinningMethod::BinByRange;
+        m_roundingMethod = RoundingMethod::NoRounding;
+        m_intervalDisplay = iDisplay;
+        m_binLabelDisplay = blDisplay;
+        m_displayFullRangeOfValues = true;
+        m_startBinsValue = std::nullopt;
+        m_continuousColumn = m_data->GetContinuousColumns().cend();
+
+        m_groupColumn = (groupColumnName ?
+            m_data->GetCategoricalColumn(groupColumnName.value()) :
+            m_data->GetCategoricalColumns().cend());
+        if (groupColumnName && m_groupColumn == m_data->GetCategoricalColumns().cend())
+            {
+            throw std::runtime_error(wxString::Format(
+                _(L"'%s': group column not found for histogram."),
+                groupColumnName.value()).ToUTF8());
+            }
+        const auto findContinuousColumn = [this](const wxString& columnName)
+            {
+            const auto column = m_data->GetContinuousColumn(columnName);
+            if (column == m_data->GetContinuousColumns().cend())
+                {
+                throw std::runtime_error(wxString::Format(
+                    _(L"'%s': continuous column not found for histogram."),
+                    columnName).ToUTF8());
+                }
+            return column;
+            };
+        const auto binStartColumn = findContinuousColumn(binStartColumnName);
+        const auto binEndColumn = findContinuousColumn(binEndColumnName);
+        const auto countColumn = findContinuousColumn(countColumnName);
+
+        // reset everything first
+        ClearBars();
+        m_validN = 0;
+        m_minValue = m_maxValue = std::numeric_limits<double>::quiet_NaN();
+
+        // review the bins' ranges, all of which must be the same width
+        std::optional<double> binSize;
+        // counts may be fractional (e.g., weighted), so total them before rounding
+        double totalCount{ 0 };
+        for (size_t i = 0; i < m_data->GetRowCount(); ++i)
+            {
+            const double binStart = binStartColumn->GetValue(i);
+            const double binEnd = binEndColumn->GetValue(i);
+            const double binCount = countColumn->GetValue(i);
+            if (std::isnan(binStart) || std::isnan(binEnd) || std::isnan(binCount))
+                { continue; }
+            if (binEnd <= binStart)
+                {
+                throw std::runtime_error(wxString::Format(
+                    _(L"Bin %s-%s: the end of a histogram bin must be greater than its start."),
+                    wxNumberFormatter::ToString(binStart, 6,
+                        wxNumberFormatter::Style::Style_NoTrailingZeroes),
+                    wxNumberFormatter::ToString(binEnd, 6,
+                        wxNumberFormatter::Style::Style_NoTrailingZeroes)).ToUTF8());
+                }
+            if (binCount < 0)
+                {
+                throw std::runtime_error(wxString::Format(
+                    _(L"Bin %s-%s: histogram bin counts cannot be negative."),
+                    wxNumberFormatter::ToString(binStart, 6,
+                        wxNumberFormatter::Style::Style_NoTrailingZeroes),
+                    wxNumberFormatter::ToString(binEnd, 6,
+                        wxNumberFormatter::Style::Style_NoTrailingZeroes)).ToUTF8());
+                }
+            if (!binSize)
+                { binSize = binEnd - binStart; }
+            else if (!compare_doubles(binSize.value(), binEnd - binStart, 1e-6))
+                {
+                throw std::runtime_error(
+                    _(L"Pre-binned histogram data must have bins of the same width.").ToUTF8());
+                }
+            m_minValue = std::isnan(m_minValue) ? binStart : std::min(m_minValue, binStart);
+            m_maxValue = std::isnan(m_maxValue) ? binEnd : std::max(m_maxValue, binEnd);
+            totalCount += binCount;
+            if (m_useGrouping)
+                { m_groupIds.insert(m_groupColumn->GetValue(i)); }
+            }
+        m_validN = static_cast<size_t>(std::llround(totalCount));
+
+        // if no data then just draw a blank 10x10 grid
+        if (!binSize)
+            {
+            GetScalingAxis().SetRange(0, 10, 0, 1, 1);
+            GetBarAxis().SetRange(0, 10, 0, 1, 1);
+            m_binCount = 0;
+            return;
+            }
+
+        // add the counts to their bins (and groups within them),
+        // with the groups in the order that they appear in the data
+        const auto numOfBins = static_cast<size_t>(
+            std::round(safe_divide(m_maxValue - m_minValue, binSize.value())));
+        RangeBins bins(numOfBins);
+        for (size_t i = 0; i < m_data->GetRowCount(); ++i)
+            {
+            const double binStart = binStartColumn->GetValue(i);
+            const double binCount = countColumn->GetValue(i);
+            if (std::isnan(binStart) || std::isnan(binEndColumn->GetValue(i)) ||
+                std::isnan(binCount))
+                { continue; }
+            const double binPosition = safe_divide(binStart - m_minValue, binSize.value());
+            // bins must line up with each other (gaps between them are OK though)
+            if (!compare_doubles(binPosition, std::round(binPosition), 1e-6))
+                {
+                throw std::runtime_error(
+                    _(L"Pre-binned histogram data must have bins that line up with each other.").ToUTF8());
+                }
+            const auto bin = std::min(static_cast<size_t>(std::round(binPosition)), numOfBins - 1);
+            const Data::GroupIdType groupId = m_useGrouping ? m_groupColumn->GetValue(i) : 0;
+            auto block = std::find_if(bins[bin].begin(), bins[bin].end(),
+                [groupId](const auto& binBlock) noexcept
+                { return binBlock.first == groupId; });
+            if (block == bins[bin].end())
+                {
+                bins[bin].emplace_back(
+                    comparable_first_pair(groupId,
+                        BinObservations(binCount, std::set<wxString, Data::StringCmpNoCase>{})));
+                }
+            else
+                { block->second.first += binCount; }
+            }
+        // drop empty blocks, as they would just be empty selection labels
+        for (auto& currentBin : bins)
+            {
+            currentBin.erase(std::remove_if(currentBin.begin(), currentBin.end(),
+                [](const auto& binBlock) noexcept
+                { return binBlock.second.first == 0; }),
+                currentBin.end());
+            }
+
+        AddRangeBars(bins, m_minValue, binSize.value(), false);
+
+        GetBarAxis().ShowOuterLabels(false);
+
+        // set axis labels
+        GetBarAxis().GetTitle().SetText(binStartColumn->GetTitle());
+        GetScalingAxis().GetTitle().SetText(_(L"Frequency"));
+        }
+
     //----------------------------------------------------------------
     wxString Histogram::GetCustomBarLabelOrValue(const double& value,
                                                  const size_t precision /*= 0*/)
@@ -106,26 +271,37 @@ namespace Wisteria::Graphs
             { return customLabel.GetText(); }
         else
             {
-            return wxNumberFormatter::ToString(value, precision,
+            return NumberFormatCache::ToString(value, static_cast<int>(precision),
                 Settings::GetDefaultNumberFormat());
             }
         }
 
     //----------------------------------------------------------------
-    size_t Histogram::CalcUniqueValuesCount() const
+    bool Histogram::HasMoreUniqueValuesThan(const size_t count) const
         {
         if (m_data == nullptr)
-            { return 0; }
+            { return false; }
 
-        frequency_set<double> groups;
-        for (size_t i = 0; i < m_data->GetRowCount(); ++i)
+        // only a handful of values need to be remembered, so a small (unsorted) list will do
+        std::vector<double> uniqueValues;
+        uniqueValues.reserve(count + 1);
+        // read the values one at a time, so that narrowed columns don't need a widened copy
+        for (size_t i = 0; i < m_continuousColumn->GetRowCount(); ++i)
             {
-            if (!std::isnan(m_continuousColumn->GetValue(i)))
+            const auto value = m_continuousColumn->GetValue(i);
+            if (std::isnan(value))
+                { continue; }
+            const auto sortableValue = ConvertToSortableValue(value);
+            if (std::find(uniqueValues.cbegin(), uniqueValues.cend(), sortableValue) ==
+                uniqueValues.cend())
                 {
-                groups.insert(ConvertToSortableValue(m_continuousColumn->GetValue(i)));
+                uniqueValues.push_back(sortableValue);
+                // no need to review the rest of the data
+                if (uniqueValues.size() > count)
+                    { return true; }
                 }
             }
-        return groups.get_data().size();
+        return false;
         }
 
     //----------------------------------------------------------------
@@ -273,12 +449,9 @@ namespace Wisteria::Graphs
         {
         if (m_data == nullptr || m_validN == 0)
             { return; }
-        double minVal = *std::min_element(
-            m_continuousColumn->GetValues().cbegin(),
-            m_continuousColumn->GetValues().cend());
-        double maxVal = *std::max_element(
-            m_continuousColumn->GetValues().cbegin(),
-            m_continuousColumn->GetValues().cend());
+        // calculated (along with the valid N) when the data was set
+        double minVal = m_minValue;
+        double maxVal = m_maxValue;
         // If data fails into a small range (e.g., < 2), then forcibly turn off rounding and integer binning.
         // Make sure that the range is larger than 0 though (otherwise there will probably just be one bin
         // and integer mode would be better there).
@@ -335,75 +508,84 @@ namespace Wisteria::Graphs
         if (GetBinningMethod() == BinningMethod::BinByIntegerRange)
             { wxASSERT(!has_fractional_part(BinSize)); }
 
-        // calculate how many observations are in each group
-        using valuesCounter = std::pair<double, std::set<wxString, Data::StringCmpNoCase>>;
-        std::vector<std::vector<comparable_first_pair<Data::GroupIdType, valuesCounter>>> bins(numOfBins);
-        for (size_t i = 0; i < m_data->GetRowCount(); ++i)
+        // the (zero-based) index of each row's group (in the order of the group IDs)
+        const std::vector<Data::GroupIdType> groupIds = m_useGrouping ?
+            std::vector<Data::GroupIdType>(m_groupIds.cbegin(), m_groupIds.cend()) :
+            std::vector<Data::GroupIdType>{ 0 };
+        const size_t groupCount = groupIds.size();
+        const auto groupOf = [this, &groupIds](const size_t row) noexcept
+            {
+            return m_useGrouping ?
+                static_cast<size_t>(std::lower_bound(groupIds.cbegin(), groupIds.cend(),
+                                                     m_groupColumn->GetValue(row)) -
+                                    groupIds.cbegin()) :
+                0;
+            };
+
+        // calculate how many observations are in each bin (and group within it).
+        // Note that the low value in the data goes into the first bin, even if it is actually
+        // less than the bin's range (right on the edge). This prevents us from making an extra
+        // bin just for this one value.
+        const auto blockCounts = statistics::parallel_grouped_histogram(
+            m_continuousColumn->GetValues(), minVal, BinSize, numOfBins, groupCount, groupOf,
+            [this](const double value) { return ConvertToSortableValue(value); });
+
+        // add the blocks to the bins (in the order that they first appear in the data)
+        // and collect the first few observation labels for each block's selection label,
+        // stopping once every block has all of the labels that it can show
+        RangeBins bins(numOfBins);
+        constexpr auto BLOCK_NOT_ADDED{ static_cast<size_t>(-1) };
+        std::vector<size_t> blockPositions(blockCounts.size(), BLOCK_NOT_ADDED);
+        std::vector<size_t> blockRowsRead(blockCounts.size(), 0);
+        auto incompleteBlocks = static_cast<size_t>(
+            std::count_if(blockCounts.cbegin(), blockCounts.cend(),
+                [](const auto count) noexcept { return count > 0; }));
+        for (size_t i = 0; i < m_data->GetRowCount() && incompleteBlocks > 0; ++i)
             {
             if (std::isnan(m_continuousColumn->GetValue(i)))
                 { continue; }
-
-            for (size_t j = 0; j < bins.size(); ++j)
+            const size_t bin = statistics::upper_inclusive_bin_index(
+                ConvertToSortableValue(m_continuousColumn->GetValue(i)), minVal, BinSize, numOfBins);
+            if (bin >= numOfBins)
+                { continue; }
+            const size_t group = groupOf(i);
+            const size_t block = (bin * groupCount) + group;
+            if (blockPositions[block] == BLOCK_NOT_ADDED)
                 {
-                const double currentVal = ConvertToSortableValue(m_continuousColumn->GetValue(i));
-                /* Logic is a little different for the first bin. The low value in the data needs to
-                   go into this bin, even if it is actually less than the bin's range (right on the edge).
-                   This prevents us from making an extra bin just for this one value.*/
-                if (compare_doubles(currentVal, minVal))
-                    {
-                    auto foundGroup = std::find(bins[0].begin(), bins[0].end(),
-                        comparable_first_pair((m_useGrouping ? m_groupColumn->GetValue(i) : 0),
-                            valuesCounter(0.0, std::set<wxString, Data::StringCmpNoCase>{})));
-                    if (foundGroup != bins[0].end())
-                        {
-                        ++foundGroup->second.first;
-                        if (foundGroup->second.second.size() < Settings::GetMaxObservationInBin())
-                            { foundGroup->second.second.emplace(m_data->GetIdColumn().GetValue(i)); }
-                        }
-                    else
-                        {
-                        std::set<wxString, Data::StringCmpNoCase> theSet;
-                        theSet.emplace(m_data->GetIdColumn().GetValue(i).c_str());
-                        bins[0].emplace_back(
-                            comparable_first_pair((m_useGrouping ? m_groupColumn->GetValue(i) : 0),
-                                valuesCounter(1.0, theSet)));
-                        }
-                    break;
-                    }
-                else if (compare_doubles_greater(currentVal, (minVal+(j*BinSize))) &&
-                    compare_doubles_less_or_equal(currentVal, (minVal+(j*BinSize)+BinSize)))
-                    {
-                    auto foundGroup = std::find(bins[j].begin(), bins[j].end(),
-                        comparable_first_pair((m_useGrouping ? m_groupColumn->GetValue(i) : 0),
-                            valuesCounter(0.0, std::set<wxString, Data::StringCmpNoCase>{})));
-                    if (foundGroup != bins[j].end())
-                        {
-                        ++foundGroup->second.first;
-                        if (foundGroup->second.second.size() < Settings::GetMaxObservationInBin())
-                            { foundGroup->second.second.emplace(m_data->GetIdColumn().GetValue(i)); }
-                        }
-                    else
-                        {
-                        std::set<wxString, Data::StringCmpNoCase> theSet;
-                        theSet.emplace(m_data->GetIdColumn().GetValue(i).c_str());
-                        bins[j].emplace_back(
-                            comparable_first_pair((m_useGrouping ?
-                                m_groupColumn->GetValue(i) :
-                                static_cast<Data::GroupIdType>(0)), valuesCounter(1, theSet)));
-                        }
-                    break;
-                    }
+                blockPositions[block] = bins[bin].size();
+                bins[bin].emplace_back(
+                    comparable_first_pair(groupIds[group],
+                        BinObservations(static_cast<double>(blockCounts[block]),
+                                        std::set<wxString, Data::StringCmpNoCase>{})));
                 }
+            // already read everything for this block that will be shown
+            if (blockRowsRead[block] == blockCounts[block])
+                { continue; }
+            ++blockRowsRead[block];
+            auto& observationLabels = bins[bin][blockPositions[block]].second.second;
+            if (observationLabels.size() < Settings::GetMaxObservationInBin())
+                { observationLabels.emplace(m_data->GetIdColumn().GetValue(i)); }
+            if (observationLabels.size() >= Settings::GetMaxObservationInBin())
+                { blockRowsRead[block] = blockCounts[block]; }
+            if (blockRowsRead[block] == blockCounts[block])
+                { --incompleteBlocks; }
             }
 
-        const double startingBarAxisPosition = minVal + safe_divide<double>(BinSize,2);
+        AddRangeBars(bins, minVal, BinSize, isLowestValueBeingAdjusted);
+        }
+
+    //----------------------------------------------------------------
+    void Histogram::AddRangeBars(RangeBins& bins, const double minVal, const double binSize,
+                                 const bool isLowestValueBeingAdjusted)
+        {
+        const double startingBarAxisPosition = minVal + safe_divide<double>(binSize,2);
         // if the starting point or interval size has floating precision then set the axis to show it
         if (GetBinningMethod() != BinningMethod::BinByIntegerRange &&
-            (has_fractional_part(startingBarAxisPosition) || has_fractional_part(BinSize)))
+            (has_fractional_part(startingBarAxisPosition) || has_fractional_part(binSize)))
             { GetBarAxis().SetPrecision(4); }
         else
             { GetBarAxis().SetPrecision(0); }
-        GetBarAxis().SetInterval(BinSize);
+        GetBarAxis().SetInterval(binSize);
 
         // tally up the total group counts
         double total = 0;
@@ -428,11 +610,11 @@ namespace Wisteria::Graphs
         bool firstBinWithValuesFound = false;
         for (size_t i = 0; i < bins.size(); ++i)
             {
-            Bar theBar(startingBarAxisPosition+(i*BinSize),
+            Bar theBar(startingBarAxisPosition+(i*binSize),
                 std::vector<BarBlock>(),
                 wxEmptyString, GraphItems::Label(),
                 GetBarEffect(), GetBarOpacity(),
-                (GetIntervalDisplay() == IntervalDisplay::Cutpoints) ? BinSize : 0);
+                (GetIntervalDisplay() == IntervalDisplay::Cutpoints) ? binSize : 0);
 
             // build the bar from its blocks (i.e., subgroups)
             double currentBarBlocksTotal{ 0 };
@@ -493,8 +675,8 @@ namespace Wisteria::Graphs
                    starting after the cutpoint.*/
                 const double startValue = (i == 0) ?
                     isLowestValueBeingAdjusted ? minVal+1 : minVal :
-                        minVal+1+(i*BinSize);
-                const double endValue = minVal+(i*BinSize)+BinSize;
+                        minVal+1+(i*binSize);
+                const double endValue = minVal+(i*binSize)+binSize;
                 wxString axisLabel;
                 if (startValue == endValue)
                     { axisLabel += GetCustomBarLabelOrValue(startValue); }
@@ -505,20 +687,20 @@ namespace Wisteria::Graphs
                     }
                 if (GetIntervalDisplay() == IntervalDisplay::Midpoints)
                     {
-                    GetBarAxis().SetCustomLabel(startingBarAxisPosition+(i*BinSize),
+                    GetBarAxis().SetCustomLabel(startingBarAxisPosition+(i*binSize),
                                                 GraphItems::Label(axisLabel));
                     }
                 }
             else
                 {
                 const wxString axisLabel = ((i == 0) ? L">= " : L"> ") +
-                    wxNumberFormatter::ToString(minVal+(i*BinSize), 6,
+                    wxNumberFormatter::ToString(minVal+(i*binSize), 6,
                         wxNumberFormatter::Style::Style_NoTrailingZeroes) + _(L" and <= ") +
-                    wxNumberFormatter::ToString(minVal+(i*BinSize)+BinSize, 6,
+                    wxNumberFormatter::ToString(minVal+(i*binSize)+binSize, 6,
                         wxNumberFormatter::Style::Style_NoTrailingZeroes);
                 if (GetIntervalDisplay() == IntervalDisplay::Midpoints)
                     {
-                    GetBarAxis().SetCustomLabel(startingBarAxisPosition+(i*BinSize),
+                    GetBarAxis().SetCustomLabel(startingBarAxisPosition+(i*binSize),
                                                 GraphItems::Label(axisLabel));
                     }
                 }
@@ -555,15 +737,10 @@ namespace Wisteria::Graphs
         // Scott
         else
             {
-            const auto minVal = *std::min_element(
-                m_continuousColumn->GetValues().cbegin(),
-                m_continuousColumn->GetValues().cend());
-            const auto maxVal = *std::max_element(
-                m_continuousColumn->GetValues().cbegin(),
-                m_continuousColumn->GetValues().cend());
+            // the range was already found (ignoring missing data) in SetData()
             const auto sd = statistics::standard_deviation(
                 m_continuousColumn->GetValues(), true);
-            return safe_divide(maxVal - minVal,
+            return safe_divide(m_maxValue - m_minValue,
                 3.5 * safe_divide(sd, std::cbrt(m_validN)) );
             }
         }
@@ -586,6 +763,8 @@ namespace Wisteria::Graphs
     //----------------------------------------------------------------
     std::shared_ptr<GraphItems::Label> Histogram::CreateLegend(const LegendOptions& options)
         {
+        if (auto cachedLegend = FindCachedLegend(options); cachedLegend != nullptr)
+            { return cachedLegend; }
         if (m_data == nullptr || GetGroupCount() == 0)
             { return nullptr; }
 
@@ -625,6 +804,7 @@ namespace Wisteria::Graphs
 
         AddReferenceLinesAndAreasToLegend(legend);
         AdjustLegendSettings(legend, options.GetPlacementHint());
+        CacheLegend(options, legend);
         return legend;
         }
     }
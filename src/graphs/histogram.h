@@ -257,6 +257,37 @@ namespace Wisteria::Graphs
                      const std::pair<std::optional<size_t>, std::optional<size_t>> binCountRanges =
                         std::make_pair(std::nullopt, std::nullopt));
 
+        /** @brief Sets pre-binned data (i.e., bin ranges and their counts that were
+                calculated elsewhere, such as by a database query).
+            @details Each row in the dataset is a bin (or, if using grouping, a group's
+             portion of a bin). Rows with the same bin range (and group) are combined.\n
+             The bins are displayed the same way as data binned by SetData()
+             (using range binning), but the raw observations are not needed.
+            @param data The data to use for the histogram.
+            @param binStartColumnName The column containing the start of each bin's range.
+            @param binEndColumnName The column containing the end of each bin's range.
+            @param countColumnName The column containing the number of observations in each bin.
+            @param groupColumnName The group column to split the bins (i.e., bars) into
+             (this is optional).
+            @param iDisplay The interval display to use.
+            @param blDisplay Which type of labels to display for the bars.
+            @throws std::runtime_error If any columns can't be found by name, if any bins
+             are of different widths (or do not line up with each other), or if any counts
+             are negative, throws an exception.\n
+             The exception's @c what() message is UTF-8 encoded, so pass it to @c wxString::FromUTF8()
+             when formatting it for an error message.
+            @note Rows with missing data in any of the bin columns are ignored.\n
+             \n
+             Because there are no observations, the bars' selection labels will only show
+             their counts.*/
+        void SetBinnedData(std::shared_ptr<const Data::Dataset> data,
+                           const wxString& binStartColumnName,
+                           const wxString& binEndColumnName,
+                           const wxString& countColumnName,
+                           const std::optional<const wxString> groupColumnName = std::nullopt,
+                           const IntervalDisplay iDisplay = IntervalDisplay::Cutpoints,
+                           const BinLabelDisplay blDisplay = BinLabelDisplay::BinValue);
+
         /** @brief Gets the number of bins/cells in the histogram with data in them.
             @note This refers to the number of cells with data in them, not the number
              slots along the axis that a cell/bar could appear.
@@ -369,8 +400,11 @@ namespace Wisteria::Graphs
         ///  start at where the data begins.
         [[nodiscard]] std::optional<double> GetBinsStart() const noexcept
             { return m_startBinsValue; }
-        /// @returns The number of unique values.
-        [[nodiscard]] size_t CalcUniqueValuesCount() const;
+        /// @returns @c true if there are more unique values than the specified count.
+        /// @param count The number of unique values to check for.
+        /// @note This stops reviewing the data as soon as it finds more than @c count
+        ///     unique values.
+        [[nodiscard]] bool HasMoreUniqueValuesThan(const size_t count) const;
         /** @brief Creates a bin for each unique value in the data.
             @param binCount If there are too many categories and sorting needs to be switched
              to ranges, then this is an optional number of bins to use.
@@ -382,6 +416,20 @@ namespace Wisteria::Graphs
             @details This is recommended if you have a lot of data and want to
              break data into categories.*/
         void SortIntoRanges(const std::optional<size_t> binCount);
+        /// @brief A block's count and the (first few) observations in it.
+        using BinObservations = std::pair<double, std::set<wxString, Data::StringCmpNoCase>>;
+        /// @brief The blocks (by group) in each bin.
+        using RangeBins =
+            std::vector<std::vector<comparable_first_pair<Data::GroupIdType, BinObservations>>>;
+        /** @brief Builds bars from range bins, along with their labels and the bar axis
+                (e.g., interval labels).
+            @param bins The bins. Trailing empty bins will be removed.
+            @param minVal The start of the first bin.
+            @param binSize The width of the bins.
+            @param isLowestValueBeingAdjusted Whether the lowest value was rounded down
+             (and the first bin was added for it).*/
+        void AddRangeBars(RangeBins& bins, const double minVal, const double binSize,
+                          const bool isLowestValueBeingAdjusted);
         /// @brief Call this when sorting data (in case it needs to be rounded).
         ///  If rounding is turned off then this simply returns the same value.
         [[nodiscard]] double ConvertToSortableValue(const double& value) const;
@@ -396,6 +444,8 @@ namespace Wisteria::Graphs
         std::vector<Wisteria::Data::ColumnWithStringTable>::const_iterator m_groupColumn;
         std::vector<Wisteria::Data::Column<double>>::const_iterator m_continuousColumn;
         size_t m_validN{ 0 };
+        double m_minValue{ std::numeric_limits<double>::quiet_NaN() };
+        double m_maxValue{ std::numeric_limits<double>::quiet_NaN() };
 
         BinningMethod m_binningMethod{ BinningMethod::BinByIntegerRange };
         RoundingMethod m_roundingMethod{ RoundingMethod::NoRounding };
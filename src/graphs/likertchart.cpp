@@ -163,6 +163,7 @@ namespace Wisteria::Graphs
         wxASSERT_LEVEL_2_MSG(std::max_element(condensedCodes.cbegin(),
                                               condensedCodes.cend())->first == 2,
                                               L"String table should end at 2!");
+        const auto recodeTable = GetSimplifiedCodes(LikertSurveyQuestionFormat::FourPoint);
         for (const auto& catColumnName : questionColumns)
             {
             auto categoricalColumn = data->GetCategoricalColumn(catColumnName);
@@ -174,11 +175,8 @@ namespace Wisteria::Graphs
             wxASSERT_LEVEL_2_MSG(*std::max_element(categoricalColumn->GetValues().cbegin(),
                 categoricalColumn->GetValues().cend()) <= 4,
                 L"Categorical codes shouldn't be higher than 4!");
-            // collapse both degrees of "negative" into one
-            categoricalColumn->Recode(2, 1);
-            // collapse both degrees of "positive" into one
-            categoricalColumn->Recode(3, 2);
-            categoricalColumn->Recode(4, 2);
+            // collapse both degrees of "negative" and "positive" into one (in one pass)
+            categoricalColumn->Recode(recodeTable);
             // use the simpler string table
             categoricalColumn->GetStringTable() = condensedCodes;
             }
@@ -196,6 +194,7 @@ namespace Wisteria::Graphs
         wxASSERT_LEVEL_2_MSG(std::max_element(condensedCodes.cbegin(),
                                               condensedCodes.cend())->first == 2,
                                               L"String table should end at 2!");
+        const auto recodeTable = GetSimplifiedCodes(LikertSurveyQuestionFormat::SixPoint);
         for (const auto& catColumnName : questionColumns)
             {
             auto categoricalColumn = data->GetCategoricalColumn(catColumnName);
@@ -207,13 +206,8 @@ namespace Wisteria::Graphs
             wxASSERT_LEVEL_2_MSG(*std::max_element(categoricalColumn->GetValues().cbegin(),
                 categoricalColumn->GetValues().cend()) <= 6,
                 L"Categorical codes shouldn't be higher than 6!");
-            // collapse all degrees of "negative" into one
-            categoricalColumn->Recode(2, 1);
-            categoricalColumn->Recode(3, 1);
-            // collapse all degrees of "positive" into one
-            categoricalColumn->Recode(4, 2);
-            categoricalColumn->Recode(5, 2);
-            categoricalColumn->Recode(6, 2);
+            // collapse all degrees of "negative" and "positive" into one (in one pass)
+            categoricalColumn->Recode(recodeTable);
             // use the simpler string table
             categoricalColumn->GetStringTable() = condensedCodes;
             }
@@ -231,6 +225,7 @@ namespace Wisteria::Graphs
         wxASSERT_LEVEL_2_MSG(std::max_element(condensedCodes.cbegin(),
                                               condensedCodes.cend())->first == 3,
                                               L"String table should end at 3!");
+        const auto recodeTable = GetSimplifiedCodes(LikertSurveyQuestionFormat::FivePoint);
         for (const auto& catColumnName : questionColumns)
             {
             auto categoricalColumn = data->GetCategoricalColumn(catColumnName);
@@ -242,13 +237,9 @@ namespace Wisteria::Graphs
             wxASSERT_LEVEL_2_MSG(*std::max_element(categoricalColumn->GetValues().cbegin(),
                 categoricalColumn->GetValues().cend()) <= 5,
                 L"Categorical codes shouldn't be higher than 5!");
-            // collapse both degrees of "negative" into one
-            categoricalColumn->Recode(2, 1);
-            // old neutral code
-            categoricalColumn->Recode(3, 2);
-            // collapse both degrees of "positive" into one
-            categoricalColumn->Recode(4, 3);
-            categoricalColumn->Recode(5, 3);
+            // collapse both degrees of "negative" and "positive" into one
+            // and move the old neutral code (in one pass)
+            categoricalColumn->Recode(recodeTable);
             // use the simpler string table
             categoricalColumn->GetStringTable() = condensedCodes;
             }
@@ -266,6 +257,7 @@ namespace Wisteria::Graphs
         wxASSERT_LEVEL_2_MSG(std::max_element(condensedCodes.cbegin(),
                                               condensedCodes.cend())->first == 3,
                                               L"String table should end at 3!");
+        const auto recodeTable = GetSimplifiedCodes(LikertSurveyQuestionFormat::SevenPoint);
         for (const auto& catColumnName : questionColumns)
             {
             auto categoricalColumn = data->GetCategoricalColumn(catColumnName);
@@ -277,20 +269,132 @@ namespace Wisteria::Graphs
             wxASSERT_LEVEL_2_MSG(*std::max_element(categoricalColumn->GetValues().cbegin(),
                 categoricalColumn->GetValues().cend()) <= 7,
                 L"Categorical codes shouldn't be higher than 7!");
-            // collapse all three degrees of "negative" into one
-            categoricalColumn->Recode(2, 1);
-            categoricalColumn->Recode(3, 1);
-            // old neutral code
-            categoricalColumn->Recode(4, 2);
-            // collapse all three degrees of "positive" into one
-            categoricalColumn->Recode(5, 3);
-            categoricalColumn->Recode(6, 3);
-            categoricalColumn->Recode(7, 3);
+            // collapse all three degrees of "negative" and "positive" into one
+            // and move the old neutral code (in one pass)
+            categoricalColumn->Recode(recodeTable);
             // use the simpler string table
             categoricalColumn->GetStringTable() = condensedCodes;
             }
         }
 
+    //-----------------------------------
+    LikertChart::LikertSurveyQuestionFormat LikertChart::GetSimplifiedFormat(
+        const LikertSurveyQuestionFormat format) noexcept
+        {
+        switch (MakeFormatUncategorized(format))
+            {
+        case LikertSurveyQuestionFormat::SevenPoint:
+            [[fallthrough]];
+        case LikertSurveyQuestionFormat::FivePoint:
+            [[fallthrough]];
+        case LikertSurveyQuestionFormat::ThreePoint:
+            return IsCategorized(format) ?
+                LikertSurveyQuestionFormat::ThreePointCategorized :
+                LikertSurveyQuestionFormat::ThreePoint;
+        default:
+            return IsCategorized(format) ?
+                LikertSurveyQuestionFormat::TwoPointCategorized :
+                LikertSurveyQuestionFormat::TwoPoint;
+            };
+        }
+
+    //-----------------------------------
+    LikertChart::ResponseCodeTable LikertChart::GetSimplifiedCodes(
+        const LikertSurveyQuestionFormat format)
+        {
+        switch (MakeFormatUncategorized(format))
+            {
+        // 0 = no response, 1-3 = negative, 4 = neutral, 5-7 = positive
+        case LikertSurveyQuestionFormat::SevenPoint:
+            return { 0, 1, 1, 1, 2, 3, 3, 3 };
+        // 0 = no response, 1-3 = negative, 4-6 = positive
+        case LikertSurveyQuestionFormat::SixPoint:
+            return { 0, 1, 1, 1, 2, 2, 2 };
+        // 0 = no response, 1-2 = negative, 3 = neutral, 4-5 = positive
+        case LikertSurveyQuestionFormat::FivePoint:
+            return { 0, 1, 1, 2, 3, 3 };
+        // 0 = no response, 1-2 = negative, 3-4 = positive
+        case LikertSurveyQuestionFormat::FourPoint:
+            return { 0, 1, 1, 2, 2 };
+        // already as simple as it gets
+        default:
+            return ResponseCodeTable{};
+            };
+        }
+
+    //-----------------------------------
+    LikertChart::ResponseCounts LikertChart::CollapseResponses(const ResponseCounts& counts) const
+        {
+        if (m_simplifiedCodes.empty())
+            { return counts; }
+        ResponseCounts collapsedCounts{ 0 };
+        for (size_t code = 0; code < counts.size(); ++code)
+            {
+            const auto newCode = (code < m_simplifiedCodes.size()) ? m_simplifiedCodes[code] : code;
+            collapsedCounts[newCode] += counts[code];
+            }
+        return collapsedCounts;
+        }
+
+    //-----------------------------------
+    LikertChart::ResponseCounts LikertChart::TabulateResponses(
+        const Data::ColumnWithStringTable& responses) const
+        {
+        ResponseCounts counts{ 0 };
+        for (const auto& code : responses.GetValues())
+            {
+            // codes outside of the scale are ignored
+            if (code < counts.size())
+                { ++counts[code]; }
+            }
+        return CollapseResponses(counts);
+        }
+
+    //-----------------------------------
+    std::vector<std::pair<Data::GroupIdType, LikertChart::ResponseCounts>>
+        LikertChart::TabulateResponses(const Data::ColumnWithStringTable& groups,
+                                       const Data::ColumnWithStringTable& responses) const
+        {
+        const auto& groupIds = groups.GetValues();
+        const auto& codes = responses.GetValues();
+        std::vector<std::pair<Data::GroupIdType, ResponseCounts>> groupCounts;
+        if (groupIds.empty())
+            { return groupCounts; }
+
+        // Group IDs are usually a small range of codes from a string table,
+        // so count into an array of them. Otherwise, fall back to a map.
+        const auto maxGroupId = *std::max_element(groupIds.cbegin(), groupIds.cend());
+        if (maxGroupId <= groupIds.size())
+            {
+            std::vector<ResponseCounts> denseCounts(maxGroupId + 1, ResponseCounts{ 0 });
+            std::vector<bool> hasGroup(maxGroupId + 1, false);
+            for (size_t i = 0; i < groupIds.size(); ++i)
+                {
+                hasGroup[groupIds[i]] = true;
+                if (codes[i] < std::tuple_size_v<ResponseCounts>)
+                    { ++denseCounts[groupIds[i]][codes[i]]; }
+                }
+            for (size_t groupId = 0; groupId < denseCounts.size(); ++groupId)
+                {
+                if (hasGroup[groupId])
+                    { groupCounts.emplace_back(groupId, CollapseResponses(denseCounts[groupId])); }
+                }
+            }
+        else
+            {
+            std::map<Data::GroupIdType, ResponseCounts> sparseCounts;
+            for (size_t i = 0; i < groupIds.size(); ++i)
+                {
+                auto [groupPos, inserted] = sparseCounts.try_emplace(groupIds[i], ResponseCounts{ 0 });
+                if (codes[i] < std::tuple_size_v<ResponseCounts>)
+                    { ++groupPos->second[codes[i]]; }
+                }
+            for (const auto& [groupId, counts] : sparseCounts)
+                { groupCounts.emplace_back(groupId, CollapseResponses(counts)); }
+            }
+        return groupCounts;
+        }
+
     //-----------------------------------
     Data::ColumnWithStringTable::StringTableType LikertChart::CreateLabels(
         const LikertChart::LikertSurveyQuestionFormat& type)
@@ -625,6 +729,28 @@ namespace Wisteria::Graphs
         else
             { m_surveyType = MakeFormatUncategorized(m_surveyType); }
 
+        // if simplifying, then collapse the responses as they are tabulated
+        // (rather than editing the data) and use the simpler scale's stock labels
+        m_simplifiedCodes.clear();
+        if (IsSimplifyingScale())
+            {
+            m_simplifiedCodes = GetSimplifiedCodes(m_surveyType);
+            m_surveyType = GetSimplifiedFormat(m_surveyType);
+            }
+        const auto simplifiedLabels = IsSimplifyingScale() ?
+            CreateLabels(m_surveyType) : Data::ColumnWithStringTable::StringTableType{};
+        const auto getResponseLabel =
+            [this, &simplifiedLabels](const Data::ColumnWithStringTable& responses,
+                                      const Data::GroupIdType code) -> wxString
+            {
+            if (IsSimplifyingScale())
+                {
+                const auto foundPos = simplifiedLabels.find(code);
+                return (foundPos != simplifiedLabels.cend()) ? foundPos->second : wxString{};
+                }
+            return responses.GetCategoryLabelFromID(code);
+            };
+
         // go in reverse order so that the first to last questions go from top-to-bottom
         for (auto questionIter = questionColumns.crbegin();
              questionIter != questionColumns.crend();
@@ -650,53 +776,53 @@ namespace Wisteria::Graphs
             if (GetSurveyType() == LikertSurveyQuestionFormat::TwoPoint ||
                 GetSurveyType() == LikertSurveyQuestionFormat::TwoPointCategorized)
                 {
-                SetNegativeLabel(categoricalColumn->GetCategoryLabelFromID(1), 1);
-                SetPositiveLabel(categoricalColumn->GetCategoryLabelFromID(2), 1);
+                SetNegativeLabel(getResponseLabel(*categoricalColumn, 1), 1);
+                SetPositiveLabel(getResponseLabel(*categoricalColumn, 2), 1);
                 }
             else if (GetSurveyType() == LikertSurveyQuestionFormat::ThreePoint ||
                 GetSurveyType() == LikertSurveyQuestionFormat::ThreePointCategorized)
                 {
-                SetNegativeLabel(categoricalColumn->GetCategoryLabelFromID(1), 1);
-                SetNeutralLabel(categoricalColumn->GetCategoryLabelFromID(2));
-                SetPositiveLabel(categoricalColumn->GetCategoryLabelFromID(3), 1);
+                SetNegativeLabel(getResponseLabel(*categoricalColumn, 1), 1);
+                SetNeutralLabel(getResponseLabel(*categoricalColumn, 2));
+                SetPositiveLabel(getResponseLabel(*categoricalColumn, 3), 1);
                 }
             else if (GetSurveyType() == LikertSurveyQuestionFormat::FourPoint ||
                 GetSurveyType() == LikertSurveyQuestionFormat::FourPointCategorized)
                 {
-                SetNegativeLabel(categoricalColumn->GetCategoryLabelFromID(1), 1);
-                SetNegativeLabel(categoricalColumn->GetCategoryLabelFromID(2), 2);
-                SetPositiveLabel(categoricalColumn->GetCategoryLabelFromID(3), 1);
-                SetPositiveLabel(categoricalColumn->GetCategoryLabelFromID(4), 2);
+                SetNegativeLabel(getResponseLabel(*categoricalColumn, 1), 1);
+                SetNegativeLabel(getResponseLabel(*categoricalColumn, 2), 2);
+                SetPositiveLabel(getResponseLabel(*categoricalColumn, 3), 1);
+                SetPositiveLabel(getResponseLabel(*categoricalColumn, 4), 2);
                 }
             else if (GetSurveyType() == LikertSurveyQuestionFormat::FivePoint ||
                 GetSurveyType() == LikertSurveyQuestionFormat::FivePointCategorized)
                 {
-                SetNegativeLabel(categoricalColumn->GetCategoryLabelFromID(1), 1);
-                SetNegativeLabel(categoricalColumn->GetCategoryLabelFromID(2), 2);
-                SetNeutralLabel(categoricalColumn->GetCategoryLabelFromID(3));
-                SetPositiveLabel(categoricalColumn->GetCategoryLabelFromID(4), 1);
-                SetPositiveLabel(categoricalColumn->GetCategoryLabelFromID(5), 2);
+                SetNegativeLabel(getResponseLabel(*categoricalColumn, 1), 1);
+                SetNegativeLabel(getResponseLabel(*categoricalColumn, 2), 2);
+                SetNeutralLabel(getResponseLabel(*categoricalColumn, 3));
+                SetPositiveLabel(getResponseLabel(*categoricalColumn, 4), 1);
+                SetPositiveLabel(getResponseLabel(*categoricalColumn, 5), 2);
                 }
             else if (GetSurveyType() == LikertSurveyQuestionFormat::SixPoint ||
                 GetSurveyType() == LikertSurveyQuestionFormat::SixPointCategorized)
                 {
-                SetNegativeLabel(categoricalColumn->GetCategoryLabelFromID(1), 1);
-                SetNegativeLabel(categoricalColumn->GetCategoryLabelFromID(2), 2);
-                SetNegativeLabel(categoricalColumn->GetCategoryLabelFromID(3), 3);
-                SetPositiveLabel(categoricalColumn->GetCategoryLabelFromID(4), 1);
-                SetPositiveLabel(categoricalColumn->GetCategoryLabelFromID(5), 2);
-                SetPositiveLabel(categoricalColumn->GetCategoryLabelFromID(6), 3);
+                SetNegativeLabel(getResponseLabel(*categoricalColumn, 1), 1);
+                SetNegativeLabel(getResponseLabel(*categoricalColumn, 2), 2);
+                SetNegativeLabel(getResponseLabel(*categoricalColumn, 3), 3);
+                SetPositiveLabel(getResponseLabel(*categoricalColumn, 4), 1);
+                SetPositiveLabel(getResponseLabel(*categoricalColumn, 5), 2);
+                SetPositiveLabel(getResponseLabel(*categoricalColumn, 6), 3);
                 }
             else if (GetSurveyType() == LikertSurveyQuestionFormat::SevenPoint ||
                 GetSurveyType() == LikertSurveyQuestionFormat::SevenPointCategorized)
                 {
-                SetNegativeLabel(categoricalColumn->GetCategoryLabelFromID(1), 1);
-                SetNegativeLabel(categoricalColumn->GetCategoryLabelFromID(2), 2);
-                SetNegativeLabel(categoricalColumn->GetCategoryLabelFromID(3), 3);
-                SetNeutralLabel(categoricalColumn->GetCategoryLabelFromID(4));
-                SetPositiveLabel(categoricalColumn->GetCategoryLabelFromID(5), 1);
-                SetPositiveLabel(categoricalColumn->GetCategoryLabelFromID(6), 2);
-                SetPositiveLabel(categoricalColumn->GetCategoryLabelFromID(7), 3);
+                SetNegativeLabel(getResponseLabel(*categoricalColumn, 1), 1);
+                SetNegativeLabel(getResponseLabel(*categoricalColumn, 2), 2);
+                SetNegativeLabel(getResponseLabel(*categoricalColumn, 3), 3);
+                SetNeutralLabel(getResponseLabel(*categoricalColumn, 4));
+                SetPositiveLabel(getResponseLabel(*categoricalColumn, 5), 1);
+                SetPositiveLabel(getResponseLabel(*categoricalColumn, 6), 2);
+                SetPositiveLabel(getResponseLabel(*categoricalColumn, 7), 3);
                 }
             }
         }
@@ -710,56 +836,18 @@ namespace Wisteria::Graphs
 
         m_maxResondants = std::max(m_maxResondants, responses.GetRowCount());
 
-        // the group IDs and their frequencies in the data
-        std::map<GroupIdType, frequency_set<double>> fMap;
-        for (size_t i = 0; i < groups.GetRowCount(); ++i)
-            {
-            auto foundPos = fMap.find(groups.GetValue(i));
-            if (foundPos == fMap.end())
-                {
-                auto [iterator, found] = fMap.try_emplace(groups.GetValue(i), frequency_set<double>());
-                iterator->second.insert(responses.GetValue(i));
-                }
-            else
-                { foundPos->second.insert(responses.GetValue(i)); }
-            }
-
-        const auto findCount = [&fMap](const GroupIdType group, const double code) -> size_t
-            {
-            const auto groupPos = fMap.find(group);
-            if (groupPos != fMap.cend())
-                {
-                const auto found = groupPos->second.get_data().find(code);
-                return (found != groupPos->second.get_data().cend()) ? found->second : 0;
-                }
-            else
-                { return 0; }
-            };
-
-        const auto findNACount = [&fMap](const GroupIdType group) -> size_t
-            {
-            const auto groupPos = fMap.find(group);
-            if (groupPos != fMap.cend())
-                {
-                size_t naCount{ 0 };
-                auto found = groupPos->second.get_data().find(0);
-                if (found != groupPos->second.get_data().cend())
-                    { naCount += found->second; }
-                return naCount;
-                }
-            else
-                { return 0; }
-            };
+        // the group IDs and their response counts
+        const auto groupCounts = TabulateResponses(groups, responses);
 
         size_t groupResponses{ 0 };
         if (GetSurveyType() == LikertSurveyQuestionFormat::TwoPointCategorized)
             {
             LikertCategorizedThreePointSurveyQuestion sQuestion(question);
-            for (const auto& group : fMap)
+            for (const auto& group : groupCounts)
                 {
                 const LikertThreePointSurveyQuestion surveyQuestion(groups.GetCategoryLabelFromID(group.first),
-                    findCount(group.first, 1), 0/* no neutrals*/, findCount(group.first, 2),
-                    findNACount(group.first));
+                    group.second[1], 0/* no neutrals*/, group.second[2],
+                    group.second[0]);
                 groupResponses += surveyQuestion.m_responses;
                 sQuestion.AddCategoricalResponse(surveyQuestion);
                 }
@@ -770,11 +858,11 @@ namespace Wisteria::Graphs
         else if (GetSurveyType() == LikertSurveyQuestionFormat::ThreePointCategorized)
             {
             LikertCategorizedThreePointSurveyQuestion sQuestion(question);
-            for (const auto& group : fMap)
+            for (const auto& group : groupCounts)
                 {
                 const LikertThreePointSurveyQuestion surveyQuestion(groups.GetCategoryLabelFromID(group.first),
-                    findCount(group.first, 1), findCount(group.first, 2), findCount(group.first, 3),
-                    findNACount(group.first));
+                    group.second[1], group.second[2], group.second[3],
+                    group.second[0]);
                 groupResponses += surveyQuestion.m_responses;
                 sQuestion.AddCategoricalResponse(surveyQuestion);
                 }
@@ -785,12 +873,12 @@ namespace Wisteria::Graphs
         else if (GetSurveyType() == LikertSurveyQuestionFormat::FourPointCategorized)
             {
             LikertCategorizedFivePointSurveyQuestion sQuestion(question);
-            for (const auto& group : fMap)
+            for (const auto& group : groupCounts)
                 {
                 const LikertFivePointSurveyQuestion surveyQuestion(groups.GetCategoryLabelFromID(group.first),
-                    findCount(group.first, 1), findCount(group.first, 2), 0/* no neutrals*/,
-                    findCount(group.first, 3), findCount(group.first, 4),
-                    findNACount(group.first));
+                    group.second[1], group.second[2], 0/* no neutrals*/,
+                    group.second[3], group.second[4],
+                    group.second[0]);
                 groupResponses += surveyQuestion.m_responses;
                 sQuestion.AddCategoricalResponse(surveyQuestion);
                 }
@@ -801,12 +889,12 @@ namespace Wisteria::Graphs
         else if (GetSurveyType() == LikertSurveyQuestionFormat::FivePointCategorized)
             {
             LikertCategorizedFivePointSurveyQuestion sQuestion(question);
-            for (const auto& group : fMap)
+            for (const auto& group : groupCounts)
                 {
                 const LikertFivePointSurveyQuestion surveyQuestion(groups.GetCategoryLabelFromID(group.first),
-                    findCount(group.first, 1), findCount(group.first, 2), findCount(group.first, 3),
-                    findCount(group.first, 4), findCount(group.first, 5),
-                    findNACount(group.first));
+                    group.second[1], group.second[2], group.second[3],
+                    group.second[4], group.second[5],
+                    group.second[0]);
                 groupResponses += surveyQuestion.m_responses;
                 sQuestion.AddCategoricalResponse(surveyQuestion);
                 }
@@ -817,12 +905,12 @@ namespace Wisteria::Graphs
         else if (GetSurveyType() == LikertSurveyQuestionFormat::SixPointCategorized)
             {
             LikertCategorizedSevenPointSurveyQuestion sQuestion(question);
-            for (const auto& group : fMap)
+            for (const auto& group : groupCounts)
                 {
                 const LikertSevenPointSurveyQuestion surveyQuestion(groups.GetCategoryLabelFromID(group.first),
-                    findCount(group.first, 1), findCount(group.first, 2), findCount(group.first, 3),
-                    0/* no neutrals*/, findCount(group.first, 4), findCount(group.first, 5),
-                    findCount(group.first, 6), findNACount(group.first));
+                    group.second[1], group.second[2], group.second[3],
+                    0/* no neutrals*/, group.second[4], group.second[5],
+                    group.second[6], group.second[0]);
                 groupResponses += surveyQuestion.m_responses;
                 sQuestion.AddCategoricalResponse(surveyQuestion);
                 }
@@ -833,12 +921,12 @@ namespace Wisteria::Graphs
         else if (GetSurveyType() == LikertSurveyQuestionFormat::SevenPointCategorized)
             {
             LikertCategorizedSevenPointSurveyQuestion sQuestion(question);
-            for (const auto& group : fMap)
+            for (const auto& group : groupCounts)
                 {
                 const LikertSevenPointSurveyQuestion surveyQuestion(groups.GetCategoryLabelFromID(group.first),
-                    findCount(group.first, 1), findCount(group.first, 2), findCount(group.first, 3),
-                    findCount(group.first, 4), findCount(group.first, 5), findCount(group.first, 6),
-                    findCount(group.first, 7), findNACount(group.first));
+                    group.second[1], group.second[2], group.second[3],
+                    group.second[4], group.second[5], group.second[6],
+                    group.second[7], group.second[0]);
                 groupResponses += surveyQuestion.m_responses;
                 sQuestion.AddCategoricalResponse(surveyQuestion);
                 }
@@ -857,29 +945,12 @@ namespace Wisteria::Graphs
 
         m_maxResondants = std::max(m_maxResondants, responses.GetRowCount());
 
-        frequency_set<double> fSet;
-        for (const auto& value : responses.GetValues())
-            { fSet.insert(value); }
-
-        const auto findCount = [&fSet](const double code) -> size_t
-            {
-            const auto found = fSet.get_data().find(code);
-            return (found != fSet.get_data().cend()) ? found->second : 0;
-            };
-
-        const auto findNACount = [&fSet]() -> size_t
-            {
-            size_t naCount{ 0 };
-            auto found = fSet.get_data().find(0);
-            if (found != fSet.get_data().cend())
-                { naCount += found->second; }
-            return naCount;
-            };
+        const auto counts = TabulateResponses(responses);
 
         if (GetSurveyType() == LikertSurveyQuestionFormat::TwoPoint)
             {
             const LikertThreePointSurveyQuestion surveyQuestion(question,
-                findCount(1), 0/* no neutrals*/, findCount(2), findNACount());
+                counts[1], 0/* no neutrals*/, counts[2], counts[0]);
             wxASSERT_LEVEL_2_MSG(surveyQuestion.m_responses == responses.GetRowCount(),
                                  L"Classified responses don't equal the overall responses count!");
             AddSurveyQuestion(surveyQuestion);
@@ -888,7 +959,7 @@ namespace Wisteria::Graphs
             {
             const LikertThreePointSurveyQuestion surveyQuestion(question,
                 // 1-3, negative to positive
-                findCount(1), findCount(2), findCount(3), findNACount());
+                counts[1], counts[2], counts[3], counts[0]);
             wxASSERT_LEVEL_2_MSG(surveyQuestion.m_responses == responses.GetRowCount(),
                                  L"Classified responses don't equal the overall responses count!");
             AddSurveyQuestion(surveyQuestion);
@@ -896,9 +967,9 @@ namespace Wisteria::Graphs
         else if (GetSurveyType() == LikertSurveyQuestionFormat::FourPoint)
             {
             const LikertFivePointSurveyQuestion surveyQuestion(question,
-                findCount(1), findCount(2),
-                0/* no neutrals*/, findCount(3),
-                findCount(4), findNACount());
+                counts[1], counts[2],
+                0/* no neutrals*/, counts[3],
+                counts[4], counts[0]);
             wxASSERT_LEVEL_2_MSG(surveyQuestion.m_responses == responses.GetRowCount(),
                                  L"Classified responses don't equal the overall responses count!");
             AddSurveyQuestion(surveyQuestion);
@@ -906,9 +977,9 @@ namespace Wisteria::Graphs
         else if (GetSurveyType() == LikertSurveyQuestionFormat::FivePoint)
             {
             const LikertFivePointSurveyQuestion surveyQuestion(question,
-                findCount(1), findCount(2),
-                findCount(3), findCount(4),
-                findCount(5), findNACount());
+                counts[1], counts[2],
+                counts[3], counts[4],
+                counts[5], counts[0]);
             wxASSERT_LEVEL_2_MSG(surveyQuestion.m_responses == responses.GetRowCount(),
                                  L"Classified responses don't equal the overall responses count!");
             AddSurveyQuestion(surveyQuestion);
@@ -916,9 +987,9 @@ namespace Wisteria::Graphs
         else if (GetSurveyType() == LikertSurveyQuestionFormat::SixPoint)
             {
             const LikertSevenPointSurveyQuestion surveyQuestion(question,
-                findCount(1), findCount(2), findCount(3),
-                0/* no neutrals*/, findCount(4), findCount(5),
-                findCount(6), findNACount());
+                counts[1], counts[2], counts[3],
+                0/* no neutrals*/, counts[4], counts[5],
+                counts[6], counts[0]);
             wxASSERT_LEVEL_2_MSG(surveyQuestion.m_responses == responses.GetRowCount(),
                                  L"Classified responses don't equal the overall responses count!");
             AddSurveyQuestion(surveyQuestion);
@@ -926,9 +997,9 @@ namespace Wisteria::Graphs
         else if (GetSurveyType() == LikertSurveyQuestionFormat::SevenPoint)
             {
             const LikertSevenPointSurveyQuestion surveyQuestion(question,
-                findCount(1), findCount(2), findCount(3),
-                findCount(4), findCount(5), findCount(6),
-                findCount(7), findNACount());
+                counts[1], counts[2], counts[3],
+                counts[4], counts[5], counts[6],
+                counts[7], counts[0]);
             wxASSERT_LEVEL_2_MSG(surveyQuestion.m_responses == responses.GetRowCount(),
                                  L"Classified responses don't equal the overall responses count!");
             AddSurveyQuestion(surveyQuestion);
@@ -548,7 +548,8 @@ namespace Wisteria::Graphs
             @param currentFormat The questions' Likert scale.
             @returns The questions' new Likert scale (should be passed to the chart's constructor).
             @note If the data's scale is already 3- or 2-point, then the data will stay the same but the
-             question (i.e., categorical) columns' string tables will be reset to use the respective stock labels.*/
+             question (i.e., categorical) columns' string tables will be reset to use the respective stock labels.
+            @sa SimplifyScale(), which collapses the responses without editing the dataset.*/
         [[nodiscard]] static LikertSurveyQuestionFormat Simplify(std::shared_ptr<Data::Dataset>& data,
             std::vector<wxString>& questionColumns,
             LikertSurveyQuestionFormat currentFormat);
@@ -586,6 +587,21 @@ namespace Wisteria::Graphs
             {
             return IsCategorized(GetSurveyType());
             }
+
+        /** @brief Sets whether to collapse the responses into the simplest scale
+                (either 3- or 2-point) when SetData() is called.
+            @details This is the same as calling Simplify() on the dataset before SetData(),
+                except that the dataset is not edited. Instead, the responses' counts are
+                collapsed as they are tabulated. The stock labels (see CreateLabels()) for the
+                simpler scale will be used.\n
+                After SetData() is called, GetSurveyType() will return the simpler scale.
+            @param simplify @c true to collapse the responses.
+            @note This should be called before SetData().*/
+        void SimplifyScale(const bool simplify) noexcept
+            { m_simplifyScale = simplify; }
+        /// @returns @c true if the responses are being collapsed into the simplest scale.
+        [[nodiscard]] bool IsSimplifyingScale() const noexcept
+            { return m_simplifyScale; }
         /// @}
 
         /// @name Section Header Functions
@@ -704,6 +720,35 @@ namespace Wisteria::Graphs
             @param format The format to review.
             @returns `true` if the specified format is categorized.*/
         [[nodiscard]] static bool IsCategorized(const LikertSurveyQuestionFormat format) noexcept;
+        /// @brief The number of responses for each code (0 = no response, then levels 1-7).
+        using ResponseCounts = std::array<size_t, 8>;
+        /// @brief Codes to recode responses with, where the index is the original code.
+        using ResponseCodeTable = std::vector<Data::GroupIdType>;
+        /** @brief Gets the simplest version of a scale (see Simplify()).
+            @param format The scale to simplify.
+            @returns The 3- or 2-point version of the scale.*/
+        [[nodiscard]] static LikertSurveyQuestionFormat GetSimplifiedFormat(
+            const LikertSurveyQuestionFormat format) noexcept;
+        /** @brief Gets the table to recode a scale's responses into its simplest scale.
+            @param format The scale to simplify.
+            @returns The table of codes for the simpler scale, indexed by the original codes.*/
+        [[nodiscard]] static ResponseCodeTable GetSimplifiedCodes(
+            const LikertSurveyQuestionFormat format);
+        /** @brief Counts the responses to a question.
+            @param responses The responses.
+            @returns The number of responses for each code (after applying the simplified codes,
+                if simplifying the scale).*/
+        [[nodiscard]] ResponseCounts TabulateResponses(
+            const Data::ColumnWithStringTable& responses) const;
+        /** @brief Counts the responses to a question, for each group.
+            @param groups The group values column.
+            @param responses The responses.
+            @returns The groups (sorted by ID) and their number of responses for each code.*/
+        [[nodiscard]] std::vector<std::pair<Data::GroupIdType, ResponseCounts>> TabulateResponses(
+            const Data::ColumnWithStringTable& groups,
+            const Data::ColumnWithStringTable& responses) const;
+        /// @brief Applies the simplified codes (if simplifying the scale) to response counts.
+        [[nodiscard]] ResponseCounts CollapseResponses(const ResponseCounts& counts) const;
         /// @brief Draws the brackets connected to questions.
         void AddQuestionBrackets();
         /** @brief Converts a 4-point scale dataset to 2-point.
@@ -1053,6 +1098,10 @@ namespace Wisteria::Graphs
         bool m_showPercentages{ true };
         bool m_showSectionHeaders{ true };
         bool m_adjustBarWidthsToRespondentSize{ false };
+        bool m_simplifyScale{ false };
+        // the table for collapsing the responses' codes while tabulating them
+        // (empty if not simplifying the scale)
+        ResponseCodeTable m_simplifiedCodes;
 
         wxColour m_negativeColor{ Colors::ColorBrewer::GetColor(Colors::Color::Orange) };
         wxColour m_positiveColor{ Colors::ColorBrewer::GetColor(Colors::Color::Cerulean) };
@@ -23,6 +23,7 @@ namespace Wisteria::Graphs
 
         m_data = data;
         GetSelectedIds().clear();
+        InvalidateLegendCache();
 
         m_useGrouping = groupColumnName.has_value();
         m_groupColumn = (groupColumnName ? GetData()->GetCategoricalColumn(groupColumnName.value()) :
@@ -62,127 +63,112 @@ namespace Wisteria::Graphs
         GetBottomXAxis().GetTitle().SetText(xColumnName);
         GetLeftYAxis().GetTitle().SetText(yColumnName);
 
-        if (m_useGrouping)
+        // Partition the rows into their series in one pass, gathering each series's
+        // Y range and whether its X values only move forward along the way.
+        // (Plots with thousands of series would otherwise rescan the data for every one.)
+        struct SeriesInfo
+            {
+            Data::GroupIdType m_groupId{ 0 };
+            std::vector<size_t> m_rows;
+            double m_minY{ std::numeric_limits<double>::max() };
+            double m_maxY{ std::numeric_limits<double>::lowest() };
+            size_t m_validYCount{ 0 };
+            double m_lastX{ std::numeric_limits<double>::lowest() };
+            bool m_isSingleDirection{ true };
+            };
+        std::vector<SeriesInfo> series;
+        std::unordered_map<Data::GroupIdType, size_t> seriesLookup;
+        // rows are usually sorted by group, so remember the last one looked up
+        std::optional<Data::GroupIdType> lastGroupId;
+        size_t lastSeriesIndex{ 0 };
+        m_xDataRange = std::make_pair(std::numeric_limits<double>::quiet_NaN(),
+                                      std::numeric_limits<double>::quiet_NaN());
+        for (size_t i = 0; i < GetData()->GetRowCount(); ++i)
             {
-            std::set<Data::GroupIdType> groups;
-            for (const auto& groupId : m_groupColumn->GetValues())
-                { groups.insert(groupId); }
-            for (const auto& group : groups)
+            const Data::GroupIdType groupId = m_useGrouping ? m_groupColumn->GetValue(i) : 0;
+            if (!lastGroupId || lastGroupId.value() != groupId)
                 {
-                Line ln;
-                ln.SetGroupInfo(groupColumnName, group,
-                                m_groupColumn->GetCategoryLabelFromID(group));
-                ln.GetPen().SetColour(GetColorScheme()->GetColor(group));
-                // if some sort of spiral, then draw as a dashed spline
-                if (IsAutoSplining() && !IsDataSingleDirection(data, group))
-                    {
-                    ln.GetPen().SetStyle(wxPenStyle::wxPENSTYLE_SHORT_DASH);
-                    ln.SetStyle(LineStyle::Spline);
-                    }
+                const auto [seriesPos, inserted] =
+                    seriesLookup.try_emplace(groupId, series.size());
+                if (inserted)
+                    { series.emplace_back().m_groupId = groupId; }
+                lastGroupId = groupId;
+                lastSeriesIndex = seriesPos->second;
+                }
+            auto& currentSeries = series[lastSeriesIndex];
+            currentSeries.m_rows.push_back(i);
+
+            const double yValue = m_yColumn->GetValue(i);
+            if (!std::isnan(yValue))
+                {
+                currentSeries.m_minY = std::min(currentSeries.m_minY, yValue);
+                currentSeries.m_maxY = std::max(currentSeries.m_maxY, yValue);
+                ++currentSeries.m_validYCount;
+                }
+            if (IsXValid(i))
+                {
+                const double xValue = GetXValue(i);
+                if (xValue < currentSeries.m_lastX)
+                    { currentSeries.m_isSingleDirection = false; }
                 else
-                    {
-                    const auto& [penStyle, lineStyle] = GetPenStyleScheme()->GetLineStyle(group);
-                    ln.GetPen().SetStyle(penStyle);
-                    ln.SetStyle(lineStyle);
-                    }
-                AddLine(ln);
+                    { currentSeries.m_lastX = xValue; }
+                m_xDataRange.first = std::isnan(m_xDataRange.first) ?
+                    xValue : std::min(m_xDataRange.first, xValue);
+                m_xDataRange.second = std::isnan(m_xDataRange.second) ?
+                    xValue : std::max(m_xDataRange.second, xValue);
                 }
             }
-        else
+        // lines are added in the order of their group IDs, then sorted by label below
+        std::sort(series.begin(), series.end(),
+            [](const auto& first, const auto& second) noexcept
+            { return first.m_groupId < second.m_groupId; });
+
+        std::optional<std::pair<double, double>> yRange;
+        // show precision if the last line's min or max have floating-point values
+        uint8_t yPrecision{ 0 };
+        for (auto& currentSeries : series)
             {
+            // no valid data for this line
+            if (currentSeries.m_validYCount == 0)
+                { continue; }
+
             Line ln;
-            ln.SetGroupInfo(groupColumnName, 0, L"");
-            ln.GetPen().SetColour(GetColorScheme()->GetColor(0));
-            if (IsAutoSplining() && !IsDataSingleDirection(data, 0))
+            ln.SetGroupInfo(groupColumnName, currentSeries.m_groupId,
+                            m_useGrouping ?
+                                m_groupColumn->GetCategoryLabelFromID(currentSeries.m_groupId) :
+                                wxString(L""));
+            ln.GetPen().SetColour(GetColorScheme()->GetColor(currentSeries.m_groupId));
+            // if some sort of spiral, then draw as a dashed spline
+            if (IsAutoSplining() && !currentSeries.m_isSingleDirection)
                 {
                 ln.GetPen().SetStyle(wxPenStyle::wxPENSTYLE_SHORT_DASH);
                 ln.SetStyle(LineStyle::Spline);
                 }
             else
                 {
-                const auto& [penStyle, lineStyle] = GetPenStyleScheme()->GetLineStyle(0);
+                const auto& [penStyle, lineStyle] =
+                    GetPenStyleScheme()->GetLineStyle(currentSeries.m_groupId);
                 ln.GetPen().SetStyle(penStyle);
                 ln.SetStyle(lineStyle);
                 }
-            AddLine(ln);
-            }
-
-        // sort the lines by their group label
-        if (m_useGrouping)
-            {
-            std::sort(m_lines.begin(), m_lines.end(),
-                [this](const auto& first, const auto& second) noexcept
-                    {
-                    return m_groupColumn->GetCategoryLabelFromID(first.m_groupId) <
-                           m_groupColumn->GetCategoryLabelFromID(second.m_groupId);
-                    }
-                );
-            }
-        }
+            ln.m_rows = std::move(currentSeries.m_rows);
+            m_lines.push_back(std::move(ln));
 
-    //-------------------------------------------
-    bool LinePlot::IsDataSingleDirection(std::shared_ptr<const Data::Dataset>& data,
-                                         const Data::GroupIdType group) const noexcept
-        {
-        wxASSERT_MSG(data, L"Null dataset passed to IsDataSingleDirection()");
-        if (data == nullptr)
-            { return false; }
-        if (data->GetRowCount() == 0)
-            { return true; }
-        double currentX{ std::numeric_limits<double>::lowest() };
-        for (size_t i = 0; i < data->GetRowCount(); ++i)
-            {
-            if (!m_useGrouping || group == m_groupColumn->GetValue(i))
-                {
-                if (IsXValid(i))
-                    {
-                    if (GetXValue(i) < currentX)
-                        { return false; }
-                    else
-                        { currentX = GetXValue(i); }
-                    }
-                }
+            // the Y axis covers every line's (rounded) range
+            const auto [yStart, yEnd] =
+                adjust_intervals(currentSeries.m_minY, currentSeries.m_maxY);
+            yRange = yRange ?
+                std::make_pair(std::min(yStart, yRange->first), std::max(yEnd, yRange->second)) :
+                std::make_pair(yStart, yEnd);
+            yPrecision = (get_mantissa(yStart) == 0 && get_mantissa(yEnd) == 0) ? 0 : 1;
             }
-        return true;
-        }
 
-    //----------------------------------------------------------------
-    void LinePlot::AddLine(const LinePlot::Line& line)
-        {
-        if (GetData() == nullptr ||
-            (GetData()->GetContinuousColumnValidN(m_yColumnName,
-                                                  line.m_groupColumnName,
-                                                  line.m_groupId) == 0))
+        if (m_lines.empty())
             { return; }
 
-        m_lines.push_back(line);
-
-        const auto [fullYDataMin, fullYDataMax] = std::minmax_element(
-            m_yColumn->GetValues().cbegin(),
-            m_yColumn->GetValues().cend());
-        const auto [minYValue, maxYValue] = m_useGrouping ?
-            GetData()->GetContinuousMinMax(m_yColumnName,
-                                           line.m_groupColumnName,
-                                           line.m_groupId) :
-            std::make_pair(*fullYDataMin, *fullYDataMax);
-
-        const auto [yStartCurrent, yEndCurrent] = GetLeftYAxis().GetRange();
-        const auto [yStart, yEnd] = adjust_intervals(minYValue, maxYValue);
-
-        const auto [xStartCurrent, xEndCurrent] = GetBottomXAxis().GetRange();
-
-        GetLeftYAxis().SetRange(
-            (GetLineCount() > 1 ? std::min(yStart, yStartCurrent) : yStart),
-            (GetLineCount() > 1 ? std::max(yEnd, yEndCurrent) : yEnd),
-            // show precision if min or max have floating-point values
-            ((get_mantissa(yStart) == 0 && get_mantissa(yEnd) == 0) ? 0 : 1),
-            false);
-
+        GetLeftYAxis().SetRange(yRange->first, yRange->second, yPrecision, false);
         const auto [minXValue, maxXValue] = GetXMinMax();
-
-        GetBottomXAxis().SetRange(
-            (GetLineCount() > 1 ? std::min(minXValue, xStartCurrent) : minXValue),
-            (GetLineCount() > 1 ? std::max(maxXValue, xEndCurrent) : maxXValue),
+        GetBottomXAxis().SetRange(minXValue, maxXValue,
             ((get_mantissa(minXValue) == 0 && get_mantissa(maxXValue) == 0) ? 0 : 1),
             false);
 
@@ -201,6 +187,14 @@ namespace Wisteria::Graphs
             }
 
         UpdateCanvasForPoints();
+
+        // sort the lines by their group label
+        if (m_useGrouping)
+            {
+            std::sort(m_lines.begin(), m_lines.end(),
+                [](const auto& first, const auto& second) noexcept
+                { return first.m_label < second.m_label; });
+            }
         }
 
     //----------------------------------------------------------------
@@ -209,44 +203,106 @@ namespace Wisteria::Graphs
         // clear everything, update axes mirroring or whatever if requested by client
         Graph2D::RecalcSizes(dc);
 
+        // map all of the rows onto the axes up front (rather than once for each line)
+        std::vector<std::optional<wxCoord>> xCoordinates, yCoordinates;
+            {
+            // the widened copies of the values are only needed for mapping them,
+            // so free them before building the (possibly decimated) lines
+            std::vector<double> xValues(GetData()->GetRowCount());
+            std::vector<double> yValues(GetData()->GetRowCount());
+            for (size_t i = 0; i < GetData()->GetRowCount(); ++i)
+                {
+                xValues[i] = GetXValue(i);
+                yValues[i] = m_yColumn->GetValue(i);
+                }
+            GetBottomXAxis().GetCoordinateTransform().ToPhysicalCoordinates(xValues, xCoordinates);
+            GetLeftYAxis().GetCoordinateTransform().ToPhysicalCoordinates(yValues, yCoordinates);
+            }
+
         for (auto& line : m_lines)
             {
-            auto points = std::make_shared<GraphItems::Points2D>(line.GetPen());
+            // use a point cloud (rather than Points2D), as lines can have
+            // a large number of points and this will draw them in batches
+            auto points = std::make_shared<GraphItems::PointCloud>(line.GetPen());
             points->SetScaling(GetScaling());
             points->SetDPIScaleFactor(GetDPIScaleFactor());
             points->SetLineStyle(line.GetStyle());
-            points->Reserve(GetData()->GetRowCount());
+            points->SetRadius(Settings::GetPointRadius());
+            const size_t maxDecimatedPoints = static_cast<size_t>(
+                std::max(GetPlotAreaBoundingBox().GetWidth(), 1)) * 4;
+            const bool decimate = IsDecimatingLines() &&
+                line.m_rows.size() > maxDecimatedPoints;
+            points->Reserve(decimate ? maxDecimatedPoints : line.m_rows.size());
+            const auto addPoint = [&points, &line, this](const size_t row, const wxPoint pt)
+                {
+                const wxColor ptColor = (m_colorIf ?
+                    m_colorIf(GetXValue(row),
+                              m_yColumn->GetValue(row)) :
+                    line.GetPen().GetColour());
+                points->AddPoint(pt,
+                                 (ptColor.IsOk() ? ptColor : line.GetPen().GetColour()),
+                                 GetShapeScheme()->GetShape(line.m_groupId),
+                                 GetData()->GetIdColumn().GetValue(row),
+                                 &GetShapeScheme()->GetImage(line.m_groupId));
+                };
+
+            // If decimating, the consecutive points in the same pixel column are reduced
+            // to the first, lowest, highest, and last of them (in their original order).
+            // The line drawn through those is the same as the line through all of them.
+            std::vector<std::pair<size_t, wxPoint>> pixelColumn;
+            const auto flushPixelColumn = [&pixelColumn, &addPoint]()
+                {
+                if (pixelColumn.size() > 4)
+                    {
+                    const auto [lowest, highest] =
+                        std::minmax_element(pixelColumn.cbegin() + 1, pixelColumn.cend() - 1,
+                            [](const auto& pt1, const auto& pt2) noexcept
+                            { return pt1.second.y < pt2.second.y; });
+                    std::array<std::pair<size_t, wxPoint>, 4> keptPoints =
+                        { pixelColumn.front(), *lowest, *highest, pixelColumn.back() };
+                    std::sort(keptPoints.begin(), keptPoints.end(),
+                        [](const auto& pt1, const auto& pt2) noexcept
+                        { return pt1.first < pt2.first; });
+                    const auto keptEnd = std::unique(keptPoints.begin(), keptPoints.end(),
+                        [](const auto& pt1, const auto& pt2) noexcept
+                        { return pt1.first == pt2.first; });
+                    for (auto keptPoint = keptPoints.begin(); keptPoint != keptEnd; ++keptPoint)
+                        { addPoint(keptPoint->first, keptPoint->second); }
+                    }
+                else
+                    {
+                    for (const auto& [row, pt] : pixelColumn)
+                        { addPoint(row, pt); }
+                    }
+                pixelColumn.clear();
+                };
+
             wxPoint pt;
-            for (size_t i = 0; i < GetData()->GetRowCount(); ++i)
+            for (const auto i : line.m_rows)
                 {
-                // skip value if from a different group
-                if (m_useGrouping && m_groupColumn->GetValue(i) != line.m_groupId)
-                    { continue; }
                 // if explicitly missing data (i.e., NaN),
                 // then add a bogus point to show a gap in the line
                 if (!IsXValid(i) ||
                     std::isnan(m_yColumn->GetValue(i)))
                     {
-                    points->AddPoint(Point2D(
-                        GraphItemInfo().AnchorPoint(wxPoint(wxDefaultCoord, wxDefaultCoord)), 1), dc);
+                    flushPixelColumn();
+                    points->AddPoint(wxPoint(wxDefaultCoord, wxDefaultCoord),
+                                     line.GetPen().GetColour());
                     continue;
                     }
-                if (!GetPhyscialCoordinates(GetXValue(i),
-                                        m_yColumn->GetValue(i),
-                                        pt))
+                if (!xCoordinates[i] || !yCoordinates[i])
                     { continue; }
-                const wxColor ptColor = (m_colorIf ?
-                    m_colorIf(GetXValue(i),
-                              m_yColumn->GetValue(i)) :
-                    line.GetPen().GetColour());
-                points->AddPoint(Point2D(
-                                    GraphItemInfo(GetData()->GetIdColumn().GetValue(i)).
-                                    AnchorPoint(pt).
-                                    Brush((ptColor.IsOk() ? ptColor : line.GetPen().GetColour())),
-                                    Settings::GetPointRadius(),
-                                    GetShapeScheme()->GetShape(line.m_groupId),
-                                    &GetShapeScheme()->GetImage(line.m_groupId)), dc);
+                pt = wxPoint(xCoordinates[i].value(), yCoordinates[i].value());
+                if (decimate)
+                    {
+                    if (!pixelColumn.empty() && pixelColumn.back().second.x != pt.x)
+                        { flushPixelColumn(); }
+                    pixelColumn.emplace_back(i, pt);
+                    }
+                else
+                    { addPoint(i, pt); }
                 }
+            flushPixelColumn();
             AddObject(points);
             }
         }
@@ -254,6 +310,9 @@ namespace Wisteria::Graphs
     //----------------------------------------------------------------
     std::shared_ptr<GraphItems::Label> LinePlot::CreateLegend(const LegendOptions& options)
         {
+        if (auto cachedLegend = FindCachedLegend(options); cachedLegend != nullptr)
+            { return cachedLegend; }
+
         auto legend = std::make_shared<GraphItems::Label>(
             GraphItemInfo().Padding(0, 0, 0, Label::GetMinLegendWidthDIPs()).
             DPIScaling(GetDPIScaleFactor()));
@@ -304,6 +363,7 @@ namespace Wisteria::Graphs
 
         AddReferenceLinesAndAreasToLegend(legend);
         AdjustLegendSettings(legend, options.GetPlacementHint());
+        CacheLegend(options, legend);
         return legend;
         }
     }
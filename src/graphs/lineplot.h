@@ -12,6 +12,7 @@
 #ifndef __WISTERIA_LINE_PLOT_H__
 #define __WISTERIA_LINE_PLOT_H__
 
+#include <unordered_map>
 #include "graph2d.h"
 
 namespace Wisteria::Graphs
@@ -186,6 +187,8 @@ namespace Wisteria::Graphs
             std::optional<wxString> m_groupColumnName;
             Data::GroupIdType m_groupId{ 0 };
             wxString m_label;
+            // the rows (in order) of the line's points
+            std::vector<size_t> m_rows;
 
             LineStyle m_lineStyle{ LineStyle::Lines };
             wxPen m_linePen{ wxPen(*wxBLACK, 2) };
@@ -298,6 +301,8 @@ namespace Wisteria::Graphs
         [[nodiscard]] Line& GetLine(const size_t index) noexcept
             {
             wxASSERT_LEVEL_2_MSG(index < m_lines.size(), L"Invalid index in GetLine()!");
+            // the line's pen may be changed, which is shown on the legend
+            InvalidateLegendCache();
             return m_lines.at(index);
             }
         /// @brief Gets the lines so that you can iterate through them and make edits
@@ -305,7 +310,10 @@ namespace Wisteria::Graphs
         /// @returns Direct access to the lines.
         /// @note This should be called after SetData().
         [[nodiscard]] std::vector<Line>& GetLines() noexcept
-            { return m_lines; }
+            {
+            InvalidateLegendCache();
+            return m_lines;
+            }
         /** @brief Gets the number of lines on the plot.
             @returns The number of lines.
             @note This should be called after SetData().*/
@@ -345,6 +353,29 @@ namespace Wisteria::Graphs
             m_pointsPerDefaultCanvasSize = pointsPerDefaultCanvasSize;
             UpdateCanvasForPoints();
             }
+        /// @returns @c true if the lines' points are reduced to what can be seen
+        ///     at the plot's resolution.
+        [[nodiscard]] bool IsDecimatingLines() const noexcept
+            { return m_decimateLines; }
+        /** @brief Sets whether to reduce the lines' points to what can be seen
+                at the plot's resolution.
+            @details When enabled, consecutive points that fall into the same pixel column
+                are reduced to the first, lowest, highest, and last of them. The line drawn
+                through these looks exactly the same, but a line will have at most four points
+                each time that it passes through a pixel column
+                (regardless of how many rows are in the data).\n
+                This is recommended for long series (e.g., sensor readings with millions of samples).
+            @param decimate @c true to decimate the lines.
+            @note When enabled, the canvas is not widened to fit the points
+                (see SetPointsPerDefaultCanvasSize()), as the lines are fit to the plot's width instead;
+                so this should be called before SetData().\n
+                Points that are removed are not drawn (or selectable), so this is best
+                used with lines that do not show markers at their points.*/
+        void DecimateLines(const bool decimate)
+            {
+            m_decimateLines = decimate;
+            UpdateCanvasForPoints();
+            }
         /// @}
 
         /** @brief Builds and returns a legend using the current colors and labels.
@@ -406,38 +437,10 @@ namespace Wisteria::Graphs
                 { return std::numeric_limits<double>::quiet_NaN(); }
             }
         /** @brief Gets the min and max values of the X column.
-            @returns The X column's min and max value, which can be NaN if invalid.*/
-        [[nodiscard]] std::pair<double, double> GetXMinMax() const
-            {
-            if (GetData()->GetRowCount() == 0)
-                {
-                return std::make_pair(std::numeric_limits<double>::quiet_NaN(),
-                                      std::numeric_limits<double>::quiet_NaN());
-                }
-            // continuous X
-            if (IsXContinuous())
-                {
-                const auto [fullXDataMin, fullXDataMax] = std::minmax_element(
-                    m_xColumnContinuous->GetValues().cbegin(),
-                    m_xColumnContinuous->GetValues().cend());
-                return std::make_pair(*fullXDataMin, *fullXDataMax);
-                }
-            // categorical X, just want the underlying number code as that is what
-            // goes along the X axis
-            else if (IsXCategorical())
-                {
-                const auto [fullXDataMin, fullXDataMax] = std::minmax_element(
-                    m_xColumnCategorical->GetValues().cbegin(),
-                    m_xColumnCategorical->GetValues().cend());
-                return std::make_pair(static_cast<double>(*fullXDataMin),
-                                      static_cast<double>(*fullXDataMax));
-                }
-            else
-                {
-                return std::make_pair(std::numeric_limits<double>::quiet_NaN(),
-                                      std::numeric_limits<double>::quiet_NaN());
-                }
-            }
+            @returns The X column's min and max value, which can be NaN if invalid.
+            @note This is calculated by SetData().*/
+        [[nodiscard]] const std::pair<double, double>& GetXMinMax() const noexcept
+            { return m_xDataRange; }
     private:
         /// @returns Whether X was loaded from a continuous column.
         [[nodiscard]] bool IsXContinuous() const noexcept
@@ -445,9 +448,6 @@ namespace Wisteria::Graphs
         /// @returns Whether X was loaded from a categorical column.
         [[nodiscard]] bool IsXCategorical() const noexcept
             { return (m_xColumnCategorical != GetData()->GetCategoricalColumns().cend()); }
-        /** @brief Adds a line to the plot.
-            @param line The line to add.*/
-        void AddLine(const Line& line);
         /// @brief Recalculates the size of embedded objects on the plot.
         void RecalcSizes(wxDC& dc) final;
         /// @brief Get the shape scheme used for the points.
@@ -463,10 +463,11 @@ namespace Wisteria::Graphs
         [[nodiscard]] const std::shared_ptr<LineStyleScheme>& GetPenStyleScheme() const noexcept
             { return m_linePenStyles; }
 
-        [[nodiscard]] bool IsDataSingleDirection(std::shared_ptr<const Data::Dataset>& data,
-                                                 const Data::GroupIdType group) const noexcept;
         void UpdateCanvasForPoints()
             {
+            // decimated lines are fit to the plot's width
+            if (IsDecimatingLines() || GetData() == nullptr)
+                { return; }
             const auto avgPointsPerRow = safe_divide<size_t>(GetData()->GetRowCount(),
                                                              GetLineCount());
             if (avgPointsPerRow > GetPointsPerDefaultCanvasSize())
@@ -483,11 +484,14 @@ namespace Wisteria::Graphs
         std::vector<Wisteria::Data::ColumnWithStringTable>::const_iterator m_xColumnCategorical;
         std::vector<Wisteria::Data::Column<double>>::const_iterator m_yColumn;
         wxString m_yColumnName;
+        std::pair<double, double> m_xDataRange{ std::numeric_limits<double>::quiet_NaN(),
+                                                std::numeric_limits<double>::quiet_NaN() };
 
         std::vector<Line> m_lines;
         size_t m_pointsPerDefaultCanvasSize{ 100 };
         bool m_useGrouping{ false };
         bool m_autoSpline{ true };
+        bool m_decimateLines{ false };
 
         std::shared_ptr<Colors::Schemes::ColorScheme> m_colorScheme;
         std::shared_ptr<IconShapeScheme> m_shapeScheme;
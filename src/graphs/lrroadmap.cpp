@@ -89,6 +89,7 @@ namespace Wisteria::Graphs
                 { return false; }
             };
 
+        std::vector<RoadStopInfo> roadStops;
         for (size_t i = 0; i < data->GetRowCount(); ++i)
             {
             if (includePredictor(coefficientColumn->GetValue(i),
@@ -96,11 +97,12 @@ namespace Wisteria::Graphs
                                   std::optional<double>(pValueColumn->GetValue(i)) :
                                   std::nullopt)) )
                 {
-                GetRoadStops().emplace_back(
+                roadStops.emplace_back(
                     RoadStopInfo(predictorColumn->GetCategoryLabelFromID(predictorColumn->GetValue(i))).
                     Value(coefficientColumn->GetValue(i)));
                 }
             }
+        SetRoadStops(std::move(roadStops));
         }
 
     //----------------------------------------------------------------
@@ -54,7 +54,7 @@ namespace Wisteria::GraphItems
         pieLabel->GetHeaderInfo().Enable(false);
 
         // make it fit in the slice, or return null if too small
-        auto points = GetPolygon();
+        const auto& points = GetPolygon();
         bool middleLabelIsTooSmall{ false };
         for (;;)
             {
@@ -151,7 +151,7 @@ namespace Wisteria::GraphItems
         { return GetMiddleOfArc(pieProportion, m_pieArea); }
 
     //----------------------------------------------------------------
-    std::vector<wxPoint> PieSlice::GetPolygon() const noexcept
+    std::vector<wxPoint> PieSlice::CalcPolygon() const
         {
         std::vector<wxPoint> points;
 
@@ -225,7 +225,7 @@ namespace Wisteria::GraphItems
 
         if (IsSelected())
             {
-            auto points = GetPolygon();
+            const auto& points = GetPolygon();
             wxDCPenChanger pc(dc, wxPen(*wxBLACK, ScaleToScreenAndCanvas(2), wxPENSTYLE_DOT));
             dc.DrawLines(points.size(), &points[0]);
             // highlight the selected protruding bounding box in debug mode
@@ -274,6 +274,7 @@ namespace Wisteria::Graphs
             { return; }
 
         GetSelectedIds().clear();
+        InvalidateLegendCache();
         const auto& groupColumn1 = data->GetCategoricalColumn(groupColumn1Name);
         if (groupColumn1 == data->GetCategoricalColumns().cend())
             {
@@ -314,84 +315,140 @@ namespace Wisteria::Graphs
         using SliceAndValues = std::map<Data::GroupIdType, double>;
         // the outer pie (or only pie, if a single series)
         SliceAndValues outerGroups;
+        // the inner pie's slices, within their respective outer pie slices
+        std::map<Data::GroupIdType, SliceAndValues> innerGroups;
+
+        const auto getGroupIdCount = [](const auto& groupColumn)
+            {
+            const auto& groupIds = groupColumn->GetValues();
+            return groupIds.empty() ? size_t{ 0 } :
+                static_cast<size_t>(*std::max_element(groupIds.cbegin(), groupIds.cend()) + 1);
+            };
+        const size_t outerGroupIdCount = getGroupIdCount(groupColumn1);
+        const size_t innerGroupIdCount = useSubgrouping ? getGroupIdCount(groupColumn2) : 1;
 
         double totalValue{ 0.0 };
-        for (size_t i = 0; i < data->GetRowCount(); ++i)
+        // if the group IDs are compact, then total the (outer x inner) slices
+        // in a dense table in one pass; otherwise, total them in the maps directly
+        if (outerGroupIdCount <= MAX_DENSE_SLICE_COUNT &&
+            innerGroupIdCount <= MAX_DENSE_SLICE_COUNT &&
+            outerGroupIdCount * innerGroupIdCount <= MAX_DENSE_SLICE_COUNT)
             {
-            if (useAggregateColumn && std::isnan(aggregateColumn->GetValue(i)) )
-                { continue; }
+            // whether each slice has any observations, and its total
+            std::vector<std::pair<bool, double>> sliceTotals(
+                outerGroupIdCount * innerGroupIdCount, std::make_pair(false, 0.0));
+            for (size_t i = 0; i < data->GetRowCount(); ++i)
+                {
+                const double value = (useAggregateColumn ? aggregateColumn->GetValue(i) : 1);
+                if (std::isnan(value))
+                    { continue; }
 
-            auto [iterator, inserted] = outerGroups.insert(std::make_pair(
-                groupColumn1->GetValue(i),
-                (useAggregateColumn ? aggregateColumn->GetValue(i) : 1)) );
-            // increment counts for group
-            if (!inserted)
+                auto& slice = sliceTotals[(groupColumn1->GetValue(i) * innerGroupIdCount) +
+                                          (useSubgrouping ? groupColumn2->GetValue(i) : 0)];
+                slice.first = true;
+                slice.second += value;
+                totalValue += value;
+                }
+
+            for (size_t i = 0; i < sliceTotals.size(); ++i)
+                {
+                if (!sliceTotals[i].first)
+                    { continue; }
+                const Data::GroupIdType outerGroupId = i / innerGroupIdCount;
+                outerGroups[outerGroupId] += sliceTotals[i].second;
+                if (useSubgrouping)
+                    { innerGroups[outerGroupId][i % innerGroupIdCount] = sliceTotals[i].second; }
+                }
+            }
+        else
+            {
+            for (size_t i = 0; i < data->GetRowCount(); ++i)
                 {
-                iterator->second += (useAggregateColumn ? aggregateColumn->GetValue(i) : 1);
+                const double value = (useAggregateColumn ? aggregateColumn->GetValue(i) : 1);
+                if (std::isnan(value))
+                    { continue; }
+
+                outerGroups[groupColumn1->GetValue(i)] += value;
+                if (useSubgrouping)
+                    { innerGroups[groupColumn1->GetValue(i)][groupColumn2->GetValue(i)] += value; }
+                totalValue += value;
                 }
-            totalValue += (useAggregateColumn ? aggregateColumn->GetValue(i) : 1);
             }
 
+        // Slices too thin to be told apart are combined into an "Other" slice
+        // (but only if there is more than one of them), so that we don't build
+        // arcs and labels for them. If everything is zero, then there are no
+        // proportions to compare, so nothing is combined.
+        const auto isSliceTooThin = [this, totalValue](const double value)
+            {
+            return totalValue != 0 &&
+                safe_divide(value, totalValue) * 360 < GetMinimumSliceAngle();
+            };
+        const auto collapseSlices = [&isSliceTooThin](const SliceAndValues& slices)
+            {
+            return std::count_if(slices.cbegin(), slices.cend(),
+                [&isSliceTooThin](const auto& slice)
+                    { return isSliceTooThin(slice.second); }) > 1;
+            };
+        const bool collapseOuterSlices = collapseSlices(outerGroups);
+        double otherOuterValue{ 0.0 };
+
         // create slices with their percents of the overall total
         for (const auto& group : outerGroups)
             {
+            if (collapseOuterSlices && isSliceTooThin(group.second))
+                {
+                otherOuterValue += group.second;
+                continue;
+                }
             GetOuterPie().emplace_back(
                 SliceInfo{ groupColumn1->GetCategoryLabelFromID(group.first),
                            group.second,
                            safe_divide(group.second, totalValue) });
             }
         std::sort(GetOuterPie().begin(), GetOuterPie().end());
+        if (collapseOuterSlices)
+            {
+            GetOuterPie().push_back(
+                CreateOtherSlice(GetOuterPie(), otherOuterValue,
+                                 safe_divide(otherOuterValue, totalValue)));
+            }
 
         // if more grouping columns, then add an inner pie (which is a subgrouping
         // of the main group)
         if (useSubgrouping && data->GetCategoricalColumns().size() > 1)
             {
-            std::map<Data::GroupIdType, SliceAndValues> innerGroups;
-            totalValue = 0;
-            auto searchValue = std::make_pair<Data::GroupIdType,
-                                              SliceAndValues>(0, SliceAndValues());
-            for (size_t i = 0; i < data->GetRowCount(); ++i)
-                {
-                if (useAggregateColumn && std::isnan(aggregateColumn->GetValue(i)) )
-                    { continue; }
-
-                searchValue.first = groupColumn1->GetValue(i);
-                auto [iterator, inserted] = innerGroups.insert(searchValue);
-                if (inserted)
-                    {
-                    iterator->second.insert(std::make_pair(
-                        groupColumn2->GetValue(i),
-                        (useAggregateColumn ? aggregateColumn->GetValue(i) : 1)));
-                    }
-                else
-                    {
-                    auto [subIterator, subInserted] = iterator->second.insert(std::make_pair(
-                        groupColumn2->GetValue(i),
-                        (useAggregateColumn ? aggregateColumn->GetValue(i) : 1)));
-                    // increment counts for group
-                    if (!subInserted)
-                        {
-                        subIterator->second +=
-                            (useAggregateColumn ? aggregateColumn->GetValue(i) : 1);
-                        }
-                    }
-                totalValue += (useAggregateColumn ? aggregateColumn->GetValue(i) : 1);
-                }
-
             std::map<wxString, PieInfo, Data::StringCmpNoCase> innerPie;
             // the outer ring (main group) for the inner group slices
             for (const auto& innerGroupOuterRing : innerGroups)
                 {
+                // parent slice was combined into "Other", so its inner slices will be too
+                if (collapseOuterSlices && isSliceTooThin(outerGroups.at(innerGroupOuterRing.first)))
+                    { continue; }
+
+                const bool collapseInnerSlices = collapseSlices(innerGroupOuterRing.second);
+                double otherInnerValue{ 0.0 };
                 PieInfo currentOuterSliceSlices;
                 // the slices with the current outer ring group
                 for (const auto& innerGroup : innerGroupOuterRing.second)
                     {
+                    if (collapseInnerSlices && isSliceTooThin(innerGroup.second))
+                        {
+                        otherInnerValue += innerGroup.second;
+                        continue;
+                        }
                     currentOuterSliceSlices.emplace_back(
                         SliceInfo{ groupColumn2->GetCategoryLabelFromID(innerGroup.first),
                                innerGroup.second,
                                safe_divide(innerGroup.second, totalValue) });
                     }
                 std::sort(currentOuterSliceSlices.begin(), currentOuterSliceSlices.end());
+                if (collapseInnerSlices)
+                    {
+                    currentOuterSliceSlices.push_back(
+                        CreateOtherSlice(currentOuterSliceSlices, otherInnerValue,
+                                         safe_divide(otherInnerValue, totalValue)));
+                    }
                 innerPie.insert(std::make_pair(
                     groupColumn1->GetCategoryLabelFromID(innerGroupOuterRing.first),
                     currentOuterSliceSlices));
@@ -408,9 +465,34 @@ namespace Wisteria::Graphs
                                      innerPieSliceGroup.second.cend());
                 ++parentGroupIndex;
                 }
+            // the outer "Other" slice's subgroups are shown as one "Other" slice
+            // (labeled the same as its parent)
+            if (collapseOuterSlices)
+                {
+                auto otherSlice = CreateOtherSlice(PieInfo{}, otherOuterValue,
+                    safe_divide(otherOuterValue, totalValue), parentGroupIndex);
+                otherSlice.SetGroupLabel(GetOuterPie().back().GetGroupLabel());
+                GetInnerPie().push_back(std::move(otherSlice));
+                }
             }
         }
 
+    //----------------------------------------------------------------
+    PieChart::SliceInfo PieChart::CreateOtherSlice(const PieInfo& slices, const double value,
+                                                   const double percent,
+                                                   const Data::GroupIdType parentSliceGroup)
+        {
+        SliceInfo otherSlice{ _(L"Other"), value, percent, parentSliceGroup };
+        otherSlice.m_isOtherSlice = true;
+        // if the data has its own "Other" group, then don't show two slices with the same label
+        if (std::find_if(slices.cbegin(), slices.cend(),
+            [&otherSlice](const auto& slice)
+                { return slice.GetGroupLabel().CmpNoCase(otherSlice.GetGroupLabel()) == 0; }) !=
+            slices.cend())
+            { otherSlice.SetGroupLabel(_(L"Other (combined)")); }
+        return otherSlice;
+        }
+
     //----------------------------------------------------------------
     void PieChart::RecalcSizes(wxDC& dc)
         {
@@ -576,20 +658,20 @@ namespace Wisteria::Graphs
         double startAngle{ 0.0 };
         std::vector<std::shared_ptr<Label>> middleLabels;
         int smallestMiddleLabelFontSize{ GetBottomXAxis().GetFont().GetPointSize() };
-        for (size_t i = 0; i < GetOuterPie().size(); ++i)
+        for (size_t i = 0; i < m_outerPie.size(); ++i)
             {
             auto pSlice = std::make_shared<PieSlice>(
-                GraphItemInfo(GetOuterPie().at(i).GetGroupLabel()).
+                GraphItemInfo(m_outerPie.at(i).GetGroupLabel()).
                 Brush(m_pieColors->GetColor(i)).
                 DPIScaling(GetDPIScaleFactor()).Scaling(GetScaling()).
                 Pen(wxNullPen),
                 drawArea,
-                startAngle, startAngle + (GetOuterPie().at(i).m_percent * 360),
-                GetOuterPie().at(i).m_value, GetOuterPie().at(i).m_percent);
-            if (GetOuterPie().at(i).m_description.length())
+                startAngle, startAngle + (m_outerPie.at(i).m_percent * 360),
+                m_outerPie.at(i).m_value, m_outerPie.at(i).m_percent);
+            if (m_outerPie.at(i).m_description.length())
                 {
-                pSlice->SetText(GetOuterPie().at(i).GetGroupLabel() + L"\n" +
-                    GetOuterPie().at(i).m_description);
+                pSlice->SetText(m_outerPie.at(i).GetGroupLabel() + L"\n" +
+                    m_outerPie.at(i).m_description);
                 pSlice->GetHeaderInfo().Enable(true).Font(pSlice->GetFont());
                 if (IsUsingColorLabels())
                     { pSlice->GetHeaderInfo().FontColor(m_pieColors->GetColor(i)); }
@@ -602,16 +684,16 @@ namespace Wisteria::Graphs
                 pSlice->GetFont().MakeBold();
                 }
             AddObject(pSlice);
-            if (GetOuterPie().at(i).m_showText)
+            if (m_outerPie.at(i).m_showText)
                 { createLabelAndConnectionLine(pSlice, false); }
 
             double sliceProportion = 1 - (IsIncludingDonutHole() ? GetDonutHoleProportion() : 0);
-            if (GetInnerPie().size())
+            if (m_innerPie.size())
                 { sliceProportion /= 2; }
 
             sliceProportion = (IsIncludingDonutHole() ? GetDonutHoleProportion() : 0) +
                 safe_divide<double>(sliceProportion, 2) +
-                (GetInnerPie().size() ? sliceProportion : 0);
+                (m_innerPie.size() ? sliceProportion : 0);
             auto middleLabel = pSlice->CreateMiddleLabel(dc, sliceProportion,
                                                         GetOuterPieMidPointLabelDisplay());
             if (middleLabel != nullptr)
@@ -622,7 +704,7 @@ namespace Wisteria::Graphs
                 }
             middleLabels.emplace_back(middleLabel);
 
-            startAngle += GetOuterPie().at(i).m_percent * 360;
+            startAngle += m_outerPie.at(i).m_percent * 360;
             }
         // make the outer ring middle labels have a common font size
         for (auto& middleLabel : middleLabels)
@@ -642,7 +724,7 @@ namespace Wisteria::Graphs
         smallestMiddleLabelFontSize = GetBottomXAxis().GetFont().GetPointSize();
         // note that we do NOT clear outerLabels or its smallest font size,
         // both rings use these
-        for (size_t i = 0; i < GetInnerPie().size(); ++i)
+        for (size_t i = 0; i < m_innerPie.size(); ++i)
             {
             const double sliceProportion = safe_divide<double>(1 -
                 (IsIncludingDonutHole() ? GetDonutHoleProportion() : 0), 2) +
@@ -660,26 +742,26 @@ namespace Wisteria::Graphs
             // outline for all inner slices within the current group
             const auto sliceLineColor{
                 ColorContrast::ShadeOrTint(
-                    m_pieColors->GetColor(GetInnerPie().at(i).m_parentSliceGroup), 0.4) };
+                    m_pieColors->GetColor(m_innerPie.at(i).m_parentSliceGroup), 0.4) };
             // slightly adjusted color based on the parent slice color
-            sliceColor = (currentParentSliceIndex == GetInnerPie().at(i).m_parentSliceGroup) ?
+            sliceColor = (currentParentSliceIndex == m_innerPie.at(i).m_parentSliceGroup) ?
                 ColorContrast::ShadeOrTint(sliceColor, .1) :
                 ColorContrast::ShadeOrTint(
-                    m_pieColors->GetColor(GetInnerPie().at(i).m_parentSliceGroup, 0.1));
-            currentParentSliceIndex = GetInnerPie().at(i).m_parentSliceGroup;
+                    m_pieColors->GetColor(m_innerPie.at(i).m_parentSliceGroup, 0.1));
+            currentParentSliceIndex = m_innerPie.at(i).m_parentSliceGroup;
 
             auto pSlice = std::make_shared<PieSlice>(
-                GraphItemInfo(GetInnerPie().at(i).GetGroupLabel()).
+                GraphItemInfo(m_innerPie.at(i).GetGroupLabel()).
                 Brush(sliceColor).
                 DPIScaling(GetDPIScaleFactor()).Scaling(GetScaling()).
                 Pen(sliceLineColor),
                 innerDrawArea,
-                startAngle, startAngle + (GetInnerPie().at(i).m_percent * 360),
-                GetInnerPie().at(i).m_value, GetInnerPie().at(i).m_percent);
-            if (GetInnerPie().at(i).m_description.length())
+                startAngle, startAngle + (m_innerPie.at(i).m_percent * 360),
+                m_innerPie.at(i).m_value, m_innerPie.at(i).m_percent);
+            if (m_innerPie.at(i).m_description.length())
                 {
-                pSlice->SetText(GetInnerPie().at(i).GetGroupLabel() + L"\n" +
-                    GetInnerPie().at(i).m_description);
+                pSlice->SetText(m_innerPie.at(i).GetGroupLabel() + L"\n" +
+                    m_innerPie.at(i).m_description);
                 pSlice->GetHeaderInfo().Enable(true).Font(pSlice->GetFont());
                 if (IsUsingColorLabels())
                     { pSlice->GetHeaderInfo().FontColor(sliceColor); }
@@ -693,7 +775,7 @@ namespace Wisteria::Graphs
                 }
             AddObject(pSlice);
 
-            if (GetInnerPie().at(i).m_showText)
+            if (m_innerPie.at(i).m_showText)
                 { createLabelAndConnectionLine(pSlice, true); }
 
             auto middleLabel = pSlice->CreateMiddleLabel(dc,
@@ -709,7 +791,7 @@ namespace Wisteria::Graphs
                 }
             middleLabels.emplace_back(middleLabel);
 
-            startAngle += GetInnerPie().at(i).m_percent * 360;
+            startAngle += m_innerPie.at(i).m_percent * 360;
             }
 
         // sort top quandrant labels (top-to-bottom)
@@ -1051,9 +1133,9 @@ namespace Wisteria::Graphs
     std::shared_ptr<GraphItems::Label> PieChart::CreateInnerPieLegend(
         const LegendCanvasPlacementHint hint)
         {
-        wxASSERT_MSG(GetInnerPie().size() > 1,
+        wxASSERT_MSG(m_innerPie.size() > 1,
                      L"Inner ring of pie chart empty, cannot create legend!");
-        if (GetInnerPie().size() == 0)
+        if (m_innerPie.size() == 0)
             { return nullptr; }
 
         auto legend = std::make_shared<GraphItems::Label>(
@@ -1063,7 +1145,7 @@ namespace Wisteria::Graphs
         size_t currentLine{ 0 };
 
         // space in line is needed for SVG exporting; otherwise, the blank line gets removed
-        wxString legendText { GetOuterPie().at(0).GetGroupLabel() + L"\n \n" };
+        wxString legendText { m_outerPie.at(0).GetGroupLabel() + L"\n \n" };
         legend->GetLinesIgnoringLeftMargin().insert(currentLine);
         currentLine += 2;
         legend->GetLegendIcons().emplace_back(
@@ -1074,7 +1156,7 @@ namespace Wisteria::Graphs
         size_t lineCount{ 0 };
         size_t currentParentSliceIndex{ 0 };
         auto sliceColor{ m_pieColors->GetColor(0) };
-        for (size_t i = 0; i < GetInnerPie().size(); ++i)
+        for (size_t i = 0; i < m_innerPie.size(); ++i)
             {
             if (Settings::GetMaxLegendItemCount() == lineCount)
                 {
@@ -1082,7 +1164,7 @@ namespace Wisteria::Graphs
                 ++currentLine;
                 break;
                 }
-            wxString currentLabel = GetInnerPie().at(i).GetGroupLabel();
+            wxString currentLabel = m_innerPie.at(i).GetGroupLabel();
             if (currentLabel.length() > Settings::GetMaxLegendTextLength())
                 {
                 currentLabel.resize(Settings::GetMaxLegendTextLength()+1);
@@ -1092,16 +1174,16 @@ namespace Wisteria::Graphs
 
             // get the color
             // slightly adjusted color based on the parent slice color
-            sliceColor = (currentParentSliceIndex == GetInnerPie().at(i).m_parentSliceGroup) ?
+            sliceColor = (currentParentSliceIndex == m_innerPie.at(i).m_parentSliceGroup) ?
                 ColorContrast::ShadeOrTint(sliceColor, .1) :
                 ColorContrast::ShadeOrTint(
-                    m_pieColors->GetColor(GetInnerPie().at(i).m_parentSliceGroup, .1));
+                    m_pieColors->GetColor(m_innerPie.at(i).m_parentSliceGroup, .1));
             // starting a new group
-            if (currentParentSliceIndex != GetInnerPie().at(i).m_parentSliceGroup)
+            if (currentParentSliceIndex != m_innerPie.at(i).m_parentSliceGroup)
                 {
-                currentParentSliceIndex = GetInnerPie().at(i).m_parentSliceGroup;
+                currentParentSliceIndex = m_innerPie.at(i).m_parentSliceGroup;
                 legendText.append(
-                    GetOuterPie().at(currentParentSliceIndex).GetGroupLabel()).append(L"\n \n");
+                    m_outerPie.at(currentParentSliceIndex).GetGroupLabel()).append(L"\n \n");
                 legend->GetLinesIgnoringLeftMargin().insert(currentLine);
                 currentLine += 2;
                 legend->GetLegendIcons().emplace_back(
@@ -1131,7 +1213,7 @@ namespace Wisteria::Graphs
     std::shared_ptr<GraphItems::Label> PieChart::CreateOuterPieLegend(
         const LegendCanvasPlacementHint hint)
         {
-        wxASSERT_MSG(GetOuterPie().size() > 1,
+        wxASSERT_MSG(m_outerPie.size() > 1,
                      L"Outer ring of pie chart empty, cannot create legend!");
         auto legend = std::make_shared<GraphItems::Label>(
             GraphItemInfo().Padding(0, 0, 0, Label::GetMinLegendWidthDIPs()).
@@ -1139,14 +1221,14 @@ namespace Wisteria::Graphs
 
         wxString legendText;
         size_t lineCount{ 0 };
-        for (size_t i = 0; i < GetOuterPie().size(); ++i)
+        for (size_t i = 0; i < m_outerPie.size(); ++i)
             {
             if (Settings::GetMaxLegendItemCount() == lineCount)
                 {
                 legendText.append(L"\u2026");
                 break;
                 }
-            wxString currentLabel = GetOuterPie().at(i).GetGroupLabel();
+            wxString currentLabel = m_outerPie.at(i).GetGroupLabel();
             if (currentLabel.length() > Settings::GetMaxLegendTextLength())
                 {
                 currentLabel.resize(Settings::GetMaxLegendTextLength()+1);
@@ -34,7 +34,13 @@ namespace Wisteria::GraphItems
                  const double value, const double percent) :
             m_pieArea(pieRect), m_startAngle(startAngle), m_endAngle(endAngle),
             m_value(value), m_percent(percent)
-            { GetGraphItemInfo() = info; }
+            {
+            GetGraphItemInfo() = info;
+            // the slice can't be moved or resized, so its shape only needs to be
+            // calculated once (rather than on every hit test while hovering)
+            m_polygon = CalcPolygon();
+            m_boundingBox = Polygon::GetPolygonBoundingBox(m_polygon);
+            }
         /** @brief Creates a label to display in the middle of the slice.\n
                 This is usually a raw count of observations in the slice, or its percentage of the
                 overall pie.
@@ -71,20 +77,25 @@ namespace Wisteria::GraphItems
         [[nodiscard]] std::pair<double, double> GetMiddleOfArc(const double pieProportion,
                                                                const wxRect pieArea) const noexcept;
         /// @returns The (approximate) polygon of the slice.
-        std::vector<wxPoint> GetPolygon() const noexcept;
+        [[nodiscard]] const std::vector<wxPoint>& GetPolygon() const noexcept
+            { return m_polygon; }
     private:
         wxRect Draw(wxDC& dc) const final;
+        /// @returns The (approximate) polygon of the slice, calculated from its angles.
+        [[nodiscard]] std::vector<wxPoint> CalcPolygon() const;
 
-        bool HitTest(const wxPoint pt, wxDC& dc) const final
+        [[nodiscard]] bool HitTest(const wxPoint pt, [[maybe_unused]] wxDC& dc) const final
             {
-            auto points = GetPolygon();
-            return Polygon::IsInsidePolygon(pt, &points[0], points.size());
+            // a pie's slices all meet in its middle, so their bounding boxes overlap a lot;
+            // the box only rules out points that are clearly elsewhere
+            return m_boundingBox.Contains(pt) &&
+                Polygon::IsInsidePolygon(pt, &m_polygon[0], m_polygon.size());
             }
 
         /// @returns The rectangle on the canvas where the point would fit in.
         /// @param dc Measurement DC, which is not used in this implementation.
         [[nodiscard]] wxRect GetBoundingBox([[maybe_unused]] wxDC& dc) const final
-            { return Polygon::GetPolygonBoundingBox(GetPolygon()); }
+            { return m_boundingBox; }
 
         // obligatory virtual interfaces that aren't implemented
         [[deprecated("Not implemented")]]
@@ -99,6 +110,8 @@ namespace Wisteria::GraphItems
         double m_endAngle{ 0 };
         double m_value{ 0 };
         double m_percent{ 0 };
+        std::vector<wxPoint> m_polygon;
+        wxRect m_boundingBox;
         };
     }
 
@@ -304,10 +317,21 @@ namespace Wisteria::Graphs
             ///     The label and description will still be shown if the slice is selected.
             void ShowGroupLabel(const bool show) noexcept
                 { m_showText = show; }
+            /// @returns @c true if this is the slice that thin slices were combined into
+            ///     (see SetMinimumSliceAngle()), rather than a group from the data.
+            /// @note This slice is labeled "Other", unless the data already has a group
+            ///     with that label (then it is labeled "Other (combined)").
+            [[nodiscard]] bool IsOtherSlice() const noexcept
+                { return m_isOtherSlice; }
 
             /// @private
+            /// @note The combined "Other" slice never equals a slice from the data,
+            ///     even if they have the same label.
             [[nodiscard]] bool operator==(const SliceInfo& that) const noexcept
-                { return m_groupLabel.CmpNoCase(that.m_groupLabel) == 0; }
+                {
+                return m_isOtherSlice == that.m_isOtherSlice &&
+                       m_groupLabel.CmpNoCase(that.m_groupLabel) == 0;
+                }
             /// @private
             [[nodiscard]] bool operator<(const SliceInfo& that) const noexcept
                 { return m_groupLabel.CmpNoCase(that.m_groupLabel) < 0; }
@@ -315,6 +339,7 @@ namespace Wisteria::Graphs
             wxString m_groupLabel;
             wxString m_description;
             bool m_showText{ true };
+            bool m_isOtherSlice{ false };
             double m_value{ 0.0 };
             double m_percent{ 0.0 };
             Wisteria::Data::GroupIdType m_parentSliceGroup{ 0 };
@@ -361,6 +386,23 @@ namespace Wisteria::Graphs
         void UseColorLabels(const bool useColors) noexcept
             { m_useColorLabels = useColors; }
 
+        /// @returns The smallest angle (in degrees) that a slice can have before it is
+        ///     combined into an "Other" slice.
+        [[nodiscard]] double GetMinimumSliceAngle() const noexcept
+            { return m_minSliceAngle; }
+        /** @brief Sets the smallest angle (in degrees) that a slice can have before it is
+                combined into an "Other" slice.
+            @details When there are multiple slices in a ring thinner than this, they are combined
+                into one "Other" slice at the end of the ring (or parent slice, for the inner ring).
+                This keeps high-cardinality groupings from producing thousands of slices
+                (and labels) that can't be told apart anyway.\n
+                The default is @c 0 (i.e., every slice is shown); a value such as half a degree
+                is recommended for groupings with a large number of categories.
+            @param degrees The minimum slice angle.
+            @note This must be called before SetData() to have any effect.*/
+        void SetMinimumSliceAngle(const double degrees) noexcept
+            { m_minSliceAngle = std::clamp(degrees, 0.0, 360.0); }
+
         /// @name Outer Pie Functions
         /// @brief Functions for customizing the outer ring of the pie chart.\n
         ///     If subgrouping is not being used, then this will be the only pie ring.
@@ -370,7 +412,13 @@ namespace Wisteria::Graphs
         ///     Use this to edit the labels and descriptions for slices.
         /// @returns The outer (i.e., main) pie.
         [[nodiscard]] PieInfo& GetOuterPie() noexcept
-            { return m_outerPie; }
+            {
+            // slice labels may be edited, which are shown on the legend
+            // (the inner ring's legend uses them as its group headers)
+            InvalidateLegendCache(Perimeter::Outer);
+            InvalidateLegendCache(Perimeter::Inner);
+            return m_outerPie;
+            }
 
         /// @returns What the labels on the middle points along the outer ring are displaying.
         /// @note If only using a single grouping column, then this refers to the main pie.
@@ -410,7 +458,10 @@ namespace Wisteria::Graphs
         ///               { slice.SetGroupLabel(false); });
         /// @endcode
         [[nodiscard]] PieInfo& GetInnerPie() noexcept
-            { return m_innerPie; }
+            {
+            InvalidateLegendCache(Perimeter::Inner);
+            return m_innerPie;
+            }
         /// @brief Gets/sets the pen used for the lines connecting inner slices to their
         ///     labels outside of the pie.
         /// @returns The inner pie connection line.
@@ -494,14 +545,13 @@ namespace Wisteria::Graphs
         [[nodiscard]] std::shared_ptr<GraphItems::Label> CreateLegend(
             const LegendOptions& options) final
             {
-            if (options.GetRingPerimeter() == Perimeter::Inner)
-                {
-                return CreateInnerPieLegend(options.GetPlacementHint());
-                }
-            else
-                {
-                return CreateOuterPieLegend(options.GetPlacementHint());
-                }
+            if (auto cachedLegend = FindCachedLegend(options); cachedLegend != nullptr)
+                { return cachedLegend; }
+            auto legend = (options.GetRingPerimeter() == Perimeter::Inner) ?
+                CreateInnerPieLegend(options.GetPlacementHint()) :
+                CreateOuterPieLegend(options.GetPlacementHint());
+            CacheLegend(options, legend);
+            return legend;
             }
 
         /** @brief Builds and returns a legend for the outer pie
@@ -541,9 +591,20 @@ namespace Wisteria::Graphs
         std::shared_ptr<Colors::Schemes::ColorScheme> GetColorScheme() const noexcept
             { return m_pieColors; }
 
+        /// @returns The slice that thin slices are combined into, labeled so that
+        ///     it can't be confused with any of the other slices in @c slices.
+        [[nodiscard]] static SliceInfo CreateOtherSlice(const PieInfo& slices, const double value,
+                                                        const double percent,
+                                                        const Data::GroupIdType parentSliceGroup = 0);
+
+        /// @brief The most (outer x inner) group IDs that SetData() will total in a dense table.
+        constexpr static size_t MAX_DENSE_SLICE_COUNT{ 64 * 1024 };
+
         PieInfo m_innerPie;
         PieInfo m_outerPie;
 
+        double m_minSliceAngle{ 0 };
+
         BinLabelDisplay m_innerPieMidPointLabelDisplay{ BinLabelDisplay::BinPercentage };
         BinLabelDisplay m_outerPieMidPointLabelDisplay{ BinLabelDisplay::BinPercentage };
         LabelPlacement m_labelPlacement{ LabelPlacement::Flush };
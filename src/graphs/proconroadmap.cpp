@@ -122,12 +122,15 @@ namespace Wisteria::Graphs
         SetMagnitude(std::abs(*maxVal));
 
         // add the influencers as road stops
+        std::vector<RoadStopInfo> roadStops;
+        roadStops.reserve(influencers.get_data().size());
         for (const auto& influencer : influencers.get_data())
             {
-            GetRoadStops().emplace_back(
+            roadStops.emplace_back(
                 RoadStopInfo(influencer.first).
                 Value(influencer.second.second));
             }
+        SetRoadStops(std::move(roadStops));
         }
 
     //----------------------------------------------------------------
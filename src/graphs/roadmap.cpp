@@ -40,34 +40,135 @@ namespace Wisteria::Graphs
         GetBottomXAxis().SetRange(0, 100, 0, 1, 1);
         }
 
-    
+
     //----------------------------------------------------------------
-    void Roadmap::RecalcSizes(wxDC& dc)
+    void Roadmap::SetRoadStops(std::vector<RoadStopInfo>&& roadStops)
         {
-        GetLeftYAxis().SetRange(0, GetRoadStops().size() + 2, 0, 1, 1);
-
-        Graph2D::RecalcSizes(dc);
+        // the cached geometry and labels are checked against the stops when they are used
+        m_roadStops = std::move(roadStops);
+        }
 
+    //----------------------------------------------------------------
+    std::pair<double, double> Roadmap::GetRoadRange() const
+        {
         // trim space off of area for the road so that there is space
         // for the markers
         auto roadRange = GetBottomXAxis().GetRange();
         const auto axisSpaceForMarkers = (roadRange.second - roadRange.first) / 5;
         roadRange.first += axisSpaceForMarkers;
         roadRange.second -= axisSpaceForMarkers;
+        return roadRange;
+        }
 
+    //----------------------------------------------------------------
+    const Roadmap::RoadGeometry& Roadmap::GetRoadGeometry(wxDC& dc)
+        {
+        // the road's shape only depends on the stops' values and where the plot is
+        const wxRect boundingBox = GetBoundingBox(dc);
+        if (m_roadGeometry &&
+            m_roadGeometry->m_boundingBox == boundingBox &&
+            m_roadGeometry->m_plotArea == GetPlotAreaBoundingBox() &&
+            compare_doubles(m_roadGeometry->m_magnitude, GetMagnitude()) &&
+            std::equal(m_roadGeometry->m_stopValues.cbegin(), m_roadGeometry->m_stopValues.cend(),
+                       GetRoadStops().cbegin(), GetRoadStops().cend(),
+                       [](const auto value, const auto& roadStop) noexcept
+                       { return value == roadStop.GetValue(); }))
+            { return m_roadGeometry.value(); }
+
+        RoadGeometry geometry;
+        geometry.m_boundingBox = boundingBox;
+        geometry.m_plotArea = GetPlotAreaBoundingBox();
+        geometry.m_magnitude = GetMagnitude();
+        geometry.m_stopValues.reserve(GetRoadStops().size());
+        for (const auto& roadStop : GetRoadStops())
+            { geometry.m_stopValues.push_back(roadStop.GetValue()); }
+
+        const auto roadRange = GetRoadRange();
         // left (negative items) and right (positive) sides of the road
         const auto middleX =
             (GetBottomXAxis().GetRange().second - GetBottomXAxis().GetRange().first) / 2;
         const auto rightRoadRange = std::make_pair(middleX, roadRange.second);
         const auto leftRoadRange = std::make_pair(middleX, roadRange.first);
 
+        wxCoord xPt{ 0 }, yPt{ 0 };
+        // start of the road (bottom)
+        if (GetBottomXAxis().GetPhysicalCoordinate(middleX, xPt))
+            { geometry.m_roadPoints.push_back({ xPt, boundingBox.GetBottom() }); }
+
+        // the curves in the road
+        geometry.m_markerPoints.reserve(GetRoadStops().size());
+        for (size_t i = 0; i < GetRoadStops().size(); ++i)
+            {
+            if (GetBottomXAxis().GetPhysicalCoordinate(
+                    scale_within(std::abs(GetRoadStops()[i].GetValue()),
+                                 std::make_pair(0.0, GetMagnitude()),
+                                 (GetRoadStops()[i].GetValue() >= 0 ?
+                                     rightRoadRange : leftRoadRange)), xPt) &&
+                GetLeftYAxis().GetPhysicalCoordinate(i + 1, yPt))
+                { geometry.m_roadPoints.push_back({ xPt, yPt }); }
+            geometry.m_markerPoints.push_back({ xPt, yPt });
+            }
+
+        // end of the road (top)
+        if (GetBottomXAxis().GetPhysicalCoordinate(middleX, xPt))
+            { geometry.m_roadPoints.push_back({ xPt, boundingBox.GetTop() }); }
+
+        m_roadGeometry = std::move(geometry);
+        return m_roadGeometry.value();
+        }
+
+    //----------------------------------------------------------------
+    const std::vector<wxString>& Roadmap::GetMarkerLabelTexts()
+        {
+        if (m_markerLabelTextsDisplay == m_markerLableDisplay &&
+            std::equal(m_markerLabelStops.cbegin(), m_markerLabelStops.cend(),
+                       GetRoadStops().cbegin(), GetRoadStops().cend(),
+                       [](const auto& cachedStop, const auto& roadStop)
+                       {
+                       return cachedStop.GetValue() == roadStop.GetValue() &&
+                           cachedStop.GetName() == roadStop.GetName();
+                       }))
+            { return m_markerLabelTexts; }
+
+        m_markerLabelTexts.clear();
+        m_markerLabelTexts.reserve(GetRoadStops().size());
+        for (const auto& roadStop : GetRoadStops())
+            {
+            m_markerLabelTexts.push_back(
+                (m_markerLableDisplay == MarkerLabelDisplay::NameAndValue) ?
+                     wxString::Format(L"%s (%s)",
+                        roadStop.GetName(),
+                            wxNumberFormatter::ToString(roadStop.GetValue(), 3,
+                            wxNumberFormatter::Style::Style_NoTrailingZeroes)) :
+                (m_markerLableDisplay == MarkerLabelDisplay::NameAndAbsoluteValue) ?
+                    wxString::Format(L"%s (%s)",
+                        roadStop.GetName(),
+                            wxNumberFormatter::ToString(std::abs(roadStop.GetValue()), 3,
+                            wxNumberFormatter::Style::Style_NoTrailingZeroes)) :
+                roadStop.GetName());
+            }
+        m_markerLabelStops = GetRoadStops();
+        m_markerLabelTextsDisplay = m_markerLableDisplay;
+        return m_markerLabelTexts;
+        }
+
+    //----------------------------------------------------------------
+    void Roadmap::RecalcSizes(wxDC& dc)
+        {
+        GetLeftYAxis().SetRange(0, GetRoadStops().size() + 2, 0, 1, 1);
+
+        Graph2D::RecalcSizes(dc);
+
+        const auto roadRange = GetRoadRange();
+
         // the scale for the location markers (in DIPs);
         // 4 is probably the best looking small points, and 20 is a large enough
         // while still being reasonable
         std::pair<double, double> pointSizesRange = { 4, 20 };
 
-        wxCoord xPt{ 0 }, yPt{ 0 };
-        std::vector<wxPoint> pts;
+        const RoadGeometry& geometry = GetRoadGeometry(dc);
+        const std::vector<wxPoint>& pts = geometry.m_roadPoints;
+        const std::vector<wxString>& markerTexts = GetMarkerLabelTexts();
         std::vector<std::shared_ptr<Point2D>> locations;
         std::vector<std::shared_ptr<Label>> locationLabels;
         auto labelConnectionLines =
@@ -76,21 +177,9 @@ namespace Wisteria::Graphs
                       wxPenStyle::wxPENSTYLE_LONG_DASH),
                 GetScaling());
 
-        // start of the road (bottom)
-        if (GetBottomXAxis().GetPhysicalCoordinate(middleX, xPt))
-            { pts.push_back({ xPt, GetBoundingBox(dc).GetBottom() }); }
-
-        // the curves in the road
+        // the location markers along the road
         for (size_t i = 0; i < GetRoadStops().size(); ++i)
             {
-            if (GetBottomXAxis().GetPhysicalCoordinate(
-                    scale_within(std::abs(GetRoadStops()[i].GetValue()),
-                                 std::make_pair(0.0, GetMagnitude()),
-                                 (GetRoadStops()[i].GetValue() >= 0 ?
-                                     rightRoadRange : leftRoadRange)), xPt) &&
-                GetLeftYAxis().GetPhysicalCoordinate(i + 1, yPt))
-                { pts.push_back({ xPt, yPt }); }
-
             // the location marker:
             auto pt = std::make_shared<Point2D>(
                 GraphItemInfo().Brush((GetRoadStops()[i].GetValue() >= 0 ?
@@ -98,48 +187,33 @@ namespace Wisteria::Graphs
                     GetNegativeIcon().second)).
                 DPIScaling(GetDPIScaleFactor()).
                 Scaling(GetScaling()).
-                AnchorPoint({ xPt , yPt }),
+                AnchorPoint(geometry.m_markerPoints[i]),
                 scale_within(std::abs(GetRoadStops()[i].GetValue()),
                              std::make_pair(0.0, GetMagnitude()), pointSizesRange),
                 (GetRoadStops()[i].GetValue() >= 0 ?
                     GetPositiveIcon().first : GetNegativeIcon().first));
             locations.push_back(pt);
 
-            const wxString markerText =
-                (m_markerLableDisplay == MarkerLabelDisplay::NameAndValue) ?
-                     wxString::Format(L"%s (%s)",
-                        GetRoadStops()[i].GetName(),
-                            wxNumberFormatter::ToString(GetRoadStops()[i].GetValue(), 3,
-                            wxNumberFormatter::Style::Style_NoTrailingZeroes)) : 
-                (m_markerLableDisplay == MarkerLabelDisplay::NameAndAbsoluteValue) ?
-                    wxString::Format(L"%s (%s)",
-                        GetRoadStops()[i].GetName(),
-                            wxNumberFormatter::ToString(std::abs(GetRoadStops()[i].GetValue()), 3,
-                            wxNumberFormatter::Style::Style_NoTrailingZeroes)) :
-                GetRoadStops()[i].GetName();
-
             auto markerLabel = std::make_shared<Label>(
-                GraphItemInfo(GraphItemInfo(markerText).
+                GraphItemInfo(GraphItemInfo(markerTexts[i]).
                 Scaling(GetScaling()).
                 DPIScaling(GetDPIScaleFactor()).
                 Pen(wxNullPen).
                 FontBackgroundColor(*wxWHITE)) );
             markerLabel->ShowLabelWhenSelected(true);
+            const wxRect markerBox = pt->GetBoundingBox(dc);
             if (GetLabelPlacement() == LabelPlacement::NextToParent)
                 {
                 markerLabel->SetAnchorPoint((GetRoadStops()[i].GetValue() >= 0 ?
-                    pt->GetBoundingBox(dc).GetBottomRight() :
-                    pt->GetBoundingBox(dc).GetBottomLeft()));
+                    markerBox.GetBottomRight() : markerBox.GetBottomLeft()));
                 markerLabel->SetAnchoring((GetRoadStops()[i].GetValue() >= 0 ?
                     Anchoring::BottomLeftCorner : Anchoring::BottomRightCorner));
                 }
             else
                 {
                 markerLabel->SetAnchorPoint((GetRoadStops()[i].GetValue() >= 0 ?
-                    wxPoint(GetPlotAreaBoundingBox().GetRight(),
-                            pt->GetBoundingBox(dc).GetBottomRight().y) :
-                    wxPoint(GetPlotAreaBoundingBox().GetLeft(),
-                            pt->GetBoundingBox(dc).GetBottomLeft().y)));
+                    wxPoint(GetPlotAreaBoundingBox().GetRight(), markerBox.GetBottom()) :
+                    wxPoint(GetPlotAreaBoundingBox().GetLeft(), markerBox.GetBottom())));
                 markerLabel->SetAnchoring((GetRoadStops()[i].GetValue() >= 0 ?
                     Anchoring::BottomRightCorner : Anchoring::BottomLeftCorner));
                 labelConnectionLines->AddLine(markerLabel->GetAnchorPoint(),
@@ -149,10 +223,6 @@ namespace Wisteria::Graphs
             locationLabels.push_back(markerLabel);
             }
 
-        // end of the road (top)
-        if (GetBottomXAxis().GetPhysicalCoordinate(middleX, xPt))
-            { pts.push_back({ xPt, GetBoundingBox(dc).GetTop() }); }
-
         // the road pavement
         wxASSERT_MSG(m_roadPen.IsOk(), L"Valid road pen needed to draw road!");
         wxPen scaledRoadPen = m_roadPen;
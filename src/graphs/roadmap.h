@@ -179,12 +179,44 @@ namespace Wisteria::Graphs
         void SetGoalLabel(const wxString& label)
             { m_goalLabel = label; }
         /// @returns The road stops.
-        [[nodiscard]] std::vector<RoadStopInfo>& GetRoadStops() noexcept
+        [[nodiscard]] const std::vector<RoadStopInfo>& GetRoadStops() const noexcept
             { return m_roadStops; }
+        /// @brief Sets the road stops (replacing any existing ones).
+        /// @details This should be called by derived classes' @c SetData() function.
+        /// @param roadStops The road stops.
+        void SetRoadStops(std::vector<RoadStopInfo>&& roadStops);
     private:
+        /// @brief Where the road and its markers are, cached between layouts.
+        struct RoadGeometry
+            {
+            // what the geometry was calculated for
+            wxRect m_boundingBox;
+            wxRect m_plotArea;
+            double m_magnitude{ 0 };
+            std::vector<double> m_stopValues;
+            // the points along the road (including the start and end)
+            std::vector<wxPoint> m_roadPoints;
+            // the anchor points of the road stops' markers
+            std::vector<wxPoint> m_markerPoints;
+            };
+
         void RecalcSizes(wxDC& dc) final;
+        /// @returns The range (along the X axis) that the road can curve within.
+        [[nodiscard]] std::pair<double, double> GetRoadRange() const;
+        /// @returns The road's points and marker positions, recalculating them
+        ///     only if the road stops or the plot's size have changed.
+        /// @note The axes must be laid out first.
+        [[nodiscard]] const RoadGeometry& GetRoadGeometry(wxDC& dc);
+        /// @returns The labels for the road stops' markers, formatting them only
+        ///     if the road stops or how they are displayed have changed.
+        [[nodiscard]] const std::vector<wxString>& GetMarkerLabelTexts();
 
         std::vector<RoadStopInfo> m_roadStops;
+        std::optional<RoadGeometry> m_roadGeometry;
+        std::vector<wxString> m_markerLabelTexts;
+        // the road stops that the marker labels were formatted from, and how
+        std::vector<RoadStopInfo> m_markerLabelStops;
+        MarkerLabelDisplay m_markerLabelTextsDisplay{ MarkerLabelDisplay::NameAndValue };
         // (absolute) max of values (e.g., IVs' coefficients)
         double m_magnitude{ 0 };
         wxString m_goalLabel{ _(L"Goal") };
@@ -1,4 +1,5 @@
 #include "table.h"
+#include "../util/numberformatcache.h"
 
 using namespace Wisteria::GraphItems;
 using namespace Wisteria::Colors;
@@ -7,6 +8,21 @@ namespace Wisteria::Graphs
     {
     //----------------------------------------------------------------
     wxString Table::TableCell::GetDisplayValue() const
+        {
+        // text is displayed as-is, so there is nothing to cache
+        if (const auto strVal{ std::get_if<wxString>(&m_value) };
+            strVal != nullptr)
+            { return *strVal; }
+        if (m_displayValueIsStale)
+            {
+            m_displayValue = FormatDisplayValue();
+            m_displayValueIsStale = false;
+            }
+        return m_displayValue;
+        }
+
+    //----------------------------------------------------------------
+    wxString Table::TableCell::FormatDisplayValue() const
         {
         if (const auto strVal{ std::get_if<wxString>(&m_value) };
             strVal != nullptr)
@@ -18,12 +34,12 @@ namespace Wisteria::Graphs
                 { return wxEmptyString; }
             else if (m_valueFormat == CellFormat::Percent)
                 {
-                return wxNumberFormatter::ToString((*dVal)*100, m_precision,
+                return NumberFormatCache::ToString((*dVal)*100, m_precision,
                     wxNumberFormatter::Style::Style_None) + L"%";
                 }
             else
                 {
-                return wxNumberFormatter::ToString(*dVal, m_precision,
+                return NumberFormatCache::ToString(*dVal, m_precision,
                     wxNumberFormatter::Style::Style_WithThousandsSep);
                 }
             }
@@ -35,7 +51,7 @@ namespace Wisteria::Graphs
             if (dVal->first > dVal->second)
                 {
                 return wxString::Format(L"%s : 1",
-                    wxNumberFormatter::ToString(
+                    NumberFormatCache::ToString(
                         safe_divide(dVal->first, dVal->second), m_precision,
                         wxNumberFormatter::Style::Style_WithThousandsSep |
                         wxNumberFormatter::Style::Style_NoTrailingZeroes));
@@ -43,7 +59,7 @@ namespace Wisteria::Graphs
             else
                 {
                 return wxString::Format(L"1 : %s",
-                    wxNumberFormatter::ToString(
+                    NumberFormatCache::ToString(
                         safe_divide(dVal->second, dVal->first), m_precision,
                         wxNumberFormatter::Style::Style_WithThousandsSep |
                         wxNumberFormatter::Style::Style_NoTrailingZeroes));
@@ -169,6 +185,9 @@ namespace Wisteria::Graphs
         const bool transpose /*= false*/)
         {
         ClearTable();
+        m_virtualData.reset();
+        m_virtualColumns.clear();
+        m_virtualColumnSamples.clear();
 
         if (transpose)
             {
@@ -179,13 +198,13 @@ namespace Wisteria::Graphs
             for (const auto& colName : columns)
                 {
                 // the row header
-                GetCell(currentRow, 0).m_value = colName;
+                GetCell(currentRow, 0).SetValue(colName);
                 if (auto continuousCol = data->GetContinuousColumn(colName);
                     continuousCol != data->GetContinuousColumns().cend())
                     {
                     for (size_t i = 0; i < continuousCol->GetValues().size(); ++i)
                         {
-                        GetCell(currentRow, i+1).m_value = continuousCol->GetValue(i);
+                        GetCell(currentRow, i+1).SetValue(continuousCol->GetValue(i));
                         }
                     }
                 else if (auto catCol = data->GetCategoricalColumn(colName);
@@ -193,8 +212,8 @@ namespace Wisteria::Graphs
                     {
                     for (size_t i = 0; i < catCol->GetValues().size(); ++i)
                         {
-                        GetCell(currentRow, i+1).m_value  =
-                            catCol->GetCategoryLabelFromID(catCol->GetValue(i));
+                        GetCell(currentRow, i+1).SetValue(
+                            catCol->GetCategoryLabelFromID(catCol->GetValue(i)));
                         }
                     }
                 else if (auto dateCol = data->GetDateColumn(colName);
@@ -202,7 +221,7 @@ namespace Wisteria::Graphs
                     {
                     for (size_t i = 0; i < dateCol->GetValues().size(); ++i)
                         {
-                        GetCell(currentRow, i+1).m_value = dateCol->GetValue(i);
+                        GetCell(currentRow, i+1).SetValue(dateCol->GetValue(i));
                         }
                     }
                 else
@@ -222,13 +241,13 @@ namespace Wisteria::Graphs
             for (const auto& colName : columns)
                 {
                 // the column header
-                GetCell(0, currentColumn).m_value = colName;
+                GetCell(0, currentColumn).SetValue(colName);
                 if (auto continuousCol = data->GetContinuousColumn(colName);
                     continuousCol != data->GetContinuousColumns().cend())
                     {
                     for (size_t i = 0; i < continuousCol->GetValues().size(); ++i)
                         {
-                        GetCell(i+1, currentColumn).m_value = continuousCol->GetValue(i);
+                        GetCell(i+1, currentColumn).SetValue(continuousCol->GetValue(i));
                         }
                     }
                 else if (auto catCol = data->GetCategoricalColumn(colName);
@@ -236,8 +255,8 @@ namespace Wisteria::Graphs
                     {
                     for (size_t i = 0; i < catCol->GetValues().size(); ++i)
                         {
-                        GetCell(i+1, currentColumn).m_value =
-                            catCol->GetCategoryLabelFromID(catCol->GetValue(i));
+                        GetCell(i+1, currentColumn).SetValue(
+                            catCol->GetCategoryLabelFromID(catCol->GetValue(i)));
                         }
                     }
                 else if (auto dateCol = data->GetDateColumn(colName);
@@ -245,7 +264,7 @@ namespace Wisteria::Graphs
                     {
                     for (size_t i = 0; i < dateCol->GetValues().size(); ++i)
                         {
-                        GetCell(i+1, currentColumn).m_value = dateCol->GetValue(i);
+                        GetCell(i+1, currentColumn).SetValue(dateCol->GetValue(i));
                         }
                     }
                 else
@@ -258,33 +277,143 @@ namespace Wisteria::Graphs
             }
         }
 
+    //----------------------------------------------------------------
+    std::vector<Table::CellValueType> Table::ReadColumnValues(const Data::Dataset& data,
+        const wxString& colName, const std::vector<size_t>& rows)
+        {
+        std::vector<CellValueType> values;
+        values.reserve(rows.size());
+        if (auto continuousCol = data.GetContinuousColumn(colName);
+            continuousCol != data.GetContinuousColumns().cend())
+            {
+            for (const auto row : rows)
+                { values.emplace_back(continuousCol->GetValue(row)); }
+            }
+        else if (auto catCol = data.GetCategoricalColumn(colName);
+            catCol != data.GetCategoricalColumns().cend())
+            {
+            for (const auto row : rows)
+                { values.emplace_back(catCol->GetCategoryLabelFromID(catCol->GetValue(row))); }
+            }
+        else if (auto dateCol = data.GetDateColumn(colName);
+            dateCol != data.GetDateColumns().cend())
+            {
+            for (const auto row : rows)
+                { values.emplace_back(dateCol->GetValue(row)); }
+            }
+        else
+            {
+            throw std::runtime_error(wxString::Format(
+                _(L"'%s': column not found for table."), colName).ToUTF8());
+            }
+        return values;
+        }
+
+    //----------------------------------------------------------------
+    void Table::SetVirtualData(const std::shared_ptr<const Data::Dataset>& data,
+                               const std::initializer_list<wxString>& columns,
+                               const size_t rowsPerPage)
+        {
+        ClearTable();
+        m_virtualData.reset();
+        m_virtualColumns.assign(columns);
+        m_virtualColumnSamples.clear();
+        m_rowsPerPage = std::max<size_t>(rowsPerPage, 1);
+        m_currentPage = 0;
+        if (data == nullptr)
+            { return; }
+
+        // sample rows spread evenly throughout the data
+        std::vector<size_t> sampleRows;
+        const auto sampleSize = std::min(data->GetRowCount(), m_virtualSampleSize);
+        sampleRows.reserve(sampleSize);
+        for (size_t i = 0; i < sampleSize; ++i)
+            { sampleRows.push_back((i * data->GetRowCount()) / sampleSize); }
+
+        for (const auto& colName : m_virtualColumns)
+            {
+            auto samples = ReadColumnValues(*data, colName, sampleRows);
+            // the longest values may not be in the sample, so include those also
+            if (auto continuousCol = data->GetContinuousColumn(colName);
+                continuousCol != data->GetContinuousColumns().cend())
+                {
+                const auto& summary = continuousCol->GetSummary();
+                if (summary.m_validN > 0)
+                    {
+                    samples.emplace_back(summary.m_min);
+                    samples.emplace_back(summary.m_max);
+                    }
+                }
+            else if (auto catCol = data->GetCategoricalColumn(colName);
+                catCol != data->GetCategoricalColumns().cend())
+                {
+                const auto& stringTable = catCol->GetStringTable();
+                const auto longestLabel = std::max_element(stringTable.cbegin(), stringTable.cend(),
+                    [](const auto& lhv, const auto& rhv) noexcept
+                    { return lhv.second.length() < rhv.second.length(); });
+                if (longestLabel != stringTable.cend())
+                    { samples.emplace_back(longestLabel->second); }
+                }
+            m_virtualColumnSamples.push_back(std::move(samples));
+            }
+
+        m_virtualData = data;
+        LoadVirtualPage();
+        }
+
+    //----------------------------------------------------------------
+    void Table::SetPage(const size_t page)
+        {
+        if (!IsVirtual())
+            { return; }
+        m_currentPage = std::min(page, GetPageCount() - 1);
+        LoadVirtualPage();
+        }
+
+    //----------------------------------------------------------------
+    void Table::LoadVirtualPage()
+        {
+        ClearTable();
+        if (!IsVirtual())
+            { return; }
+
+        const auto firstRow = std::min(m_currentPage * m_rowsPerPage,
+                                       m_virtualData->GetRowCount());
+        std::vector<size_t> pageRows(std::min(m_rowsPerPage,
+                                              m_virtualData->GetRowCount() - firstRow));
+        std::iota(pageRows.begin(), pageRows.end(), firstRow);
+
+        SetTableSize(pageRows.size() + 1, m_virtualColumns.size());
+        size_t currentColumn{ 0 };
+        for (const auto& colName : m_virtualColumns)
+            {
+            // the column header
+            GetCell(0, currentColumn).SetValue(colName);
+            const auto values = ReadColumnValues(*m_virtualData, colName, pageRows);
+            for (size_t i = 0; i < values.size(); ++i)
+                { GetCell(i + 1, currentColumn).SetValue(values[i]); }
+            ++currentColumn;
+            }
+        }
+
     //----------------------------------------------------------------
     void Table::CalculateAggregate(const AggregateInfo& aggInfo,
                                    Table::TableCell& aggCell,
-                                   const std::vector<double>& values)
+                                   const AggregateValues& values)
         {
-        if (values.size())
+        if (values.m_count > 0)
             {
             if (aggInfo.m_type == AggregateType::Total)
-                {
-                aggCell.m_value = std::accumulate(values.cbegin(),
-                                                  values.cend(), 0);
-                }
+                { aggCell.SetValue(values.m_total); }
             else if (aggInfo.m_type == AggregateType::ChangePercent &&
-                values.size() > 1)
+                values.m_count > 1)
                 {
-                const auto oldValue = values.front();
-                const auto newValue = values.back();
-                aggCell.m_value = safe_divide(newValue-oldValue, oldValue);
-                aggCell.m_valueFormat = CellFormat::Percent;
+                aggCell.SetValue(safe_divide(values.m_last - values.m_first, values.m_first));
+                aggCell.SetFormat(CellFormat::Percent);
                 }
             else if (aggInfo.m_type == AggregateType::Ratio &&
-                values.size() > 1)
-                {
-                const auto firstValue = values.front();
-                const auto secondValue = values.back();
-                aggCell.m_value = std::make_pair(firstValue, secondValue);
-                }
+                values.m_count > 1)
+                { aggCell.SetValue(std::make_pair(values.m_first, values.m_last)); }
             }
         }
 
@@ -323,7 +452,7 @@ namespace Wisteria::Graphs
                         std::nullopt, rowIter->first + rowIter->second, bkColor);
                     // make parent group consume first cell of subtotal row
                     GetCell(rowIter->first, 0).m_rowCount++;
-                    GetCell(lastSubgroupRow+1, 1).m_value = _(L"Total");
+                    GetCell(lastSubgroupRow+1, 1).SetValue(_(L"Total"));
                     }
                 }
             // no groups, so just add an overall total row at the bottom
@@ -349,20 +478,21 @@ namespace Wisteria::Graphs
             if (bkColor.has_value())
                 { SetRowBackgroundColor(rIndex, bkColor.value()); }
 
-            std::vector<double> colValues;
+            // tally values from the whole column, unless a custom range was defined
+            const size_t firstRow = (aggInfo.m_cell1.has_value() ? aggInfo.m_cell1.value() : 0);
+            const size_t lastRow = std::min(
+                (aggInfo.m_cell2.has_value() ? aggInfo.m_cell2.value() + 1 : rIndex),
+                GetRowCount());
             for (size_t currentCol = 0; currentCol < GetColumnCount(); ++currentCol)
                 {
-                colValues.clear();
-                // tally values from the whole row, unless a custom range was defined
-                for (size_t currentRow = (aggInfo.m_cell1.has_value() ? aggInfo.m_cell1.value() : 0);
-                     currentRow < (aggInfo.m_cell2.has_value() ? aggInfo.m_cell2.value()+1 : rIndex);
-                     ++currentRow)
+                AggregateValues colValues;
+                for (size_t currentRow = firstRow; currentRow < lastRow; ++currentRow)
                     {
-                    const auto& cell = GetCell(currentRow, currentCol);
-                    if (cell.IsNumeric() && !std::isnan(cell.GetDoubleValue()))
-                        { colValues.push_back(cell.GetDoubleValue()); }
-                    CalculateAggregate(aggInfo, GetCell(rIndex, currentCol), colValues);
+                    // skip the aggregate row itself (if inserted inside of the range)
+                    if (currentRow != rIndex)
+                        { colValues.Add(m_table[currentRow][currentCol]); }
                     }
+                CalculateAggregate(aggInfo, m_table[rIndex][currentCol], colValues);
                 }
             }
         }
@@ -381,22 +511,21 @@ namespace Wisteria::Graphs
             if (bkColor.has_value())
                 { SetColumnBackgroundColor(columnIndex, bkColor.value()); }
 
-            size_t currentRow{ 0 };
-            std::vector<double> rowValues;
+            // tally values from the whole row, unless a custom range was defined
+            const size_t firstColumn = (aggInfo.m_cell1.has_value() ? aggInfo.m_cell1.value() : 0);
             for (auto& row : m_table)
                 {
-                rowValues.clear();
-                // tally values from the whole row, unless a custom range was defined
-                for (size_t i = (aggInfo.m_cell1.has_value() ? aggInfo.m_cell1.value() : 0);
-                     i < (aggInfo.m_cell2.has_value() ? aggInfo.m_cell2.value()+1 : columnIndex);
-                     ++i)
+                const size_t lastColumn = std::min(
+                    (aggInfo.m_cell2.has_value() ? aggInfo.m_cell2.value() + 1 : columnIndex),
+                    row.size());
+                AggregateValues rowValues;
+                for (size_t i = firstColumn; i < lastColumn; ++i)
                     {
-                    const auto& cell = GetCell(currentRow, i);
-                    if (cell.IsNumeric() && !std::isnan(cell.GetDoubleValue()))
-                        { rowValues.push_back(cell.GetDoubleValue()); }
+                    // skip the aggregate column itself (if inserted inside of the range)
+                    if (i != columnIndex)
+                        { rowValues.Add(row[i]); }
                     }
-                CalculateAggregate(aggInfo, GetCell(currentRow, columnIndex), rowValues);
-                ++currentRow;
+                CalculateAggregate(aggInfo, row[columnIndex], rowValues);
                 }
             }
         }
@@ -503,27 +632,23 @@ namespace Wisteria::Graphs
         std::vector<CellPosition> outlierPositions;
         if (column < GetColumnCount())
             {
+            // NaN is kept so that the indices line up with the rows
             std::vector<double> values;
             values.reserve(GetRowCount());
             for (size_t row = 0; row < GetRowCount(); ++row)
-                {
-                const auto val = GetCell(row, column).GetDoubleValue();
-                if (!std::isnan(val))
-                    { values.push_back(val); }
-                }
-            const auto meanVal = statistics::mean(values);
-            const auto sdVal = statistics::standard_deviation(values, true);
-            // get the z-scores and see who is an outlier
-            for (size_t row = 0; row < GetRowCount(); ++row)
-                {
-                const auto val = GetCell(row, column).GetDoubleValue();
-                if (!std::isnan(val))
-                    {
-                    const auto zScore = statistics::z_score(val, meanVal, sdVal);
-                    if (zScore > outlierThreshold)
-                        { outlierPositions.push_back(std::make_pair(row, column)); }
-                    }
-                }
+                { values.push_back(GetCell(row, column).GetDoubleValue()); }
+            // get the mean and SD from one pass
+            const auto valueMoments = statistics::calculate_moments(values);
+            const auto sdVal = statistics::standard_deviation(valueMoments, true);
+            // a zero SD yields z-scores of zero, so nothing would be an outlier
+            if (sdVal == 0)
+                { return outlierPositions; }
+            const auto meanVal = valueMoments.mean;
+            // a z-score above the threshold is the same as being beyond this many SDs from the mean
+            for (const auto row : statistics::indices_outside_range(values,
+                                    meanVal - (outlierThreshold * sdVal),
+                                    meanVal + (outlierThreshold * sdVal)))
+                { outlierPositions.push_back(std::make_pair(row, column)); }
             }
         return outlierPositions;
         }
@@ -538,6 +663,18 @@ namespace Wisteria::Graphs
         rowHeights.clear();
         rowHeights.resize(GetRowCount());
 
+        // format the cells' values up front (and cache them), doing it in parallel
+        // for large tables; measuring them below has to use the DC, so that is sequential
+        if (GetRowCount() * GetColumnCount() >= m_parallelFormatCellCount)
+            {
+            std::for_each(std::execution::par, m_table.cbegin(), m_table.cend(),
+                [](const auto& row)
+                {
+                for (const auto& cell : row)
+                    { [[maybe_unused]] const auto displayValue = cell.GetDisplayValue(); }
+                });
+            }
+
         size_t currentRow{ 0 }, currentColumn{ 0 };
         Label measuringLabel(GraphItemInfo().Pen(*wxBLACK_PEN).
             Padding(5, 5, 5, 5).
@@ -596,6 +733,35 @@ namespace Wisteria::Graphs
             ++currentRow;
             }
 
+        // if only showing a page of the data, then widen the columns to fit the values
+        // from the rest of the data also, so that the columns' widths don't change
+        // from page to page
+        if (IsVirtual() && GetRowCount() > 1 &&
+            GetColumnCount() == m_virtualColumnSamples.size())
+            {
+            for (size_t column = 0; column < GetColumnCount(); ++column)
+                {
+                // measure the samples formatted like the page's cells in this column
+                TableCell sampleCell = m_table[1][column];
+                if (sampleCell.m_columnCount > 1)
+                    { continue; }
+                for (const auto& value : m_virtualColumnSamples[column])
+                    {
+                    sampleCell.SetValue(value);
+                    const auto cellText = sampleCell.GetDisplayValue();
+                    measuringLabel.SetText(cellText.length() ? cellText : L" ");
+                    if (sampleCell.m_suggestedLineLength.has_value())
+                        {
+                        measuringLabel.SplitTextToFitLength(
+                            sampleCell.m_suggestedLineLength.value());
+                        }
+                    measuringLabel.SetFont(sampleCell.m_font);
+                    columnWidths[column] = std::max(
+                        measuringLabel.GetBoundingBox(dc).GetWidth(), columnWidths[column]);
+                    }
+                }
+            }
+
         auto tableWidth = std::accumulate(columnWidths.cbegin(), columnWidths.cend(), 0);
         auto tableHeight = std::accumulate(rowHeights.cbegin(), rowHeights.cend(), 0);
 
@@ -830,7 +996,7 @@ namespace Wisteria::Graphs
                 const wxRect boxRect(pts[0], pts[2]);
 
                 const auto cellText = cell.GetDisplayValue();
-                auto cellLabel = std::make_shared<Label>(
+                auto cellLabel = MakePlotObject<Label>(
                     GraphItemInfo(cellText.length() ? cellText : L" ").
                     Pen(wxNullPen).Padding(5, 5, 5, 5).
                     Scaling(GetScaling()).DPIScaling(GetDPIScaleFactor()).
@@ -914,8 +1080,8 @@ namespace Wisteria::Graphs
             ++currentRow;
             }
 
-        auto highlightedBorderLines = std::make_shared<Lines>(GetHighlightPen(), GetScaling());
-        auto borderLines = std::make_shared<Lines>(GetPen(), GetScaling());
+        auto highlightedBorderLines = MakePlotObject<Lines>(GetHighlightPen(), GetScaling());
+        auto borderLines = MakePlotObject<Lines>(GetPen(), GetScaling());
         currentRow = currentColumn = 0;
         currentXPos = drawArea.GetX();
         currentYPos = drawArea.GetY();
@@ -1087,7 +1253,7 @@ namespace Wisteria::Graphs
             std::sort(note.m_cells.begin(), note.m_cells.end(),
                 [](const auto& lv, const auto& rv) noexcept
                     { return lv.first < rv.first; });
-            auto noteConnectionLines = std::make_shared<Lines>(GetHighlightPen(), GetScaling());
+            auto noteConnectionLines = MakePlotObject<Lines>(GetHighlightPen(), GetScaling());
             wxCoord lowestY{ drawArea.GetBottom() }, highestY{ drawArea.GetTop() };
             auto gutterSide = DeduceGutterSide(note);
             if (gutterSide == Side::Right)
@@ -1114,7 +1280,7 @@ namespace Wisteria::Graphs
                     wxPoint(rightGutter.GetX() + connectionOverhangWidth*2, cellsYMiddle));
                 AddObject(noteConnectionLines);
                 // add the note into the gutter
-                auto noteLabel = std::make_shared<Label>(
+                auto noteLabel = MakePlotObject<Label>(
                     GraphItemInfo(note.m_note).
                     Pen(wxNullPen).
                     // use same text scale as the table (or 1.0 if the table font is really small)
@@ -1169,7 +1335,7 @@ namespace Wisteria::Graphs
                     wxPoint(leftGutter.GetRight() - connectionOverhangWidth *2, cellsYMiddle));
                 AddObject(noteConnectionLines);
                 // add the note into the gutter
-                auto noteLabel = std::make_shared<Label>(
+                auto noteLabel = MakePlotObject<Label>(
                     GraphItemInfo(note.m_note).
                     Pen(wxNullPen).
                     // use same text scale as the table
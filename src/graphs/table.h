@@ -14,6 +14,7 @@
 
 #include <vector>
 #include <variant>
+#include <execution>
 #include "graph2d.h"
 
 namespace Wisteria::Graphs
@@ -298,7 +299,10 @@ namespace Wisteria::Graphs
             /// @brief Sets the value.
             /// @param value The value to set for the cell.
             void SetValue(const CellValueType& value)
-                { m_value = value; }
+                {
+                m_value = value;
+                m_displayValueIsStale = true;
+                }
             /// @brief Sets the color.
             /// @param color The value to set for the cell.
             void SetBackgroundColor(const wxColour color)
@@ -357,6 +361,23 @@ namespace Wisteria::Graphs
             void ShowOuterRightBorder(const bool show)
                 { m_showOuterRightBorder = show; }
         private:
+            /// @brief Sets how the (numeric) value is displayed.
+            /// @param format The format to display the value with.
+            void SetFormat(const CellFormat format) noexcept
+                {
+                m_valueFormat = format;
+                m_displayValueIsStale = true;
+                }
+            /// @brief Sets the precision of the (numeric) value.
+            /// @param precision The precision.
+            void SetPrecision(const uint8_t precision) noexcept
+                {
+                m_precision = precision;
+                m_displayValueIsStale = true;
+                }
+            /// @returns The value formatted as it is displayed in the cell.
+            /// @note Prefer GetDisplayValue(), which caches this.
+            [[nodiscard]] wxString FormatDisplayValue() const;
             /// @brief Returns a double value representing the cell.
             /// @details This is useful for comparing cells (or aggregating them).
             /// @returns If numeric, returns the underlying double value.
@@ -392,6 +413,10 @@ namespace Wisteria::Graphs
             CellValueType m_value{ std::numeric_limits<double>::quiet_NaN() };
             CellFormat m_valueFormat{ CellFormat::General };
             uint8_t m_precision{ 0 };
+            // formatting numbers and dates is expensive and tables are laid out often,
+            // so the formatted value is cached until the value or its formatting changes
+            mutable wxString m_displayValue;
+            mutable bool m_displayValueIsStale{ true };
             wxColour m_bgColor{ *wxWHITE };
             wxFont m_font{ wxSystemSettings::GetFont(wxSYS_DEFAULT_GUI_FONT) };
             std::optional<PageHorizontalAlignment> m_horizontalCellAlignment;
@@ -425,6 +450,49 @@ namespace Wisteria::Graphs
         void SetData(const std::shared_ptr<const Data::Dataset>& data,
                      const std::initializer_list<wxString>& columns,
                      const bool transpose = false);
+        /** @brief Sets the data for the table, but only shows a page of its rows at a time.
+            @details This is meant for large datasets, where copying every value into a cell
+                (and measuring all of them) would be too expensive. Only a reference to the
+                dataset is kept, and only the rows on the current page are loaded into cells.\n
+                \n
+                So that the columns are the same width from page to page, their widths are
+                estimated from a sample of their values (along with their longest values).
+            @param data The data.
+            @param columns The columns to display in the table.\n
+                The columns will appear in the order that you specify here.
+            @param rowsPerPage The number of rows from the data to display at a time.
+            @throws std::runtime_error If any columns can't be found by name,
+                throws an exception.\n
+                The exception's @c what() message is UTF-8 encoded, so pass it to
+                @c wxString::FromUTF8() when formatting it for an error message.
+            @note The first row (the column names) is repeated on every page.\n
+                Any customizations to the cells (e.g., BoldRow() or GroupColumn()) only apply
+                to the current page, so they should be applied after calling SetPage().\n
+                Transposing the data is not supported here.
+            @sa SetPage(), GetPageCount().*/
+        void SetVirtualData(const std::shared_ptr<const Data::Dataset>& data,
+                            const std::initializer_list<wxString>& columns,
+                            const size_t rowsPerPage);
+        /// @returns @c true if the table is showing a page of its data at a time.
+        /// @sa SetVirtualData().
+        [[nodiscard]] bool IsVirtual() const noexcept
+            { return m_virtualData != nullptr; }
+        /** @brief Loads a page of rows from the data into the table.
+            @param page The (zero-based) page to display.\n
+                This will be clamped to the last page.
+            @note This is only relevant if data was set via SetVirtualData().*/
+        void SetPage(const size_t page);
+        /// @returns The (zero-based) page of rows being displayed.
+        [[nodiscard]] size_t GetPage() const noexcept
+            { return m_currentPage; }
+        /// @returns The number of pages of rows in the data,
+        ///     or @c 1 if not displaying the data a page at a time.
+        [[nodiscard]] size_t GetPageCount() const noexcept
+            {
+            return (IsVirtual() && m_virtualData->GetRowCount() > 0) ?
+                safe_divide(m_virtualData->GetRowCount() + m_rowsPerPage - 1, m_rowsPerPage) :
+                1;
+            }
 
         /// @name Table Functions
         /// @brief Functions for editing the table as a whole.
@@ -512,7 +580,7 @@ namespace Wisteria::Graphs
                         std::clamp<size_t>(rowIndex, 0, GetRowCount()),
                     std::vector<TableCell>(GetColumnCount(), TableCell()));
                 if (rowName.has_value())
-                    { insertedRow->at(0).m_value = rowName.value(); }
+                    { insertedRow->at(0).SetValue(rowName.value()); }
                 }
             }
         /// @brief Inserts an empty column at the given index.
@@ -536,7 +604,7 @@ namespace Wisteria::Graphs
                         TableCell());
                     }
                 if (colName.has_value())
-                    { m_table[0][colIndex].m_value = colName.value(); }
+                    { m_table[0][colIndex].SetValue(colName.value()); }
                 }
             }
         /** @brief Adds an aggregate (e.g., total) row to the end of the table.
@@ -641,7 +709,7 @@ namespace Wisteria::Graphs
                 {
                 auto& currentRow = m_table[row];
                 for (auto& cell : currentRow)
-                    { cell.m_precision = precision; }
+                    { cell.SetPrecision(precision); }
                 }
             }
         /** @brief Sets the specified column's precision.
@@ -654,7 +722,7 @@ namespace Wisteria::Graphs
                 for (auto& row : m_table)
                     {
                     if (column < row.size())
-                        { row[column].m_precision = precision; }
+                        { row[column].SetPrecision(precision); }
                     }
                 }
             }
@@ -815,12 +883,50 @@ namespace Wisteria::Graphs
         [[nodiscard]] std::optional<TableCell> GetParentColumnWiseCell(const size_t row,
                                                                        const size_t column);
 
+        /// @brief A running tally of a series of values, which all of the
+        ///     aggregate types can be calculated from.
+        /// @details This is filled in a single pass over the cells being aggregated,
+        ///     rather than collecting their values first.
+        struct AggregateValues
+            {
+            /// @brief Adds a cell's value to the tally (if it is a valid number).
+            /// @param cell The cell.
+            void Add(const TableCell& cell) noexcept
+                {
+                if (!cell.IsNumeric())
+                    { return; }
+                const auto value = cell.GetDoubleValue();
+                if (std::isnan(value))
+                    { return; }
+                if (m_count == 0)
+                    { m_first = value; }
+                m_last = value;
+                m_total += value;
+                ++m_count;
+                }
+            size_t m_count{ 0 };
+            double m_total{ 0 };
+            double m_first{ 0 };
+            double m_last{ 0 };
+            };
+
         /** @brief Calculates an aggregation from a series of values.
             @param aggInfo Which type of aggregate calculation to perform.
             @param aggCell The cell to place the result.
-            @param values The values for the calculation.*/
-        void CalculateAggregate(const AggregateInfo& aggInfo, TableCell& aggCell,
-                                const std::vector<double>& values);
+            @param values The tally of values for the calculation.*/
+        static void CalculateAggregate(const AggregateInfo& aggInfo, TableCell& aggCell,
+                                       const AggregateValues& values);
+
+        /** @brief Reads values from a column in a dataset.
+            @param data The dataset.
+            @param colName The name of the column.
+            @param rows The rows to read.
+            @returns The values (as they would appear in cells) from the given rows.
+            @throws std::runtime_error If the column can't be found.*/
+        [[nodiscard]] static std::vector<CellValueType> ReadColumnValues(
+            const Data::Dataset& data, const wxString& colName, const std::vector<size_t>& rows);
+        /// @brief Loads the current page of rows from the virtual data into the table.
+        void LoadVirtualPage();
 
         // DIPs for annotation connection lines and space between lines
         static constexpr wxCoord m_labelSpacingFromLine{ 5 };
@@ -832,6 +938,17 @@ namespace Wisteria::Graphs
 
         std::vector<CellAnnotation> m_cellAnnotations;
 
+        // virtual mode (only the current page of the dataset is loaded into cells)
+        std::shared_ptr<const Data::Dataset> m_virtualData;
+        std::vector<wxString> m_virtualColumns;
+        size_t m_rowsPerPage{ 1 };
+        size_t m_currentPage{ 0 };
+        // values from the rest of the data, for estimating the columns' widths
+        std::vector<std::vector<CellValueType>> m_virtualColumnSamples;
+        static constexpr size_t m_virtualSampleSize{ 100 };
+        // tables with at least this many cells have their values formatted in parallel
+        static constexpr size_t m_parallelFormatCellCount{ 1000 };
+
         wxPen m_highlightPen{ wxPen(*wxRED_PEN) };
 
         // cached values
@@ -13,6 +13,7 @@
 #define __TEXT_COLUMN_H__
 
 #include "text_functional.h"
+#include "text_scan.h"
 
 namespace lily_of_the_valley
     {
@@ -30,12 +31,36 @@ namespace lily_of_the_valley
             @returns The text after the column(s) that were just read.*/
         [[nodiscard]] virtual const wchar_t* operator()(const wchar_t* text) const noexcept
             {
+            return find_column_end(text,
+                [this](const wchar_t character) noexcept
+                    { return is_delimiter(character); });
+            }
+        /** @brief Indicates whether this parser is actually reading anything back into the parent parser.
+            @details If this is `false`, then the parser is simply skipping this column.
+            @returns `true` if text that is parsed for this column is fed back into the parent parser.*/
+        [[nodiscard]] inline bool is_reading_text() const noexcept
+            { return m_read_text; }
+        /** @brief Determines if a character is a delimiter.
+            @param character The character to review.
+            @returns `true` if @c character is a delimiter.*/
+        [[nodiscard]] virtual bool is_delimiter(const wchar_t character) const noexcept = 0;
+    protected:
+        /** @brief Reads to the end of the next column, using a delimiter functor.
+            @details Derived parsers call this with their own (non-virtual) functor,
+                so that checking each character doesn't go through a virtual call.
+            @param text The current row of text to parse.
+            @param is_delim The delimiter functor.
+            @returns The text after the column that was just read.*/
+        template<typename delimiter_functorT>
+        [[nodiscard]] inline const wchar_t* find_column_end(const wchar_t* text,
+                                                           const delimiter_functorT& is_delim) const noexcept
+            {
             if (text == nullptr || text[0] == 0)
                 { return nullptr; }
             int32_t quoteStack{ 0 };
             while (text[0] && !is_eol(text[0]) &&
                 // allow delims if inside of set of double quotes
-                (!is_delimiter(text[0]) || (quoteStack%2 != 0)))
+                (!is_delim(text[0]) || (quoteStack%2 != 0)))
                 {
                 if (text[0] == L'\"')
                     {
@@ -53,16 +78,6 @@ namespace lily_of_the_valley
                 }
             return text;
             }
-        /** @brief Indicates whether this parser is actually reading anything back into the parent parser.
-            @details If this is `false`, then the parser is simply skipping this column.
-            @returns `true` if text that is parsed for this column is fed back into the parent parser.*/
-        [[nodiscard]] inline bool is_reading_text() const noexcept
-            { return m_read_text; }
-        /** @brief Determines if a character is a delimiter.
-            @param character The character to review.
-            @returns `true` if @c character is a delimiter.*/
-        [[nodiscard]] virtual bool is_delimiter(const wchar_t character) const noexcept = 0;
-    protected:
         /// @brief Functor for determining and end-of-line.
         is_end_of_line is_eol;
     private:
@@ -113,6 +128,11 @@ namespace lily_of_the_valley
         explicit text_column_standard_delimiter_parser(const bool read_text = true) noexcept
             : text_column_parser(read_text)
             {}
+        /** @brief Reads the next column from the current row of text.
+            @param text The current row of text to parse.
+            @returns The text after the column that was just read.*/
+        [[nodiscard]] inline const wchar_t* operator()(const wchar_t* text) const noexcept final
+            { return find_column_end(text, is_delim); }
         /** @brief Determines if a character is a delimiter.
             @param character The character to review.
             @returns `true` if @c character is a delimiter.*/
@@ -131,8 +151,23 @@ namespace lily_of_the_valley
         /// @param read_text Set to `true` to feed the parsed text back to the parent parser,
         ///  or `false` to simply skip to the end of line.
         explicit text_column_delimited_character_parser(const wchar_t delim, const bool read_text = true) noexcept
-            : text_column_parser(read_text), is_delim(delim)
+            : text_column_parser(read_text), is_delim(delim), m_delim(delim)
             {}
+        /** @brief Reads the next column from the current row of text.
+            @details This scans for the delimiter (and quotes and line endings)
+                several characters at a time.
+            @param text The current row of text to parse.
+            @returns The text after the column that was just read.*/
+        [[nodiscard]] inline const wchar_t* operator()(const wchar_t* text) const noexcept final
+            {
+            if (text == nullptr || text[0] == 0)
+                { return nullptr; }
+            // a delimiter that is also a quote or line ending would be ambiguous,
+            // so let the general parser handle that the way it always has
+            if (m_delim == L'\"' || is_eol(m_delim) || m_delim == 0)
+                { return find_column_end(text, is_delim); }
+            return text_scan::find_field_end(text, m_delim);
+            }
         /** @brief Determines if a character is a delimiter.
             @param character The character to review.
             @returns `true` if @c character is a delimiter.*/
@@ -140,6 +175,7 @@ namespace lily_of_the_valley
             { return is_delim(character); }
     private:
         is_single_delimiter is_delim;
+        wchar_t m_delim{ L';' };
         };
 
     /// @brief Parser that finds a single-character delimiter from a set of possible characters.
@@ -153,6 +189,11 @@ namespace lily_of_the_valley
         explicit text_column_delimited_multiple_character_parser(const wchar_t* delims, const bool read_text = true)
             : text_column_parser(read_text), is_delim(delims)
             {}
+        /** @brief Reads the next column from the current row of text.
+            @param text The current row of text to parse.
+            @returns The text after the column that was just read.*/
+        [[nodiscard]] inline const wchar_t* operator()(const wchar_t* text) const noexcept final
+            { return find_column_end(text, is_delim); }
         /** @brief Determines if a character is a delimiter.
             @param character The character to review.
             @returns `true` if @c character is a delimiter.*/
@@ -208,7 +249,9 @@ namespace lily_of_the_valley
             @returns The text after the column(s) that were just read.*/
         [[nodiscard]] inline const wchar_t* read(const wchar_t* text)
             {
-            const wchar_t* end = m_parser(text);
+            // the parser's type is known here, so call its scanner directly
+            // (rather than through the vtable) for every field
+            const wchar_t* end = m_parser.Tparser::operator()(text);
             /* if this is null then we are at the end of the file,
                so just copy over the rest of the file into this column*/
             if (end == nullptr)
@@ -66,7 +66,32 @@ namespace lily_of_the_valley
         size_t read(const wchar_t* text, const size_t row_count, const size_t column_count,
                     const bool ignore_blank_lines = false)
             {
-            if (text == nullptr || text[0] == 0 || row_count == 0)
+            if (row_count == 0)
+                { return 0; }
+            return read_rows(text, row_count, column_count, ignore_blank_lines, 0);
+            }
+        /** @brief Reads a block of text and divides it up into columns & rows, adding
+             rows as they are read (until the end of the text is reached).
+            @details Unlike read(), the number of rows does not need to be known ahead of time,
+             so a separate pass of the text (e.g., with text_preview) is not needed.
+            @param text The text to parser and import tabular data from.
+            @param column_count The number of columns to import. Note that this will be overridden
+             if any row definitions allow for dynamic column growth.
+            @param ignore_blank_lines Whether blank lines should be skipped.
+            @param row_count_hint The estimated number of rows, which is used to
+             reserve space for the rows up front. This is optional, but will reduce
+             reallocations if it is close to the actual number of rows.
+            @returns The number of rows read.*/
+        size_t read_all(const wchar_t* text, const size_t column_count,
+                        const bool ignore_blank_lines = false,
+                        const size_t row_count_hint = 0)
+            { return read_rows(text, std::nullopt, column_count, ignore_blank_lines, row_count_hint); }
+    private:
+        size_t read_rows(const wchar_t* text, const std::optional<size_t> row_count,
+                         const size_t column_count, const bool ignore_blank_lines,
+                         const size_t row_count_hint)
+            {
+            if (text == nullptr || text[0] == 0)
                 { return 0; }
             const wchar_t* currentPosition = text;
             size_t currentRowIndex = 0;
@@ -74,12 +99,18 @@ namespace lily_of_the_valley
             if (m_matrix)
                 {
                 m_matrix->clear();
-                m_matrix->resize(row_count);
+                if (row_count)
+                    { m_matrix->resize(row_count.value()); }
+                else
+                    { m_matrix->reserve(row_count_hint); }
                 }
             else
                 {
                 m_vector->clear();
-                m_vector->resize(row_count);
+                if (row_count)
+                    { m_vector->resize(row_count.value()); }
+                else
+                    { m_vector->reserve(row_count_hint); }
                 }
             for (auto pos = m_rows.begin();
                 pos != m_rows.end();
@@ -90,8 +121,14 @@ namespace lily_of_the_valley
                     (!pos->get_repeat_count() ? true : i < pos->get_repeat_count().value());
                     ++i)
                     {
-                    if (currentRowIndex >= row_count)
+                    if (row_count && currentRowIndex >= row_count.value())
                         { return currentRowIndex; }
+                    // if reading until the end of the text, then add a new row
+                    // (it will be trimmed off at the end if nothing gets read into it)
+                    if (m_matrix && currentRowIndex >= m_matrix->size())
+                        { m_matrix->resize(currentRowIndex + 1); }
+                    else if (!m_matrix && currentRowIndex >= m_vector->size())
+                        { m_vector->resize(currentRowIndex + 1); }
                     if (m_matrix)
                         {
                         m_matrix->at(currentRowIndex).resize(column_count);
@@ -236,7 +273,7 @@ namespace lily_of_the_valley
                 { m_vector->resize(currentRowIndex); }
             return currentRowIndex;
             }
-    private:
+
         std::vector<std::vector<string_typeT>>* m_matrix{ nullptr };
         std::vector<string_typeT>* m_vector{ nullptr };
         std::vector<text_row<string_typeT>> m_rows;
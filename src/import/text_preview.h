@@ -49,16 +49,7 @@ namespace lily_of_the_valley
             if (text == nullptr || text[0] == 0)
                 { return 0; }
 
-            standard_delimited_character_column deliminatedColumn(
-                text_column_delimited_character_parser{ headerRowDelimiter });
-            text_row<std::wstring> headerRow(1);
-            headerRow.add_column(deliminatedColumn);
-            headerRow.set_values(&m_header_names);
-            headerRow.allow_column_resizing(true);
-            headerRow.read(text);
-            cell_collapse_quotes<std::wstring> collapseQuotes;
-            for (auto& header : m_header_names)
-                { header = collapseQuotes(header); }
+            read_header(text, headerRowDelimiter);
 
             const wchar_t* currentPos = text;
             const wchar_t* lineStart = nullptr;
@@ -100,6 +91,33 @@ namespace lily_of_the_valley
                 }
             return m_row_count;
             }
+        /** @brief Reads only the column names from the first line of a file.
+            @details This is useful for when the number of rows doesn't need to be known
+             ahead of time (e.g., when using text_matrix::read_all()), as it avoids
+             scanning the rest of the file.
+            @param text A wide character stream t to parse.
+            @param headerRowDelimiter The delimiter to use to determine the number of columns when
+             parsing the header.
+            @returns The number of columns read from the header.
+             Call get_header_names() to retrieve the column names.*/
+        size_t read_header(const wchar_t* text, const wchar_t headerRowDelimiter)
+            {
+            m_header_names.clear();
+            if (text == nullptr || text[0] == 0)
+                { return 0; }
+
+            standard_delimited_character_column deliminatedColumn(
+                text_column_delimited_character_parser{ headerRowDelimiter });
+            text_row<std::wstring> headerRow(1);
+            headerRow.add_column(deliminatedColumn);
+            headerRow.set_values(&m_header_names);
+            headerRow.allow_column_resizing(true);
+            headerRow.read(text);
+            cell_collapse_quotes<std::wstring> collapseQuotes;
+            for (auto& header : m_header_names)
+                { header = collapseQuotes(header); }
+            return m_header_names.size();
+            }
         /// @returns The number of rows from the last preview.
         [[nodiscard]] size_t get_row_count() const noexcept
             { return m_row_count; }
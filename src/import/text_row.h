@@ -158,7 +158,9 @@ namespace lily_of_the_valley
                            Enable column count resizing to change that.*/
                         if (m_values)
                             {
-                            if (currentColumnIndex >= m_values->size())
+                            if (currentColumnIndex >= m_values->size() &&
+                                // skipped columns aren't written anywhere
+                                currentColumnIter->get_parser().is_reading_text())
                                 {
                                 if (is_column_resizing_enabled())
                                     { m_values->resize(m_values->size()+1); }
@@ -244,7 +246,9 @@ namespace lily_of_the_valley
                            Enable column count resizing to change that.*/
                         if (m_values)
                             {
-                            if (currentColumnIndex >= m_values->size())
+                            if (currentColumnIndex >= m_values->size() &&
+                                // skipped columns aren't written anywhere
+                                currentColumnIter->get_parser().is_reading_text())
                                 {
                                 if (is_column_resizing_enabled())
                                     { m_values->resize(m_values->size()+1); }
@@ -330,7 +334,9 @@ namespace lily_of_the_valley
                            Enable column count resizing to change that.*/
                         if (m_values)
                             {
-                            if (currentColumnIndex >= m_values->size())
+                            if (currentColumnIndex >= m_values->size() &&
+                                // skipped columns aren't written anywhere
+                                currentColumnIter->get_parser().is_reading_text())
                                 {
                                 if (is_column_resizing_enabled())
                                     { m_values->resize(m_values->size()+1); }
@@ -415,7 +421,9 @@ namespace lily_of_the_valley
                            Enable column count resizing to change that.*/
                         if (m_values)
                             {
-                            if (currentColumnIndex >= m_values->size())
+                            if (currentColumnIndex >= m_values->size() &&
+                                // skipped columns aren't written anywhere
+                                currentColumnIter->get_parser().is_reading_text())
                                 {
                                 if (is_column_resizing_enabled())
                                     { m_values->resize(m_values->size()+1); }
@@ -489,7 +497,9 @@ namespace lily_of_the_valley
                        Enable column count resizing to change that.*/
                     if (m_values)
                         {
-                        if (currentColumnIndex >= m_values->size())
+                        if (currentColumnIndex >= m_values->size() &&
+                            // skipped columns aren't written anywhere
+                            currentColumnIter->get_parser().is_reading_text())
                             {
                             if (is_column_resizing_enabled())
                                 { m_values->resize(m_values->size()+1); }
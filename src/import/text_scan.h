@@ -0,0 +1,197 @@
+/** @addtogroup Importing
+    @brief Classes for importing data.
+    @date 2005-2022
+    @copyright Blake Madden
+    @author Blake Madden
+    @details This program is free software; you can redistribute it and/or modify
+     it under the terms of the 3-Clause BSD License.
+
+     SPDX-License-Identifier: BSD-3-Clause
+@{*/
+
+#ifndef __TEXT_SCAN_H__
+#define __TEXT_SCAN_H__
+
+#include <cstddef>
+#include <cstdint>
+
+// the block reads may go past the end of the buffer (harmlessly), which address
+// sanitizers would report, so only check one character at a time when sanitizing
+#if defined(__SANITIZE_ADDRESS__)
+    #define TEXT_SCAN_SANITIZING
+#elif defined(__has_feature)
+    #if __has_feature(address_sanitizer)
+        #define TEXT_SCAN_SANITIZING
+    #endif
+#endif
+
+#if defined(TEXT_SCAN_SANITIZING)
+    // scalar scanning only
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define TEXT_SCAN_SSE2
+    #include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    #define TEXT_SCAN_NEON
+    #include <arm_neon.h>
+#endif
+
+namespace lily_of_the_valley
+    {
+    /** @brief Vectorized scanning of delimited text (e.g., CSV files).
+        @details These work on null-terminated @c wchar_t buffers (what the column parsers read),
+            and check 16 bytes at a time (with SSE2 or NEON, falling back to checking
+            one character at a time on other CPUs) for the characters that can end
+            a field: the delimiter, a quote, a carriage return, a line feed,
+            or the null terminator.
+        @note Like @c strlen(), the vectorized scans may read past the null terminator,
+            but only within the same aligned 16-byte block (which can't cross a page).*/
+    namespace text_scan
+        {
+        /// @private
+        [[nodiscard]] inline constexpr bool is_field_boundary(const wchar_t character,
+                                                              const wchar_t delim) noexcept
+            {
+            return (character == delim || character == 0 || character == 10 ||
+                    character == 13 || character == 0x22 /* quote */);
+            }
+
+#if defined(TEXT_SCAN_SSE2)
+        /// @private
+        [[nodiscard]] inline __m128i splat(const wchar_t character) noexcept
+            {
+            // wchar_t is 16-bit on Windows and 32-bit elsewhere
+            if constexpr (sizeof(wchar_t) == 2)
+                { return _mm_set1_epi16(static_cast<short>(character)); }
+            else
+                { return _mm_set1_epi32(static_cast<int>(character)); }
+            }
+        /// @private
+        [[nodiscard]] inline __m128i equals(const __m128i lhv, const __m128i rhv) noexcept
+            {
+            if constexpr (sizeof(wchar_t) == 2)
+                { return _mm_cmpeq_epi16(lhv, rhv); }
+            else
+                { return _mm_cmpeq_epi32(lhv, rhv); }
+            }
+#elif defined(TEXT_SCAN_NEON)
+        /// @private
+        [[nodiscard]] inline uint8x16_t splat(const wchar_t character) noexcept
+            {
+            // wchar_t is 16-bit on Windows and 32-bit elsewhere
+            if constexpr (sizeof(wchar_t) == 2)
+                { return vreinterpretq_u8_u16(vdupq_n_u16(static_cast<uint16_t>(character))); }
+            else
+                { return vreinterpretq_u8_u32(vdupq_n_u32(static_cast<uint32_t>(character))); }
+            }
+        /// @private
+        [[nodiscard]] inline uint8x16_t equals(const uint8x16_t lhv, const uint8x16_t rhv) noexcept
+            {
+            if constexpr (sizeof(wchar_t) == 2)
+                {
+                return vreinterpretq_u8_u16(
+                    vceqq_u16(vreinterpretq_u16_u8(lhv), vreinterpretq_u16_u8(rhv)));
+                }
+            else
+                {
+                return vreinterpretq_u8_u32(
+                    vceqq_u32(vreinterpretq_u32_u8(lhv), vreinterpretq_u32_u8(rhv)));
+                }
+            }
+#endif
+
+        /** @brief Finds the first delimiter, quote, carriage return, line feed,
+                or null terminator in a string.
+            @param text The (null-terminated) text to scan.
+            @param delim The delimiter.
+            @returns A pointer to the first of those characters (which will be the
+                null terminator if none of the others are found).*/
+        [[nodiscard]] inline const wchar_t* find_field_boundary(const wchar_t* text,
+                                                                const wchar_t delim) noexcept
+            {
+#if defined(TEXT_SCAN_SSE2) || defined(TEXT_SCAN_NEON)
+            constexpr size_t blockSize{ 16 };
+            // step through the start until the text is aligned,
+            // so that the block reads never cross into another page
+            while ((reinterpret_cast<uintptr_t>(text) % blockSize) != 0)
+                {
+                if (is_field_boundary(text[0], delim))
+                    { return text; }
+                ++text;
+                }
+            const auto delims = splat(delim);
+            const auto quotes = splat(static_cast<wchar_t>(0x22));
+            const auto carriageReturns = splat(static_cast<wchar_t>(13));
+            const auto lineFeeds = splat(static_cast<wchar_t>(10));
+            const auto terminators = splat(static_cast<wchar_t>(0));
+            for (;;)
+                {
+    #if defined(TEXT_SCAN_SSE2)
+                const __m128i block = _mm_load_si128(reinterpret_cast<const __m128i*>(text));
+                const __m128i matches =
+                    _mm_or_si128(_mm_or_si128(equals(block, delims),
+                                              equals(block, quotes)),
+                                 _mm_or_si128(_mm_or_si128(equals(block, carriageReturns),
+                                                           equals(block, lineFeeds)),
+                                              equals(block, terminators)));
+                const bool found = (_mm_movemask_epi8(matches) != 0);
+    #else
+                const uint8x16_t block = vld1q_u8(reinterpret_cast<const uint8_t*>(text));
+                const uint8x16_t matches =
+                    vorrq_u8(vorrq_u8(equals(block, delims),
+                                      equals(block, quotes)),
+                             vorrq_u8(vorrq_u8(equals(block, carriageReturns),
+                                               equals(block, lineFeeds)),
+                                      equals(block, terminators)));
+                const bool found = (vmaxvq_u8(matches) != 0);
+    #endif
+                if (found)
+                    {
+                    // find which character in the block it was
+                    while (!is_field_boundary(text[0], delim))
+                        { ++text; }
+                    return text;
+                    }
+                text += blockSize / sizeof(wchar_t);
+                }
+#else
+            while (!is_field_boundary(text[0], delim))
+                { ++text; }
+            return text;
+#endif
+            }
+
+        /** @brief Finds the end of a delimited field.
+            @details Delimiters inside of quotes are part of the field, and doubled
+                (i.e., escaped) quotes are stepped over. A field always ends at the end of
+                the line (even inside of quotes).
+            @param text The (null-terminated) text to scan, starting at the field.
+            @param delim The delimiter.
+            @returns A pointer to the delimiter, end of line, or null terminator
+                that ended the field.*/
+        [[nodiscard]] inline const wchar_t* find_field_end(const wchar_t* text,
+                                                           const wchar_t delim) noexcept
+            {
+            constexpr wchar_t quote{ 0x22 };
+            bool insideQuotes{ false };
+            for (;;)
+                {
+                // inside of quotes, only a quote or the end of the line will stop the scan
+                text = find_field_boundary(text, insideQuotes ? quote : delim);
+                if (text[0] != quote)
+                    { return text; }
+                // just step over doubled up (i.e., escaped) quote
+                if (text[1] == quote)
+                    { text += 2; }
+                else
+                    {
+                    ++text;
+                    insideQuotes = !insideQuotes;
+                    }
+                }
+            }
+        }
+    }
+
+/** @}*/
+
+#endif //__TEXT_SCAN_H__
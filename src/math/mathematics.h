@@ -247,6 +247,21 @@ inline void split_int64(const uint64_t value, uint32_t& lowHalf, uint32_t& highH
     lowHalf = static_cast<uint32_t>(value);
     }
 
+/// @returns The number of bits set in a 64-bit integer (i.e., its population count).
+/// @param value The value to review.
+[[nodiscard]] inline size_t count_bits(const uint64_t value) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<size_t>(__builtin_popcountll(value));
+#else
+    // SWAR (SIMD within a register) bit counting
+    uint64_t bits = value - ((value >> 1) & 0x5555555555555555ULL);
+    bits = (bits & 0x3333333333333333ULL) + ((bits >> 2) & 0x3333333333333333ULL);
+    bits = (bits + (bits >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return static_cast<size_t>((bits * 0x0101010101010101ULL) >> 56);
+#endif
+    }
+
 /// @returns The mantissa (floating-point value beyond the decimal) of a double value.
 /// @param value The value to review.
 [[nodiscard]] inline double get_mantissa(const double value) noexcept
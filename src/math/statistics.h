@@ -18,8 +18,11 @@
 #include <limits>
 #include <cmath>
 #include <vector>
+#include <array>
+#include <cstdint>
 #include <map>
 #include <execution>
+#include <random>
 #include "mathematics.h"
 #include "safe_math.h"
 #include "../util/frequency_set.h"
@@ -39,42 +42,51 @@ namespace statistics
                 { return initVal + (std::isnan(val) ? 0 : 1); }));
         }
 
+    /** @private
+        @brief Collects the value(s) with the highest count from a frequency table
+         in a single pass.
+        @param groups The values and their frequency counts.
+        @returns The most frequent value(s).*/
+    template <typename T, typename mapT>
+    [[nodiscard]] std::set<T> modes_from_frequencies(const mapT& groups)
+        {
+        size_t modeGroupSize{ 0 };
+        std::vector<T> modes;
+        for (const auto& [value, count] : groups)
+            {
+            if (count > modeGroupSize)
+                {
+                modeGroupSize = count;
+                modes.clear();
+                modes.push_back(value);
+                }
+            else if (count == modeGroupSize)
+                { modes.push_back(value); }
+            }
+        return std::set<T>(modes.cbegin(), modes.cend());
+        }
+
     /** @brief Calculates the mode(s) (most repeated value) from a specified range.
         @param data The data to analyze.
         @returns A set containing all modes from a specified range.
          In the case of a tie, multiple modes will be returned.
+        @note Arithmetic values are counted in a hash table; the highest count
+         (and any ties) are then found in one pass over the table.
+         For large numeric vectors, mode_sorted() may be faster.
         @warning If analyzing floating-point data, NaN should be removed prior to calling this.*/
     template <typename T>
     [[nodiscard]] std::set<T> mode(const std::vector<T>& data)
         {
-        std::set<T> modes;
         if (data.size() == 0)
-            { return modes; }
-        frequency_set<T> groups;
-        // this will sort the larger items to the front
-        std::multimap<size_t, T, std::greater<size_t>> groupsByCount;
+            { return std::set<T>(); }
+        using storage_type = std::conditional_t<std::is_arithmetic_v<T>,
+                                                frequency_storage::hash_storage,
+                                                frequency_storage::ordered_storage>;
+        frequency_set<T, std::less<T>, storage_type> groups;
         // look at the full range of the data, not just non-NaN
         for (const auto& val : data)
             { groups.insert(val); }
-        // flip the groupings so that the size of each group is the first element
-        for (auto pos = groups.get_data().cbegin();
-            pos != groups.get_data().cend();
-            ++pos)
-            { groupsByCount.emplace(pos->second, pos->first); }
-        // start at the most frequent group and work forwards to get any other modes that have the same count
-        if (groupsByCount.size())
-            {
-            const size_t modeGroupSize = groupsByCount.cbegin()->first;
-            for (auto groupsIter = groupsByCount.cbegin(); groupsIter != groupsByCount.cend(); ++groupsIter)
-                {
-                if (groupsIter->first == modeGroupSize)
-                    { modes.insert(groupsIter->second); }
-                else
-                    { break; }
-                }
-            }
-
-        return modes;
+        return modes_from_frequencies<T>(groups.get_data());
         }
 
     /** @brief Calculates the mode(s) (most repeated value) from a specified range.
@@ -87,36 +99,63 @@ namespace statistics
     template <typename T, typename predicateT>
     [[nodiscard]] std::set<T> mode(const std::vector<T>& data, predicateT transformValue)
         {
-        std::set<T> modes;
         if (data.size() == 0)
-            { return modes; }
-        frequency_set<T> groups;
-        // this will sort the larger items to the front
-        std::multimap<size_t, T, std::greater<size_t>> groupsByCount;
+            { return std::set<T>(); }
+        using storage_type = std::conditional_t<std::is_arithmetic_v<T>,
+                                                frequency_storage::hash_storage,
+                                                frequency_storage::ordered_storage>;
+        frequency_set<T, std::less<T>, storage_type> groups;
         // look at the full range of the data, not just non-NaN
         for (const auto& val : data)
             { groups.insert(transformValue(val)); }
-        // flip the groupings so that the size of each group is the first element
-        for (auto pos = groups.get_data().cbegin();
-            pos != groups.get_data().cend();
-            ++pos)
-            { groupsByCount.emplace(pos->second, pos->first); }
-        // start at the most frequent group and work forwards to get any other modes that have the same count
-        if (groupsByCount.size())
-            {
-            const size_t modeGroupSize = groupsByCount.cbegin()->first;
-            for (auto groupsIter = groupsByCount.cbegin();
-                groupsIter != groupsByCount.cend();
-                ++groupsIter)
-                {
-                if (groupsIter->first == modeGroupSize)
-                    { modes.insert(groupsIter->second); }
-                else
-                    { break; }
-                }
+        return modes_from_frequencies<T>(groups.get_data());
+        }
+
+    /** @brief Calculates the mode(s) (most repeated value) from a range of numbers
+         by sorting a copy of it and measuring the runs of equal values.
+        @details This avoids building a frequency table at all and is usually the fastest
+         approach for large numeric vectors with many unique values.
+        @param data The data to analyze.
+        @returns A set containing all modes from a specified range.
+         In the case of a tie, multiple modes will be returned.
+        @note NaN values are ignored.*/
+    template <typename T>
+    [[nodiscard]] std::set<T> mode_sorted(const std::vector<T>& data)
+        {
+        static_assert(std::is_arithmetic_v<T>, "mode_sorted() requires numeric data.");
+        std::vector<T> sortedData;
+        sortedData.reserve(data.size());
+        if constexpr (std::is_floating_point_v<T>)
+            {
+            std::copy_if(data.cbegin(), data.cend(), std::back_inserter(sortedData),
+                [](const auto val) noexcept { return !std::isnan(val); });
             }
+        else
+            { sortedData.assign(data.cbegin(), data.cend()); }
+        if (sortedData.size() == 0)
+            { return std::set<T>(); }
+        std::sort(sortedData.begin(), sortedData.end());
 
-        return modes;
+        size_t modeGroupSize{ 0 };
+        std::vector<T> modes;
+        auto runStart = sortedData.cbegin();
+        while (runStart != sortedData.cend())
+            {
+            const auto runEnd = std::find_if(runStart, sortedData.cend(),
+                [runValue = *runStart](const auto val) noexcept { return val != runValue; });
+            const auto runLength = static_cast<size_t>(std::distance(runStart, runEnd));
+            if (runLength > modeGroupSize)
+                {
+                modeGroupSize = runLength;
+                modes.clear();
+                modes.push_back(*runStart);
+                }
+            else if (runLength == modeGroupSize)
+                { modes.push_back(*runStart); }
+            runStart = runEnd;
+            }
+        // runs are visited in ascending order, so the modes are already sorted
+        return std::set<T>(modes.cbegin(), modes.cend());
         }
 
     /** @returns The means (average) value from the specified range.
@@ -165,19 +204,207 @@ namespace statistics
     [[nodiscard]] inline double median_presorted(const std::vector<double>& data)
         { return median_presorted(data.cbegin(), data.cend()); }
 
+    /** @brief Partially reorders a range so that the values at the specified positions
+         are the same as they would be if the range was sorted.
+        @details This uses @c std::nth_element() (introselect) for the middle position,
+         and then recursively selects the positions on either side of it within
+         their respective partitions. This is much faster than sorting when only a few
+         order statistics (e.g., quartiles) are needed.
+        @param first The start of the range.
+        @param last The end of the range.
+        @param firstPosition The start of the (sorted, unique) positions to select.
+        @param lastPosition The end of the positions to select.
+        @param offset The position of @c first in the full range.*/
+    inline void select_positions(const std::vector<double>::iterator first,
+                                 const std::vector<double>::iterator last,
+                                 const std::vector<size_t>::const_iterator firstPosition,
+                                 const std::vector<size_t>::const_iterator lastPosition,
+                                 const size_t offset)
+        {
+        if (firstPosition == lastPosition || first == last)
+            { return; }
+        const auto middlePosition = firstPosition + (std::distance(firstPosition, lastPosition) / 2);
+        const auto nth = first + (*middlePosition - offset);
+        std::nth_element(first, nth, last);
+        select_positions(first, nth, firstPosition, middlePosition, offset);
+        select_positions(nth + 1, last, middlePosition + 1, lastPosition, *middlePosition + 1);
+        }
+
+    /** @brief Partially reorders data so that the values at the specified positions
+         are the same as they would be if the data was sorted.
+        @details Afterwards, the order statistics can be read from the data
+         at those positions (e.g., `data[positions[0]]`).
+        @param[in,out] data The data to partially reorder (usually a scratch buffer).
+        @param positions The (zero-based) positions that are needed.
+        @warning NaN values should be removed from the input prior to calling this.*/
+    inline void select_order_statistics(std::vector<double>& data, std::vector<size_t> positions)
+        {
+        std::sort(positions.begin(), positions.end());
+        positions.erase(std::unique(positions.begin(), positions.end()), positions.end());
+        positions.erase(std::lower_bound(positions.begin(), positions.end(), data.size()),
+                        positions.end());
+        select_positions(data.begin(), data.end(), positions.cbegin(), positions.cend(), 0);
+        }
+
+    /** @returns The position(s) of the median of a range within sorted data
+         (which will be the same position if the range's length is odd).
+        @details This is a helper for finding the positions to pass to select_order_statistics().
+        @param start The start of the range.
+        @param length The length of the range.*/
+    [[nodiscard]] inline std::pair<size_t, size_t> median_positions(const size_t start,
+                                                                   const size_t length) noexcept
+        { return std::make_pair(start + ((length - 1) / 2), start + (length / 2)); }
+
     /** @returns The median value from the specified range.
-        @param data The data to analyze.*/
-    [[nodiscard]] inline double median(const std::vector<double>& data)
+        @param[in,out] data The data to analyze, which will be partially reordered.
+         This is meant to be a scratch buffer that can be reused.
+        @warning NaN values should be removed from the input prior to calling this.*/
+    [[nodiscard]] inline double median_unsorted(std::vector<double>& data)
         {
-        std::vector<double> dest;
-        dest.reserve(data.size());
+        if (data.empty())
+            { throw std::invalid_argument("No observations in median calculation."); }
+        const auto [lower, upper] = median_positions(0, data.size());
+        select_order_statistics(data, { lower, upper });
+        return (lower == upper) ? data[lower] : (data[lower] + data[upper]) / static_cast<double>(2);
+        }
+
+    /** @returns The median value from the specified range.
+        @param data The data to analyze.
+        @param[out] buffer A scratch buffer that the valid (i.e., non-NaN) values are copied into.
+         This can be reused between calls to avoid reallocating it.*/
+    [[nodiscard]] inline double median(const std::vector<double>& data, std::vector<double>& buffer)
+        {
+        buffer.clear();
+        buffer.reserve(data.size());
         // don't copy NaN into buffer
         std::copy_if(data.cbegin(), data.cend(),
-            std::back_inserter(dest),
+            std::back_inserter(buffer),
             [](const auto val) noexcept
               { return !std::isnan(val); });
-        std::sort(std::execution::par, dest.begin(), dest.end());
-        return median_presorted(dest);
+        return median_unsorted(buffer);
+        }
+
+    /** @returns The median value from the specified range.
+        @param data The data to analyze.*/
+    [[nodiscard]] inline double median(const std::vector<double>& data)
+        {
+        std::vector<double> dest;
+        return median(data, dest);
+        }
+
+    /// @brief The count, mean, and central moment sums of a range of data.
+    /// @details This is the result of calculate_moments() and can be passed to
+    ///  variance(), standard_deviation(), etc. to calculate multiple statistics
+    ///  from a single pass over the data.
+    struct moments
+        {
+        /// @brief The valid (non-NaN) number of observations.
+        size_t n{ 0 };
+        /// @brief The mean of the valid observations.
+        double mean{ 0 };
+        /// @brief The sum of squared deviations from the mean.
+        double m2{ 0 };
+        /// @brief The sum of cubed deviations from the mean.
+        double m3{ 0 };
+        /// @brief The sum of deviations from the mean raised to the fourth power.
+        double m4{ 0 };
+
+        /** @brief Combines the moments of another range of data into these moments.
+            @param that The moments of the other range.
+            @returns A self reference.
+            @note This uses Pébay's pairwise update formulas, which are numerically stable.*/
+        moments& merge(const moments& that) noexcept
+            {
+            if (that.n == 0)
+                { return *this; }
+            if (n == 0)
+                {
+                *this = that;
+                return *this;
+                }
+            const double nA = static_cast<double>(n);
+            const double nB = static_cast<double>(that.n);
+            const double nAB = nA + nB;
+            const double delta = that.mean - mean;
+            const double delta2 = delta * delta;
+            const double deltaN = delta / nAB;
+
+            m4 += that.m4 +
+                (delta2 * delta2 * nA * nB * (nA * nA - nA * nB + nB * nB)) / (nAB * nAB * nAB) +
+                (6 * delta2 * (nA * nA * that.m2 + nB * nB * m2)) / (nAB * nAB) +
+                (4 * deltaN * (nA * that.m3 - nB * m3));
+            m3 += that.m3 +
+                (delta2 * delta * nA * nB * (nA - nB)) / (nAB * nAB) +
+                (3 * deltaN * (nA * that.m2 - nB * m2));
+            m2 += that.m2 + (delta2 * nA * nB) / nAB;
+            mean += deltaN * nB;
+            n += that.n;
+            return *this;
+            }
+        /** @brief Adds a value to these moments.
+            @param value The value to add (should not be NaN).
+            @returns A self reference.
+            @note This is an incremental update (i.e., Welford's method extended to
+             the third and fourth moments), so the moments of a range that is
+             appended to do not need to be recalculated from all of its data.*/
+        moments& add(const double value) noexcept
+            {
+            const double nA = static_cast<double>(n);
+            const double nAB = nA + 1;
+            const double delta = value - mean;
+            const double deltaN = delta / nAB;
+            const double deltaN2 = deltaN * deltaN;
+            const double term1 = delta * deltaN * nA;
+            m4 += term1 * deltaN2 * (nAB * nAB - 3 * nAB + 3) + 6 * deltaN2 * m2 - 4 * deltaN * m3;
+            m3 += term1 * deltaN * (nAB - 2) - 3 * deltaN * m2;
+            m2 += term1;
+            mean += deltaN;
+            ++n;
+            return *this;
+            }
+        };
+
+    /** @brief Calculates the count, mean, and central moment sums from the specified range
+         in a single pass.
+        @details The data is processed in small blocks (that stay in the cache), where the mean
+         and deviations of each block are calculated with branchless loops that the compiler can
+         vectorize. The blocks are then merged together with moments::merge().
+        @param data The data to analyze. NaN values are ignored.
+        @returns The moments of the data.*/
+    [[nodiscard]] inline moments calculate_moments(const std::vector<double>& data) noexcept
+        {
+        constexpr size_t blockSize{ 512 };
+        moments results;
+        for (size_t blockStart = 0; blockStart < data.size(); blockStart += blockSize)
+            {
+            const double* block = data.data() + blockStart;
+            const size_t blockLength = std::min(blockSize, data.size() - blockStart);
+
+            size_t blockN{ 0 };
+            double blockSum{ 0 };
+            for (size_t i = 0; i < blockLength; ++i)
+                {
+                const bool isValid = !std::isnan(block[i]);
+                blockN += isValid ? 1 : 0;
+                blockSum += isValid ? block[i] : 0.0;
+                }
+            if (blockN == 0)
+                { continue; }
+
+            moments blockMoments;
+            blockMoments.n = blockN;
+            blockMoments.mean = blockSum / static_cast<double>(blockN);
+            for (size_t i = 0; i < blockLength; ++i)
+                {
+                const double deviation = std::isnan(block[i]) ? 0.0 : (block[i] - blockMoments.mean);
+                const double deviation2 = deviation * deviation;
+                blockMoments.m2 += deviation2;
+                blockMoments.m3 += deviation2 * deviation;
+                blockMoments.m4 += deviation2 * deviation2;
+                }
+            results.merge(blockMoments);
+            }
+        return results;
         }
 
     /** @returns The sum of squares/cubes/etc. from the specified range.
@@ -199,13 +426,13 @@ namespace statistics
         }
 
     /** @returns The variance from the specified range.
-        @param data The data to analyze.
+        @param data The moments of the data to analyze (see calculate_moments()).
         @param is_sample Set to @c true to use sample variance (i.e., N-1).*/
-    [[nodiscard]] inline double variance(const std::vector<double>& data, const bool is_sample)
+    [[nodiscard]] inline double variance(const moments& data, const bool is_sample)
         {
         // sum of squares/N-1
-        const double sos = sum_of_powers(data, 2);
-        const size_t N = valid_n(data);
+        const double sos = data.m2;
+        const size_t N = data.n;
         if (N < 2)
             { throw std::invalid_argument("Not enough observations to calculate variance."); }
         if (sos == 0.0f)
@@ -213,6 +440,23 @@ namespace statistics
         return safe_divide<double>(sos, is_sample ? (N-1) : N);
         }
 
+    /** @returns The variance from the specified range.
+        @param data The data to analyze.
+        @param is_sample Set to @c true to use sample variance (i.e., N-1).*/
+    [[nodiscard]] inline double variance(const std::vector<double>& data, const bool is_sample)
+        { return variance(calculate_moments(data), is_sample); }
+
+    /** @returns The standard deviation from the specified range.
+        @param data The moments of the data to analyze (see calculate_moments()).
+        @param is_sample Set to @c true to use sample variance (i.e., N-1).*/
+    [[nodiscard]] inline double standard_deviation(const moments& data, const bool is_sample)
+        {
+        if (data.n < 2)
+            { throw std::invalid_argument("Not enough observations to calculate std. dev."); }
+        // square root of variance
+        return std::sqrt(variance(data, is_sample) );
+        }
+
     /** @returns The standard deviation from the specified range.
         @param data The data to analyze.
         @param is_sample Set to @c true to use sample variance (i.e., N-1).*/
@@ -220,8 +464,7 @@ namespace statistics
         {
         if (data.size() < 2)
             { throw std::invalid_argument("Not enough observations to calculate std. dev."); }
-        // square root of variance
-        return std::sqrt(variance(data, is_sample) );
+        return standard_deviation(calculate_moments(data), is_sample);
         }
 
     /** @returns A value, converted to a z-score.
@@ -244,10 +487,12 @@ namespace statistics
     [[nodiscard]] inline double standard_error_of_mean(const std::vector<double>& data,
                                                        const bool is_sample)
         {
-        const auto N = valid_n(data);
+        const auto dataMoments = calculate_moments(data);
+        const auto N = dataMoments.n;
         if (N < 2)
             { throw std::invalid_argument("Not enough observations to calculate SEM."); }
-        return safe_divide<double>(standard_deviation(data, is_sample), std::sqrt(static_cast<double>(N)));
+        return safe_divide<double>(standard_deviation(dataMoments, is_sample),
+                                   std::sqrt(static_cast<double>(N)));
         }
 
     /** @brief Gets the skewness from the specified range.
@@ -262,12 +507,14 @@ namespace statistics
         @returns The skewness from the specified range.*/
     [[nodiscard]] inline double skewness(const std::vector<double>& data, const bool is_sample)
         {
-        const auto N = valid_n(data);
-        if (N < 3)
+        const auto dataMoments = calculate_moments(data);
+        if (dataMoments.n < 3)
             { throw std::invalid_argument("Not enough observations to calculate Skewness."); }
+        // use floating-point for the counts so that the products don't overflow
+        const auto N = static_cast<double>(dataMoments.n);
+        const double sd = standard_deviation(dataMoments, is_sample);
 
-        return safe_divide<double>(N*sum_of_powers(data, 3),
-                                    (N-1)*(N-2)*std::pow(standard_deviation(data, is_sample),3));
+        return safe_divide<double>(N*dataMoments.m3, (N-1)*(N-2)*(sd*sd*sd));
         }
 
     /** @brief Gets the Kurtosis from the specified range.
@@ -278,12 +525,15 @@ namespace statistics
         @returns The Kurtosis from the specified range.*/
     [[nodiscard]] inline double kurtosis(const std::vector<double>& data, const bool is_sample)
         {
-        const auto N = valid_n(data);
-        if (N < 4)
+        const auto dataMoments = calculate_moments(data);
+        if (dataMoments.n < 4)
             { throw std::invalid_argument("Not enough observations to calculate Kurtosis."); }
+        // use floating-point for the counts so that the products don't overflow
+        const auto N = static_cast<double>(dataMoments.n);
+        const double var = variance(dataMoments, is_sample);
 
-        return safe_divide<double>(N*(N+1) * sum_of_powers(data, 4) - 3*sum_of_powers(data, 2) * sum_of_powers(data, 2) * (N-1),
-                                   (N-1)*(N-2)*(N-3)*std::pow(standard_deviation(data, is_sample),4));
+        return safe_divide<double>(N*(N+1) * dataMoments.m4 - 3*dataMoments.m2 * dataMoments.m2 * (N-1),
+                                   (N-1)*(N-2)*(N-3)*(var*var));
         }
 
     /** @brief Calculates the 25th and 75th percentiles from the specified range using the
@@ -312,6 +562,396 @@ namespace statistics
         upper_quartile_value = median_presorted(data.cbegin()+middlePosition-(is_even(N) ? 0 : 1), data.cend());
         }
 
+    /** @brief Calculates the median, 25th, and 75th percentiles from the specified range using the
+         Tukey hinges method (see quartiles_presorted()), without sorting the data.
+        @details All of the order statistics are selected from one partitioning pass
+         (see select_order_statistics()).
+        @param[in,out] data The data to analyze, which will be partially reordered.
+         This is meant to be a scratch buffer that can be reused.
+        @param[out] median_value The calculated median.
+        @param[out] lower_quartile_value The calculated lower quartile.
+        @param[out] upper_quartile_value The calculated upper quartile.
+        @warning NaN values should be removed from the input prior to calling this.*/
+    inline void median_and_quartiles(std::vector<double>& data,
+                                     double& median_value,
+                                     double& lower_quartile_value,
+                                     double& upper_quartile_value)
+        {
+        const size_t N = data.size();
+        if (N == 0)
+            { throw std::invalid_argument("No observations in quartiles calculation."); }
+
+        // the lower half (will include the median point if N is odd)
+        const auto middlePosition = static_cast<size_t>(std::ceil(safe_divide<double>(N, 2)));
+        const auto lowerHalf = median_positions(0, middlePosition);
+        // upper half (will step back to include median point if N is odd)
+        const size_t upperStart = middlePosition - (is_even(N) ? 0 : 1);
+        const auto upperHalf = median_positions(upperStart, N - upperStart);
+        const auto middle = median_positions(0, N);
+
+        select_order_statistics(data,
+            { lowerHalf.first, lowerHalf.second, middle.first, middle.second,
+              upperHalf.first, upperHalf.second });
+        const auto medianOf = [&data](const std::pair<size_t, size_t>& positions)
+            {
+            return (positions.first == positions.second) ? data[positions.first] :
+                (data[positions.first] + data[positions.second]) / static_cast<double>(2);
+            };
+        median_value = medianOf(middle);
+        lower_quartile_value = medianOf(lowerHalf);
+        upper_quartile_value = medianOf(upperHalf);
+        }
+
+    /** @brief Calculates the 25th and 75th percentiles from the specified range using the
+         Tukey hinges method (see quartiles_presorted()), without sorting the data.
+        @param[in,out] data The data to analyze, which will be partially reordered.
+         This is meant to be a scratch buffer that can be reused.
+        @param[out] lower_quartile_value The calculated lower quartile.
+        @param[out] upper_quartile_value The calculated upper quartile.
+        @warning NaN values should be removed from the input prior to calling this.*/
+    inline void quartiles(std::vector<double>& data,
+                          double& lower_quartile_value,
+                          double& upper_quartile_value)
+        {
+        [[maybe_unused]] double median_value{ 0 };
+        median_and_quartiles(data, median_value, lower_quartile_value, upper_quartile_value);
+        }
+
+    /** @brief Calculates multiple percentiles from the specified range, without sorting the data.
+        @details The percentiles are linearly interpolated between the closest ranks
+         (i.e., the method used by Excel's @c PERCENTILE.INC and R's default quantile type).
+         All of the order statistics are selected from one partitioning pass
+         (see select_order_statistics()).
+        @param[in,out] data The data to analyze, which will be partially reordered.
+         This is meant to be a scratch buffer that can be reused.
+        @param percentiles The percentiles to calculate (each between 0 and 1).
+        @returns The values at the respective percentiles.
+        @warning NaN values should be removed from the input prior to calling this.*/
+    [[nodiscard]] inline std::vector<double> percentiles(std::vector<double>& data,
+                                                         const std::vector<double>& percentiles)
+        {
+        if (data.empty())
+            { throw std::invalid_argument("No observations in percentile calculation."); }
+        if (std::any_of(percentiles.cbegin(), percentiles.cend(),
+            [](const auto percentile) noexcept
+              { return !is_within<double>(std::make_pair(0.0, 1.0), percentile); }))
+            { throw std::invalid_argument("Percentiles must be between 0 and 1."); }
+
+        std::vector<size_t> positions;
+        positions.reserve(percentiles.size() * 2);
+        for (const auto percentile : percentiles)
+            {
+            const double rank = percentile * (data.size() - 1);
+            positions.push_back(static_cast<size_t>(std::floor(rank)));
+            positions.push_back(static_cast<size_t>(std::ceil(rank)));
+            }
+        select_order_statistics(data, positions);
+
+        std::vector<double> results;
+        results.reserve(percentiles.size());
+        for (const auto percentile : percentiles)
+            {
+            const double rank = percentile * (data.size() - 1);
+            const double lowerValue = data[static_cast<size_t>(std::floor(rank))];
+            const double upperValue = data[static_cast<size_t>(std::ceil(rank))];
+            results.push_back(lowerValue + (rank - std::floor(rank)) * (upperValue - lowerValue));
+            }
+        return results;
+        }
+
+    /** @returns The value at a percentile in the specified range, without sorting the data.
+        @param[in,out] data The data to analyze, which will be partially reordered.
+        @param percentile The percentile to calculate (between 0 and 1).
+        @sa percentiles() for calculating multiple percentiles at once.
+        @warning NaN values should be removed from the input prior to calling this.*/
+    [[nodiscard]] inline double percentile(std::vector<double>& data, const double percentile)
+        { return percentiles(data, { percentile }).front(); }
+
+    /** @brief A mergeable sketch for calculating approximate quantiles (e.g., medians and quartiles)
+         of large (or streaming) data without storing all of the values.
+        @details This is a KLL sketch, which keeps a hierarchy of buffers ("compactors").
+         When a buffer fills up, it is sorted and every other value is promoted to the next buffer
+         (where each value represents twice as many observations). This keeps the memory bounded
+         (roughly `6 / rank_error` values) regardless of how much data is inserted.\n
+         Sketches can be built separately (e.g., on different threads or for different
+         chunks of a file) and then combined with merge().
+        @code
+         statistics::quantile_sketch sketch(0.01);
+         for (const auto& value : values)
+            { sketch.insert(value); }
+         const auto quartiles = sketch.quantiles({ 0.25, 0.5, 0.75 });
+        @endcode
+        @note The minimum and maximum values are tracked exactly.*/
+    class quantile_sketch
+        {
+    public:
+        /** @brief Constructor.
+            @param rank_error The (approximate) maximum error of the ranks of the quantiles.
+             For example, `0.01` will return a median whose rank is within 1% of the true median's.
+             Lower values use more memory.*/
+        explicit quantile_sketch(const double rank_error = 0.01) :
+            m_k(static_cast<size_t>(std::ceil(2.0 / std::clamp(rank_error, 0.0001, 0.5))))
+            { grow(); }
+        /** @brief Adds a value to the sketch.
+            @param value The value to add. NaN values are ignored.*/
+        void insert(const double value)
+            {
+            if (std::isnan(value))
+                { return; }
+            ++m_count;
+            m_min = std::min(m_min, value);
+            m_max = std::max(m_max, value);
+            m_compactors.front().push_back(value);
+            if (++m_size >= m_max_size)
+                { compress(); }
+            }
+        /** @brief Adds a range of values to the sketch.
+            @param data The values to add. NaN values are ignored.*/
+        void insert(const std::vector<double>& data)
+            {
+            for (const auto& value : data)
+                { insert(value); }
+            }
+        /** @brief Combines another sketch into this one.
+            @details Afterwards, this sketch will represent both sets of data.
+            @param that The sketch to merge into this one.
+            @returns A self reference.*/
+        quantile_sketch& merge(const quantile_sketch& that)
+            {
+            if (that.m_count == 0)
+                { return *this; }
+            while (m_compactors.size() < that.m_compactors.size())
+                { grow(); }
+            for (size_t h = 0; h < that.m_compactors.size(); ++h)
+                {
+                m_compactors[h].insert(m_compactors[h].end(),
+                    that.m_compactors[h].cbegin(), that.m_compactors[h].cend());
+                }
+            m_count += that.m_count;
+            m_min = std::min(m_min, that.m_min);
+            m_max = std::max(m_max, that.m_max);
+            update_size();
+            while (m_size >= m_max_size)
+                { compress(); }
+            return *this;
+            }
+        /// @returns The number of (valid) values inserted into the sketch.
+        [[nodiscard]] size_t count() const noexcept
+            { return m_count; }
+        /// @returns The (approximate) maximum rank error that the sketch was constructed with.
+        [[nodiscard]] double rank_error() const noexcept
+            { return 2.0 / m_k; }
+        /// @returns The smallest value inserted into the sketch.
+        [[nodiscard]] double minimum() const noexcept
+            { return (m_count == 0) ? std::numeric_limits<double>::quiet_NaN() : m_min; }
+        /// @returns The largest value inserted into the sketch.
+        [[nodiscard]] double maximum() const noexcept
+            { return (m_count == 0) ? std::numeric_limits<double>::quiet_NaN() : m_max; }
+        /** @returns The approximate values at the specified quantiles.
+            @param quantiles The quantiles to calculate (each between 0 and 1).
+            @throws std::invalid_argument If the sketch is empty or if a quantile
+             is outside of 0-1.*/
+        [[nodiscard]] std::vector<double> quantiles(const std::vector<double>& quantiles) const
+            {
+            if (m_count == 0)
+                { throw std::invalid_argument("No observations in quantile calculation."); }
+            // the values, along with how many observations each one represents
+            std::vector<std::pair<double, uint64_t>> weightedValues;
+            weightedValues.reserve(m_size);
+            for (size_t h = 0; h < m_compactors.size(); ++h)
+                {
+                for (const auto& value : m_compactors[h])
+                    { weightedValues.emplace_back(value, uint64_t{ 1 } << h); }
+                }
+            std::sort(weightedValues.begin(), weightedValues.end());
+            // convert weights to cumulative weights
+            uint64_t totalWeight{ 0 };
+            for (auto& weightedValue : weightedValues)
+                {
+                totalWeight += weightedValue.second;
+                weightedValue.second = totalWeight;
+                }
+
+            std::vector<double> results;
+            results.reserve(quantiles.size());
+            for (const auto quantile : quantiles)
+                {
+                if (!is_within<double>(std::make_pair(0.0, 1.0), quantile))
+                    { throw std::invalid_argument("Quantiles must be between 0 and 1."); }
+                if (quantile == 0)
+                    { results.push_back(m_min); }
+                else if (quantile == 1)
+                    { results.push_back(m_max); }
+                else
+                    {
+                    const auto targetRank = static_cast<uint64_t>(std::ceil(quantile * totalWeight));
+                    const auto pos = std::lower_bound(weightedValues.cbegin(), weightedValues.cend(),
+                        targetRank,
+                        [](const auto& weightedValue, const uint64_t rank) noexcept
+                          { return weightedValue.second < rank; });
+                    results.push_back((pos == weightedValues.cend()) ? m_max : pos->first);
+                    }
+                }
+            return results;
+            }
+        /** @returns The approximate value at the specified quantile.
+            @param quantile The quantile to calculate (between 0 and 1).
+            @throws std::invalid_argument If the sketch is empty or if the quantile
+             is outside of 0-1.*/
+        [[nodiscard]] double quantile(const double quantile) const
+            { return quantiles({ quantile }).front(); }
+    private:
+        /// @returns The capacity of a compactor, where the highest levels are the largest.
+        [[nodiscard]] size_t capacity(const size_t level) const noexcept
+            {
+            const auto depth = m_compactors.size() - level - 1;
+            return static_cast<size_t>(std::ceil(std::pow(2.0 / 3.0, depth) * m_k)) + 1;
+            }
+        void grow()
+            {
+            m_compactors.emplace_back();
+            m_max_size = 0;
+            for (size_t h = 0; h < m_compactors.size(); ++h)
+                { m_max_size += capacity(h); }
+            }
+        void update_size() noexcept
+            {
+            m_size = 0;
+            for (const auto& compactor : m_compactors)
+                { m_size += compactor.size(); }
+            }
+        /// @brief Promotes every other value from the lowest full compactor up a level.
+        void compress()
+            {
+            for (size_t h = 0; h < m_compactors.size(); ++h)
+                {
+                if (m_compactors[h].size() >= capacity(h))
+                    {
+                    if (h + 1 >= m_compactors.size())
+                        { grow(); }
+                    auto& compactor = m_compactors[h];
+                    auto& nextCompactor = m_compactors[h + 1];
+                    std::sort(compactor.begin(), compactor.end());
+                    // randomly keep the odd or even values, so that the ranks stay unbiased
+                    // (if there is an odd number of values, then the smallest one is left behind)
+                    const size_t offset = (compactor.size() % 2) + (m_random() & 1);
+                    for (size_t i = offset; i < compactor.size(); i += 2)
+                        { nextCompactor.push_back(compactor[i]); }
+                    compactor.resize(compactor.size() % 2);
+                    update_size();
+                    break;
+                    }
+                }
+            }
+
+        size_t m_k{ 200 };
+        std::vector<std::vector<double>> m_compactors;
+        size_t m_size{ 0 };
+        size_t m_max_size{ 0 };
+        size_t m_count{ 0 };
+        double m_min{ std::numeric_limits<double>::max() };
+        double m_max{ std::numeric_limits<double>::lowest() };
+        // fixed seed, so that the same data always gives the same results
+        std::minstd_rand m_random{ 5489 };
+        };
+
+    /** @brief Statistics of a range of data that are updated incrementally as values are added.
+        @details This is useful for data that is appended to over time (e.g., a live feed),
+         where recalculating statistics from all of the data whenever it changes would be wasteful.
+         The count, mean, variance, skewness, kurtosis, minimum, and maximum are
+         available in constant time; quantiles are approximated from a quantile_sketch,
+         which is updated in amortized constant time and queried in time proportional to
+         the sketch's (small, bounded) size.
+        @code
+         statistics::running_statistics stats;
+         for (const auto& value : values)
+            { stats.add(value); }
+         // ...append more values later, then query again
+         stats.add(newValue);
+         const auto sd = stats.standard_deviation(true);
+         const auto median = stats.quantile(0.5);
+        @endcode*/
+    class running_statistics
+        {
+    public:
+        /** @brief Constructor.
+            @param rank_error The (approximate) maximum error of the ranks of the quantiles.
+             See quantile_sketch for details.*/
+        explicit running_statistics(const double rank_error = 0.01) : m_sketch(rank_error)
+            {}
+        /** @brief Adds a value.
+            @param value The value to add. NaN values are ignored.*/
+        void add(const double value)
+            {
+            if (std::isnan(value))
+                { return; }
+            m_moments.add(value);
+            m_sketch.insert(value);
+            }
+        /** @brief Adds a range of values.
+            @param data The values to add. NaN values are ignored.*/
+        void add(const std::vector<double>& data)
+            {
+            m_moments.merge(calculate_moments(data));
+            m_sketch.insert(data);
+            }
+        /** @brief Combines the statistics of another range of data into these.
+            @param that The statistics to merge into these.
+            @returns A self reference.*/
+        running_statistics& merge(const running_statistics& that)
+            {
+            m_moments.merge(that.m_moments);
+            m_sketch.merge(that.m_sketch);
+            return *this;
+            }
+        /// @returns The number of (valid) values added.
+        [[nodiscard]] size_t count() const noexcept
+            { return m_moments.n; }
+        /** @returns The mean of the values.
+            @throws std::invalid_argument If no values have been added.*/
+        [[nodiscard]] double mean() const
+            {
+            if (m_moments.n == 0)
+                { throw std::invalid_argument("No observations in mean calculation."); }
+            return m_moments.mean;
+            }
+        /** @returns The variance of the values.
+            @param is_sample Set to @c true to use sample variance (i.e., N-1).*/
+        [[nodiscard]] double variance(const bool is_sample) const
+            { return statistics::variance(m_moments, is_sample); }
+        /** @returns The standard deviation of the values.
+            @param is_sample Set to @c true to use sample variance (i.e., N-1).*/
+        [[nodiscard]] double standard_deviation(const bool is_sample) const
+            { return statistics::standard_deviation(m_moments, is_sample); }
+        /// @returns The smallest value added (NaN if no values have been added).
+        [[nodiscard]] double minimum() const noexcept
+            { return m_sketch.minimum(); }
+        /// @returns The largest value added (NaN if no values have been added).
+        [[nodiscard]] double maximum() const noexcept
+            { return m_sketch.maximum(); }
+        /** @returns The approximate values at the specified quantiles.
+            @param quantiles The quantiles to calculate (each between 0 and 1).
+            @throws std::invalid_argument If no values have been added or if a quantile
+             is outside of 0-1.*/
+        [[nodiscard]] std::vector<double> quantiles(const std::vector<double>& quantiles) const
+            { return m_sketch.quantiles(quantiles); }
+        /** @returns The approximate value at the specified quantile.
+            @param quantile The quantile to calculate (between 0 and 1).
+            @throws std::invalid_argument If no values have been added or if the quantile
+             is outside of 0-1.*/
+        [[nodiscard]] double quantile(const double quantile) const
+            { return m_sketch.quantile(quantile); }
+        /// @returns The moments of the values (e.g., to pass to skewness() or kurtosis() calculations).
+        [[nodiscard]] const moments& get_moments() const noexcept
+            { return m_moments; }
+        /// @returns The quantile sketch of the values.
+        [[nodiscard]] const quantile_sketch& get_quantile_sketch() const noexcept
+            { return m_sketch; }
+    private:
+        moments m_moments;
+        quantile_sketch m_sketch;
+        };
+
     /** @brief Calculates the outlier and extreme ranges for a given range.
         @param LBV The lower boundary.
         @param UBV The upper boundary.
@@ -334,6 +974,119 @@ namespace statistics
         upper_extreme_boundary = UBV + 2*OUTLIER_COEFFICIENT*(UBV - LBV);
         }
 
+    /** @brief Finds the indices of the values that fall outside of a range.
+        @details The values are compared in fixed-size blocks without branching
+         (which the compiler can vectorize), and only blocks that contain flagged values
+         are then compacted into the index list. Because outliers are usually rare,
+         this is much faster than classifying each value with a branch.
+        @param data The data to analyze.
+        @param lower The lower boundary (values below this are returned).
+        @param upper The upper boundary (values above this are returned).
+        @returns The (ascending) indices of the values outside of `[lower, upper]`.
+        @note NaN values are ignored.*/
+    [[nodiscard]] inline std::vector<size_t> indices_outside_range(const std::vector<double>& data,
+                                                                   const double lower, const double upper)
+        {
+        constexpr size_t blockSize{ 256 };
+        std::array<uint8_t, blockSize> flags{ 0 };
+        std::vector<size_t> indices;
+        for (size_t blockStart = 0; blockStart < data.size(); blockStart += blockSize)
+            {
+            const size_t blockLength = std::min(blockSize, data.size() - blockStart);
+            const double* values = data.data() + blockStart;
+            uint8_t anyFlagged{ 0 };
+            // comparisons against NaN are always false, so NaN is never flagged
+            for (size_t i = 0; i < blockLength; ++i)
+                {
+                flags[i] = static_cast<uint8_t>(values[i] < lower) |
+                           static_cast<uint8_t>(values[i] > upper);
+                anyFlagged |= flags[i];
+                }
+            if (anyFlagged == 0)
+                { continue; }
+            for (size_t i = 0; i < blockLength; ++i)
+                {
+                if (flags[i] != 0)
+                    { indices.push_back(blockStart + i); }
+                }
+            }
+        return indices;
+        }
+
+    /// @brief The indices of the outliers and extreme values from a range of data.
+    struct outlier_indices
+        {
+        /// @brief Values beyond the outlier boundaries, but within the extreme boundaries.
+        std::vector<size_t> outliers;
+        /// @brief Values beyond the extreme boundaries.
+        std::vector<size_t> extremes;
+        };
+
+    /** @brief Classifies the outliers and extreme values from a range of data in one pass.
+        @details Uses the same blocked, branch-free approach as indices_outside_range().
+        @param data The data to analyze.
+        @param lower_outlier_boundary The lower outlier boundary.
+        @param upper_outlier_boundary The upper outlier boundary.
+        @param lower_extreme_boundary The lower extreme boundary.
+        @param upper_extreme_boundary The upper extreme boundary.
+        @returns The (ascending) indices of the outliers and extreme values.
+        @note NaN values are ignored.\n
+         Use outlier_extreme_ranges() to calculate the boundaries from the quartiles.*/
+    [[nodiscard]] inline outlier_indices classify_outliers(const std::vector<double>& data,
+        const double lower_outlier_boundary, const double upper_outlier_boundary,
+        const double lower_extreme_boundary, const double upper_extreme_boundary)
+        {
+        constexpr size_t blockSize{ 256 };
+        std::array<uint8_t, blockSize> flags{ 0 };
+        outlier_indices indices;
+        for (size_t blockStart = 0; blockStart < data.size(); blockStart += blockSize)
+            {
+            const size_t blockLength = std::min(blockSize, data.size() - blockStart);
+            const double* values = data.data() + blockStart;
+            uint8_t anyFlagged{ 0 };
+            // 0 = within the outlier boundaries, 1 = outlier, 2 = extreme
+            for (size_t i = 0; i < blockLength; ++i)
+                {
+                flags[i] = static_cast<uint8_t>(
+                    (static_cast<uint8_t>(values[i] < lower_outlier_boundary) |
+                     static_cast<uint8_t>(values[i] > upper_outlier_boundary)) +
+                    (static_cast<uint8_t>(values[i] < lower_extreme_boundary) |
+                     static_cast<uint8_t>(values[i] > upper_extreme_boundary)));
+                anyFlagged |= flags[i];
+                }
+            if (anyFlagged == 0)
+                { continue; }
+            for (size_t i = 0; i < blockLength; ++i)
+                {
+                if (flags[i] == 1)
+                    { indices.outliers.push_back(blockStart + i); }
+                else if (flags[i] == 2)
+                    { indices.extremes.push_back(blockStart + i); }
+                }
+            }
+        return indices;
+        }
+
+    /** @brief Calculates the quartiles of a range of data and classifies its outliers
+         and extreme values in one pass.
+        @param data The data to analyze.
+        @returns The (ascending) indices of the outliers and extreme values.
+        @note NaN values are ignored.*/
+    [[nodiscard]] inline outlier_indices classify_outliers(const std::vector<double>& data)
+        {
+        std::vector<double> validData;
+        validData.reserve(data.size());
+        std::copy_if(data.cbegin(), data.cend(), std::back_inserter(validData),
+            [](const auto val) noexcept
+              { return !std::isnan(val); });
+        if (validData.size() == 0)
+            { return outlier_indices{}; }
+        double lq(0), uq(0), lo(0), uo(0), le(0), ue(0);
+        quartiles(validData, lq, uq);
+        outlier_extreme_ranges<double>(lq, uq, lo, uo, le, ue);
+        return classify_outliers(data, lo, uo, le, ue);
+        }
+
     /** @brief Accepts a range of data and iteratively returns the outliers.
         @details You can get the outlier and extreme ranges from the data, as
          well as read the outlier values one-by-one.
@@ -377,11 +1130,8 @@ namespace statistics
                 std::back_inserter(m_temp_buffer),
                 [](const auto val) noexcept
                   { return !std::isnan(val); });
-            std::sort(std::execution::par, m_temp_buffer.begin(), m_temp_buffer.end() );
             // calculate the quartile ranges
-            statistics::quartiles_presorted(
-                m_temp_buffer,
-                lq, uq);
+            statistics::quartiles(m_temp_buffer, lq, uq);
             // calculate the outliers and extremes
             statistics::outlier_extreme_ranges<double>(
                 lq, uq,
@@ -471,6 +1221,537 @@ namespace statistics
         assert(is_within<double>(pc,-1,1) && "Error in phi coefficient calculation. Value should be -1 >= and <= 1.");
         return pc;
         }
+
+    /** @private
+        @brief Calls a function for every pair of items `(i, j)` (where `i <= j`) among @c count items,
+         in parallel over square tiles of pairs.
+        @details Each call to @c pairFunction must only write to results for its own pair,
+         so the results are the same regardless of how the tiles are scheduled.*/
+    template <typename pairFunctionT>
+    inline void for_each_item_pair(const size_t count, pairFunctionT pairFunction)
+        {
+        constexpr size_t tileSize{ 16 };
+        const size_t tileCount = (count / tileSize) + ((count % tileSize) ? 1 : 0);
+        std::vector<std::pair<size_t, size_t>> tiles;
+        for (size_t tileRow = 0; tileRow < tileCount; ++tileRow)
+            {
+            for (size_t tileColumn = tileRow; tileColumn < tileCount; ++tileColumn)
+                { tiles.emplace_back(tileRow, tileColumn); }
+            }
+        std::for_each(std::execution::par, tiles.cbegin(), tiles.cend(),
+            [&pairFunction, count](const auto& tile)
+                {
+                const size_t rowEnd = std::min(count, (tile.first + 1) * tileSize);
+                const size_t columnEnd = std::min(count, (tile.second + 1) * tileSize);
+                for (size_t i = tile.first * tileSize; i < rowEnd; ++i)
+                    {
+                    for (size_t j = std::max(i, tile.second * tileSize); j < columnEnd; ++j)
+                        { pairFunction(i, j); }
+                    }
+                });
+        }
+
+    /** @brief Calculates the phi coefficient between every pair of binary variables.
+        @details Each variable is packed into two bit sets (one for its "yes" values and one
+         for its valid values), so that the counts for each pair of variables can be
+         calculated 64 observations at a time with bitwise ANDs and population counts.
+         The pairs are processed in parallel in tiles.
+        @param variables The variables to compare (e.g., the values
+         from continuous columns, such as `column.GetValues()`).
+         Values greater than zero are treated as @c 1 and zero as @c 0 (like phi_coefficient());
+         other values (e.g., NaN) are treated as missing data and are
+         excluded from the pairs that they are in.
+        @returns A row-major matrix of the phi coefficients, where the value at
+         `[i * variables.size() + j]` is the coefficient between variables @c i and @c j.
+         Like phi_coefficient(), pairs where either variable is constant will be zero.
+        @throws std::invalid_argument If the variables are not all the same length.*/
+    [[nodiscard]] inline std::vector<double> phi_coefficient_matrix(
+        const std::vector<std::reference_wrapper<const std::vector<double>>>& variables)
+        {
+        const size_t variableCount = variables.size();
+        if (variableCount == 0)
+            { return std::vector<double>(); }
+        const size_t observationCount = variables.front().get().size();
+        for (const auto& variable : variables)
+            {
+            if (variable.get().size() != observationCount)
+                { throw std::invalid_argument("Variables passed to phi_coefficient_matrix must be the same size!"); }
+            }
+
+        // pack the variables into bit sets
+        const size_t wordCount = (observationCount / 64) + ((observationCount % 64) ? 1 : 0);
+        std::vector<uint64_t> yesBits(variableCount * wordCount, 0);
+        std::vector<uint64_t> validBits(variableCount * wordCount, 0);
+        for (size_t var = 0; var < variableCount; ++var)
+            {
+            const auto& values = variables[var].get();
+            for (size_t i = 0; i < observationCount; ++i)
+                {
+                const uint64_t bit = uint64_t{ 1 } << (i % 64);
+                if (values[i] > 0)
+                    {
+                    yesBits[var * wordCount + (i / 64)] |= bit;
+                    validBits[var * wordCount + (i / 64)] |= bit;
+                    }
+                else if (values[i] == 0)
+                    { validBits[var * wordCount + (i / 64)] |= bit; }
+                }
+            }
+
+        std::vector<double> results(variableCount * variableCount, 0);
+        for_each_item_pair(variableCount,
+            [&](const size_t var1, const size_t var2)
+                {
+                const uint64_t* yes1 = yesBits.data() + var1 * wordCount;
+                const uint64_t* yes2 = yesBits.data() + var2 * wordCount;
+                const uint64_t* valid1 = validBits.data() + var1 * wordCount;
+                const uint64_t* valid2 = validBits.data() + var2 * wordCount;
+                size_t n11{ 0 }, n1_dot{ 0 }, n_dot_1{ 0 }, n{ 0 };
+                for (size_t word = 0; word < wordCount; ++word)
+                    {
+                    n11 += count_bits(yes1[word] & yes2[word]);
+                    n1_dot += count_bits(yes1[word] & valid2[word]);
+                    n_dot_1 += count_bits(valid1[word] & yes2[word]);
+                    n += count_bits(valid1[word] & valid2[word]);
+                    }
+                const double n10 = static_cast<double>(n1_dot - n11);
+                const double n01 = static_cast<double>(n_dot_1 - n11);
+                const double n00 = static_cast<double>(n - n1_dot - n_dot_1 + n11);
+                const double n0_dot = static_cast<double>(n - n1_dot);
+                const double n_dot_0 = static_cast<double>(n - n_dot_1);
+                const double pc = safe_divide<double>((n11 * n00) - (n10 * n01),
+                    std::sqrt(static_cast<double>(n1_dot) * n0_dot * n_dot_0 * static_cast<double>(n_dot_1)));
+                results[var1 * variableCount + var2] = results[var2 * variableCount + var1] = pc;
+                });
+        return results;
+        }
+
+    /** @brief Calculates the Pearson correlation coefficient between every pair of variables.
+        @details The pairs are processed in parallel in tiles. Each pair's coefficient is
+         calculated from the observations that are valid in both variables
+         (i.e., pairwise deletion), using a numerically stable single-pass update.
+        @param variables The variables to compare (e.g., the values
+         from continuous columns, such as `column.GetValues()`). NaN values are treated as missing data.
+        @returns A row-major matrix of the correlation coefficients, where the value at
+         `[i * variables.size() + j]` is the coefficient between variables @c i and @c j.
+         Pairs where either variable is constant (or that have fewer than two valid observations) will be NaN.
+        @note For binary (0/1) variables, this is the same as phi_coefficient_matrix(),
+         although that is much faster.
+        @throws std::invalid_argument If the variables are not all the same length.*/
+    [[nodiscard]] inline std::vector<double> correlation_matrix(
+        const std::vector<std::reference_wrapper<const std::vector<double>>>& variables)
+        {
+        const size_t variableCount = variables.size();
+        if (variableCount == 0)
+            { return std::vector<double>(); }
+        const size_t observationCount = variables.front().get().size();
+        for (const auto& variable : variables)
+            {
+            if (variable.get().size() != observationCount)
+                { throw std::invalid_argument("Variables passed to correlation_matrix must be the same size!"); }
+            }
+
+        std::vector<double> results(variableCount * variableCount,
+                                    std::numeric_limits<double>::quiet_NaN());
+        for_each_item_pair(variableCount,
+            [&](const size_t var1, const size_t var2)
+                {
+                const auto& values1 = variables[var1].get();
+                const auto& values2 = variables[var2].get();
+                double n{ 0 }, mean1{ 0 }, mean2{ 0 }, m2_1{ 0 }, m2_2{ 0 }, coMoment{ 0 };
+                for (size_t i = 0; i < observationCount; ++i)
+                    {
+                    if (std::isnan(values1[i]) || std::isnan(values2[i]))
+                        { continue; }
+                    ++n;
+                    const double delta1 = values1[i] - mean1;
+                    mean1 += delta1 / n;
+                    const double delta2 = values2[i] - mean2;
+                    mean2 += delta2 / n;
+                    m2_1 += delta1 * (values1[i] - mean1);
+                    m2_2 += delta2 * (values2[i] - mean2);
+                    coMoment += delta1 * (values2[i] - mean2);
+                    }
+                if (n >= 2 && m2_1 > 0 && m2_2 > 0)
+                    {
+                    results[var1 * variableCount + var2] = results[var2 * variableCount + var1] =
+                        std::clamp(coMoment / std::sqrt(m2_1 * m2_2), -1.0, 1.0);
+                    }
+                });
+        return results;
+        }
+
+    /// @brief The default number of values that each task processes in chunked_reduce().
+    constexpr size_t reduction_chunk_size{ 16 * 1024 };
+
+    /** @brief Performs a reduction over fixed-size chunks of a range in parallel.
+        @details The range `[0, count)` is split into chunks of @c chunkSize indices.
+         Each chunk is accumulated into its own copy of @c init (on whichever thread picks it up),
+         then the per-chunk results are merged sequentially in chunk order.
+         Because the chunk boundaries and merge order depend only on @c count and @c chunkSize
+         (not on the number of threads or how they are scheduled), floating-point results are
+         bit-reproducible from run to run.
+        @param count The number of items in the range.
+        @param init The identity accumulator; each chunk starts with a copy of it.
+        @param accumulate Function with the signature
+         `void (AccumT& accumulator, const size_t first, const size_t last)`
+         which reduces the items in `[first, last)` into the accumulator.
+        @param merge Function with the signature `void (AccumT& result, const AccumT& chunkResult)`.
+        @param chunkSize The number of items in each chunk.
+        @returns The merged result.
+        @par Example
+        @code
+         const auto& values = column.GetValues();
+         // sum of the non-NaN values
+         const double total = statistics::chunked_reduce(values.size(), 0.0,
+            [&values](double& accum, const size_t first, const size_t last) noexcept
+                {
+                for (size_t i = first; i < last; ++i)
+                    { accum += std::isnan(values[i]) ? 0.0 : values[i]; }
+                },
+            [](double& result, const double chunkResult) noexcept
+                { result += chunkResult; });
+        @endcode*/
+    template <typename AccumT, typename accumulateT, typename mergeT>
+    [[nodiscard]] AccumT chunked_reduce(const size_t count, const AccumT& init,
+                                        accumulateT accumulate, mergeT merge,
+                                        const size_t chunkSize = reduction_chunk_size)
+        {
+        if (count == 0)
+            { return init; }
+        const size_t chunk = std::max<size_t>(1, chunkSize);
+        const size_t chunkCount = (count / chunk) + ((count % chunk) ? 1 : 0);
+        std::vector<AccumT> partials(chunkCount, init);
+        if (chunkCount == 1)
+            { accumulate(partials[0], 0, count); }
+        else
+            {
+            std::vector<size_t> chunkIndices(chunkCount);
+            std::iota(chunkIndices.begin(), chunkIndices.end(), 0);
+            std::for_each(std::execution::par, chunkIndices.cbegin(), chunkIndices.cend(),
+                [&partials, &accumulate, chunk, count](const size_t chunkIndex)
+                    {
+                    accumulate(partials[chunkIndex], chunkIndex * chunk,
+                               std::min(count, (chunkIndex + 1) * chunk));
+                    });
+            }
+        AccumT result{ init };
+        for (const auto& partial : partials)
+            { merge(result, partial); }
+        return result;
+        }
+
+    /** @returns The valid (non-NaN) number of observations from the specified range,
+         counted in parallel.
+        @param data The data to analyze.*/
+    [[nodiscard]] inline size_t parallel_valid_n(const std::vector<double>& data)
+        {
+        return chunked_reduce(data.size(), size_t{ 0 },
+            [&data](size_t& accum, const size_t first, const size_t last) noexcept
+                {
+                for (size_t i = first; i < last; ++i)
+                    { accum += std::isnan(data[i]) ? 0 : 1; }
+                },
+            [](size_t& result, const size_t chunkResult) noexcept
+                { result += chunkResult; });
+        }
+
+    /** @returns The sum of the valid (non-NaN) values from the specified range, summed in parallel.
+        @param data The data to analyze.
+        @note The result is reproducible run to run, but may differ in the last bits from
+         a sequential summation because the values are summed in chunks.*/
+    [[nodiscard]] inline double parallel_sum(const std::vector<double>& data)
+        {
+        return chunked_reduce(data.size(), 0.0,
+            [&data](double& accum, const size_t first, const size_t last) noexcept
+                {
+                for (size_t i = first; i < last; ++i)
+                    { accum += std::isnan(data[i]) ? 0.0 : data[i]; }
+                },
+            [](double& result, const double chunkResult) noexcept
+                { result += chunkResult; });
+        }
+
+    /** @returns The mean of the valid (non-NaN) values from the specified range, calculated in parallel.
+        @param data The data to analyze.
+        @throws std::invalid_argument If there are no valid observations.*/
+    [[nodiscard]] inline double parallel_mean(const std::vector<double>& data)
+        {
+        const auto [N, summation] = chunked_reduce(data.size(), std::make_pair(size_t{ 0 }, 0.0),
+            [&data](std::pair<size_t, double>& accum, const size_t first, const size_t last) noexcept
+                {
+                for (size_t i = first; i < last; ++i)
+                    {
+                    if (!std::isnan(data[i]))
+                        {
+                        ++accum.first;
+                        accum.second += data[i];
+                        }
+                    }
+                },
+            [](std::pair<size_t, double>& result, const std::pair<size_t, double>& chunkResult) noexcept
+                {
+                result.first += chunkResult.first;
+                result.second += chunkResult.second;
+                });
+        if (N == 0)
+            { throw std::invalid_argument("No observations in mean calculation."); }
+        return safe_divide<double>(summation, N);
+        }
+
+    /** @returns The minimum and maximum valid (non-NaN) values from the specified range,
+         calculated in parallel. Both will be NaN if there are no valid values.
+        @param data The data to analyze.*/
+    [[nodiscard]] inline std::pair<double, double> parallel_min_max(const std::vector<double>& data)
+        {
+        return chunked_reduce(data.size(),
+            std::make_pair(std::numeric_limits<double>::quiet_NaN(),
+                           std::numeric_limits<double>::quiet_NaN()),
+            [&data](std::pair<double, double>& accum, const size_t first, const size_t last) noexcept
+                {
+                for (size_t i = first; i < last; ++i)
+                    {
+                    if (std::isnan(data[i]))
+                        { continue; }
+                    // std::min/max would propagate the initial NaN, so compare explicitly
+                    if (std::isnan(accum.first) || data[i] < accum.first)
+                        { accum.first = data[i]; }
+                    if (std::isnan(accum.second) || data[i] > accum.second)
+                        { accum.second = data[i]; }
+                    }
+                },
+            [](std::pair<double, double>& result, const std::pair<double, double>& chunkResult) noexcept
+                {
+                if (std::isnan(result.first) || chunkResult.first < result.first)
+                    { result.first = chunkResult.first; }
+                if (std::isnan(result.second) || chunkResult.second > result.second)
+                    { result.second = chunkResult.second; }
+                });
+        }
+
+    /** @brief Finds which equal-width bin a value falls into, where each bin includes its
+         upper edge (and the first bin also includes its lower edge).
+        @details Edges are compared with compare_doubles() and its related functions,
+         so a value within their tolerance of an edge is considered to be on it.\n
+         The bin is calculated directly from the value (rather than searching through
+         the bins), and then only it and its neighbors are checked against their edges.
+        @param value The value to look up.
+        @param binStart The starting (lower) edge of the first bin.
+        @param binWidth The width of each bin.
+        @param binCount The number of bins.
+        @returns The (zero-based) index of the bin, or @c binCount if the value is NaN
+         or outside of the bins.*/
+    [[nodiscard]] inline size_t upper_inclusive_bin_index(const double value,
+        const double binStart, const double binWidth, const size_t binCount) noexcept
+        {
+        if (std::isnan(value) || binCount == 0)
+            { return binCount; }
+        if (compare_doubles(value, binStart))
+            { return 0; }
+        const auto isInBin = [value, binStart, binWidth](const size_t bin) noexcept
+            {
+            return compare_doubles_greater(value, binStart + (bin * binWidth)) &&
+                compare_doubles_less_or_equal(value, binStart + (bin * binWidth) + binWidth);
+            };
+        // bins that are (nearly) narrower than the tolerance overlap each other,
+        // so fall back to searching them in order
+        if (!(binWidth > 1e-5))
+            {
+            for (size_t bin = 0; bin < binCount; ++bin)
+                {
+                if (isInBin(bin))
+                    { return bin; }
+                }
+            return binCount;
+            }
+        const double position = std::ceil((value - binStart) / binWidth) - 1;
+        if (!(position >= -1) || position > static_cast<double>(binCount))
+            { return binCount; }
+        const size_t estimate = std::min(static_cast<size_t>(std::max(position, 0.0)), binCount - 1);
+        // a value on (or within the tolerance of) an edge belongs to the lower bin
+        for (size_t bin = (estimate > 0 ? estimate - 1 : 0);
+             bin <= std::min(estimate + 1, binCount - 1);
+             ++bin)
+            {
+            if (isInBin(bin))
+                { return bin; }
+            }
+        return binCount;
+        }
+
+    /** @brief Counts the values from a range (by group) into equal-width bins, in parallel.
+        @details Each chunk of the data is counted into its own histogram,
+         and these are then merged together.
+        @param data The data to analyze.
+        @param binStart The starting (lower) edge of the first bin.
+        @param binWidth The width of each bin.
+        @param binCount The number of bins.
+        @param groupCount The number of groups.
+        @param groupOf Function with the signature `size_t (const size_t index)` which returns
+         the (zero-based) group of the value at an index.
+         Values whose group is @c groupCount or higher are ignored.
+        @param transform Function with the signature `double (const double value)` which
+         is applied to each value before binning it (e.g., rounding it).
+        @returns The number of values in each bin and group, where the count for
+         bin @c b and group @c g is at `(b * groupCount) + g`.\n
+         Bins include their upper edges (see upper_inclusive_bin_index()).
+        @note NaN values and values outside of the bins are ignored.
+        @warning @c groupOf and @c transform are called from multiple threads.*/
+    template <typename groupFunctionT, typename transformT>
+    [[nodiscard]] std::vector<size_t> parallel_grouped_histogram(const std::vector<double>& data,
+        const double binStart, const double binWidth, const size_t binCount,
+        const size_t groupCount, groupFunctionT groupOf, transformT transform)
+        {
+        return chunked_reduce(data.size(), std::vector<size_t>(binCount * groupCount, 0),
+            [&data, &groupOf, &transform, binStart, binWidth, binCount, groupCount]
+            (std::vector<size_t>& accum, const size_t first, const size_t last)
+                {
+                for (size_t i = first; i < last; ++i)
+                    {
+                    if (std::isnan(data[i]))
+                        { continue; }
+                    const size_t bin =
+                        upper_inclusive_bin_index(transform(data[i]), binStart, binWidth, binCount);
+                    const size_t group = groupOf(i);
+                    if (bin < binCount && group < groupCount)
+                        { ++accum[(bin * groupCount) + group]; }
+                    }
+                },
+            [](std::vector<size_t>& result, const std::vector<size_t>& chunkResult) noexcept
+                {
+                for (size_t i = 0; i < result.size(); ++i)
+                    { result[i] += chunkResult[i]; }
+                });
+        }
+
+    /** @brief Counts the values from a range into equal-width bins, in parallel.
+        @param data The data to analyze.
+        @param binStart The starting (lower) edge of the first bin.
+        @param binWidth The width of each bin.
+        @param binCount The number of bins.
+        @returns The number of values in each bin. Bins include their lower edge;
+         the last bin also includes its upper edge.
+        @note NaN values and values outside of the bins are ignored.
+        @throws std::invalid_argument If the bin width is not positive.*/
+    [[nodiscard]] inline std::vector<size_t> parallel_histogram(const std::vector<double>& data,
+        const double binStart, const double binWidth, const size_t binCount)
+        {
+        if (!(binWidth > 0))
+            { throw std::invalid_argument("Histogram bin width must be positive."); }
+        return chunked_reduce(data.size(), std::vector<size_t>(binCount, 0),
+            [&data, binStart, binWidth, binCount](std::vector<size_t>& accum,
+                                                  const size_t first, const size_t last) noexcept
+                {
+                for (size_t i = first; i < last; ++i)
+                    {
+                    const double position = (data[i] - binStart) / binWidth;
+                    // also filters out NaN
+                    if (!(position >= 0) || position > binCount)
+                        { continue; }
+                    ++accum[std::min(static_cast<size_t>(position), binCount - 1)];
+                    }
+                },
+            [](std::vector<size_t>& result, const std::vector<size_t>& chunkResult) noexcept
+                {
+                for (size_t i = 0; i < result.size(); ++i)
+                    { result[i] += chunkResult[i]; }
+                });
+        }
+
+    /// @brief The count, sum, minimum, and maximum of the valid values in a group.
+    struct group_aggregate
+        {
+        /// @brief The number of valid (non-NaN) values.
+        size_t n{ 0 };
+        /// @brief The sum of the values.
+        double sum{ 0 };
+        /// @brief The minimum value (NaN if the group is empty).
+        double minimum{ std::numeric_limits<double>::quiet_NaN() };
+        /// @brief The maximum value (NaN if the group is empty).
+        double maximum{ std::numeric_limits<double>::quiet_NaN() };
+        /// @returns The mean of the group's values (NaN if the group is empty).
+        [[nodiscard]] double mean() const noexcept
+            { return (n == 0) ? std::numeric_limits<double>::quiet_NaN() : sum / n; }
+        /** @brief Adds a value to the group.
+            @param value The value to add.*/
+        void add(const double value) noexcept
+            {
+            ++n;
+            sum += value;
+            if (std::isnan(minimum) || value < minimum)
+                { minimum = value; }
+            if (std::isnan(maximum) || value > maximum)
+                { maximum = value; }
+            }
+        /** @brief Combines another group's aggregates into this one.
+            @param that The group to merge.*/
+        void merge(const group_aggregate& that) noexcept
+            {
+            if (that.n == 0)
+                { return; }
+            n += that.n;
+            sum += that.sum;
+            if (std::isnan(minimum) || that.minimum < minimum)
+                { minimum = that.minimum; }
+            if (std::isnan(maximum) || that.maximum > maximum)
+                { maximum = that.maximum; }
+            }
+        };
+
+    /** @brief Calculates the count, sum, minimum, and maximum of the valid values
+         from the specified range in a single (parallel) pass.
+        @param data The data to analyze.
+        @returns The aggregates of the data.*/
+    [[nodiscard]] inline group_aggregate parallel_aggregate(const std::vector<double>& data)
+        {
+        return chunked_reduce(data.size(), group_aggregate{},
+            [&data](group_aggregate& accum, const size_t first, const size_t last) noexcept
+                {
+                for (size_t i = first; i < last; ++i)
+                    {
+                    if (!std::isnan(data[i]))
+                        { accum.add(data[i]); }
+                    }
+                },
+            [](group_aggregate& result, const group_aggregate& chunkResult) noexcept
+                { result.merge(chunkResult); });
+        }
+
+    /** @brief Calculates the count, sum, minimum, and maximum of values for each group, in parallel.
+        @param data The data to analyze.
+        @param groups The group ID of each value in @c data (e.g., the IDs from a
+         categorical column, such as `Column<GroupIdType>::GetValues()`).
+        @param groupCount The number of groups. Group IDs must be less than this;
+         values with out-of-range IDs are ignored.
+        @returns The aggregates for each group, indexed by group ID.
+        @note NaN values are ignored.\n
+         Each chunk keeps its own table of @c groupCount aggregates, so this is intended for
+         categorical groupings (i.e., not an ID column).
+        @throws std::invalid_argument If @c data and @c groups are different sizes.*/
+    template <typename groupT>
+    [[nodiscard]] std::vector<group_aggregate> parallel_grouped_aggregates(
+        const std::vector<double>& data, const std::vector<groupT>& groups, const size_t groupCount)
+        {
+        static_assert(std::is_integral_v<groupT>, "Group IDs must be integral.");
+        if (data.size() != groups.size())
+            { throw std::invalid_argument("Data and group sizes do not match."); }
+        return chunked_reduce(data.size(), std::vector<group_aggregate>(groupCount),
+            [&data, &groups, groupCount](std::vector<group_aggregate>& accum,
+                                         const size_t first, const size_t last) noexcept
+                {
+                for (size_t i = first; i < last; ++i)
+                    {
+                    if (std::isnan(data[i]) || static_cast<size_t>(groups[i]) >= groupCount)
+                        { continue; }
+                    accum[static_cast<size_t>(groups[i])].add(data[i]);
+                    }
+                },
+            [](std::vector<group_aggregate>& result, const std::vector<group_aggregate>& chunkResult) noexcept
+                {
+                for (size_t i = 0; i < result.size(); ++i)
+                    { result[i].merge(chunkResult[i]); }
+                });
+        }
     }
 
 /** @}*/
@@ -17,12 +17,100 @@ void ImageExportDlg::OnOptionsChanged([[maybe_unused]] wxCommandEvent& event)
 
     TransferDataFromWindow();
 
-    wxImage img(m_originalBitmap.ConvertToImage());
+    m_previewThumbnail->SetBitmap(wxBitmap(GetPreviewImage()));
+    UpdateEstimate();
+    }
+
+//-------------------------------------------------------------
+void ImageExportDlg::OnEncodingChanged([[maybe_unused]] wxCommandEvent& event)
+    {
+    TransferDataFromWindow();
+    UpdateEstimate();
+    }
 
+//-------------------------------------------------------------
+const wxImage& ImageExportDlg::GetPreviewImage()
+    {
+    if (!m_previewImage.IsOk() && m_originalBitmap.IsOk())
+        { m_previewImage = m_originalBitmap.ConvertToImage(); }
     if (m_options.m_mode == static_cast<decltype(m_options.m_mode)>(ImageExportOptions::ColorMode::Grayscale))
-        { img = img.ConvertToGreyscale(); }
+        {
+        if (!m_grayscalePreviewImage.IsOk() && m_previewImage.IsOk())
+            { m_grayscalePreviewImage = m_previewImage.ConvertToGreyscale(); }
+        return m_grayscalePreviewImage;
+        }
+    return m_previewImage;
+    }
 
-    m_previewThumbnail->SetBitmap(wxBitmap(img));
+//-------------------------------------------------------------
+void ImageExportDlg::UpdateEstimate()
+    {
+    if (m_estimateLabel == nullptr)
+        { return; }
+    const wxImage& previewImage = GetPreviewImage();
+    if (!previewImage.IsOk() || previewImage.GetWidth() == 0 || previewImage.GetHeight() == 0)
+        {
+        m_estimateLabel->SetLabel(wxString{});
+        return;
+        }
+
+    ImageExportOptions sampleOptions{ m_options };
+    sampleOptions.m_tiffCompression = GetSelectedTiffCompression();
+    // only re-encode the sample if an encoding option changed (size changes are just extrapolated)
+    if (!m_encodingSample || m_encodingSample->m_mode != sampleOptions.m_mode ||
+        m_encodingSample->m_profile != sampleOptions.m_profile ||
+        m_encodingSample->m_tiffCompression != sampleOptions.m_tiffCompression)
+        {
+        wxBusyCursor bc;
+        const auto encodeStart = std::chrono::steady_clock::now();
+        // encode the preview the same way that the canvas saves it
+        wxImage sampleImage{ previewImage.Copy() };
+        GraphItems::Image::FlattenForExport(sampleImage, false);
+        sampleOptions.ApplyEncodingOptions(sampleImage, m_bitmapType);
+        wxMemoryOutputStream sampleStream;
+        if (!sampleImage.SaveFile(sampleStream, m_bitmapType))
+            {
+            m_encodingSample.reset();
+            m_estimateLabel->SetLabel(wxString{});
+            return;
+            }
+        m_encodingSample = EncodingSample{ sampleOptions.m_mode, sampleOptions.m_profile,
+            sampleOptions.m_tiffCompression, static_cast<size_t>(sampleStream.GetLength()),
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - encodeStart) };
+        }
+
+    // file size and encoding time roughly scale with the number of pixels
+    // (this is only an approximation, as compression also depends on the rendered content)
+    const double pixelRatio = safe_divide<double>(
+        static_cast<double>(m_options.m_imageSize.GetWidth()) * m_options.m_imageSize.GetHeight(),
+        static_cast<double>(previewImage.GetWidth()) * previewImage.GetHeight());
+    const auto estimatedSize = static_cast<wxULongLong_t>(m_encodingSample->m_fileSize * pixelRatio);
+    const auto estimatedMilliseconds =
+        static_cast<long>(std::ceil((m_encodingSample->m_encodeTime.count() * pixelRatio) / 1000));
+    m_estimateLabel->SetLabel(
+        wxString::Format(_(L"Estimated file size: %s\nEstimated encoding time: %s ms"),
+            wxFileName::GetHumanReadableSize(wxULongLong(estimatedSize)),
+            wxNumberFormatter::ToString(estimatedMilliseconds)));
+    Layout();
+    }
+
+//-------------------------------------------------------------
+TiffCompression ImageExportDlg::GetSelectedTiffCompression() const
+    {
+    if (m_tiffCompressionCombo == nullptr)
+        { return TiffCompression::CompressionNone; }
+    switch (m_tiffCompressionCombo->GetSelection())
+        {
+    case 1:
+        return TiffCompression::CompressionLZW;
+    case 2:
+        return TiffCompression::CompressionJPEG;
+    case 3:
+        return TiffCompression::CompressionDeflate;
+    default:
+        return TiffCompression::CompressionNone;
+        }
     }
 
 void ImageExportDlg::OnSizeChanged(wxSpinEvent& event)
@@ -44,6 +132,7 @@ void ImageExportDlg::OnSizeChanged(wxSpinEvent& event)
         }
 
     TransferDataToWindow();
+    UpdateEstimate();
     }
 
 /// Creation
@@ -64,6 +153,10 @@ bool ImageExportDlg::Create(wxWindow* parent,
     Bind(wxEVT_BUTTON, &ImageExportDlg::OnOK, this, wxID_OK);
     Bind(wxEVT_SPINCTRL, &ImageExportDlg::OnSizeChanged, this);
     Bind(wxEVT_RADIOBOX, &ImageExportDlg::OnOptionsChanged, this, ImageExportDlg::COLOR_MODE_COMBO_ID);
+    Bind(wxEVT_RADIOBOX, &ImageExportDlg::OnEncodingChanged, this, ImageExportDlg::EXPORT_PROFILE_ID);
+    Bind(wxEVT_COMBOBOX, &ImageExportDlg::OnEncodingChanged, this, ImageExportDlg::TIFF_COMPRESSION_ID);
+
+    UpdateEstimate();
 
     Centre();
     return true;
@@ -115,6 +208,19 @@ void ImageExportDlg::CreateControls(const wxBitmapType bitmapType)
         column1Sizer->AddSpacer(wxSizerFlags::GetDefaultBorder());
         }
 
+    // formats whose encoding can trade speed for file size
+    if (bitmapType == wxBITMAP_TYPE_PNG || bitmapType == wxBITMAP_TYPE_JPEG)
+        {
+        wxArrayString profiles;
+        profiles.Add(_(L"&Fastest"));
+        profiles.Add(_(L"&Balanced"));
+        profiles.Add(_(L"&Smallest file"));
+        wxRadioBox* profilesRadioBox = new wxRadioBox(this, EXPORT_PROFILE_ID, _(L"Encoding"),
+            wxDefaultPosition, wxDefaultSize, profiles, 0, wxRA_SPECIFY_ROWS, wxGenericValidator(&m_options.m_profile) );
+        column1Sizer->Add(profilesRadioBox, 0, wxEXPAND);
+        column1Sizer->AddSpacer(wxSizerFlags::GetDefaultBorder());
+        }
+
     if (bitmapType == wxBITMAP_TYPE_TIF)
         {
         wxStaticBox* tiffBox = new wxStaticBox(this, wxID_ANY, _(L"TIFF options:"));
@@ -131,7 +237,7 @@ void ImageExportDlg::CreateControls(const wxBitmapType bitmapType)
         compressionChoices.Add(_DT(L"Lempel-Ziv & Welch", DTExplanation::ProperNoun));
         compressionChoices.Add(_DT(L"JPEG"));
         compressionChoices.Add(_(L"Deflate"));
-        m_tiffCompressionCombo = new wxComboBox(this, wxID_ANY, wxEmptyString,
+        m_tiffCompressionCombo = new wxComboBox(this, TIFF_COMPRESSION_ID, wxEmptyString,
                                             wxDefaultPosition, wxDefaultSize, compressionChoices,
                                             wxCB_DROPDOWN|wxCB_READONLY);
         m_tiffCompressionCombo->SetSelection((m_options.m_tiffCompression == TiffCompression::CompressionNone) ?
@@ -149,6 +255,14 @@ void ImageExportDlg::CreateControls(const wxBitmapType bitmapType)
             false, wxID_ANY, wxDefaultPosition, wxSize(128,128));
         previewSizer->Add(m_previewThumbnail);
         column2Sizer->Add(previewSizer);
+
+        // unknown/non-image formats (e.g., SVG) aren't encoded like this
+        if (bitmapType != wxBITMAP_TYPE_ANY)
+            {
+            m_estimateLabel = new wxStaticText(this, wxID_STATIC, wxString{});
+            column2Sizer->AddSpacer(wxSizerFlags::GetDefaultBorder());
+            column2Sizer->Add(m_estimateLabel);
+            }
         }
 
     mainSizer->Add(CreateSeparatedButtonSizer(wxOK|wxCANCEL|wxHELP), 0, wxEXPAND|wxALL, wxSizerFlags::GetDefaultBorder());
@@ -161,28 +275,7 @@ void ImageExportDlg::OnOK([[maybe_unused]] wxCommandEvent& event)
     {
     TransferDataFromWindow();
 
-    if (m_tiffCompressionCombo)
-        {
-        switch (m_tiffCompressionCombo->GetSelection())
-            {
-        case 0:
-            m_options.m_tiffCompression = TiffCompression::CompressionNone;
-            break;
-        case 1:
-            m_options.m_tiffCompression = TiffCompression::CompressionLZW;
-            break;
-        case 2:
-            m_options.m_tiffCompression = TiffCompression::CompressionJPEG;
-            break;
-        case 3:
-            m_options.m_tiffCompression = TiffCompression::CompressionDeflate;
-            break;
-        default:
-            m_options.m_tiffCompression = TiffCompression::CompressionNone;
-            }
-        }
-    else
-        { m_options.m_tiffCompression = TiffCompression::CompressionNone; }
+    m_options.m_tiffCompression = GetSelectedTiffCompression();
 
     if (IsModal())
         { EndModal(wxID_OK); }
@@ -23,6 +23,11 @@
 #include <wx/dialog.h>
 #include <wx/filename.h>
 #include <wx/mstream.h>
+#include <wx/quantize.h>
+#include <wx/numformatter.h>
+#include <chrono>
+#include <cmath>
+#include <optional>
 #include "../math/mathematics.h"
 #include "../ui/thumbnail.h"
 #include "../util/donttranslate.h"
@@ -50,17 +55,80 @@ namespace Wisteria::UI
             Grayscale, /*!< Shades of gray (i.e., B & W).*/
             Greyscale = Grayscale
             };
+        /// @brief How to balance encoding speed against file size.
+        enum class ExportProfile
+            {
+            Fast,     /*!< Encode as quickly as possible (e.g., minimal PNG compression).\n
+                           This works well for charts, which are mostly flat colors.*/
+            Balanced, /*!< Standard compression (e.g., zlib's default PNG compression level of 6
+                           and a JPEG quality of 90).\n
+                           Note that earlier versions always used maximum PNG compression
+                           (which is now the @c Smallest profile) and a JPEG quality of 100.*/
+            Smallest  /*!< Smallest file size (e.g., maximum PNG compression), which is slower.*/
+            };
         /// @brief Default Constructor.
         ImageExportOptions() noexcept : m_mode(static_cast<decltype(m_mode)>(ColorMode::RGB)),
                                 m_tiffCompression(TiffCompression::CompressionNone),
                                 m_imageSize(700, 500) {};
         int m_mode{ static_cast<decltype(m_mode)>(ColorMode::RGB) }; /*!< The color mode. Really a ColorMode, but must be int to be compatible with a validator.*/
+        int m_profile{ static_cast<decltype(m_profile)>(ExportProfile::Balanced) }; /*!< The encoding profile. Really an ExportProfile, but must be int to be compatible with a validator.*/
         TiffCompression m_tiffCompression{ TiffCompression::CompressionNone }; /*!< The Tiff compression method (if saving as Tiff).*/
         wxSize m_imageSize{ wxSize(700, 500) }; /*!< The dimensions of the exported image.*/
+
+        /** @brief Sets the format-specific encoding options (e.g., compression) on an image
+                that is about to be saved.
+            @param[in,out] image The image to set the options on. For GIFs, this will also
+                reduce the image to 256 colors (if necessary).
+            @param imageType The format that the image will be saved as.*/
+        void ApplyEncodingOptions(wxImage& image, const wxBitmapType imageType) const
+            {
+            const auto profile = static_cast<ExportProfile>(m_profile);
+            if (imageType == wxBITMAP_TYPE_TIF)
+                {
+                image.SetOption(wxIMAGE_OPTION_COMPRESSION,
+                                static_cast<int>(m_tiffCompression));
+                }
+            else if (imageType == wxBITMAP_TYPE_JPEG)
+                {
+                // lower quality encodes a little faster, but mostly makes the file smaller
+                image.SetOption(wxIMAGE_OPTION_QUALITY,
+                    (profile == ExportProfile::Fast) ? 85 :
+                    (profile == ExportProfile::Smallest) ? 75 : 90);
+                }
+            else if (imageType == wxBITMAP_TYPE_PNG)
+                {
+                if (profile == ExportProfile::Fast)
+                    {
+                    // charts are mostly runs of flat colors, so run-length encoding
+                    // (Z_RLE) at the lowest level compresses them nearly as well and much faster
+                    image.SetOption(wxIMAGE_OPTION_PNG_COMPRESSION_LEVEL, 1);
+                    image.SetOption(wxIMAGE_OPTION_PNG_COMPRESSION_STRATEGY, 3);
+                    }
+                else
+                    {
+                    image.SetOption(wxIMAGE_OPTION_PNG_COMPRESSION_LEVEL,
+                        (profile == ExportProfile::Smallest) ? 9 : 6);
+                    }
+                }
+            else if (imageType == wxBITMAP_TYPE_GIF)
+                {
+                // "dumb" image down to 256 colors, unless it already fits in a GIF palette
+                // (which charts usually do)
+                wxImageHistogram histogram;
+                if (image.ComputeHistogram(histogram) > 256)
+                    { wxQuantize::Quantize(image, image, 256); }
+                }
+            }
         };
 
-    /// @brief Options dialog for saving an image. Includes options for color/B&W, tiff compression, etc.
-    /// @details Canvas save events use this dialog, so normally client code should not need to use this interface.
+    /** @brief Options dialog for saving an image. Includes options for color/B&W, tiff compression, etc.
+        @details Canvas save events use this dialog, so normally client code should not need to use this interface.\n
+         The preview image is only rendered once (by the caller); changing the color mode
+         is previewed by converting that image (once per mode), and the estimated file size and
+         encoding time are extrapolated from encoding that image in memory with the selected options.
+        @note The estimates are only approximate. They are scaled up from the preview by its number of pixels,
+         but how well an image compresses also depends on its size and content (e.g., a larger rendering
+         has smoother areas, which usually compress better).*/
     class ImageExportDlg final : public wxDialog
         {
     public:
@@ -81,7 +149,8 @@ namespace Wisteria::UI
                        const wxPoint& pos = wxDefaultPosition, const wxSize& size = wxDefaultSize,
                        long style = wxDEFAULT_DIALOG_STYLE|wxCLIP_CHILDREN) :
                        m_options(options),
-                       m_originalBitmap(previewImg)
+                       m_originalBitmap(previewImg),
+                       m_bitmapType(bitmapType)
             {
             Create(parent, bitmapType, id, caption, pos, size, style);
             }
@@ -118,11 +187,29 @@ namespace Wisteria::UI
             m_helpTopic = topicPath;
             }
     private:
+        /// @brief The results of encoding the preview image with a set of options.
+        struct EncodingSample
+            {
+            int m_mode{ 0 };
+            int m_profile{ 0 };
+            TiffCompression m_tiffCompression{ TiffCompression::CompressionNone };
+            size_t m_fileSize{ 0 };
+            std::chrono::microseconds m_encodeTime{ 0 };
+            };
+
         void CreateControls(const wxBitmapType bitmapType);
 
         void OnOK([[maybe_unused]] wxCommandEvent& event);
         void OnOptionsChanged([[maybe_unused]] wxCommandEvent& event);
+        void OnEncodingChanged([[maybe_unused]] wxCommandEvent& event);
         void OnSizeChanged(wxSpinEvent& event);
+        /// @returns The TIFF compression selected in the dialog.
+        [[nodiscard]] TiffCompression GetSelectedTiffCompression() const;
+        /// @returns The preview image, in the selected color mode.
+        [[nodiscard]] const wxImage& GetPreviewImage();
+        /// @brief Updates the estimated file size and encoding time for the current options.
+        /// @note These are approximations, extrapolated from encoding the (smaller) preview image.
+        void UpdateEstimate();
         void OnHelpClicked([[maybe_unused]] wxCommandEvent& event)
             {
             if (m_helpTopic.length())
@@ -137,13 +224,22 @@ namespace Wisteria::UI
         static constexpr int COLOR_MODE_COMBO_ID = wxID_HIGHEST + 1;
         static constexpr int IMAGE_WIDTH_ID = wxID_HIGHEST + 2;
         static constexpr int IMAGE_HEIGHT_ID = wxID_HIGHEST + 3;
+        static constexpr int EXPORT_PROFILE_ID = wxID_HIGHEST + 4;
+        static constexpr int TIFF_COMPRESSION_ID = wxID_HIGHEST + 5;
 
         ImageExportOptions m_options;
 
         wxBitmap m_originalBitmap{ wxNullBitmap };
+        wxBitmapType m_bitmapType{ wxBITMAP_TYPE_ANY };
+        // the preview (converted from the bitmap once), and its grayscale version
+        // (converted when first requested)
+        wxImage m_previewImage;
+        wxImage m_grayscalePreviewImage;
+        std::optional<EncodingSample> m_encodingSample;
 
         wxComboBox* m_tiffCompressionCombo{ nullptr };
         Thumbnail* m_previewThumbnail{ nullptr };
+        wxStaticText* m_estimateLabel{ nullptr };
 
         wxString m_helpProjectFolder;
         wxString m_helpTopic;
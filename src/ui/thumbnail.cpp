@@ -124,6 +124,7 @@ namespace Wisteria::UI
     void Thumbnail::SetBitmap(const wxBitmap& bmp)
         {
         m_img = GraphItems::Image(bmp.ConvertToImage());
+        ResetScaledThumbnails();
         const wxSize newSize = m_img.SetBestSize(GetSize());
         SetSize(newSize);
         SetMinSize(newSize);
@@ -135,6 +136,7 @@ namespace Wisteria::UI
     bool Thumbnail::LoadImage(const wxString& filePath)
         {
         m_img = GraphItems::Image(GraphItems::Image::LoadFile(filePath));
+        ResetScaledThumbnails();
         const wxSize newSize = m_img.SetBestSize(GetSize());
         SetSize(newSize);
         SetMinSize(newSize);
@@ -151,13 +153,19 @@ namespace Wisteria::UI
         dc.Clear();
         if (m_img.IsOk())
             {
-            m_img.SetDPIScaleFactor(GetDPIScaleFactor());
-            m_img.SetOpacity(GetOpacity());
-            m_img.SetAnchoring(Anchoring::TopLeftCorner);
-            m_img.SetAnchorPoint(
-                wxPoint(safe_divide(GetSize().GetWidth() - m_img.GetImageSize().GetWidth(), 2),
-                        safe_divide(GetSize().GetHeight() - m_img.GetImageSize().GetHeight(), 2)));
-            m_img.Draw(dc);
+            const wxSize imageSize{ m_img.GetImageSize() };
+            const wxPoint topLeftCorner(
+                safe_divide(GetSize().GetWidth() - imageSize.GetWidth(), 2),
+                safe_divide(GetSize().GetHeight() - imageSize.GetHeight(), 2));
+            if (const auto* scaledThumbnail = FindScaledThumbnail(imageSize);
+                scaledThumbnail != nullptr)
+                { dc.DrawBitmap(*scaledThumbnail, topLeftCorner); }
+            // show a rough version until it is scaled properly
+            else if (imageSize.GetWidth() > 0 && imageSize.GetHeight() > 0)
+                {
+                dc.DrawBitmap(GetPlaceholder(imageSize), topLeftCorner);
+                StartScaling(imageSize);
+                }
             }
         else
             {
@@ -198,39 +206,49 @@ namespace Wisteria::UI
             if (m_img.GetOriginalImage().GetWidth() <= GetSize().GetWidth() &&
                 m_img.GetOriginalImage().GetHeight() <= GetSize().GetHeight())
                 { return; }
-            // rescale image if caller requested a size different from the original bitmap's size
-            wxBitmap canvasBmp{ m_img.GetOriginalImage() };
-
-            const std::pair<double,double> scaledSize =
-                geometry::calculate_downscaled_size(
-                    std::make_pair<double, double>(canvasBmp.GetWidth(),canvasBmp.GetHeight()),
-                    std::make_pair<double, double>(wxSystemSettings::GetMetric(wxSYS_SCREEN_X),
-                                                   wxSystemSettings::GetMetric(wxSYS_SCREEN_Y)));
-            if (wxSize(scaledSize.first, scaledSize.second) != canvasBmp.GetSize())
-                { canvasBmp = wxBitmap(canvasBmp.ConvertToImage().Rescale(scaledSize.first, scaledSize.second, wxIMAGE_QUALITY_HIGH)); }
-            // add a little "click to close" label at the bottom of the full image
-            wxMemoryDC memDC(canvasBmp);
-            memDC.SetFont(wxFont(wxSystemSettings::GetFont(wxSYS_DEFAULT_GUI_FONT).GetPointSize(),
-                                 wxFONTFAMILY_DEFAULT, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL,
-                                 false, L"Times New Roman"));
-            memDC.SetTextForeground(*wxBLUE);
-            memDC.SetPen(*wxBLACK_PEN);
-            memDC.SetBrush(wxBrush(wxColour(L"#FFFFDD")));
-            wxCoord width, height;
-            const wxString label(_(L"Click to close"));
-            memDC.GetTextExtent(label, &width, &height);
-            memDC.DrawRoundedRectangle(canvasBmp.GetWidth()-(width+14), canvasBmp.GetHeight()-(height+14),
-                width+8, height+8, 2);
-            memDC.DrawText(label, canvasBmp.GetWidth()-(width+10), canvasBmp.GetHeight()-(height+10));
-            // draw a border around the image (some platforms don't put a border around dialogs)
-            memDC.SetPen(*wxBLACK_PEN);
-                memDC.DrawLine(0,0,memDC.GetSize().GetWidth(),0);
-                memDC.DrawLine(0,memDC.GetSize().GetHeight()-1,memDC.GetSize().GetWidth(),memDC.GetSize().GetHeight()-1);
-                memDC.DrawLine(0,0,0,memDC.GetSize().GetHeight());
-                memDC.DrawLine(memDC.GetSize().GetWidth()-1,0,memDC.GetSize().GetWidth()-1,memDC.GetSize().GetHeight());
-            memDC.SelectObject(wxNullBitmap);
-
-            EnlargedImageWindow enlargedImage(canvasBmp, this);
+            const wxSize screenSize(wxSystemSettings::GetMetric(wxSYS_SCREEN_X),
+                                    wxSystemSettings::GetMetric(wxSYS_SCREEN_Y));
+            // reuse the full-size preview from the last click,
+            // unless the screen's resolution has changed
+            if (!m_enlargedBitmap.IsOk() || m_enlargedScreenSize != screenSize)
+                {
+                // downscale the image (not a bitmap of it) to fit the screen, so that
+                // it only needs to be converted to a bitmap once
+                wxImage enlargedImg{ m_img.GetOriginalImage() };
+                const std::pair<double,double> scaledSize =
+                    geometry::calculate_downscaled_size(
+                        std::make_pair<double, double>(enlargedImg.GetWidth(), enlargedImg.GetHeight()),
+                        std::make_pair<double, double>(screenSize.GetWidth(), screenSize.GetHeight()));
+                if (wxSize(scaledSize.first, scaledSize.second) != enlargedImg.GetSize())
+                    { enlargedImg = enlargedImg.Scale(scaledSize.first, scaledSize.second, wxIMAGE_QUALITY_HIGH); }
+                wxBitmap canvasBmp{ enlargedImg };
+                // add a little "click to close" label at the bottom of the full image
+                wxMemoryDC memDC(canvasBmp);
+                memDC.SetFont(wxFont(wxSystemSettings::GetFont(wxSYS_DEFAULT_GUI_FONT).GetPointSize(),
+                                     wxFONTFAMILY_DEFAULT, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL,
+                                     false, L"Times New Roman"));
+                memDC.SetTextForeground(*wxBLUE);
+                memDC.SetPen(*wxBLACK_PEN);
+                memDC.SetBrush(wxBrush(wxColour(L"#FFFFDD")));
+                wxCoord width, height;
+                const wxString label(_(L"Click to close"));
+                memDC.GetTextExtent(label, &width, &height);
+                memDC.DrawRoundedRectangle(canvasBmp.GetWidth()-(width+14), canvasBmp.GetHeight()-(height+14),
+                    width+8, height+8, 2);
+                memDC.DrawText(label, canvasBmp.GetWidth()-(width+10), canvasBmp.GetHeight()-(height+10));
+                // draw a border around the image (some platforms don't put a border around dialogs)
+                memDC.SetPen(*wxBLACK_PEN);
+                    memDC.DrawLine(0,0,memDC.GetSize().GetWidth(),0);
+                    memDC.DrawLine(0,memDC.GetSize().GetHeight()-1,memDC.GetSize().GetWidth(),memDC.GetSize().GetHeight()-1);
+                    memDC.DrawLine(0,0,0,memDC.GetSize().GetHeight());
+                    memDC.DrawLine(memDC.GetSize().GetWidth()-1,0,memDC.GetSize().GetWidth()-1,memDC.GetSize().GetHeight());
+                memDC.SelectObject(wxNullBitmap);
+
+                m_enlargedBitmap = canvasBmp;
+                m_enlargedScreenSize = screenSize;
+                }
+
+            EnlargedImageWindow enlargedImage(m_enlargedBitmap, this);
             // would be nice to show with wxSHOW_EFFECT_EXPAND, but it looks really bad on Windows
             enlargedImage.ShowModal();
             }
@@ -243,4 +261,84 @@ namespace Wisteria::UI
                 { SetBitmap(wxBitmap(GraphItems::Image::LoadFile(fileDlg.GetPath()))); }
             }
         }
+    
+    //----------------------------------
+    const wxBitmap* Thumbnail::FindScaledThumbnail(const wxSize size)
+        {
+        const auto scaledThumbnail = std::find_if(m_scaledThumbnails.begin(), m_scaledThumbnails.end(),
+            [this, &size](const auto& thumbnail) noexcept
+            { return thumbnail.m_size == size && thumbnail.m_opacity == GetOpacity(); });
+        if (scaledThumbnail == m_scaledThumbnails.end())
+            { return nullptr; }
+        // move it to the front, so that the least recently used one is evicted first
+        m_scaledThumbnails.splice(m_scaledThumbnails.begin(), m_scaledThumbnails, scaledThumbnail);
+        return &m_scaledThumbnails.front().m_bitmap;
+        }
+
+    //----------------------------------
+    const wxBitmap& Thumbnail::GetPlaceholder(const wxSize size)
+        {
+        if (!m_placeholder.m_bitmap.IsOk() || m_placeholder.m_size != size ||
+            m_placeholder.m_opacity != GetOpacity())
+            {
+            // nearest-neighbor scaling is rough, but quick enough to do while painting
+            wxImage placeholder =
+                m_img.GetOriginalImage().Scale(size.GetWidth(), size.GetHeight(), wxIMAGE_QUALITY_NEAREST);
+            GraphItems::Image::SetOpacity(placeholder, GetOpacity(), true);
+            m_placeholder = ScaledThumbnail{ size, GetOpacity(), wxBitmap(placeholder) };
+            }
+        return m_placeholder.m_bitmap;
+        }
+
+    //----------------------------------
+    void Thumbnail::StartScaling(const wxSize size)
+        {
+        // already scaling; when it's done, the thumbnail is repainted and
+        // will request the size that it needs then
+        if (m_scalingTask.valid())
+            { return; }
+        m_scalingRequest = ScaledThumbnail{ size, GetOpacity(), wxNullBitmap };
+        m_scalingGeneration = m_imageGeneration;
+        // the background thread gets its own (deep) copy of the image,
+        // as wxImage's reference counting isn't thread safe
+        m_scalingTask = std::async(std::launch::async,
+            [this, image = m_img.GetOriginalImage().Copy(), size, opacity = GetOpacity()]() mutable
+            {
+            image.Rescale(size.GetWidth(), size.GetHeight(), wxIMAGE_QUALITY_HIGH);
+            GraphItems::Image::SetOpacity(image, opacity, true);
+            // bitmaps need to be created in the main thread
+            CallAfter([this]() { FinishScaling(); });
+            return image;
+            });
+        }
+
+    //----------------------------------
+    void Thumbnail::FinishScaling()
+        {
+        if (!m_scalingTask.valid())
+            { return; }
+        const wxImage scaledImage = m_scalingTask.get();
+        // the image was changed while it was being scaled
+        if (m_scalingGeneration != m_imageGeneration || !scaledImage.IsOk())
+            {
+            Refresh();
+            return;
+            }
+
+        if (m_scaledThumbnails.size() >= MAX_SCALED_THUMBNAILS)
+            { m_scaledThumbnails.pop_back(); }
+        m_scalingRequest.m_bitmap = wxBitmap(scaledImage);
+        m_scaledThumbnails.push_front(std::move(m_scalingRequest));
+        m_scalingRequest = ScaledThumbnail{};
+        Refresh();
+        }
+
+    //----------------------------------
+    void Thumbnail::ResetScaledThumbnails()
+        {
+        ++m_imageGeneration;
+        m_scaledThumbnails.clear();
+        m_placeholder = ScaledThumbnail{};
+        m_enlargedBitmap = wxNullBitmap;
+        }
     }
\ No newline at end of file
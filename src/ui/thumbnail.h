@@ -22,6 +22,8 @@
 #include <wx/dcbuffer.h>
 #include <wx/dnd.h>
 #include <wx/filename.h>
+#include <future>
+#include <list>
 #include "../base/image.h"
 
 namespace Wisteria::UI
@@ -49,7 +51,11 @@ namespace Wisteria::UI
         wxBitmap m_bitmap;
         };
 
-    /// @brief A thumbnail control, which includes previewing the full image and (optional) drag 'n' drop support.
+    /** @brief A thumbnail control, which includes previewing the full image and (optional) drag 'n' drop support.
+        @details Scaling the image down to the thumbnail's size is done on a background thread;
+         until it finishes, a quickly (but roughly) scaled version of the image is shown.
+         The last few sizes that the image was scaled to are kept, so resizing back and forth
+         (e.g., in a gallery of thumbnails) doesn't scale the image again.*/
     class Thumbnail : public wxWindow
         {
     public:
@@ -80,6 +86,13 @@ namespace Wisteria::UI
         Thumbnail(const Thumbnail&) = delete;
         /// @private
         Thumbnail& operator=(const Thumbnail&) = delete;
+        /// @private
+        ~Thumbnail()
+            {
+            // the background scaling refers to this control, so let it finish
+            if (m_scalingTask.valid())
+                { m_scalingTask.wait(); }
+            }
 
         /** @brief Loads an image (from path) into the thumbnail.
             @param filePath The path to the image.
@@ -105,13 +118,51 @@ namespace Wisteria::UI
         [[nodiscard]] uint8_t GetOpacity() const noexcept
             { return m_opactity; }
     private:
+        /// @brief The image scaled (and made translucent) for the thumbnail.
+        struct ScaledThumbnail
+            {
+            wxSize m_size;
+            uint8_t m_opacity{ wxALPHA_OPAQUE };
+            wxBitmap m_bitmap;
+            };
+
         void OnResize(wxSizeEvent& event);
         void OnClick([[maybe_unused]] wxMouseEvent& event);
         void OnPaint([[maybe_unused]] wxPaintEvent& event);
 
+        /// @returns The image already scaled to the specified size and the current opacity,
+        ///     or null if it hasn't been scaled to that yet.
+        /// @note If found, it is moved to the front of the cache (as the most recently used).
+        [[nodiscard]] const wxBitmap* FindScaledThumbnail(const wxSize size);
+        /// @returns A roughly scaled version of the image, to show until the
+        ///     (high quality) scaling is finished.
+        [[nodiscard]] const wxBitmap& GetPlaceholder(const wxSize size);
+        /// @brief Starts scaling the image to a size on a background thread
+        ///     (unless it is already scaling the image).
+        void StartScaling(const wxSize size);
+        /// @brief Stores the scaled image from the background thread and repaints.
+        void FinishScaling();
+        /// @brief Clears all scaled versions of the image (e.g., when the image is changed).
+        void ResetScaledThumbnails();
+
         Wisteria::GraphItems::Image m_img;
         ClickMode m_clickMode{ ClickMode::FullSizeViewable };
         uint8_t m_opactity{ wxALPHA_OPAQUE };
+
+        // scaled versions of the image, the most recently used first
+        std::list<ScaledThumbnail> m_scaledThumbnails;
+        ScaledThumbnail m_placeholder;
+        std::future<wxImage> m_scalingTask;
+        ScaledThumbnail m_scalingRequest;
+        // which image the background scaling is for, so that results for a
+        // previous image are thrown away
+        size_t m_imageGeneration{ 0 };
+        size_t m_scalingGeneration{ 0 };
+        constexpr static size_t MAX_SCALED_THUMBNAILS{ 4 };
+
+        // the full-size preview (with its label drawn on it), and the screen size it was made for
+        wxBitmap m_enlargedBitmap;
+        wxSize m_enlargedScreenSize;
         };
 
     // Drop file handler for thumbnail control.
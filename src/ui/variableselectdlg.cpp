@@ -46,7 +46,116 @@ void VariableSelectDlg::UpdateButtonStates()
     }
 
 //-------------------------------------------------------------
-void VariableSelectDlg::MoveSelectedVariablesBetweenLists(wxListView* list, wxListView* otherList)
+VariableSelectDlg::VariableListCtrl::VariableListCtrl(wxWindow* parent,
+    const Data::Dataset::ColumnPreviewInfo& columnInfo, const long style) :
+    wxListView(parent, wxID_ANY, wxDefaultPosition, wxDefaultSize, style|wxLC_VIRTUAL),
+    m_columnInfo(columnInfo)
+    {
+    InsertColumn(0, wxEmptyString);
+    // autosizing would need to measure every item, so just fill the list's width
+    Bind(wxEVT_SIZE,
+        [this](wxSizeEvent& event)
+            {
+            SetColumnWidth(0, GetClientSize().GetWidth());
+            event.Skip();
+            });
+    }
+
+//-------------------------------------------------------------
+wxString VariableSelectDlg::VariableListCtrl::OnGetItemText(long item,
+                                                            [[maybe_unused]] long column) const
+    {
+    return (item >= 0 && static_cast<size_t>(item) < m_visibleColumns.size()) ?
+        m_columnInfo[m_visibleColumns[item]].first : wxString{};
+    }
+
+//-------------------------------------------------------------
+void VariableSelectDlg::VariableListCtrl::AddColumns(const std::vector<size_t>& columns,
+                                                     const bool keepColumnOrder)
+    {
+    const auto previousSize = m_columns.size();
+    m_columns.insert(m_columns.cend(), columns.cbegin(), columns.cend());
+    if (keepColumnOrder)
+        {
+        auto newColumns = m_columns.begin() + previousSize;
+        std::sort(newColumns, m_columns.end());
+        std::inplace_merge(m_columns.begin(), newColumns, m_columns.end());
+        }
+    RefreshVisibleColumns();
+    }
+
+//-------------------------------------------------------------
+std::vector<size_t> VariableSelectDlg::VariableListCtrl::TakeSelectedColumns()
+    {
+    std::vector<size_t> selectedColumns;
+    selectedColumns.reserve(GetSelectedItemCount());
+    for (long item = GetFirstSelected(); item != wxNOT_FOUND; item = GetNextSelected(item))
+        { selectedColumns.push_back(m_visibleColumns[item]); }
+    if (selectedColumns.empty())
+        { return selectedColumns; }
+
+    // remove them all in one pass
+    auto sortedColumns{ selectedColumns };
+    std::sort(sortedColumns.begin(), sortedColumns.end());
+    m_columns.erase(std::remove_if(m_columns.begin(), m_columns.end(),
+        [&sortedColumns](const auto column)
+        { return std::binary_search(sortedColumns.cbegin(), sortedColumns.cend(), column); }),
+        m_columns.end());
+    RefreshVisibleColumns();
+    return selectedColumns;
+    }
+
+//-------------------------------------------------------------
+void VariableSelectDlg::VariableListCtrl::SetFilter(const wxString& filter)
+    {
+    const wxString lowerFilter = filter.Lower();
+    if (lowerFilter == m_filter)
+        { return; }
+    if (m_lowerCaseNames.empty() && !lowerFilter.empty())
+        {
+        m_lowerCaseNames.reserve(m_columnInfo.size());
+        for (const auto& [name, type] : m_columnInfo)
+            { m_lowerCaseNames.push_back(name.Lower()); }
+        }
+    // if more was typed onto the filter, then only the columns that matched
+    // the previous filter need to be searched again
+    const bool isNarrowing = (!m_filter.empty() && lowerFilter.StartsWith(m_filter));
+    m_filter = lowerFilter;
+    if (isNarrowing)
+        {
+        m_visibleColumns.erase(std::remove_if(m_visibleColumns.begin(), m_visibleColumns.end(),
+            [this](const auto column)
+            { return m_lowerCaseNames[column].find(m_filter) == wxString::npos; }),
+            m_visibleColumns.end());
+        SetItemCount(m_visibleColumns.size());
+        SetItemState(-1, 0, wxLIST_STATE_SELECTED);
+        Refresh();
+        }
+    else
+        { RefreshVisibleColumns(); }
+    }
+
+//-------------------------------------------------------------
+void VariableSelectDlg::VariableListCtrl::RefreshVisibleColumns()
+    {
+    if (m_filter.empty())
+        { m_visibleColumns = m_columns; }
+    else
+        {
+        m_visibleColumns.clear();
+        std::copy_if(m_columns.cbegin(), m_columns.cend(), std::back_inserter(m_visibleColumns),
+            [this](const auto column)
+            { return m_lowerCaseNames[column].find(m_filter) != wxString::npos; });
+        }
+    SetItemCount(m_visibleColumns.size());
+    // the rows now refer to different columns, so the selection is meaningless
+    SetItemState(-1, 0, wxLIST_STATE_SELECTED);
+    Refresh();
+    }
+
+//-------------------------------------------------------------
+void VariableSelectDlg::MoveSelectedVariablesBetweenLists(VariableListCtrl* list,
+                                                          VariableListCtrl* otherList)
     {
     wxASSERT_MSG(list, "Invalid list control!");
     wxASSERT_MSG(otherList, "Invalid list control!");
@@ -56,7 +165,7 @@ void VariableSelectDlg::MoveSelectedVariablesBetweenLists(wxListView* list, wxLi
     // have more than one after moving
     if (otherList->HasFlag(wxLC_SINGLE_SEL))
         {
-        if (otherList->GetItemCount() ||
+        if (otherList->GetColumns().size() ||
             list->GetSelectedItemCount() > 1)
             {
             wxMessageBox(_(L"Only one variable is allowed in this list."),
@@ -65,41 +174,8 @@ void VariableSelectDlg::MoveSelectedVariablesBetweenLists(wxListView* list, wxLi
             return;
             }
         }
-    const auto selStrings = GetSelectedVariablesInList(list);
-    wxWindowUpdateLocker noUpdates(otherList);
-    for (const auto& str : selStrings)
-        { otherList->InsertItem(otherList->GetItemCount(), str); }
-    otherList->SetColumnWidth(0, wxLIST_AUTOSIZE);
-    RemoveSelectedVariablesFromList(list);
-    }
-
-//-------------------------------------------------------------
-std::vector<wxString> VariableSelectDlg::GetSelectedVariablesInList(wxListView* list)
-    {
-    std::vector<wxString> selStrings;
-    long item{ wxNOT_FOUND };
-    for (;;)
-        {
-        item = list->GetNextItem(item, wxLIST_NEXT_ALL, wxLIST_STATE_SELECTED);
-        if (item == wxNOT_FOUND)
-            { break; }
-        selStrings.emplace_back(list->GetItemText(item));
-        }
-    return selStrings;
-    };
-
-//-------------------------------------------------------------
-void VariableSelectDlg::RemoveSelectedVariablesFromList(wxListView* list)
-    {
-    wxWindowUpdateLocker noUpdates(list);
-    long item{ wxNOT_FOUND };
-    for (;;)
-        {
-        item = list->GetNextItem(item, wxLIST_NEXT_ALL, wxLIST_STATE_SELECTED);
-        if (item == wxNOT_FOUND)
-            { break; }
-        list->DeleteItem(item--);
-        }
+    // variables moved back to the main list go back to where they were in the file
+    otherList->AddColumns(list->TakeSelectedColumns(), (otherList == m_mainVarlist));
     }
 
 //-------------------------------------------------------------
@@ -112,9 +188,9 @@ std::vector<wxString> VariableSelectDlg::GetSelectedVariables(const size_t listI
         }
     const auto& varList = m_varLists[listIndex];
     std::vector<wxString> strings;
-    strings.reserve(varList.m_list->GetItemCount());
-    for (auto i = 0; i < varList.m_list->GetItemCount(); ++i)
-        { strings.emplace_back(varList.m_list->GetItemText(i)); }
+    strings.reserve(varList.m_list->GetColumns().size());
+    for (const auto column : varList.m_list->GetColumns())
+        { strings.emplace_back(m_columnInfo[column].first); }
     return strings;
     };
 
@@ -127,17 +203,29 @@ void VariableSelectDlg::CreateControls(const std::vector<VariableListInfo>& varI
     mainSizer->Add(varsSizer,
         wxSizerFlags(1).Expand().Border(wxALL, wxSizerFlags::GetDefaultBorder()));
 
-    // fill the main list of variables
-    varsSizer->Add(new wxStaticText(this, wxID_ANY, _(L"Variables")),
+    // fill the main list of variables (along with a search box to filter it)
+    auto mainVarlistLabelSizer = new wxBoxSizer(wxHORIZONTAL);
+    mainVarlistLabelSizer->Add(new wxStaticText(this, wxID_ANY, _(L"Variables")),
+        wxSizerFlags().CenterVertical());
+    mainVarlistLabelSizer->AddStretchSpacer();
+    auto searchCtrl = new wxSearchCtrl(this, wxID_ANY);
+    searchCtrl->SetDescriptiveText(_(L"Filter"));
+    mainVarlistLabelSizer->Add(searchCtrl);
+    varsSizer->Add(mainVarlistLabelSizer,
         wxGBPosition(0, 0), wxGBSpan(1, 1), wxEXPAND|wxALL);
-    m_mainVarlist = new wxListView(this, wxID_ANY, wxDefaultPosition, wxDefaultSize,
-                               wxLC_REPORT|wxLC_NO_HEADER);
-    m_mainVarlist->InsertColumn(0, wxEmptyString);
-    for (const auto& [name, type] : m_columnInfo)
-        { m_mainVarlist->InsertItem(m_mainVarlist->GetItemCount(), name); }
-    m_mainVarlist->SetColumnWidth(0, wxLIST_AUTOSIZE);
+    m_mainVarlist = new VariableListCtrl(this, m_columnInfo, wxLC_REPORT|wxLC_NO_HEADER);
+    std::vector<size_t> allColumns(m_columnInfo.size());
+    std::iota(allColumns.begin(), allColumns.end(), 0);
+    m_mainVarlist->AddColumns(allColumns, false);
     varsSizer->Add(m_mainVarlist, wxGBPosition(1, 0), wxGBSpan(3, 1), wxEXPAND|wxALL);
 
+    searchCtrl->Bind(wxEVT_TEXT,
+        [this](wxCommandEvent& event)
+            {
+            m_mainVarlist->SetFilter(event.GetString());
+            UpdateButtonStates();
+            });
+
     // set up the variable groups on the right side
     int currentButtonRow{ 1 };
     int currentLabelRow{ 0 };
@@ -162,8 +250,7 @@ void VariableSelectDlg::CreateControls(const std::vector<VariableListInfo>& varI
             wxGBPosition(currentLabelRow, 2), wxGBSpan(1, 1), wxEXPAND|wxALL);
         currentLabelRow += 2;
 
-        auto list = new wxListView(this, wxID_ANY, wxDefaultPosition, wxDefaultSize, listStyle);
-        list->InsertColumn(0, wxEmptyString);
+        auto list = new VariableListCtrl(this, m_columnInfo, listStyle);
         varsSizer->Add(list, wxGBPosition(currentListRow, 2), wxGBSpan(1, 1), wxEXPAND|wxALL);
         currentListRow += 2;
 
@@ -244,7 +331,7 @@ bool VariableSelectDlg::Validate()
         {
         if (varList.m_required &&
             varList.m_list &&
-            varList.m_list->GetItemCount() == 0)
+            varList.m_list->GetColumns().empty())
             {
             wxMessageBox(
                 wxString::Format(
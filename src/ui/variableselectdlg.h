@@ -21,12 +21,19 @@
 #include <wx/stattext.h>
 #include <wx/artprov.h>
 #include <wx/wupdlock.h>
+#include <wx/srchctrl.h>
+#include <algorithm>
+#include <numeric>
 #include "../data/dataset.h"
 
 namespace Wisteria::UI
     {
     /** @brief Dialog for selecting variables for an analysis.
-    
+        @details The variable lists are virtual (they read the column names straight from
+         the column information), so the dialog opens just as quickly for files with thousands
+         of columns. The list of available variables can also be filtered by typing into the
+         search box above it.
+
         @par Example:
         @code
          // This will create a selection dialog with a list
@@ -120,13 +127,58 @@ namespace Wisteria::UI
         /// @returns A list of the variable names that the user has selected for a given list.
         std::vector<wxString> GetSelectedVariables(const size_t listIndex) const;
     private:
+        /// @brief A virtual list of variables, which stores the indices of its
+        ///     columns (into the dialog's column information) rather than their names.
+        class VariableListCtrl final : public wxListView
+            {
+        public:
+            /// @brief Constructor.
+            /// @param parent The parent window.
+            /// @param columnInfo The columns that the list's items refer to.
+            /// @param style The list's style.
+            VariableListCtrl(wxWindow* parent, const Data::Dataset::ColumnPreviewInfo& columnInfo,
+                             const long style);
+            /// @private
+            VariableListCtrl(const VariableListCtrl&) = delete;
+            /// @private
+            VariableListCtrl& operator=(const VariableListCtrl&) = delete;
+
+            /// @brief Adds columns to the list.
+            /// @param columns The indices of the columns to add.
+            /// @param keepColumnOrder @c true to keep the list in the order of the columns
+            ///     (e.g., for the list of available variables); otherwise, they are added to the end.
+            void AddColumns(const std::vector<size_t>& columns, const bool keepColumnOrder);
+            /// @brief Removes the selected items from the list.
+            /// @returns The indices of the removed columns, in the order they were shown.
+            std::vector<size_t> TakeSelectedColumns();
+            /// @returns The indices of the columns in the list (including any filtered out).
+            [[nodiscard]] const std::vector<size_t>& GetColumns() const noexcept
+                { return m_columns; }
+            /** @brief Only shows the columns whose names contain a string.
+                @param filter The string to search for (case insensitively).
+                    An empty string will show all columns.*/
+            void SetFilter(const wxString& filter);
+        private:
+            [[nodiscard]] wxString OnGetItemText(long item, long column) const final;
+            /// @brief Updates the shown items after the columns or filter have changed.
+            void RefreshVisibleColumns();
+
+            const Data::Dataset::ColumnPreviewInfo& m_columnInfo;
+            std::vector<size_t> m_columns;
+            // the columns that match the filter (which are what the list shows)
+            std::vector<size_t> m_visibleColumns;
+            wxString m_filter;
+            // lowercased column names for filtering, built on first use
+            std::vector<wxString> m_lowerCaseNames;
+            };
+
         struct VariableList
             {
             wxString m_label;
             int m_addId{ wxID_ANY };
             int m_removeId{ wxID_ANY };
             bool m_singleSelection{ false };
-            wxListView* m_list{ nullptr };
+            VariableListCtrl* m_list{ nullptr };
             bool m_required{ false };
             };
 
@@ -135,19 +187,12 @@ namespace Wisteria::UI
         /// @brief Moves the selected variables in one list to another.
         /// @param list The list to move items from.
         /// @param otherList The sub list to move the variables into.
-        static void MoveSelectedVariablesBetweenLists(wxListView* list, wxListView* othotherListerlist);
-        /// @returns the list of variables selected a list.
-        /// @param list The list to get the selected items from.
-        /// @returns A vector of the selected strings.
-        [[nodiscard]] static std::vector<wxString> GetSelectedVariablesInList(wxListView* list);
-        /// @brief Removes the selected items from a list.
-        /// @param list The list box to remove items from.
-        static void RemoveSelectedVariablesFromList(wxListView* list);
+        void MoveSelectedVariablesBetweenLists(VariableListCtrl* list, VariableListCtrl* otherList);
         /// @brief Enables/disables buttons as needed.
         void UpdateButtonStates();
 
         Data::Dataset::ColumnPreviewInfo m_columnInfo;
-        wxListView* m_mainVarlist{ nullptr };
+        VariableListCtrl* m_mainVarlist{ nullptr };
         std::vector<VariableList> m_varLists;
         };
     }
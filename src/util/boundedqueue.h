@@ -0,0 +1,151 @@
+/** @addtogroup Utilities
+    @brief Utility classes.
+    @date 2005-2022
+    @copyright Blake Madden
+    @author Blake Madden
+    @details This program is free software; you can redistribute it and/or modify
+     it under the terms of the 3-Clause BSD License.
+
+     SPDX-License-Identifier: BSD-3-Clause
+@{*/
+
+#ifndef __BOUNDED_QUEUE_H__
+#define __BOUNDED_QUEUE_H__
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <utility>
+
+/** @brief A fixed-capacity, lock-free queue that any number of threads can push to
+        and pop from.
+    @details Each slot carries a sequence number that tells producers and consumers
+        whether it is free or filled for their turn around the ring, so pushing and
+        popping only need an atomic compare-and-swap on the queue's head or tail.
+        When the queue is full, TryPush() fails instead of blocking or allocating;
+        it is up to the caller to decide whether to drop the item or retry.
+    @note The capacity is rounded up to a power of two.
+    @par Example
+    @code
+        BoundedQueue<wxString> messages(1024);
+        if (!messages.TryPush(L"Import started"))
+            { ++droppedMessages; }
+        // ...then, on a worker thread
+        while (auto message = messages.TryPop())
+            { file.Write(*message); }
+    @endcode*/
+template<typename T>
+class BoundedQueue
+    {
+public:
+    /// @brief Constructor.
+    /// @param capacity The maximum number of items that the queue can hold.
+    explicit BoundedQueue(const size_t capacity) :
+        m_mask(RoundUpToPowerOfTwo(capacity) - 1),
+        m_cells(std::make_unique<Cell[]>(m_mask + 1))
+        {
+        for (size_t i = 0; i <= m_mask; ++i)
+            { m_cells[i].m_sequence.store(i, std::memory_order_relaxed); }
+        }
+    /// @private
+    BoundedQueue(const BoundedQueue&) = delete;
+    /// @private
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    /** @brief Adds an item to the back of the queue.
+        @param item The item to add.
+        @returns @c false if the queue is full (in which case @c item is left untouched).*/
+    [[nodiscard]] bool TryPush(T&& item)
+        {
+        size_t position = m_tail.load(std::memory_order_relaxed);
+        for (;;)
+            {
+            Cell& cell = m_cells[position & m_mask];
+            const size_t sequence = cell.m_sequence.load(std::memory_order_acquire);
+            const auto difference =
+                static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+            // slot is free for this turn, so try to claim it
+            if (difference == 0)
+                {
+                if (m_tail.compare_exchange_weak(position, position + 1,
+                                                 std::memory_order_relaxed))
+                    {
+                    cell.m_item = std::move(item);
+                    cell.m_sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                    }
+                }
+            // slot still holds an item from the previous turn (i.e., the queue is full)
+            else if (difference < 0)
+                { return false; }
+            // another producer claimed the slot, so try the next one
+            else
+                { position = m_tail.load(std::memory_order_relaxed); }
+            }
+        }
+    /// @brief Removes the item at the front of the queue.
+    /// @returns The item, or @c std::nullopt if the queue is empty.
+    [[nodiscard]] std::optional<T> TryPop()
+        {
+        size_t position = m_head.load(std::memory_order_relaxed);
+        for (;;)
+            {
+            Cell& cell = m_cells[position & m_mask];
+            const size_t sequence = cell.m_sequence.load(std::memory_order_acquire);
+            const auto difference =
+                static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+            if (difference == 0)
+                {
+                if (m_head.compare_exchange_weak(position, position + 1,
+                                                 std::memory_order_relaxed))
+                    {
+                    std::optional<T> item{ std::move(cell.m_item) };
+                    cell.m_item = T{};
+                    // free the slot for the producers' next turn around the ring
+                    cell.m_sequence.store(position + m_mask + 1, std::memory_order_release);
+                    return item;
+                    }
+                }
+            else if (difference < 0)
+                { return std::nullopt; }
+            else
+                { position = m_head.load(std::memory_order_relaxed); }
+            }
+        }
+    /// @returns The maximum number of items that the queue can hold.
+    [[nodiscard]] size_t GetCapacity() const noexcept
+        { return m_mask + 1; }
+    /// @returns The approximate number of items in the queue.
+    /// @note This is only a snapshot if other threads are using the queue.
+    [[nodiscard]] size_t GetApproximateSize() const noexcept
+        {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        return (tail >= head) ? (tail - head) : 0;
+        }
+private:
+    [[nodiscard]] static size_t RoundUpToPowerOfTwo(const size_t value) noexcept
+        {
+        size_t result{ 2 };
+        while (result < value)
+            { result <<= 1; }
+        return result;
+        }
+
+    struct Cell
+        {
+        std::atomic<size_t> m_sequence{ 0 };
+        T m_item{};
+        };
+
+    const size_t m_mask{ 0 };
+    std::unique_ptr<Cell[]> m_cells;
+    // producers and consumers are kept on separate cache lines
+    alignas(64) std::atomic<size_t> m_tail{ 0 };
+    alignas(64) std::atomic<size_t> m_head{ 0 };
+    };
+
+/** @}*/
+
+#endif //__BOUNDED_QUEUE_H__
@@ -16,14 +16,308 @@
 #include <unordered_map>
 #include <set>
 #include <unordered_set>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <cstdint>
+#include <cassert>
+
+/** @brief An insertion-ordered map that uses open addressing (linear probing) to look up its keys.
+    @details Entries are stored contiguously in a vector and a separate table of slots
+     maps hashed keys to their entries. This avoids the per-node allocations of
+     @c std::map and @c std::unordered_map, which dominate when counting large columns.
+    @note Iterators (and references to entries) are invalidated when new keys are inserted.
+     Only the interface needed by the frequency sets is provided (no erasing).*/
+template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>>
+class flat_hash_map
+    {
+public:
+    /// @private
+    using value_type = std::pair<K, V>;
+    /// @private
+    using container_type = std::vector<value_type>;
+    /// @private
+    using iterator = typename container_type::iterator;
+    /// @private
+    using const_iterator = typename container_type::const_iterator;
+    /** @brief Inserts a key and value if the key is not already in the map.
+        @param key The key.
+        @param value The value to assign to the key if it is newly inserted.
+        @returns An iterator to the key's entry and whether it was inserted.*/
+    std::pair<iterator, bool> try_emplace(const K& key, V value)
+        {
+        // keep the load factor at or below 1/2
+        if ((m_entries.size() + 1) * 2 > m_slots.size())
+            { rehash(std::max<size_t>(16, m_slots.size() * 2)); }
+        size_t slot = hash_slot(key);
+        while (m_slots[slot] != 0)
+            {
+            const auto entry = m_entries.begin() + (m_slots[slot] - 1);
+            if (m_equal(entry->first, key))
+                { return std::make_pair(entry, false); }
+            slot = (slot + 1) & (m_slots.size() - 1);
+            }
+        m_entries.emplace_back(key, std::move(value));
+        m_slots[slot] = m_entries.size();
+        return std::make_pair(std::prev(m_entries.end()), true);
+        }
+    /** @brief Finds a key.
+        @param key The key to search for.
+        @returns An iterator to the key's entry, or end() if not found.*/
+    [[nodiscard]] const_iterator find(const K& key) const
+        {
+        if (m_entries.empty())
+            { return cend(); }
+        size_t slot = hash_slot(key);
+        while (m_slots[slot] != 0)
+            {
+            const auto entry = m_entries.cbegin() + (m_slots[slot] - 1);
+            if (m_equal(entry->first, key))
+                { return entry; }
+            slot = (slot + 1) & (m_slots.size() - 1);
+            }
+        return cend();
+        }
+    /** @brief Reserves space for a number of unique keys.
+        @param size The number of keys to reserve space for.*/
+    void reserve(const size_t size)
+        {
+        m_entries.reserve(size);
+        size_t slotCount{ 16 };
+        while (slotCount < size * 2)
+            { slotCount *= 2; }
+        if (slotCount > m_slots.size())
+            { rehash(slotCount); }
+        }
+    /// @brief Clears the contents of the map.
+    void clear() noexcept
+        {
+        m_entries.clear();
+        m_slots.clear();
+        }
+    /// @returns The number of unique keys.
+    [[nodiscard]] size_t size() const noexcept
+        { return m_entries.size(); }
+    /// @returns @c true if the map is empty.
+    [[nodiscard]] bool empty() const noexcept
+        { return m_entries.empty(); }
+    /// @private
+    [[nodiscard]] iterator begin() noexcept
+        { return m_entries.begin(); }
+    /// @private
+    [[nodiscard]] iterator end() noexcept
+        { return m_entries.end(); }
+    /// @private
+    [[nodiscard]] const_iterator begin() const noexcept
+        { return m_entries.cbegin(); }
+    /// @private
+    [[nodiscard]] const_iterator end() const noexcept
+        { return m_entries.cend(); }
+    /// @private
+    [[nodiscard]] const_iterator cbegin() const noexcept
+        { return m_entries.cbegin(); }
+    /// @private
+    [[nodiscard]] const_iterator cend() const noexcept
+        { return m_entries.cend(); }
+private:
+    [[nodiscard]] size_t hash_slot(const K& key) const
+        {
+        // Fibonacci hashing spreads weak hashes (e.g., identity hashes for integers)
+        // across the power-of-two table
+        return static_cast<size_t>((static_cast<uint64_t>(m_hash(key)) * 0x9E3779B97F4A7C15ULL) >>
+                                   (64 - m_slotBits));
+        }
+    void rehash(const size_t slotCount)
+        {
+        m_slots.assign(slotCount, 0);
+        m_slotBits = 0;
+        while ((size_t{ 1 } << m_slotBits) < slotCount)
+            { ++m_slotBits; }
+        for (size_t i = 0; i < m_entries.size(); ++i)
+            {
+            size_t slot = hash_slot(m_entries[i].first);
+            while (m_slots[slot] != 0)
+                { slot = (slot + 1) & (m_slots.size() - 1); }
+            m_slots[slot] = i + 1;
+            }
+        }
+    container_type m_entries;
+    // zero is an empty slot, otherwise the (one-based) index into m_entries
+    std::vector<size_t> m_slots;
+    size_t m_slotBits{ 0 };
+    Hash m_hash;
+    KeyEqual m_equal;
+    };
+
+/** @brief An insertion-ordered map for small, non-negative integral keys
+     (e.g., group IDs or Likert codes) that indexes its entries directly by key.
+    @details The lookup table grows to the largest key inserted, so this should only
+     be used when the domain of keys is known to be small.
+    @note Iterators (and references to entries) are invalidated when new keys are inserted.*/
+template <typename K, typename V>
+class dense_map
+    {
+    static_assert(std::is_integral_v<K>, "dense_map requires integral keys.");
+public:
+    /// @private
+    using value_type = std::pair<K, V>;
+    /// @private
+    using container_type = std::vector<value_type>;
+    /// @private
+    using iterator = typename container_type::iterator;
+    /// @private
+    using const_iterator = typename container_type::const_iterator;
+    /** @brief Inserts a key and value if the key is not already in the map.
+        @param key The key (must not be negative).
+        @param value The value to assign to the key if it is newly inserted.
+        @returns An iterator to the key's entry and whether it was inserted.*/
+    std::pair<iterator, bool> try_emplace(const K& key, V value)
+        {
+        if constexpr (std::is_signed_v<K>)
+            { assert(key >= 0 && "dense_map keys cannot be negative!"); }
+        const auto index = static_cast<size_t>(key);
+        if (index >= m_slots.size())
+            { m_slots.resize(std::max(index + 1, m_slots.size() * 2), 0); }
+        if (m_slots[index] != 0)
+            { return std::make_pair(m_entries.begin() + (m_slots[index] - 1), false); }
+        m_entries.emplace_back(key, std::move(value));
+        m_slots[index] = m_entries.size();
+        return std::make_pair(std::prev(m_entries.end()), true);
+        }
+    /** @brief Finds a key.
+        @param key The key to search for.
+        @returns An iterator to the key's entry, or end() if not found.*/
+    [[nodiscard]] const_iterator find(const K& key) const
+        {
+        if constexpr (std::is_signed_v<K>)
+            {
+            if (key < 0)
+                { return cend(); }
+            }
+        if (static_cast<size_t>(key) >= m_slots.size() ||
+            m_slots[static_cast<size_t>(key)] == 0)
+            { return cend(); }
+        return m_entries.cbegin() + (m_slots[static_cast<size_t>(key)] - 1);
+        }
+    /** @brief Reserves space for keys up to (and including) a given value.
+        @param maxKey The largest key expected.*/
+    void reserve(const K& maxKey)
+        {
+        if constexpr (std::is_signed_v<K>)
+            {
+            if (maxKey < 0)
+                { return; }
+            }
+        if (static_cast<size_t>(maxKey) >= m_slots.size())
+            { m_slots.resize(static_cast<size_t>(maxKey) + 1, 0); }
+        }
+    /// @brief Clears the contents of the map.
+    void clear() noexcept
+        {
+        m_entries.clear();
+        m_slots.clear();
+        }
+    /// @returns The number of unique keys.
+    [[nodiscard]] size_t size() const noexcept
+        { return m_entries.size(); }
+    /// @returns @c true if the map is empty.
+    [[nodiscard]] bool empty() const noexcept
+        { return m_entries.empty(); }
+    /// @private
+    [[nodiscard]] iterator begin() noexcept
+        { return m_entries.begin(); }
+    /// @private
+    [[nodiscard]] iterator end() noexcept
+        { return m_entries.end(); }
+    /// @private
+    [[nodiscard]] const_iterator begin() const noexcept
+        { return m_entries.cbegin(); }
+    /// @private
+    [[nodiscard]] const_iterator end() const noexcept
+        { return m_entries.cend(); }
+    /// @private
+    [[nodiscard]] const_iterator cbegin() const noexcept
+        { return m_entries.cbegin(); }
+    /// @private
+    [[nodiscard]] const_iterator cend() const noexcept
+        { return m_entries.cend(); }
+private:
+    container_type m_entries;
+    // zero is an unused key, otherwise the (one-based) index into m_entries
+    std::vector<size_t> m_slots;
+    };
+
+/** @brief Storage policies for the frequency sets and maps.
+    @details Pass one of these as the @c Storage template argument to select how
+     the unique values are tracked:
+     - @c ordered_storage: a @c std::map (the default). Iterating get_data() is always sorted.
+     - @c hash_storage: an open-addressing hash table (flat_hash_map).
+       Faster for unordered counting; get_data() is in insertion order.
+     - @c dense_storage: a table indexed directly by the value (dense_map),
+       for small, non-negative integral domains. get_data() is in insertion order.
+
+     For the unordered backends, call get_sorted_data() when ordered output is needed;
+     the values are only sorted at that point.*/
+namespace frequency_storage
+    {
+    /// @brief Stores values in a @c std::map, keeping them sorted.
+    struct ordered_storage
+        {
+        /// @private
+        static constexpr bool is_ordered{ true };
+        /// @private
+        template <typename K, typename V, typename Compare>
+        using map_type = std::map<K, V, Compare>;
+        };
+
+    /// @brief Stores values in an open-addressing hash table.
+    struct hash_storage
+        {
+        /// @private
+        static constexpr bool is_ordered{ false };
+        /// @private
+        template <typename K, typename V, typename Compare>
+        using map_type = flat_hash_map<K, V>;
+        };
+
+    /// @brief Stores values in a table indexed by the (small, non-negative integral) value.
+    struct dense_storage
+        {
+        /// @private
+        static constexpr bool is_ordered{ false };
+        /// @private
+        template <typename K, typename V, typename Compare>
+        using map_type = dense_map<K, V>;
+        };
+
+    /** @private
+        @brief Copies a table's entries into a vector, sorting them by key if the storage is unordered.*/
+    template <typename Storage, typename Compare, typename MapT>
+    [[nodiscard]] auto sorted_entries(const MapT& table)
+        {
+        std::vector<std::pair<std::remove_const_t<typename MapT::value_type::first_type>,
+                              typename MapT::value_type::second_type>> entries(table.cbegin(), table.cend());
+        if constexpr (!Storage::is_ordered)
+            {
+            Compare comp;
+            std::sort(entries.begin(), entries.end(),
+                [&comp](const auto& lhv, const auto& rhv) { return comp(lhv.first, rhv.first); });
+            }
+        return entries;
+        }
+    }
 
 /// @brief Same as a std::set, but also keeps a frequency count of every unique value added.
-template <typename T, typename Compare = std::less<T>>
+/// @details Use a @c frequency_storage policy as the @c Storage argument to select the backend.
+template <typename T, typename Compare = std::less<T>,
+          typename Storage = frequency_storage::ordered_storage>
 class frequency_set
     {
 public:
     /// @private
-    using map_type = typename std::map<T, size_t, Compare>;
+    using map_type = typename Storage::template map_type<T, size_t, Compare>;
     /// @private
     using const_iterator = typename map_type::const_iterator;
     /** @brief Inserts an item into the set.
@@ -56,18 +350,24 @@ public:
     /// @returns The (const) set of values and their respective frequency counts.
     [[nodiscard]] const map_type& get_data() const noexcept
         { return m_table; }
+    /** @returns The values and their respective frequency counts, sorted by value.
+        @note With the default (ordered) storage, get_data() is already sorted
+         and avoids the copy.*/
+    [[nodiscard]] auto get_sorted_data() const
+        { return frequency_storage::sorted_entries<Storage, Compare>(m_table); }
 private:
     map_type m_table;
     };
 
 /// @brief Same as a frequency_set, expect it also enables the caller to
 /// increment a second frequency count based on a criterion.
-template <typename T, typename TCompare = std::less<T>>
+template <typename T, typename TCompare = std::less<T>,
+          typename Storage = frequency_storage::ordered_storage>
 class double_frequency_set
     {
 public:
     /// @private
-    using map_type = typename std::map<T, std::pair<size_t,size_t>, TCompare>;
+    using map_type = typename Storage::template map_type<T, std::pair<size_t,size_t>, TCompare>;
     /// @private
     using const_iterator = typename map_type::const_iterator;
     /** @brief Inserts an item into the set.
@@ -109,7 +409,7 @@ public:
     /** @brief Inserts another double_frequency_set into this one, copying over (or combining) the items,
          frequency counts, and custom counts.
         @param that The double_frequency_set to insert into this one.*/
-    void operator+=(const double_frequency_set<T,TCompare>& that)
+    void operator+=(const double_frequency_set<T,TCompare,Storage>& that)
         {
         for (auto iter = that.get_data().cbegin();
             iter != that.get_data().cend();
@@ -131,7 +431,7 @@ public:
          that are already in this set.
         @param that The double_frequency_set to insert into this one.
         @param frequencyIncrement The value to use to increment the custom count.*/
-    void insert_with_custom_increment(const double_frequency_set<T,TCompare>& that, const size_t frequencyIncrement = 1)
+    void insert_with_custom_increment(const double_frequency_set<T,TCompare,Storage>& that, const size_t frequencyIncrement = 1)
         {
         for (auto iter = that.get_data().cbegin();
             iter != that.get_data().cend();
@@ -150,6 +450,9 @@ public:
     /// @returns The set of values and their respective frequency counts.
     [[nodiscard]] const map_type& get_data() const noexcept
         { return m_table; }
+    /// @returns The values and their respective frequency and custom counts, sorted by value.
+    [[nodiscard]] auto get_sorted_data() const
+        { return frequency_storage::sorted_entries<Storage, TCompare>(m_table); }
 private:
     map_type m_table;
     };
@@ -157,12 +460,13 @@ private:
 /// @brief Same as a std::set, but also keeps a frequency count of every unique value added,
 ///  as well as an additional value to accumulate.
 /// @todo needs unit test
-template <typename T, typename Compare = std::less<T>>
+template <typename T, typename Compare = std::less<T>,
+          typename Storage = frequency_storage::ordered_storage>
 class aggregate_frequency_set
     {
 public:
     /// @private
-    using map_type = typename std::map<T, std::pair<size_t, double>, Compare>;
+    using map_type = typename Storage::template map_type<T, std::pair<size_t, double>, Compare>;
     /// @private
     using const_iterator = typename map_type::const_iterator;
     /** @brief Inserts an item into the set.
@@ -206,17 +510,21 @@ public:
     /// @returns The set of values and their respective counts and totals.
     [[nodiscard]] map_type& get_data() noexcept
         { return m_table; }
+    /// @returns The values and their respective counts and totals, sorted by value.
+    [[nodiscard]] auto get_sorted_data() const
+        { return frequency_storage::sorted_entries<Storage, Compare>(m_table); }
 private:
     map_type m_table;
     };
 
 /// @brief Same as a map, but also keeps a frequency count of every unique value added.
-template <typename T1, typename T2, typename Compare = std::less<T1>>
+template <typename T1, typename T2, typename Compare = std::less<T1>,
+          typename Storage = frequency_storage::ordered_storage>
 class frequency_map
     {
 public:
     /// @private
-    using map_type = typename std::map<T1, std::pair<T2,size_t>, Compare>; //Key/(value & count)
+    using map_type = typename Storage::template map_type<T1, std::pair<T2,size_t>, Compare>; //Key/(value & count)
     /// @private
     using const_iterator = typename map_type::const_iterator;
     /** @brief Inserts a pair of items into the map.
@@ -250,6 +558,9 @@ public:
     /// @returns The map of pairs and their respective frequency counts.
     [[nodiscard]] const map_type& get_data() const noexcept
         { return m_table; }
+    /// @returns The keys, their values, and their respective frequency counts, sorted by key.
+    [[nodiscard]] auto get_sorted_data() const
+        { return frequency_storage::sorted_entries<Storage, Compare>(m_table); }
 private:
     map_type m_table;
     };
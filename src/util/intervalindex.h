@@ -0,0 +1,165 @@
+/** @addtogroup Utilities
+    @brief Utility classes.
+    @date 2005-2022
+    @copyright Blake Madden
+    @author Blake Madden
+    @details This program is free software; you can redistribute it and/or modify
+     it under the terms of the 3-Clause BSD License.
+
+     SPDX-License-Identifier: BSD-3-Clause
+@{*/
+
+#ifndef __INTERVAL_INDEX_H__
+#define __INTERVAL_INDEX_H__
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+/** @brief A static index of intervals, used to quickly find which intervals overlap a range.
+    @details The intervals are sorted by their starts, and a tree over that order records the
+        latest end in each subtree. Finding the intervals that overlap a range is a binary
+        search for the intervals that start before the range ends, followed by a walk down
+        the tree that skips every subtree that ended before the range starts.
+        This takes O(log n + k log n) time (where @c k is the number of intervals found),
+        rather than checking every interval.
+
+        This is meant for timelines (e.g., the tasks in a Gantt chart), where only the
+        items in the visible date range need to be laid out.
+    @note The index holds copies of the intervals, so it must be rebuilt if they change.\n
+        Intervals are closed (i.e., an interval ending where the range starts overlaps it).
+        Use infinities for intervals that are open ended.
+    @par Example
+    @code
+        IntervalIndex<double> index;
+        index.Build({ { 1, 5 }, { 3, 9 }, { 12, 20 } });
+        // returns { 0, 1 }
+        const auto overlapping = index.FindOverlapping(4, 10);
+    @endcode*/
+template<typename T>
+class IntervalIndex
+    {
+public:
+    /** @brief Indexes a set of intervals.
+        @param intervals The intervals (start and end) to index. Their indices in this
+            vector are what FindOverlapping() returns.
+            Intervals whose ends are before their starts are not indexed.*/
+    void Build(const std::vector<std::pair<T, T>>& intervals)
+        {
+        m_starts.clear();
+        m_ends.clear();
+        m_originalIndices.clear();
+        m_maxEnds.clear();
+
+        std::vector<size_t> order(intervals.size());
+        std::iota(order.begin(), order.end(), 0);
+        order.erase(std::remove_if(order.begin(), order.end(),
+            [&intervals](const auto index)
+            { return intervals[index].second < intervals[index].first; }),
+            order.end());
+        std::stable_sort(order.begin(), order.end(),
+            [&intervals](const auto lhv, const auto rhv)
+            { return intervals[lhv].first < intervals[rhv].first; });
+
+        m_starts.reserve(order.size());
+        m_ends.reserve(order.size());
+        m_originalIndices.reserve(order.size());
+        for (const auto index : order)
+            {
+            m_starts.push_back(intervals[index].first);
+            m_ends.push_back(intervals[index].second);
+            m_originalIndices.push_back(index);
+            }
+
+        // build the tree of latest ends bottom up, with the leaves
+        // (in start order) at the end of the array
+        m_leafCount = 1;
+        while (m_leafCount < m_starts.size())
+            { m_leafCount <<= 1; }
+        m_maxEnds.assign(m_leafCount * 2, T{});
+        for (size_t i = 0; i < m_ends.size(); ++i)
+            { m_maxEnds[m_leafCount + i] = m_ends[i]; }
+        for (size_t node = m_leafCount - 1; node > 0; --node)
+            {
+            const size_t leftChild = node * 2;
+            const size_t rightChild = leftChild + 1;
+            m_maxEnds[node] = !HasItems(rightChild) ? m_maxEnds[leftChild] :
+                std::max(m_maxEnds[leftChild], m_maxEnds[rightChild]);
+            }
+        }
+    /// @brief Removes all intervals from the index.
+    void Clear() noexcept
+        {
+        m_starts.clear();
+        m_ends.clear();
+        m_originalIndices.clear();
+        m_maxEnds.clear();
+        m_leafCount = 0;
+        }
+    /// @returns The number of intervals in the index.
+    [[nodiscard]] size_t GetSize() const noexcept
+        { return m_starts.size(); }
+    /// @returns @c true if there are no intervals in the index.
+    [[nodiscard]] bool IsEmpty() const noexcept
+        { return m_starts.empty(); }
+
+    /** @returns The indices (into the vector passed to Build()) of the intervals
+            that overlap a range, in ascending order.
+        @param rangeStart The start of the range.
+        @param rangeEnd The end of the range.*/
+    [[nodiscard]] std::vector<size_t> FindOverlapping(const T& rangeStart,
+                                                      const T& rangeEnd) const
+        {
+        std::vector<size_t> found;
+        if (IsEmpty() || rangeEnd < rangeStart)
+            { return found; }
+        // only the intervals that start before the range ends can overlap it
+        const size_t candidateCount = static_cast<size_t>(std::distance(m_starts.cbegin(),
+            std::upper_bound(m_starts.cbegin(), m_starts.cend(), rangeEnd)));
+        if (candidateCount > 0)
+            { Collect(1, 0, m_leafCount, candidateCount, rangeStart, found); }
+        std::sort(found.begin(), found.end());
+        return found;
+        }
+private:
+    /// @returns @c true if a node's subtree covers any indexed intervals.
+    [[nodiscard]] bool HasItems(const size_t node) const noexcept
+        {
+        // find the first leaf under the node
+        size_t firstLeaf{ node };
+        while (firstLeaf < m_leafCount)
+            { firstLeaf *= 2; }
+        return (firstLeaf - m_leafCount) < m_starts.size();
+        }
+    /// @brief Adds the intervals (among the first @c candidateCount) under a node
+    ///     that end at or after @c rangeStart.
+    void Collect(const size_t node, const size_t nodeFirst, const size_t nodeLast,
+                 const size_t candidateCount, const T& rangeStart,
+                 std::vector<size_t>& found) const
+        {
+        if (nodeFirst >= candidateCount || m_maxEnds[node] < rangeStart)
+            { return; }
+        if (node >= m_leafCount)
+            {
+            found.push_back(m_originalIndices[nodeFirst]);
+            return;
+            }
+        const size_t middle = nodeFirst + (nodeLast - nodeFirst) / 2;
+        Collect(node * 2, nodeFirst, middle, candidateCount, rangeStart, found);
+        Collect(node * 2 + 1, middle, nodeLast, candidateCount, rangeStart, found);
+        }
+
+    // the intervals, sorted by their starts
+    std::vector<T> m_starts;
+    std::vector<T> m_ends;
+    std::vector<size_t> m_originalIndices;
+    // latest end in each subtree (node 1 is the root; node n's children are 2n and 2n+1)
+    std::vector<T> m_maxEnds;
+    size_t m_leafCount{ 0 };
+    };
+
+/** @}*/
+
+#endif //__INTERVAL_INDEX_H__
@@ -0,0 +1,140 @@
+/** @addtogroup Utilities
+    @brief Utility classes.
+    @date 2005-2022
+    @copyright Blake Madden
+    @author Blake Madden
+    @details This program is free software; you can redistribute it and/or modify
+     it under the terms of the 3-Clause BSD License.
+
+     SPDX-License-Identifier: BSD-3-Clause
+@{*/
+
+#ifndef __LAZY_CACHE_H__
+#define __LAZY_CACHE_H__
+
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+/** @brief A value that is calculated the first time that it is needed
+        (e.g., summary statistics about a column of data) and then cached.
+    @details Get() can be called from any number of threads at the same time;
+        the value is only built once, by whichever thread asks for it first,
+        while the others wait for it.\n
+        Once the value is built, reading it only costs an atomic load.
+    @note Discarding the value (i.e., Reset(), Set(), or Take()) is meant for the owner's
+        non-const functions that change the data that the value is calculated from,
+        so (like those functions) they should not be called while other threads are
+        reading the cache.\n
+        Copies of the cache copy the value if it has been built.
+    @par Example
+    @code
+        // in a class's definition
+        LazyCache<double> m_total;
+
+        // in a const member function
+        return m_total.Get([this]()
+            { return std::accumulate(m_values.cbegin(), m_values.cend(), 0.0); });
+
+        // in a function that changes m_values
+        m_total.Reset();
+    @endcode*/
+template<typename T>
+class LazyCache
+    {
+public:
+    /// @private
+    LazyCache() = default;
+    /// @private
+    LazyCache(const LazyCache& that)
+        {
+        if (const auto* value = that.Find())
+            {
+            m_value = *value;
+            m_isBuilt.store(true, std::memory_order_release);
+            }
+        }
+    /// @private
+    LazyCache& operator=(const LazyCache& that)
+        {
+        if (this != &that)
+            {
+            Reset();
+            if (const auto* value = that.Find())
+                { Set(*value); }
+            }
+        return *this;
+        }
+    /// @private
+    LazyCache(LazyCache&& that) noexcept
+        {
+        if (auto value = that.Take())
+            { Set(std::move(value.value())); }
+        }
+    /// @private
+    LazyCache& operator=(LazyCache&& that) noexcept
+        {
+        if (this != &that)
+            {
+            Reset();
+            if (auto value = that.Take())
+                { Set(std::move(value.value())); }
+            }
+        return *this;
+        }
+
+    /** @returns The cached value, building it first if necessary.
+        @param build A function that returns the value (a @c T).
+            This is only called if the value hasn't been built yet.*/
+    template<typename BuildT>
+    [[nodiscard]] const T& Get(BuildT&& build) const
+        {
+        if (!m_isBuilt.load(std::memory_order_acquire))
+            {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            // another thread may have built it while this one was waiting
+            if (!m_isBuilt.load(std::memory_order_relaxed))
+                {
+                m_value = std::forward<BuildT>(build)();
+                m_isBuilt.store(true, std::memory_order_release);
+                }
+            }
+        return m_value.value();
+        }
+    /// @returns The cached value, or @c nullptr if it hasn't been built.
+    [[nodiscard]] const T* Find() const noexcept
+        {
+        return m_isBuilt.load(std::memory_order_acquire) ? &m_value.value() : nullptr;
+        }
+    /// @brief Discards the value, so that it will be rebuilt the next time that it is needed.
+    void Reset() noexcept
+        {
+        m_isBuilt.store(false, std::memory_order_relaxed);
+        m_value.reset();
+        }
+    /// @brief Replaces the value (e.g., with one that was updated incrementally).
+    /// @param value The new value.
+    void Set(T value)
+        {
+        m_value = std::move(value);
+        m_isBuilt.store(true, std::memory_order_release);
+        }
+    /// @brief Removes the value from the cache.
+    /// @returns The value, or @c std::nullopt if it hadn't been built.
+    [[nodiscard]] std::optional<T> Take() noexcept
+        {
+        if (!m_isBuilt.load(std::memory_order_acquire))
+            { return std::nullopt; }
+        m_isBuilt.store(false, std::memory_order_relaxed);
+        return std::exchange(m_value, std::nullopt);
+        }
+private:
+    mutable std::mutex m_mutex;
+    mutable std::optional<T> m_value;
+    mutable std::atomic<bool> m_isBuilt{ false };
+    };
+
+/** @}*/
+
+#endif //__LAZY_CACHE_H__
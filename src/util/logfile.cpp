@@ -28,10 +28,235 @@ LogFile::LogFile()
         }
     }
 
+//--------------------------------------------------
+LogFile::~LogFile()
+    {
+    StopWriter();
+    ReportSuppressedRecords(true);
+    LogFile::Flush();
+    }
+
+//--------------------------------------------------
+void LogFile::SetAsynchronous(const bool async, const size_t queueCapacity /*= 4096*/)
+    {
+    StopWriter();
+    if (!async)
+        { return; }
+
+    // write anything buffered so far first, so that the records stay in order
+    LogFile::Flush();
+    m_asyncQueue = std::make_unique<BoundedQueue<wxString>>(queueCapacity);
+    m_stopWriter = m_wakeWriter = false;
+    m_writerThread = std::thread([this]() { WriteQueuedRecordsLoop(); });
+    }
+
+//--------------------------------------------------
+void LogFile::StopWriter()
+    {
+    if (!m_writerThread.joinable())
+        { return; }
+        {
+        std::lock_guard<std::mutex> lock(m_writerMutex);
+        m_stopWriter = true;
+        }
+    m_writerCondition.notify_one();
+    m_writerThread.join();
+    m_asyncQueue.reset();
+    }
+
+//--------------------------------------------------
+void LogFile::WriteQueuedRecordsLoop()
+    {
+    std::unique_lock<std::mutex> lock(m_writerMutex);
+    for (;;)
+        {
+        // wake up periodically, or sooner if the queue is filling up or
+        // someone is waiting for the records to be written
+        m_writerCondition.wait_for(lock, WRITER_INTERVAL,
+            [this]() { return m_stopWriter || m_wakeWriter; });
+        m_wakeWriter = false;
+        const bool stopping = m_stopWriter;
+        lock.unlock();
+        WriteQueuedRecords();
+        lock.lock();
+        m_writtenCondition.notify_all();
+        if (stopping)
+            { break; }
+        }
+    }
+
+//--------------------------------------------------
+void LogFile::WriteQueuedRecords()
+    {
+    wxString batch;
+    uint64_t recordCount{ 0 };
+    // only take what is in the queue now, so that a steady stream of
+    // new records can't keep this from writing
+    const size_t queuedCount = m_asyncQueue->GetApproximateSize();
+    while (recordCount < queuedCount)
+        {
+        auto record = m_asyncQueue->TryPop();
+        if (!record)
+            { break; }
+        batch += record.value();
+        ++recordCount;
+        }
+
+    const auto droppedRecords = m_droppedRecords.load(std::memory_order_relaxed);
+    if (droppedRecords > m_reportedDroppedRecords)
+        {
+        batch += wxString::Format(L"%s%s log records were dropped "
+            "because they were logged faster than they could be written.\t%s\n",
+            GetLevelPrefix(wxLOG_Warning),
+            std::to_wstring(droppedRecords - m_reportedDroppedRecords),
+            wxDateTime::Now().FormatISOCombined(' '));
+        m_reportedDroppedRecords = droppedRecords;
+        }
+
+    if (!batch.empty())
+        { WriteToLogFile(batch); }
+    m_writtenRecords.fetch_add(recordCount, std::memory_order_release);
+    }
+
+//--------------------------------------------------
+void LogFile::WaitForWriter()
+    {
+    if (!m_writerThread.joinable())
+        { return; }
+    const auto queuedRecords = m_queuedRecords.load(std::memory_order_acquire);
+    std::unique_lock<std::mutex> lock(m_writerMutex);
+    m_wakeWriter = true;
+    m_writerCondition.notify_one();
+    m_writtenCondition.wait(lock, [this, queuedRecords]()
+        {
+        return m_writtenRecords.load(std::memory_order_acquire) >= queuedRecords;
+        });
+    }
+
+//--------------------------------------------------
+void LogFile::AppendRecord(wxString&& record)
+    {
+    if (m_asyncQueue == nullptr)
+        {
+        m_buffer += record;
+        return;
+        }
+
+    if (!m_asyncQueue->TryPush(std::move(record)))
+        {
+        m_droppedRecords.fetch_add(1, std::memory_order_relaxed);
+        return;
+        }
+    m_queuedRecords.fetch_add(1, std::memory_order_release);
+    // wake the writer early if the queue is getting full
+    if (m_asyncQueue->GetApproximateSize() >= m_asyncQueue->GetCapacity() / 2)
+        {
+            {
+            std::lock_guard<std::mutex> lock(m_writerMutex);
+            m_wakeWriter = true;
+            }
+        m_writerCondition.notify_one();
+        }
+    }
+
+//--------------------------------------------------
+bool LogFile::IsRateLimited(const wxLogRecordInfo& info)
+    {
+    if (m_maxRecordsPerSecond == 0 || info.filename == nullptr)
+        { return false; }
+
+    const auto now = std::chrono::steady_clock::now();
+    auto& rate = m_callSiteRates[std::wstring(wxString(info.filename).wc_str()) +
+                                 L":" + std::to_wstring(info.line)];
+    if (rate.m_recordCount == 0 || now - rate.m_windowStart >= std::chrono::seconds(1))
+        {
+        // this call site's previous window is over, so note what it suppressed
+        // and start a new window
+        if (rate.m_suppressedCount > 0)
+            { AppendRecord(FormatSuppressionNote(rate)); }
+        rate.m_windowStart = now;
+        rate.m_recordCount = 0;
+        rate.m_suppressedCount = 0;
+        rate.m_functionName = (info.func ? wxString(info.func) : wxString(L"N/A"));
+        rate.m_fileName = wxFileName(info.filename).GetFullName();
+        rate.m_line = info.line;
+        }
+    if (++rate.m_recordCount > m_maxRecordsPerSecond)
+        {
+        ++rate.m_suppressedCount;
+        return true;
+        }
+    return false;
+    }
+
+//--------------------------------------------------
+wxString LogFile::FormatSuppressionNote(const CallSiteRate& rate)
+    {
+    return wxString::Format(L"%s%s similar messages were suppressed.\t%s\t%s\t%s: line %d\n",
+        GetLevelPrefix(wxLOG_Warning), std::to_wstring(rate.m_suppressedCount),
+        wxDateTime::Now().FormatISOCombined(' '),
+        rate.m_functionName, rate.m_fileName, rate.m_line);
+    }
+
+//--------------------------------------------------
+void LogFile::ReportSuppressedRecords(const bool allSites)
+    {
+    const auto now = std::chrono::steady_clock::now();
+    for (auto ratePos = m_callSiteRates.begin(); ratePos != m_callSiteRates.end(); /* in loop*/)
+        {
+        const auto& rate = ratePos->second;
+        if (!allSites && now - rate.m_windowStart < std::chrono::seconds(1))
+            {
+            ++ratePos;
+            continue;
+            }
+        if (rate.m_suppressedCount > 0)
+            { AppendRecord(FormatSuppressionNote(rate)); }
+        // call sites that have gone quiet are forgotten, so that this doesn't grow
+        ratePos = m_callSiteRates.erase(ratePos);
+        }
+    }
+
+//--------------------------------------------------
+bool LogFile::WriteToLogFile(const wxString& text)
+    {
+    wxFile logFile(m_logFilePath, wxFile::write_append);
+    if (!logFile.IsOpened() || !logFile.Write(text))
+        { return false; }
+    const bool needsRotating = (m_maxFileSize > 0 &&
+        logFile.Length() > static_cast<wxFileOffset>(m_maxFileSize));
+    logFile.Close();
+    if (needsRotating)
+        { RotateLogFile(); }
+    return true;
+    }
+
+//--------------------------------------------------
+void LogFile::RotateLogFile()
+    {
+    // shift the older backups down (e.g., ".1" becomes ".2") and drop the oldest one
+    if (m_maxBackupFiles > 0)
+        {
+        for (size_t i = m_maxBackupFiles - 1; i > 0; --i)
+            {
+            const wxString olderBackup{ m_logFilePath + L"." + std::to_wstring(i) };
+            if (wxFileExists(olderBackup))
+                {
+                wxRenameFile(olderBackup,
+                             m_logFilePath + L"." + std::to_wstring(i + 1), true);
+                }
+            }
+        wxRenameFile(m_logFilePath, m_logFilePath + L".1", true);
+        }
+    wxFile logFile;
+    logFile.Create(m_logFilePath, true);
+    }
+
 //--------------------------------------------------
 wxString LogFile::ReadLog()
     {
     LogFile::Flush();
+    WaitForWriter();
 
     wxString logBuffer;
     wxFile logFile(m_logFilePath, wxFile::read);
@@ -48,21 +273,24 @@ wxString LogFile::ReadLog()
 void LogFile::Flush()
     {
     wxLog::Flush();
-    if (m_buffer.length())
+    ReportSuppressedRecords(false);
+    // the writer thread writes the records on its own schedule,
+    // so just make sure that it isn't waiting too long
+    if (m_asyncQueue != nullptr)
         {
-        wxFile logFile(m_logFilePath, wxFile::write_append);
-        if (logFile.IsOpened())
             {
-            logFile.Write(m_buffer);
-            m_buffer.clear();
+            std::lock_guard<std::mutex> lock(m_writerMutex);
+            m_wakeWriter = true;
             }
+        m_writerCondition.notify_one();
         }
+    if (m_buffer.length() && WriteToLogFile(m_buffer))
+        { m_buffer.clear(); }
     }
 
 //--------------------------------------------------
-void LogFile::DoLogTextAtLevel(wxLogLevel level, const wxString &msg)
+wxString LogFile::GetLevelPrefix(const wxLogLevel level)
     {
-    wxString prefix;
     switch (level)
         {
         case wxLOG_Debug:
@@ -71,49 +299,32 @@ void LogFile::DoLogTextAtLevel(wxLogLevel level, const wxString &msg)
             // don't expose these for translation;
             // log messages are usually only needed for developers,
             // so translating them causes more problems than it solves
-            prefix = L"\U0001F41E Debug: ";
-            break;
-        case wxLOG_FatalError: 
+            return L"\U0001F41E Debug: ";
+        case wxLOG_FatalError:
             [[fallthrough]];
         case wxLOG_Error:
-            prefix = L"\U00002757 Error: ";
-            break;
+            return L"\U00002757 Error: ";
         case wxLOG_Warning:
-            prefix = L"\x26A0 Warning: ";
-            break;
+            return L"\x26A0 Warning: ";
         default:
-            prefix.clear();
+            return wxString{};
         }
-    m_buffer += (prefix + msg);
     }
 
+//--------------------------------------------------
+void LogFile::DoLogTextAtLevel(wxLogLevel level, const wxString &msg)
+    { AppendRecord(GetLevelPrefix(level) + msg); }
+
 //--------------------------------------------------
 void LogFile::DoLogRecord(wxLogLevel level, const wxString &msg,
                           const wxLogRecordInfo &info)
     {
-    wxString prefix;
-    switch (level)
-        {
-        case wxLOG_Debug:
-            [[fallthrough]];
-        case wxLOG_Trace:
-            prefix = L"\U0001F41E Debug: ";
-            break;
-        case wxLOG_FatalError: 
-            [[fallthrough]];
-        case wxLOG_Error:
-            prefix = L"\U00002757 Error: ";
-            break;
-        case wxLOG_Warning:
-            prefix = L"\x26A0 Warning: ";
-            break;
-        default:
-            prefix.clear();
-        }
-    m_buffer += wxString::Format(L"%s%s\t%s\t%s\t%s: line %d\n",
-        prefix, msg,
+    if (IsRateLimited(info))
+        { return; }
+    AppendRecord(wxString::Format(L"%s%s\t%s\t%s\t%s: line %d\n",
+        GetLevelPrefix(level), msg,
         wxDateTime(info.timestamp).FormatISOCombined(' '),
         (info.func ? wxString(info.func) : L"N/A"),
         (info.filename ? wxFileName(info.filename).GetFullName() : L"N/A"),
-        info.line);
+        info.line));
     }
@@ -18,6 +18,15 @@
 #include <wx/file.h>
 #include <wx/filename.h>
 #include <wx/stdpaths.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include "boundedqueue.h"
 
 /** @brief Logging system that writes its records to a temp file.
     @details Each record in the log report is highly verbose. It will include
@@ -52,6 +61,20 @@
      | @emoji :warning:     | Warning   |
      | @emoji :exclamation: | Error     |
      | @emoji :bug:         | Debug     |
+
+    @par Performance
+     By default, records are buffered and written to the file when the log is flushed
+     (which wxWidgets does when the application is idle). For programs that log heavily
+     (e.g., verbose import warnings), call SetAsynchronous() so that records are
+     handed off to a background thread that appends them in batches. Its queue is bounded,
+     so if records arrive faster than they can be written, the extra ones are dropped
+     (and the number dropped is noted in the log) rather than stalling the program or
+     using unbounded memory.
+
+     Independent of that, rate limiting (SetMaxRecordsPerSecond()) can suppress the records
+     from a call site that logs too many in a second (with a summary written afterwards),
+     and rotation (SetMaxFileSize()) can start a new file when the log grows too large.
+     Both are disabled by default.
     */
 class LogFile : public wxLog
     {
@@ -68,6 +91,8 @@ public:
     LogFile& operator=(const LogFile&) = delete;
     /// @private
     LogFile& operator=(LogFile&&) = delete;
+    /// @private
+    ~LogFile();
     
     /// @brief Reads (and returns) the content of the log file.
     /// @returns The content of the log report.
@@ -88,20 +113,120 @@ public:
     [[nodiscard]] const wxString& GetLogFilePath() const noexcept
         { return m_logFilePath; }
 
+    /** @brief Sets whether records are written to the file by a background thread.
+        @details When enabled, logging a record only formats it and adds it to a
+         bounded queue; a writer thread appends the queued records to the file in batches.
+        @param async @c true to write records on a background thread.
+        @param queueCapacity The number of records that can be waiting to be written.
+         If the queue is full, then new records are dropped.
+        @note Disabling this (or destroying the log) waits for the queued records
+         to be written.*/
+    void SetAsynchronous(const bool async, const size_t queueCapacity = 4096);
+    /// @returns @c true if records are being written by a background thread.
+    [[nodiscard]] bool IsAsynchronous() const noexcept
+        { return m_asyncQueue != nullptr; }
+    /// @returns The number of records dropped (since the log was created) because
+    ///     the asynchronous queue was full.
+    [[nodiscard]] uint64_t GetDroppedRecordCount() const noexcept
+        { return m_droppedRecords.load(std::memory_order_relaxed); }
+
+    /** @brief Sets the maximum number of records that a single call site
+         (i.e., file and line) can log per second.
+        @details Extra records from that call site are suppressed, and a note
+         saying how many were suppressed is logged afterwards.
+        @param maxRecords The number of records. @c 0 (the default) disables rate limiting.*/
+    void SetMaxRecordsPerSecond(const size_t maxRecords) noexcept
+        { m_maxRecordsPerSecond = maxRecords; }
+    /// @returns The maximum number of records that a single call site can log per second.
+    [[nodiscard]] size_t GetMaxRecordsPerSecond() const noexcept
+        { return m_maxRecordsPerSecond; }
+
+    /** @brief Sets the size at which the log file is rotated.
+        @details When the file grows past this size, it is renamed (with a @c .1 suffix,
+         and older backups are renamed to @c .2, @c .3, etc.) and a new file is started.
+        @param maxFileSize The size (in bytes). @c 0 (the default) lets the file grow without limit.
+        @param maxBackupFiles The number of previous log files to keep.*/
+    void SetMaxFileSize(const size_t maxFileSize, const size_t maxBackupFiles = 1) noexcept
+        {
+        m_maxFileSize = maxFileSize;
+        m_maxBackupFiles = maxBackupFiles;
+        }
+    /// @returns The size (in bytes) at which the log file is rotated.
+    [[nodiscard]] size_t GetMaxFileSize() const noexcept
+        { return m_maxFileSize; }
+
     /// @private
     void Flush() final;
 protected:
     /// @private
     void DoLogText(const wxString &msg) final
-        { m_buffer << msg << L"\n"; }
+        { AppendRecord(msg + L"\n"); }
     /// @private
     void DoLogRecord(wxLogLevel level, const wxString &msg,
                      const wxLogRecordInfo &info) final;
     /// @private
     void DoLogTextAtLevel(wxLogLevel level, const wxString &msg) final;
 private:
+    /// @brief How many records a call site has logged in the current one-second window.
+    struct CallSiteRate
+        {
+        std::chrono::steady_clock::time_point m_windowStart;
+        size_t m_recordCount{ 0 };
+        size_t m_suppressedCount{ 0 };
+        wxString m_functionName;
+        wxString m_fileName;
+        int m_line{ 0 };
+        };
+    /// @returns The icon and label for a log level.
+    [[nodiscard]] static wxString GetLevelPrefix(const wxLogLevel level);
+    /// @brief Buffers a formatted record or queues it for the writer thread.
+    void AppendRecord(wxString&& record);
+    /// @returns @c true if a record from the given call site should be suppressed.
+    [[nodiscard]] bool IsRateLimited(const wxLogRecordInfo& info);
+    /// @returns A record saying how many records a call site had suppressed.
+    [[nodiscard]] static wxString FormatSuppressionNote(const CallSiteRate& rate);
+    /// @brief Logs how many records were suppressed from call sites whose
+    ///     rate-limiting windows have ended.
+    /// @param allSites @c true to report all call sites, even ones still in their window.
+    void ReportSuppressedRecords(const bool allSites);
+    /// @brief Appends text to the log file, rotating the file if it is too large.
+    /// @returns @c false if the file could not be written to.
+    bool WriteToLogFile(const wxString& text);
+    /// @brief Renames the log file (and its backups) and starts a new one.
+    void RotateLogFile();
+    /// @brief The writer thread's loop.
+    void WriteQueuedRecordsLoop();
+    /// @brief Writes all queued records to the file in one batch.
+    void WriteQueuedRecords();
+    /// @brief Waits for the writer thread to write everything queued so far.
+    void WaitForWriter();
+    /// @brief Writes the remaining records and stops the writer thread.
+    void StopWriter();
+
+    constexpr static std::chrono::milliseconds WRITER_INTERVAL{ 250 };
+
     wxString m_buffer;
     wxString m_logFilePath;
+
+    // rate limiting and rotation
+    size_t m_maxRecordsPerSecond{ 0 };
+    std::unordered_map<std::wstring, CallSiteRate> m_callSiteRates;
+    size_t m_maxFileSize{ 0 };
+    size_t m_maxBackupFiles{ 1 };
+
+    // asynchronous writing
+    std::unique_ptr<BoundedQueue<wxString>> m_asyncQueue;
+    std::thread m_writerThread;
+    std::mutex m_writerMutex;
+    std::condition_variable m_writerCondition;
+    std::condition_variable m_writtenCondition;
+    bool m_wakeWriter{ false };
+    bool m_stopWriter{ false };
+    std::atomic<uint64_t> m_queuedRecords{ 0 };
+    std::atomic<uint64_t> m_writtenRecords{ 0 };
+    std::atomic<uint64_t> m_droppedRecords{ 0 };
+    // dropped records already noted in the file (only used by the writer thread)
+    uint64_t m_reportedDroppedRecords{ 0 };
     };
 
 /** @}*/
@@ -0,0 +1,42 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        measuringdc.cpp
+// Author:      Blake Madden
+// Copyright:   (c) 2005-2022 Blake Madden
+// Licence:     3-Clause BSD licence
+// SPDX-License-Identifier: BSD-3-Clause
+///////////////////////////////////////////////////////////////////////////////
+
+#include "measuringdc.h"
+
+//----------------------------------------------------------------
+std::unique_ptr<MeasuringDC> MeasuringDC::Create()
+    {
+    auto renderer = wxGraphicsRenderer::GetDefaultRenderer();
+    if (renderer == nullptr)
+        { return nullptr; }
+    // the DC takes ownership of the context
+    wxGraphicsContext* context = renderer->CreateMeasuringContext();
+    if (context == nullptr)
+        { return nullptr; }
+    return std::unique_ptr<MeasuringDC>(new MeasuringDC(context));
+    }
+
+//----------------------------------------------------------------
+std::unique_ptr<MeasuringDC>& MeasuringDC::GetThreadDC() noexcept
+    {
+    thread_local std::unique_ptr<MeasuringDC> threadDC;
+    return threadDC;
+    }
+
+//----------------------------------------------------------------
+MeasuringDC* MeasuringDC::GetForCurrentThread()
+    {
+    auto& threadDC = GetThreadDC();
+    if (threadDC == nullptr)
+        { threadDC = Create(); }
+    return threadDC.get();
+    }
+
+//----------------------------------------------------------------
+void MeasuringDC::ReleaseForCurrentThread() noexcept
+    { GetThreadDC().reset(); }
@@ -0,0 +1,86 @@
+/** @addtogroup Utilities
+    @brief Utility classes.
+    @date 2005-2022
+    @copyright Blake Madden
+    @author Blake Madden
+    @details This program is free software; you can redistribute it and/or modify
+     it under the terms of the 3-Clause BSD License.
+
+     SPDX-License-Identifier: BSD-3-Clause
+@{*/
+
+#ifndef __MEASURING_DC_H__
+#define __MEASURING_DC_H__
+
+#include <wx/dcgraph.h>
+#include <wx/graphics.h>
+#include <wx/window.h>
+#include <memory>
+
+/** @brief A DC for measuring layouts, which isn't bound to a window.
+    @details Laying out graphs and canvases (i.e., calling `RecalcSizes()`) only needs a DC
+        for measuring text and scaling DIPs; it never draws anything. This DC is built on the
+        graphics renderer's measuring context, so it can be used on worker threads and in
+        processes that don't show any windows (e.g., batch exporting).
+
+        Text measured with it goes through TextExtentCache like any other DC,
+        so measurements are shared with the window and export DCs that measure the same way.
+    @note A DC should only be used by one thread at a time, so each thread should use
+        its own instance (see GetForCurrentThread()). Also, wxWidgets's fonts, pens,
+        and brushes aren't safe to share between threads, so a layout measured on a
+        worker thread must not use any that other threads are using.\n
+        The DC must be destroyed before wxWidgets shuts down its graphics renderer.
+        Call ReleaseForCurrentThread() from the application's @c OnExit()
+        to destroy the main thread's DC in time.
+    @par Example
+    @code
+        // lay out a hidden graph (without needing a window's DC)
+        if (auto measuringDC = MeasuringDC::GetForCurrentThread();
+            measuringDC != nullptr)
+            { graph->RecalcSizes(*measuringDC); }
+
+        // ...and in the application's class
+        int MyApp::OnExit()
+            {
+            MeasuringDC::ReleaseForCurrentThread();
+            return wxApp::OnExit();
+            }
+    @endcode*/
+class MeasuringDC final : public wxGCDC
+    {
+public:
+    /// @private
+    MeasuringDC(const MeasuringDC&) = delete;
+    /// @private
+    MeasuringDC& operator=(const MeasuringDC&) = delete;
+    /** @brief Creates a measuring DC.
+        @returns The DC, or null if the graphics renderer can't create a measuring context.*/
+    [[nodiscard]] static std::unique_ptr<MeasuringDC> Create();
+    /** @brief Gets a measuring DC owned by the calling thread.
+        @details The DC is created the first time a thread asks for it and lives
+            until the thread ends or ReleaseForCurrentThread() is called.
+        @returns The thread's DC, or null if the graphics renderer can't create
+            a measuring context.*/
+    [[nodiscard]] static MeasuringDC* GetForCurrentThread();
+    /** @brief Destroys the calling thread's DC (if it has one).
+        @details The main thread's DC would otherwise be destroyed when the program exits,
+            which is after wxWidgets has shut down. So call this from the application's
+            @c OnExit() (or before the graphics renderer is otherwise cleaned up).
+        @note Calling GetForCurrentThread() afterwards will create a new DC.*/
+    static void ReleaseForCurrentThread() noexcept;
+    /** @brief Determines whether a layout measured with this DC would match
+            one measured for a window.
+        @param window The window that the layout will be shown in.
+        @returns @c true if this DC scales DIPs the same way that the window does.*/
+    [[nodiscard]] bool MatchesScaleOf(const wxWindow& window) const
+        { return FromDIP(100) == window.FromDIP(100); }
+private:
+    explicit MeasuringDC(wxGraphicsContext* context) : wxGCDC(context)
+        {}
+    /// @returns The calling thread's DC (which is empty until first requested).
+    [[nodiscard]] static std::unique_ptr<MeasuringDC>& GetThreadDC() noexcept;
+    };
+
+/** @}*/
+
+#endif //__MEASURING_DC_H__
@@ -0,0 +1,130 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        memorybudget.cpp
+// Author:      Blake Madden
+// Copyright:   (c) 2005-2022 Blake Madden
+// Licence:     3-Clause BSD licence
+// SPDX-License-Identifier: BSD-3-Clause
+///////////////////////////////////////////////////////////////////////////////
+
+#include "memorybudget.h"
+#include <algorithm>
+
+//----------------------------------------------------------------
+void MemoryBudget::Registration::SetBytes(const size_t bytes) noexcept
+    {
+    if (!m_state)
+        { return; }
+    const size_t previousBytes = m_state->m_bytes.exchange(bytes, std::memory_order_relaxed);
+    if (bytes >= previousBytes)
+        { m_usedBytes.fetch_add(bytes - previousBytes, std::memory_order_relaxed); }
+    else
+        { m_usedBytes.fetch_sub(previousBytes - bytes, std::memory_order_relaxed); }
+    }
+
+//----------------------------------------------------------------
+void MemoryBudget::Registration::Touch() noexcept
+    {
+    if (m_state)
+        {
+        m_state->m_lastUsed.store(m_clock.fetch_add(1, std::memory_order_relaxed) + 1,
+                                  std::memory_order_relaxed);
+        }
+    }
+
+//----------------------------------------------------------------
+void MemoryBudget::Registration::Reset()
+    {
+    if (!m_state)
+        { return; }
+    auto& registry = GetRegistry();
+    // waits for an eviction in progress (which may be using the cache) to finish
+    std::lock_guard<std::mutex> lock(registry.m_mutex);
+    SetBytes(0);
+    registry.m_caches.remove(m_state);
+    m_state.reset();
+    }
+
+//----------------------------------------------------------------
+MemoryBudget::Registry& MemoryBudget::GetRegistry()
+    {
+    static Registry registry;
+    return registry;
+    }
+
+//----------------------------------------------------------------
+MemoryBudget::Registration MemoryBudget::Register(const wxString& name,
+    std::function<void(const size_t bytesToFree)> evict)
+    {
+    auto state = std::make_shared<CacheState>();
+    state->m_name = name;
+    state->m_evict = std::move(evict);
+    state->m_lastUsed.store(m_clock.fetch_add(1, std::memory_order_relaxed) + 1,
+                            std::memory_order_relaxed);
+    auto& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.m_mutex);
+    registry.m_caches.push_back(state);
+    return Registration(std::move(state));
+    }
+
+//----------------------------------------------------------------
+void MemoryBudget::SetBudget(const size_t bytes)
+    {
+    m_budget.store(bytes, std::memory_order_relaxed);
+    Enforce();
+    }
+
+//----------------------------------------------------------------
+std::vector<MemoryBudget::CacheUsage> MemoryBudget::GetUsage()
+    {
+    std::vector<CacheUsage> usage;
+    auto& registry = GetRegistry();
+        {
+        std::lock_guard<std::mutex> lock(registry.m_mutex);
+        usage.reserve(registry.m_caches.size());
+        for (const auto& cache : registry.m_caches)
+            { usage.push_back({ cache->m_name, cache->m_bytes.load(std::memory_order_relaxed) }); }
+        }
+    std::sort(usage.begin(), usage.end(),
+        [](const auto& lhv, const auto& rhv) noexcept
+        { return lhv.m_bytes > rhv.m_bytes; });
+    return usage;
+    }
+
+//----------------------------------------------------------------
+void MemoryBudget::Enforce()
+    {
+    // the common case (no budget, or under it) shouldn't need the lock
+    const size_t budget = GetBudget();
+    if (budget == 0 || GetUsedBytes() <= budget)
+        { return; }
+    auto& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.m_mutex);
+    EvictOverBudget(registry);
+    }
+
+//----------------------------------------------------------------
+void MemoryBudget::EvictOverBudget(Registry& registry)
+    {
+    // least recently used first
+    std::vector<std::shared_ptr<CacheState>> caches(registry.m_caches.cbegin(),
+                                                    registry.m_caches.cend());
+    std::sort(caches.begin(), caches.end(),
+        [](const auto& lhv, const auto& rhv) noexcept
+        {
+        return lhv->m_lastUsed.load(std::memory_order_relaxed) <
+               rhv->m_lastUsed.load(std::memory_order_relaxed);
+        });
+    // each cache is asked once; a cache that can't free anything right now
+    // (e.g., a canvas asked from a worker thread) is skipped
+    for (const auto& cache : caches)
+        {
+        const size_t budget = GetBudget();
+        const size_t usedBytes = GetUsedBytes();
+        if (budget == 0 || usedBytes <= budget)
+            { return; }
+        if (cache->m_bytes.load(std::memory_order_relaxed) == 0 || !cache->m_evict)
+            { continue; }
+        m_evictionCount.fetch_add(1, std::memory_order_relaxed);
+        cache->m_evict(usedBytes - budget);
+        }
+    }
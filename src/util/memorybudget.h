@@ -0,0 +1,223 @@
+/** @addtogroup Utilities
+    @brief Utility classes.
+    @date 2005-2022
+    @copyright Blake Madden
+    @author Blake Madden
+    @details This program is free software; you can redistribute it and/or modify
+     it under the terms of the 3-Clause BSD License.
+
+     SPDX-License-Identifier: BSD-3-Clause
+@{*/
+
+#ifndef __MEMORY_BUDGET_H__
+#define __MEMORY_BUDGET_H__
+
+#include <wx/string.h>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/** @brief Process-wide memory budget for caches of derived data
+        (e.g., rendered bitmaps, decoded images, and text measurements).
+    @details Caches register with the budget and report how many bytes they are holding.
+        When the total goes over the budget, the least recently used caches are asked to
+        free memory (in that order) until the total is back under the budget.
+        Everything that is freed this way can be recreated (e.g., a canvas redraws its
+        backing bitmap the next time it is painted), so evicting only costs time.
+
+        The library registers these caches:
+        - Each canvas's backing, preview, background, and watermark bitmaps, along with
+          its graphs' hit testing indices and cached legends (see @c Canvas::ReleaseCaches())
+        - The shared image asset and effect caches (see @c GraphItems::Image)
+        - TextExtentCache and NumberFormatCache
+
+        Datasets' caches (e.g., summary statistics and group indices) aren't registered,
+        as datasets are shared between graphs (and canvases) in too many ways to track;
+        see @c Dataset::ReleaseCaches() and the example below.
+
+        There is no budget by default; call SetBudget() to enable it.
+    @note The budget only covers registered caches, not the data that they are derived from
+        (e.g., datasets); use the objects' @c GetMemoryUsage() functions to see where the
+        rest of the memory is going. When running under a hard memory limit
+        (e.g., in a container), set the budget to the part of that limit that caches can use.\n
+        This is thread safe, but caches are evicted on the thread that goes over the budget.
+        Canvases can only release their caches on the main thread, and not while drawing,
+        so when they are evicted from another thread (or while drawing) they queue the release
+        for the main thread's event loop instead. Until that runs, the budget may stay exceeded
+        (or other caches may be evicted in their place), and canvases aren't evicted this way
+        at all in programs that don't run an event loop.
+    @par Example
+    @code
+        // let caches use up to 512MB
+        MemoryBudget::SetBudget(512 * 1024 * 1024);
+
+        // a service registering what its dataset caches (e.g., group indices),
+        // which the dataset rebuilds when needed
+        class SalesReport
+            {
+        public:
+            SalesReport()
+                {
+                m_budgetRegistration = MemoryBudget::Register(L"Sales dataset caches",
+                    [this](const size_t)
+                    {
+                    m_sales->ReleaseCaches();
+                    m_budgetRegistration.SetBytes(0);
+                    });
+                }
+            void Update()
+                {
+                // ...build graphs from m_sales...
+                m_budgetRegistration.SetBytes(m_sales->GetMemoryUsage().m_cacheBytes);
+                m_budgetRegistration.Touch();
+                MemoryBudget::Enforce();
+                }
+        private:
+            std::shared_ptr<Data::Dataset> m_sales;
+            // declared last, so that it is unregistered before the dataset is destroyed
+            MemoryBudget::Registration m_budgetRegistration;
+            };
+    @endcode*/
+class MemoryBudget
+    {
+    /// @private
+    struct CacheState
+        {
+        wxString m_name;
+        std::function<void(const size_t bytesToFree)> m_evict;
+        std::atomic<size_t> m_bytes{ 0 };
+        std::atomic<uint64_t> m_lastUsed{ 0 };
+        };
+public:
+    /// @brief A registered cache's name and how much memory it is using.
+    struct CacheUsage
+        {
+        /// @brief The name that the cache was registered with.
+        wxString m_name;
+        /// @brief The number of bytes that the cache is holding.
+        size_t m_bytes{ 0 };
+        };
+
+    /** @brief A cache's registration with the budget.
+        @details The cache is unregistered when this is destroyed, so it should be
+            declared after the data that the cache's eviction function frees
+            (so that it is destroyed first).
+        @note Copies of a registration are empty (i.e., not registered), so that objects
+            holding one can still be copied. Call MemoryBudget::Register() again for the copy.*/
+    class Registration
+        {
+        friend class MemoryBudget;
+    public:
+        /// @private
+        Registration() = default;
+        /// @private
+        Registration(const Registration&) noexcept
+            {}
+        /// @private
+        Registration& operator=(const Registration& that) noexcept
+            {
+            if (this != &that)
+                { Reset(); }
+            return *this;
+            }
+        /// @private
+        Registration(Registration&& that) noexcept : m_state(std::move(that.m_state))
+            {}
+        /// @private
+        Registration& operator=(Registration&& that) noexcept
+            {
+            if (this != &that)
+                {
+                Reset();
+                m_state = std::move(that.m_state);
+                }
+            return *this;
+            }
+        /// @private
+        ~Registration()
+            { Reset(); }
+
+        /** @brief Sets how many bytes the cache is now holding.
+            @param bytes The size of the cache.
+            @note This doesn't evict anything; call MemoryBudget::Enforce() afterwards
+                (outside of any locks that the cache's eviction function uses).*/
+        void SetBytes(const size_t bytes) noexcept;
+        /// @returns The number of bytes that the cache last reported holding.
+        [[nodiscard]] size_t GetBytes() const noexcept
+            { return m_state ? m_state->m_bytes.load(std::memory_order_relaxed) : 0; }
+        /// @brief Marks the cache as just used, so that it will be evicted after the others.
+        void Touch() noexcept;
+        /// @returns @c true if this is registered with the budget.
+        [[nodiscard]] bool IsRegistered() const noexcept
+            { return m_state != nullptr; }
+        /// @brief Unregisters the cache.
+        void Reset();
+    private:
+        explicit Registration(std::shared_ptr<CacheState> state) noexcept :
+            m_state(std::move(state))
+            {}
+        std::shared_ptr<CacheState> m_state;
+        };
+
+    /// @private
+    MemoryBudget() = delete;
+
+    /** @brief Registers a cache with the budget.
+        @param name A name for the cache, used when reporting memory use.
+        @param evict A function that frees (at least) the given number of bytes from the
+            cache, or all of it if it can't free a partial amount. It should update
+            the cache's size (see Registration::SetBytes()) afterwards.
+        @returns The registration, which is used to report the cache's size.
+        @warning @c evict is called while the budget is locked, so it must not call
+            any other MemoryBudget functions (other than Registration::SetBytes()).*/
+    [[nodiscard]] static Registration Register(const wxString& name,
+                                               std::function<void(const size_t bytesToFree)> evict);
+
+    /** @brief Sets the maximum number of bytes that registered caches can hold.
+        @param bytes The budget. Setting this to @c 0 (the default) disables the budget.
+        @note Caches are evicted right away if they are already over the new budget.*/
+    static void SetBudget(const size_t bytes);
+    /// @returns The maximum number of bytes that registered caches can hold,
+    ///     or @c 0 if there is no budget.
+    [[nodiscard]] static size_t GetBudget() noexcept
+        { return m_budget.load(std::memory_order_relaxed); }
+    /// @returns The number of bytes that all registered caches are holding.
+    [[nodiscard]] static size_t GetUsedBytes() noexcept
+        { return m_usedBytes.load(std::memory_order_relaxed); }
+    /// @returns The registered caches and their sizes, largest first.
+    [[nodiscard]] static std::vector<CacheUsage> GetUsage();
+    /** @brief Evicts the least recently used caches until the total is under the budget.
+        @details This returns immediately if the caches are already under the budget.
+        @note Caches call this after they grow, so clients don't normally need to.*/
+    static void Enforce();
+    /** @returns The number of times that a cache has been asked to free memory
+            since the program started.*/
+    [[nodiscard]] static uint64_t GetEvictionCount() noexcept
+        { return m_evictionCount.load(std::memory_order_relaxed); }
+private:
+    /// @brief The registered caches, along with the lock for them.
+    /// @note This is a function-level static, so that caches in other translation units
+    ///     can register while they are being initialized.
+    struct Registry
+        {
+        std::mutex m_mutex;
+        std::list<std::shared_ptr<CacheState>> m_caches;
+        };
+    [[nodiscard]] static Registry& GetRegistry();
+    /// @brief Evicts caches while the registry is locked.
+    static void EvictOverBudget(Registry& registry);
+
+    inline static std::atomic<size_t> m_budget{ 0 };
+    inline static std::atomic<size_t> m_usedBytes{ 0 };
+    // increases every time that a cache is used, to order the caches by when they were used
+    inline static std::atomic<uint64_t> m_clock{ 0 };
+    inline static std::atomic<uint64_t> m_evictionCount{ 0 };
+    };
+
+/** @}*/
+
+#endif //__MEMORY_BUDGET_H__
@@ -0,0 +1,173 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        numberformatcache.cpp
+// Author:      Blake Madden
+// Copyright:   (c) 2005-2022 Blake Madden
+// Licence:     3-Clause BSD licence
+// SPDX-License-Identifier: BSD-3-Clause
+///////////////////////////////////////////////////////////////////////////////
+
+#include "numberformatcache.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+
+//----------------------------------------------------------------
+wxString NumberFormatCache::ToString(const double value, const int precision, const int style)
+    {
+    FormatKey key;
+    static_assert(sizeof(key.m_valueBits) == sizeof(value),
+                  "Double must be 64 bits to be used as a key.");
+    std::memcpy(&key.m_valueBits, &value, sizeof(value));
+    key.m_precision = precision;
+    key.m_style = style;
+    key.m_decimalSeparator = wxNumberFormatter::GetDecimalSeparator();
+    if (wxChar thousandsSeparator{ 0 };
+        (style & wxNumberFormatter::Style::Style_WithThousandsSep) &&
+        wxNumberFormatter::GetThousandsSeparatorIfUsed(&thousandsSeparator))
+        { key.m_thousandsSeparator = thousandsSeparator; }
+
+    wxString formatted;
+    if (Find(key, formatted))
+        { return formatted; }
+
+    if (!FormatWholeNumber(key, value, formatted))
+        { formatted = wxNumberFormatter::ToString(value, precision, style); }
+    Add(key, formatted);
+    return formatted;
+    }
+
+//----------------------------------------------------------------
+bool NumberFormatCache::FormatWholeNumber(const FormatKey& key, const double value,
+                                          wxString& formatted)
+    {
+    constexpr int supportedStyles = wxNumberFormatter::Style::Style_WithThousandsSep |
+                                    wxNumberFormatter::Style::Style_NoTrailingZeroes;
+    // beyond this, doubles can't hold every whole number,
+    // so leave the rounding to the formatter
+    constexpr double maxWholeNumber{ 1e15 };
+    if ((key.m_style & ~supportedStyles) != 0 || key.m_precision < 0 ||
+        !std::isfinite(value) || std::abs(value) >= maxWholeNumber ||
+        std::trunc(value) != value ||
+        // the formatter writes negative zero as "-0"
+        (value == 0 && std::signbit(value)))
+        { return false; }
+
+    auto wholeNumber = static_cast<int64_t>(std::abs(value));
+    // write the digits (with separators) backwards
+    wxChar buffer[32]{ 0 };
+    size_t position{ std::size(buffer) };
+    size_t digitCount{ 0 };
+    do
+        {
+        if (key.m_thousandsSeparator != 0 && digitCount > 0 && digitCount % 3 == 0)
+            { buffer[--position] = key.m_thousandsSeparator; }
+        buffer[--position] = static_cast<wxChar>(L'0' + (wholeNumber % 10));
+        wholeNumber /= 10;
+        ++digitCount;
+        } while (wholeNumber > 0);
+    if (value < 0)
+        { buffer[--position] = L'-'; }
+
+    formatted.assign(buffer + position, std::size(buffer) - position);
+    if (key.m_precision > 0 &&
+        !(key.m_style & wxNumberFormatter::Style::Style_NoTrailingZeroes))
+        {
+        formatted += key.m_decimalSeparator;
+        formatted.append(static_cast<size_t>(key.m_precision), L'0');
+        }
+    return true;
+    }
+
+//----------------------------------------------------------------
+bool NumberFormatCache::Find(const FormatKey& key, wxString& formatted)
+    {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto foundPos = m_lookup.find(key);
+    if (foundPos == m_lookup.cend())
+        {
+        m_missCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+        }
+    m_hitCount.fetch_add(1, std::memory_order_relaxed);
+    // move to the front, as it is now the most recently used
+    m_values.splice(m_values.begin(), m_values, foundPos->second);
+    formatted = foundPos->second->second;
+    return true;
+    }
+
+//----------------------------------------------------------------
+void NumberFormatCache::Add(const FormatKey& key, const wxString& formatted)
+    {
+    auto& registration = GetBudgetRegistration();
+        {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_maxEntries == 0)
+            { return; }
+        // another thread may have formatted this in the meantime
+        if (m_lookup.find(key) != m_lookup.cend())
+            { return; }
+        m_bytes += GetEntryBytes(formatted);
+        m_values.emplace_front(key, formatted);
+        m_lookup.insert(std::make_pair(key, m_values.begin()));
+        while (m_values.size() > m_maxEntries)
+            { RemoveOldest(); }
+        registration.SetBytes(m_bytes);
+        registration.Touch();
+        }
+    // the budget may evict from this cache, so it can't be locked here
+    MemoryBudget::Enforce();
+    }
+
+//----------------------------------------------------------------
+void NumberFormatCache::RemoveOldest()
+    {
+    m_bytes -= std::min(m_bytes, GetEntryBytes(m_values.back().second));
+    m_lookup.erase(m_values.back().first);
+    m_values.pop_back();
+    }
+
+//----------------------------------------------------------------
+MemoryBudget::Registration& NumberFormatCache::GetBudgetRegistration()
+    {
+    static MemoryBudget::Registration registration =
+        MemoryBudget::Register(L"Formatted numbers",
+            [](const size_t bytesToFree)
+            {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            const size_t targetBytes = (m_bytes > bytesToFree) ? m_bytes - bytesToFree : 0;
+            while (!m_values.empty() && m_bytes > targetBytes)
+                { RemoveOldest(); }
+            GetBudgetRegistration().SetBytes(m_bytes);
+            });
+    return registration;
+    }
+
+//----------------------------------------------------------------
+void NumberFormatCache::SetMaxEntries(const size_t maxEntries)
+    {
+    auto& registration = GetBudgetRegistration();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_maxEntries = maxEntries;
+    while (m_values.size() > m_maxEntries)
+        { RemoveOldest(); }
+    registration.SetBytes(m_bytes);
+    }
+
+//----------------------------------------------------------------
+size_t NumberFormatCache::GetMaxEntries()
+    {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_maxEntries;
+    }
+
+//----------------------------------------------------------------
+void NumberFormatCache::Clear()
+    {
+    auto& registration = GetBudgetRegistration();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_values.clear();
+    m_lookup.clear();
+    m_bytes = 0;
+    registration.SetBytes(m_bytes);
+    }
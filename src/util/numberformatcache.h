@@ -0,0 +1,158 @@
+/** @addtogroup Utilities
+    @brief Utility classes.
+    @date 2005-2022
+    @copyright Blake Madden
+    @author Blake Madden
+    @details This program is free software; you can redistribute it and/or modify
+     it under the terms of the 3-Clause BSD License.
+
+     SPDX-License-Identifier: BSD-3-Clause
+@{*/
+
+#ifndef __NUMBER_FORMAT_CACHE_H__
+#define __NUMBER_FORMAT_CACHE_H__
+
+#include <wx/string.h>
+#include <wx/numformatter.h>
+#include "memorybudget.h"
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+/** @brief Process-wide cache of formatted numbers.
+    @details Axes re-create their tick labels every time their ranges change
+        (e.g., dashboards re-ranging their axes every second), and tables and histograms
+        format the same values over and over. Formatting through @c wxNumberFormatter
+        is relatively expensive, so this remembers the formatted strings, keyed on
+        the value, precision, style, and the locale's decimal and thousands separators.
+
+        Whole numbers (the most common tick values) are also formatted directly,
+        without going through @c wxNumberFormatter.
+
+        The cache is bounded; when it is full, the least recently used string is discarded.
+        It is also registered with the MemoryBudget, like TextExtentCache.
+    @note This is thread safe.
+    @par Example
+    @code
+        // same as wxNumberFormatter::ToString(1500, 0, Settings::GetDefaultNumberFormat()),
+        // but cached
+        const wxString label =
+            NumberFormatCache::ToString(1500, 0, Settings::GetDefaultNumberFormat());
+    @endcode*/
+class NumberFormatCache
+    {
+public:
+    /// @private
+    NumberFormatCache() = delete;
+    /** @brief Formats a number.
+        @param value The value to format.
+        @param precision The number of digits after the decimal separator.
+        @param style The @c wxNumberFormatter::Style flags to format with.
+        @returns The formatted value, the same as what
+            @c wxNumberFormatter::ToString() would return.*/
+    [[nodiscard]] static wxString ToString(const double value, const int precision,
+                                           const int style);
+
+    /** @brief Sets the maximum number of strings to remember.
+        @param maxEntries The number of strings.
+            Setting this to @c 0 disables the cache.*/
+    static void SetMaxEntries(const size_t maxEntries);
+    /// @returns The maximum number of strings to remember.
+    [[nodiscard]] static size_t GetMaxEntries();
+    /// @brief Removes all strings from the cache.
+    static void Clear();
+    /// @returns The (approximate) number of bytes that the cache is using.
+    [[nodiscard]] static size_t GetMemoryUsage()
+        {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_bytes;
+        }
+
+    /** @returns The number of values that were found in the cache
+            since the program started.
+        @note This is a running total (it is not reset by Clear()).*/
+    [[nodiscard]] static uint64_t GetHitCount() noexcept
+        { return m_hitCount.load(std::memory_order_relaxed); }
+    /** @returns The number of values that were not found in the cache
+            since the program started.
+        @note Like GetHitCount(), this is a running total.*/
+    [[nodiscard]] static uint64_t GetMissCount() noexcept
+        { return m_missCount.load(std::memory_order_relaxed); }
+private:
+    /// @brief What a value was formatted with.
+    struct FormatKey
+        {
+        // the value's bits, so that -0 and NaNs are distinct keys
+        uint64_t m_valueBits{ 0 };
+        int m_precision{ 0 };
+        int m_style{ 0 };
+        wxChar m_decimalSeparator{ L'.' };
+        // zero if the locale doesn't use one
+        wxChar m_thousandsSeparator{ 0 };
+        [[nodiscard]] bool operator==(const FormatKey& that) const noexcept
+            {
+            return m_valueBits == that.m_valueBits &&
+                m_precision == that.m_precision &&
+                m_style == that.m_style &&
+                m_decimalSeparator == that.m_decimalSeparator &&
+                m_thousandsSeparator == that.m_thousandsSeparator;
+            }
+        };
+    /// @brief Hashes a format key.
+    class FormatKeyHash
+        {
+    public:
+        [[nodiscard]] size_t operator()(const FormatKey& key) const noexcept
+            {
+            size_t hashValue = std::hash<uint64_t>{}(key.m_valueBits);
+            const auto combine = [&hashValue](const size_t value) noexcept
+                { hashValue ^= value + 0x9e3779b9 + (hashValue << 6) + (hashValue >> 2); };
+            combine(std::hash<int>{}(key.m_precision));
+            combine(std::hash<int>{}(key.m_style));
+            combine(std::hash<wxChar>{}(key.m_thousandsSeparator));
+            return hashValue;
+            }
+        };
+    using FormattedList = std::list<std::pair<FormatKey, wxString>>;
+
+    /** @brief Formats a whole number without going through @c wxNumberFormatter.
+        @param key The value and how to format it.
+        @param value The value.
+        @param[out] formatted The formatted value.
+        @returns @c false if the value isn't a whole number that can be formatted directly.*/
+    [[nodiscard]] static bool FormatWholeNumber(const FormatKey& key, const double value,
+                                                wxString& formatted);
+    /// @brief Looks up a value, and moves it to the front of the cache if found.
+    /// @returns @c true if the value was found (and copied into @c formatted).
+    [[nodiscard]] static bool Find(const FormatKey& key, wxString& formatted);
+    /// @brief Adds a value to the cache, discarding the oldest ones if necessary.
+    static void Add(const FormatKey& key, const wxString& formatted);
+    /// @brief Discards the least recently used string.
+    /// @note The cache must be locked and not empty.
+    static void RemoveOldest();
+    /// @returns The (approximate) number of bytes that a string uses in the cache.
+    [[nodiscard]] static size_t GetEntryBytes(const wxString& formatted) noexcept
+        {
+        // the list and map nodes (the map holds a copy of the key) and the string
+        return sizeof(FormattedList::value_type) + sizeof(FormatKey) +
+               formatted.length() * sizeof(wxChar) + 4 * sizeof(void*);
+        }
+    /// @returns The cache's registration with the memory budget.
+    [[nodiscard]] static MemoryBudget::Registration& GetBudgetRegistration();
+
+    inline static std::mutex m_mutex;
+    // most recently used values are at the front
+    inline static FormattedList m_values;
+    inline static std::unordered_map<FormatKey, FormattedList::iterator,
+                                     FormatKeyHash> m_lookup;
+    inline static size_t m_maxEntries{ 4096 };
+    inline static size_t m_bytes{ 0 };
+    inline static std::atomic<uint64_t> m_hitCount{ 0 };
+    inline static std::atomic<uint64_t> m_missCount{ 0 };
+    };
+
+/** @}*/
+
+#endif //__NUMBER_FORMAT_CACHE_H__
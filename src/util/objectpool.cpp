@@ -0,0 +1,62 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        objectpool.cpp
+// Author:      Blake Madden
+// Copyright:   (c) 2005-2022 Blake Madden
+// Licence:     3-Clause BSD licence
+// SPDX-License-Identifier: BSD-3-Clause
+///////////////////////////////////////////////////////////////////////////////
+
+#include "objectpool.h"
+#include <new>
+
+//----------------------------------------------------------------
+void* ObjectPool::Allocate(const size_t size, const size_t alignment)
+    {
+    if (!IsPooled(size, alignment))
+        {
+        return (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) ?
+            ::operator new(size, std::align_val_t(alignment)) :
+            ::operator new(size);
+        }
+
+    const size_t sizeClass = GetSizeClass(size);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_freeLists[sizeClass] == nullptr)
+        {
+        // carve a new chunk into blocks of this size
+        const size_t blockSize = (sizeClass + 1) * BLOCK_GRANULARITY;
+        m_chunks.push_back(std::make_unique<std::byte[]>(blockSize * BLOCKS_PER_CHUNK));
+        m_reservedBytes += blockSize * BLOCKS_PER_CHUNK;
+        std::byte* const chunk = m_chunks.back().get();
+        for (size_t i = 0; i < BLOCKS_PER_CHUNK; ++i)
+            {
+            auto* const block = new (chunk + (i * blockSize)) FreeBlock;
+            block->m_next = m_freeLists[sizeClass];
+            m_freeLists[sizeClass] = block;
+            }
+        }
+    FreeBlock* const block = m_freeLists[sizeClass];
+    m_freeLists[sizeClass] = block->m_next;
+    return block;
+    }
+
+//----------------------------------------------------------------
+void ObjectPool::Deallocate(void* block, const size_t size, const size_t alignment) noexcept
+    {
+    if (block == nullptr)
+        { return; }
+    if (!IsPooled(size, alignment))
+        {
+        if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+            { ::operator delete(block, std::align_val_t(alignment)); }
+        else
+            { ::operator delete(block); }
+        return;
+        }
+
+    const size_t sizeClass = GetSizeClass(size);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto* const freeBlock = new (block) FreeBlock;
+    freeBlock->m_next = m_freeLists[sizeClass];
+    m_freeLists[sizeClass] = freeBlock;
+    }
@@ -0,0 +1,131 @@
+/** @addtogroup Utilities
+    @brief Utility classes.
+    @date 2005-2022
+    @copyright Blake Madden
+    @author Blake Madden
+    @details This program is free software; you can redistribute it and/or modify
+     it under the terms of the 3-Clause BSD License.
+
+     SPDX-License-Identifier: BSD-3-Clause
+@{*/
+
+#ifndef __OBJECT_POOL_H__
+#define __OBJECT_POOL_H__
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/** @brief A pool of memory blocks for small objects that are repeatedly created and destroyed.
+    @details Blocks are carved out of larger chunks, and freed blocks are kept (by size)
+        for reuse rather than being returned to the heap. For example, a graph creates
+        thousands of small plot objects every time that it is laid out and frees them
+        on the next layout; with a pool, the next layout reuses the same memory.
+
+        Memory is only returned to the heap when the pool is destroyed.
+        Requests that are too large (or over-aligned) for the pool are passed through to the heap.
+    @note This is thread safe, as objects may be released from a different thread
+        than the one that created them.
+    @sa ObjectPoolAllocator.*/
+class ObjectPool
+    {
+public:
+    /// @private
+    ObjectPool() = default;
+    /// @private
+    ObjectPool(const ObjectPool&) = delete;
+    /// @private
+    ObjectPool& operator=(const ObjectPool&) = delete;
+    /** @brief Gets a block of memory.
+        @param size The size (in bytes) of the block.
+        @param alignment The alignment that the block needs.
+        @returns The block.
+        @throws std::bad_alloc If the memory cannot be allocated.*/
+    [[nodiscard]] void* Allocate(const size_t size, const size_t alignment);
+    /** @brief Returns a block of memory to the pool.
+        @param block The block, which must have come from Allocate().
+        @param size The size that the block was requested with.
+        @param alignment The alignment that the block was requested with.*/
+    void Deallocate(void* block, const size_t size, const size_t alignment) noexcept;
+    /// @returns The number of bytes that the pool has reserved from the heap.
+    [[nodiscard]] size_t GetReservedBytes() const
+        {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_reservedBytes;
+        }
+private:
+    /// @returns @c true if a request of this size and alignment is served by the pool.
+    [[nodiscard]] constexpr static bool IsPooled(const size_t size, const size_t alignment) noexcept
+        { return size > 0 && size <= MAX_POOLED_SIZE && alignment <= BLOCK_GRANULARITY; }
+    /// @returns The free list for a block size.
+    [[nodiscard]] constexpr static size_t GetSizeClass(const size_t size) noexcept
+        { return (size + BLOCK_GRANULARITY - 1) / BLOCK_GRANULARITY - 1; }
+
+    constexpr static size_t BLOCK_GRANULARITY{ alignof(std::max_align_t) };
+    constexpr static size_t MAX_POOLED_SIZE{ 1024 };
+    constexpr static size_t BLOCKS_PER_CHUNK{ 64 };
+
+    /// @brief A freed block, which links to the next free block of the same size.
+    struct FreeBlock
+        {
+        FreeBlock* m_next{ nullptr };
+        };
+
+    mutable std::mutex m_mutex;
+    std::array<FreeBlock*, MAX_POOLED_SIZE / BLOCK_GRANULARITY> m_freeLists{};
+    std::vector<std::unique_ptr<std::byte[]>> m_chunks;
+    size_t m_reservedBytes{ 0 };
+    };
+
+/** @brief Standard allocator that gets its memory from an ObjectPool.
+    @details The allocator shares ownership of its pool, so objects created with it
+        (e.g., through @c std::allocate_shared()) keep the pool alive, even if they outlive
+        whatever created them.
+    @par Example
+    @code
+        auto pool = std::make_shared<ObjectPool>();
+        auto label = std::allocate_shared<Label>(ObjectPoolAllocator<Label>(pool),
+                                                 L"Q1 Sales");
+    @endcode*/
+template<typename T>
+class ObjectPoolAllocator
+    {
+public:
+    /// @private
+    using value_type = T;
+    /** @brief Constructor.
+        @param pool The pool to get memory from.*/
+    explicit ObjectPoolAllocator(std::shared_ptr<ObjectPool> pool) noexcept :
+        m_pool(std::move(pool))
+        {}
+    /// @private
+    template<typename U>
+    ObjectPoolAllocator(const ObjectPoolAllocator<U>& that) noexcept :
+        m_pool(that.GetPool())
+        {}
+    /// @private
+    [[nodiscard]] T* allocate(const size_t count)
+        { return static_cast<T*>(m_pool->Allocate(count * sizeof(T), alignof(T))); }
+    /// @private
+    void deallocate(T* block, const size_t count) noexcept
+        { m_pool->Deallocate(block, count * sizeof(T), alignof(T)); }
+    /// @returns The pool that memory is coming from.
+    [[nodiscard]] const std::shared_ptr<ObjectPool>& GetPool() const noexcept
+        { return m_pool; }
+    /// @private
+    template<typename U>
+    [[nodiscard]] bool operator==(const ObjectPoolAllocator<U>& that) const noexcept
+        { return m_pool == that.GetPool(); }
+    /// @private
+    template<typename U>
+    [[nodiscard]] bool operator!=(const ObjectPoolAllocator<U>& that) const noexcept
+        { return m_pool != that.GetPool(); }
+private:
+    std::shared_ptr<ObjectPool> m_pool;
+    };
+
+/** @}*/
+
+#endif //__OBJECT_POOL_H__
@@ -0,0 +1,351 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        pixelkernels.cpp
+// Author:      Blake Madden
+// Copyright:   (c) 2005-2022 Blake Madden
+// Licence:     3-Clause BSD licence
+// SPDX-License-Identifier: BSD-3-Clause
+///////////////////////////////////////////////////////////////////////////////
+
+#include "pixelkernels.h"
+#include <algorithm>
+#include <cstring>
+#include <execution>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define PIXEL_KERNELS_SSE2
+    #include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    // the NEON path uses AArch64-only instructions (e.g., across-vector reductions),
+    // so 32-bit ARM builds use the plain loops
+    #define PIXEL_KERNELS_NEON
+    #include <arm_neon.h>
+#endif
+
+namespace
+    {
+    //----------------------------------------------------------------
+    /// @returns The luma of a pixel, using the same (fixed point) weights
+    ///     as wxImage::ConvertToGreyscale().
+    [[nodiscard]] inline uint8_t Luma(const uint8_t red, const uint8_t green,
+                                      const uint8_t blue) noexcept
+        {
+        return static_cast<uint8_t>((red * 299 + green * 587 + blue * 114 + 500) / 1000);
+        }
+
+#ifdef PIXEL_KERNELS_SSE2
+    //----------------------------------------------------------------
+    /** @returns @c true if any byte in a block of 16 pixels (48 bytes) matches its
+            respective channel in the color.
+        @details If this is @c false, then no pixel in the block can match the color
+            and the block can be skipped.*/
+    [[nodiscard]] inline bool AnyChannelMatches(const uint8_t* rgb, const __m128i pattern[3]) noexcept
+        {
+        const __m128i first =
+            _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(rgb)), pattern[0]);
+        const __m128i second =
+            _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(rgb + 16)), pattern[1]);
+        const __m128i third =
+            _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(rgb + 32)), pattern[2]);
+        return _mm_movemask_epi8(_mm_or_si128(_mm_or_si128(first, second), third)) != 0;
+        }
+
+    //----------------------------------------------------------------
+    /// @brief Fills three vectors with a color's RGB values repeated across 48 bytes
+    ///     (i.e., 16 pixels).
+    inline void MakeColorPattern(__m128i pattern[3], const uint8_t red, const uint8_t green,
+                                 const uint8_t blue) noexcept
+        {
+        alignas(16) uint8_t bytes[48];
+        for (size_t i = 0; i < 48; i += 3)
+            {
+            bytes[i] = red;
+            bytes[i + 1] = green;
+            bytes[i + 2] = blue;
+            }
+        pattern[0] = _mm_load_si128(reinterpret_cast<const __m128i*>(bytes));
+        pattern[1] = _mm_load_si128(reinterpret_cast<const __m128i*>(bytes + 16));
+        pattern[2] = _mm_load_si128(reinterpret_cast<const __m128i*>(bytes + 32));
+        }
+#endif
+
+#ifdef PIXEL_KERNELS_NEON
+    //----------------------------------------------------------------
+    /// @returns The lumas of eight pixels.
+    [[nodiscard]] inline uint16x8_t Luma(const uint8x8_t red, const uint8x8_t green,
+                                         const uint8x8_t blue) noexcept
+        {
+        const uint16x8_t red16 = vmovl_u8(red);
+        const uint16x8_t green16 = vmovl_u8(green);
+        const uint16x8_t blue16 = vmovl_u8(blue);
+        const auto lumaHalf = [](const uint16x4_t r, const uint16x4_t g, const uint16x4_t b)
+            {
+            uint32x4_t sum = vmull_n_u16(r, 299);
+            sum = vmlal_n_u16(sum, g, 587);
+            sum = vmlal_n_u16(sum, b, 114);
+            sum = vaddq_u32(sum, vdupq_n_u32(500));
+            // (sum / 1000) is the same as ((sum / 8) / 125), and (x / 125) is
+            // (x * 33555) >> 22 for all of the values (< 32768) that can come through here
+            sum = vshrq_n_u32(sum, 3);
+            return vmovn_u32(vshrq_n_u32(vmulq_n_u32(sum, 33555), 22));
+            };
+        return vcombine_u16(
+            lumaHalf(vget_low_u16(red16), vget_low_u16(green16), vget_low_u16(blue16)),
+            lumaHalf(vget_high_u16(red16), vget_high_u16(green16), vget_high_u16(blue16)));
+        }
+#endif
+    }
+
+//----------------------------------------------------------------
+template<typename KernelT>
+void PixelKernels::ForEachChunk(const size_t pixelCount, KernelT kernel)
+    {
+    if (pixelCount < PARALLEL_PIXEL_THRESHOLD)
+        {
+        kernel(0, pixelCount);
+        return;
+        }
+    std::vector<size_t> chunkStarts;
+    chunkStarts.reserve((pixelCount / PIXELS_PER_CHUNK) + 1);
+    for (size_t i = 0; i < pixelCount; i += PIXELS_PER_CHUNK)
+        { chunkStarts.push_back(i); }
+    std::for_each(std::execution::par, chunkStarts.cbegin(), chunkStarts.cend(),
+        [pixelCount, &kernel](const size_t chunkStart)
+        { kernel(chunkStart, std::min(PIXELS_PER_CHUNK, pixelCount - chunkStart)); });
+    }
+
+//----------------------------------------------------------------
+void PixelKernels::SetOpacity(uint8_t* alpha, const size_t pixelCount, const uint8_t opacity,
+                              const bool preserveTransparentPixels)
+    {
+    if (alpha == nullptr || pixelCount == 0)
+        { return; }
+    if (!preserveTransparentPixels)
+        {
+        std::memset(alpha, opacity, pixelCount);
+        return;
+        }
+    ForEachChunk(pixelCount, [alpha, opacity](const size_t start, const size_t count)
+        {
+        uint8_t* const chunk = alpha + start;
+        size_t i{ 0 };
+#if defined(PIXEL_KERNELS_SSE2)
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i opacityValues = _mm_set1_epi8(static_cast<char>(opacity));
+        for (; i + 16 <= count; i += 16)
+            {
+            const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chunk + i));
+            // transparent pixels stay at zero, everything else gets the opacity
+            const __m128i transparent = _mm_cmpeq_epi8(values, zero);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(chunk + i),
+                             _mm_andnot_si128(transparent, opacityValues));
+            }
+#elif defined(PIXEL_KERNELS_NEON)
+        const uint8x16_t opacityValues = vdupq_n_u8(opacity);
+        for (; i + 16 <= count; i += 16)
+            {
+            const uint8x16_t transparent = vceqzq_u8(vld1q_u8(chunk + i));
+            vst1q_u8(chunk + i, vbicq_u8(opacityValues, transparent));
+            }
+#endif
+        for (; i < count; ++i)
+            {
+            if (chunk[i] != 0)
+                { chunk[i] = opacity; }
+            }
+        });
+    }
+
+//----------------------------------------------------------------
+void PixelKernels::SetColorTransparent(const uint8_t* rgb, uint8_t* alpha,
+                                       const size_t pixelCount,
+                                       const uint8_t red, const uint8_t green, const uint8_t blue)
+    {
+    if (rgb == nullptr || alpha == nullptr || pixelCount == 0)
+        { return; }
+    ForEachChunk(pixelCount, [rgb, alpha, red, green, blue](const size_t start, const size_t count)
+        {
+        const uint8_t* const rgbChunk = rgb + (start * 3);
+        uint8_t* const alphaChunk = alpha + start;
+        const auto scalarKernel = [&](const size_t first, const size_t last)
+            {
+            for (size_t i = first; i < last; ++i)
+                {
+                const uint8_t* const pixel = rgbChunk + (i * 3);
+                if (pixel[0] == red && pixel[1] == green && pixel[2] == blue)
+                    { alphaChunk[i] = 0; }
+                }
+            };
+        size_t i{ 0 };
+#if defined(PIXEL_KERNELS_SSE2)
+        __m128i pattern[3];
+        MakeColorPattern(pattern, red, green, blue);
+        for (; i + 16 <= count; i += 16)
+            {
+            if (AnyChannelMatches(rgbChunk + (i * 3), pattern))
+                { scalarKernel(i, i + 16); }
+            }
+#elif defined(PIXEL_KERNELS_NEON)
+        const uint8x16_t redValues = vdupq_n_u8(red);
+        const uint8x16_t greenValues = vdupq_n_u8(green);
+        const uint8x16_t blueValues = vdupq_n_u8(blue);
+        for (; i + 16 <= count; i += 16)
+            {
+            const uint8x16x3_t pixels = vld3q_u8(rgbChunk + (i * 3));
+            const uint8x16_t matches =
+                vandq_u8(vandq_u8(vceqq_u8(pixels.val[0], redValues),
+                                  vceqq_u8(pixels.val[1], greenValues)),
+                         vceqq_u8(pixels.val[2], blueValues));
+            vst1q_u8(alphaChunk + i, vbicq_u8(vld1q_u8(alphaChunk + i), matches));
+            }
+#endif
+        scalarKernel(i, count);
+        });
+    }
+
+//----------------------------------------------------------------
+void PixelKernels::ReplaceColor(uint8_t* rgb, const size_t pixelCount,
+                                const uint8_t srcRed, const uint8_t srcGreen, const uint8_t srcBlue,
+                                const uint8_t destRed, const uint8_t destGreen, const uint8_t destBlue)
+    {
+    if (rgb == nullptr || pixelCount == 0 ||
+        (srcRed == destRed && srcGreen == destGreen && srcBlue == destBlue))
+        { return; }
+    ForEachChunk(pixelCount,
+        [rgb, srcRed, srcGreen, srcBlue, destRed, destGreen, destBlue]
+        (const size_t start, const size_t count)
+        {
+        uint8_t* const rgbChunk = rgb + (start * 3);
+        const auto scalarKernel = [&](const size_t first, const size_t last)
+            {
+            for (size_t i = first; i < last; ++i)
+                {
+                uint8_t* const pixel = rgbChunk + (i * 3);
+                if (pixel[0] == srcRed && pixel[1] == srcGreen && pixel[2] == srcBlue)
+                    {
+                    pixel[0] = destRed;
+                    pixel[1] = destGreen;
+                    pixel[2] = destBlue;
+                    }
+                }
+            };
+        size_t i{ 0 };
+#if defined(PIXEL_KERNELS_SSE2)
+        __m128i pattern[3];
+        MakeColorPattern(pattern, srcRed, srcGreen, srcBlue);
+        for (; i + 16 <= count; i += 16)
+            {
+            if (AnyChannelMatches(rgbChunk + (i * 3), pattern))
+                { scalarKernel(i, i + 16); }
+            }
+#elif defined(PIXEL_KERNELS_NEON)
+        const uint8x16_t srcRedValues = vdupq_n_u8(srcRed);
+        const uint8x16_t srcGreenValues = vdupq_n_u8(srcGreen);
+        const uint8x16_t srcBlueValues = vdupq_n_u8(srcBlue);
+        const uint8x16_t destRedValues = vdupq_n_u8(destRed);
+        const uint8x16_t destGreenValues = vdupq_n_u8(destGreen);
+        const uint8x16_t destBlueValues = vdupq_n_u8(destBlue);
+        for (; i + 16 <= count; i += 16)
+            {
+            uint8x16x3_t pixels = vld3q_u8(rgbChunk + (i * 3));
+            const uint8x16_t matches =
+                vandq_u8(vandq_u8(vceqq_u8(pixels.val[0], srcRedValues),
+                                  vceqq_u8(pixels.val[1], srcGreenValues)),
+                         vceqq_u8(pixels.val[2], srcBlueValues));
+            if (vmaxvq_u8(matches) == 0)
+                { continue; }
+            pixels.val[0] = vbslq_u8(matches, destRedValues, pixels.val[0]);
+            pixels.val[1] = vbslq_u8(matches, destGreenValues, pixels.val[1]);
+            pixels.val[2] = vbslq_u8(matches, destBlueValues, pixels.val[2]);
+            vst3q_u8(rgbChunk + (i * 3), pixels);
+            }
+#endif
+        scalarKernel(i, count);
+        });
+    }
+
+//----------------------------------------------------------------
+void PixelKernels::ToGrayscale(uint8_t* rgb, const size_t pixelCount)
+    {
+    if (rgb == nullptr || pixelCount == 0)
+        { return; }
+    ForEachChunk(pixelCount, [rgb](const size_t start, const size_t count)
+        {
+        uint8_t* const rgbChunk = rgb + (start * 3);
+        size_t i{ 0 };
+#if defined(PIXEL_KERNELS_NEON)
+        for (; i + 16 <= count; i += 16)
+            {
+            uint8x16x3_t pixels = vld3q_u8(rgbChunk + (i * 3));
+            const uint8x16_t lumas = vcombine_u8(
+                vmovn_u16(Luma(vget_low_u8(pixels.val[0]), vget_low_u8(pixels.val[1]),
+                               vget_low_u8(pixels.val[2]))),
+                vmovn_u16(Luma(vget_high_u8(pixels.val[0]), vget_high_u8(pixels.val[1]),
+                               vget_high_u8(pixels.val[2]))));
+            pixels.val[0] = pixels.val[1] = pixels.val[2] = lumas;
+            vst3q_u8(rgbChunk + (i * 3), pixels);
+            }
+#endif
+        // SSE2 has no byte shuffles to pull the channels apart (and SSSE3 is not part of
+        // the x86-64 baseline), so other platforms rely on the compiler here
+        for (; i < count; ++i)
+            {
+            uint8_t* const pixel = rgbChunk + (i * 3);
+            pixel[0] = pixel[1] = pixel[2] = Luma(pixel[0], pixel[1], pixel[2]);
+            }
+        });
+    }
+
+//----------------------------------------------------------------
+void PixelKernels::MonoToSilhouette(uint8_t* rgb, uint8_t* alpha, const size_t pixelCount,
+                                    const uint8_t red, const uint8_t green, const uint8_t blue)
+    {
+    if (rgb == nullptr || alpha == nullptr || pixelCount == 0)
+        { return; }
+    const bool recolor = (red != 0 || green != 0 || blue != 0);
+    ForEachChunk(pixelCount,
+        [rgb, alpha, red, green, blue, recolor](const size_t start, const size_t count)
+        {
+        uint8_t* const rgbChunk = rgb + (start * 3);
+        uint8_t* const alphaChunk = alpha + start;
+        size_t i{ 0 };
+#if defined(PIXEL_KERNELS_NEON)
+        const uint8x16_t white = vdupq_n_u8(255);
+        const uint8x16_t zero = vdupq_n_u8(0);
+        const uint8x16_t redValues = vdupq_n_u8(red);
+        const uint8x16_t greenValues = vdupq_n_u8(green);
+        const uint8x16_t blueValues = vdupq_n_u8(blue);
+        for (; i + 16 <= count; i += 16)
+            {
+            uint8x16x3_t pixels = vld3q_u8(rgbChunk + (i * 3));
+            const uint8x16_t whites =
+                vandq_u8(vandq_u8(vceqq_u8(pixels.val[0], white), vceqq_u8(pixels.val[1], white)),
+                         vceqq_u8(pixels.val[2], white));
+            vst1q_u8(alphaChunk + i, vbicq_u8(vld1q_u8(alphaChunk + i), whites));
+            if (recolor)
+                {
+                const uint8x16_t blacks =
+                    vandq_u8(vandq_u8(vceqq_u8(pixels.val[0], zero),
+                                      vceqq_u8(pixels.val[1], zero)),
+                             vceqq_u8(pixels.val[2], zero));
+                pixels.val[0] = vbslq_u8(blacks, redValues, pixels.val[0]);
+                pixels.val[1] = vbslq_u8(blacks, greenValues, pixels.val[1]);
+                pixels.val[2] = vbslq_u8(blacks, blueValues, pixels.val[2]);
+                vst3q_u8(rgbChunk + (i * 3), pixels);
+                }
+            }
+#endif
+        for (; i < count; ++i)
+            {
+            uint8_t* const pixel = rgbChunk + (i * 3);
+            if (pixel[0] == 255 && pixel[1] == 255 && pixel[2] == 255)
+                { alphaChunk[i] = 0; }
+            else if (recolor && pixel[0] == 0 && pixel[1] == 0 && pixel[2] == 0)
+                {
+                pixel[0] = red;
+                pixel[1] = green;
+                pixel[2] = blue;
+                }
+            }
+        });
+    }
@@ -0,0 +1,95 @@
+/** @addtogroup Utilities
+    @brief Utility classes.
+    @date 2005-2022
+    @copyright Blake Madden
+    @author Blake Madden
+    @details This program is free software; you can redistribute it and/or modify
+     it under the terms of the 3-Clause BSD License.
+
+     SPDX-License-Identifier: BSD-3-Clause
+@{*/
+
+#ifndef __PIXEL_KERNELS_H__
+#define __PIXEL_KERNELS_H__
+
+#include <cstddef>
+#include <cstdint>
+
+/** @brief Low-level routines for editing an image's pixel and alpha buffers in place.
+    @details These work on the raw buffers from @c wxImage::GetData() (packed RGB triplets)
+        and @c wxImage::GetAlpha() (one byte per pixel).
+
+        SSE2 (x86) or NEON (ARM64) instructions are used when the compiler targets them,
+        otherwise plain loops are used. Large images are also split into chunks
+        which are processed in parallel.
+    @note The caller is responsible for making sure that the buffers are not shared with
+        other images (i.e., call @c wxImage::UnShare() first), and that they hold
+        at least @c pixelCount pixels.
+    @par Example
+    @code
+        // make all non-transparent pixels half transparent
+        img.UnShare();
+        PixelKernels::SetOpacity(img.GetAlpha(),
+                                 static_cast<size_t>(img.GetWidth()) * img.GetHeight(),
+                                 128, true);
+    @endcode*/
+class PixelKernels
+    {
+public:
+    /// @private
+    PixelKernels() = delete;
+    /** @brief Sets every pixel's alpha value.
+        @param alpha The alpha channel.
+        @param pixelCount The number of pixels.
+        @param opacity The alpha value to use.
+        @param preserveTransparentPixels @c true to leave pixels that are fully
+            transparent alone.*/
+    static void SetOpacity(uint8_t* alpha, const size_t pixelCount, const uint8_t opacity,
+                           const bool preserveTransparentPixels);
+    /** @brief Makes pixels of a given color fully transparent.
+        @param rgb The RGB data.
+        @param alpha The alpha channel.
+        @param pixelCount The number of pixels.
+        @param red,green,blue The color to make transparent.*/
+    static void SetColorTransparent(const uint8_t* rgb, uint8_t* alpha, const size_t pixelCount,
+                                    const uint8_t red, const uint8_t green, const uint8_t blue);
+    /** @brief Replaces pixels of a given color with another color.
+        @param rgb The RGB data.
+        @param pixelCount The number of pixels.
+        @param srcRed,srcGreen,srcBlue The color to replace.
+        @param destRed,destGreen,destBlue The color to replace it with.*/
+    static void ReplaceColor(uint8_t* rgb, const size_t pixelCount,
+                             const uint8_t srcRed, const uint8_t srcGreen, const uint8_t srcBlue,
+                             const uint8_t destRed, const uint8_t destGreen, const uint8_t destBlue);
+    /** @brief Converts pixels to grayscale.
+        @details Uses the same luma weights as @c wxImage::ConvertToGreyscale()
+            (0.299, 0.587, 0.114).
+        @param rgb The RGB data.
+        @param pixelCount The number of pixels.*/
+    static void ToGrayscale(uint8_t* rgb, const size_t pixelCount);
+    /** @brief Finishes a silhouette from a monochrome image, in one pass.
+        @details White pixels become transparent and black pixels become opaque
+            and (optionally) recolored.
+        @param rgb The RGB data of an image from @c wxImage::ConvertToMono().
+        @param alpha The alpha channel.
+        @param pixelCount The number of pixels.
+        @param red,green,blue The color for the silhouette's (i.e., the black) pixels.*/
+    static void MonoToSilhouette(uint8_t* rgb, uint8_t* alpha, const size_t pixelCount,
+                                 const uint8_t red, const uint8_t green, const uint8_t blue);
+private:
+    /** @brief Runs a kernel over a range of pixels, splitting large images into chunks
+            that are processed in parallel.
+        @param pixelCount The number of pixels.
+        @param kernel The function to call with the first pixel (index) and number of
+            pixels for each chunk.*/
+    template<typename KernelT>
+    static void ForEachChunk(const size_t pixelCount, KernelT kernel);
+
+    // images smaller than this are processed on the calling thread
+    static constexpr size_t PARALLEL_PIXEL_THRESHOLD{ 1024 * 1024 };
+    static constexpr size_t PIXELS_PER_CHUNK{ 256 * 1024 };
+    };
+
+/** @}*/
+
+#endif //__PIXEL_KERNELS_H__
@@ -0,0 +1,151 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        spatialgrid.cpp
+// Author:      Blake Madden
+// Copyright:   (c) 2005-2022 Blake Madden
+// Licence:     3-Clause BSD licence
+// SPDX-License-Identifier: BSD-3-Clause
+///////////////////////////////////////////////////////////////////////////////
+
+#include "spatialgrid.h"
+#include <cmath>
+
+//----------------------------------------------------------------
+void SpatialGrid::Build(std::vector<wxRect> boxes)
+    {
+    Clear();
+    m_boxes = std::move(boxes);
+    m_isBuilt = true;
+
+    // get the area covered by all the (non-empty) boxes
+    size_t itemCount{ 0 };
+    double totalWidth{ 0 }, totalHeight{ 0 };
+    for (const auto& box : m_boxes)
+        {
+        if (box.IsEmpty())
+            { continue; }
+        m_area = (itemCount == 0) ? box : m_area.Union(box);
+        totalWidth += box.GetWidth();
+        totalHeight += box.GetHeight();
+        ++itemCount;
+        }
+    if (itemCount == 0)
+        { return; }
+
+    // aim for about one item per cell, but don't make the cells
+    // smaller than the items (or else the items will span several cells)
+    const double itemsPerPixel = static_cast<double>(itemCount) /
+        (static_cast<double>(m_area.GetWidth()) * m_area.GetHeight());
+    const double cellLength = 1.0 / std::sqrt(itemsPerPixel);
+    const auto calcCellSize = [&](const double areaLength, const double averageItemLength)
+        {
+        const int cellCount = std::clamp(
+            static_cast<int>(areaLength / std::max({ cellLength, averageItemLength, 1.0 })),
+            1, MAX_CELLS_PER_SIDE);
+        return static_cast<int>(std::ceil(areaLength / cellCount));
+        };
+    m_cellSize = wxSize(calcCellSize(m_area.GetWidth(), totalWidth / itemCount),
+                        calcCellSize(m_area.GetHeight(), totalHeight / itemCount));
+    m_columns = static_cast<int>(std::ceil(static_cast<double>(m_area.GetWidth()) /
+                                           m_cellSize.GetWidth()));
+    m_rows = static_cast<int>(std::ceil(static_cast<double>(m_area.GetHeight()) /
+                                        m_cellSize.GetHeight()));
+
+    // count the items in each cell, and then fill them in
+    // (so that the cells are stored in one contiguous block)
+    m_cellStarts.assign(static_cast<size_t>(m_columns) * m_rows + 1, 0);
+    const auto forEachCell = [this](const wxRect& box, auto&& func)
+        {
+        const auto [firstColumn, firstRow] = GetCell(box.GetTopLeft());
+        const auto [lastColumn, lastRow] = GetCell(box.GetBottomRight());
+        for (int row = firstRow; row <= lastRow; ++row)
+            {
+            for (int column = firstColumn; column <= lastColumn; ++column)
+                { func(static_cast<size_t>(row) * m_columns + column); }
+            }
+        };
+    const auto isLargeItem = [this](const wxRect& box)
+        {
+        const auto [firstColumn, firstRow] = GetCell(box.GetTopLeft());
+        const auto [lastColumn, lastRow] = GetCell(box.GetBottomRight());
+        return (static_cast<int64_t>(lastColumn - firstColumn + 1) *
+                (lastRow - firstRow + 1)) > MAX_CELLS_PER_ITEM;
+        };
+    for (size_t i = 0; i < m_boxes.size(); ++i)
+        {
+        if (m_boxes[i].IsEmpty())
+            { continue; }
+        if (isLargeItem(m_boxes[i]))
+            {
+            m_largeItems.push_back(static_cast<uint32_t>(i));
+            continue;
+            }
+        forEachCell(m_boxes[i], [this](const size_t cell) { ++m_cellStarts[cell + 1]; });
+        }
+    for (size_t i = 1; i < m_cellStarts.size(); ++i)
+        { m_cellStarts[i] += m_cellStarts[i - 1]; }
+    m_cellItems.resize(m_cellStarts.back());
+    std::vector<uint32_t> cellFill(m_cellStarts.cbegin(), m_cellStarts.cend() - 1);
+    for (size_t i = 0; i < m_boxes.size(); ++i)
+        {
+        if (m_boxes[i].IsEmpty() || isLargeItem(m_boxes[i]))
+            { continue; }
+        forEachCell(m_boxes[i], [this, &cellFill, i](const size_t cell)
+            { m_cellItems[cellFill[cell]++] = static_cast<uint32_t>(i); });
+        }
+    }
+
+//----------------------------------------------------------------
+std::vector<size_t> SpatialGrid::FindItemsAt(const wxPoint pt) const
+    {
+    std::vector<size_t> items;
+    if (m_columns == 0 || !m_area.Contains(pt))
+        { return items; }
+    const auto [column, row] = GetCell(pt);
+    const size_t cell = static_cast<size_t>(row) * m_columns + column;
+    // items were added to the cells in order, so these will already be sorted
+    for (auto i = m_cellStarts[cell]; i < m_cellStarts[cell + 1]; ++i)
+        {
+        if (m_boxes[m_cellItems[i]].Contains(pt))
+            { items.push_back(m_cellItems[i]); }
+        }
+    if (!m_largeItems.empty())
+        {
+        const auto cellItemsEnd = items.size();
+        for (const auto item : m_largeItems)
+            {
+            if (m_boxes[item].Contains(pt))
+                { items.push_back(item); }
+            }
+        std::inplace_merge(items.begin(), items.begin() + cellItemsEnd, items.end());
+        }
+    return items;
+    }
+
+//----------------------------------------------------------------
+std::optional<size_t> SpatialGrid::FindFirstItemAt(const wxPoint pt) const
+    {
+    std::optional<size_t> firstItem;
+    if (m_columns == 0 || !m_area.Contains(pt))
+        { return firstItem; }
+    const auto [column, row] = GetCell(pt);
+    const size_t cell = static_cast<size_t>(row) * m_columns + column;
+    for (auto i = m_cellStarts[cell]; i < m_cellStarts[cell + 1]; ++i)
+        {
+        if (m_boxes[m_cellItems[i]].Contains(pt))
+            {
+            firstItem = m_cellItems[i];
+            break;
+            }
+        }
+    for (const auto item : m_largeItems)
+        {
+        if (firstItem && item >= firstItem.value())
+            { break; }
+        if (m_boxes[item].Contains(pt))
+            {
+            firstItem = item;
+            break;
+            }
+        }
+    return firstItem;
+    }
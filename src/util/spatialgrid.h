@@ -0,0 +1,104 @@
+/** @addtogroup Utilities
+    @brief Utility classes.
+    @date 2005-2022
+    @copyright Blake Madden
+    @author Blake Madden
+    @details This program is free software; you can redistribute it and/or modify
+     it under the terms of the 3-Clause BSD License.
+
+     SPDX-License-Identifier: BSD-3-Clause
+@{*/
+
+#ifndef __SPATIAL_GRID_H__
+#define __SPATIAL_GRID_H__
+
+#include <wx/gdicmn.h>
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+/** @brief A uniform grid of rectangles, used to quickly find which rectangles contain a point.
+    @details The area covered by the rectangles is divided into cells, and each rectangle is
+        recorded in the cells that it overlaps. Looking up a point only needs to check the
+        rectangles in the point's cell, rather than every rectangle.
+
+        This is meant for hit testing objects on a canvas (e.g., points in a scatter plot
+        or the bars in a bar chart), where the rectangles are the objects' bounding boxes.
+    @note Rectangles that cover a large part of the area (e.g., a background shape)
+        are kept aside and checked on every lookup, rather than added to many cells.\n
+        The grid holds copies of the rectangles, so it must be rebuilt if they change.
+    @par Example
+    @code
+        SpatialGrid grid;
+        grid.Build(boundingBoxes);
+        // find the first (i.e., lowest index) rectangle under the mouse
+        const auto hitItem = grid.FindFirstItemAt(mousePoint);
+    @endcode*/
+class SpatialGrid
+    {
+public:
+    /** @brief Indexes a set of rectangles.
+        @param boxes The rectangles to index. Their indices in this vector are what the
+            lookup functions return. Empty rectangles are not indexed.*/
+    void Build(std::vector<wxRect> boxes);
+    /// @brief Removes all rectangles from the grid.
+    /// @details Call this when the indexed rectangles have changed.
+    void Clear() noexcept
+        {
+        m_boxes.clear();
+        m_cellStarts.clear();
+        m_cellItems.clear();
+        m_largeItems.clear();
+        m_columns = m_rows = 0;
+        m_isBuilt = false;
+        }
+    /// @returns The number of bytes that the grid's index is using.
+    [[nodiscard]] size_t GetMemoryUsage() const noexcept
+        {
+        return m_boxes.capacity() * sizeof(wxRect) +
+               (m_cellStarts.capacity() + m_cellItems.capacity() + m_largeItems.capacity()) *
+                   sizeof(uint32_t);
+        }
+    /// @returns @c true if Build() has been called since the grid was last cleared.
+    [[nodiscard]] bool IsBuilt() const noexcept
+        { return m_isBuilt; }
+    /** @returns The indices of the rectangles that contain a point, in ascending order.
+        @param pt The point to look up.*/
+    [[nodiscard]] std::vector<size_t> FindItemsAt(const wxPoint pt) const;
+    /** @returns The lowest index of the rectangles that contain a point,
+            or @c std::nullopt if no rectangle contains it.
+        @param pt The point to look up.*/
+    [[nodiscard]] std::optional<size_t> FindFirstItemAt(const wxPoint pt) const;
+private:
+    /// @returns The cell (column and row) that a point is in.
+    /// @note The point must be inside of the grid's area.
+    [[nodiscard]] std::pair<int, int> GetCell(const wxPoint pt) const noexcept
+        {
+        return std::make_pair(
+            std::min((pt.x - m_area.GetLeft()) / m_cellSize.GetWidth(), m_columns - 1),
+            std::min((pt.y - m_area.GetTop()) / m_cellSize.GetHeight(), m_rows - 1));
+        }
+
+    // rectangles that cover more cells than this are checked on every lookup
+    static constexpr int MAX_CELLS_PER_ITEM{ 64 };
+    // upper limit of cells along either side of the grid
+    static constexpr int MAX_CELLS_PER_SIDE{ 1024 };
+
+    std::vector<wxRect> m_boxes;
+    wxRect m_area;
+    wxSize m_cellSize{ 1, 1 };
+    int m_columns{ 0 };
+    int m_rows{ 0 };
+    // the items in each cell, stored contiguously; cell N's items are in
+    // [m_cellStarts[N], m_cellStarts[N + 1])
+    std::vector<uint32_t> m_cellStarts;
+    std::vector<uint32_t> m_cellItems;
+    std::vector<uint32_t> m_largeItems;
+    bool m_isBuilt{ false };
+    };
+
+/** @}*/
+
+#endif //__SPATIAL_GRID_H__
@@ -0,0 +1,291 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        stripimagewriter.cpp
+// Author:      Blake Madden
+// Copyright:   (c) 2005-2022 Blake Madden
+// Licence:     3-Clause BSD licence
+// SPDX-License-Identifier: BSD-3-Clause
+///////////////////////////////////////////////////////////////////////////////
+
+#include "stripimagewriter.h"
+#include <array>
+#include <limits>
+
+namespace
+    {
+    /// @returns The CRC-32 of a PNG chunk's type and data.
+    uint32_t CalcChunkCRC(const char* chunkType, const std::vector<uint8_t>& data)
+        {
+        static const auto crcTable = []()
+            {
+            std::array<uint32_t, 256> table{ 0 };
+            for (uint32_t i = 0; i < table.size(); ++i)
+                {
+                uint32_t crc{ i };
+                for (int bit = 0; bit < 8; ++bit)
+                    { crc = (crc & 1) ? (0xEDB88320U ^ (crc >> 1)) : (crc >> 1); }
+                table[i] = crc;
+                }
+            return table;
+            }();
+        uint32_t crc{ 0xFFFFFFFFU };
+        const auto update = [&crc](const uint8_t byte) noexcept
+            { crc = crcTable[(crc ^ byte) & 0xFF] ^ (crc >> 8); };
+        for (size_t i = 0; i < 4; ++i)
+            { update(static_cast<uint8_t>(chunkType[i])); }
+        for (const auto byte : data)
+            { update(byte); }
+        return crc ^ 0xFFFFFFFFU;
+        }
+    }
+
+//----------------------------------------------------------------
+void StripImageWriter::AppendBigEndian32(std::vector<uint8_t>& buffer, const uint32_t value)
+    {
+    buffer.push_back(static_cast<uint8_t>(value >> 24));
+    buffer.push_back(static_cast<uint8_t>(value >> 16));
+    buffer.push_back(static_cast<uint8_t>(value >> 8));
+    buffer.push_back(static_cast<uint8_t>(value));
+    }
+
+//----------------------------------------------------------------
+void StripImageWriter::AppendLittleEndian16(std::vector<uint8_t>& buffer, const uint16_t value)
+    {
+    buffer.push_back(static_cast<uint8_t>(value));
+    buffer.push_back(static_cast<uint8_t>(value >> 8));
+    }
+
+//----------------------------------------------------------------
+void StripImageWriter::AppendLittleEndian32(std::vector<uint8_t>& buffer, const uint32_t value)
+    {
+    buffer.push_back(static_cast<uint8_t>(value));
+    buffer.push_back(static_cast<uint8_t>(value >> 8));
+    buffer.push_back(static_cast<uint8_t>(value >> 16));
+    buffer.push_back(static_cast<uint8_t>(value >> 24));
+    }
+
+//----------------------------------------------------------------
+PngStripWriter::PngStripWriter(wxOutputStream& stream, const wxSize imageSize,
+                               const int compressionLevel) :
+    StripImageWriter(stream, imageSize),
+    m_zlibStream(m_compressedData, compressionLevel, wxZLIB_ZLIB)
+    {}
+
+//----------------------------------------------------------------
+bool PngStripWriter::WriteChunk(const char* chunkType, const std::vector<uint8_t>& data)
+    {
+    std::vector<uint8_t> header;
+    AppendBigEndian32(header, static_cast<uint32_t>(data.size()));
+    header.insert(header.end(), chunkType, chunkType + 4);
+    std::vector<uint8_t> crc;
+    AppendBigEndian32(crc, CalcChunkCRC(chunkType, data));
+    return WriteBuffer(header.data(), header.size()) &&
+        (data.empty() || WriteBuffer(data.data(), data.size())) &&
+        WriteBuffer(crc.data(), crc.size());
+    }
+
+//----------------------------------------------------------------
+bool PngStripWriter::FlushCompressedData()
+    {
+    auto& compressedData = m_compressedData.GetBuffer();
+    if (compressedData.empty())
+        { return true; }
+    const bool written = WriteChunk("IDAT", compressedData);
+    compressedData.clear();
+    return written;
+    }
+
+//----------------------------------------------------------------
+bool PngStripWriter::WriteStrip(const wxImage& strip)
+    {
+    if (!IsValidStrip(strip))
+        { return false; }
+    if (!m_headerWritten)
+        {
+        constexpr std::array<uint8_t, 8> signature{ 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+        if (!WriteBuffer(signature.data(), signature.size()))
+            { return false; }
+        std::vector<uint8_t> header;
+        AppendBigEndian32(header, static_cast<uint32_t>(m_imageSize.GetWidth()));
+        AppendBigEndian32(header, static_cast<uint32_t>(m_imageSize.GetHeight()));
+        header.push_back(8); // bit depth
+        header.push_back(2); // color type (RGB)
+        header.push_back(0); // compression method (deflate)
+        header.push_back(0); // filter method
+        header.push_back(0); // interlace method (none)
+        if (!WriteChunk("IHDR", header))
+            { return false; }
+        m_headerWritten = true;
+        }
+
+    const size_t rowSize = static_cast<size_t>(strip.GetWidth()) * 3;
+    const unsigned char* const rgbData = strip.GetData();
+    constexpr uint8_t noFilter{ 0 };
+    for (int row = 0; row < strip.GetHeight(); ++row)
+        {
+        m_zlibStream.Write(&noFilter, 1);
+        m_zlibStream.Write(rgbData + (row * rowSize), rowSize);
+        if (!m_zlibStream.IsOk())
+            { return false; }
+        }
+    m_rowsWritten += strip.GetHeight();
+    // write out whatever zlib has compressed so far
+    return FlushCompressedData();
+    }
+
+//----------------------------------------------------------------
+bool PngStripWriter::Finish()
+    {
+    if (!m_headerWritten || m_rowsWritten != m_imageSize.GetHeight())
+        { return false; }
+    return m_zlibStream.Close() && FlushCompressedData() &&
+        WriteChunk("IEND", std::vector<uint8_t>{});
+    }
+
+//----------------------------------------------------------------
+TiffStripWriter::TiffStripWriter(wxOutputStream& stream, const wxSize imageSize,
+                                 const bool deflate, const uint32_t dpi /*= 72*/) :
+    StripImageWriter(stream, imageSize), m_deflate(deflate), m_dpi(dpi)
+    {}
+
+//----------------------------------------------------------------
+bool TiffStripWriter::WriteStrip(const wxImage& strip)
+    {
+    if (!IsValidStrip(strip))
+        { return false; }
+    if (!m_headerWritten)
+        {
+        // little-endian header, with the directory's offset filled in when finished
+        std::vector<uint8_t> header{ 'I', 'I' };
+        AppendLittleEndian16(header, 42);
+        AppendLittleEndian32(header, 0);
+        if (!WriteBuffer(header.data(), header.size()))
+            { return false; }
+        m_offset = header.size();
+        m_rowsPerStrip = strip.GetHeight();
+        m_headerWritten = true;
+        }
+    // only the last strip can be shorter than the others
+    else if (strip.GetHeight() > m_rowsPerStrip ||
+             (m_rowsWritten % m_rowsPerStrip) != 0)
+        { return false; }
+
+    const size_t dataSize = static_cast<size_t>(strip.GetWidth()) * strip.GetHeight() * 3;
+    const uint8_t* stripData = strip.GetData();
+    size_t stripSize{ dataSize };
+    BufferOutputStream compressedData;
+    if (m_deflate)
+        {
+        wxZlibOutputStream zlibStream(compressedData, wxZ_DEFAULT_COMPRESSION, wxZLIB_ZLIB);
+        zlibStream.Write(stripData, dataSize);
+        if (!zlibStream.Close())
+            { return false; }
+        stripData = compressedData.GetBuffer().data();
+        stripSize = compressedData.GetBuffer().size();
+        }
+    if (m_offset + stripSize > std::numeric_limits<uint32_t>::max())
+        { return false; }
+    if (!WriteBuffer(stripData, stripSize))
+        { return false; }
+    m_stripOffsets.push_back(static_cast<uint32_t>(m_offset));
+    m_stripByteCounts.push_back(static_cast<uint32_t>(stripSize));
+    m_offset += stripSize;
+    m_rowsWritten += strip.GetHeight();
+    return true;
+    }
+
+//----------------------------------------------------------------
+bool TiffStripWriter::Finish()
+    {
+    if (!m_headerWritten || m_rowsWritten != m_imageSize.GetHeight())
+        { return false; }
+
+    // the directory must start on a word boundary
+    if (m_offset % 2 != 0)
+        {
+        constexpr uint8_t padding{ 0 };
+        if (!WriteBuffer(&padding, 1))
+            { return false; }
+        ++m_offset;
+        }
+
+    enum TiffFieldType : uint16_t
+        {
+        Short = 3,
+        Long = 4,
+        Rational = 5
+        };
+    constexpr uint16_t entryCount{ 13 };
+    const uint64_t directoryOffset{ m_offset };
+    // values that don't fit in a directory entry go after the directory
+    uint64_t valuesOffset{ directoryOffset + 2 + (entryCount * 12) + 4 };
+    std::vector<uint8_t> directory;
+    std::vector<uint8_t> values;
+    const auto addEntry = [&directory](const uint16_t tag, const TiffFieldType fieldType,
+                                       const uint32_t count, const uint32_t value)
+        {
+        AppendLittleEndian16(directory, tag);
+        AppendLittleEndian16(directory, fieldType);
+        AppendLittleEndian32(directory, count);
+        // shorts are left-justified in the value field
+        if (fieldType == TiffFieldType::Short && count == 1)
+            {
+            AppendLittleEndian16(directory, static_cast<uint16_t>(value));
+            AppendLittleEndian16(directory, 0);
+            }
+        else
+            { AppendLittleEndian32(directory, value); }
+        };
+    // adds values after the directory and returns their offset
+    const auto addValues = [&values, &valuesOffset](const std::vector<uint8_t>& data)
+        {
+        const auto offset = static_cast<uint32_t>(valuesOffset + values.size());
+        values.insert(values.end(), data.cbegin(), data.cend());
+        return offset;
+        };
+
+    std::vector<uint8_t> bitsPerSample;
+    for (int i = 0; i < 3; ++i)
+        { AppendLittleEndian16(bitsPerSample, 8); }
+    AppendLittleEndian16(bitsPerSample, 0); // keep the next value aligned
+    std::vector<uint8_t> resolution;
+    AppendLittleEndian32(resolution, m_dpi);
+    AppendLittleEndian32(resolution, 1);
+    std::vector<uint8_t> stripOffsets, stripByteCounts;
+    for (size_t i = 0; i < m_stripOffsets.size(); ++i)
+        {
+        AppendLittleEndian32(stripOffsets, m_stripOffsets[i]);
+        AppendLittleEndian32(stripByteCounts, m_stripByteCounts[i]);
+        }
+    const auto stripCount = static_cast<uint32_t>(m_stripOffsets.size());
+
+    AppendLittleEndian16(directory, entryCount);
+    // entries must be sorted by tag
+    addEntry(256, TiffFieldType::Long, 1, m_imageSize.GetWidth());  // ImageWidth
+    addEntry(257, TiffFieldType::Long, 1, m_imageSize.GetHeight()); // ImageLength
+    addEntry(258, TiffFieldType::Short, 3, addValues(bitsPerSample)); // BitsPerSample
+    addEntry(259, TiffFieldType::Short, 1, m_deflate ? 8 : 1); // Compression
+    addEntry(262, TiffFieldType::Short, 1, 2); // PhotometricInterpretation (RGB)
+    addEntry(273, TiffFieldType::Long, stripCount, // StripOffsets
+             (stripCount == 1) ? m_stripOffsets.front() : addValues(stripOffsets));
+    addEntry(277, TiffFieldType::Short, 1, 3); // SamplesPerPixel
+    addEntry(278, TiffFieldType::Long, 1, m_rowsPerStrip); // RowsPerStrip
+    addEntry(279, TiffFieldType::Long, stripCount, // StripByteCounts
+             (stripCount == 1) ? m_stripByteCounts.front() : addValues(stripByteCounts));
+    addEntry(282, TiffFieldType::Rational, 1, addValues(resolution)); // XResolution
+    addEntry(283, TiffFieldType::Rational, 1, addValues(resolution)); // YResolution
+    addEntry(284, TiffFieldType::Short, 1, 1); // PlanarConfiguration (chunky)
+    addEntry(296, TiffFieldType::Short, 1, 2); // ResolutionUnit (inches)
+    AppendLittleEndian32(directory, 0); // no more directories
+
+    if (valuesOffset + values.size() > std::numeric_limits<uint32_t>::max() ||
+        !WriteBuffer(directory.data(), directory.size()) ||
+        !WriteBuffer(values.data(), values.size()))
+        { return false; }
+
+    // point the header to the directory
+    if (m_stream.SeekO(4) == wxInvalidOffset)
+        { return false; }
+    std::vector<uint8_t> offset;
+    AppendLittleEndian32(offset, static_cast<uint32_t>(directoryOffset));
+    return WriteBuffer(offset.data(), offset.size());
+    }
@@ -0,0 +1,164 @@
+/** @addtogroup Utilities
+    @brief Utility classes.
+    @date 2005-2022
+    @copyright Blake Madden
+    @author Blake Madden
+    @details This program is free software; you can redistribute it and/or modify
+     it under the terms of the 3-Clause BSD License.
+
+     SPDX-License-Identifier: BSD-3-Clause
+@{*/
+
+#ifndef __STRIP_IMAGE_WRITER_H__
+#define __STRIP_IMAGE_WRITER_H__
+
+#include <wx/image.h>
+#include <wx/stream.h>
+#include <wx/zstream.h>
+#include <cstdint>
+#include <vector>
+
+/** @brief Interface for writing an image to a stream one horizontal strip at a time.
+    @details This is used for exporting very large images, where the entire image
+        would not fit in memory. Only the strip being written (and the encoder's state)
+        needs to be held in memory.
+    @par Example
+    @code
+        wxFileOutputStream output(L"poster.png");
+        PngStripWriter writer(output, wxSize(20000, 15000), 6);
+        for (int top = 0; top < 15000; top += 256)
+            {
+            wxImage strip = RenderRows(top, 256); // client code
+            if (!writer.WriteStrip(strip))
+                { break; }
+            }
+        writer.Finish();
+    @endcode*/
+class StripImageWriter
+    {
+public:
+    /** @brief Constructor.
+        @param stream The stream to write to.
+        @param imageSize The size (in pixels) of the entire image.*/
+    StripImageWriter(wxOutputStream& stream, const wxSize imageSize) :
+        m_stream(stream), m_imageSize(imageSize)
+        {}
+    /// @private
+    StripImageWriter(const StripImageWriter&) = delete;
+    /// @private
+    StripImageWriter& operator=(const StripImageWriter&) = delete;
+    /// @private
+    virtual ~StripImageWriter() = default;
+    /** @brief Writes the next rows of the image.
+        @param strip The rows to write. Must be the same width as the image, and its
+            rows must not go past the image's height. Any alpha channel is ignored.
+        @returns @c true if the rows were written successfully.*/
+    virtual bool WriteStrip(const wxImage& strip) = 0;
+    /** @brief Finishes writing the image.
+        @details This must be called after all rows have been written.
+        @returns @c true if the image was written successfully
+            (and all of its rows were provided).*/
+    virtual bool Finish() = 0;
+    /// @returns The number of rows written so far.
+    [[nodiscard]] int GetRowsWritten() const noexcept
+        { return m_rowsWritten; }
+protected:
+    /// @returns @c true if @c strip can be written as the next rows of the image.
+    [[nodiscard]] bool IsValidStrip(const wxImage& strip) const
+        {
+        return strip.IsOk() && strip.GetWidth() == m_imageSize.GetWidth() &&
+            m_rowsWritten + strip.GetHeight() <= m_imageSize.GetHeight();
+        }
+    /// @brief Writes a buffer to the output stream.
+    /// @returns @c true if the buffer was fully written.
+    bool WriteBuffer(const void* buffer, const size_t size)
+        { return m_stream.Write(buffer, size).LastWrite() == size; }
+    /// @brief Appends a 32-bit big-endian value to a buffer.
+    static void AppendBigEndian32(std::vector<uint8_t>& buffer, const uint32_t value);
+    /// @brief Appends a 16-bit little-endian value to a buffer.
+    static void AppendLittleEndian16(std::vector<uint8_t>& buffer, const uint16_t value);
+    /// @brief Appends a 32-bit little-endian value to a buffer.
+    static void AppendLittleEndian32(std::vector<uint8_t>& buffer, const uint32_t value);
+
+    /// @brief An output stream that collects its data into a buffer.
+    /// @details This is used to capture the output of a @c wxZlibOutputStream.
+    class BufferOutputStream final : public wxOutputStream
+        {
+    public:
+        /// @returns The data written so far.
+        [[nodiscard]] std::vector<uint8_t>& GetBuffer() noexcept
+            { return m_buffer; }
+    protected:
+        size_t OnSysWrite(const void* buffer, size_t size) final
+            {
+            const auto* const bytes = static_cast<const uint8_t*>(buffer);
+            m_buffer.insert(m_buffer.end(), bytes, bytes + size);
+            return size;
+            }
+    private:
+        std::vector<uint8_t> m_buffer;
+        };
+
+    wxOutputStream& m_stream;
+    wxSize m_imageSize;
+    int m_rowsWritten{ 0 };
+    };
+
+/** @brief Writes a (24-bit RGB) PNG file one strip at a time.
+    @details Each strip is compressed into the file's zlib stream and then written
+        as its own @c IDAT chunk, so that memory use stays constant regardless of the image's size.
+    @note Rows are written unfiltered, which compresses flat-colored graphics (e.g., charts) well.*/
+class PngStripWriter final : public StripImageWriter
+    {
+public:
+    /** @brief Constructor.
+        @param stream The stream to write to.
+        @param imageSize The size (in pixels) of the entire image.
+        @param compressionLevel The zlib compression level (@c 0-9).*/
+    PngStripWriter(wxOutputStream& stream, const wxSize imageSize, const int compressionLevel);
+    bool WriteStrip(const wxImage& strip) final;
+    bool Finish() final;
+private:
+    /// @brief Writes a PNG chunk (with its length and CRC).
+    bool WriteChunk(const char* chunkType, const std::vector<uint8_t>& data);
+    /// @brief Writes the compressed data collected so far as an @c IDAT chunk.
+    bool FlushCompressedData();
+
+    BufferOutputStream m_compressedData;
+    wxZlibOutputStream m_zlibStream;
+    bool m_headerWritten{ false };
+    };
+
+/** @brief Writes a (24-bit RGB) TIFF file one strip at a time.
+    @details Each call to WriteStrip() is written as a TIFF strip (either uncompressed
+        or deflate compressed), and the image's directory is written at the end of the file.
+    @note All strips (except for the last one) must have the same height.\n
+        The stream must be seekable (e.g., a file stream), as the directory's offset is
+        written to the file's header after all strips are written.\n
+        Files larger than 4GB (i.e., BigTIFF) are not supported.*/
+class TiffStripWriter final : public StripImageWriter
+    {
+public:
+    /** @brief Constructor.
+        @param stream The stream to write to.
+        @param imageSize The size (in pixels) of the entire image.
+        @param deflate @c true to deflate compress the strips.
+        @param dpi The resolution of the image.*/
+    TiffStripWriter(wxOutputStream& stream, const wxSize imageSize,
+                    const bool deflate, const uint32_t dpi = 72);
+    bool WriteStrip(const wxImage& strip) final;
+    bool Finish() final;
+private:
+    bool m_deflate{ false };
+    uint32_t m_dpi{ 72 };
+    int m_rowsPerStrip{ 0 };
+    bool m_headerWritten{ false };
+    // file offset of where we are writing
+    uint64_t m_offset{ 0 };
+    std::vector<uint32_t> m_stripOffsets;
+    std::vector<uint32_t> m_stripByteCounts;
+    };
+
+/** @}*/
+
+#endif //__STRIP_IMAGE_WRITER_H__
@@ -0,0 +1,590 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        svgoptimizer.cpp
+// Author:      Blake Madden
+// Copyright:   (c) 2005-2022 Blake Madden
+// Licence:     3-Clause BSD licence
+// SPDX-License-Identifier: BSD-3-Clause
+///////////////////////////////////////////////////////////////////////////////
+
+#include "svgoptimizer.h"
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace
+    {
+    /// @returns @c true if a character is XML whitespace.
+    [[nodiscard]] constexpr bool IsSpace(const char chr) noexcept
+        { return chr == ' ' || chr == '\t' || chr == '\n' || chr == '\r'; }
+
+    /// @returns @c true if a string is only whitespace.
+    [[nodiscard]] bool IsWhitespace(const std::string& text) noexcept
+        { return std::all_of(text.cbegin(), text.cend(), IsSpace); }
+
+    /// @returns A string with leading and trailing whitespace removed.
+    [[nodiscard]] std::string Trim(const std::string& text)
+        {
+        const auto first = std::find_if_not(text.cbegin(), text.cend(), IsSpace);
+        const auto last = std::find_if_not(text.crbegin(), text.crend(), IsSpace).base();
+        return (first < last) ? std::string(first, last) : std::string{};
+        }
+
+    /// @returns The numbers in a list (e.g., a polygon's points),
+    ///     or an empty vector if anything else is in it.
+    [[nodiscard]] std::vector<double> ParseNumbers(const std::string& text)
+        {
+        std::vector<double> numbers;
+        const char* current = text.c_str();
+        for (;;)
+            {
+            while (IsSpace(*current) || *current == ',')
+                { ++current; }
+            if (*current == 0)
+                { break; }
+            char* end{ nullptr };
+            const double value = std::strtod(current, &end);
+            if (end == current)
+                { return std::vector<double>{}; }
+            numbers.push_back(value);
+            current = end;
+            }
+        return numbers;
+        }
+
+    /// @returns A number formatted compactly (with at most three decimal places).
+    [[nodiscard]] std::string FormatNumber(const double value)
+        {
+        char buffer[64]{ 0 };
+        std::snprintf(buffer, sizeof(buffer), "%.3f", value);
+        std::string formatted{ buffer };
+        formatted.erase(formatted.find_last_not_of('0') + 1);
+        if (!formatted.empty() && formatted.back() == '.')
+            { formatted.pop_back(); }
+        return (formatted == "-0") ? std::string{ "0" } : formatted;
+        }
+
+    /// @returns The CSS declarations (property and value) in a @c style attribute.
+    [[nodiscard]] std::vector<std::pair<std::string, std::string>>
+        ParseDeclarations(const std::string& style)
+        {
+        std::vector<std::pair<std::string, std::string>> declarations;
+        size_t start{ 0 };
+        while (start < style.length())
+            {
+            size_t end = style.find(';', start);
+            if (end == std::string::npos)
+                { end = style.length(); }
+            const std::string declaration = style.substr(start, end - start);
+            const auto colon = declaration.find(':');
+            if (colon != std::string::npos)
+                {
+                declarations.emplace_back(Trim(declaration.substr(0, colon)),
+                                          Trim(declaration.substr(colon + 1)));
+                }
+            start = end + 1;
+            }
+        return declarations;
+        }
+
+    /// @returns An XML attribute value with its entities replaced.
+    [[nodiscard]] std::string Unescape(const std::string& value)
+        {
+        if (value.find('&') == std::string::npos)
+            { return value; }
+        constexpr std::pair<const char*, char> entities[] =
+            {
+                { "&quot;", '"' }, { "&apos;", '\'' }, { "&lt;", '<' },
+                { "&gt;", '>' }, { "&amp;", '&' }
+            };
+        std::string unescaped;
+        unescaped.reserve(value.length());
+        for (size_t i = 0; i < value.length(); ++i)
+            {
+            bool replaced{ false };
+            if (value[i] == '&')
+                {
+                for (const auto& [entity, chr] : entities)
+                    {
+                    if (value.compare(i, std::strlen(entity), entity) == 0)
+                        {
+                        unescaped += chr;
+                        i += std::strlen(entity) - 1;
+                        replaced = true;
+                        break;
+                        }
+                    }
+                }
+            if (!replaced)
+                { unescaped += value[i]; }
+            }
+        return unescaped;
+        }
+    }
+
+//----------------------------------------------------------------
+const std::string* SvgOptimizer::Tag::FindAttribute(const std::string& name) const
+    {
+    const auto attribute = std::find_if(m_attributes.cbegin(), m_attributes.cend(),
+        [&name](const auto& attrib) { return attrib.first == name; });
+    return (attribute != m_attributes.cend()) ? &attribute->second : nullptr;
+    }
+
+//----------------------------------------------------------------
+std::string SvgOptimizer::Tag::TakeAttribute(const std::string& name)
+    {
+    const auto attribute = std::find_if(m_attributes.begin(), m_attributes.end(),
+        [&name](const auto& attrib) { return attrib.first == name; });
+    if (attribute == m_attributes.end())
+        { return std::string{}; }
+    std::string value = std::move(attribute->second);
+    m_attributes.erase(attribute);
+    return value;
+    }
+
+//----------------------------------------------------------------
+std::string SvgOptimizer::Tag::ToString() const
+    {
+    std::string markup{ "<" + m_name };
+    for (const auto& [name, value] : m_attributes)
+        {
+        // use whichever quote the (escaped) value doesn't contain
+        const char quote = (value.find('"') == std::string::npos) ? '"' : '\'';
+        markup.append(" ").append(name).append("=").append(1, quote).
+            append(value).append(1, quote);
+        }
+    markup.append(m_isEmpty ? "/>" : ">");
+    return markup;
+    }
+
+//----------------------------------------------------------------
+bool SvgOptimizer::ReadToken(std::istream& input, std::string& token)
+    {
+    token.clear();
+    auto* buffer = input.rdbuf();
+    int chr = buffer->sgetc();
+    if (chr == std::char_traits<char>::eof())
+        { return false; }
+
+    // text, up to the next tag
+    if (chr != '<')
+        {
+        while (chr != std::char_traits<char>::eof() && chr != '<')
+            {
+            token += static_cast<char>(chr);
+            chr = buffer->snextc();
+            }
+        return true;
+        }
+
+    // a tag, comment, or CDATA section
+    const auto endsWith = [&token](const char* ending)
+        {
+        const size_t length = std::strlen(ending);
+        return token.length() >= length &&
+            token.compare(token.length() - length, length, ending) == 0;
+        };
+    char quote{ 0 };
+    while (chr != std::char_traits<char>::eof())
+        {
+        token += static_cast<char>(chr);
+        buffer->sbumpc();
+        if (token.compare(0, 4, "<!--") == 0)
+            {
+            if (token.length() >= 7 && endsWith("-->"))
+                { break; }
+            }
+        else if (token.compare(0, 9, "<![CDATA[") == 0)
+            {
+            if (token.length() >= 12 && endsWith("]]>"))
+                { break; }
+            }
+        else if (quote != 0)
+            {
+            if (chr == quote)
+                { quote = 0; }
+            }
+        else if ((chr == '"' || chr == '\'') && token.find('=') != std::string::npos)
+            { quote = static_cast<char>(chr); }
+        else if (chr == '>')
+            { break; }
+        chr = buffer->sgetc();
+        }
+    return true;
+    }
+
+//----------------------------------------------------------------
+bool SvgOptimizer::ParseTag(const std::string& token, Tag& tag)
+    {
+    tag = Tag{};
+    if (token.length() < 3 || token.front() != '<' || token.back() != '>' ||
+        !std::isalpha(static_cast<unsigned char>(token[1])))
+        { return false; }
+    tag.m_isEmpty = (token[token.length() - 2] == '/');
+    const size_t end = token.length() - (tag.m_isEmpty ? 2 : 1);
+
+    size_t position{ 1 };
+    while (position < end && !IsSpace(token[position]) && token[position] != '/')
+        { ++position; }
+    tag.m_name = token.substr(1, position - 1);
+
+    for (;;)
+        {
+        while (position < end && IsSpace(token[position]))
+            { ++position; }
+        if (position >= end)
+            { break; }
+        const size_t nameStart = position;
+        while (position < end && token[position] != '=' && !IsSpace(token[position]))
+            { ++position; }
+        std::string name = token.substr(nameStart, position - nameStart);
+        while (position < end && IsSpace(token[position]))
+            { ++position; }
+        if (position >= end || token[position] != '=')
+            { return false; }
+        ++position;
+        while (position < end && IsSpace(token[position]))
+            { ++position; }
+        if (position >= end || (token[position] != '"' && token[position] != '\''))
+            { return false; }
+        const char quote = token[position++];
+        const size_t valueEnd = token.find(quote, position);
+        if (valueEnd == std::string::npos || valueEnd >= end)
+            { return false; }
+        tag.m_attributes.emplace_back(std::move(name),
+                                      token.substr(position, valueEnd - position));
+        position = valueEnd + 1;
+        }
+    return true;
+    }
+
+//----------------------------------------------------------------
+bool SvgOptimizer::SplitShape(const Tag& tag, Tag& definition,
+                              std::pair<std::string, std::string>& position)
+    {
+    // shapes with IDs may be referenced elsewhere, and transformed shapes would
+    // need their transforms applied to the position
+    if (!tag.m_isEmpty || tag.FindAttribute("id") != nullptr ||
+        tag.FindAttribute("transform") != nullptr)
+        { return false; }
+
+    definition = tag;
+    const auto splitPosition = [&definition, &position](const char* xName, const char* yName)
+        {
+        const auto* x = definition.FindAttribute(xName);
+        const auto* y = definition.FindAttribute(yName);
+        if (x == nullptr || y == nullptr ||
+            ParseNumbers(*x).size() != 1 || ParseNumbers(*y).size() != 1)
+            { return false; }
+        position = std::make_pair(Trim(*x), Trim(*y));
+        definition.TakeAttribute(xName);
+        definition.TakeAttribute(yName);
+        // keep the attributes in the same order, so that equivalent shapes match
+        std::sort(definition.m_attributes.begin(), definition.m_attributes.end());
+        definition.m_attributes.insert(definition.m_attributes.begin(),
+                                       { { xName, "0" }, { yName, "0" } });
+        return true;
+        };
+
+    if (tag.m_name == "ellipse" || tag.m_name == "circle")
+        { return splitPosition("cx", "cy"); }
+    else if (tag.m_name == "rect")
+        { return splitPosition("x", "y"); }
+    else if (tag.m_name == "polygon" || tag.m_name == "polyline")
+        {
+        const auto* points = tag.FindAttribute("points");
+        if (points == nullptr)
+            { return false; }
+        const auto coordinates = ParseNumbers(*points);
+        if (coordinates.size() < 4 || coordinates.size() % 2 != 0)
+            { return false; }
+        // draw the points relative to the first one
+        std::string relativePoints;
+        for (size_t i = 0; i < coordinates.size(); i += 2)
+            {
+            if (!relativePoints.empty())
+                { relativePoints += ' '; }
+            relativePoints.append(FormatNumber(coordinates[i] - coordinates[0])).append(",").
+                append(FormatNumber(coordinates[i + 1] - coordinates[1]));
+            }
+        position = std::make_pair(FormatNumber(coordinates[0]), FormatNumber(coordinates[1]));
+        definition.TakeAttribute("points");
+        std::sort(definition.m_attributes.begin(), definition.m_attributes.end());
+        definition.m_attributes.insert(definition.m_attributes.begin(),
+                                       { "points", relativePoints });
+        return true;
+        }
+    return false;
+    }
+
+//----------------------------------------------------------------
+SvgOptimizer::GroupState SvgOptimizer::GetGroupState(const Tag& tag, const GroupState& parent)
+    {
+    GroupState state{ parent };
+    const auto applyProperty = [&state](const std::string& name, const std::string& value)
+        {
+        if (name == "fill")
+            { state.m_isFillNone = (value == "none"); }
+        else if (name == "opacity" || name == "fill-opacity" || name == "stroke-opacity")
+            {
+            const auto opacity = ParseNumbers(value);
+            if (opacity.size() == 1 && opacity.front() < 1)
+                { state.m_isTranslucent = true; }
+            }
+        };
+    for (const auto& [name, value] : tag.m_attributes)
+        {
+        if (name == "style")
+            {
+            for (const auto& [property, propertyValue] : ParseDeclarations(Unescape(value)))
+                { applyProperty(property, propertyValue); }
+            }
+        else
+            { applyProperty(name, Trim(value)); }
+        }
+    return state;
+    }
+
+//----------------------------------------------------------------
+bool SvgOptimizer::IsMergeablePath(const Tag& tag, const GroupState& parent)
+    {
+    const auto* pathData = tag.FindAttribute("d");
+    if (!tag.m_isEmpty || pathData == nullptr || tag.FindAttribute("id") != nullptr)
+        { return false; }
+    // overlapping translucent lines are darker where they cross, which a single path isn't
+    const GroupState state = GetGroupState(tag, parent);
+    if (state.m_isTranslucent)
+        { return false; }
+
+    // must be a single, open subpath that starts at an absolute position
+    const std::string data = Trim(*pathData);
+    if (data.empty() || data.front() != 'M' ||
+        data.find_first_of("Mm", 1) != std::string::npos ||
+        data.find_first_of("Zz") != std::string::npos)
+        { return false; }
+    if (state.m_isFillNone)
+        { return true; }
+    // if filled, then only straight lines are safe (as they have no area to fill)
+    const auto command = data.find_first_not_of("0123456789.,-+eE \t\r\n", 1);
+    if (command == std::string::npos ||
+        data.find_first_not_of("0123456789.,-+eE \t\r\n", command + 1) != std::string::npos)
+        { return false; }
+    const auto arguments = ParseNumbers(data.substr(command + 1)).size();
+    switch (data[command])
+        {
+    case 'L':
+        [[fallthrough]];
+    case 'l':
+        return arguments == 2;
+    case 'H':
+        [[fallthrough]];
+    case 'h':
+        [[fallthrough]];
+    case 'V':
+        [[fallthrough]];
+    case 'v':
+        return arguments == 1;
+    default:
+        return false;
+        }
+    }
+
+//----------------------------------------------------------------
+std::string SvgOptimizer::StyleToCss(const std::string& style)
+    {
+    std::string css = Trim(Unescape(style));
+    // these would break out of the style sheet
+    if (css.find("]]>") != std::string::npos || css.find_first_of("{}<") != std::string::npos)
+        { return std::string{}; }
+    return css;
+    }
+
+//----------------------------------------------------------------
+void SvgOptimizer::ApplyStyleClass(Tag& tag) const
+    {
+    const auto* style = tag.FindAttribute("style");
+    if (style == nullptr)
+        { return; }
+    const auto styleClass = m_styleClasses.find(*style);
+    if (styleClass == m_styleClasses.cend())
+        { return; }
+    const std::string className = "s" + std::to_string(styleClass->second);
+    tag.TakeAttribute("style");
+    const auto existingClass = std::find_if(tag.m_attributes.begin(), tag.m_attributes.end(),
+        [](const auto& attrib) { return attrib.first == "class"; });
+    if (existingClass != tag.m_attributes.end())
+        { existingClass->second.append(" ").append(className); }
+    else
+        { tag.m_attributes.emplace_back("class", className); }
+    }
+
+//----------------------------------------------------------------
+void SvgOptimizer::WriteDefinitions(std::ostream& output) const
+    {
+    if (m_styleOrder.empty() && m_sharedShapes.empty())
+        { return; }
+    output << "\n<defs>\n";
+    if (!m_styleOrder.empty())
+        {
+        output << "<style type=\"text/css\"><![CDATA[\n";
+        for (size_t i = 0; i < m_styleOrder.size(); ++i)
+            { output << ".s" << i << "{" << StyleToCss(m_styleOrder[i]) << "}\n"; }
+        output << "]]></style>\n";
+        }
+    for (const auto* shape : m_sharedShapes)
+        {
+        Tag definition{ shape->m_definition };
+        ApplyStyleClass(definition);
+        definition.m_attributes.insert(definition.m_attributes.begin(),
+                                       { "id", "p" + std::to_string(shape->m_id) });
+        output << definition.ToString() << "\n";
+        }
+    output << "</defs>\n";
+    }
+
+//----------------------------------------------------------------
+void SvgOptimizer::FlushPendingPath(std::ostream& output)
+    {
+    if (m_pendingPath.m_lineCount == 0)
+        { return; }
+    Tag path{ m_pendingPath.m_tag };
+    path.m_attributes.insert(path.m_attributes.begin(), { "d", m_pendingPath.m_pathData });
+    output << path.ToString() << "\n";
+    m_pendingPath = PendingPath{};
+    }
+
+//----------------------------------------------------------------
+bool SvgOptimizer::Optimize(std::istream& input, std::ostream& output)
+    {
+    m_styleClasses.clear();
+    m_styleOrder.clear();
+    m_shapes.clear();
+    m_sharedShapes.clear();
+    m_groupStates.clear();
+    m_pendingPath = PendingPath{};
+
+    const auto start = input.tellg();
+    if (!input.good() || start == std::istream::pos_type(-1))
+        { return false; }
+
+    // first pass, count the styles and shapes
+    std::map<std::string, size_t> styleCounts;
+    std::vector<std::string> stylesInOrder;
+    std::string token;
+    Tag tag;
+    Tag definition;
+    std::pair<std::string, std::string> position;
+    while (ReadToken(input, token))
+        {
+        if (!ParseTag(token, tag))
+            { continue; }
+        if (const auto* style = tag.FindAttribute("style");
+            style != nullptr && !StyleToCss(*style).empty())
+            {
+            if (++styleCounts[*style] == 2)
+                { stylesInOrder.push_back(*style); }
+            }
+        if (SplitShape(tag, definition, position))
+            {
+            auto& shape = m_shapes[definition.ToString()];
+            if (shape.m_count++ == 0)
+                { shape.m_definition = std::move(definition); }
+            }
+        }
+    for (auto& style : stylesInOrder)
+        {
+        m_styleClasses.emplace(style, m_styleOrder.size());
+        m_styleOrder.push_back(std::move(style));
+        }
+    // only the reused shapes are needed for the second pass, so free the rest
+    for (auto shapePos = m_shapes.begin(); shapePos != m_shapes.end(); /* in loop*/)
+        {
+        if (shapePos->second.m_count >= m_minimumShapeReuseCount)
+            {
+            shapePos->second.m_id = m_sharedShapes.size();
+            m_sharedShapes.push_back(&shapePos->second);
+            ++shapePos;
+            }
+        else
+            { shapePos = m_shapes.erase(shapePos); }
+        }
+
+    // second pass, write the compacted file
+    input.clear();
+    input.seekg(start);
+    if (!input.good())
+        { return false; }
+    bool definitionsWritten{ false };
+    while (ReadToken(input, token))
+        {
+        // whitespace between merged paths is dropped
+        if (m_pendingPath.m_lineCount > 0 && IsWhitespace(token))
+            { continue; }
+
+        if (!ParseTag(token, tag))
+            {
+            FlushPendingPath(output);
+            if (token.compare(0, 3, "</g") == 0 && !m_groupStates.empty())
+                { m_groupStates.pop_back(); }
+            output << token;
+            continue;
+            }
+
+        const GroupState parentState =
+            m_groupStates.empty() ? GroupState{} : m_groupStates.back();
+        if (tag.m_name == "path" && IsMergeablePath(tag, parentState))
+            {
+            std::string pathData = Trim(tag.TakeAttribute("d"));
+            ApplyStyleClass(tag);
+            if (m_pendingPath.m_lineCount > 0 &&
+                (m_pendingPath.m_tag.m_attributes != tag.m_attributes ||
+                 m_pendingPath.m_lineCount >= m_maximumMergedLineCount))
+                { FlushPendingPath(output); }
+            if (m_pendingPath.m_lineCount == 0)
+                { m_pendingPath.m_tag = std::move(tag); }
+            else
+                { m_pendingPath.m_pathData += ' '; }
+            m_pendingPath.m_pathData += pathData;
+            ++m_pendingPath.m_lineCount;
+            continue;
+            }
+        FlushPendingPath(output);
+
+        if (tag.m_name == "g" && !tag.m_isEmpty)
+            { m_groupStates.push_back(GetGroupState(tag, parentState)); }
+
+        if (SplitShape(tag, definition, position))
+            {
+            const auto shape = m_shapes.find(definition.ToString());
+            if (shape != m_shapes.cend() && shape->second.m_count >= m_minimumShapeReuseCount)
+                {
+                output << "<use xlink:href=\"#p" << shape->second.m_id << "\" x=\"" <<
+                    position.first << "\" y=\"" << position.second << "\"/>";
+                continue;
+                }
+            }
+
+        if (tag.m_name == "svg" && !definitionsWritten)
+            {
+            // <use> elements need the XLink namespace
+            if (tag.FindAttribute("xmlns:xlink") == nullptr)
+                { tag.m_attributes.emplace_back("xmlns:xlink", "http://www.w3.org/1999/xlink"); }
+            output << tag.ToString();
+            WriteDefinitions(output);
+            definitionsWritten = true;
+            continue;
+            }
+
+        if (tag.FindAttribute("style") != nullptr)
+            {
+            ApplyStyleClass(tag);
+            output << tag.ToString();
+            }
+        // leave everything else exactly as it was
+        else
+            { output << token; }
+        }
+    FlushPendingPath(output);
+    output.flush();
+    return definitionsWritten && output.good();
+    }
@@ -0,0 +1,158 @@
+/** @addtogroup Utilities
+    @brief Utility classes.
+    @date 2005-2022
+    @copyright Blake Madden
+    @author Blake Madden
+    @details This program is free software; you can redistribute it and/or modify
+     it under the terms of the 3-Clause BSD License.
+
+     SPDX-License-Identifier: BSD-3-Clause
+@{*/
+
+#ifndef __SVG_OPTIMIZER_H__
+#define __SVG_OPTIMIZER_H__
+
+#include <algorithm>
+#include <cstddef>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/** @brief Compacts an SVG file (e.g., one written by @c wxSVGFileDC) as it is copied
+        from one stream to another.
+    @details SVG writers that draw one primitive at a time repeat a lot of markup.
+        This makes two (streaming) passes over the file and:
+        - Moves @c style attributes that are used more than once into shared CSS classes.
+        - Moves shapes (ellipses, circles, rectangles, and polygons) that are drawn more than
+          once at different positions (e.g., the points in a scatter plot) into @c <defs>,
+          and replaces them with @c <use> elements.
+        - Merges runs of adjacent line paths with the same styling into single paths
+          (e.g., grid lines), as long as they aren't translucent (where overlapping lines
+          would look different).
+
+        The file is read and written a token at a time (other than the paths being merged),
+        but the first pass keeps every distinct style and shape that it sees, including
+        the ones that are only drawn once (e.g., bars of different heights), until the
+        reused ones are known. So peak memory use grows with the number of distinct
+        styles and shapes, which can approach the number of shapes in the file.
+        Only the reused shapes are kept for the second pass.
+    @note The input stream must be seekable, as it is read twice.
+    @par Example
+    @code
+        std::ifstream input("chart-raw.svg", std::ios::binary);
+        std::ofstream output("chart.svg", std::ios::binary);
+        SvgOptimizer optimizer;
+        if (!optimizer.Optimize(input, output))
+            { // handle error
+            }
+    @endcode*/
+class SvgOptimizer
+    {
+public:
+    /** @brief Copies an SVG file from one stream to another, compacting it along the way.
+        @param input The SVG file to read.
+        @param output The stream to write the compacted file to.
+        @returns @c true if the file was written. If @c false, then @c output may contain a
+            partially written file.*/
+    bool Optimize(std::istream& input, std::ostream& output);
+    /// @brief Sets how many times a shape must be drawn before it is moved into @c <defs>.
+    /// @param count The minimum number of times. The default is @c 2.
+    void SetMinimumShapeReuseCount(const size_t count) noexcept
+        { m_minimumShapeReuseCount = std::max<size_t>(count, 2); }
+    /// @brief Sets the maximum number of lines to merge into one path.
+    /// @param count The maximum number of lines. The default is @c 1,000.
+    void SetMaximumMergedLineCount(const size_t count) noexcept
+        { m_maximumMergedLineCount = std::max<size_t>(count, 1); }
+private:
+    /// @brief An attribute's name and (still escaped) value.
+    using Attribute = std::pair<std::string, std::string>;
+
+    /// @brief A parsed start (or empty) tag.
+    struct Tag
+        {
+        std::string m_name;
+        std::vector<Attribute> m_attributes;
+        bool m_isEmpty{ false };
+        /// @returns The value of an attribute, or null if not found.
+        [[nodiscard]] const std::string* FindAttribute(const std::string& name) const;
+        /// @brief Removes an attribute.
+        /// @returns The attribute's value (or an empty string if not found).
+        std::string TakeAttribute(const std::string& name);
+        /// @returns The tag as markup.
+        [[nodiscard]] std::string ToString() const;
+        };
+
+    /// @brief A shape moved into @c <defs>, drawn from its own origin.
+    struct Shape
+        {
+        /// @brief The shape (positioned at the origin) for the @c <defs> section.
+        Tag m_definition;
+        size_t m_count{ 0 };
+        size_t m_id{ 0 };
+        };
+
+    /// @brief The inherited state of a group.
+    struct GroupState
+        {
+        bool m_isTranslucent{ false };
+        bool m_isFillNone{ false };
+        };
+
+    /// @brief A run of lines being merged into one path.
+    struct PendingPath
+        {
+        Tag m_tag;
+        std::string m_pathData;
+        size_t m_lineCount{ 0 };
+        };
+
+    /** @brief Reads the next tag, text run, or comment.
+        @param input The stream to read from.
+        @param[out] token The token that was read.
+        @returns @c false when there is nothing left to read.*/
+    [[nodiscard]] static bool ReadToken(std::istream& input, std::string& token);
+    /// @brief Parses a start (or empty) tag's name and attributes.
+    /// @returns @c false if the token isn't a start tag.
+    [[nodiscard]] static bool ParseTag(const std::string& token, Tag& tag);
+    /** @brief Splits a shape into its position and its origin-relative definition.
+        @param tag The shape.
+        @param[out] definition The shape, positioned at the origin.
+        @param[out] position The shape's position.
+        @returns @c false if the tag isn't a shape that can be reused.*/
+    [[nodiscard]] static bool SplitShape(const Tag& tag, Tag& definition,
+                                         std::pair<std::string, std::string>& position);
+    /// @returns The state of a group, inheriting from its parent.
+    [[nodiscard]] static GroupState GetGroupState(const Tag& tag, const GroupState& parent);
+    /// @returns @c true if a path can be merged with others (given the styling it inherits).
+    [[nodiscard]] static bool IsMergeablePath(const Tag& tag, const GroupState& parent);
+    /// @returns The CSS declarations for a @c style attribute,
+    ///     or an empty string if they can't be moved into a style sheet.
+    [[nodiscard]] static std::string StyleToCss(const std::string& style);
+
+    /// @brief Replaces a tag's @c style with its shared class (if it has one).
+    void ApplyStyleClass(Tag& tag) const;
+    /// @brief Writes the @c <defs> section (style sheet and shared shapes).
+    void WriteDefinitions(std::ostream& output) const;
+    /// @brief Writes (and clears) the path being merged.
+    void FlushPendingPath(std::ostream& output);
+
+    size_t m_minimumShapeReuseCount{ 2 };
+    size_t m_maximumMergedLineCount{ 1'000 };
+
+    // styles used by more than one element, mapped to their class IDs
+    std::map<std::string, size_t> m_styleClasses;
+    std::vector<std::string> m_styleOrder;
+    // shapes, keyed by their origin-relative markup
+    // (all of them during the first pass, only the reused ones afterwards)
+    std::map<std::string, Shape> m_shapes;
+    std::vector<const Shape*> m_sharedShapes;
+    std::vector<GroupState> m_groupStates;
+    PendingPath m_pendingPath;
+    };
+
+/** @}*/
+
+#endif //__SVG_OPTIMIZER_H__
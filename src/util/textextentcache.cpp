@@ -0,0 +1,164 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        textextentcache.cpp
+// Author:      Blake Madden
+// Copyright:   (c) 2005-2022 Blake Madden
+// Licence:     3-Clause BSD licence
+// SPDX-License-Identifier: BSD-3-Clause
+///////////////////////////////////////////////////////////////////////////////
+
+#include "textextentcache.h"
+#include <algorithm>
+
+//----------------------------------------------------------------
+wxSize TextExtentCache::GetTextExtent(wxDC& dc, const wxString& text)
+    {
+    auto key = MakeKey(dc, text, false);
+    if (Measurement measurement; Find(key, measurement))
+        { return measurement.m_size; }
+
+    Measurement measurement;
+    dc.GetTextExtent(text, &measurement.m_size.x, &measurement.m_size.y);
+    Add(std::move(key), measurement);
+    return measurement.m_size;
+    }
+
+//----------------------------------------------------------------
+void TextExtentCache::GetMultiLineTextExtent(wxDC& dc, const wxString& text,
+                                             wxCoord* width, wxCoord* height,
+                                             wxCoord* heightLine /*= nullptr*/)
+    {
+    auto key = MakeKey(dc, text, true);
+    Measurement measurement;
+    if (!Find(key, measurement))
+        {
+        dc.GetMultiLineTextExtent(text, &measurement.m_size.x, &measurement.m_size.y,
+                                  &measurement.m_lineHeight);
+        Add(std::move(key), measurement);
+        }
+    if (width != nullptr)
+        { *width = measurement.m_size.GetWidth(); }
+    if (height != nullptr)
+        { *height = measurement.m_size.GetHeight(); }
+    if (heightLine != nullptr)
+        { *heightLine = measurement.m_lineHeight; }
+    }
+
+//----------------------------------------------------------------
+TextExtentCache::MeasurementKey TextExtentCache::MakeKey(wxDC& dc, const wxString& text,
+                                                         const bool multiLine)
+    {
+    MeasurementKey key;
+    key.m_text = text;
+    key.m_multiLine = multiLine;
+    const wxFont& font = dc.GetFont();
+    if (font.IsOk())
+        {
+        key.m_faceName = font.GetFaceName();
+        key.m_pointSize = font.GetFractionalPointSize();
+        key.m_weight = font.GetNumericWeight();
+        key.m_style = font.GetStyle();
+        key.m_family = font.GetFamily();
+        }
+    key.m_ppi = dc.GetPPI();
+    key.m_contentScaleFactor = dc.GetContentScaleFactor();
+    dc.GetUserScale(&key.m_userScaleX, &key.m_userScaleY);
+    dc.GetLogicalScale(&key.m_logicalScaleX, &key.m_logicalScaleY);
+    if (const auto context = dc.GetGraphicsContext(); context != nullptr)
+        { key.m_renderer = context->GetRenderer(); }
+    return key;
+    }
+
+//----------------------------------------------------------------
+bool TextExtentCache::Find(const MeasurementKey& key, Measurement& measurement)
+    {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto foundPos = m_lookup.find(key);
+    if (foundPos == m_lookup.cend())
+        {
+        m_missCount.fetch_add(1, std::memory_order_relaxed);
+        ++m_threadMissCount;
+        return false;
+        }
+    m_hitCount.fetch_add(1, std::memory_order_relaxed);
+    ++m_threadHitCount;
+    // move to the front, as it is now the most recently used
+    m_measurements.splice(m_measurements.begin(), m_measurements, foundPos->second);
+    measurement = foundPos->second->second;
+    return true;
+    }
+
+//----------------------------------------------------------------
+void TextExtentCache::Add(MeasurementKey&& key, const Measurement& measurement)
+    {
+    auto& registration = GetBudgetRegistration();
+        {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_maxEntries == 0)
+            { return; }
+        // another thread may have measured this in the meantime
+        if (m_lookup.find(key) != m_lookup.cend())
+            { return; }
+        m_bytes += GetEntryBytes(key);
+        m_measurements.emplace_front(std::move(key), measurement);
+        m_lookup.insert(std::make_pair(m_measurements.front().first, m_measurements.begin()));
+        while (m_measurements.size() > m_maxEntries)
+            { RemoveOldest(); }
+        registration.SetBytes(m_bytes);
+        registration.Touch();
+        }
+    // the budget may evict from this cache, so it can't be locked here
+    MemoryBudget::Enforce();
+    }
+
+//----------------------------------------------------------------
+void TextExtentCache::RemoveOldest()
+    {
+    m_bytes -= std::min(m_bytes, GetEntryBytes(m_measurements.back().first));
+    m_lookup.erase(m_measurements.back().first);
+    m_measurements.pop_back();
+    }
+
+//----------------------------------------------------------------
+MemoryBudget::Registration& TextExtentCache::GetBudgetRegistration()
+    {
+    static MemoryBudget::Registration registration =
+        MemoryBudget::Register(L"Text measurements",
+            [](const size_t bytesToFree)
+            {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            const size_t targetBytes = (m_bytes > bytesToFree) ? m_bytes - bytesToFree : 0;
+            while (!m_measurements.empty() && m_bytes > targetBytes)
+                { RemoveOldest(); }
+            GetBudgetRegistration().SetBytes(m_bytes);
+            });
+    return registration;
+    }
+
+//----------------------------------------------------------------
+void TextExtentCache::SetMaxEntries(const size_t maxEntries)
+    {
+    auto& registration = GetBudgetRegistration();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_maxEntries = maxEntries;
+    while (m_measurements.size() > m_maxEntries)
+        { RemoveOldest(); }
+    registration.SetBytes(m_bytes);
+    }
+
+//----------------------------------------------------------------
+size_t TextExtentCache::GetMaxEntries()
+    {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_maxEntries;
+    }
+
+//----------------------------------------------------------------
+void TextExtentCache::Clear()
+    {
+    auto& registration = GetBudgetRegistration();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_measurements.clear();
+    m_lookup.clear();
+    m_bytes = 0;
+    registration.SetBytes(m_bytes);
+    }
@@ -0,0 +1,226 @@
+/** @addtogroup Utilities
+    @brief Utility classes.
+    @date 2005-2022
+    @copyright Blake Madden
+    @author Blake Madden
+    @details This program is free software; you can redistribute it and/or modify
+     it under the terms of the 3-Clause BSD License.
+
+     SPDX-License-Identifier: BSD-3-Clause
+@{*/
+
+#ifndef __TEXT_EXTENT_CACHE_H__
+#define __TEXT_EXTENT_CACHE_H__
+
+#include <wx/dc.h>
+#include <wx/font.h>
+#include <wx/graphics.h>
+#include "memorybudget.h"
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+
+/** @brief Process-wide cache of text measurements.
+    @details Measuring text through the native font APIs is expensive, and layouts
+        (e.g., tables and Likert charts with hundreds of labels) measure the same strings
+        with the same fonts over and over again. This cache remembers the extents of strings,
+        keyed on the text, the DC's font (face, size, weight, and style), and how the
+        DC measures (its DPI, scaling, and renderer).
+
+        The cache is bounded; when it is full, the least recently used measurement is discarded.
+        It is also registered with the MemoryBudget, which can discard the least recently
+        used measurements when the program's caches are over budget.
+    @note This is thread safe, so layouts being calculated on worker threads can share it.
+    @par Example
+    @code
+        // same as dc.GetTextExtent(L"Sales (in millions)"), but cached
+        const wxSize sz = TextExtentCache::GetTextExtent(dc, L"Sales (in millions)");
+    @endcode*/
+class TextExtentCache
+    {
+public:
+    /// @private
+    TextExtentCache() = delete;
+    /** @brief Measures a single line of text with the DC's current font.
+        @param dc The DC to measure with.
+        @param text The text to measure.
+        @returns The size of the text.*/
+    [[nodiscard]] static wxSize GetTextExtent(wxDC& dc, const wxString& text);
+    /** @brief Measures a single line of text with the DC's current font.
+        @param dc The DC to measure with.
+        @param text The text to measure.
+        @param[out] width The width of the text.
+        @param[out] height The height of the text.*/
+    static void GetTextExtent(wxDC& dc, const wxString& text, wxCoord* width, wxCoord* height)
+        {
+        const wxSize sz = GetTextExtent(dc, text);
+        if (width != nullptr)
+            { *width = sz.GetWidth(); }
+        if (height != nullptr)
+            { *height = sz.GetHeight(); }
+        }
+    /** @brief Measures (possibly) multiline text with the DC's current font.
+        @param dc The DC to measure with.
+        @param text The text to measure.
+        @returns The size of the text.*/
+    [[nodiscard]] static wxSize GetMultiLineTextExtent(wxDC& dc, const wxString& text)
+        {
+        wxSize sz;
+        GetMultiLineTextExtent(dc, text, &sz.x, &sz.y);
+        return sz;
+        }
+    /** @brief Measures (possibly) multiline text with the DC's current font.
+        @param dc The DC to measure with.
+        @param text The text to measure.
+        @param[out] width The width of the text.
+        @param[out] height The height of the text.
+        @param[out] heightLine The height of a single line of text.*/
+    static void GetMultiLineTextExtent(wxDC& dc, const wxString& text,
+                                       wxCoord* width, wxCoord* height,
+                                       wxCoord* heightLine = nullptr);
+
+    /** @brief Sets the maximum number of measurements to remember.
+        @param maxEntries The number of measurements.
+            Setting this to @c 0 disables the cache.*/
+    static void SetMaxEntries(const size_t maxEntries);
+    /// @returns The maximum number of measurements to remember.
+    [[nodiscard]] static size_t GetMaxEntries();
+    /// @brief Removes all measurements from the cache.
+    static void Clear();
+    /// @returns The (approximate) number of bytes that the cache is using.
+    [[nodiscard]] static size_t GetMemoryUsage()
+        {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_bytes;
+        }
+
+    /** @returns The number of measurements that were found in the cache
+            since the program started.
+        @note This is a running total (it is not reset by Clear()), so callers wanting
+            the number of hits for a particular operation should subtract
+            the value read before the operation from the value read after it.*/
+    [[nodiscard]] static uint64_t GetHitCount() noexcept
+        { return m_hitCount.load(std::memory_order_relaxed); }
+    /** @returns The number of measurements that were not found in the cache
+            (i.e., text that had to be measured by the DC) since the program started.
+        @note Like GetHitCount(), this is a running total.*/
+    [[nodiscard]] static uint64_t GetMissCount() noexcept
+        { return m_missCount.load(std::memory_order_relaxed); }
+    /** @returns The number of measurements that the calling thread found in the cache.
+        @note Like GetHitCount(), this is a running total. Because other threads' measurements
+            aren't included, this is what should be used to count the hits for an operation
+            (e.g., laying out a canvas) while other threads may be measuring text.*/
+    [[nodiscard]] static uint64_t GetThreadHitCount() noexcept
+        { return m_threadHitCount; }
+    /// @returns The number of measurements that the calling thread didn't find in the cache.
+    /// @note Like GetThreadHitCount(), this only counts the calling thread's measurements.
+    [[nodiscard]] static uint64_t GetThreadMissCount() noexcept
+        { return m_threadMissCount; }
+private:
+    /// @brief What a measurement was made with.
+    struct MeasurementKey
+        {
+        wxString m_text;
+        wxString m_faceName;
+        double m_pointSize{ 0 };
+        int m_weight{ 0 };
+        int m_style{ 0 };
+        int m_family{ 0 };
+        wxSize m_ppi;
+        double m_contentScaleFactor{ 1 };
+        double m_userScaleX{ 1 };
+        double m_userScaleY{ 1 };
+        double m_logicalScaleX{ 1 };
+        double m_logicalScaleY{ 1 };
+        // the graphics renderer (if a GC-based DC), as different renderers measure differently
+        const wxGraphicsRenderer* m_renderer{ nullptr };
+        bool m_multiLine{ false };
+        [[nodiscard]] bool operator==(const MeasurementKey& that) const noexcept
+            {
+            return m_multiLine == that.m_multiLine &&
+                m_pointSize == that.m_pointSize &&
+                m_weight == that.m_weight &&
+                m_style == that.m_style &&
+                m_family == that.m_family &&
+                m_ppi == that.m_ppi &&
+                m_contentScaleFactor == that.m_contentScaleFactor &&
+                m_userScaleX == that.m_userScaleX &&
+                m_userScaleY == that.m_userScaleY &&
+                m_logicalScaleX == that.m_logicalScaleX &&
+                m_logicalScaleY == that.m_logicalScaleY &&
+                m_renderer == that.m_renderer &&
+                m_faceName == that.m_faceName &&
+                m_text == that.m_text;
+            }
+        };
+    /// @brief Hashes a measurement key.
+    class MeasurementKeyHash
+        {
+    public:
+        [[nodiscard]] size_t operator()(const MeasurementKey& key) const
+            {
+            size_t hashValue =
+                std::hash<std::wstring_view>{}(std::wstring_view(key.m_text.wc_str(),
+                                                                 key.m_text.length()));
+            const auto combine = [&hashValue](const size_t value) noexcept
+                { hashValue ^= value + 0x9e3779b9 + (hashValue << 6) + (hashValue >> 2); };
+            combine(std::hash<std::wstring_view>{}(std::wstring_view(key.m_faceName.wc_str(),
+                                                                     key.m_faceName.length())));
+            combine(std::hash<double>{}(key.m_pointSize));
+            combine(std::hash<int>{}(key.m_weight));
+            combine(std::hash<int>{}(key.m_style));
+            combine(std::hash<int>{}(key.m_ppi.GetHeight()));
+            combine(std::hash<double>{}(key.m_userScaleX));
+            combine(std::hash<bool>{}(key.m_multiLine));
+            return hashValue;
+            }
+        };
+    /// @brief A measurement.
+    struct Measurement
+        {
+        wxSize m_size;
+        wxCoord m_lineHeight{ 0 };
+        };
+    using MeasurementList = std::list<std::pair<MeasurementKey, Measurement>>;
+
+    /// @returns The key for measuring text with a DC (and its current font).
+    [[nodiscard]] static MeasurementKey MakeKey(wxDC& dc, const wxString& text,
+                                                const bool multiLine);
+    /// @brief Looks up a measurement, and moves it to the front of the cache if found.
+    /// @returns @c true if the measurement was found (and copied into @c measurement).
+    [[nodiscard]] static bool Find(const MeasurementKey& key, Measurement& measurement);
+    /// @brief Adds a measurement to the cache, discarding the oldest ones if necessary.
+    static void Add(MeasurementKey&& key, const Measurement& measurement);
+    /// @brief Discards the least recently used measurement.
+    /// @note The cache must be locked and not empty.
+    static void RemoveOldest();
+    /// @returns The (approximate) number of bytes that a measurement uses in the cache.
+    [[nodiscard]] static size_t GetEntryBytes(const MeasurementKey& key) noexcept
+        {
+        // the list and map nodes (the map holds a copy of the key) and both copies of the strings
+        return 2 * (sizeof(MeasurementKey) +
+                    (key.m_text.length() + key.m_faceName.length()) * sizeof(wxChar)) +
+               sizeof(Measurement) + 4 * sizeof(void*);
+        }
+    /// @returns The cache's registration with the memory budget.
+    [[nodiscard]] static MemoryBudget::Registration& GetBudgetRegistration();
+
+    inline static std::mutex m_mutex;
+    // most recently used measurements are at the front
+    inline static MeasurementList m_measurements;
+    inline static std::unordered_map<MeasurementKey, MeasurementList::iterator,
+                                     MeasurementKeyHash> m_lookup;
+    inline static size_t m_maxEntries{ 8192 };
+    inline static size_t m_bytes{ 0 };
+    inline static std::atomic<uint64_t> m_hitCount{ 0 };
+    inline static std::atomic<uint64_t> m_missCount{ 0 };
+    inline static thread_local uint64_t m_threadHitCount{ 0 };
+    inline static thread_local uint64_t m_threadMissCount{ 0 };
+    };
+
+/** @}*/
+
+#endif //__TEXT_EXTENT_CACHE_H__
@@ -42,6 +42,15 @@ SET(WISTERIA_SRC
     src/ui/variableselectdlg.cpp
     src/util/formulaformat.cpp
     src/util/logfile.cpp
+    src/util/measuringdc.cpp
     src/util/memorymappedfile.cpp
+    src/util/memorybudget.cpp
+    src/util/numberformatcache.cpp
+    src/util/objectpool.cpp
+    src/util/pixelkernels.cpp
+    src/util/spatialgrid.cpp
+    src/util/stripimagewriter.cpp
+    src/util/svgoptimizer.cpp
+    src/util/textextentcache.cpp
     src/wxSimpleJSON/src/cJSON/cJSON.c
     src/wxSimpleJSON/src/wxSimpleJSON.cpp)
\ No newline at end of file